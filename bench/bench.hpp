@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_BENCH_HPP
+#define LIBBITCOIN_NETWORK_BENCH_HPP
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network.hpp>
+
+namespace bench {
+
+using namespace bc;
+using namespace bc::network;
+using namespace bc::system;
+
+typedef std::vector<std::pair<std::string, double>> values;
+
+/// Heap allocations, all threads (counted by replaced operator new).
+extern std::atomic<size_t> allocations;
+
+/// Emit one result line (text, or a JSON object per line if --json).
+void report(const std::string& name, const values& values);
+
+/// Synthetic wire payloads (message bodies, without heading).
+data_chunk transaction_payload(uint32_t salt);
+data_chunk block_payload(size_t transactions);
+data_chunk inventory_payload(size_t items);
+data_chunk headers_payload(size_t headers);
+data_chunk address_payload(size_t items);
+
+/// Benchmark suites, false on failure.
+bool channels(size_t count);
+bool host_pool(size_t scale);
+bool lifecycle(size_t scale);
+bool messages(size_t scale);
+bool pipeline(size_t scale);
+bool relay(size_t scale);
+bool simulation(size_t peers);
+bool subscribers(size_t scale);
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+#ifdef HAVE_LINUX
+    #include <unistd.h>
+#endif
+
+namespace bench {
+
+// Memory cost of idle channels. Builds count idle (paused, unattached)
+// channels over in-memory pipes and reports resident set growth and heap
+// allocations per channel, with the channel's own estimate by component
+// (proxy::footprint) for comparison. Resident set is read from /proc (Linux),
+// and is reported as zero where not available.
+
+static size_t resident()
+{
+#ifdef HAVE_LINUX
+    std::ifstream statm{ "/proc/self/statm" };
+    size_t pages{};
+    size_t resident{};
+    if (!(statm >> pages >> resident))
+        return zero;
+
+    return resident * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+    return zero;
+#endif
+}
+
+static proxy::footprint measure(const channel::ptr& instance)
+{
+    std::promise<proxy::footprint> measured{};
+    boost::asio::post(instance->strand(), [&]()
+    {
+        measured.set_value(instance->memory());
+    });
+
+    return measured.get_future().get();
+}
+
+bool channels(size_t count)
+{
+    const logger log{};
+    settings set(chain::selection::mainnet);
+    threadpool pool(2);
+
+    std::vector<channel::ptr> idle{};
+    idle.reserve(two * count);
+
+    const auto rss = resident();
+    const auto allocated = allocations.load();
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto pair = network::pipe::create(log, pool.service());
+        idle.push_back(std::make_shared<channel>(log, pair.first, set,
+            two * index, true));
+        idle.push_back(std::make_shared<channel>(log, pair.second, set,
+            add1(two * index), true));
+    }
+
+    const auto built = static_cast<double>(idle.size());
+    const auto grown = floored_subtract(resident(), rss);
+    const auto allocs = allocations.load() - allocated;
+    const auto estimate = measure(idle.front());
+
+    report("channels/idle_" + std::to_string(idle.size()),
+    {
+        { "rss_per_channel", grown / built },
+        { "allocs_per_channel", allocs / built },
+        { "estimate", static_cast<double>(estimate.total()) },
+        { "object", static_cast<double>(estimate.object) },
+        { "socket", static_cast<double>(estimate.socket) },
+        { "buffers", static_cast<double>(estimate.buffers) },
+        { "subscribers", static_cast<double>(estimate.subscribers) },
+        { "timers", static_cast<double>(estimate.timers) },
+        { "filters", static_cast<double>(estimate.filters) }
+    });
+
+    for (const auto& instance: idle)
+        instance->stop(error::service_stopped);
+
+    idle.clear();
+    pool.stop();
+    pool.join();
+    return true;
+}
+
+} // namespace bench
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace bench {
+
+using namespace bc::network::messages;
+using namespace std::chrono;
+
+// Host pool operations at scale. Each pool is filled by save of 1000 address
+// messages, then persisted (stop) and loaded (start), then used by take and
+// restore cycles. Saves into the full pool measure message acceptance at
+// capacity (eviction of the oldest). Pools of 10k, 100k and 1m are measured.
+
+constexpr size_t message_size = 1'000;
+
+static address_cptr message(size_t offset)
+{
+    address_items items(message_size);
+    for (size_t index = 0; index < message_size; ++index)
+    {
+        // Distinct public IPv4-mapped addresses from 1.0.0.0.
+        const auto ip = possible_narrow_cast<uint32_t>(
+            0x01000000u + offset + index);
+
+        auto& item = items.at(index);
+        item.timestamp = 1'700'000'000;
+        item.services = 1;
+        item.ip = unspecified_ip_address;
+        item.ip.at(10) = 0xff;
+        item.ip.at(11) = 0xff;
+        item.ip.at(12) = static_cast<uint8_t>(ip >> 24);
+        item.ip.at(13) = static_cast<uint8_t>(ip >> 16);
+        item.ip.at(14) = static_cast<uint8_t>(ip >> 8);
+        item.ip.at(15) = static_cast<uint8_t>(ip);
+        item.port = 8333;
+    }
+
+    return std::make_shared<const address>(address{ std::move(items) });
+}
+
+static double seconds(const steady_clock::time_point& start)
+{
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+static void rate(const std::string& name, size_t count, size_t pooled,
+    double elapsed)
+{
+    report(name,
+    {
+        { "operations", static_cast<double>(count) },
+        { "pooled", static_cast<double>(pooled) },
+        { "ns_per_op", elapsed * 1e9 / count },
+        { "ops_per_s", count / elapsed }
+    });
+}
+
+static bool measure(const logger& log, size_t capacity, size_t scale)
+{
+    const auto prefix = "hosts/" + std::to_string(capacity / 1'000) + "k/";
+
+    settings set(chain::selection::mainnet);
+    set.path = std::filesystem::temp_directory_path() /
+        "libbitcoin-network-bench-hosts";
+    set.host_pool_capacity = possible_narrow_cast<uint32_t>(capacity);
+    set.services_minimum = 0;
+    set.peers.clear();
+    set.seeds.clear();
+    std::filesystem::remove_all(set.path);
+    std::filesystem::create_directories(set.path);
+
+    auto result = true;
+    const auto fail = [&](const code& ec)
+    {
+        if (ec) result = false;
+    };
+
+    // Fill by save (1000 address messages).
+    {
+        network::hosts pool(set, log);
+        if (pool.start())
+            return false;
+
+        const auto messages = capacity / message_size;
+        auto start = steady_clock::now();
+        for (size_t index = 0; index < messages; ++index)
+            pool.save(message(index * message_size),
+                [&](const code& ec, size_t) { fail(ec); });
+
+        rate(prefix + "save/fill", messages, pool.count(), seconds(start));
+
+        // Saves at capacity evict others (fresh addresses beyond the pool).
+        start = steady_clock::now();
+        for (size_t index = 0; index < scale * 100u; ++index)
+            pool.save(message(capacity + index * message_size),
+                [&](const code& ec, size_t) { fail(ec); });
+
+        rate(prefix + "save/full", scale * 100u, pool.count(),
+            seconds(start));
+
+        start = steady_clock::now();
+        const auto pooled = pool.count();
+        fail(pool.stop());
+        rate(prefix + "stop/file_save", one, pooled, seconds(start));
+    }
+
+    {
+        network::hosts pool(set, log);
+        auto start = steady_clock::now();
+        fail(pool.start());
+        rate(prefix + "start/file_load", one, pool.count(), seconds(start));
+
+        // Take and restore cycles (pool size remains constant).
+        const auto cycles = scale * 100'000u;
+        start = steady_clock::now();
+        for (size_t cycle = 0; cycle < cycles; ++cycle)
+        {
+            pool.take([&](const code& ec, const address_item_cptr& host)
+            {
+                fail(ec);
+                if (!ec)
+                    pool.restore(host, result_handler{ fail });
+            });
+        }
+
+        rate(prefix + "take_restore", cycles, pool.count(), seconds(start));
+        fail(pool.stop());
+    }
+
+    std::filesystem::remove_all(set.path);
+    return result;
+}
+
+bool host_pool(size_t scale)
+{
+    const logger log{};
+    return measure(log, 10'000, scale)
+        && measure(log, 100'000, scale)
+        && measure(log, 1'000'000, scale);
+}
+
+} // namespace bench
@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using namespace std::chrono;
+
+// Timer and connection lifecycle costs. Deadline start, restart and stop at
+// 10k concurrent timers (on the shared timer wheel and on asio timers), the
+// per message channel::signal_activity (eager and lazy inactivity),
+// session::defer allocations per call, and sustained handshake throughput
+// (inbound session and version protocols over loopback) at a fixed number of
+// connections in flight. Timer and channel calls are made on the strand.
+
+// Prevents the optimizer from discarding benchmarked work.
+static std::atomic<size_t> sink{};
+
+constexpr size_t timers = 10'000;
+constexpr size_t in_flight = 50;
+
+template <typename Function>
+static void time(const std::string& name, size_t iterations,
+    Function&& function)
+{
+    const auto allocated = allocations.load();
+    const auto start = steady_clock::now();
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+        function(iteration);
+
+    const auto seconds = duration<double>(steady_clock::now() - start).count();
+    const auto allocs = allocations.load() - allocated;
+
+    report(name,
+    {
+        { "iterations", static_cast<double>(iterations) },
+        { "ns_per_op", seconds * 1e9 / iterations },
+        { "allocs_per_op", static_cast<double>(allocs) / iterations }
+    });
+}
+
+static void on_strand(asio::strand& strand, const std::function<void()>& work)
+{
+    std::promise<void> done{};
+    boost::asio::post(strand, [&]()
+    {
+        work();
+        done.set_value();
+    });
+
+    done.get_future().wait();
+}
+
+// Timeouts exceed the run, so that only cancellations are notified.
+static void deadlines(const logger& log, asio::strand& strand,
+    timer_wheel* wheel, size_t scale)
+{
+    const auto prefix = std::string{ wheel ? "deadline/wheel" :
+        "deadline/asio" } + "_10k/";
+
+    std::vector<deadline::ptr> instances{};
+    instances.reserve(timers);
+    for (size_t index = 0; index < timers; ++index)
+        instances.push_back(wheel ?
+            std::make_shared<deadline>(log, strand, *wheel, minutes{ 10 }) :
+            std::make_shared<deadline>(log, strand, minutes{ 10 }));
+
+    const auto handler = [](const code& ec)
+    {
+        sink += ec.value();
+    };
+
+    on_strand(strand, [&]()
+    {
+        time(prefix + "start", timers, [&](size_t iteration)
+        {
+            instances[iteration]->start(handler);
+        });
+
+        time(prefix + "restart", scale * timers * 10u, [&](size_t iteration)
+        {
+            instances[iteration % timers]->start(handler);
+        });
+
+        time(prefix + "stop", timers, [&](size_t iteration)
+        {
+            instances[iteration]->stop();
+        });
+    });
+
+    // Drain cancellation notifications posted to the strand.
+    on_strand(strand, []() {});
+}
+
+class activity_channel
+  : public channel
+{
+public:
+    using channel::channel;
+
+    void signal() NOEXCEPT
+    {
+        signal_activity();
+    }
+};
+
+static void activity(const logger& log, threadpool& pool, bool lazy,
+    size_t scale)
+{
+    settings set(chain::selection::mainnet);
+    set.lazy_inactivity = lazy;
+
+    const auto pair = network::pipe::create(log, pool.service());
+    const auto instance = std::make_shared<activity_channel>(log, pair.first,
+        set, 1);
+
+    on_strand(instance->strand(), [&]()
+    {
+        time(std::string{ "channel/signal_activity_" } +
+            (lazy ? "lazy" : "eager"), scale * 1'000'000u, [&](size_t)
+            {
+                instance->signal();
+            });
+    });
+
+    instance->stop(error::service_stopped);
+    on_strand(instance->strand(), []() {});
+}
+
+class deferring_session
+  : public session
+{
+public:
+    deferring_session(p2p& network) NOEXCEPT
+      : session(network, 1)
+    {
+    }
+
+    void defer_one() NOEXCEPT
+    {
+        defer(minutes{ 10 }, [](const code& ec)
+        {
+            sink += ec.value();
+        });
+    }
+};
+
+static void deferrals(size_t scale)
+{
+    const logger log{};
+    settings set(chain::selection::mainnet);
+    p2p net(set, log);
+    const auto instance = std::make_shared<deferring_session>(net);
+
+    on_strand(net.strand(), [&]()
+    {
+        instance->start([](const code&) {});
+        time("session/defer", scale * timers, [&](size_t)
+        {
+            instance->defer_one();
+        });
+
+        // Stop cancels all deferred timers.
+        instance->stop();
+    });
+
+    on_strand(net.strand(), []() {});
+    net.close();
+}
+
+static uint16_t free_port(asio::io_context& service)
+{
+    asio::acceptor acceptor(service,
+        asio::endpoint{ asio::ipv4::loopback(), 0 });
+    return acceptor.local_endpoint().port();
+}
+
+static settings configure(const std::string& name)
+{
+    settings set(chain::selection::mainnet);
+    set.path = std::filesystem::temp_directory_path() / name;
+    set.outbound_connections = 0;
+    set.host_pool_capacity = 0;
+    set.enable_address = false;
+    set.enable_loopback = true;
+    set.rate_limit = 0;
+    set.trace_sample = 0;
+    set.seeds.clear();
+    set.peers.clear();
+    std::filesystem::create_directories(set.path);
+    return set;
+}
+
+static code open(p2p& net)
+{
+    std::promise<code> started{};
+    net.start([&](const code& ec)
+    {
+        if (ec)
+        {
+            started.set_value(ec);
+            return;
+        }
+
+        net.run([&](const code& ec)
+        {
+            started.set_value(ec);
+        });
+    });
+
+    return started.get_future().get();
+}
+
+// Each completed handshake (at the node) starts another client connection.
+static bool handshakes(size_t count)
+{
+    threadpool probe(1);
+    const auto port = free_port(probe.service());
+    probe.stop();
+    probe.join();
+
+    auto node_settings = configure("libbitcoin-network-bench-lifecycle");
+    node_settings.inbound_connections = possible_narrow_cast<uint16_t>(
+        std::min(count, size_t{ max_uint16 }));
+    node_settings.binds.emplace_back("127.0.0.1:" + std::to_string(port));
+    node_settings.initialize();
+
+    auto client_settings = configure("libbitcoin-network-bench-lifecycler");
+    client_settings.initialize();
+
+    const logger log{};
+    p2p node(node_settings, log);
+    p2p client(client_settings, log);
+
+    auto ec = open(node);
+    if (!ec)
+        ec = open(client);
+
+    if (ec)
+    {
+        report("lifecycle/start", { { "failed", ec.value() } });
+        client.close();
+        node.close();
+        return false;
+    }
+
+    const config::endpoint endpoint{ "127.0.0.1", port };
+    std::promise<steady_clock::time_point> finished{};
+    std::mutex mutex{};
+    size_t started{};
+    size_t completed{};
+
+    node.subscribe_connect([&](const code& ec, const channel::ptr&)
+    {
+        if (ec)
+            return false;
+
+        std::unique_lock lock{ mutex };
+        if (++completed == count)
+        {
+            finished.set_value(steady_clock::now());
+            return false;
+        }
+
+        if (started < count)
+        {
+            ++started;
+            client.connect(endpoint);
+        }
+
+        return true;
+    }, [](const code&, p2p::object_key) {});
+
+    const auto allocated = allocations.load();
+    const auto start = steady_clock::now();
+    {
+        std::unique_lock lock{ mutex };
+        for (; started < std::min(in_flight, count); ++started)
+            client.connect(endpoint);
+    }
+
+    const auto seconds = duration<double>(finished.get_future().get() -
+        start).count();
+    const auto allocs = allocations.load() - allocated;
+
+    report("lifecycle/handshake",
+    {
+        { "connections", static_cast<double>(count) },
+        { "in_flight", static_cast<double>(std::min(in_flight, count)) },
+        { "connections_per_s", count / seconds },
+        { "allocs_per_connection", static_cast<double>(allocs) / count }
+    });
+
+    client.close();
+    node.close();
+    return true;
+}
+
+bool lifecycle(size_t scale)
+{
+    const logger log{};
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+
+    timer_wheel wheel{};
+    deadlines(log, strand, &wheel, scale);
+    deadlines(log, strand, nullptr, scale);
+
+    activity(log, pool, false, scale);
+    activity(log, pool, true, scale);
+
+    pool.stop();
+    pool.join();
+
+    deferrals(scale);
+    return handshakes(scale * 1'000u);
+}
+
+} // namespace bench
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+// libbitcoin-network-bench [--json]
+//     [channels|hosts|lifecycle|messages|pipeline|relay|simulation|
+//     subscribers] [scale]
+// All suites are run if none is named. The simulation connects scale * 500
+// peers, channels builds scale * 1000 idle channel pairs, and relay injects
+// scale * 200 announcements into each topology of 8 nodes. Text results are
+// aligned for reading, JSON results are one object per line (name and
+// values) for trend tracking. Run optimized (--enable-ndebug).
+
+namespace bench {
+
+std::atomic<size_t> allocations{};
+static bool json{};
+
+void report(const std::string& name, const values& values)
+{
+    if (json)
+    {
+        std::cout << "{\"name\":\"" << name << "\"";
+        for (const auto& value: values)
+            std::cout << ",\"" << value.first << "\":" << value.second;
+
+        std::cout << "}" << std::endl;
+        return;
+    }
+
+    std::cout << std::left << std::setw(28) << name << std::right
+        << std::fixed << std::setprecision(1);
+    for (const auto& value: values)
+        std::cout << "  " << value.first << " " << value.second;
+
+    std::cout << std::endl;
+}
+
+} // namespace bench
+
+void* operator new(size_t size)
+{
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (const auto pointer = std::malloc(size))
+        return pointer;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t scale = 1;
+    std::string suite{};
+    for (auto arg = 1; arg < argc; ++arg)
+    {
+        if (std::strcmp(argv[arg], "--json") == 0)
+            bench::json = true;
+        else if (const auto value = std::atoi(argv[arg]); value > 0)
+            scale = static_cast<size_t>(value);
+        else
+            suite = argv[arg];
+    }
+
+    const auto all = suite.empty();
+    auto result = true;
+    if (all || suite == "channels")
+        result &= bench::channels(scale * 1'000u);
+    if (all || suite == "hosts")
+        result &= bench::host_pool(scale);
+    if (all || suite == "lifecycle")
+        result &= bench::lifecycle(scale);
+    if (all || suite == "messages")
+        result &= bench::messages(scale);
+    if (all || suite == "pipeline")
+        result &= bench::pipeline(scale);
+    if (all || suite == "relay")
+        result &= bench::relay(scale);
+    if (all || suite == "simulation")
+        result &= bench::simulation(scale * 500u);
+    if (all || suite == "subscribers")
+        result &= bench::subscribers(scale);
+
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace bench {
+
+using namespace bc::network::messages;
+using namespace std::chrono;
+
+// Prevents the optimizer from discarding benchmarked work.
+static std::atomic<size_t> sink{};
+
+template <typename Function>
+static void time(const std::string& name, size_t iterations, size_t bytes,
+    Function&& function)
+{
+    const auto allocated = allocations.load();
+    const auto start = steady_clock::now();
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+        function();
+
+    const auto elapsed = duration<double>(steady_clock::now() - start);
+    const auto seconds = elapsed.count();
+    const auto allocs = allocations.load() - allocated;
+
+    report(name,
+    {
+        { "iterations", static_cast<double>(iterations) },
+        { "ns_per_op", seconds * 1e9 / iterations },
+        { "mb_per_s", bytes * iterations / seconds / 1e6 },
+        { "allocs_per_op", static_cast<double>(allocs) / iterations }
+    });
+}
+
+// Serialize includes heading construction (payload checksum).
+template <typename Message>
+static bool measure(const std::string& name, const data_chunk& payload,
+    size_t iterations)
+{
+    constexpr auto magic = 0xd9b4bef9_u32;
+    constexpr uint32_t version = level::maximum_protocol;
+    const auto message = deserialize<Message>(payload, version);
+    if (!message)
+        return false;
+
+    time(name + "/serialize", iterations, payload.size(), [&]()
+    {
+        sink += serialize(*message, magic, version)->size();
+    });
+
+    time(name + "/deserialize", iterations, payload.size(), [&]()
+    {
+        sink += deserialize<Message>(payload, version) ? 1u : 0u;
+    });
+
+    return true;
+}
+
+static void checksum(const std::string& name, size_t bytes,
+    size_t iterations)
+{
+    const data_chunk payload(bytes, 0x42);
+    time(name, iterations, bytes, [&]()
+    {
+        sink += heading::factory(0xd9b4bef9, transaction::command,
+            payload).checksum;
+    });
+}
+
+bool messages(size_t scale)
+{
+    // Roughly mainnet: ~2500 transactions of ~260 bytes per block.
+    const auto result =
+        measure<inventory>("inventory", inventory_payload(50'000), scale * 50)
+        && measure<headers>("headers", headers_payload(2'000), scale * 200)
+        && measure<address>("address", address_payload(1'000), scale * 1'000)
+        && measure<block>("block", block_payload(2'500), scale * 50)
+        && measure<transaction>("transaction", transaction_payload(42),
+            scale * 100'000);
+
+    checksum("heading/checksum_32", 32, scale * 1'000'000);
+    checksum("heading/checksum_1m", 1'000'000, scale * 200);
+    return result;
+}
+
+} // namespace bench
@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using namespace bc::network::messages;
+using namespace std::chrono;
+
+// Throughput and latency of the proxy read/write pipeline over loopback and
+// in-memory pipes. Each stream sends count messages from one channel to
+// another over a connected pair, reporting messages/second, bytes/second,
+// p50/p99 send-to-receive latency and heap allocations per message (all
+// threads, including the sender).
+
+struct channels
+{
+    channel::ptr sender;
+    channel::ptr receiver;
+};
+
+static code connect(const logger& log, threadpool& pool,
+    const settings& set, channels& out)
+{
+    asio::acceptor acceptor(pool.service(),
+        asio::endpoint{ asio::ipv4::loopback(), 0 });
+    const auto port = std::to_string(acceptor.local_endpoint().port());
+
+    auto inbound = std::make_shared<network::socket>(log, pool.service());
+    auto outbound = std::make_shared<network::socket>(log, pool.service());
+
+    std::promise<code> accepted{};
+    std::promise<code> connected{};
+    inbound->accept(acceptor, [&](const code& ec)
+    {
+        accepted.set_value(ec);
+    });
+
+    asio::resolver resolver(pool.service());
+    outbound->connect(resolver.resolve("127.0.0.1", port),
+        [&](const code& ec)
+        {
+            connected.set_value(ec);
+        });
+
+    const auto ec = connected.get_future().get();
+    const auto accept_ec = accepted.get_future().get();
+    if (ec || accept_ec)
+    {
+        inbound->stop();
+        outbound->stop();
+        return ec ? ec : accept_ec;
+    }
+
+    // Quiet channels do not subscribe to announcements.
+    out.sender = std::make_shared<channel>(log, outbound, set, 1, true);
+    out.receiver = std::make_shared<channel>(log, inbound, set, 2, true);
+    return error::success;
+}
+
+// In-memory pair, excludes kernel socket costs.
+static void attach(const logger& log, threadpool& pool, const settings& set,
+    channels& out)
+{
+    const auto pair = network::pipe::create(log, pool.service());
+    out.sender = std::make_shared<channel>(log, pair.second, set, 1, true);
+    out.receiver = std::make_shared<channel>(log, pair.first, set, 2, true);
+}
+
+static int64_t ticks()
+{
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename Message>
+static bool run(const std::string& name, const channels& pair,
+    const data_chunk& payload, size_t count)
+{
+    const auto message = deserialize<Message>(payload,
+        pair.sender->negotiated_version());
+    if (!message)
+        return false;
+
+    std::vector<std::atomic<int64_t>> sent(count);
+    std::vector<int64_t> latencies{};
+    latencies.reserve(count);
+    std::promise<int64_t> done{};
+
+    const auto received = pair.receiver->received();
+    const auto allocated = allocations.load();
+    const auto start = ticks();
+
+    boost::asio::post(pair.receiver->strand(), [&]()
+    {
+        pair.receiver->subscribe<Message>(
+            [&](const code& ec, const typename Message::cptr&)
+            {
+                if (ec)
+                    return false;
+
+                const auto now = ticks();
+                latencies.push_back(now - sent.at(latencies.size()).load());
+                if (latencies.size() == count)
+                {
+                    done.set_value(now);
+                    return false;
+                }
+
+                return true;
+            });
+
+        // The read loop is started by the first stream.
+        if (pair.receiver->paused())
+            pair.receiver->resume();
+    });
+
+    boost::asio::post(pair.sender->strand(), [&]()
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            sent.at(index).store(ticks());
+            pair.sender->send<Message>(*message, [](const code&) {});
+        }
+    });
+
+    const auto finish = done.get_future().get();
+    const auto seconds = static_cast<double>(finish - start) / 1e9;
+    const auto bytes = pair.receiver->received() - received;
+    const auto allocs = allocations.load() - allocated;
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto quantile = [&](double rank)
+    {
+        const auto at = static_cast<size_t>(rank * (latencies.size() - 1u));
+        return static_cast<double>(latencies.at(at)) / 1e3;
+    };
+
+    report(name,
+    {
+        { "messages", static_cast<double>(count) },
+        { "msg_per_s", count / seconds },
+        { "mb_per_s", bytes / seconds / 1e6 },
+        { "p50_us", quantile(0.50) },
+        { "p99_us", quantile(0.99) },
+        { "allocs_per_msg", static_cast<double>(allocs) / count }
+    });
+
+    return true;
+}
+
+bool pipeline(size_t scale)
+{
+    const logger log{};
+    settings set(chain::selection::mainnet);
+    set.rate_limit = 0;
+    set.trace_sample = 0;
+    set.payload_pool_capacity = 64;
+
+    threadpool pool(2);
+    channels tcp{};
+    channels memory{};
+    attach(log, pool, set, memory);
+    if (const auto ec = connect(log, pool, set, tcp))
+    {
+        report("pipeline/connect", { { "failed", ec.value() } });
+        memory.sender->stop(error::service_stopped);
+        memory.receiver->stop(error::service_stopped);
+        pool.stop();
+        pool.join();
+        return false;
+    }
+
+    auto result = true;
+    for (const auto& [name, pair]: { std::pair{ "tcp", tcp },
+        std::pair{ "pipe", memory } })
+    {
+        const std::string prefix{ "pipeline/" + std::string{ name } + "/" };
+        result = result
+            && run<inventory>(prefix + "inv", pair, inventory_payload(50),
+                scale * 100'000)
+            && run<transaction>(prefix + "tx", pair, transaction_payload(42),
+                scale * 100'000)
+            && run<block>(prefix + "block", pair, block_payload(250),
+                scale * 2'000);
+
+        pair.sender->stop(error::service_stopped);
+        pair.receiver->stop(error::service_stopped);
+    }
+
+    tcp = {};
+    memory = {};
+    pool.stop();
+    pool.join();
+    return result;
+}
+
+} // namespace bench
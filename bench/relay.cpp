@@ -0,0 +1,511 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+using namespace std::chrono;
+using namespace std::placeholders;
+using namespace bc::network::messages;
+
+// End-to-end relay latency over loopback. K p2p nodes are connected in a
+// line, star or full mesh (manual connections to inbound sessions), and each
+// channel has a relay protocol that broadcasts a novel single item inventory
+// received from its peer to the other channels of the node, which send the
+// shared (serialized once) encoding. Announcements are injected one at a
+// time at the last node, and the first arrival at each node is timed. The
+// hop latency is from first arrival at the sending node (or injection) to
+// first arrival at the node, and the total from injection. Nodes are named
+// by user agent, so that the sending node of a channel is known.
+
+constexpr size_t nodes = 8;
+constexpr size_t announcements = 200;
+constexpr auto relay_timeout = seconds{ 10 };
+
+enum class topology
+{
+    line,
+    star,
+    mesh
+};
+
+typedef std::vector<std::pair<size_t, size_t>> edges;
+
+// Node zero is the star hub, so injection at the last node is a leaf.
+static edges to_edges(topology shape, size_t count)
+{
+    edges out{};
+    for (size_t from = 0; from < count; ++from)
+    {
+        for (size_t to = add1(from); to < count; ++to)
+        {
+            if (shape == topology::mesh ||
+                (shape == topology::line && to == add1(from)) ||
+                (shape == topology::star && is_zero(from)))
+                out.emplace_back(from, to);
+        }
+    }
+
+    return out;
+}
+
+class relay_protocol;
+
+// First arrivals of the current announcement, shared by all nodes.
+class relay_state
+{
+public:
+    typedef steady_clock::time_point time_point;
+
+    relay_state(size_t count)
+      : arrivals_(count), senders_(count), injectors_(count)
+    {
+    }
+
+    void enlist(size_t node, const std::shared_ptr<relay_protocol>& protocol)
+    {
+        std::unique_lock lock{ mutex_ };
+        injectors_.at(node) = protocol;
+    }
+
+    std::shared_ptr<relay_protocol> injector(size_t node)
+    {
+        std::unique_lock lock{ mutex_ };
+        return injectors_.at(node).lock();
+    }
+
+    std::future<void> begin(const hash_digest& hash, size_t origin)
+    {
+        std::unique_lock lock{ mutex_ };
+        hash_ = hash;
+        done_ = {};
+        remaining_ = sub1(arrivals_.size());
+        std::fill(arrivals_.begin(), arrivals_.end(), time_point{});
+        std::fill(senders_.begin(), senders_.end(), origin);
+        arrivals_.at(origin) = steady_clock::now();
+        return done_.get_future();
+    }
+
+    // True if this is the first arrival of the announcement at the node.
+    bool arrive(size_t node, size_t sender, const hash_digest& hash)
+    {
+        const auto now = steady_clock::now();
+        std::unique_lock lock{ mutex_ };
+        if (hash != hash_ || node >= arrivals_.size() ||
+            arrivals_.at(node) != time_point{})
+            return false;
+
+        arrivals_.at(node) = now;
+        senders_.at(node) = sender;
+        if (is_zero(--remaining_))
+            done_.set_value();
+
+        return true;
+    }
+
+    // Hop and total latencies (ns) and hop counts of the completed relay.
+    void collect(size_t origin, std::vector<int64_t>& hops,
+        std::vector<int64_t>& totals, size_t& depth)
+    {
+        std::unique_lock lock{ mutex_ };
+        for (size_t node = 0; node < arrivals_.size(); ++node)
+        {
+            if (node == origin)
+                continue;
+
+            const auto sender = senders_.at(node);
+            hops.push_back(duration_cast<nanoseconds>(arrivals_.at(node) -
+                arrivals_.at(sender)).count());
+            totals.push_back(duration_cast<nanoseconds>(arrivals_.at(node) -
+                arrivals_.at(origin)).count());
+
+            size_t count{};
+            for (auto at = node; at != origin && count < arrivals_.size();
+                at = senders_.at(at))
+                ++count;
+
+            depth = std::max(depth, count);
+        }
+    }
+
+private:
+    std::mutex mutex_{};
+    hash_digest hash_{};
+    std::promise<void> done_{};
+    size_t remaining_{};
+    std::vector<time_point> arrivals_;
+    std::vector<size_t> senders_;
+    std::vector<std::weak_ptr<relay_protocol>> injectors_;
+};
+
+#define CLASS relay_protocol
+
+class relay_protocol
+  : public protocol, protected tracker<relay_protocol>
+{
+public:
+    typedef std::shared_ptr<relay_protocol> ptr;
+
+    relay_protocol(session& session, const channel::ptr& channel,
+        relay_state& state, size_t node) NOEXCEPT
+      : protocol(session, channel),
+        tracker<relay_protocol>(session.log),
+        state_(state),
+        strand_(channel->strand()),
+        node_(node),
+        peer_(to_node(channel->peer_version()))
+    {
+    }
+
+    void start() NOEXCEPT override
+    {
+        BC_ASSERT_MSG(stranded(), "relay_protocol");
+
+        if (started())
+            return;
+
+        SUBSCRIBE_CHANNEL2(inventory, handle_receive_inventory, _1, _2);
+        SUBSCRIBE_BROADCAST3(inventory, handle_broadcast_inventory, _1, _2,
+            _3);
+        state_.enlist(node_, shared_from_base<relay_protocol>());
+        protocol::start();
+    }
+
+    // Send to the peer of this channel and broadcast to the others.
+    void inject(const inventory::cptr& message) NOEXCEPT
+    {
+        boost::asio::post(strand_,
+            std::bind(&relay_protocol::do_inject,
+                shared_from_base<relay_protocol>(), message));
+    }
+
+protected:
+    void do_inject(const inventory::cptr& message) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "relay_protocol");
+
+        if (stopped())
+            return;
+
+        SEND1(*message, handle_send, _1);
+        broadcast<inventory>(message);
+    }
+
+    bool handle_receive_inventory(const code& ec,
+        const inventory::cptr& message) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "relay_protocol");
+
+        if (stopped(ec))
+            return false;
+
+        if (!message->items.empty() &&
+            state_.arrive(node_, peer_, message->items.front().hash))
+            broadcast<inventory>(message);
+
+        return true;
+    }
+
+    bool handle_broadcast_inventory(const code& ec,
+        const inventory::cptr& message, uint64_t) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "relay_protocol");
+
+        if (stopped(ec))
+            return false;
+
+        SEND1(*message, handle_send, _1);
+        return true;
+    }
+
+private:
+    // User agents are "/bench:<node>/".
+    static size_t to_node(const version::cptr& peer)
+    {
+        if (!peer)
+            return max_size_t;
+
+        const auto& agent = peer->user_agent;
+        const auto start = agent.find(':');
+        return start == std::string::npos ? max_size_t :
+            static_cast<size_t>(std::atoll(agent.c_str() + add1(start)));
+    }
+
+    relay_state& state_;
+    asio::strand& strand_;
+    const size_t node_;
+    const size_t peer_;
+};
+
+#undef CLASS
+
+template <class Session>
+class relay_session
+  : public Session
+{
+public:
+    relay_session(p2p& network, uint64_t identifier, relay_state& state,
+        size_t node) NOEXCEPT
+      : Session(network, identifier), state_(state), node_(node)
+    {
+    }
+
+protected:
+    void attach_protocols(const channel::ptr& channel) NOEXCEPT override
+    {
+        Session::attach_protocols(channel);
+        channel->attach<relay_protocol>(*this, state_, node_)->start();
+    }
+
+private:
+    relay_state& state_;
+    const size_t node_;
+};
+
+class relay_node
+  : public p2p
+{
+public:
+    relay_node(const settings& settings, const logger& log,
+        relay_state& state, size_t node) NOEXCEPT
+      : p2p(settings, log), state_(state), node_(node)
+    {
+    }
+
+protected:
+    session_manual::ptr attach_manual_session() NOEXCEPT override
+    {
+        return attach<relay_session<session_manual>>(*this, state_, node_);
+    }
+
+    session_inbound::ptr attach_inbound_session() NOEXCEPT override
+    {
+        return attach<relay_session<session_inbound>>(*this, state_, node_);
+    }
+
+private:
+    relay_state& state_;
+    const size_t node_;
+};
+
+static uint16_t free_port(asio::io_context& service)
+{
+    asio::acceptor acceptor(service,
+        asio::endpoint{ asio::ipv4::loopback(), 0 });
+    return acceptor.local_endpoint().port();
+}
+
+static settings configure(const std::string& name, size_t node,
+    uint16_t port, size_t count)
+{
+    settings set(chain::selection::mainnet);
+    set.path = std::filesystem::temp_directory_path() / name;
+    set.user_agent = "/bench:" + std::to_string(node) + "/";
+    set.inbound_connections = possible_narrow_cast<uint16_t>(count);
+    set.outbound_connections = 0;
+    set.host_pool_capacity = 0;
+    set.enable_address = false;
+    set.enable_loopback = true;
+    set.rate_limit = 0;
+    set.trace_sample = 0;
+    set.seeds.clear();
+    set.peers.clear();
+    set.binds.emplace_back("127.0.0.1:" + std::to_string(port));
+    std::filesystem::create_directories(set.path);
+    set.initialize();
+    return set;
+}
+
+static code open(p2p& net)
+{
+    std::promise<code> started{};
+    net.start([&](const code& ec)
+    {
+        if (ec)
+        {
+            started.set_value(ec);
+            return;
+        }
+
+        net.run([&](const code& ec)
+        {
+            started.set_value(ec);
+        });
+    });
+
+    return started.get_future().get();
+}
+
+static double quantile(std::vector<int64_t>& values, double rank)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const auto at = static_cast<size_t>(rank * (values.size() - 1u));
+    return static_cast<double>(values.at(at)) / 1e3;
+}
+
+static bool relay(topology shape, const std::string& name, size_t count,
+    size_t messages)
+{
+    const auto links = to_edges(shape, count);
+
+    threadpool probe(1);
+    std::vector<uint16_t> ports{};
+    for (size_t node = 0; node < count; ++node)
+        ports.push_back(free_port(probe.service()));
+
+    probe.stop();
+    probe.join();
+
+    const logger log{};
+    relay_state state(count);
+    std::vector<settings> configurations{};
+    std::vector<std::unique_ptr<relay_node>> network{};
+    configurations.reserve(count);
+    for (size_t node = 0; node < count; ++node)
+    {
+        configurations.push_back(configure("libbitcoin-network-bench-relay" +
+            std::to_string(node), node, ports.at(node), count));
+        network.push_back(std::make_unique<relay_node>(
+            configurations.back(), log, state, node));
+    }
+
+    const auto close = [&]()
+    {
+        for (const auto& node: network)
+            node->close();
+    };
+
+    // Each link is notified at both of its nodes.
+    std::mutex mutex{};
+    std::promise<void> linked{};
+    auto pending = two * links.size();
+    for (const auto& node: network)
+    {
+        node->subscribe_connect([&](const code& ec, const channel::ptr&)
+        {
+            if (ec)
+                return false;
+
+            std::unique_lock lock{ mutex };
+            if (is_zero(--pending))
+                linked.set_value();
+
+            return !is_zero(pending);
+        }, [](const code&, p2p::object_key) {});
+
+        if (const auto ec = open(*node))
+        {
+            report("relay/" + name + "/start", { { "failed", ec.value() } });
+            close();
+            return false;
+        }
+    }
+
+    for (const auto& link: links)
+        network.at(link.first)->connect({ "127.0.0.1",
+            ports.at(link.second) });
+
+    if (linked.get_future().wait_for(relay_timeout) !=
+        std::future_status::ready)
+    {
+        report("relay/" + name + "/connect", { { "failed", 1.0 } });
+        close();
+        return false;
+    }
+
+    const auto origin = sub1(count);
+    std::vector<int64_t> hops{};
+    std::vector<int64_t> totals{};
+    size_t depth{};
+
+    const auto start = steady_clock::now();
+    for (size_t index = 0; index < messages; ++index)
+    {
+        hash_digest hash{};
+        hash.at(0) = possible_narrow_cast<uint8_t>(index);
+        hash.at(1) = possible_narrow_cast<uint8_t>(index >> 8);
+        hash.at(2) = 0x42;
+
+        const auto injector = state.injector(origin);
+        if (!injector)
+        {
+            report("relay/" + name + "/inject", { { "failed", 1.0 } });
+            close();
+            return false;
+        }
+
+        constexpr auto type = inventory::type_id::transaction;
+        const auto message = to_shared(inventory{ { { type, hash } } });
+        auto relayed = state.begin(hash, origin);
+        injector->inject(message);
+
+        if (relayed.wait_for(relay_timeout) != std::future_status::ready)
+        {
+            report("relay/" + name + "/relay", { { "failed", 1.0 } });
+            close();
+            return false;
+        }
+
+        state.collect(origin, hops, totals, depth);
+    }
+
+    const auto seconds = duration<double>(steady_clock::now() -
+        start).count();
+
+    report("relay/" + name,
+    {
+        { "nodes", static_cast<double>(count) },
+        { "links", static_cast<double>(links.size()) },
+        { "hops", static_cast<double>(depth) },
+        { "announcements_per_s", messages / seconds },
+        { "hop_p50_us", quantile(hops, 0.50) },
+        { "hop_p99_us", quantile(hops, 0.99) },
+        { "total_p50_us", quantile(totals, 0.50) },
+        { "total_p99_us", quantile(totals, 0.99) }
+    });
+
+    close();
+    return true;
+}
+
+bool relay(size_t scale)
+{
+    auto result = true;
+    result &= relay(topology::line, "line", nodes, scale * announcements);
+    result &= relay(topology::star, "star", nodes, scale * announcements);
+    result &= relay(topology::mesh, "mesh", nodes, scale * announcements);
+    return result;
+}
+
+} // namespace bench
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using namespace std::chrono;
+
+// Connection lifecycle at scale over loopback. One node accepts peers
+// connections, all made by a second (client) p2p instance as manual
+// connections. Handshakes include the address protocols, so addr gossip is
+// exercised. Reports handshake throughput, resident memory per channel and
+// strand queue latency (post to invoke) across all of the node's channels.
+
+// Resident set size in bytes (linux only, otherwise zero).
+static size_t resident()
+{
+    std::ifstream statm{ "/proc/self/statm" };
+    size_t pages{}, rss{};
+    if (!(statm >> pages >> rss))
+        return zero;
+
+    return rss * 4'096u;
+}
+
+static uint16_t free_port(asio::io_context& service)
+{
+    asio::acceptor acceptor(service,
+        asio::endpoint{ asio::ipv4::loopback(), 0 });
+    return acceptor.local_endpoint().port();
+}
+
+static settings configure(const std::string& name)
+{
+    settings set(chain::selection::mainnet);
+    set.path = std::filesystem::temp_directory_path() / name;
+    set.outbound_connections = 0;
+    set.host_pool_capacity = 0;
+    set.enable_loopback = true;
+    set.rate_limit = 0;
+    set.trace_sample = 0;
+    set.seeds.clear();
+    set.peers.clear();
+    std::filesystem::create_directories(set.path);
+    return set;
+}
+
+static code open(p2p& net)
+{
+    std::promise<code> started{};
+    net.start([&](const code& ec)
+    {
+        if (ec)
+        {
+            started.set_value(ec);
+            return;
+        }
+
+        net.run([&](const code& ec)
+        {
+            started.set_value(ec);
+        });
+    });
+
+    return started.get_future().get();
+}
+
+bool simulation(size_t peers)
+{
+    threadpool probe(1);
+    const auto port = free_port(probe.service());
+    probe.stop();
+    probe.join();
+
+    auto node_settings = configure("libbitcoin-network-bench-node");
+    node_settings.inbound_connections = possible_narrow_cast<uint16_t>(
+        std::min(peers, size_t{ max_uint16 }));
+    node_settings.binds.emplace_back("127.0.0.1:" + std::to_string(port));
+    node_settings.initialize();
+
+    // The client retains addresses gossiped by the node.
+    auto client_settings = configure("libbitcoin-network-bench-client");
+    client_settings.host_pool_capacity = 1'000;
+    client_settings.initialize();
+
+    const logger log{};
+    p2p node(node_settings, log);
+    p2p client(client_settings, log);
+
+    std::promise<steady_clock::time_point> connected{};
+    std::mutex mutex{};
+    std::vector<std::weak_ptr<channel>> channels{};
+    size_t handshakes{};
+    node.subscribe_connect([&](const code& ec, const channel::ptr& channel)
+    {
+        if (ec)
+            return false;
+
+        std::unique_lock lock{ mutex };
+        channels.push_back(channel);
+        if (++handshakes == peers)
+        {
+            connected.set_value(steady_clock::now());
+            return false;
+        }
+
+        return true;
+    }, [](const code&, p2p::object_key) {});
+
+    auto ec = open(node);
+    if (!ec)
+        ec = open(client);
+
+    if (ec)
+    {
+        report("simulation/start", { { "failed", ec.value() } });
+        client.close();
+        node.close();
+        return false;
+    }
+
+    const auto memory = resident();
+    const auto start = steady_clock::now();
+    const config::endpoint endpoint{ "127.0.0.1", port };
+    for (size_t peer = 0; peer < peers; ++peer)
+        client.connect(endpoint);
+
+    const auto finish = connected.get_future().get();
+    const auto seconds = duration<double>(finish - start).count();
+    const auto growth = resident() - std::min(memory, resident());
+
+    // Strand queue latency, one probe posted to each channel strand.
+    std::vector<int64_t> latencies{};
+    std::promise<void> probed{};
+    size_t pending{};
+    {
+        std::unique_lock lock{ mutex };
+        pending = channels.size();
+        latencies.reserve(pending);
+        for (const auto& weak: channels)
+        {
+            const auto channel = weak.lock();
+            if (!channel)
+            {
+                --pending;
+                continue;
+            }
+
+            const auto posted = steady_clock::now();
+            boost::asio::post(channel->strand(), [&, posted]()
+            {
+                std::unique_lock probe_lock{ mutex };
+                latencies.push_back(duration_cast<nanoseconds>(
+                    steady_clock::now() - posted).count());
+                if (latencies.size() == pending)
+                    probed.set_value();
+            });
+        }
+
+        if (is_zero(pending))
+            probed.set_value();
+    }
+
+    probed.get_future().wait();
+    std::sort(latencies.begin(), latencies.end());
+    const auto quantile = [&](double rank)
+    {
+        if (latencies.empty())
+            return 0.0;
+
+        const auto at = static_cast<size_t>(rank * (latencies.size() - 1u));
+        return static_cast<double>(latencies.at(at)) / 1e3;
+    };
+
+    report("simulation/handshake",
+    {
+        { "channels", static_cast<double>(handshakes) },
+        { "handshakes_per_s", handshakes / seconds },
+        { "bytes_per_channel", static_cast<double>(growth) / peers },
+        { "strand_p50_us", quantile(0.50) },
+        { "strand_p99_us", quantile(0.99) },
+        { "addresses", static_cast<double>(client.address_count()) }
+    });
+
+    client.close();
+    node.close();
+    return true;
+}
+
+} // namespace bench
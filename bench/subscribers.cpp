@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace bench {
+
+using namespace bc::network::messages;
+using namespace std::chrono;
+
+// Subscription containers on the relay path. Subscriber and unsubscriber
+// notify, with and without desubscription churn, desubscriber keyed
+// subscribe/notify_one/desubscribe at 1k and 10k keys, and broadcaster
+// fan-out latency (broadcast to delivery at the last channel strand) to N
+// channels. All subscriber calls are made on the strand, as required.
+
+// Prevents the optimizer from discarding benchmarked work.
+static std::atomic<size_t> sink{};
+
+constexpr size_t threads = 4;
+
+template <typename Function>
+static void time(const std::string& name, size_t iterations,
+    Function&& function)
+{
+    const auto allocated = allocations.load();
+    const auto start = steady_clock::now();
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+        function(iteration);
+
+    const auto seconds = duration<double>(steady_clock::now() - start).count();
+    const auto allocs = allocations.load() - allocated;
+
+    report(name,
+    {
+        { "iterations", static_cast<double>(iterations) },
+        { "ns_per_op", seconds * 1e9 / iterations },
+        { "allocs_per_op", static_cast<double>(allocs) / iterations }
+    });
+}
+
+static void on_strand(asio::strand& strand, const std::function<void()>& work)
+{
+    std::promise<void> done{};
+    boost::asio::post(strand, [&]()
+    {
+        work();
+        done.set_value();
+    });
+
+    done.get_future().wait();
+}
+
+static void notify_subscriber(asio::strand& strand, size_t count,
+    size_t scale)
+{
+    on_strand(strand, [&]()
+    {
+        subscriber<size_t> instance(strand);
+        for (size_t index = 0; index < count; ++index)
+            instance.subscribe([](const code&, size_t value)
+            {
+                sink += value;
+            });
+
+        time("subscriber/notify_" + std::to_string(count),
+            scale * 1'000'000u / count, [&](size_t iteration)
+            {
+                instance.notify(error::success, iteration);
+            });
+
+        instance.stop(error::service_stopped, zero);
+    });
+}
+
+// One tenth of the handlers desubscribe on each notify, and are replaced.
+static void notify_unsubscriber(asio::strand& strand, size_t count,
+    size_t scale)
+{
+    on_strand(strand, [&]()
+    {
+        unsubscriber<size_t> instance(strand);
+        size_t subscribed{};
+        const auto fill = [&]()
+        {
+            while (instance.size() < count)
+            {
+                const auto index = subscribed++;
+                instance.subscribe([index](const code& ec, size_t round)
+                {
+                    sink += round;
+                    return !ec && (index % 10u) != (round % 10u);
+                });
+            }
+        };
+
+        fill();
+        time("unsubscriber/notify_churn_" + std::to_string(count),
+            scale * 1'000'000u / count, [&](size_t iteration)
+            {
+                instance.notify(error::success, iteration);
+                fill();
+            });
+
+        instance.stop(error::service_stopped, zero);
+    });
+}
+
+// Each operation subscribes a new key and desubscribes the oldest, at size.
+static void churn_desubscriber(asio::strand& strand, size_t keys,
+    size_t scale)
+{
+    on_strand(strand, [&]()
+    {
+        desubscriber<uint64_t, size_t> instance(strand);
+        const auto handler = [](const code& ec, size_t value)
+        {
+            sink += value;
+            return !ec;
+        };
+
+        for (uint64_t key = 0; key < keys; ++key)
+            instance.subscribe(handler, key);
+
+        const auto prefix = "desubscriber/" + std::to_string(keys / 1'000) +
+            "k/";
+
+        time(prefix + "notify_one", scale * 1'000'000u, [&](size_t iteration)
+        {
+            instance.notify_one(iteration % keys, error::success, iteration);
+        });
+
+        time(prefix + "subscribe_desubscribe", scale * 1'000'000u,
+            [&](size_t iteration)
+            {
+                instance.subscribe(handler, keys + iteration);
+                instance.notify_one(iteration, error::desubscribed, zero);
+            });
+
+        instance.stop(error::service_stopped, zero);
+    });
+}
+
+// Channel strands share a pool, as channels of a network share its pool.
+static void fanout_broadcaster(threadpool& pool, size_t channels,
+    size_t scale)
+{
+    asio::strand strand(pool.service().get_executor());
+    broadcaster instance(strand, threads);
+    std::deque<asio::strand> strands{};
+    std::atomic<size_t> delivered{};
+    std::unique_ptr<std::promise<void>> done{};
+
+    on_strand(strand, [&]()
+    {
+        for (size_t channel = 0; channel < channels; ++channel)
+        {
+            auto& to = strands.emplace_back(pool.service().get_executor());
+            instance.subscribe_fanout<ping>(
+                [&](const code& ec, const ping::cptr&, const wire_cache::ptr&,
+                    broadcaster::channel_id) NOEXCEPT
+                {
+                    if (!ec && add1(delivered.fetch_add(one)) == channels)
+                        done->set_value();
+
+                    return !ec;
+                }, add1(channel), to);
+        }
+    });
+
+    const auto message = std::make_shared<const ping>(ping{ 42 });
+    time("broadcaster/fanout_" + std::to_string(channels),
+        scale * 100'000u / channels, [&](size_t)
+        {
+            delivered = zero;
+            done = std::make_unique<std::promise<void>>();
+            auto future = done->get_future();
+            boost::asio::post(strand, [&]()
+            {
+                instance.notify(message, zero);
+            });
+
+            future.wait();
+        });
+
+    on_strand(strand, [&]()
+    {
+        instance.stop(error::service_stopped);
+    });
+
+    // Drain stop notifications posted to channel strands.
+    for (auto& to: strands)
+        on_strand(to, []() {});
+}
+
+bool subscribers(size_t scale)
+{
+    threadpool pool(threads);
+    asio::strand strand(pool.service().get_executor());
+
+    for (const auto count: { 1u, 100u, 1'000u })
+    {
+        notify_subscriber(strand, count, scale);
+        notify_unsubscriber(strand, count, scale);
+    }
+
+    for (const auto keys: { 1'000u, 10'000u })
+        churn_desubscriber(strand, keys, scale);
+
+    for (const auto channels: { 10u, 100u, 1'000u })
+        fanout_broadcaster(pool, channels, scale);
+
+    pool.stop();
+    pool.join();
+    return true;
+}
+
+} // namespace bench
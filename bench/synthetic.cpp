@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+namespace bench {
+
+constexpr auto script_size = 100u;
+constexpr auto header_size = 80u;
+
+template <typename Bytes>
+static void put(data_chunk& out, const Bytes& bytes)
+{
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+static void put_variable(data_chunk& out, size_t value)
+{
+    if (value < 0xfd)
+    {
+        out.push_back(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        out.push_back(0xfd);
+        put(out, to_little_endian(static_cast<uint16_t>(value)));
+    }
+    else
+    {
+        out.push_back(0xfe);
+        put(out, to_little_endian(static_cast<uint32_t>(value)));
+    }
+}
+
+static hash_digest salted(uint64_t salt)
+{
+    return bitcoin_hash(to_chunk(to_little_endian(salt)));
+}
+
+// Non-witness one input, one output transaction.
+static void put_transaction(data_chunk& out, uint32_t salt)
+{
+    put(out, to_little_endian<uint32_t>(1));
+    put_variable(out, 1);
+    put(out, salted(salt));
+    put(out, to_little_endian<uint32_t>(0));
+    put_variable(out, script_size);
+    out.insert(out.end(), script_size, 0x51);
+    put(out, to_little_endian<uint32_t>(max_uint32));
+    put_variable(out, 1);
+    put(out, to_little_endian<uint64_t>(salt));
+    put_variable(out, script_size);
+    out.insert(out.end(), script_size, 0x51);
+    put(out, to_little_endian<uint32_t>(0));
+}
+
+static void put_header(data_chunk& out, uint32_t salt)
+{
+    put(out, to_little_endian<uint32_t>(4));
+    put(out, salted(salt));
+    put(out, salted(add1(salt)));
+    put(out, to_little_endian<uint32_t>(salt));
+    put(out, to_little_endian<uint32_t>(0x1d00ffff));
+    put(out, to_little_endian<uint32_t>(salt));
+}
+
+data_chunk transaction_payload(uint32_t salt)
+{
+    data_chunk out{};
+    put_transaction(out, salt);
+    return out;
+}
+
+data_chunk block_payload(size_t transactions)
+{
+    data_chunk out{};
+    put_header(out, 0);
+    put_variable(out, transactions);
+    for (size_t index = 0; index < transactions; ++index)
+        put_transaction(out, static_cast<uint32_t>(index));
+
+    return out;
+}
+
+data_chunk inventory_payload(size_t items)
+{
+    data_chunk out{};
+    put_variable(out, items);
+    for (size_t index = 0; index < items; ++index)
+    {
+        put(out, to_little_endian<uint32_t>(1));
+        put(out, salted(index));
+    }
+
+    return out;
+}
+
+data_chunk headers_payload(size_t headers)
+{
+    data_chunk out{};
+    put_variable(out, headers);
+    for (size_t index = 0; index < headers; ++index)
+    {
+        put_header(out, static_cast<uint32_t>(index));
+        put_variable(out, 0);
+    }
+
+    return out;
+}
+
+// Timestamped items (version >= 31402) with ipv4-mapped addresses.
+data_chunk address_payload(size_t items)
+{
+    data_chunk out{};
+    put_variable(out, items);
+    for (size_t index = 0; index < items; ++index)
+    {
+        put(out, to_little_endian<uint32_t>(1'700'000'000));
+        put(out, to_little_endian<uint64_t>(1));
+        out.insert(out.end(), 10, 0x00);
+        out.insert(out.end(), 2, 0xff);
+        put(out, to_big_endian(static_cast<uint32_t>(0x0a000000 + index)));
+        put(out, to_big_endian<uint16_t>(8333));
+    }
+
+    return out;
+}
+
+} // namespace bench
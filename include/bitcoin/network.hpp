@@ -23,29 +23,45 @@
 #include <bitcoin/network/version.hpp>
 #include <bitcoin/network/async/asio.hpp>
 #include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/async/coarse_clock.hpp>
 #include <bitcoin/network/async/desubscriber.hpp>
 #include <bitcoin/network/async/enable_shared_from_base.hpp>
+#include <bitcoin/network/async/handler_memory.hpp>
 #include <bitcoin/network/async/handlers.hpp>
+#include <bitcoin/network/async/move_handler.hpp>
+#include <bitcoin/network/async/object_slab.hpp>
 #include <bitcoin/network/async/race_quality.hpp>
 #include <bitcoin/network/async/race_speed.hpp>
 #include <bitcoin/network/async/race_volume.hpp>
 #include <bitcoin/network/async/subscriber.hpp>
 #include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/thread_context.hpp>
 #include <bitcoin/network/async/threadpool.hpp>
+#include <bitcoin/network/async/threadpools.hpp>
+#include <bitcoin/network/async/throttle.hpp>
 #include <bitcoin/network/async/time.hpp>
 #include <bitcoin/network/async/unsubscriber.hpp>
 #include <bitcoin/network/config/address.hpp>
 #include <bitcoin/network/config/authority.hpp>
 #include <bitcoin/network/config/config.hpp>
 #include <bitcoin/network/config/endpoint.hpp>
+#include <bitcoin/network/config/subnets.hpp>
 #include <bitcoin/network/config/utilities.hpp>
+#include <bitcoin/network/log/aggregator.hpp>
+#include <bitcoin/network/log/arguments.hpp>
 #include <bitcoin/network/log/capture.hpp>
+#include <bitcoin/network/log/events.hpp>
+#include <bitcoin/network/log/formats.hpp>
 #include <bitcoin/network/log/levels.hpp>
 #include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/log/logger.hpp>
+#include <bitcoin/network/log/probe.hpp>
+#include <bitcoin/network/log/record_queue.hpp>
 #include <bitcoin/network/log/reporter.hpp>
 #include <bitcoin/network/log/timer.hpp>
+#include <bitcoin/network/log/tracer.hpp>
 #include <bitcoin/network/log/tracker.hpp>
+#include <bitcoin/network/log/usdt.hpp>
 #include <bitcoin/network/messages/address.hpp>
 #include <bitcoin/network/messages/address_item.hpp>
 #include <bitcoin/network/messages/alert.hpp>
@@ -73,6 +89,7 @@
 #include <bitcoin/network/messages/heading.hpp>
 #include <bitcoin/network/messages/inventory.hpp>
 #include <bitcoin/network/messages/inventory_item.hpp>
+#include <bitcoin/network/messages/inventory_view.hpp>
 #include <bitcoin/network/messages/memory_pool.hpp>
 #include <bitcoin/network/messages/merkle_block.hpp>
 #include <bitcoin/network/messages/message.hpp>
@@ -80,39 +97,94 @@
 #include <bitcoin/network/messages/not_found.hpp>
 #include <bitcoin/network/messages/ping.hpp>
 #include <bitcoin/network/messages/pong.hpp>
+#include <bitcoin/network/messages/reconciliation_difference.hpp>
+#include <bitcoin/network/messages/reconciliation_sketch.hpp>
 #include <bitcoin/network/messages/reject.hpp>
+#include <bitcoin/network/messages/request_reconciliation.hpp>
+#include <bitcoin/network/messages/request_sketch_extension.hpp>
 #include <bitcoin/network/messages/send_compact.hpp>
 #include <bitcoin/network/messages/send_headers.hpp>
+#include <bitcoin/network/messages/send_reconciliation.hpp>
+#include <bitcoin/network/messages/siphash.hpp>
 #include <bitcoin/network/messages/transaction.hpp>
 #include <bitcoin/network/messages/version.hpp>
 #include <bitcoin/network/messages/version_acknowledge.hpp>
+#include <bitcoin/network/messages/wtxid_relay.hpp>
 #include <bitcoin/network/messages/enums/identifier.hpp>
 #include <bitcoin/network/messages/enums/level.hpp>
 #include <bitcoin/network/messages/enums/magic_numbers.hpp>
 #include <bitcoin/network/messages/enums/service.hpp>
 #include <bitcoin/network/net/acceptor.hpp>
+#include <bitcoin/network/net/anchors.hpp>
+#include <bitcoin/network/net/asmap.hpp>
+#include <bitcoin/network/net/bans.hpp>
+#include <bitcoin/network/net/block_stream.hpp>
+#include <bitcoin/network/net/blocklist.hpp>
+#include <bitcoin/network/net/bloom_filter.hpp>
 #include <bitcoin/network/net/broadcaster.hpp>
+#include <bitcoin/network/net/capture.hpp>
 #include <bitcoin/network/net/channel.hpp>
+#include <bitcoin/network/net/checksum_batcher.hpp>
 #include <bitcoin/network/net/connector.hpp>
 #include <bitcoin/network/net/deadline.hpp>
 #include <bitcoin/network/net/distributor.hpp>
+#include <bitcoin/network/net/eviction.hpp>
+#include <bitcoin/network/net/export_ring.hpp>
+#include <bitcoin/network/net/fetcher.hpp>
+#include <bitcoin/network/net/filter_cache.hpp>
+#include <bitcoin/network/net/filter_matcher.hpp>
+#include <bitcoin/network/net/handoff.hpp>
+#include <bitcoin/network/net/header_fetcher.hpp>
 #include <bitcoin/network/net/hosts.hpp>
+#include <bitcoin/network/net/lz4.hpp>
+#include <bitcoin/network/net/memory_budget.hpp>
+#include <bitcoin/network/net/message_exporter.hpp>
+#include <bitcoin/network/net/metrics.hpp>
 #include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/net/name_resolver.hpp>
+#include <bitcoin/network/net/nonces.hpp>
+#include <bitcoin/network/net/payload_hash.hpp>
+#include <bitcoin/network/net/payload_pool.hpp>
+#include <bitcoin/network/net/pin_sketch.hpp>
+#include <bitcoin/network/net/pipe.hpp>
 #include <bitcoin/network/net/proxy.hpp>
+#include <bitcoin/network/net/recycler.hpp>
+#include <bitcoin/network/net/replay.hpp>
+#include <bitcoin/network/net/resources.hpp>
+#include <bitcoin/network/net/rolling_filter.hpp>
+#include <bitcoin/network/net/seeds.hpp>
+#include <bitcoin/network/net/seen_filter.hpp>
+#include <bitcoin/network/net/serve_cache.hpp>
+#include <bitcoin/network/net/short_id_table.hpp>
 #include <bitcoin/network/net/socket.hpp>
+#include <bitcoin/network/net/timeout_estimator.hpp>
+#include <bitcoin/network/net/timer_wheel.hpp>
+#include <bitcoin/network/net/upload_budget.hpp>
+#include <bitcoin/network/net/version_template.hpp>
+#include <bitcoin/network/net/wire_cache.hpp>
 #include <bitcoin/network/protocols/protocol.hpp>
 #include <bitcoin/network/protocols/protocol_address_in_31402.hpp>
 #include <bitcoin/network/protocols/protocol_address_out_31402.hpp>
 #include <bitcoin/network/protocols/protocol_alert_31402.hpp>
+#include <bitcoin/network/protocols/protocol_bloom_filter_70001.hpp>
+#include <bitcoin/network/protocols/protocol_client_filter_70015.hpp>
+#include <bitcoin/network/protocols/protocol_compact_block_70014.hpp>
+#include <bitcoin/network/protocols/protocol_fee_filter_70013.hpp>
+#include <bitcoin/network/protocols/protocol_fetch_31402.hpp>
+#include <bitcoin/network/protocols/protocol_headers_31800.hpp>
+#include <bitcoin/network/protocols/protocol_memory_pool_60002.hpp>
 #include <bitcoin/network/protocols/protocol_ping_31402.hpp>
 #include <bitcoin/network/protocols/protocol_ping_60001.hpp>
+#include <bitcoin/network/protocols/protocol_reconcile_70016.hpp>
 #include <bitcoin/network/protocols/protocol_reject_70002.hpp>
 #include <bitcoin/network/protocols/protocol_seed_31402.hpp>
+#include <bitcoin/network/protocols/protocol_send_headers_70012.hpp>
 #include <bitcoin/network/protocols/protocol_version_31402.hpp>
 #include <bitcoin/network/protocols/protocol_version_70001.hpp>
 #include <bitcoin/network/protocols/protocol_version_70002.hpp>
 #include <bitcoin/network/protocols/protocols.hpp>
 #include <bitcoin/network/sessions/session.hpp>
+#include <bitcoin/network/sessions/session_feeler.hpp>
 #include <bitcoin/network/sessions/session_inbound.hpp>
 #include <bitcoin/network/sessions/session_manual.hpp>
 #include <bitcoin/network/sessions/session_outbound.hpp>
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NETWORK_ASYNC_ASIO_HPP
 
 #include <memory>
+#include <vector>
 #include <bitcoin/network/async/time.hpp>
 #include <bitcoin/network/define.hpp>
 
@@ -37,6 +38,7 @@ typedef boost::asio::strand<executor_type> strand;
 typedef boost::asio::steady_timer steady_timer;
 typedef boost::asio::mutable_buffer mutable_buffer;
 typedef boost::asio::const_buffer const_buffer;
+typedef std::vector<const_buffer> const_buffers;
 
 typedef boost::asio::ip::v6_only v6_only;
 typedef boost::asio::ip::address address;
@@ -55,6 +57,12 @@ typedef std::shared_ptr<socket> socket_ptr;
 
 constexpr auto max_connections = boost::asio::socket_base::max_listen_connections;
 
+// C++20 coroutines (optional protocol layer), frames are recycled per thread.
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+template <typename Type = void>
+using awaitable = boost::asio::awaitable<Type>;
+#endif
+
 } // namespace asio
 } // namespace network
 } // namespace libbitcoin
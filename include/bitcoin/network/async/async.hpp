@@ -20,15 +20,22 @@
 #define LIBBITCOIN_NETWORK_ASYNC_ASYNC_HPP
 
 #include <bitcoin/network/async/asio.hpp>
+#include <bitcoin/network/async/coarse_clock.hpp>
 #include <bitcoin/network/async/desubscriber.hpp>
 #include <bitcoin/network/async/enable_shared_from_base.hpp>
+#include <bitcoin/network/async/handler_memory.hpp>
 #include <bitcoin/network/async/handlers.hpp>
+#include <bitcoin/network/async/move_handler.hpp>
+#include <bitcoin/network/async/object_slab.hpp>
 #include <bitcoin/network/async/race_quality.hpp>
 #include <bitcoin/network/async/race_speed.hpp>
 #include <bitcoin/network/async/race_volume.hpp>
 #include <bitcoin/network/async/subscriber.hpp>
 #include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/thread_context.hpp>
 #include <bitcoin/network/async/threadpool.hpp>
+#include <bitcoin/network/async/threadpools.hpp>
+#include <bitcoin/network/async/throttle.hpp>
 #include <bitcoin/network/async/time.hpp>
 #include <bitcoin/network/async/unsubscriber.hpp>
 
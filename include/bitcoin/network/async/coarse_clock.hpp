@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_COARSE_CLOCK_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_COARSE_CLOCK_HPP
+
+#include <ctime>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, static.
+/// Coarse steady and wall time, cached by a single ticker thread at
+/// millisecond resolution and each read with one relaxed atomic load. For
+/// timestamps that do not require precision (address times, log time,
+/// inactivity). Reads fall through to the precise clocks while not running.
+class BCT_API coarse_clock final
+{
+public:
+    static constexpr milliseconds resolution{ 1 };
+
+    /// Start the ticker, counted (each start must be paired with a stop).
+    static void start() NOEXCEPT;
+
+    /// Stop and join the ticker upon the last paired stop.
+    static void stop() NOEXCEPT;
+
+    /// The ticker is running (cached times are read).
+    static bool running() NOEXCEPT;
+
+    /// Current steady time, within resolution if running.
+    static steady_clock::time_point steady() NOEXCEPT;
+
+    /// Current wall time, within resolution if running.
+    static wall_clock::time_point wall() NOEXCEPT;
+
+    /// Current zulu (utc) time as time_t, within resolution if running.
+    static time_t zulu() NOEXCEPT;
+
+private:
+    static void tick() NOEXCEPT;
+    static void run() NOEXCEPT;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -20,9 +20,11 @@
 #define LIBBITCOIN_NETWORK_ASYNC_DESUBSCRIBER_HPP
 
 #include <functional>
-#include <map>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 #include <bitcoin/network/async/asio.hpp>
+#include <bitcoin/network/async/move_handler.hpp>
 #include <bitcoin/network/define.hpp>
 
 namespace libbitcoin {
@@ -30,6 +32,8 @@ namespace network {
 
 /// Not thread safe, non-virtual.
 /// All methods must be invoked on strand, handlers are invoked on strand.
+/// Handlers are held contiguously in subscription order, indexed by key.
+/// Desubscription leaves a tombstone, which is compacted after notify.
 template <typename Key, typename... Args>
 class desubscriber final
 {
@@ -37,7 +41,11 @@ public:
     DELETE_COPY_MOVE(desubscriber);
 
     using key = Key;
+    /// Copyable handler, for external declarations.
     typedef std::function<bool(const code&, Args...)> handler;
+
+    /// Retained handler, move-only and stored inline when small.
+    typedef move_handler<bool(const code&, Args...)> callback;
     typedef std::function<void(const code&, const Key&)> completer;
 
     // Strand is only used for assertions.
@@ -47,7 +55,7 @@ public:
     /// If stopped, handler is invoked with error::subscriber_stopped.
     /// If key exists, handler is invoked with error::subscriber_exists.
     /// Otherwise handler retained. Subscription code is also returned here.
-    code subscribe(handler&& handler, const Key& key) NOEXCEPT;
+    code subscribe(callback&& handler, const Key& key) NOEXCEPT;
 
     /// Invoke each handler in order with specified arguments.
     /// Handler return true for resubscription, otherwise it is desubscribed.
@@ -65,16 +73,29 @@ public:
     /// Invoke each handler in order, with default arguments, then drop all.
     void stop_default(const code& ec) NOEXCEPT;
 
-    /// The map size.
+    /// The number of subscriptions.
     size_t size() const NOEXCEPT;
 
 private:
+    struct entry
+    {
+        Key key;
+        callback handler;
+    };
+
+    // Invoke the handler of the slot, tombstoning it upon desubscription.
+    bool invoke(size_t slot, const code& ec, const Args&... args) NOEXCEPT;
+    void compact() NOEXCEPT;
+
     // This is thread safe.
     asio::strand& strand_;
 
     // These are not thread safe.
     bool stopped_{ false };
-    std::map<Key, handler> map_{};
+    size_t depth_{};
+    size_t tombstones_{};
+    std::vector<entry> entries_{};
+    std::unordered_map<Key, size_t> index_{};
 };
 
 } // namespace network
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_HANDLER_MEMORY_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_HANDLER_MEMORY_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Recycled storage for the (one at a time) asynchronous operation of an i/o
+/// object, such as the read or write of a socket. An allocation that fits
+/// while the storage is free uses it, others use the general-purpose heap.
+class BCT_API handler_memory final
+{
+public:
+    DELETE_COPY_MOVE(handler_memory);
+
+    /// Sufficient for a composed asio read/write with a bound handler.
+    static constexpr size_t capacity = 512;
+
+    handler_memory() NOEXCEPT;
+
+    /// Allocate size bytes, from storage if it fits and is free.
+    void* allocate(size_t size) NOEXCEPT;
+
+    /// Deallocate a pointer obtained from allocate.
+    void deallocate(void* pointer) NOEXCEPT;
+
+    /// The storage is allocated.
+    bool in_use() const NOEXCEPT;
+
+private:
+    // These are not thread safe.
+    alignas(std::max_align_t) unsigned char storage_[capacity];
+    bool in_use_{};
+};
+
+/// Minimal allocator over handler_memory (asio associated allocator).
+template <typename Type>
+class handler_allocator
+{
+public:
+    using value_type = Type;
+
+    explicit handler_allocator(handler_memory& memory) NOEXCEPT
+      : memory_(&memory)
+    {
+    }
+
+    template <typename Other>
+    handler_allocator(const handler_allocator<Other>& other) NOEXCEPT
+      : memory_(other.memory_)
+    {
+    }
+
+    Type* allocate(size_t count) const NOEXCEPT
+    {
+        return static_cast<Type*>(memory_->allocate(sizeof(Type) * count));
+    }
+
+    void deallocate(Type* pointer, size_t) const NOEXCEPT
+    {
+        memory_->deallocate(pointer);
+    }
+
+    template <typename Other>
+    bool operator==(const handler_allocator<Other>& other) const NOEXCEPT
+    {
+        return memory_ == other.memory_;
+    }
+
+    template <typename Other>
+    bool operator!=(const handler_allocator<Other>& other) const NOEXCEPT
+    {
+        return memory_ != other.memory_;
+    }
+
+private:
+    template <typename>
+    friend class handler_allocator;
+
+    handler_memory* memory_;
+};
+
+/// Handler wrapper that associates handler_memory as its allocator, so that
+/// asio allocates the operation (and intermediate handlers) from it.
+template <typename Handler>
+class allocated_handler
+{
+public:
+    using allocator_type = handler_allocator<Handler>;
+
+    allocated_handler(handler_memory& memory, Handler&& handler) NOEXCEPT
+      : memory_(memory), handler_(std::move(handler))
+    {
+    }
+
+    allocator_type get_allocator() const NOEXCEPT
+    {
+        return allocator_type{ memory_ };
+    }
+
+    template <typename... Args>
+    void operator()(Args&&... args)
+    {
+        handler_(std::forward<Args>(args)...);
+    }
+
+private:
+    handler_memory& memory_;
+    Handler handler_;
+};
+
+/// Associate the memory with the handler (memory must outlive operation).
+template <typename Handler>
+inline allocated_handler<std::decay_t<Handler>> make_allocated(
+    handler_memory& memory, Handler&& handler) NOEXCEPT
+{
+    return { memory, std::forward<Handler>(handler) };
+}
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
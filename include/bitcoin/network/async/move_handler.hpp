@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_MOVE_HANDLER_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_MOVE_HANDLER_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Default inline capacity, sufficient for a bound member function with a
+/// shared pointer and up to two additional bound words.
+constexpr size_t move_handler_capacity = 48;
+
+template <typename Signature, size_t Capacity = move_handler_capacity>
+class move_handler;
+
+/// Not thread safe, non-virtual.
+/// Move-only type-erased callable with inline (small buffer) storage.
+/// Callables that fit the capacity and are nothrow movable are stored inline,
+/// others are allocated. Unlike std::function it does not require copyable
+/// callables, and does not allocate for typical bound protocol handlers.
+template <typename Result, typename... Args, size_t Capacity>
+class move_handler<Result(Args...), Capacity> final
+{
+public:
+    template <typename Function>
+    static constexpr bool is_callable =
+        !std::is_same_v<Function, move_handler> &&
+        std::is_invocable_r_v<Result, Function&, Args...>;
+
+    move_handler(const move_handler&) = delete;
+    move_handler& operator=(const move_handler&) = delete;
+
+    /// Construct an empty handler.
+    move_handler() NOEXCEPT;
+    move_handler(std::nullptr_t) NOEXCEPT;
+
+    /// Construct from any callable of the signature (constrained, so that
+    /// overloads on distinct signatures resolve as with std::function).
+    template <typename Function, std::enable_if_t<
+        is_callable<std::decay_t<Function>>, bool> = true>
+    move_handler(Function&& function) NOEXCEPT
+    {
+        using callable = std::decay_t<Function>;
+
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        if constexpr (is_inline<callable>)
+        {
+            new (buffer_) callable(std::forward<Function>(function));
+            operations_ = &inline_operations<callable>::table;
+        }
+        else
+        {
+            new (buffer_) callable*(
+                new callable(std::forward<Function>(function)));
+            operations_ = &allocated_operations<callable>::table;
+        }
+        BC_POP_WARNING()
+    }
+
+    /// Move the callable, the other is left empty.
+    move_handler(move_handler&& other) NOEXCEPT;
+    move_handler& operator=(move_handler&& other) NOEXCEPT;
+
+    /// Destroy the callable.
+    ~move_handler() NOEXCEPT;
+
+    /// Invoke the callable (must not be empty).
+    Result operator()(Args... args) const NOEXCEPT;
+
+    /// The handler holds a callable.
+    explicit operator bool() const NOEXCEPT;
+
+    /// The callable is stored inline (not allocated).
+    bool inlined() const NOEXCEPT;
+
+private:
+    struct operations
+    {
+        Result(*invoke)(void* data, Args&&... args);
+        void(*move)(void* to, void* from);
+        void(*destroy)(void* data);
+        bool inlined;
+    };
+
+    template <typename Function>
+    static constexpr bool is_inline = sizeof(Function) <= Capacity &&
+        alignof(Function) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Function>;
+
+    template <typename Function>
+    struct inline_operations;
+
+    template <typename Function>
+    struct allocated_operations;
+
+    void reset() NOEXCEPT;
+
+    // These are not thread safe.
+    const operations* operations_{};
+    alignas(std::max_align_t) mutable unsigned char buffer_[Capacity];
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#include <bitcoin/network/impl/async/move_handler.ipp>
+
+#endif
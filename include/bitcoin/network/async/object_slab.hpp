@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_OBJECT_SLAB_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_OBJECT_SLAB_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Free list of fixed size blocks, recycling the storage of per-connection
+/// objects (such as socket and channel) upon their destruction. Blocks
+/// released beyond the retained limit are returned to the heap.
+class BCT_API object_slab final
+{
+public:
+    DELETE_COPY_MOVE(object_slab);
+
+    /// Blocks of size bytes, up to limit retained for reuse.
+    object_slab(size_t size, size_t limit) NOEXCEPT;
+
+    /// Free retained blocks.
+    ~object_slab() NOEXCEPT;
+
+    /// Allocate a block, reusing a retained block if available.
+    void* allocate() NOEXCEPT;
+
+    /// Deallocate a block obtained from allocate (retained within limit).
+    void deallocate(void* block) NOEXCEPT;
+
+    /// The number of blocks retained for reuse.
+    size_t retained() const NOEXCEPT;
+
+private:
+    // These are thread safe.
+    const size_t size_;
+    const size_t limit_;
+
+    // These are protected by mutex.
+    std::vector<void*> free_{};
+    mutable std::mutex mutex_{};
+};
+
+/// Allocator over a process-wide object_slab of each allocated type, for use
+/// with std::allocate_shared (the slab of the combined control block and
+/// object). Allocations of other than one object use the heap.
+template <typename Type, size_t Limit = 256>
+class slab_allocator
+{
+public:
+    using value_type = Type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = slab_allocator<Other, Limit>;
+    };
+
+    slab_allocator() NOEXCEPT = default;
+
+    template <typename Other>
+    slab_allocator(const slab_allocator<Other, Limit>&) NOEXCEPT
+    {
+    }
+
+    Type* allocate(size_t count) const NOEXCEPT
+    {
+        static_assert(alignof(Type) <= alignof(std::max_align_t));
+
+        if (count != one)
+        {
+            BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+            return std::allocator<Type>{}.allocate(count);
+            BC_POP_WARNING()
+        }
+
+        return static_cast<Type*>(slab().allocate());
+    }
+
+    void deallocate(Type* pointer, size_t count) const NOEXCEPT
+    {
+        if (count != one)
+        {
+            std::allocator<Type>{}.deallocate(pointer, count);
+            return;
+        }
+
+        slab().deallocate(pointer);
+    }
+
+    template <typename Other>
+    bool operator==(const slab_allocator<Other, Limit>&) const NOEXCEPT
+    {
+        return true;
+    }
+
+    template <typename Other>
+    bool operator!=(const slab_allocator<Other, Limit>&) const NOEXCEPT
+    {
+        return false;
+    }
+
+    /// The slab of the allocated type.
+    static object_slab& slab() NOEXCEPT
+    {
+        static object_slab instance{ sizeof(Type), Limit };
+        return instance;
+    }
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
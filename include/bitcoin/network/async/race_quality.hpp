@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NETWORK_ASYNC_RACE_QUALITY_HPP
 #define LIBBITCOIN_NETWORK_ASYNC_RACE_QUALITY_HPP
 
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <utility>
@@ -32,6 +33,8 @@ namespace network {
 /// Race is a bind that invokes handler with the first set of arguments
 /// but only after a preconfigured number of invocations. This assists in
 /// synchronizing the results of a set of racing asynchronous operations.
+/// The handler is held inline and the race may be restarted upon completion,
+/// so that a race may be recycled without allocation.
 template <typename... Args>
 class race_quality final
 {
@@ -50,6 +53,9 @@ public:
     /// False implies invalid usage.
     bool start(handler&& complete) NOEXCEPT;
 
+    /// Start with the given number of runners, as of a recycled race.
+    bool start(size_t size, handler&& complete) NOEXCEPT;
+
     /// True implies winning finisher (first not failed).
     /// First arg is an 'error code', cast to bool (failed if true).
     /// There may be no winner, in which case last finish is invoked.
@@ -67,14 +73,12 @@ private:
     bool invoke() NOEXCEPT;
     bool set_winner(bool success) NOEXCEPT;
 
-    // This is thread safe.
-    const size_t size_;
-
     // These are not thread safe.
+    size_t size_;
     packed args_{};
     bool success_{};
     size_t runners_{};
-    std::shared_ptr<handler> complete_{};
+    handler complete_{};
 };
 
 } // namespace network
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NETWORK_ASYNC_RACE_SPEED_HPP
 #define LIBBITCOIN_NETWORK_ASYNC_RACE_SPEED_HPP
 
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <utility>
@@ -32,6 +33,7 @@ namespace network {
 /// Race is a bind that invokes handler with the first set of arguments
 /// but only after a preconfigured number of invocations. This assists in
 /// synchronizing the results of a set of racing asynchronous operations.
+/// The handler is held inline and the race may be restarted upon completion.
 template <size_t Size, typename... Args>
 class race_speed final
 {
@@ -72,7 +74,7 @@ private:
     // These are not thread safe.
     packed args_{};
     size_t runners_{};
-    std::shared_ptr<handler> complete_{};
+    handler complete_{};
 };
 
 } // namespace network
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NETWORK_ASYNC_RACE_VOLUME_HPP
 #define LIBBITCOIN_NETWORK_ASYNC_RACE_VOLUME_HPP
 
+#include <functional>
 #include <memory>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
@@ -30,6 +31,7 @@ namespace network {
 /// Race is a bind that invokes handler with the first set of arguments
 /// but only after a preconfigured number of invocations. This assists in
 /// synchronizing the results of a set of racing asynchronous operations.
+/// Handlers are held inline and the race may be restarted upon completion.
 template <error::error_t Success, error::error_t Fail>
 class race_volume final
 {
@@ -51,7 +53,11 @@ public:
     /// Signal finisher and pass total count.
     bool finish(size_t count) NOEXCEPT;
 
+    /// Pass total count without finishing, invokes sufficient if reached.
+    bool sufficient(size_t count) NOEXCEPT;
+
 private:
+    void notify(const code& ec) NOEXCEPT;
     bool invoke() NOEXCEPT;
 
     // These are thread safe.
@@ -60,8 +66,8 @@ private:
 
     // These are not thread safe.
     size_t runners_{};
-    std::shared_ptr<handler> sufficient_{};
-    std::shared_ptr<handler> complete_{};
+    handler sufficient_{};
+    handler complete_{};
 };
 
 } // namespace network
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NETWORK_ASYNC_THREAD_HPP
 
 #include <memory>
+#include <vector>
 #include <boost/thread.hpp>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
@@ -52,7 +53,13 @@ enum class thread_priority
 // stackoverflow.com/q/22448022/1172329
 typedef boost::thread thread;
 
+/// Logical processor indexes for thread placement (empty implies any).
+typedef std::vector<uint32_t> processor_set;
+
 BCT_API void set_priority(thread_priority priority) NOEXCEPT;
+BCT_API bool set_affinity(uint32_t processor) NOEXCEPT;
+BCT_API bool set_affinity(const processor_set& processors,
+    size_t index) NOEXCEPT;
 BCT_API thread_priority priority(bool priority) NOEXCEPT;
 BCT_API size_t thread_default(size_t configured) NOEXCEPT;
 BCT_API size_t thread_ceiling(size_t configured) NOEXCEPT;
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_THREAD_CONTEXT_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_THREAD_CONTEXT_HPP
+
+#include <atomic>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/asio.hpp>
+#include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/threadpool.hpp>
+#include <bitcoin/network/async/threadpools.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe except stop/join, non-virtual.
+/// The threads of one or more networks. Network strands run on a shared
+/// threadpool, as do channels unless context per thread, in which case
+/// channels are assigned round robin to single threaded services and the
+/// network strands share the one remaining thread.
+class BCT_API thread_context final
+{
+public:
+    DELETE_COPY_MOVE(thread_context);
+
+    /// Construct the specified number of threads.
+    /// The shared threadpool adapts up to maximum threads under load, based
+    /// on handler queue delay relative to threshold (not if per thread).
+    thread_context(size_t number_threads, bool context_per_thread=false,
+        const processor_set& processors={}, size_t maximum_threads=zero,
+        const steady_clock::duration& threshold={}) NOEXCEPT;
+
+    /// Stop and join threads.
+    ~thread_context() NOEXCEPT;
+
+    /// Destroy the work keep-alive of all threads (safe from any thread).
+    void stop() NOEXCEPT;
+
+    /// True once stopped, after which network close cannot be sequenced.
+    bool stopped() const NOEXCEPT;
+
+    /// Block until all threads terminate, channel services first so that
+    /// their final posts to network strands are not orphaned.
+    /// Returns false if called from within the context (would deadlock).
+    bool join() NOEXCEPT;
+
+    /// As join, but abandoning work outstanding at the deadline.
+    bool join(const steady_clock::time_point& deadline) NOEXCEPT;
+
+    /// The service of network strands (and of channels if not per thread).
+    asio::io_context& service() NOEXCEPT;
+
+    /// Single threaded channel services (empty if not per thread).
+    threadpools& services() NOEXCEPT;
+
+private:
+    // These are thread safe.
+    threadpool threadpool_;
+    threadpools services_;
+    std::atomic_bool stopped_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -19,27 +19,36 @@
 #ifndef LIBBITCOIN_NETWORK_ASYNC_THREADPOOL_HPP
 #define LIBBITCOIN_NETWORK_ASYNC_THREADPOOL_HPP
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/asio.hpp>
 #include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/time.hpp>
 #include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
 
 namespace libbitcoin {
 namespace network {
 
 // TODO: investigate boost::threadpool.
 
-/// Not thread safe, non-virtual.
+/// Thread safe, non-virtual.
 /// A collection of threads that share an asio I/O context (service).
+/// The thread count may optionally adapt to load (see adapt).
 class BCT_API threadpool final
 {
 public:
     DELETE_COPY_MOVE(threadpool);
 
     /// Threadpool constructor, initializes the specified number of threads.
+    /// Threads are pinned to processors in rotation, if any are specified.
+    /// A non-adaptive single thread service is hinted as such to asio, which
+    /// elides scheduler cross-thread wakeups (other threads may still post).
     threadpool(size_t number_threads=one,
-        thread_priority priority=thread_priority::normal) NOEXCEPT;
+        thread_priority priority=thread_priority::normal,
+        const processor_set& processors={}, bool adaptive=false) NOEXCEPT;
 
     /// Stop and join threads.
     ~threadpool() NOEXCEPT;
@@ -53,18 +62,60 @@ public:
     /// Returns false if called from within threadpool (would deadlock).
     bool join() NOEXCEPT;
 
+    /// Block until all threads in the pool terminate or the deadline passes,
+    /// at which point the service is stopped, abandoning outstanding work.
+    /// Returns false if called from within threadpool (would deadlock).
+    bool join(const steady_clock::time_point& deadline) NOEXCEPT;
+
+    /// Vary the thread count between the constructed number and maximum.
+    /// Grows by one thread when sampled handler queue delay exceeds threshold
+    /// and shrinks by one after a sustained idle period. Call at most once.
+    /// Has no effect if maximum does not exceed the constructed number, or if
+    /// the pool was not constructed as adaptive.
+    void adapt(size_t maximum, const steady_clock::duration& threshold) NOEXCEPT;
+
+    /// The number of threads currently servicing handlers.
+    size_t size() const NOEXCEPT;
+
     /// Non-const underlying boost::io_service object (thread safe).
     asio::io_context& service() NOEXCEPT;
 
 private:
     using work_guard = boost::asio::executor_work_guard<asio::executor_type>;
     static inline work_guard keep_alive(asio::io_context& service) NOEXCEPT;
+    static constexpr int concurrency(size_t threads, bool adaptive) NOEXCEPT;
 
-    // This is thread safe.
+    void spawn() NOEXCEPT;
+    void run(size_t index) NOEXCEPT;
+    bool retire() NOEXCEPT;
+    bool restore(std::vector<thread>& threads) NOEXCEPT;
+    void grow() NOEXCEPT;
+    void shrink() NOEXCEPT;
+    void sample() NOEXCEPT;
+    void handle_sample(const error::boost_code& ec) NOEXCEPT;
+
+    // These are thread safe.
     asio::io_context service_{};
+    std::atomic<size_t> running_{};
+    std::atomic<size_t> retiring_{};
+    std::atomic_bool stopped_{};
+    const thread_priority priority_;
+    const processor_set processors_;
+    const size_t minimum_;
+    const bool adaptive_;
 
-    // These are not thread safe.
+    // These are protected by mutex.
     std::vector<thread> threads_{};
+    size_t spawned_{};
+    mutable std::mutex mutex_{};
+
+    // These are accessed only by the (serial) sampler.
+    std::unique_ptr<asio::steady_timer> timer_{};
+    size_t maximum_{};
+    steady_clock::duration threshold_{};
+    size_t idle_{};
+
+    // This is not thread safe.
     work_guard work_;
 };
 
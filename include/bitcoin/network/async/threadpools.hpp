@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_THREADPOOLS_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_THREADPOOLS_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/asio.hpp>
+#include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/threadpool.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe except stop/join, non-virtual.
+/// A collection of single threaded threadpools, each with its own I/O context
+/// (service). Services are assigned round robin, so that objects created on
+/// them (sockets, strands and timers) are pinned to one thread and do not
+/// contend on a shared scheduler.
+class BCT_API threadpools final
+{
+public:
+    DELETE_COPY_MOVE(threadpools);
+
+    /// Construct the specified number of single threaded threadpools.
+    /// Pools are pinned to processors in rotation, if any are specified.
+    threadpools(size_t number_pools=zero,
+        thread_priority priority=thread_priority::normal,
+        const processor_set& processors={}) NOEXCEPT;
+
+    /// Stop and join threads.
+    ~threadpools() NOEXCEPT;
+
+    /// Destroy the work keep-alive of each pool. Safe to call from any thread.
+    void stop() NOEXCEPT;
+
+    /// Block until all threads in all pools terminate.
+    /// Returns false if called from within any pool (would deadlock).
+    bool join() NOEXCEPT;
+
+    /// Block until all threads in all pools terminate or the deadline passes,
+    /// at which point remaining services are stopped (work abandoned).
+    bool join(const steady_clock::time_point& deadline) NOEXCEPT;
+
+    /// The number of pools (zero implies none, service() must not be used).
+    size_t size() const NOEXCEPT;
+
+    /// The next service in round robin order (thread safe).
+    asio::io_context& service() NOEXCEPT;
+
+    /// The service of the indexed pool, index must be less than size().
+    asio::io_context& service(size_t index) NOEXCEPT;
+
+private:
+    // These are thread safe.
+    std::vector<std::unique_ptr<threadpool>> pools_{};
+    std::atomic<size_t> next_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_THROTTLE_HPP
+#define LIBBITCOIN_NETWORK_ASYNC_THROTTLE_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe.
+/// Token bucket, holding up to the configured number of tokens, replenished
+/// continuously at that number per period. Zero tokens implies unlimited.
+class BCT_API throttle
+{
+public:
+    typedef steady_clock::duration duration;
+    typedef steady_clock::time_point time_point;
+
+    DEFAULT_COPY_MOVE_DESTRUCT(throttle);
+
+    /// Unlimited throttle.
+    throttle() NOEXCEPT;
+
+    /// Throttle to tokens per period (burst of tokens), starts full.
+    throttle(size_t tokens, const duration& period) NOEXCEPT;
+
+    /// True if the throttle is not limited.
+    bool unlimited() const NOEXCEPT;
+
+    /// True if the bucket is full at the given time (idle).
+    bool full(const time_point& now=steady_clock::now()) NOEXCEPT;
+
+    /// Consume tokens if available at the given time, false if not.
+    /// A request for more tokens than the burst succeeds only when full,
+    /// and leaves the bucket empty.
+    bool consume(size_t tokens=one,
+        const time_point& now=steady_clock::now()) NOEXCEPT;
+
+    /// Time until the tokens are available (zero if now available).
+    duration delay(size_t tokens=one,
+        const time_point& now=steady_clock::now()) NOEXCEPT;
+
+private:
+    void refill(const time_point& now) NOEXCEPT;
+
+    // These are thread safe.
+    size_t limit_;
+    duration period_;
+
+    // These are not thread safe.
+    size_t tokens_;
+    time_point updated_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
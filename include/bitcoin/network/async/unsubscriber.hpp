@@ -20,10 +20,11 @@
 #define LIBBITCOIN_NETWORK_ASYNC_UNSUBSCRIBER_HPP
 
 #include <functional>
-#include <list>
 #include <utility>
+#include <vector>
 #include <bitcoin/network/async/asio.hpp>
 #include <bitcoin/network/async/handlers.hpp>
+#include <bitcoin/network/async/move_handler.hpp>
 #include <bitcoin/network/define.hpp>
 
 namespace libbitcoin {
@@ -37,15 +38,19 @@ class unsubscriber final
 public:
     DELETE_COPY_MOVE(unsubscriber);
 
+    /// Copyable handler, for external declarations.
     typedef std::function<bool(const code&, Args...)> handler;
 
+    /// Retained handler, move-only and stored inline when small.
+    typedef move_handler<bool(const code&, Args...)> callback;
+
     // Strand is only used for assertions.
     unsubscriber(asio::strand& strand) NOEXCEPT;
     ~unsubscriber() NOEXCEPT;
 
     /// If stopped, handler is invoked with error::subscriber_stopped.
     /// Otherwise handler retained. Subscription code is also returned here.
-    code subscribe(handler&& handler) NOEXCEPT;
+    code subscribe(callback&& handler) NOEXCEPT;
 
     /// Invoke each handler in order with specified arguments.
     /// Handler return true for resubscription, otherwise it is desubscribed.
@@ -57,16 +62,19 @@ public:
     /// Invoke each handler in order, with default arguments, then drop all.
     void stop_default(const code& ec) NOEXCEPT;
 
-    /// The list size.
+    /// The number of subscriptions (tombstones are counted while notifying).
     size_t size() const NOEXCEPT;
 
 private:
+    void compact() NOEXCEPT;
+
     // This is thread safe.
     asio::strand& strand_;
 
     // These are not thread safe.
     bool stopped_{ false };
-    std::list<handler> queue_{};
+    size_t depth_{};
+    std::vector<callback> queue_{};
 };
 
 } // namespace network
@@ -85,6 +85,9 @@ public:
     messages::address_item to_address_item(uint32_t timestamp,
         uint64_t services) const NOEXCEPT;
 
+    /// Authority converted to the compact ip/port key used by hosts.
+    messages::address_key to_key() const NOEXCEPT;
+
     /// Operators.
     /// -----------------------------------------------------------------------
 
@@ -120,12 +123,14 @@ typedef std::vector<authority> authorities;
 
 namespace std
 {
+/// Hashes the 16 byte address only, as equality treats zero port as *.
 template<>
 struct hash<bc::network::config::authority>
 {
     size_t operator()(const bc::network::config::authority& value) const NOEXCEPT
     {
-        return std::hash<std::string>{}(value.to_literal());
+        return std::hash<bc::network::messages::ip_address>{}(
+            value.to_ip_address());
     }
 };
 } // namespace std
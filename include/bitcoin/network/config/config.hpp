@@ -22,6 +22,7 @@
 #include <bitcoin/network/config/address.hpp>
 #include <bitcoin/network/config/authority.hpp>
 #include <bitcoin/network/config/endpoint.hpp>
+#include <bitcoin/network/config/subnets.hpp>
 #include <bitcoin/network/config/utilities.hpp>
 
 #endif
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_CONFIG_SUBNETS_HPP
+#define LIBBITCOIN_NETWORK_CONFIG_SUBNETS_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/config/authority.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace config {
+
+/// Binary prefix trie of authorities, compiled once for O(prefix) matching.
+/// Matching is equivalent to authority == address_item, with zero port as *
+/// and zero CIDR as host. IPv4 and IPv6 are compiled to independent tries.
+/// Not thread safe for construction, thread safe for matching.
+class BCT_API subnets
+{
+public:
+    /// A compiled prefix (as authority, without port), cidr is relative to
+    /// the (IPv4-mapped) address family and zero implies host.
+    struct prefix
+    {
+        messages::ip_address ip;
+        uint8_t cidr;
+    };
+
+    typedef std::vector<prefix> prefixes;
+
+    DEFAULT_COPY_MOVE_DESTRUCT(subnets);
+
+    subnets() NOEXCEPT;
+    subnets(const authorities& values) NOEXCEPT;
+
+    /// Compile prefixes directly (bulk lists, no authority parse).
+    subnets(const prefixes& values) NOEXCEPT;
+
+    /// Count of compiled authorities.
+    size_t size() const NOEXCEPT;
+
+    /// True if no authorities are compiled.
+    bool empty() const NOEXCEPT;
+
+    /// True if the item is contained by any compiled authority.
+    bool contains(const messages::address_item& item) const NOEXCEPT;
+
+private:
+    // Child offsets into the trie (zero implies none, as root is never a
+    // child), and an offset into ports_ (zero implies not terminal).
+    struct node
+    {
+        uint32_t child[2];
+        uint32_t ports;
+    };
+
+    typedef std::vector<node> trie;
+    typedef std::vector<uint16_t> ports;
+
+    void insert(const messages::ip_address& ip, uint8_t cidr,
+        uint16_t port) NOEXCEPT;
+    bool match(const node& node, uint16_t port) const NOEXCEPT;
+    bool contains(const trie& nodes, const messages::ip_address& ip,
+        size_t offset, size_t bits, uint16_t port) const NOEXCEPT;
+
+    // These are thread safe (const after construct).
+    trie v4_{ node{} };
+    trie v6_{ node{} };
+    std::vector<ports> ports_{ ports{} };
+    size_t size_{};
+};
+
+} // namespace config
+} // namespace network
+} // namespace libbitcoin
+
+#endif
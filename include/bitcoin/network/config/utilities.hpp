@@ -64,6 +64,17 @@ constexpr bool is_v6(const messages::ip_address& ip) NOEXCEPT
     return !is_v4(ip);
 }
 
+/// Network group is /16 for IPv4 (mapped) and /32 for IPv6 addresses.
+constexpr uint32_t to_group(const messages::ip_address& ip) NOEXCEPT
+{
+    constexpr auto at = ipv6_size - ipv4_size;
+    if (is_v4(ip))
+        return (uint32_t{ ip[at] } << 8) | ip[add1(at)];
+
+    return (uint32_t{ ip[0] } << 24) | (uint32_t{ ip[1] } << 16) |
+        (uint32_t{ ip[2] } << 8) | ip[3];
+}
+
 /// Member if subnet addresses contain host.
 BCT_API bool is_member(const asio::address& ip, const asio::address& subnet,
     uint8_t cidr) NOEXCEPT;
@@ -54,10 +54,22 @@
 #define WITH_LOGR
 #define WITH_LOGF
 #define WITH_LOGQ
+////#define WITH_PROBES
+////#define WITH_TRACES
+////#define WITH_USDT
 
 #if defined(WITH_EVENTS)
     #define HAVE_EVENTS
 #endif
+#if defined(WITH_PROBES)
+    #define HAVE_PROBES
+#endif
+#if defined(WITH_TRACES)
+    #define HAVE_TRACES
+#endif
+#if defined(WITH_USDT) && __has_include(<sys/sdt.h>)
+    #define HAVE_USDT
+#endif
 #if defined(WITH_LOGGING)
     #define HAVE_LOGGING
     #if defined(WITH_LOGO)
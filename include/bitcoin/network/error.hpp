@@ -114,6 +114,8 @@ enum error_t
     channel_dropped,
     channel_expired,
     channel_inactive,
+    channel_congested,
+    channel_evicted,
     channel_stopped,
     service_stopped,
     subscriber_exists,
@@ -35,12 +35,12 @@ template <typename Key, typename... Args>
 desubscriber<Key, Args...>::~desubscriber() NOEXCEPT
 {
     // Destruction may not occur on the strand.
-    BC_ASSERT_MSG(map_.empty(), "desubscriber is not cleared");
+    BC_ASSERT_MSG(index_.empty(), "desubscriber is not cleared");
 }
 
 template <typename Key, typename... Args>
 code desubscriber<Key, Args...>::
-subscribe(handler&& handler, const Key& key) NOEXCEPT
+subscribe(callback&& handler, const Key& key) NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
 
@@ -50,14 +50,15 @@ subscribe(handler&& handler, const Key& key) NOEXCEPT
         /*bool*/ handler(error::subscriber_stopped, Args{}...);
         return error::subscriber_stopped;
     }
-    else if (map_.contains(key))
+    else if (index_.contains(key))
     {
         /*bool*/ handler(error::subscriber_exists, Args{}...);
         return error::subscriber_exists;
     }
     else
     {
-        map_.emplace(key, std::move(handler));
+        index_.emplace(key, entries_.size());
+        entries_.push_back({ key, std::move(handler) });
         return error::success;
     }
     BC_POP_WARNING()
@@ -72,21 +73,17 @@ notify(const code& ec, const Args&... args) NOEXCEPT
     if (stopped_)
         return;
 
-    // Already on the strand to protect map_, so execute each handler.
-    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    for (auto it = map_.begin(); it != map_.end();)
+    // Subscriptions made by handlers are not notified until the next call.
+    ++depth_;
+    for (size_t slot = 0, end = entries_.size(); !stopped_ && slot < end;
+        ++slot)
     {
-        // Invoke handler and handle result.
-        if (!it->second(ec, args...))
-        {
-            it = map_.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        if (entries_[slot].handler)
+            invoke(slot, ec, args...);
     }
-    BC_POP_WARNING()
+    --depth_;
+
+    compact();
 }
 
 template <typename Key, typename... Args>
@@ -98,18 +95,21 @@ notify_one(const Key& key, const code& ec, const Args&... args) NOEXCEPT
     if (stopped_)
         return false;
 
-    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    const auto it = map_.find(key);
-    if (it != map_.end())
-    {
-        // Invoke handler and handle result.
-        if (!it->second(ec, args...))
-            map_.erase(it);
+    const auto it = index_.find(key);
+    if (it == index_.end())
+        return false;
 
-        return true;
+    // An empty handler here is being invoked (reentrant), so is not repeated.
+    const auto slot = it->second;
+    if (entries_[slot].handler)
+    {
+        ++depth_;
+        invoke(slot, ec, args...);
+        --depth_;
+        compact();
     }
-    BC_POP_WARNING()
-    return false;
+
+    return true;
 }
 
 template <typename Key, typename... Args>
@@ -124,7 +124,9 @@ stop(const code& ec, const Args&... args) NOEXCEPT
 
     notify(ec, args...);
     stopped_ = true;
-    map_.clear();
+    entries_.clear();
+    index_.clear();
+    tombstones_ = zero;
 }
 
 template <typename Key, typename... Args>
@@ -140,7 +142,66 @@ size_t desubscriber<Key, Args...>::
 size() const NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
-    return map_.size();
+    return index_.size();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+template <typename Key, typename... Args>
+bool desubscriber<Key, Args...>::
+invoke(size_t slot, const code& ec, const Args&... args) NOEXCEPT
+{
+    // Invoke from a local, as the handler may subscribe (reallocation).
+    auto handler = std::move(entries_[slot].handler);
+    entries_[slot].handler = callback{};
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    const auto resubscribe = handler(ec, args...);
+    BC_POP_WARNING()
+
+    // Entries are cleared if the handler stopped the subscriber.
+    if (stopped_)
+        return false;
+
+    if (resubscribe)
+    {
+        entries_[slot].handler = std::move(handler);
+        return true;
+    }
+
+    index_.erase(entries_[slot].key);
+    ++tombstones_;
+    return false;
+}
+
+// Removal preserves subscription order, amortized over desubscriptions.
+template <typename Key, typename... Args>
+void desubscriber<Key, Args...>::
+compact() NOEXCEPT
+{
+    if (!is_zero(depth_) || (tombstones_ * two) <= entries_.size())
+        return;
+
+    size_t to{};
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    for (size_t from = 0; from < entries_.size(); ++from)
+    {
+        if (!entries_[from].handler)
+            continue;
+
+        if (to != from)
+        {
+            entries_[to] = std::move(entries_[from]);
+            index_[entries_[to].key] = to;
+        }
+
+        ++to;
+    }
+    BC_POP_WARNING()
+
+    entries_.erase(std::next(entries_.begin(), to), entries_.end());
+    tombstones_ = zero;
 }
 
 } // namespace network
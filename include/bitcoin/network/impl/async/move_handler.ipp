@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_ASYNC_MOVE_HANDLER_IPP
+#define LIBBITCOIN_NETWORK_ASYNC_MOVE_HANDLER_IPP
+
+#include <new>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+// Operations tables.
+// ----------------------------------------------------------------------------
+
+template <typename Result, typename... Args, size_t Capacity>
+template <typename Function>
+struct move_handler<Result(Args...), Capacity>::inline_operations
+{
+    static Result invoke(void* data, Args&&... args)
+    {
+        return (*static_cast<Function*>(data))(std::forward<Args>(args)...);
+    }
+
+    static void move(void* to, void* from)
+    {
+        const auto source = static_cast<Function*>(from);
+        new (to) Function(std::move(*source));
+        source->~Function();
+    }
+
+    static void destroy(void* data)
+    {
+        static_cast<Function*>(data)->~Function();
+    }
+
+    static constexpr operations table{ &invoke, &move, &destroy, true };
+};
+
+template <typename Result, typename... Args, size_t Capacity>
+template <typename Function>
+struct move_handler<Result(Args...), Capacity>::allocated_operations
+{
+    static Function*& get(void* data)
+    {
+        return *static_cast<Function**>(data);
+    }
+
+    static Result invoke(void* data, Args&&... args)
+    {
+        return (*get(data))(std::forward<Args>(args)...);
+    }
+
+    static void move(void* to, void* from)
+    {
+        new (to) Function*(get(from));
+    }
+
+    static void destroy(void* data)
+    {
+        delete get(data);
+    }
+
+    static constexpr operations table{ &invoke, &move, &destroy, false };
+};
+
+// Construct.
+// ----------------------------------------------------------------------------
+
+template <typename Result, typename... Args, size_t Capacity>
+move_handler<Result(Args...), Capacity>::
+move_handler() NOEXCEPT
+{
+}
+
+template <typename Result, typename... Args, size_t Capacity>
+move_handler<Result(Args...), Capacity>::
+move_handler(std::nullptr_t) NOEXCEPT
+{
+}
+
+template <typename Result, typename... Args, size_t Capacity>
+move_handler<Result(Args...), Capacity>::
+move_handler(move_handler&& other) NOEXCEPT
+  : operations_(other.operations_)
+{
+    if (!is_null(operations_))
+    {
+        operations_->move(buffer_, other.buffer_);
+        other.operations_ = nullptr;
+    }
+}
+
+template <typename Result, typename... Args, size_t Capacity>
+move_handler<Result(Args...), Capacity>&
+move_handler<Result(Args...), Capacity>::
+operator=(move_handler&& other) NOEXCEPT
+{
+    if (this == &other)
+        return *this;
+
+    reset();
+    operations_ = other.operations_;
+    if (!is_null(operations_))
+    {
+        operations_->move(buffer_, other.buffer_);
+        other.operations_ = nullptr;
+    }
+
+    return *this;
+}
+
+template <typename Result, typename... Args, size_t Capacity>
+move_handler<Result(Args...), Capacity>::
+~move_handler() NOEXCEPT
+{
+    reset();
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+template <typename Result, typename... Args, size_t Capacity>
+Result move_handler<Result(Args...), Capacity>::
+operator()(Args... args) const NOEXCEPT
+{
+    BC_ASSERT_MSG(!is_null(operations_), "empty handler");
+    return operations_->invoke(buffer_, std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args, size_t Capacity>
+move_handler<Result(Args...), Capacity>::
+operator bool() const NOEXCEPT
+{
+    return !is_null(operations_);
+}
+
+template <typename Result, typename... Args, size_t Capacity>
+bool move_handler<Result(Args...), Capacity>::
+inlined() const NOEXCEPT
+{
+    return !is_null(operations_) && operations_->inlined;
+}
+
+// private
+template <typename Result, typename... Args, size_t Capacity>
+void move_handler<Result(Args...), Capacity>::
+reset() NOEXCEPT
+{
+    if (!is_null(operations_))
+    {
+        operations_->destroy(buffer_);
+        operations_ = nullptr;
+    }
+}
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
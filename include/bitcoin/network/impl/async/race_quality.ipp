@@ -57,15 +57,24 @@ start(handler&& complete) NOEXCEPT
     if (running())
         return false;
 
-    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    complete_ = std::make_shared<handler>(std::forward<handler>(complete));
-    BC_POP_WARNING()
-
+    complete_ = std::move(complete);
     success_ = false;
     runners_ = size_;
     return true;
 }
 
+template <typename... Args>
+bool race_quality<Args...>::
+start(size_t size, handler&& complete) NOEXCEPT
+{
+    // false implies logic error.
+    if (running())
+        return false;
+
+    size_ = size;
+    return start(std::move(complete));
+}
+
 template <typename... Args>
 bool race_quality<Args...>::
 finish(const Args&... args) NOEXCEPT
@@ -117,12 +126,14 @@ invoke() NOEXCEPT
     if (!complete_)
         return false;
 
-    // Invoke completion handler.
-    invoker(*complete_, args_, sequence{});
-
-    // Clear all resources.
-    complete_.reset();
+    // Clear all resources before invocation, as the handler may restart.
+    const auto complete = std::move(complete_);
+    const auto args = std::move(args_);
+    complete_ = nullptr;
     args_ = {};
+
+    // Invoke completion handler.
+    invoker(complete, args, sequence{});
     return true;
 }
 
@@ -56,10 +56,7 @@ start(handler&& complete) NOEXCEPT
     if (running())
         return false;
 
-    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    complete_ = std::make_shared<handler>(std::forward<handler>(complete));
-    BC_POP_WARNING()
-
+    complete_ = std::move(complete);
     runners_ = Size;
     return true;
 }
@@ -110,12 +107,14 @@ invoke() NOEXCEPT
     if (!complete_)
         return false;
 
-    // Invoke completion handler.
-    invoker(*complete_, args_, sequence{});
-
-    // Clear all resources.
-    complete_.reset();
+    // Clear all resources before invocation, as the handler may restart.
+    const auto complete = std::move(complete_);
+    const auto args = std::move(args_);
+    complete_ = nullptr;
     args_ = {};
+
+    // Invoke completion handler.
+    invoker(complete, args, sequence{});
     return true;
 }
 
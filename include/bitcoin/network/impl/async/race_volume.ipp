@@ -57,11 +57,8 @@ start(handler&& sufficient, handler&& complete) NOEXCEPT
     if (running())
         return false;
 
-    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    sufficient_ = std::make_shared<handler>(std::forward<handler>(sufficient));
-    complete_ = std::make_shared<handler>(std::forward<handler>(complete));
-    BC_POP_WARNING()
-
+    sufficient_ = std::move(sufficient);
+    complete_ = std::move(complete);
     runners_ = size_;
     return true;
 }
@@ -79,24 +76,43 @@ finish(size_t count) NOEXCEPT
     {
         // Invoke sufficient and clear resources before race is finished.
         if (count >= required_)
-        {
-            (*sufficient_)(Success);
-            sufficient_.reset();
-        }
+            notify(Success);
         else if (runners_ == one)
-        {
-            (*sufficient_)(Fail);
-            sufficient_.reset();
-        }
+            notify(Fail);
     }
 
     // false invoke implies logic error.
     return invoke();
 }
 
+template <error::error_t Success, error::error_t Fail>
+bool race_volume<Success, Fail>::
+sufficient(size_t count) NOEXCEPT
+{
+    // false implies logic error.
+    if (!running())
+        return false;
+
+    // Insufficiency is determined only by the last finisher.
+    if (sufficient_ && count >= required_)
+        notify(Success);
+
+    return true;
+}
+
 // private
 // ----------------------------------------------------------------------------
 
+template <error::error_t Success, error::error_t Fail>
+void race_volume<Success, Fail>::
+notify(const code& ec) NOEXCEPT
+{
+    // Clear before invocation, as sufficient is invoked at most once.
+    const auto notifier = std::move(sufficient_);
+    sufficient_ = nullptr;
+    notifier(ec);
+}
+
 template <error::error_t Success, error::error_t Fail>
 bool race_volume<Success, Fail>::
 invoke() NOEXCEPT
@@ -113,11 +129,12 @@ invoke() NOEXCEPT
     if (!complete_)
         return false;
 
-    // Invoke completion handler, always success.
-    (*complete_)(Success);
+    // Clear resources before invocation, as the handler may restart.
+    const auto complete = std::move(complete_);
+    complete_ = nullptr;
 
-    // Clear resources.
-    complete_.reset();
+    // Invoke completion handler, always success.
+    complete(Success);
     return true;
 }
 
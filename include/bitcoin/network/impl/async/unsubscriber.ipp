@@ -42,7 +42,7 @@ unsubscriber<Args...>::
 
 template <typename... Args>
 code unsubscriber<Args...>::
-subscribe(handler&& handler) NOEXCEPT
+subscribe(callback&& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
 
@@ -70,20 +70,26 @@ notify(const code& ec, const Args&... args) NOEXCEPT
         return;
 
     // Already on the strand to protect queue_, so execute each handler.
+    // Each handler is moved out for invocation, as it may subscribe (growing
+    // the queue) or notify, leaving an empty slot (tombstone) if desubscribed.
     BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    for (auto it = queue_.begin(); it != queue_.end();)
+    ++depth_;
+    for (size_t index = 0; !stopped_ && index < queue_.size(); ++index)
     {
-        // Invoke handler and handle result.
-        if (!(*it)(ec, args...))
-        {
-            it = queue_.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        // Skip tombstones and handlers in reentrant invocation.
+        if (!queue_[index])
+            continue;
+
+        // Invoke handler and handle result (queue is cleared by stop).
+        auto handler = std::move(queue_[index]);
+        queue_[index] = callback{};
+        if (handler(ec, args...) && !stopped_)
+            queue_[index] = std::move(handler);
     }
+    --depth_;
     BC_POP_WARNING()
+
+    compact();
 }
 
 template <typename... Args>
@@ -117,6 +123,25 @@ size() const NOEXCEPT
     return queue_.size();
 }
 
+// private
+// ----------------------------------------------------------------------------
+
+// Retained handlers are compacted in order, once the outermost notify ends.
+template <typename... Args>
+void unsubscriber<Args...>::
+compact() NOEXCEPT
+{
+    if (!is_zero(depth_))
+        return;
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::erase_if(queue_, [](const callback& handler) NOEXCEPT
+    {
+        return !handler;
+    });
+    BC_POP_WARNING()
+}
+
 } // namespace network
 } // namespace libbitcoin
 
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_AGGREGATOR_HPP
+#define LIBBITCOIN_NETWORK_LOG_AGGREGATOR_HPP
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/logger.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Optional aggregation of logger events for scraping in the text exposition
+/// format (prometheus/openmetrics). Event values are recorded to histograms
+/// of log-linear buckets (hdr style), four linear buckets per power of two,
+/// so that quantiles are within 25% over the full uint64_t range. Channel
+/// stops are counted by stop code. When subscribed, the aggregator must
+/// remain in scope until the logger is stopped.
+class BCT_API aggregator final
+{
+public:
+    static constexpr size_t linear = 4;
+    static constexpr size_t buckets = linear + (64u - 2u) * linear;
+
+    DELETE_COPY_MOVE(aggregator);
+
+    aggregator() NOEXCEPT;
+
+    /// Subscribe to events of the logger.
+    void subscribe(logger& log) NOEXCEPT;
+
+    /// Record an event value (invoked by the subscription).
+    void record(uint8_t event, uint64_t value) NOEXCEPT;
+
+    /// Count of values recorded for the event.
+    uint64_t count(uint8_t event) const NOEXCEPT;
+
+    /// Upper bound of the bucket at the quantile [0..1], zero if empty.
+    uint64_t quantile(uint8_t event, double fraction) const NOEXCEPT;
+
+    /// All events in the text exposition format.
+    std::string exposition() const NOEXCEPT;
+
+    /// Bucket of the value, and the largest value in the bucket.
+    static size_t to_bucket(uint64_t value) NOEXCEPT;
+    static uint64_t to_upper(size_t bucket) NOEXCEPT;
+
+private:
+    struct histogram
+    {
+        uint64_t count{};
+        uint64_t sum{};
+        std::array<uint64_t, buckets> counts{};
+    };
+
+    // These are protected by mutex.
+    std::map<uint8_t, histogram> histograms_{};
+    std::map<uint64_t, uint64_t> stops_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_ARGUMENTS_HPP
+#define LIBBITCOIN_NETWORK_LOG_ARGUMENTS_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/record_queue.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Raw log arguments for deferred (binary) formatting. Each argument is
+/// appended to the fixed buffer of one log record as a tag byte and its raw
+/// value, so the caller pays a copy rather than formatting. Text and bytes
+/// that do not fit are truncated and other values omitted (rendered empty).
+/// Decoding requires only the bytes and the pattern, so records may also be
+/// persisted and decoded offline.
+class BCT_API arguments final
+{
+public:
+    static constexpr size_t capacity = record_queue::text_size;
+
+    arguments() NOEXCEPT;
+
+    /// Append an integral, text, code or bytes (rendered as base16).
+    template <typename Type>
+    void add(const Type& value) NOEXCEPT
+    {
+        if constexpr (std::is_same_v<Type, code>)
+            add_code(value.value(), value.category().name());
+        else if constexpr (std::is_same_v<Type, bool>)
+            add_unsigned(value ? 1u : 0u);
+        else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+            add_signed(value);
+        else if constexpr (std::is_integral_v<Type>)
+            add_unsigned(value);
+        else if constexpr (std::is_convertible_v<const Type&, std::string_view>)
+            add_text(value);
+        else
+            add_bytes(value);
+    }
+
+    /// The encoded arguments.
+    std::string_view data() const NOEXCEPT;
+
+    /// Replace each "{}" of the pattern with the next decoded argument.
+    static std::string format(const char* pattern,
+        std::string_view data) NOEXCEPT;
+
+private:
+    void add_unsigned(uint64_t value) NOEXCEPT;
+    void add_signed(int64_t value) NOEXCEPT;
+    void add_text(std::string_view value) NOEXCEPT;
+    void add_bytes(const system::data_slice& value) NOEXCEPT;
+    void add_code(int value, std::string_view category) NOEXCEPT;
+
+    bool reserve(size_t bytes) NOEXCEPT;
+    void put(uint8_t byte) NOEXCEPT;
+    void put(uint64_t value, size_t bytes) NOEXCEPT;
+    void put(std::string_view value) NOEXCEPT;
+
+    // These are not thread safe.
+    std::array<char, capacity> buffer_{};
+    size_t size_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_EVENTS_HPP
+#define LIBBITCOIN_NETWORK_LOG_EVENTS_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace events {
+
+// Could use class enum, but we want simple conversion to uint8_t.
+enum : uint8_t
+{
+    ping_round_trip,    // ping sent to pong received (span, nanoseconds)
+    handshake,          // channel creation to handshake (span, nanoseconds)
+    outbound_connect,   // outbound channel started (count)
+    inbound_accept,     // inbound channel started (count)
+    channel_stop,       // channel stopped (value is the stop error code)
+    network_queued,     // network strand post to execute (span, nanoseconds)
+    network_executed,   // network strand handler execution (span, nanoseconds)
+    channel_queued,     // channel strand post to execute (span, nanoseconds)
+    channel_executed    // channel strand handler execution (span, nanoseconds)
+};
+
+} // namespace events
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_FORMATS_HPP
+#define LIBBITCOIN_NETWORK_LOG_FORMATS_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace formats {
+
+// Could use class enum, but we want simple conversion to uint16_t.
+// Identifiers are persisted in binary logs, so append only.
+enum : uint16_t
+{
+    text,               // preformatted text (not binary)
+    invalid_payload,    // command, authority, payload (hex), code
+    invalid_magic       // magic, authority
+};
+
+/// Pattern of the format, with "{}" placeholders for arguments in order.
+/// Unknown formats have an empty pattern.
+BCT_API const char* to_pattern(uint16_t format) NOEXCEPT;
+
+} // namespace formats
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -42,22 +42,29 @@ enum : uint8_t
 };
 
 // LOG_ONLY() is insufficient for individual disablement.
+// Defined levels are also subject to the logger's runtime mask, which is
+// tested before the writer (and its stream) is constructed.
 #if defined(HAVE_LOGGING)
     #define LOG_ONLY(name) name
     #define LOG(level_, message) \
         BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT) \
-        log.write(levels::level_) << message << std::endl; \
+        if (log.enabled(levels::level_)) \
+            log.write(levels::level_) << message << std::endl; \
         BC_POP_WARNING()
+    #define LOGB(level_, format_, ...) \
+        log.record(levels::level_, formats::format_, __VA_ARGS__)
 #else
     #define LOG_ONLY(name)
     #define LOG(level, message)
+    #define LOGB(level, format, ...)
 #endif
 
 #if defined(HAVE_LOGO)
     constexpr auto objects_defined = true;
     #define LOGO(message) \
         BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT) \
-        log_.write(levels::objects) << message << std::endl; \
+        if (log_.enabled(levels::objects)) \
+            log_.write(levels::objects) << message << std::endl; \
         BC_POP_WARNING()
 #else
     constexpr auto objects_defined = false;
@@ -107,9 +114,11 @@ enum : uint8_t
 #if defined(HAVE_LOGR)
     constexpr auto remote_defined = true;
     #define LOGR(message) LOG(remote, message)
+    #define LOGRB(format, ...) LOGB(remote, format, __VA_ARGS__)
 #else
     constexpr auto remote_defined = false;
     #define LOGR(message)
+    #define LOGRB(format, ...)
 #endif
 
 #if defined(HAVE_LOGF)
@@ -19,11 +19,19 @@
 #ifndef LIBBITCOIN_NETWORK_LOG_LOG_HPP
 #define LIBBITCOIN_NETWORK_LOG_LOG_HPP
 
+#include <bitcoin/network/log/aggregator.hpp>
+#include <bitcoin/network/log/arguments.hpp>
 #include <bitcoin/network/log/capture.hpp>
+#include <bitcoin/network/log/events.hpp>
+#include <bitcoin/network/log/formats.hpp>
 #include <bitcoin/network/log/levels.hpp>
 #include <bitcoin/network/log/logger.hpp>
+#include <bitcoin/network/log/probe.hpp>
+#include <bitcoin/network/log/record_queue.hpp>
 #include <bitcoin/network/log/reporter.hpp>
 #include <bitcoin/network/log/timer.hpp>
+#include <bitcoin/network/log/tracer.hpp>
 #include <bitcoin/network/log/tracker.hpp>
+#include <bitcoin/network/log/usdt.hpp>
 
 #endif
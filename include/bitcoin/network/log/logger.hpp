@@ -22,11 +22,15 @@
 #include <atomic>
 #include <ostream>
 #include <sstream>
+#include <string_view>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/arguments.hpp>
+#include <bitcoin/network/log/formats.hpp>
 #include <bitcoin/network/log/levels.hpp>
+#include <bitcoin/network/log/record_queue.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -35,6 +39,9 @@ namespace network {
 /// Must be kept in scope until last logger::writer instance is destroyed.
 /// Emits streaming writer that commits message upon destruct.
 /// Provides subscription to std::string message commitments.
+/// Committed messages are queued without locks or allocation as fixed size
+/// records, which the logger thread drains to subscribers. Messages are
+/// dropped (and counted) when the queue is full.
 /// Stoppable with optional termination code and message.
 class BCT_API logger final
 {
@@ -49,6 +56,13 @@ public:
     /// Use to initialize timer events.
     static time now() NOEXCEPT { return fine_clock::now(); }
 
+    /// Capacity of the message record queue.
+    static constexpr size_t record_capacity = 4'096;
+
+    /// Runtime level mask (bit per level), all levels enabled by default.
+    static constexpr uint32_t all_levels = max_uint32;
+    static constexpr size_t mask_bits = sizeof(uint32_t) * byte_bits;
+
     /// Streaming log writer (std::ostringstream), not thread safe.
     class writer final
     {
@@ -64,7 +78,7 @@ public:
         {
             // log_.notify() cannot be non-const in destructor.
             BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-            log_.notify(error::success, level_, stream_.str());
+            log_.notify(error::success, level_, stream_.view());
             BC_POP_WARNING()
         }
 
@@ -100,6 +114,35 @@ public:
     /// require shared logger instances, an unnecessary complication/cost.
     writer write(uint8_t level) const NOEXCEPT;
 
+    /// Queue a binary message of raw arguments (use LOGB), formatted by the
+    /// logger thread upon delivery (see formats).
+    template <typename... Args>
+    void record(uint8_t level, uint16_t format,
+        const Args&... args) const NOEXCEPT
+    {
+        if (!enabled(level))
+            return;
+
+        arguments values{};
+        (values.add(args), ...);
+        notify(level, format, values.data());
+    }
+
+    /// True if the level is enabled by the runtime mask (relaxed load).
+    /// Log macros test this before constructing a writer, so a disabled level
+    /// costs only the load. Compiled-out levels (HAVE_LOG*) cost nothing.
+    inline bool enabled(uint8_t level) const NOEXCEPT
+    {
+        const auto bit = uint32_t{ 1 } << (level % mask_bits);
+        return level < mask_bits &&
+            !is_zero(mask_.load(std::memory_order_relaxed) & bit);
+    }
+
+    /// Enable or disable a level, or set/get the full runtime level mask.
+    void enable(uint8_t level, bool value=true) NOEXCEPT;
+    void set_mask(uint32_t mask) NOEXCEPT;
+    uint32_t mask() const NOEXCEPT;
+
     /// Fire event with optional value, recorded with current time.
     void fire(uint8_t event, uint64_t value=zero) const NOEXCEPT;
 
@@ -111,6 +154,9 @@ public:
     void subscribe_messages(message_notifier&& handler) NOEXCEPT;
     void subscribe_events(event_notifier&& handler) NOEXCEPT;
 
+    /// The number of messages dropped because the record queue was full.
+    size_t dropped() const NOEXCEPT;
+
     /// Stop subscribers/pool with final message/empty posted to subscribers.
     void stop(const code& ec, const std::string& message, uint8_t level) NOEXCEPT;
     void stop(const std::string& message, uint8_t level=levels::quit) NOEXCEPT;
@@ -119,12 +165,16 @@ public:
 protected:
     bool stranded() const NOEXCEPT;
     void notify(const code& ec, uint8_t level,
-        std::string&& message) const NOEXCEPT;
+        std::string_view message) const NOEXCEPT;
+    void notify(uint8_t level, uint16_t format,
+        std::string_view data) const NOEXCEPT;
 
 private:
     void do_subscribe_messages(const message_notifier& handler) NOEXCEPT;
     void do_notify_message(const code& ec, uint8_t level, time_t zulu,
         const std::string& message) const NOEXCEPT;
+    void do_drain() const NOEXCEPT;
+    void drain() const NOEXCEPT;
 
     void do_subscribe_events(const event_notifier& handler) NOEXCEPT;
     void do_notify_event(uint8_t event, uint64_t value,
@@ -138,6 +188,9 @@ private:
 
     // These are thread safe.
     std::atomic_bool stopped_{ false };
+    std::atomic<uint32_t> mask_{ all_levels };
+    mutable std::atomic_bool draining_{ false };
+    mutable record_queue records_{ record_capacity };
     BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
     asio::strand strand_{ pool_.service().get_executor() };
     BC_POP_WARNING()
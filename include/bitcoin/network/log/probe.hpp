@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_PROBE_HPP
+#define LIBBITCOIN_NETWORK_LOG_PROBE_HPP
+
+#include <array>
+#include <chrono>
+#include <string_view>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Probed scopes, PROBE(name) requires a point of the same name.
+enum class probe_point : size_t
+{
+    proxy_deserialize,
+    distributor_notify,
+    messages_serialize,
+    hosts_save,
+    session_start,
+    session_handshake,
+    session_channel_started,
+    session_channel_stopped,
+    count
+};
+
+/// Thread safe, non-virtual.
+/// Process-wide latency histograms of probed scopes. Each thread records into
+/// its own counters (single writer, relaxed), which are summed by snapshot, so
+/// recording is free of contention and may be sampled while running.
+class BCT_API probes final
+{
+public:
+    /// Buckets are powers of two of elapsed nanoseconds.
+    static constexpr size_t bucket_count = 64;
+    static constexpr size_t points = static_cast<size_t>(probe_point::count);
+
+    struct histogram
+    {
+        uint64_t count{};
+        uint64_t total{};
+        std::array<uint64_t, bucket_count> buckets{};
+    };
+
+    typedef std::array<histogram, points> profile;
+
+    /// Record elapsed time of the scope into the calling thread's histogram.
+    static void record(probe_point point, const nanoseconds& elapsed) NOEXCEPT;
+
+    /// Sum of the histograms of all threads that have recorded.
+    static profile snapshot() NOEXCEPT;
+
+    /// The name of the probe point.
+    static std::string_view name(probe_point point) NOEXCEPT;
+};
+
+/// Not thread safe, non-virtual.
+/// Records the lifetime of the scope into the histogram of its point.
+class probe final
+{
+public:
+    DELETE_COPY_MOVE(probe);
+
+    inline probe(probe_point point) NOEXCEPT
+      : point_(point), start_(fine_clock::now())
+    {
+    }
+
+    inline ~probe() NOEXCEPT
+    {
+        probes::record(point_, std::chrono::duration_cast<nanoseconds>(
+            fine_clock::now() - start_));
+    }
+
+private:
+    const probe_point point_;
+    const fine_clock::time_point start_;
+};
+
+#if defined(HAVE_PROBES)
+    #define PROBE(name) \
+        const network::probe probe_##name{ network::probe_point::name }
+#else
+    #define PROBE(name)
+#endif
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_RECORD_QUEUE_HPP
+#define LIBBITCOIN_NETWORK_LOG_RECORD_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <string_view>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Bounded lock-free queue of fixed size log records, for any number of
+/// producers and a single consumer (after Vyukov's bounded queue). Each cell
+/// carries a sequence, so a producer claims a cell with one compare-exchange
+/// of the tail and publishes it with a release store, and no allocation
+/// follows construction. When full a record is dropped and counted, rather
+/// than the queue growing. Text over text_size bytes is truncated.
+class BCT_API record_queue final
+{
+public:
+    static constexpr size_t text_size = 480;
+
+    struct record
+    {
+        uint8_t level;
+        uint16_t format;
+        time_t zulu;
+        size_t size;
+        std::array<char, text_size> text;
+
+        std::string_view view() const NOEXCEPT;
+    };
+
+    DELETE_COPY_MOVE(record_queue);
+
+    /// Capacity is rounded up to a power of two (minimum two).
+    record_queue(size_t capacity) NOEXCEPT;
+
+    /// Enqueue a record from any thread, false if full (dropped).
+    /// Text is binary arguments for other than the (zero) text format.
+    bool push(uint8_t level, time_t zulu, std::string_view text,
+        uint16_t format=zero) NOEXCEPT;
+
+    /// Dequeue a record, false if empty (single consumer only).
+    bool pop(record& out) NOEXCEPT;
+
+    /// The number of records dropped because the queue was full.
+    size_t dropped() const NOEXCEPT;
+
+    /// Capacity (in records) of the queue.
+    size_t capacity() const NOEXCEPT;
+
+private:
+    struct cell
+    {
+        std::atomic<size_t> sequence{};
+        record value{};
+    };
+
+    // These are thread safe (const).
+    const size_t mask_;
+    const std::unique_ptr<cell[]> cells_;
+
+    // These are thread safe.
+    alignas(64) std::atomic<size_t> tail_{};
+    alignas(64) std::atomic<size_t> dropped_{};
+
+    // This is protected by single consumer.
+    alignas(64) size_t head_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -19,7 +19,9 @@
 #ifndef LIBBITCOIN_NETWORK_LOG_REPORTER_HPP
 #define LIBBITCOIN_NETWORK_LOG_REPORTER_HPP
 
+#include <utility>
 #include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/events.hpp>
 #include <bitcoin/network/log/levels.hpp>
 #include <bitcoin/network/log/logger.hpp>
 
@@ -36,6 +38,43 @@ public:
     const logger& log;
     void fire(uint8_t event, size_t count=zero) const NOEXCEPT;
     void span(uint8_t event, const logger::time& started) const NOEXCEPT;
+
+    /// Wrap a handler to be posted to a strand, so that its queue delay and
+    /// execution time are spanned to the given events (requires HAVE_PROBES,
+    /// otherwise the handler is returned unwrapped).
+    template <typename Handler>
+    inline auto timed(uint8_t queued, uint8_t executed,
+        Handler&& handler) const NOEXCEPT
+    {
+#if defined(HAVE_PROBES)
+        return [&sink = log, queued, executed, posted = logger::now(),
+            handler = std::forward<Handler>(handler)]() mutable NOEXCEPT
+        {
+            sink.span(queued, posted);
+            const auto started = logger::now();
+            handler();
+            sink.span(executed, started);
+        };
+#else
+        return std::forward<Handler>(handler);
+#endif
+    }
+
+    /// Wrap a handler to be posted to the network strand.
+    template <typename Handler>
+    inline auto network_timed(Handler&& handler) const NOEXCEPT
+    {
+        return timed(events::network_queued, events::network_executed,
+            std::forward<Handler>(handler));
+    }
+
+    /// Wrap a handler to be posted to a channel strand.
+    template <typename Handler>
+    inline auto channel_timed(Handler&& handler) const NOEXCEPT
+    {
+        return timed(events::channel_queued, events::channel_executed,
+            std::forward<Handler>(handler));
+    }
 };
 
 } // namespace network
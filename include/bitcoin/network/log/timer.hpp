@@ -55,10 +55,11 @@ struct timer final
     }
 };
 
-/// Current zulu (utc) time using the wall clock, as time_t.
+/// Current zulu (utc) time using the wall clock, as time_t (coarse if the
+/// coarse clock is running).
 BCT_API time_t zulu_time() NOEXCEPT;
 
-/// Current zulu (utc) time using the wall clock, cast to uint32_t.
+/// Current zulu (utc) time as zulu_time(), cast to uint32_t.
 BCT_API uint32_t unix_time() NOEXCEPT;
 
 /// Specified zulu (utc) time as local time: "yyyy-mm-ddThh:mm:ssL".
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_TRACER_HPP
+#define LIBBITCOIN_NETWORK_LOG_TRACER_HPP
+
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Traced spans, TRACE_*(name, id) requires a point of the same name.
+enum class trace_point : uint8_t
+{
+    channel,
+    handshake,
+    protocols,
+    message,
+    deserialize,
+    dispatch,
+    count
+};
+
+/// Thread safe, non-virtual.
+/// Process-wide ring buffers of span events, keyed by channel identifier so
+/// that a channel may be followed across threads. Each thread records into
+/// its own ring (oldest events overwritten), which are merged by snapshot.
+/// Recording is disabled until enabled, and compiled out unless HAVE_TRACES.
+class BCT_API traces final
+{
+public:
+    /// Events retained by each recording thread.
+    static constexpr size_t capacity = 4'096;
+    static constexpr size_t points = static_cast<size_t>(trace_point::count);
+
+    enum class phase : uint8_t
+    {
+        begin,
+        end,
+        instant
+    };
+
+    struct event
+    {
+        uint64_t time{};
+        uint64_t id{};
+        uint32_t thread{};
+        trace_point point{};
+        traces::phase phase{};
+    };
+
+    typedef std::vector<event> events;
+
+    /// Enable or disable recording (disabled by default).
+    static void enable(bool value=true) NOEXCEPT;
+    static bool enabled() NOEXCEPT;
+
+    /// Record an event of the span into the calling thread's ring.
+    static void record(trace_point point, phase phase, uint64_t id) NOEXCEPT;
+
+    /// Retained events of all threads that have recorded, ordered by time.
+    static events snapshot() NOEXCEPT;
+
+    /// Discard retained events of all threads.
+    static void clear() NOEXCEPT;
+
+    /// Write events as Chrome trace event JSON (also read by Perfetto).
+    /// Spans are async events of the channel id, as they cross threads.
+    static bool write(std::ostream& out, const events& values) NOEXCEPT;
+
+    /// The name of the trace point.
+    static std::string_view name(trace_point point) NOEXCEPT;
+};
+
+/// Not thread safe, non-virtual.
+/// Records the lifetime of the scope as a span of its point.
+class trace final
+{
+public:
+    DELETE_COPY_MOVE(trace);
+
+    inline trace(trace_point point, uint64_t id) NOEXCEPT
+      : point_(point), id_(id)
+    {
+        traces::record(point_, traces::phase::begin, id_);
+    }
+
+    inline ~trace() NOEXCEPT
+    {
+        traces::record(point_, traces::phase::end, id_);
+    }
+
+private:
+    const trace_point point_;
+    const uint64_t id_;
+};
+
+#if defined(HAVE_TRACES)
+    #define TRACE_BEGIN(name, id) network::traces::record( \
+        network::trace_point::name, network::traces::phase::begin, id)
+    #define TRACE_END(name, id) network::traces::record( \
+        network::trace_point::name, network::traces::phase::end, id)
+    #define TRACE_SCOPE(name, id) \
+        const network::trace trace_##name{ network::trace_point::name, id }
+#else
+    #define TRACE_BEGIN(name, id)
+    #define TRACE_END(name, id)
+    #define TRACE_SCOPE(name, id)
+#endif
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -20,7 +20,9 @@
 #define LIBBITCOIN_NETWORK_LOG_TRACKER_HPP
 
 #include <atomic>
+#include <string>
 #include <typeinfo>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/levels.hpp>
@@ -29,41 +31,106 @@
 namespace libbitcoin {
 namespace network {
 
+/// Thread safe, non-virtual.
+/// Live instance counts of all tracked classes (always available). Each
+/// tracked class enrolls its counter once, upon first instantiation.
+class BCT_API census final
+{
+public:
+    typedef std::atomic<size_t> counter;
+
+    struct entry
+    {
+        std::string name;
+        size_t count;
+    };
+
+    typedef std::vector<entry> entries;
+
+    /// Enroll the counter of a tracked class (returns true).
+    static bool enroll(const char* name, const counter& count) NOEXCEPT;
+
+    /// Current instance counts of all enrolled classes.
+    static entries snapshot() NOEXCEPT;
+};
+
+/// Counts instances in the census (relaxed), and with HAVE_LOGO also logs
+/// construct and destruct of each instance.
 template <class Class>
 class tracker
 {
 protected:
-    DEFAULT_COPY_MOVE(tracker);
-
 #if defined(HAVE_LOGO)
 
     tracker(const logger& log) NOEXCEPT
       : log_(log)
     {
-        LOGO(typeid(Class).name() << "(" << ++instances_ << ")");
+        LOGO(typeid(Class).name() << "(" << increment() << ")");
     }
 
-    ~tracker() NOEXCEPT
+    tracker(const tracker& other) NOEXCEPT
+      : tracker(other.log_)
     {
-        LOGO(typeid(Class).name() << "(" << --instances_ << ")~");
     }
 
-private:
-    // These are thread safe.
-    static inline std::atomic<size_t> instances_{};
-    const logger& log_;
+    tracker(tracker&& other) NOEXCEPT
+      : tracker(other.log_)
+    {
+    }
+
+    ~tracker() NOEXCEPT
+    {
+        LOGO(typeid(Class).name() << "(" << decrement() << ")~");
+    }
 
 #else // HAVE_LOGO
 
     tracker(const logger&) NOEXCEPT
     {
+        increment();
+    }
+
+    tracker(const tracker&) NOEXCEPT
+    {
+        increment();
+    }
+
+    tracker(tracker&&) NOEXCEPT
+    {
+        increment();
     }
 
     ~tracker() NOEXCEPT
     {
+        decrement();
     }
 
 #endif // HAVE_LOGO
+
+    tracker& operator=(const tracker&) NOEXCEPT = default;
+    tracker& operator=(tracker&&) NOEXCEPT = default;
+
+private:
+    static inline size_t increment() NOEXCEPT
+    {
+        // Names the enrollment, so that it is instantiated with the class.
+        static_cast<void>(enrolled_);
+        return add1(instances_.fetch_add(one, std::memory_order_relaxed));
+    }
+
+    static inline size_t decrement() NOEXCEPT
+    {
+        return sub1(instances_.fetch_sub(one, std::memory_order_relaxed));
+    }
+
+    // These are thread safe.
+    static inline census::counter instances_{};
+    static inline const bool enrolled_ = census::enroll(typeid(Class).name(),
+        instances_);
+
+#if defined(HAVE_LOGO)
+    const logger& log_;
+#endif
 };
 
 } // namespace network
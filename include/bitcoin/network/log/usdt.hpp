@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_LOG_USDT_HPP
+#define LIBBITCOIN_NETWORK_LOG_USDT_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+/// User statically defined tracepoints (USDT) of the "libbitcoin" provider,
+/// for attachment by bpftrace or systemtap to an unmodified build. A detached
+/// tracepoint is a nop instruction, but its arguments are evaluated, so they
+/// are restricted to integers and pointers at hand. Commands are passed as a
+/// pointer to the heading's (nul padded, unterminated) twelve command bytes.
+/// Compiled out unless HAVE_USDT (WITH_USDT and <sys/sdt.h>).
+
+#if defined(HAVE_USDT)
+    #include <sys/sdt.h>
+    #define USDT1(name, a) \
+        DTRACE_PROBE1(libbitcoin, name, a)
+    #define USDT2(name, a, b) \
+        DTRACE_PROBE2(libbitcoin, name, a, b)
+    #define USDT3(name, a, b, c) \
+        DTRACE_PROBE3(libbitcoin, name, a, b, c)
+    #define USDT4(name, a, b, c, d) \
+        DTRACE_PROBE4(libbitcoin, name, a, b, c, d)
+#else
+    #define USDT1(name, a)
+    #define USDT2(name, a, b)
+    #define USDT3(name, a, b, c)
+    #define USDT4(name, a, b, c, d)
+#endif
+
+#endif
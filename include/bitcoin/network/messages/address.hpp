@@ -43,6 +43,10 @@ struct BCT_API address
     static address deserialize(uint32_t version,
         system::reader& source) NOEXCEPT;
 
+    /// Deserialize into an existing message, reusing its vector capacity.
+    static void deserialize(uint32_t version, system::reader& source,
+        address& out) NOEXCEPT;
+
     bool serialize(uint32_t version,
         const system::data_slab& data) const NOEXCEPT;
     void serialize(uint32_t version,
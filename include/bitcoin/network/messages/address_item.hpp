@@ -83,6 +83,30 @@ constexpr bool is_specified(const address_item& item) NOEXCEPT
     return !is_zero(item.port) && item.ip != unspecified_ip_address;
 }
 
+/// Compact ip/port identity of an address item (hosts keys).
+struct address_key
+{
+    ip_address ip;
+    uint16_t port;
+};
+
+constexpr address_key to_key(const address_item& item) NOEXCEPT
+{
+    return { item.ip, item.port };
+}
+
+constexpr bool operator==(const address_key& left,
+    const address_key& right) NOEXCEPT
+{
+    return left.ip == right.ip && left.port == right.port;
+}
+
+constexpr bool operator!=(const address_key& left,
+    const address_key& right) NOEXCEPT
+{
+    return !(left == right);
+}
+
 } // namespace messages
 
 using address_item_cptr = messages::address_item::cptr;
@@ -93,6 +117,18 @@ using address_item_cptr = messages::address_item::cptr;
 /// std lib hash table support (hosts).
 namespace std
 {
+template<>
+struct hash<bc::network::messages::address_key>
+{
+    size_t operator()(
+        const bc::network::messages::address_key& value) const NOEXCEPT
+    {
+        return bc::system::hash_combine(
+            std::hash<bc::network::messages::ip_address>{}(value.ip),
+            std::hash<uint16_t>{}(value.port));
+    }
+};
+
 template<>
 struct hash<bc::network::messages::address_item>
 {
@@ -40,9 +40,17 @@ struct BCT_API block
 
     static cptr deserialize(uint32_t version, const system::data_chunk& data,
         bool witness=true) NOEXCEPT;
+    /// Hash is the optional double sha256 of data (e.g. from checksum).
+    static cptr deserialize(uint32_t version, const system::chunk_ptr& data,
+        bool witness=true, const system::hash_cptr& hash={}) NOEXCEPT;
     static block deserialize(uint32_t version, system::reader& source,
         bool witness=true) NOEXCEPT;
 
+    /// Cache the header hash and the identity hash of each transaction (in
+    /// lanes), from the serialization of the block in data.
+    static void set_hashes(const system::chain::block& block,
+        const system::data_chunk& data) NOEXCEPT;
+
     bool serialize(uint32_t version,
         const system::data_slab& data, bool witness=true) const NOEXCEPT;
     void serialize(uint32_t version, system::writer& sink,
@@ -51,6 +59,12 @@ struct BCT_API block
     size_t size(uint32_t version, bool witness) const NOEXCEPT;
 
     system::chain::block::cptr block_ptr;
+
+    /// Wire encoding retained from a chunk deserialization (zero-copy relay).
+    system::chunk_ptr payload_ptr{};
+
+    /// Double sha256 of the retained encoding if known (relay checksum).
+    system::hash_cptr payload_hash_ptr{};
 };
 
 } // namespace messages
@@ -20,10 +20,12 @@
 #define LIBBITCOIN_NETWORK_MESSAGES_COMPACT_BLOCK_HPP
 
 #include <memory>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/messages/compact_block_item.hpp>
 #include <bitcoin/network/messages/enums/identifier.hpp>
+#include <bitcoin/network/messages/siphash.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -53,6 +55,24 @@ struct BCT_API compact_block
 
     size_t size(uint32_t version, bool witness) const NOEXCEPT;
 
+    /// BIP152 short id key, from sha256 of the header and nonce.
+    static siphash_key to_key(const system::chain::header& header,
+        uint64_t nonce) NOEXCEPT;
+
+    /// BIP152 short id, the low 48 bits of siphash of the (w)txid.
+    static uint64_t to_short_id(const siphash_key& key,
+        const system::hash_digest& hash) NOEXCEPT;
+
+    /// BIP152 short ids of the (w)txids, computed as a batch.
+    static std::vector<uint64_t> to_short_ids(const siphash_key& key,
+        const system::hashes& hashes) NOEXCEPT;
+
+    /// The short id as a number (little-endian).
+    static uint64_t to_number(const short_id& id) NOEXCEPT;
+
+    /// The short id key of this message.
+    siphash_key key() const NOEXCEPT;
+
     system::chain::header::cptr header_ptr;
     uint64_t nonce;
     short_id_list short_ids;
@@ -60,7 +60,13 @@ enum class identifier
     send_headers,
     transaction,
     version,
-    version_acknowledge
+    version_acknowledge,
+    wtxid_relay,
+    reconciliation_difference,
+    reconciliation_sketch,
+    request_reconciliation,
+    send_reconciliation,
+    request_sketch_extension
 };
 
 } // namespace messages
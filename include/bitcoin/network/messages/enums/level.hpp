@@ -38,6 +38,7 @@ namespace messages {
 // ping         v2      60001   BIP031  added nonce field
 // pong         v1      60001   BIP031
 // reject       v3      70002   BIP061  disabled by default, deprecated
+// wtxidrelay   v4      70016   BIP339  between version and verack
 // ----------------------------------------------------------------------------
 // alert        v4                      disabled by default, deprecated
 // checkorder   --                      obsolete
@@ -144,11 +145,14 @@ enum level: uint32_t
     /// client filters protocol
     bip157 = 70015,
 
+    /// wtxid_relay, inventory by wtxid
+    bip339 = 70016,
+
     /// We require at least this of peers (for current address structure).
     minimum_protocol = address_time,
 
     /// We support at most this internally (bound to settings default).
-    maximum_protocol = bip157
+    maximum_protocol = bip339
 };
 
 } // namespace messages
@@ -44,6 +44,9 @@ constexpr size_t max_reject_message = max_uint16;
 // This is arbitrary, useful as an address pool and block announce guard.
 constexpr size_t maximum_advertisement = 10;
 
+// This is arbitrary, bounds reconciliation sketch decoding cost (elements).
+constexpr size_t max_sketch_capacity = 256;
+
 ////constexpr size_t max_bloom_filter_hashes = 2'000;
 ////constexpr size_t max_get_data = 50'000;
 ////constexpr size_t max_get_client_filter_headers = 1'999;
@@ -54,6 +54,10 @@ enum service: uint64_t
     /// Serves only the last 288 (2 day) blocks.
     node_xnetwork_limited = system::bit_right<uint32_t>(10),
 
+    /// Experimental (bits 24-31 are reserved for temporary experiments).
+    /// The node accepts compressed relay envelopes (peered channels only).
+    node_compression = system::bit_right<uint32_t>(24),
+
     /// The minimum supported capability.
     minimum_services = node_none,
 
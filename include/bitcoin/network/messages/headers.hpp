@@ -44,6 +44,9 @@ struct BCT_API headers
     static headers deserialize(uint32_t version,
         system::reader& source) NOEXCEPT;
 
+    /// Hash each header of a valid headers payload, in batched lanes.
+    static system::hashes hash(const system::data_slice& data) NOEXCEPT;
+
     bool serialize(uint32_t version,
         const system::data_slab& data) const NOEXCEPT;
     void serialize(uint32_t version,
@@ -55,6 +58,7 @@ struct BCT_API headers
     system::hashes to_hashes() const NOEXCEPT;
     inventory_items to_inventory(inventory::type_id type) const NOEXCEPT;
 
+    /// Deserialized headers share one allocation (aliased pointers).
     system::chain::header_cptrs header_ptrs;
 };
 
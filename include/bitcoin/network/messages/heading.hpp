@@ -42,6 +42,17 @@ struct BCT_API heading
         return witness ? system::chain::max_block_weight : non_witness;
     }
 
+    /// Maximum payload of the identified message, not exceeding limit, for
+    /// rejection of a heading before its payload buffer is allocated.
+    /// Messages without a known bound (including unknown) are given limit.
+    static size_t maximum_payload(identifier id, size_t limit) NOEXCEPT;
+
+    /// Structural scan of a list message payload, O(1): the count is within
+    /// the limit of the type and its elements exactly fill the payload, for
+    /// rejection before any element is deserialized (true if not a list).
+    static bool prescan(identifier id,
+        const system::data_slice& payload) NOEXCEPT;
+
     static std::string get_command(const system::data_chunk& payload) NOEXCEPT;
     static heading factory(uint32_t magic, const std::string& command,
         const system::data_slice& payload) NOEXCEPT;
@@ -63,6 +74,10 @@ struct BCT_API heading
     bool serialize(const system::data_slab& data) const NOEXCEPT;
     void serialize(system::writer& sink) const NOEXCEPT;
 
+    /// Identifier of a raw (nul-padded) or string command, without
+    /// constructing a string, for use directly against the wire buffer.
+    static identifier id(const system::data_slice& command) NOEXCEPT;
+
     identifier id() const NOEXCEPT;
 
     uint32_t magic;
@@ -71,6 +86,24 @@ struct BCT_API heading
     uint32_t checksum;
 };
 
+/// Fixed-size heading for the read loop, parsed in place from the wire
+/// buffer, with command identified once (no string or shared allocation).
+struct BCT_API fixed_heading
+{
+    static constexpr size_t command_size = heading::command_size;
+
+    bool deserialize(system::reader& source) NOEXCEPT;
+
+    /// Logging utility only (allocates).
+    std::string command_text() const NOEXCEPT;
+
+    uint32_t magic;
+    system::data_array<command_size> command;
+    uint32_t payload_size;
+    uint32_t checksum;
+    identifier id;
+};
+
 } // namespace messages
 } // namespace network
 } // namespace libbitcoin
@@ -50,6 +50,10 @@ struct BCT_API inventory
     static inventory deserialize(uint32_t version,
         system::reader& source) NOEXCEPT;
 
+    /// Deserialize into an existing message, reusing its vector capacity.
+    static void deserialize(uint32_t version, system::reader& source,
+        inventory& out) NOEXCEPT;
+
     bool serialize(uint32_t version,
         const system::data_slab& data) const NOEXCEPT;
     void serialize(uint32_t version,
@@ -42,6 +42,9 @@ struct BCT_API inventory_item
         filtered_block = block | transaction,
         compact_block = system::bit_right<uint32_t>(2),
 
+        // BIP339 transaction by wtxid (not a combination of flags).
+        wtxid = transaction | compact_block,
+
         witness = system::bit_right<uint32_t>(30),
         witness_transaction = witness | transaction,
         witness_block = witness | block,
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_MESSAGES_INVENTORY_VIEW_HPP
+#define LIBBITCOIN_NETWORK_MESSAGES_INVENTORY_VIEW_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/inventory.hpp>
+#include <bitcoin/network/messages/inventory_item.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+/// Zero-copy view of an inv, get_data or not_found payload (wire format).
+/// The payload must outlive the view. Types and hashes are read from where
+/// they lie in the payload, so parsing is a bounds check with no allocation.
+class BCT_API inventory_view
+{
+public:
+    typedef inventory_item::type_id type_id;
+
+    /// Invalid (and empty) unless payload is an exact inventory vector list.
+    inventory_view(const system::data_slice& payload) NOEXCEPT;
+
+    /// Properties.
+    /// -----------------------------------------------------------------------
+
+    /// True if the payload is well-formed.
+    operator bool() const NOEXCEPT;
+
+    size_t size() const NOEXCEPT;
+    bool empty() const NOEXCEPT;
+
+    /// Index must be less than size.
+    type_id type(size_t index) const NOEXCEPT;
+    const system::hash_digest& hash(size_t index) const NOEXCEPT;
+    inventory_item item(size_t index) const NOEXCEPT;
+
+    /// Methods.
+    /// -----------------------------------------------------------------------
+
+    size_t count(type_id type) const NOEXCEPT;
+    system::hashes to_hashes(type_id type) const NOEXCEPT;
+    inventory to_inventory() const NOEXCEPT;
+
+    /// Single pass, in order and without allocation. The matched handler is
+    /// invoked with hashes of the type, the other with the remaining items.
+    template <typename Matched, typename Other>
+    void partition(type_id type, Matched&& matched,
+        Other&& other) const NOEXCEPT
+    {
+        for (size_t index{}; index < size_; ++index)
+        {
+            const auto kind = this->type(index);
+            if (kind == type)
+                matched(hash(index));
+            else
+                other(kind, hash(index));
+        }
+    }
+
+private:
+    static constexpr size_t item_size = sizeof(uint32_t) + system::hash_size;
+
+    const uint8_t* at(size_t index) const NOEXCEPT;
+
+    // These are thread safe (const).
+    const uint8_t* items_;
+    size_t size_;
+};
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -23,8 +23,20 @@
 #include <memory>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/probe.hpp>
+#include <bitcoin/network/messages/block.hpp>
+#include <bitcoin/network/messages/compact_block.hpp>
+#include <bitcoin/network/messages/compact_transactions.hpp>
+#include <bitcoin/network/messages/get_address.hpp>
 #include <bitcoin/network/messages/heading.hpp>
+#include <bitcoin/network/messages/memory_pool.hpp>
+#include <bitcoin/network/messages/ping.hpp>
+#include <bitcoin/network/messages/pong.hpp>
+#include <bitcoin/network/messages/request_sketch_extension.hpp>
+#include <bitcoin/network/messages/send_headers.hpp>
 #include <bitcoin/network/messages/transaction.hpp>
+#include <bitcoin/network/messages/version_acknowledge.hpp>
+#include <bitcoin/network/messages/wtxid_relay.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -36,39 +48,195 @@ inline uint32_t network_checksum(const system::hash_digest& hash) NOEXCEPT
     return from_little_endian(array_cast<uint8_t, sizeof(uint32_t)>(hash));
 }
 
+/// Checksum of the empty payload, network_checksum(bitcoin_hash({})).
+constexpr uint32_t empty_checksum = 0xe2e0f65d;
+
+/// Messages with a witness and witness-stripped encoding.
+template <typename Message>
+constexpr bool is_witness_payload =
+    system::is_same_type<Message, block> ||
+    system::is_same_type<Message, transaction> ||
+    system::is_same_type<Message, compact_block> ||
+    system::is_same_type<Message, compact_transactions>;
+
+/// Messages with a constant empty payload (heading only on the wire).
+template <typename Message>
+constexpr bool is_empty_payload =
+    system::is_same_type<Message, version_acknowledge> ||
+    system::is_same_type<Message, get_address> ||
+    system::is_same_type<Message, send_headers> ||
+    system::is_same_type<Message, wtxid_relay> ||
+    system::is_same_type<Message, memory_pool> ||
+    system::is_same_type<Message, request_sketch_extension>;
+
+/// Messages with a payload of only a nonce (bip31 and later).
+template <typename Message>
+constexpr bool is_nonce_payload =
+    system::is_same_type<Message, ping> ||
+    system::is_same_type<Message, pong>;
+
+/// Wire template of the nul-padded command, computed once per message type.
+template <typename Message>
+const system::data_array<heading::command_size>& command_template() NOEXCEPT
+{
+    static const auto command = []() NOEXCEPT
+    {
+        system::data_array<heading::command_size> out{};
+        system::write::bytes::copy writer(out);
+        writer.write_string_buffer(Message::command, heading::command_size);
+        return out;
+    }();
+
+    return command;
+}
+
+/// Allocator of serialization buffers (buffers are fully overwritten).
+inline system::chunk_ptr allocate_chunk(size_t size) NOEXCEPT
+{
+    return std::make_shared<system::data_chunk>(size);
+}
+
+/// Serialize a templated message, patching only magic and nonce (if any).
+/// This bypasses payload serialization and, for empty payloads, hashing.
+template <typename Message, typename Allocate>
+system::chunk_ptr serialize_template([[maybe_unused]] const Message& message,
+    uint32_t magic, uint32_t version, Allocate&& allocate) NOEXCEPT
+{
+    using namespace system;
+    const auto nonce = is_nonce_payload<Message> &&
+        (!is_same_type<Message, ping> || version >= level::bip31);
+
+    const auto payload = nonce ? sizeof(uint64_t) : zero;
+    const auto data = allocate(heading::size() + payload);
+    if (!data)
+        return {};
+
+    write::bytes::copy writer(*data);
+    writer.write_4_bytes_little_endian(magic);
+    writer.write_bytes(command_template<Message>());
+    writer.write_4_bytes_little_endian(possible_narrow_cast<uint32_t>(payload));
+
+    if constexpr (is_nonce_payload<Message>)
+    {
+        if (nonce)
+        {
+            const auto bytes = to_little_endian(message.nonce);
+            writer.write_4_bytes_little_endian(network_checksum(
+                bitcoin_hash(bytes.size(), bytes.data())));
+            writer.write_bytes(bytes);
+            return writer ? data : nullptr;
+        }
+    }
+
+    writer.write_4_bytes_little_endian(empty_checksum);
+    return writer ? data : nullptr;
+}
+
 /// Deserialize message payload from the wire protocol encoding.
+/// The payload hash (double sha256), if provided, seeds transaction identity.
 /// Returns nullptr if serialization fails for any reason (expected).
 template <typename Message>
 typename Message::cptr deserialize(const system::data_chunk& body,
-    uint32_t version) NOEXCEPT
+    uint32_t version, const system::hash_cptr& hash={}) NOEXCEPT
 {
     // TODO: build witness into feature w/magic and negotiated version.
-    // TODO: have deserialize use data for hash pregeneration as applicable.
-    return Message::deserialize(version, body);
+    if constexpr (system::is_same_type<Message, transaction>)
+        return Message::deserialize(version, body, true, hash);
+    else
+        return Message::deserialize(version, body);
 }
 
-/// Serialize message object to the wire protocol encoding.
-/// Returns nullptr if serialization fails for any reason (unexpected).
+/// Deserialize message payload from the wire protocol encoding.
+/// Block and transaction retain the payload, which must not then be reused.
+/// The payload hash (double sha256), if provided, seeds transaction identity.
+/// Returns nullptr if serialization fails for any reason (expected).
 template <typename Message>
+typename Message::cptr deserialize(const system::chunk_ptr& body,
+    uint32_t version, const system::hash_cptr& hash={}) NOEXCEPT
+{
+    // TODO: build witness into feature w/magic and negotiated version.
+    if constexpr (system::is_same_type<Message, transaction>)
+        return Message::deserialize(version, body, true, hash);
+    else if constexpr (system::is_same_type<Message, block>)
+        return Message::deserialize(version, body, true, hash);
+    else
+        return body ? Message::deserialize(version, *body) : nullptr;
+}
+
+/// Double sha256 of the retained wire payload of a block or transaction, if
+/// it is the encoding of the given size (as written by serialize), so that
+/// relay of a received payload does not rehash it for the heading checksum.
+/// The witness hash of a transaction is the hash of its received payload.
+template <typename Message>
+system::hash_cptr retained_hash([[maybe_unused]] const Message& message,
+    [[maybe_unused]] size_t size) NOEXCEPT
+{
+    if constexpr (system::is_same_type<Message, transaction>)
+    {
+        if (message.payload_ptr && message.payload_ptr->size() == size &&
+            message.transaction_ptr)
+            return system::to_shared(message.transaction_ptr->hash(true));
+    }
+    else if constexpr (system::is_same_type<Message, block>)
+    {
+        if (message.payload_ptr && message.payload_ptr->size() == size)
+            return message.payload_hash_ptr;
+    }
+
+    return {};
+}
+
+/// Serialize message object to the wire protocol encoding, into a buffer of
+/// exactly the encoded size obtained from allocate (such as a pool lease).
+/// Witness applies only to is_witness_payload messages (otherwise ignored).
+/// Returns nullptr if serialization fails for any reason (unexpected).
+template <typename Message, typename Allocate>
 system::chunk_ptr serialize(const Message& message, uint32_t magic,
-    uint32_t version) NOEXCEPT
+    uint32_t version, [[maybe_unused]] bool witness,
+    Allocate&& allocate) NOEXCEPT
 {
-    const auto size = heading::size() + message.size(version);
-    const auto data = std::make_shared<system::data_chunk>(size);
-    const auto body_start = std::next(data->begin(), heading::size());
-    const system::data_slab body(body_start, data->end());
+    PROBE(messages_serialize);
 
-    ////// Transaction is the only message that can use the identity hash.
-    ////// TODO: Hash must match witness serialization of the transaction object.
-    ////system::hash_cptr hash{};
-    ////if constexpr (is_same_type<Message, transaction>) { hash = message.hash; }
+    // Fixed-layout messages are written from templates (no payload pass).
+    if constexpr (is_empty_payload<Message> || is_nonce_payload<Message>)
+        return serialize_template(message, magic, version, allocate);
+    else
+    {
+        size_t size{};
+        if constexpr (is_witness_payload<Message>)
+            size = heading::size() + message.size(version, witness);
+        else
+            size = heading::size() + message.size(version);
 
-    // TODO: build witness into feature w/magic and negotiated version.
-    if (!message.serialize(version, body) ||
-        !heading::factory(magic, Message::command, body /*, hash*/).serialize(*data))
-        return {};
+        const auto data = allocate(size);
+        if (!data)
+            return {};
+
+        const auto body_start = std::next(data->begin(), heading::size());
+        const system::data_slab body(body_start, data->end());
+
+        bool written{};
+        if constexpr (is_witness_payload<Message>)
+            written = message.serialize(version, body, witness);
+        else
+            written = message.serialize(version, body);
+
+        if (!written || !heading::factory(magic, Message::command, body,
+            retained_hash(message, body.size())).serialize(*data))
+            return {};
+
+        return data;
+    }
+}
 
-    return data;
+/// Serialize message object to the wire protocol encoding.
+/// Witness applies only to is_witness_payload messages (otherwise ignored).
+/// Returns nullptr if serialization fails for any reason (unexpected).
+template <typename Message>
+system::chunk_ptr serialize(const Message& message, uint32_t magic,
+    uint32_t version, bool witness=true) NOEXCEPT
+{
+    return serialize(message, magic, version, witness, allocate_chunk);
 }
 
 } // namespace messages
@@ -50,17 +50,25 @@
 #include <bitcoin/network/messages/heading.hpp>
 #include <bitcoin/network/messages/inventory.hpp>
 #include <bitcoin/network/messages/inventory_item.hpp>
+#include <bitcoin/network/messages/inventory_view.hpp>
 #include <bitcoin/network/messages/memory_pool.hpp>
 #include <bitcoin/network/messages/merkle_block.hpp>
 #include <bitcoin/network/messages/message.hpp>
 #include <bitcoin/network/messages/not_found.hpp>
 #include <bitcoin/network/messages/ping.hpp>
 #include <bitcoin/network/messages/pong.hpp>
+#include <bitcoin/network/messages/reconciliation_difference.hpp>
+#include <bitcoin/network/messages/reconciliation_sketch.hpp>
 #include <bitcoin/network/messages/reject.hpp>
+#include <bitcoin/network/messages/request_reconciliation.hpp>
+#include <bitcoin/network/messages/request_sketch_extension.hpp>
 #include <bitcoin/network/messages/send_compact.hpp>
 #include <bitcoin/network/messages/send_headers.hpp>
+#include <bitcoin/network/messages/send_reconciliation.hpp>
+#include <bitcoin/network/messages/siphash.hpp>
 #include <bitcoin/network/messages/transaction.hpp>
 #include <bitcoin/network/messages/version.hpp>
 #include <bitcoin/network/messages/version_acknowledge.hpp>
+#include <bitcoin/network/messages/wtxid_relay.hpp>
 
 #endif
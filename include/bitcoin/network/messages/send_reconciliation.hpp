@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_MESSAGES_SEND_RECONCILIATION_HPP
+#define LIBBITCOIN_NETWORK_MESSAGES_SEND_RECONCILIATION_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/enums/identifier.hpp>
+#include <bitcoin/network/messages/siphash.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+struct BCT_API send_reconciliation
+{
+    typedef std::shared_ptr<const send_reconciliation> cptr;
+
+    static const identifier id;
+    static const std::string command;
+    static const uint32_t version_minimum;
+    static const uint32_t version_maximum;
+
+    /// BIP330 reconciliation protocol version.
+    static constexpr uint32_t reconciliation_version = 1;
+
+    /// BIP330 short id key, from the tagged hash of both salts (ascending).
+    static siphash_key to_key(uint64_t local_salt,
+        uint64_t remote_salt) NOEXCEPT;
+
+    /// BIP330 short id, one plus siphash of the wtxid modulo 2^32-1.
+    static uint32_t to_short_id(const siphash_key& key,
+        const system::hash_digest& wtxid) NOEXCEPT;
+
+    static size_t size(uint32_t version) NOEXCEPT;
+
+    static cptr deserialize(uint32_t version,
+        const system::data_chunk& data) NOEXCEPT;
+    static send_reconciliation deserialize(uint32_t version,
+        system::reader& source) NOEXCEPT;
+
+    bool serialize(uint32_t version,
+        const system::data_slab& data) const NOEXCEPT;
+    void serialize(uint32_t version,
+        system::writer& sink) const NOEXCEPT;
+
+    uint32_t protocol_version;
+    uint64_t salt;
+};
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_MESSAGES_SIPHASH_HPP
+#define LIBBITCOIN_NETWORK_MESSAGES_SIPHASH_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+/// SipHash-2-4 key, as two little-endian words.
+struct BCT_API siphash_key
+{
+    uint64_t k0;
+    uint64_t k1;
+};
+
+/// SipHash-2-4 of arbitrary data.
+BCT_API uint64_t siphash(const siphash_key& key,
+    const system::data_slice& data) NOEXCEPT;
+
+/// SipHash-2-4 of a 32 byte hash (unrolled, as used by BIP152 short ids).
+BCT_API uint64_t siphash(const siphash_key& key,
+    const system::hash_digest& hash) NOEXCEPT;
+
+/// SipHash-2-4 of each 32 byte hash, in order (same key for all).
+/// Hashes are computed in interleaved lanes of independent state, which the
+/// compiler may vectorize, with any remainder computed individually.
+BCT_API std::vector<uint64_t> siphash(const siphash_key& key,
+    const system::hashes& hashes) NOEXCEPT;
+
+/// SipHash-2-4 of each data item, in order (same key for all).
+/// Items of equal size are computed in interleaved lanes, as above, so that
+/// the scripts of a watch list (few distinct sizes) are mostly batched.
+BCT_API std::vector<uint64_t> siphash(const siphash_key& key,
+    const system::data_stack& items) NOEXCEPT;
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NETWORK_MESSAGES_TRANSACTION_HPP
 
 #include <memory>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/messages/enums/identifier.hpp>
@@ -38,11 +39,23 @@ struct BCT_API transaction
     static const uint32_t version_minimum;
     static const uint32_t version_maximum;
 
+    /// Non-witness hash of a witness-serialized transaction, of (non-witness)
+    /// size, streaming its three non-witness segments without reparsing.
     static system::hash_digest desegregated_hash(
         const system::data_chunk& data, size_t size) NOEXCEPT;
 
+    /// Non-witness hashes of witness-serialized transactions (e.g. of a block)
+    /// of corresponding (non-witness) sizes, in order, hashed in lanes. Those
+    /// not segregated (size is data size) are hashed in place.
+    static system::hashes desegregated_hashes(
+        const std::vector<system::data_slice>& data,
+        const std::vector<size_t>& sizes) NOEXCEPT;
+
+    /// Hash is the optional double sha256 of data (e.g. from checksum).
     static cptr deserialize(uint32_t version, const system::data_chunk& data,
-        bool witness=true) NOEXCEPT;
+        bool witness=true, const system::hash_cptr& hash={}) NOEXCEPT;
+    static cptr deserialize(uint32_t version, const system::chunk_ptr& data,
+        bool witness=true, const system::hash_cptr& hash={}) NOEXCEPT;
     static transaction deserialize(uint32_t version, system::reader& source,
         bool witness=true) NOEXCEPT;
 
@@ -54,6 +67,9 @@ struct BCT_API transaction
     size_t size(uint32_t version, bool witness) const NOEXCEPT;
 
     system::chain::transaction::cptr transaction_ptr;
+
+    /// Wire encoding retained from a chunk deserialization (zero-copy relay).
+    system::chunk_ptr payload_ptr{};
 };
 
 } // namespace messages
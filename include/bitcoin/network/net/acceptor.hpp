@@ -21,11 +21,13 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/handoff.hpp>
 #include <bitcoin/network/net/socket.hpp>
 #include <bitcoin/network/settings.hpp>
 
@@ -41,6 +43,7 @@ class BCT_API acceptor
 {
 public:
     typedef std::shared_ptr<acceptor> ptr;
+    typedef std::function<bool(const config::authority&)> filter_handler;
 
     DELETE_COPY_MOVE(acceptor);
 
@@ -51,6 +54,15 @@ public:
     acceptor(const logger& log, asio::strand& strand,
         asio::io_context& service, const settings& settings) NOEXCEPT;
 
+    /// Construct an instance creating sockets round robin on services.
+    acceptor(const logger& log, asio::strand& strand,
+        threadpools& services, const settings& settings) NOEXCEPT;
+
+    /// Construct an instance on its own strand of the shard service, upon
+    /// which sockets are created. Methods require the acceptor strand.
+    acceptor(const logger& log, asio::io_context& shard,
+        const settings& settings) NOEXCEPT;
+
     /// Asserts/logs stopped.
     virtual ~acceptor() NOEXCEPT;
 
@@ -64,6 +76,10 @@ public:
     /// Start the listener on the specified ip address and port (call once).
     virtual code start(const config::authority& local) NOEXCEPT;
 
+    /// Start the listener on a listening socket taken by handoff (call once),
+    /// the acceptor owns the descriptor upon success.
+    virtual code adopt(const handoff::listener& listener) NOEXCEPT;
+
     /// Cancel work (idempotent), handler signals completion.
     virtual void stop() NOEXCEPT;
 
@@ -73,6 +89,15 @@ public:
     /// The local endpoint to which this acceptor is bound (requires strand).
     virtual config::authority local() const NOEXCEPT;
 
+    /// The descriptor of the listening socket for handoff (fixed at start).
+    virtual handoff::descriptor descriptor() NOEXCEPT;
+
+    /// The acceptor has its own (shard) strand.
+    virtual bool sharded() const NOEXCEPT;
+
+    /// The strand of the acceptor (thread safe).
+    virtual asio::strand& strand() NOEXCEPT;
+
     // Methods.
     // ------------------------------------------------------------------------
     /// Subsequent accepts may only be attempted following handler invocation.
@@ -81,23 +106,43 @@ public:
     /// Accept next connection available until stop.
     virtual void accept(socket_handler&& handler) NOEXCEPT;
 
+    /// Filter connections by remote authority before the socket (and its
+    /// strand) is created, rejected connections are closed and accept
+    /// continues without handler invocation (requires strand).
+    virtual void filter(filter_handler&& handler) NOEXCEPT;
+
 protected:
+    /// The service of the next socket.
+    asio::io_context& socket_service() NOEXCEPT;
+
+    /// The remote authority passes the filter, if set (requires strand).
+    bool admitted(const config::authority& remote) const NOEXCEPT;
+
     virtual code start(const asio::endpoint& point) NOEXCEPT;
 
     // These are thread safe.
     const settings& settings_;
+    const settings::cptr retained_;
     asio::io_context& service_;
+    threadpools* const services_;
+    const std::unique_ptr<asio::strand> shard_;
     asio::strand& strand_;
 
     // These are protected by strand.
     asio::acceptor acceptor_;
+    filter_handler filter_{};
     bool stopped_{ true };
 
 private:
     void handle_accept(const code& ec, const socket::ptr& socket,
         const socket_handler& handler) NOEXCEPT;
+    void handle_connection(const error::boost_code& ec,
+        asio::socket&& connection, asio::io_context& service,
+        const socket_handler& handler) NOEXCEPT;
 };
 
+typedef std::vector<acceptor::ptr> acceptors;
+
 } // namespace network
 } // namespace libbitcoin
 
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_ANCHORS_HPP
+#define LIBBITCOIN_NETWORK_NET_ANCHORS_HPP
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Outbound peers that were long-lived (anchor_lifetime) at shutdown, saved
+/// to the settings-specified path and dialed first upon the next start. At
+/// most anchor_connections are saved, block-relay peers and then the longest
+/// lived first (zero anchor_connections disables).
+class BCT_API anchors final
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(anchors);
+
+    /// Construct an instance.
+    anchors(const settings& settings) NOEXCEPT;
+
+    /// Load anchors from file (the file is removed, as anchors are taken).
+    code start() NOEXCEPT;
+
+    /// Save recorded anchors to file.
+    code stop() NOEXCEPT;
+
+    /// Count of loaded anchors not yet taken.
+    size_t count() const NOEXCEPT;
+
+    /// Take a loaded anchor, false if none remain.
+    bool take(messages::address_item_cptr& out) NOEXCEPT;
+
+    /// Record an outbound peer stopped at shutdown (ignored if short-lived).
+    void record(const messages::address_item& item, bool block_relay,
+        const steady_clock::duration& uptime) NOEXCEPT;
+
+private:
+    struct anchor
+    {
+        messages::address_item item;
+        bool block_relay;
+        steady_clock::duration uptime;
+    };
+
+    // This is thread safe.
+    const settings& settings_;
+
+    // These are protected by mutex.
+    std::deque<messages::address_item_cptr> loaded_{};
+    std::vector<anchor> recorded_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_ASMAP_HPP
+#define LIBBITCOIN_NETWORK_NET_ASMAP_HPP
+
+#include <filesystem>
+#include <memory>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe once loaded (immutable), non-virtual.
+/// Autonomous system map, the compact binary trie of IP prefixes to ASN as
+/// produced for Bitcoin Core (-asmap), memory-mapped from file. Lookup walks
+/// the trie bytecode with the 128 bits of the (IPv4-mapped) IPv6 address.
+class BCT_API asmap final
+{
+public:
+    DELETE_COPY_MOVE(asmap);
+
+    /// Network group keys of ASN groups are distinct from prefix groups.
+    static constexpr uint64_t asn_group = uint64_t{ 1 } << 32;
+
+    /// Construct an unloaded map.
+    asmap() NOEXCEPT;
+
+    /// Memory-map the file, error::file_load if not mapped.
+    code load(const std::filesystem::path& file) NOEXCEPT;
+
+    /// A map is loaded.
+    bool loaded() const NOEXCEPT;
+
+    /// The ASN of the address, zero if unmapped (or map not loaded).
+    uint32_t lookup(const messages::ip_address& ip) const NOEXCEPT;
+    uint32_t lookup(const config::authority& host) const NOEXCEPT;
+
+    /// The network group of the address, its ASN if mapped and otherwise its
+    /// /16 (IPv4) or /32 (IPv6) prefix.
+    uint64_t group(const messages::ip_address& ip) const NOEXCEPT;
+
+    /// Interpret asmap bytecode for the address, zero if unmapped or invalid.
+    static uint32_t interpret(const system::data_slice& map,
+        const messages::ip_address& ip) NOEXCEPT;
+
+private:
+    // These are thread safe (immutable once loaded).
+    std::unique_ptr<boost::interprocess::file_mapping> file_{};
+    std::unique_ptr<boost::interprocess::mapped_region> region_{};
+    system::data_slice map_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
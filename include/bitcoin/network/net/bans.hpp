@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_BANS_HPP
+#define LIBBITCOIN_NETWORK_NET_BANS_HPP
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Misbehavior scores and bans keyed on the raw address (port is ignored, as
+/// an inbound peer reconnects from an arbitrary port). Protocol errors add a
+/// penalty to the score, which halves over each ban_decay period. A score at
+/// or beyond ban_threshold bans the address for ban_duration (zero threshold
+/// disables). Times are unix seconds so that bans survive restart, and the
+/// bans (not scores) are saved to and loaded from the settings-specified path
+/// with the host pool (non-zero host_pool_capacity).
+class BCT_API bans final
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(bans);
+
+    /// Bound on tracked addresses, decayed entries are pruned at the bound.
+    static constexpr size_t maximum_entries = 65'536;
+
+    /// Construct an instance.
+    bans(const settings& settings) NOEXCEPT;
+
+    /// Load bans from file.
+    code start() NOEXCEPT;
+
+    /// Save unexpired bans to file.
+    code stop() NOEXCEPT;
+
+    /// Count of unexpired bans.
+    size_t count(uint32_t now=unix_time()) const NOEXCEPT;
+
+    /// The address is presently banned.
+    bool banned(const messages::address_item& item,
+        uint32_t now=unix_time()) const NOEXCEPT;
+
+    /// Score the address for the error, true if this results in a ban.
+    bool misbehaved(const messages::address_item& item, const code& ec,
+        uint32_t now=unix_time()) NOEXCEPT;
+
+    /// Misbehavior score of the error code (zero if not misbehavior).
+    static uint32_t penalty(const code& ec) NOEXCEPT;
+
+private:
+    struct record
+    {
+        uint32_t score;
+        uint32_t updated;
+        uint32_t expiry;
+    };
+
+    typedef std::unordered_map<messages::ip_address, record> table;
+
+    uint32_t decayed(const record& entry, uint32_t now) const NOEXCEPT;
+    void prune(uint32_t now) NOEXCEPT;
+
+    // This is thread safe.
+    const settings& settings_;
+
+    // These are protected by mutex.
+    table table_{};
+    mutable std::shared_mutex mutex_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_BLOCK_STREAM_HPP
+#define LIBBITCOIN_NETWORK_NET_BLOCK_STREAM_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Incremental block message parser over a payload buffer that is filled in
+/// order as chunks are read. Each advance parses the header, transaction
+/// count and all transactions completed within the filled prefix, so that
+/// parsing overlaps the read of the remainder. A transaction split across
+/// chunks is parsed once complete (incomplete parses are discarded).
+class BCT_API block_stream final
+{
+public:
+    DELETE_COPY_MOVE(block_stream);
+
+    /// The payload must be sized to the full payload (heading payload_size).
+    /// The block message retains the payload if retain is set (zero-copy).
+    block_stream(const system::chunk_ptr& payload, uint32_t version,
+        bool retain, bool witness=true) NOEXCEPT;
+
+    /// Parse all that is complete within the filled prefix of the payload.
+    /// False if the payload is invalid (a parse fails with no more to read).
+    bool advance(size_t filled) NOEXCEPT;
+
+    /// The number of transactions parsed.
+    size_t parsed() const NOEXCEPT;
+
+    /// The block message, nullptr if not fully and exactly parsed.
+    /// Hash is the optional double sha256 of the payload (retained with it).
+    messages::block::cptr finish(const system::hash_cptr& hash={}) NOEXCEPT;
+
+private:
+    system::data_slice remaining(size_t filled) const NOEXCEPT;
+
+    // These are thread safe (const).
+    const system::chunk_ptr payload_;
+    const uint32_t version_;
+    const bool retain_;
+    const bool witness_;
+
+    // These are not thread safe.
+    system::chain::header::cptr header_{};
+    system::chain::transaction_cptrs transactions_{};
+    uint64_t count_{};
+    size_t offset_{};
+    bool invalid_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_BLOCKLIST_HPP
+#define LIBBITCOIN_NETWORK_NET_BLOCKLIST_HPP
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Bulk blocklist of address prefixes from an external file, compiled
+/// directly to a prefix trie (without authority parsing or settings). A text
+/// file holds one address or address/cidr per line ('#' comments), parsed in
+/// parallel chunks. A binary file (as written by save) holds 17 byte records
+/// of the 16 byte (IPv4-mapped) address and cidr. A refresh reloads the file
+/// if changed, and swaps in the new trie atomically (prior kept on failure).
+class BCT_API blocklist final
+{
+public:
+    DELETE_COPY_MOVE(blocklist);
+
+    /// Parallelism of text parsing (minimum one).
+    blocklist(const std::filesystem::path& file, size_t threads=one) NOEXCEPT;
+
+    /// Load the file if modified since last loaded (or not yet loaded).
+    /// Returns error::file_load if unreadable or malformed binary.
+    code refresh() NOEXCEPT;
+
+    /// The item is contained by a loaded prefix (false if none loaded).
+    bool contains(const messages::address_item& item) const NOEXCEPT;
+
+    /// The number of loaded prefixes.
+    size_t size() const NOEXCEPT;
+
+    /// Parse text lines to prefixes, returns the count of invalid lines.
+    static size_t parse(config::subnets::prefixes& out,
+        std::string_view text) NOEXCEPT;
+
+    /// Write prefixes as a binary blocklist file.
+    static code save(const std::filesystem::path& file,
+        const config::subnets::prefixes& values) NOEXCEPT;
+
+private:
+    typedef std::shared_ptr<const config::subnets> subnets_cptr;
+
+    code load(config::subnets::prefixes& out) const NOEXCEPT;
+    void parallel(config::subnets::prefixes& out,
+        std::string_view text) const NOEXCEPT;
+
+    // These are thread safe.
+    const std::filesystem::path file_;
+    const size_t threads_;
+    std::atomic<subnets_cptr> subnets_{};
+
+    // These are protected by mutex.
+    std::mutex mutex_{};
+    std::filesystem::file_time_type modified_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_BLOOM_FILTER_HPP
+#define LIBBITCOIN_NETWORK_NET_BLOOM_FILTER_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// BIP37 peer-provided bloom filter, with murmur3 bit positions computed for
+/// all hash functions in a single pass over the element. Transactions are
+/// matched by txid, output script pushes, spent outpoints and input script
+/// pushes, with matched outputs inserted as configured by the peer's flags.
+/// A block is matched in one pass, in transaction order (so that spends of
+/// outputs matched earlier in the block are matched), yielding its merkle
+/// block and the positions of the matched transactions.
+class BCT_API bloom_filter final
+{
+public:
+    DELETE_COPY_MOVE(bloom_filter);
+
+    typedef std::vector<size_t> indexes;
+
+    /// BIP37 limits.
+    static constexpr size_t maximum_filter = 36'000;
+    static constexpr size_t maximum_hash_functions = 50;
+    static constexpr size_t maximum_element = 520;
+
+    /// BIP37 update flags.
+    enum update : uint8_t
+    {
+        update_none = 0,
+        update_all = 1,
+        update_pay_key_only = 2,
+        update_mask = 3
+    };
+
+    /// Murmur3 (x86, 32 bit) of the data with the given seed.
+    static uint32_t murmur3(uint32_t seed,
+        const system::data_slice& data) NOEXCEPT;
+
+    /// The loaded filter is within BIP37 limits.
+    static bool is_valid(const messages::bloom_filter_load& load) NOEXCEPT;
+
+    /// Construct from a valid load message.
+    bloom_filter(const messages::bloom_filter_load& load) NOEXCEPT;
+
+    /// Insert the element.
+    void insert(const system::data_slice& element) NOEXCEPT;
+
+    /// True if the element has been inserted (or a false positive).
+    bool contains(const system::data_slice& element) const NOEXCEPT;
+
+    /// True if the transaction matches, inserting outputs per flags.
+    bool match(const system::chain::transaction& tx) NOEXCEPT;
+
+    /// The merkle block of the block, and positions of matched transactions.
+    messages::merkle_block match(indexes& matched,
+        const system::chain::block& block) NOEXCEPT;
+
+private:
+    // Matching a transaction hash also matches outputs.
+    bool match(const system::chain::transaction& tx,
+        const system::hash_digest& hash) NOEXCEPT;
+
+    // These are thread safe (const).
+    const uint32_t hash_functions_;
+    const uint32_t tweak_;
+    const uint8_t flags_;
+
+    // These are not thread safe.
+    system::data_chunk bits_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
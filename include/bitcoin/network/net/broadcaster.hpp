@@ -19,12 +19,17 @@
 #ifndef LIBBITCOIN_NETWORK_NET_BROADCASTER_HPP
 #define LIBBITCOIN_NETWORK_NET_BROADCASTER_HPP
 
+#include <atomic>
 #include <functional>
+#include <map>
+#include <memory>
 #include <utility>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/wire_cache.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -33,13 +38,17 @@ namespace network {
 #define SUBSCRIBER_TYPE(name) name##_subscriber
 #define DECLARE_SUBSCRIBER(name) SUBSCRIBER_TYPE(name) SUBSCRIBER(name)
 #define DEFINE_SUBSCRIBER(name) using SUBSCRIBER_TYPE(name) = \
-    desubscriber<channel_id, const messages::name::cptr&, channel_id>
+    desubscriber<channel_id, const messages::name::cptr&, \
+        const wire_cache::ptr&, channel_id>
 #define SUBSCRIBER_OVERLOAD(name) code do_subscribe( \
     broadcaster::handler<messages::name>&& handler, channel_id id) NOEXCEPT \
     { return SUBSCRIBER(name).subscribe(std::move(handler), id); }
 #define NOTIFY_OVERLOAD(name) inline void notify( \
-    const messages::name::cptr& message, channel_id sender) NOEXCEPT \
-    { SUBSCRIBER(name).notify(error::success, message, sender); }
+    const messages::name::cptr& message, channel_id sender, \
+    const requirement& required={}) NOEXCEPT \
+    { const auto cache = std::make_shared<wire_cache>(); \
+      SUBSCRIBER(name).notify(error::success, message, cache, sender); \
+      fanout(messages::name::id, message, cache, sender, required); }
 
 /// Not thread safe.
 class BCT_API broadcaster
@@ -47,10 +56,37 @@ class BCT_API broadcaster
 public:
     using channel_id = uint64_t;
 
+    /// Peer capabilities of a fan-out subscriber, set upon subscription
+    /// (after handshake). The fee filter may be updated at any time.
+    struct capabilities
+    {
+        uint64_t services{};
+        uint32_t version{};
+        bool relay{};
+        std::atomic<uint64_t> fee_filter{};
+    };
+
+    typedef std::shared_ptr<capabilities> capabilities_ptr;
+
+    /// Requirement of a broadcast, evaluated against subscriber capabilities
+    /// in the fan-out batch, before any subscriber handler is posted. Default
+    /// values are not restrictive (a zero fee rate is not fee filtered).
+    struct requirement
+    {
+        uint64_t services;
+        uint32_t version;
+        bool relay;
+        uint64_t fee_rate;
+
+        bool satisfied(const capabilities& peer) const NOEXCEPT;
+    };
+
     /// Helper for external declarations.
+    /// The cache is shared by all subscribers to one broadcast message.
     template <class Message>
-    using handler = std::function<bool(const code&,
-        const typename Message::cptr&, channel_id)>;
+    using handler = typename desubscriber<channel_id,
+        const typename Message::cptr&, const wire_cache::ptr&,
+        channel_id>::callback;
 
     DELETE_COPY_MOVE_DESTRUCT(broadcaster);
 
@@ -81,15 +117,23 @@ public:
     DEFINE_SUBSCRIBER(not_found);
     DEFINE_SUBSCRIBER(ping);
     DEFINE_SUBSCRIBER(pong);
+    DEFINE_SUBSCRIBER(reconciliation_difference);
+    DEFINE_SUBSCRIBER(reconciliation_sketch);
     DEFINE_SUBSCRIBER(reject);
+    DEFINE_SUBSCRIBER(request_reconciliation);
+    DEFINE_SUBSCRIBER(request_sketch_extension);
     DEFINE_SUBSCRIBER(send_compact);
     DEFINE_SUBSCRIBER(send_headers);
+    DEFINE_SUBSCRIBER(send_reconciliation);
     DEFINE_SUBSCRIBER(transaction);
     DEFINE_SUBSCRIBER(version);
     DEFINE_SUBSCRIBER(version_acknowledge);
+    DEFINE_SUBSCRIBER(wtxid_relay);
 
     /// Create an instance of this class.
-    broadcaster(asio::strand& strand) NOEXCEPT;
+    /// Fan-out subscribers of each execution context are partitioned into
+    /// the given number of slices (batches), zero is treated as one.
+    broadcaster(asio::strand& strand, size_t slices=one) NOEXCEPT;
 
     /// If stopped, handler is invoked with error::subscriber_stopped.
     /// If key exists, handler is invoked with error::subscriber_exists.
@@ -100,7 +144,36 @@ public:
         return do_subscribe(std::forward<Handler>(handler), subscriber);
     }
 
+    /// Subscribe for fan-out notification, handler is invoked on the strand.
+    /// Subscribers are grouped by execution context of the strand and
+    /// notified by one batch per group (slice), off of the broadcast strand.
+    /// The sender of a broadcast is not notified, and the handler result is
+    /// ignored (subscription ends with unsubscribe or stop). A subscriber with
+    /// capabilities is notified only of broadcasts with satisfied requirement
+    /// (transactions always require relay), others of all broadcasts.
+    /// If stopped, handler is invoked with error::subscriber_stopped.
+    /// If key exists, handler is invoked with error::subscriber_exists.
+    template <class Message>
+    code subscribe_fanout(handler<Message>&& handler, channel_id subscriber,
+        asio::strand& strand, const capabilities_ptr& peer={}) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        return do_subscribe_fanout(Message::id,
+            std::make_shared<const relay>(
+                [handler = std::move(handler)](const code& ec,
+                    const message_cptr& message, const wire_cache::ptr& cache,
+                    channel_id sender) NOEXCEPT
+                {
+                    return handler(ec,
+                        std::static_pointer_cast<const Message>(message),
+                        cache, sender);
+                }), subscriber, strand, peer);
+        BC_POP_WARNING()
+    }
+
     /// Relay a message instance to each subscriber of the type.
+    /// Subscribers share a wire cache, so the message is serialized once for
+    /// each distinct set of negotiated channel parameters.
     NOTIFY_OVERLOAD(address);
     NOTIFY_OVERLOAD(alert);
     NOTIFY_OVERLOAD(block);
@@ -128,12 +201,21 @@ public:
     NOTIFY_OVERLOAD(not_found);
     NOTIFY_OVERLOAD(ping);
     NOTIFY_OVERLOAD(pong);
+    NOTIFY_OVERLOAD(reconciliation_difference);
+    NOTIFY_OVERLOAD(reconciliation_sketch);
     NOTIFY_OVERLOAD(reject);
+    NOTIFY_OVERLOAD(request_reconciliation);
+    NOTIFY_OVERLOAD(request_sketch_extension);
     NOTIFY_OVERLOAD(send_compact);
     NOTIFY_OVERLOAD(send_headers);
+    NOTIFY_OVERLOAD(send_reconciliation);
     NOTIFY_OVERLOAD(transaction);
     NOTIFY_OVERLOAD(version);
     NOTIFY_OVERLOAD(version_acknowledge);
+    NOTIFY_OVERLOAD(wtxid_relay);
+
+    /// Set the fee rate of the fan-out subscriber, by which it is indexed.
+    void set_fee_filter(channel_id subscriber, uint64_t rate) NOEXCEPT;
 
     /// Unsubscribe the channel identifier from all subscribers.
     void unsubscribe(channel_id subscriber) NOEXCEPT;
@@ -144,6 +226,54 @@ public:
     virtual void stop(const code& ec) NOEXCEPT;
 
 private:
+    // Fan-out subscriptions are type-erased and keyed by message identifier.
+    typedef std::shared_ptr<const void> message_cptr;
+    typedef move_handler<bool(const code&, const message_cptr&,
+        const wire_cache::ptr&, channel_id)> relay;
+
+    struct target
+    {
+        channel_id id;
+        asio::strand* strand;
+        std::shared_ptr<const relay> handler;
+        capabilities_ptr peer;
+        uint64_t fee_filter;
+    };
+
+    // Targets are ordered by channel identifier and immutable once shared.
+    typedef std::vector<target> targets;
+    typedef std::shared_ptr<const targets> targets_cptr;
+
+    // Members are also indexed by ascending fee filter, so that a fee rated
+    // broadcast visits only those members that accept the rate.
+    struct shard
+    {
+        const asio::io_context* context;
+        size_t slice;
+        asio::executor_type executor;
+        targets_cptr members;
+        targets_cptr by_fee;
+    };
+
+    typedef std::vector<shard> shards;
+
+    static void post(const target& to, const code& ec,
+        const message_cptr& message, const wire_cache::ptr& cache,
+        channel_id sender) NOEXCEPT;
+    static void deliver(const shard& part, const message_cptr& message,
+        const wire_cache::ptr& cache, channel_id sender,
+        const requirement& required) NOEXCEPT;
+    static void set_members(shard& part, targets&& members) NOEXCEPT;
+
+    code do_subscribe_fanout(messages::identifier id,
+        std::shared_ptr<const relay>&& handler, channel_id subscriber,
+        asio::strand& strand, const capabilities_ptr& peer) NOEXCEPT;
+    void fanout(messages::identifier id, const message_cptr& message,
+        const wire_cache::ptr& cache, channel_id sender,
+        const requirement& required) NOEXCEPT;
+    void unsubscribe_fanout(channel_id subscriber) NOEXCEPT;
+    void stop_fanout(const code& ec) NOEXCEPT;
+
     SUBSCRIBER_OVERLOAD(address);
     SUBSCRIBER_OVERLOAD(alert);
     SUBSCRIBER_OVERLOAD(block);
@@ -171,12 +301,26 @@ private:
     SUBSCRIBER_OVERLOAD(not_found);
     SUBSCRIBER_OVERLOAD(ping);
     SUBSCRIBER_OVERLOAD(pong);
+    SUBSCRIBER_OVERLOAD(reconciliation_difference);
+    SUBSCRIBER_OVERLOAD(reconciliation_sketch);
     SUBSCRIBER_OVERLOAD(reject);
+    SUBSCRIBER_OVERLOAD(request_reconciliation);
+    SUBSCRIBER_OVERLOAD(request_sketch_extension);
     SUBSCRIBER_OVERLOAD(send_compact);
     SUBSCRIBER_OVERLOAD(send_headers);
+    SUBSCRIBER_OVERLOAD(send_reconciliation);
     SUBSCRIBER_OVERLOAD(transaction);
     SUBSCRIBER_OVERLOAD(version);
     SUBSCRIBER_OVERLOAD(version_acknowledge);
+    SUBSCRIBER_OVERLOAD(wtxid_relay);
+
+    // These are thread safe.
+    asio::strand& strand_;
+    const size_t slices_;
+
+    // These are protected by strand.
+    bool stopped_{ false };
+    std::map<messages::identifier, shards> fanouts_{};
 
     // These are thread safe.
     DECLARE_SUBSCRIBER(address);
@@ -206,12 +350,18 @@ private:
     DECLARE_SUBSCRIBER(not_found);
     DECLARE_SUBSCRIBER(ping);
     DECLARE_SUBSCRIBER(pong);
+    DECLARE_SUBSCRIBER(reconciliation_difference);
+    DECLARE_SUBSCRIBER(reconciliation_sketch);
     DECLARE_SUBSCRIBER(reject);
+    DECLARE_SUBSCRIBER(request_reconciliation);
+    DECLARE_SUBSCRIBER(request_sketch_extension);
     DECLARE_SUBSCRIBER(send_compact);
     DECLARE_SUBSCRIBER(send_headers);
+    DECLARE_SUBSCRIBER(send_reconciliation);
     DECLARE_SUBSCRIBER(transaction);
     DECLARE_SUBSCRIBER(version);
     DECLARE_SUBSCRIBER(version_acknowledge);
+    DECLARE_SUBSCRIBER(wtxid_relay);
 };
 
 #undef SUBSCRIBER
@@ -219,7 +369,7 @@ private:
 #undef DECLARE_SUBSCRIBER
 #undef DEFINE_SUBSCRIBER
 #undef SUBSCRIBER_OVERLOAD
-#undef CASE_NOTIFY
+#undef NOTIFY_OVERLOAD
 
 } // namespace network
 } // namespace libbitcoin
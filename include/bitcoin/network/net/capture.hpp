@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_CAPTURE_HPP
+#define LIBBITCOIN_NETWORK_NET_CAPTURE_HPP
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Binary capture of the messages read by a channel, as framed by the proxy.
+/// The file is a magic number followed by records, each the little-endian
+/// microseconds since capture start, message size, and raw message (heading
+/// and payload). Captures are replayed to a channel by net::replay.
+class BCT_API capture final
+{
+public:
+    typedef std::unique_ptr<capture> ptr;
+
+    /// A captured message.
+    struct record
+    {
+        uint64_t microseconds;
+        system::data_chunk message;
+    };
+
+    DELETE_COPY_MOVE(capture);
+
+    /// Capture file magic number ("bccp").
+    static constexpr uint32_t file_magic = 0x70636362;
+
+    /// Create (truncate) the capture file, writes fail if not created.
+    capture(const std::filesystem::path& file) NOEXCEPT;
+
+    /// The file is open and no write has failed.
+    bool good() const NOEXCEPT;
+
+    /// Append a record of the raw heading and payload (buffered).
+    bool write(const system::data_slice& heading,
+        const system::data_slice& payload) NOEXCEPT;
+
+    /// Read and verify the magic number of a capture stream.
+    static bool read_magic(std::istream& stream) NOEXCEPT;
+
+    /// Read the next record of a capture stream, false at end or failure.
+    static bool read(std::istream& stream, record& out) NOEXCEPT;
+
+private:
+    // These are not thread safe.
+    const steady_clock::time_point start_{ steady_clock::now() };
+    system::ofstream file_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
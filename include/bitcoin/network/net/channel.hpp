@@ -19,7 +19,9 @@
 #ifndef LIBBITCOIN_NETWORK_NET_CHANNEL_HPP
 #define LIBBITCOIN_NETWORK_NET_CHANNEL_HPP
 
+#include <atomic>
 #include <memory>
+#include <tuple>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
@@ -27,8 +29,11 @@
 #include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/messages/messages.hpp>
 #include <bitcoin/network/net/broadcaster.hpp>
+#include <bitcoin/network/net/capture.hpp>
 #include <bitcoin/network/net/deadline.hpp>
 #include <bitcoin/network/net/proxy.hpp>
+#include <bitcoin/network/net/resources.hpp>
+#include <bitcoin/network/net/rolling_filter.hpp>
 #include <bitcoin/network/settings.hpp>
 
 namespace libbitcoin {
@@ -47,6 +52,17 @@ class BCT_API channel
 public:
     typedef std::shared_ptr<channel> ptr;
 
+    /// Channels are constructed by sessions over recycled (slab) storage.
+    typedef slab_allocator<channel> allocator;
+
+    /// Round trip statistics in nanoseconds (zero prior to first sample).
+    struct latency
+    {
+        uint64_t smoothed;
+        uint64_t minimum;
+        uint64_t jitter;
+    };
+
     DELETE_COPY_MOVE(channel);
 
     /// Attach protocol to channel, caller must start (requires strand).
@@ -68,13 +84,46 @@ public:
             protocol->stopping(ec);
         });
 
+        protocols_ += sizeof(Protocol);
         return protocol;
     }
 
+    /// Attach a compile-time list of protocols under one stop subscription,
+    /// caller must start each (requires strand). The stop notification is
+    /// expanded over the list, so there is no per-protocol subscriber.
+    template <class... Protocols, class Session>
+    std::tuple<typename Protocols::ptr...> attach_all(Session& session) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+
+        if (!stranded())
+            return {};
+
+        // Protocols are attached after channel start (read paused).
+        const auto self = shared_from_base<channel>();
+        const std::tuple<typename Protocols::ptr...> protocols
+        {
+            std::make_shared<Protocols>(session, self)...
+        };
+
+        // Protocol lifetimes are ensured by the channel stop subscriber.
+        subscribe_stop([=](const code& ec) NOEXCEPT
+        {
+            std::apply([&](const auto&... protocol) NOEXCEPT
+            {
+                (protocol->stopping(ec), ...);
+            }, protocols);
+        });
+
+        protocols_ += (sizeof(Protocols) + ...);
+        return protocols;
+    }
+
     /// Construct a channel to encapsulated and communicate on the socket.
+    /// Retains the settings snapshot, if shared, for the channel lifetime.
     channel(const logger& log, const socket::ptr& socket, 
-        const settings& settings, uint64_t identifier=zero,
-        bool quiet=true) NOEXCEPT;
+        const network::settings& settings, const resources::ptr& shared,
+        uint64_t identifier=zero, bool quiet=true) NOEXCEPT;
 
     /// Asserts/logs stopped.
     virtual ~channel() NOEXCEPT;
@@ -94,10 +143,32 @@ public:
     /// Arbitrary identifier of the channel (for session subscribers).
     uint64_t identifier() const NOEXCEPT;
 
+    /// Settings snapshot with which the channel was created.
+    const network::settings& settings() const NOEXCEPT;
+
+    /// Duration since channel construction.
+    steady_clock::duration uptime() const NOEXCEPT;
+
     /// Start height for version message (set only before handshake).
     size_t start_height() const NOEXCEPT;
     void set_start_height(size_t height) NOEXCEPT;
 
+    /// Channel relays only blocks, no transactions or addresses (set only
+    /// before handshake).
+    bool block_relay() const NOEXCEPT;
+    void set_block_relay(bool value) NOEXCEPT;
+
+    /// Transactions are announced to and by the peer by wtxid (bip339), set
+    /// only during handshake.
+    bool wtxid_relay() const NOEXCEPT;
+    void set_wtxid_relay(bool value) NOEXCEPT;
+
+    /// Transactions are reconciled with the peer (bip330) using the short id
+    /// key, set only during handshake.
+    bool reconciliation() const NOEXCEPT;
+    const messages::siphash_key& reconciliation_key() const NOEXCEPT;
+    void set_reconciliation(const messages::siphash_key& key) NOEXCEPT;
+
     /// Negotiated version should be written only in handshake.
     uint32_t negotiated_version() const NOEXCEPT;
     void set_negotiated_version(uint32_t value) NOEXCEPT;
@@ -106,16 +177,73 @@ public:
     messages::version::cptr peer_version() const NOEXCEPT;
     void set_peer_version(const messages::version::cptr& value) NOEXCEPT;
 
+    /// Peer capabilities for broadcast pre-filtering, set from the handshake
+    /// upon first call (requires strand, after handshake).
+    broadcaster::capabilities_ptr capabilities() NOEXCEPT;
+
+    /// Minimum fee rate of transactions announced to peer (thread safe).
+    void set_fee_filter(uint64_t rate) NOEXCEPT;
+
+    /// Minimum fee rate of transactions announced to peer (requires strand).
+    uint64_t fee_filter() const NOEXCEPT;
+
     /// Originating address of connection with current time and peer services.
     address_item_cptr get_updated_address() const NOEXCEPT;
 
+    /// Queue an inventory item for announcement to peer (requires strand).
+    /// Items known to the peer are dropped, and queued items are sent as one
+    /// inventory message upon the randomized trickle interval.
+    void announce(const messages::inventory_item& item) NOEXCEPT;
+
+    /// Record a hash as known to the peer, suppressing its announcement.
+    /// Hashes are also recorded upon announcement to and by the peer.
+    void set_known(const system::hash_digest& hash) NOEXCEPT;
+
+    /// The hash is known to the peer, probabilistic (requires strand).
+    bool is_known(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Ping round trip statistics, thread safe (each value independently).
+    latency round_trip() const NOEXCEPT;
+
+    /// Update round trip statistics with a sample (requires strand).
+    void set_round_trip(uint64_t nanoseconds) NOEXCEPT;
+
+    /// Estimated memory of the channel by component (requires strand).
+    footprint memory() const NOEXCEPT override;
+
 protected:
     /// Property values provided to the proxy.
-    size_t minimum_buffer() const NOEXCEPT override;
     size_t maximum_payload() const NOEXCEPT override;
     uint32_t protocol_magic() const NOEXCEPT override;
     bool validate_checksum() const NOEXCEPT override;
+    bool retain_payload() const NOEXCEPT override;
+    size_t maximum_gather_count() const NOEXCEPT override;
+    size_t maximum_gather_bytes() const NOEXCEPT override;
+    size_t deserialize_threshold() const NOEXCEPT override;
+    size_t read_chunk() const NOEXCEPT override;
+    size_t read_ahead() const NOEXCEPT override;
+    size_t write_slice() const NOEXCEPT override;
+    size_t buffer_retain() const NOEXCEPT override;
+    deadline::duration buffer_idle() const NOEXCEPT override;
+    deadline::duration read_quantum() const NOEXCEPT override;
+    bool batch_checksum() const NOEXCEPT override;
+    bool deduplicate_sends() const NOEXCEPT override;
+    bool pool_sends() const NOEXCEPT override;
+    size_t rate_limit() const NOEXCEPT override;
+    size_t send_high_water() const NOEXCEPT override;
+    size_t send_low_water() const NOEXCEPT override;
+    deadline::duration send_grace() const NOEXCEPT override;
+    size_t compression_minimum() const NOEXCEPT override;
     uint32_t version() const NOEXCEPT override;
+    bool trusted() const NOEXCEPT override;
+    size_t trace_sample() const NOEXCEPT override;
+    uint64_t trace_id() const NOEXCEPT override;
+    asio::io_context& deserializer() NOEXCEPT override;
+    checksum_batcher& checksums() NOEXCEPT override;
+    metrics& aggregate() NOEXCEPT override;
+    upload_budget& uploads() NOEXCEPT override;
+    capture* recorder() NOEXCEPT override;
+    message_exporter* exporter() NOEXCEPT override;
 
     /// Signals inbound traffic, called from proxy on strand (requires strand).
     void signal_activity() NOEXCEPT override;
@@ -128,25 +256,55 @@ private:
     void handle_expiration(const code& ec) NOEXCEPT;
 
     void start_inactivity() NOEXCEPT;
+    void start_inactivity(const deadline::duration& timeout) NOEXCEPT;
     void handle_inactivity(const code& ec) NOEXCEPT;
 
+    bool handle_inventory(const code& ec,
+        const messages::inventory::cptr& message) NOEXCEPT;
+    void start_trickle() NOEXCEPT;
+    void handle_trickle(const code& ec) NOEXCEPT;
+    void flush_announcements() NOEXCEPT;
+    void handle_announce(const code& ec) NOEXCEPT;
+
     // Proxy base class is not fully thread safe.
 
     // These are thread safe (const).
     const bool quiet_;
-    const settings& settings_;
+    const bool traced_;
+    const bool trusted_;
+    const network::settings& settings_;
+    const network::settings::cptr retained_;
+    const resources::ptr resources_;
     const uint64_t identifier_;
+    const steady_clock::time_point created_{ steady_clock::now() };
     const uint64_t nonce_
     {
         system::pseudo_random::next<uint64_t>(one, max_uint64)
     };
 
+    // These are written on the strand and readable from any thread.
+    std::atomic<uint64_t> rtt_smoothed_{};
+    std::atomic<uint64_t> rtt_minimum_{};
+    std::atomic<uint64_t> rtt_jitter_{};
+
     // These are not thread safe.
     deadline::ptr expiration_;
     deadline::ptr inactivity_;
+    deadline::ptr trickle_;
+    capture::ptr capture_;
+    steady_clock::time_point activity_{};
+    messages::inventory_items announcements_{};
+    rolling_filter known_;
+    bool inventoried_{};
     uint32_t negotiated_version_;
     messages::version::cptr peer_version_{};
+    broadcaster::capabilities_ptr capabilities_{};
     size_t start_height_{};
+    size_t protocols_{};
+    bool block_relay_{};
+    bool wtxid_relay_{};
+    bool reconciliation_{};
+    messages::siphash_key reconciliation_key_{};
 };
 
 typedef std::function<void(const code&, const channel::ptr&)> channel_handler;
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_CHECKSUM_BATCHER_HPP
+#define LIBBITCOIN_NETWORK_NET_CHECKSUM_BATCHER_HPP
+
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Payload hash (double sha256) service shared by the channels of a network.
+/// Payloads submitted within the window (or until a full group of lanes is
+/// pending) are hashed together on the batcher thread, using the lane
+/// interleaved payload_hash::batch, ordered by size so that lanes of a group
+/// are of similar length. Each hash is posted to the submitting strand.
+class BCT_API checksum_batcher final
+{
+public:
+    typedef steady_clock::duration duration;
+    typedef std::function<void(const system::hash_cptr&)> handler;
+
+    DELETE_COPY_MOVE(checksum_batcher);
+
+    /// Payloads larger than this are not batched (hash them in place).
+    static constexpr size_t maximum_payload = 65'536;
+
+    /// Construct a batcher of the window on its own thread.
+    checksum_batcher(const duration& window) NOEXCEPT;
+
+    /// Stop and join the thread, pending handlers are not invoked.
+    ~checksum_batcher() NOEXCEPT;
+
+    /// Queue the payload, the handler is posted to strand with its hash.
+    /// The payload is released by the batcher before the handler is posted.
+    void submit(const system::chunk_ptr& payload, asio::strand& strand,
+        handler&& complete) NOEXCEPT;
+
+private:
+    struct job
+    {
+        system::chunk_ptr payload;
+        asio::strand* strand;
+        handler complete;
+    };
+
+    typedef std::vector<job> jobs;
+
+    void arm() NOEXCEPT;
+    void handle_window(const error::boost_code& ec) NOEXCEPT;
+    void hash(jobs&& batch) NOEXCEPT;
+
+    // These are thread safe.
+    const duration window_;
+    threadpool pool_{};
+
+    // These are protected by mutex.
+    jobs pending_{};
+    bool armed_{};
+    bool stopped_{};
+    mutable std::mutex mutex_{};
+
+    // This is protected by the batcher thread.
+    asio::steady_timer timer_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -27,6 +27,7 @@
 #include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/messages/messages.hpp>
 #include <bitcoin/network/net/deadline.hpp>
+#include <bitcoin/network/net/resources.hpp>
 #include <bitcoin/network/net/socket.hpp>
 #include <bitcoin/network/settings.hpp>
 
@@ -51,7 +52,13 @@ public:
 
     /// Construct an instance.
     connector(const logger& log, asio::strand& strand,
-        asio::io_context& service, const settings& settings) NOEXCEPT;
+        asio::io_context& service, const settings& settings,
+        const resources::ptr& shared) NOEXCEPT;
+
+    /// Construct an instance creating sockets round robin on services.
+    connector(const logger& log, asio::strand& strand,
+        threadpools& services, const settings& settings,
+        const resources::ptr& shared) NOEXCEPT;
 
     /// Asserts/logs stopped.
     virtual ~connector() NOEXCEPT;
@@ -76,38 +83,79 @@ public:
         socket_handler&& handler) NOEXCEPT;
 
     /// Try to connect to the endpoint, starts timer.
+    /// A name that resolves to both address families races the families,
+    /// the alternate started after the configured stagger (RFC 8305).
     virtual void connect(const config::endpoint& endpoint,
         socket_handler&& handler) NOEXCEPT;
 
 protected:
+    /// The service of the next socket.
+    asio::io_context& socket_service() NOEXCEPT;
+
     typedef race_speed<two, const code&, const socket::ptr&> racer_t;
 
     /// Try to connect to host:port, starts timer.
     virtual void start(const std::string& hostname, uint16_t port,
         const config::address& host, socket_handler&& handler) NOEXCEPT;
 
+    /// Try to connect to a numeric endpoint (not resolved), starts timer.
+    virtual void start(const asio::endpoint& point,
+        const config::address& host, socket_handler&& handler) NOEXCEPT;
+
     // These are thread safe
     const settings& settings_;
+    const settings::cptr retained_;
+    const resources::ptr resources_;
     asio::io_context& service_;
+    threadpools* const services_;
     asio::strand& strand_;
 
     // These are protected by strand.
     asio::resolver resolver_;
     deadline::ptr timer_;
     racer_t racer_{};
+    size_t ticket_{};
+    steady_clock::time_point started_{};
 
 private:
     typedef std::shared_ptr<bool> finish_ptr;
 
+    // Dual stack (RFC 8305) race of the alternate address family.
+    struct dual
+    {
+        socket::ptr alternate;
+        deadline::ptr stagger;
+        size_t attempts;
+    };
+
+    typedef std::shared_ptr<dual> dual_ptr;
+
     void handle_resolve(const error::boost_code& ec,
         const asio::endpoints& range, const finish_ptr& finish,
         const socket::ptr& socket) NOEXCEPT;
+    void start_dual(const asio::endpoints& primary,
+        const asio::endpoints& secondary, const finish_ptr& finish,
+        const socket::ptr& socket) NOEXCEPT;
+    void handle_stagger(const code& ec, const asio::endpoints& range,
+        const finish_ptr& finish, const socket::ptr& socket,
+        const dual_ptr& state) NOEXCEPT;
+    void do_handle_attempt(const code& ec, const finish_ptr& finish,
+        const socket::ptr& attempt, const socket::ptr& socket,
+        const dual_ptr& state) NOEXCEPT;
+    void handle_attempt(const code& ec, const finish_ptr& finish,
+        const socket::ptr& attempt, const socket::ptr& socket,
+        const dual_ptr& state) NOEXCEPT;
     void do_handle_connect(const code& ec, const finish_ptr& finish,
         const socket::ptr& socket) NOEXCEPT;
     void handle_connect(const code& ec, const finish_ptr& finish,
         const socket::ptr& socket) NOEXCEPT;
     void handle_timer(const code& ec, const finish_ptr& finish,
         const socket::ptr& socket) NOEXCEPT;
+    void stop_dual() NOEXCEPT;
+    void cancel_resolve() NOEXCEPT;
+
+    // This is protected by strand (dual stack race of current connect).
+    dual_ptr dual_{};
 };
 
 typedef std::vector<connector::ptr> connectors;
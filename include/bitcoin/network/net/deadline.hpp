@@ -24,6 +24,7 @@
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/timer_wheel.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -32,6 +33,8 @@ namespace network {
 /// Class wrapper for boost::asio::basic_waitable_timer (restartable).
 /// This simplifies invocation, eliminates boost-specific error handling and
 /// makes timer firing and cancellation conditions safe for shared objects.
+/// A deadline on a timer wheel is scheduled by the wheel for timeouts of at
+/// least the wheel resolution, saving an asio timer rearm on each restart.
 class BCT_API deadline final
   : public std::enable_shared_from_this<deadline>, protected tracker<deadline>
 {
@@ -40,11 +43,18 @@ public:
 
     typedef steady_clock::duration duration;
     typedef std::shared_ptr<deadline> ptr;
+
+    /// Allocator of the channel timers, which share the channel lifetime.
+    typedef slab_allocator<deadline> allocator;
     
     /// Timer notification handler is posted to the service.
     deadline(const logger& log, asio::strand& strand,
         const duration& timeout=seconds(0)) NOEXCEPT;
 
+    /// Timer notification handler is posted to the strand by the wheel.
+    deadline(const logger& log, asio::strand& strand, timer_wheel& wheel,
+        const duration& timeout=seconds(0)) NOEXCEPT;
+
     /// Assert timer stopped.
     ~deadline() NOEXCEPT;
 
@@ -63,11 +73,15 @@ private:
     void handle_timer(const error::boost_code& ec,
         const result_handler& handle) NOEXCEPT;
 
-    // This is thread safe.
+    // These are thread safe.
     const duration duration_;
+    asio::strand& strand_;
+    timer_wheel* const wheel_;
 
-    // This is not thread safe.
+    // These are not thread safe.
     asio::steady_timer timer_;
+    timer_wheel::key key_{};
+    bool waiting_{};
 };
 
 } // namespace network
@@ -19,24 +19,23 @@
 #ifndef LIBBITCOIN_NETWORK_NET_DISTRIBUTOR_HPP
 #define LIBBITCOIN_NETWORK_NET_DISTRIBUTOR_HPP
 
+#include <array>
 #include <functional>
+#include <memory>
+#include <tuple>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/recycler.hpp>
 
 namespace libbitcoin {
 namespace network {
 
-#define SUBSCRIBER(name) name##_subscriber_
-#define SUBSCRIBER_TYPE(name) name##_subscriber
-#define DECLARE_SUBSCRIBER(name) SUBSCRIBER_TYPE(name) SUBSCRIBER(name)
-#define DEFINE_SUBSCRIBER(name) using SUBSCRIBER_TYPE(name) = \
-    unsubscriber<const messages::name::cptr&>
 #define SUBSCRIBER_OVERLOAD(name) code do_subscribe( \
     distributor::handler<messages::name>&& handler) NOEXCEPT \
-    { return SUBSCRIBER(name).subscribe(std::move(handler)); }
+    { return subscribe_type<messages::name>(std::move(handler)); }
 
 /// Not thread safe.
 class BCT_API distributor
@@ -44,44 +43,32 @@ class BCT_API distributor
 public:
     /// Helper for external declarations.
     template <class Message>
-    using handler = std::function<bool(const code&,
-        const typename Message::cptr&)>;
+    using handler = typename unsubscriber<
+        const typename Message::cptr&>::callback;
+
+    /// The number of message identifiers, including unknown (zero).
+    static constexpr size_t identifiers = add1(static_cast<size_t>(
+        messages::identifier::request_sketch_extension));
+
+    /// Deferred notification of a deserialized message (requires strand).
+    typedef std::function<void()> delivery;
+
+    /// Scheduling lane of a message type. Control messages are deserialized
+    /// on the channel strand, bulk messages on the deserializer (if enabled),
+    /// and normal messages by the configured payload size threshold.
+    enum class lane : uint8_t
+    {
+        control,
+        normal,
+        bulk
+    };
 
     DELETE_COPY_MOVE_DESTRUCT(distributor);
 
-    DEFINE_SUBSCRIBER(address);
-    DEFINE_SUBSCRIBER(alert);
-    DEFINE_SUBSCRIBER(block);
-    DEFINE_SUBSCRIBER(bloom_filter_add);
-    DEFINE_SUBSCRIBER(bloom_filter_clear);
-    DEFINE_SUBSCRIBER(bloom_filter_load);
-    DEFINE_SUBSCRIBER(client_filter);
-    DEFINE_SUBSCRIBER(client_filter_checkpoint);
-    DEFINE_SUBSCRIBER(client_filter_headers);
-    DEFINE_SUBSCRIBER(compact_block);
-    DEFINE_SUBSCRIBER(compact_transactions);
-    DEFINE_SUBSCRIBER(fee_filter);
-    DEFINE_SUBSCRIBER(get_address);
-    DEFINE_SUBSCRIBER(get_blocks);
-    DEFINE_SUBSCRIBER(get_client_filter_checkpoint);
-    DEFINE_SUBSCRIBER(get_client_filter_headers);
-    DEFINE_SUBSCRIBER(get_client_filters);
-    DEFINE_SUBSCRIBER(get_compact_transactions);
-    DEFINE_SUBSCRIBER(get_data);
-    DEFINE_SUBSCRIBER(get_headers);
-    DEFINE_SUBSCRIBER(headers);
-    DEFINE_SUBSCRIBER(inventory);
-    DEFINE_SUBSCRIBER(memory_pool);
-    DEFINE_SUBSCRIBER(merkle_block);
-    DEFINE_SUBSCRIBER(not_found);
-    DEFINE_SUBSCRIBER(ping);
-    DEFINE_SUBSCRIBER(pong);
-    DEFINE_SUBSCRIBER(reject);
-    DEFINE_SUBSCRIBER(send_compact);
-    DEFINE_SUBSCRIBER(send_headers);
-    DEFINE_SUBSCRIBER(transaction);
-    DEFINE_SUBSCRIBER(version);
-    DEFINE_SUBSCRIBER(version_acknowledge);
+    /// Subscriber of a message type.
+    template <class Message>
+    using message_subscriber = unsubscriber<const typename Message::cptr&>;
+
 
     /// Create an instance of this class.
     distributor(asio::strand& strand) NOEXCEPT;
@@ -96,9 +83,64 @@ public:
     }
 
     /// Relay a message instance to each subscriber of the type.
+    /// The optional payload hash (double sha256) seeds message identity.
+    /// Returns error code if fails to deserialize, otherwise success.
+    virtual code notify(messages::identifier id, uint32_t version,
+        const system::data_chunk& data,
+        const system::hash_cptr& hash={}) NOEXCEPT;
+
+    /// Relay a message instance to each subscriber of the type.
+    /// Block and transaction messages retain the payload (zero-copy), so the
+    /// caller must not reuse a payload that remains referenced after notify.
     /// Returns error code if fails to deserialize, otherwise success.
     virtual code notify(messages::identifier id, uint32_t version,
-        const system::data_chunk& data) NOEXCEPT;
+        const system::chunk_ptr& data,
+        const system::hash_cptr& hash={}) NOEXCEPT;
+
+    /// Deserialize a message instance for subsequent delivery to subscribers.
+    /// Does not access subscribers, so may be invoked off of the strand.
+    /// Returns error code if fails to deserialize, otherwise sets delivery.
+    virtual code prepare(delivery& out, messages::identifier id,
+        uint32_t version, const system::data_chunk& data,
+        const system::hash_cptr& hash={}) NOEXCEPT;
+
+    /// Deserialize a message instance for subsequent delivery to subscribers.
+    /// Block and transaction messages retain the payload (zero-copy).
+    /// Does not access subscribers, so may be invoked off of the strand.
+    /// Returns error code if fails to deserialize, otherwise sets delivery.
+    virtual code prepare(delivery& out, messages::identifier id,
+        uint32_t version, const system::chunk_ptr& data,
+        const system::hash_cptr& hash={}) NOEXCEPT;
+
+    /// Relay a deserialized message instance to each subscriber of the type
+    /// (requires strand). Used for messages parsed incrementally by the proxy.
+    template <class Message>
+    void deliver(const typename Message::cptr& message) NOEXCEPT
+    {
+        const auto subscribers = find<Message>();
+        if (!is_null(subscribers))
+            subscribers->notify(error::success, message);
+    }
+
+    /// Set the scheduling lane of the message type (requires strand).
+    template <class Message>
+    void prioritize(lane priority) NOEXCEPT
+    {
+        lanes_[static_cast<size_t>(Message::id)] = priority;
+    }
+
+    /// The scheduling lane of the message type, O(1).
+    virtual lane priority(messages::identifier id) const NOEXCEPT;
+
+    /// There is at least one subscriber to the message type.
+    /// Subscribers are created upon first subscription to the type, so this
+    /// is linear in the (small) number of message types subscribed.
+    /// Messages without subscribers are not deserialized by notify.
+    virtual bool subscribed(messages::identifier id) const NOEXCEPT;
+
+    /// Estimated heap bytes of subscriptions (slots are created upon first
+    /// subscription to a type, so an unsubscribed type costs nothing).
+    virtual size_t memory() const NOEXCEPT;
 
     /// Stop all subscribers, prevents subsequent subscription (idempotent).
     /// The subscriber is stopped regardless of the error code, however by
@@ -106,21 +148,168 @@ public:
     virtual void stop(const code& ec) NOEXCEPT;
 
 private:
+    // Subscriber slot of a message type, created upon first subscription.
+    class slot
+    {
+    public:
+        DELETE_COPY_MOVE(slot);
+
+        slot() NOEXCEPT = default;
+        virtual ~slot() NOEXCEPT = default;
+        virtual size_t size() const NOEXCEPT = 0;
+        virtual size_t bytes() const NOEXCEPT = 0;
+        virtual void stop(const code& ec) NOEXCEPT = 0;
+    };
+
+    template <class Message>
+    class typed_slot final
+      : public slot
+    {
+    public:
+        typed_slot(asio::strand& strand) NOEXCEPT
+          : subscribers(strand)
+        {
+        }
+
+        size_t size() const NOEXCEPT override
+        {
+            return subscribers.size();
+        }
+
+        size_t bytes() const NOEXCEPT override
+        {
+            using callback = typename message_subscriber<Message>::callback;
+            return sizeof(typed_slot) + size() * sizeof(callback);
+        }
+
+        void stop(const code& ec) NOEXCEPT override
+        {
+            subscribers.stop_default(ec);
+        }
+
+        message_subscriber<Message> subscribers;
+    };
+
+    // Dispatch tables are indexed by messages::identifier.
+    template <typename Data>
+    using notifier = code(distributor::*)(uint32_t, const Data&,
+        const system::hash_cptr&) NOEXCEPT;
+    template <typename Data>
+    using preparer = code(distributor::*)(delivery&, uint32_t, const Data&,
+        const system::hash_cptr&) NOEXCEPT;
+
+    // Select the subscriber by message identifier and notify.
+    template <typename Data>
+    code notify_data(messages::identifier id, uint32_t version,
+        const Data& data, const system::hash_cptr& hash) NOEXCEPT;
+
+    // Select the message type by identifier and prepare delivery.
+    template <typename Data>
+    code prepare_data(delivery& out, messages::identifier id,
+        uint32_t version, const Data& data,
+        const system::hash_cptr& hash) NOEXCEPT;
+
+    // High frequency (small or vector) message types are recycled.
+    using recyclers = std::tuple<
+        recycler<messages::address>,
+        recycler<messages::get_data>,
+        recycler<messages::inventory>,
+        recycler<messages::ping>,
+        recycler<messages::pong>>;
+
+    template <class Message>
+    static constexpr bool recycled =
+        system::is_same_type<Message, messages::address> ||
+        system::is_same_type<Message, messages::get_data> ||
+        system::is_same_type<Message, messages::inventory> ||
+        system::is_same_type<Message, messages::ping> ||
+        system::is_same_type<Message, messages::pong>;
+
+    // Deserialize a message instance, recycled if of a recycled type.
+    template <typename Message, typename Data>
+    typename Message::cptr deserialize(uint32_t version, const Data& data,
+        const system::hash_cptr& hash) NOEXCEPT
+    {
+        if constexpr (!recycled<Message>)
+            return messages::deserialize<Message>(data, version, hash);
+        else if constexpr (system::is_same_type<Data, system::chunk_ptr>)
+            return data ? std::get<recycler<Message>>(recyclers_)
+                .deserialize(version, *data) : nullptr;
+        else
+            return std::get<recycler<Message>>(recyclers_)
+                .deserialize(version, data);
+    }
+
     // Deserialize a stream into a message instance and notify subscribers.
-    template <typename Message, typename Subscriber>
-    code do_notify(Subscriber& subscriber, uint32_t version,
-        const system::data_chunk& data) NOEXCEPT
+    template <typename Message, typename Data>
+    code do_notify(uint32_t version, const Data& data,
+        const system::hash_cptr& hash) NOEXCEPT
     {
+        const auto subscribers = find<Message>();
+
         // Avoid deserialization if there are no subscribers for the type.
-        if (!is_zero(subscriber.size()))
+        if (is_null(subscribers) || is_zero(subscribers->size()))
+            return error::success;
+
+        // Subscribers are notified only with stop code or error::success.
+        const auto message = deserialize<Message>(version, data, hash);
+        if (!message) return error::invalid_message;
+        subscribers->notify(error::success, message);
+        return error::success;
+    }
+
+    // Deserialize a stream into a message instance, bound for notification.
+    template <typename Message, typename Data>
+    code do_prepare(delivery& out, uint32_t version, const Data& data,
+        const system::hash_cptr& hash) NOEXCEPT
+    {
+        const auto message = deserialize<Message>(version, data, hash);
+        if (!message) return error::invalid_message;
+
+        // Subscribers are resolved upon delivery, which requires the strand.
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        out = [this, message]() NOEXCEPT
+        {
+            const auto subscribers = find<Message>();
+            if (!is_null(subscribers))
+                subscribers->notify(error::success, message);
+        };
+        BC_POP_WARNING()
+        return error::success;
+    }
+
+    // The subscriber of the message type, or nullptr if never subscribed.
+    template <class Message>
+    message_subscriber<Message>* find() const NOEXCEPT
+    {
+        static_assert(static_cast<size_t>(Message::id) < identifiers);
+        const auto& entry = slots_[static_cast<size_t>(Message::id)];
+        return entry ? &static_cast<typed_slot<Message>*>(
+            entry.get())->subscribers : nullptr;
+    }
+
+    // Subscribe to the message type, creating its slot as required.
+    template <class Message>
+    code subscribe_type(handler<Message>&& handler) NOEXCEPT
+    {
+        if (stopped_)
         {
-            // Subscribers are notified only with stop code or error::success.
-            const auto message = messages::deserialize<Message>(data, version);
-            if (!message) return error::invalid_message;
-            subscriber.notify(error::success, message);
+            /*bool*/ handler(error::subscriber_stopped,
+                typename Message::cptr{});
+            return error::subscriber_stopped;
         }
 
-        return error::success;
+        auto subscribers = find<Message>();
+        if (is_null(subscribers))
+        {
+            BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+            auto entry = std::make_unique<typed_slot<Message>>(strand_);
+            subscribers = &entry->subscribers;
+            slots_[static_cast<size_t>(Message::id)] = std::move(entry);
+            BC_POP_WARNING()
+        }
+
+        return subscribers->subscribe(std::move(handler));
     }
 
     SUBSCRIBER_OVERLOAD(address);
@@ -150,54 +339,30 @@ private:
     SUBSCRIBER_OVERLOAD(not_found);
     SUBSCRIBER_OVERLOAD(ping);
     SUBSCRIBER_OVERLOAD(pong);
+    SUBSCRIBER_OVERLOAD(reconciliation_difference);
+    SUBSCRIBER_OVERLOAD(reconciliation_sketch);
     SUBSCRIBER_OVERLOAD(reject);
+    SUBSCRIBER_OVERLOAD(request_reconciliation);
+    SUBSCRIBER_OVERLOAD(request_sketch_extension);
     SUBSCRIBER_OVERLOAD(send_compact);
     SUBSCRIBER_OVERLOAD(send_headers);
+    SUBSCRIBER_OVERLOAD(send_reconciliation);
     SUBSCRIBER_OVERLOAD(transaction);
     SUBSCRIBER_OVERLOAD(version);
     SUBSCRIBER_OVERLOAD(version_acknowledge);
+    SUBSCRIBER_OVERLOAD(wtxid_relay);
 
     // These are thread safe.
-    DECLARE_SUBSCRIBER(address);
-    DECLARE_SUBSCRIBER(alert);
-    DECLARE_SUBSCRIBER(block);
-    DECLARE_SUBSCRIBER(bloom_filter_add);
-    DECLARE_SUBSCRIBER(bloom_filter_clear);
-    DECLARE_SUBSCRIBER(bloom_filter_load);
-    DECLARE_SUBSCRIBER(client_filter);
-    DECLARE_SUBSCRIBER(client_filter_checkpoint);
-    DECLARE_SUBSCRIBER(client_filter_headers);
-    DECLARE_SUBSCRIBER(compact_block);
-    DECLARE_SUBSCRIBER(compact_transactions);
-    DECLARE_SUBSCRIBER(fee_filter);
-    DECLARE_SUBSCRIBER(get_address);
-    DECLARE_SUBSCRIBER(get_blocks);
-    DECLARE_SUBSCRIBER(get_client_filter_checkpoint);
-    DECLARE_SUBSCRIBER(get_client_filter_headers);
-    DECLARE_SUBSCRIBER(get_client_filters);
-    DECLARE_SUBSCRIBER(get_compact_transactions);
-    DECLARE_SUBSCRIBER(get_data);
-    DECLARE_SUBSCRIBER(get_headers);
-    DECLARE_SUBSCRIBER(headers);
-    DECLARE_SUBSCRIBER(inventory);
-    DECLARE_SUBSCRIBER(memory_pool);
-    DECLARE_SUBSCRIBER(merkle_block);
-    DECLARE_SUBSCRIBER(not_found);
-    DECLARE_SUBSCRIBER(ping);
-    DECLARE_SUBSCRIBER(pong);
-    DECLARE_SUBSCRIBER(reject);
-    DECLARE_SUBSCRIBER(send_compact);
-    DECLARE_SUBSCRIBER(send_headers);
-    DECLARE_SUBSCRIBER(transaction);
-    DECLARE_SUBSCRIBER(version);
-    DECLARE_SUBSCRIBER(version_acknowledge);
+    asio::strand& strand_;
+    recyclers recyclers_{};
+
+    // These are protected by strand (indexed by messages::identifier).
+    bool stopped_{ false };
+    std::array<lane, identifiers> lanes_;
+    std::array<std::unique_ptr<slot>, identifiers> slots_{};
 };
 
-#undef SUBSCRIBER
-#undef SUBSCRIBER_TYPE
-#undef DEFINE_SUBSCRIBER
 #undef SUBSCRIBER_OVERLOAD
-#undef DECLARE_SUBSCRIBER
 
 } // namespace network
 } // namespace libbitcoin
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_EVICTION_HPP
+#define LIBBITCOIN_NETWORK_NET_EVICTION_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Selection of an inbound channel to evict for a new connection, in the
+/// manner of the satoshi client. Candidates are protected in turn by network
+/// group diversity, by lowest round trip, by most bytes received and then
+/// half of those remaining by longest uptime. Of those that remain, the
+/// channel of the most represented network group with the highest processing
+/// cost (per uptime) is selected, with ties to the youngest. The distinct
+/// criteria make it costly for an attacker to displace all peers.
+class BCT_API eviction final
+{
+public:
+    struct candidate
+    {
+        uint64_t identifier;
+        uint64_t group;
+        uint64_t round_trip;
+        uint64_t received;
+        steady_clock::duration uptime;
+        uint64_t processing;
+    };
+
+    typedef std::vector<candidate> candidates;
+
+    /// Count of candidates protected by each criterion.
+    static constexpr size_t protect_group = 4;
+    static constexpr size_t protect_round_trip = 8;
+    static constexpr size_t protect_received = 4;
+
+    /// Select the identifier of the candidate to evict, false if none.
+    /// An unsampled (zero) round trip is considered the slowest.
+    static bool select(uint64_t& out, candidates peers) NOEXCEPT;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
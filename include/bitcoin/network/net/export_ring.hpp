@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_EXPORT_RING_HPP
+#define LIBBITCOIN_NETWORK_NET_EXPORT_RING_HPP
+
+#include <atomic>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe (write requires a single producer), non-virtual.
+/// Readers are thread safe (lock free) and may be in other processes (of the
+/// same user, the region is created owner read/write only).
+/// Shared memory (POSIX) ring of received messages. The region is a header,
+/// a power of two count of record slots and a byte arena, with the header
+/// and each slot a 64 byte line of little-endian 64 bit words:
+///     header: magic|format (32|32), slots, arena, head, cursor
+///     slot:   sequence, position, channel, size, identifier, version
+/// Record n is in slot (n % slots) and its payload is contiguous at
+/// (position % arena) bytes into the arena. The producer marks a slot odd
+/// (2n+1) while writing and publishes it as even (2n+2), advancing the arena
+/// cursor before bytes are overwritten. A reader (seqlock) uses the payload
+/// in place and then confirms it is intact, so readers neither copy nor hold
+/// the producer, which overwrites the oldest records. Not supported on Windows
+/// (the ring is not good).
+class BCT_API export_ring final
+{
+public:
+    /// Result of reading a record.
+    enum class status
+    {
+        /// The record is published (confirm intact after use).
+        ready,
+
+        /// The record is not yet published.
+        pending,
+
+        /// The record has been overwritten (resume at tail).
+        lapped
+    };
+
+    /// A record in place (payload references the shared region).
+    struct record
+    {
+        uint64_t sequence;
+        uint64_t position;
+        uint64_t channel;
+        uint32_t version;
+        messages::identifier id;
+        system::data_slice payload;
+    };
+
+    DELETE_COPY_MOVE(export_ring);
+
+    /// Ring magic number ("bcxr") and format version.
+    static constexpr uint32_t ring_magic = 0x72786362;
+    static constexpr uint32_t ring_format = 1;
+
+    /// Create (replace) the named ring of arena bytes and slots (producer).
+    /// Slots are rounded up to a power of two.
+    export_ring(const std::string& name, size_t arena, size_t slots) NOEXCEPT;
+
+    /// Open the named ring for reading (consumer).
+    export_ring(const std::string& name) NOEXCEPT;
+
+    /// Unmap the region, the producer also removes the name.
+    ~export_ring() NOEXCEPT;
+
+    /// The region is mapped and of the expected format.
+    bool good() const NOEXCEPT;
+
+    /// Arena bytes (bound on the size of a record payload).
+    size_t capacity() const NOEXCEPT;
+
+    /// Write the record as the next sequence (producer only).
+    /// False if not good, not the producer or larger than the arena.
+    bool write(messages::identifier id, uint64_t channel, uint32_t version,
+        const system::data_slice& payload) NOEXCEPT;
+
+    /// Sequence of the next record to be published.
+    uint64_t head() const NOEXCEPT;
+
+    /// Oldest sequence that may remain readable.
+    uint64_t tail() const NOEXCEPT;
+
+    /// Read the record of sequence in place.
+    status read(record& out, uint64_t sequence) const NOEXCEPT;
+
+    /// The record read was not overwritten during its use.
+    bool intact(const record& record) const NOEXCEPT;
+
+private:
+    typedef std::atomic<uint64_t> word;
+    static_assert(word::is_always_lock_free);
+
+    struct header
+    {
+        word identity;
+        word slots;
+        word arena;
+        word head;
+        word cursor;
+        word reserved[3];
+    };
+
+    struct slot
+    {
+        word sequence;
+        word position;
+        word channel;
+        word size;
+        word id;
+        word version;
+        word reserved[2];
+    };
+
+    static_assert(sizeof(header) == 64u);
+    static_assert(sizeof(slot) == 64u);
+
+    bool map(int descriptor, size_t size, bool writable) NOEXCEPT;
+    slot& at(uint64_t sequence) const NOEXCEPT;
+    uint8_t* arena() const NOEXCEPT;
+
+    // These are thread safe (const after construction).
+    const std::string name_;
+    const bool producer_;
+    header* header_{};
+    size_t size_{};
+    size_t mask_{};
+    size_t arena_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_FETCHER_HPP
+#define LIBBITCOIN_NETWORK_NET_FETCHER_HPP
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Schedules get_data requests of queued inventory across channels. Each
+/// channel is granted a window of in-flight items, sized to its measured
+/// delivery rate and round trip (bandwidth-delay product) within the maximum.
+/// Items stalled or not found on a channel, or in flight on a released
+/// channel, are requeued ahead of others, excluding the channels on which
+/// they failed (until all known channels have failed).
+class BCT_API fetcher final
+{
+public:
+    DELETE_COPY_MOVE(fetcher);
+
+    /// Window is the maximum in-flight items per channel (minimum one).
+    fetcher(size_t window, const steady_clock::duration& stall) NOEXCEPT;
+
+    /// Queue items for fetch, those already queued or in flight are ignored.
+    void enqueue(const messages::inventory_items& items) NOEXCEPT;
+
+    /// Take items to request of the channel, up to its available window.
+    messages::inventory_items request(uint64_t channel) NOEXCEPT;
+
+    /// Record receipt of the item, false if not in flight on the channel.
+    bool received(uint64_t channel, const system::hash_digest& hash) NOEXCEPT;
+
+    /// Requeue the item (not found), false if not in flight on the channel.
+    bool not_found(uint64_t channel, const system::hash_digest& hash) NOEXCEPT;
+
+    /// Requeue items in flight on the channel longer than the stall, count.
+    size_t expire(uint64_t channel) NOEXCEPT;
+
+    /// Requeue all items in flight on the channel and forget the channel.
+    void release(uint64_t channel) NOEXCEPT;
+
+    /// Properties.
+    /// -----------------------------------------------------------------------
+
+    /// The current window of the channel (maximum if unmeasured).
+    size_t window(uint64_t channel) const NOEXCEPT;
+
+    /// The smoothed round trip of the channel, zero if unmeasured.
+    steady_clock::duration round_trip(uint64_t channel) const NOEXCEPT;
+
+    /// The number of items awaiting request.
+    size_t queued() const NOEXCEPT;
+
+    /// The number of items requested and not yet received.
+    size_t in_flight() const NOEXCEPT;
+
+private:
+    typedef std::vector<uint64_t> channels;
+
+    struct pending
+    {
+        messages::inventory_item item;
+        channels excluded;
+    };
+
+    struct flight
+    {
+        messages::inventory_item item;
+        channels excluded;
+        uint64_t channel;
+        steady_clock::time_point sent;
+    };
+
+    // Round trips are microseconds and rate is items per second.
+    struct peer
+    {
+        size_t in_flight{};
+        uint64_t round_trip{};
+        uint64_t minimum{};
+        uint64_t rate{};
+        steady_clock::time_point last{};
+    };
+
+    typedef std::list<pending> queue;
+    typedef std::map<system::hash_digest, flight> flights;
+
+    // These require the mutex to be held.
+    size_t window(const peer& value) const NOEXCEPT;
+    void requeue(flights::iterator it, bool failed) NOEXCEPT;
+
+    // These are thread safe (const).
+    const size_t window_;
+    const steady_clock::duration stall_;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_{};
+    queue queue_{};
+    std::set<system::hash_digest> queued_{};
+    flights flights_{};
+    std::map<uint64_t, peer> peers_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
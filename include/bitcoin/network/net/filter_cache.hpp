@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_FILTER_CACHE_HPP
+#define LIBBITCOIN_NETWORK_NET_FILTER_CACHE_HPP
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Least recently used cache of BIP157 filter hashes and filter headers, keyed
+/// by filter type and block hash, and of filter checkpoints, keyed by filter
+/// type and stop hash. Shared by all channels so that the range queries of
+/// light clients, which concentrate near the chain top, are served from memory.
+/// Entries are immutable for a given block hash, so none are invalidated.
+class BCT_API filter_cache final
+{
+public:
+    DELETE_COPY_MOVE(filter_cache);
+
+    struct header
+    {
+        system::hash_digest filter_hash;
+        system::hash_digest filter_header;
+    };
+
+    /// Capacity is the number of filter headers, checkpoints are bounded to
+    /// one for each checkpoint interval of headers (minimum one).
+    filter_cache(size_t capacity) NOEXCEPT;
+
+    /// Obtain the cached filter header of the block, false if not cached.
+    bool find(header& out, uint8_t type,
+        const system::hash_digest& block) NOEXCEPT;
+
+    /// Cache the filter header of the block, evicting the least recent.
+    void store(uint8_t type, const system::hash_digest& block,
+        const header& value) NOEXCEPT;
+
+    /// Obtain the cached checkpoint for the stop hash, nullptr if not cached.
+    messages::client_filter_checkpoint::cptr find(uint8_t type,
+        const system::hash_digest& stop) NOEXCEPT;
+
+    /// Cache the checkpoint (keyed by its type and stop hash).
+    void store(
+        const messages::client_filter_checkpoint::cptr& checkpoint) NOEXCEPT;
+
+    /// The number of cached filter headers.
+    size_t size() const NOEXCEPT;
+
+    /// The number of cached checkpoints.
+    size_t checkpoints() const NOEXCEPT;
+
+private:
+    typedef std::pair<uint8_t, system::hash_digest> key;
+    typedef std::list<std::pair<key, header>> headers;
+    typedef std::list<std::pair<key,
+        messages::client_filter_checkpoint::cptr>> checkpoint_list;
+
+    // These are thread safe (const).
+    const size_t header_capacity_;
+    const size_t checkpoint_capacity_;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_;
+    headers headers_{};
+    std::map<key, headers::iterator> header_index_{};
+    checkpoint_list checkpoints_{};
+    std::map<key, checkpoint_list::iterator> checkpoint_index_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_FILTER_MATCHER_HPP
+#define LIBBITCOIN_NETWORK_NET_FILTER_MATCHER_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe (immutable), non-virtual.
+/// BIP158 basic filter matcher of a watch list (such as output scripts). A
+/// filter is its item count (compact size) followed by the Golomb-Rice coded
+/// (P = 19) deltas of its sorted items, each hashed by SipHash (keyed by the
+/// block hash) and mapped to [0, count * 784931). Watched items are hashed in
+/// size-batched lanes and mapped in the same way for each filter, sorted, and
+/// merge joined against the set as it is decoded (a word of bits at a time),
+/// ending at the first match. There is no shared state, so filters may be
+/// matched concurrently, such as in batches on the compute pool.
+class BCT_API filter_matcher final
+{
+public:
+    typedef std::vector<messages::client_filter::cptr> filters;
+
+    /// BIP158 basic filter type and parameters.
+    static constexpr uint8_t basic = 0;
+    static constexpr size_t golomb_bits = 19;
+    static constexpr uint64_t golomb_range = 784'931;
+
+    /// BIP158 SipHash key, the first 16 bytes of the block hash.
+    static messages::siphash_key to_key(
+        const system::hash_digest& block_hash) NOEXCEPT;
+
+    /// Map a hash uniformly onto [0, range), the high word of the product.
+    static uint64_t to_range(uint64_t hash, uint64_t range) NOEXCEPT;
+
+    /// Construct from the items to watch.
+    filter_matcher(const system::data_stack& items) NOEXCEPT;
+
+    /// The number of watched items.
+    size_t size() const NOEXCEPT;
+
+    /// True if any watched item is in the block filter (a false positive has
+    /// probability of about 1/784931 per item). Invalid filters and those of
+    /// other than basic type match, so that no block is missed.
+    bool match(const system::hash_digest& block_hash,
+        const system::data_slice& filter) const NOEXCEPT;
+    bool match(const messages::client_filter& filter) const NOEXCEPT;
+
+    /// The indexes of the filters that match, in order.
+    std::vector<size_t> match(const filters& filters) const NOEXCEPT;
+
+private:
+    const system::data_stack items_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_HANDOFF_HPP
+#define LIBBITCOIN_NETWORK_NET_HANDOFF_HPP
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe (offer and stop require strand), non-virtual.
+/// Restart without closing listeners. A starting process takes the listening
+/// sockets offered at a Unix domain socket path by the running process, which
+/// passes them as descriptors (SCM_RIGHTS) and then stops accepting, so that
+/// connection attempts during restart are queued by the kernel and accepted
+/// by the new process. The socket is owner only (0600) within a private
+/// directory (0700, created if missing), and descriptors pass only between
+/// processes of the same user. Not supported on Windows (not_allowed).
+class BCT_API handoff final
+  : public std::enable_shared_from_this<handoff>
+{
+public:
+    typedef std::shared_ptr<handoff> ptr;
+    typedef asio::acceptor::native_handle_type descriptor;
+    typedef std::vector<descriptor> descriptors;
+
+    struct listener
+    {
+        asio::endpoint local;
+        descriptor handle;
+    };
+
+    typedef std::vector<listener> listeners;
+
+    /// Bound on the number of listeners passed.
+    static constexpr size_t maximum_listeners = 64;
+
+    /// Obtain the listeners offered at the path, with their bound endpoints
+    /// (blocking, bounded by timeout). Caller owns the descriptors.
+    static code take(listeners& out, const std::filesystem::path& path,
+        const steady_clock::duration& timeout) NOEXCEPT;
+
+    /// Close the descriptors of listeners not adopted.
+    static void release(const listeners& listeners) NOEXCEPT;
+
+    DELETE_COPY_MOVE(handoff);
+
+    handoff(asio::strand& strand) NOEXCEPT;
+
+    /// Offer the listeners at the path (replacing a prior socket of this user),
+    /// handler is invoked once with success when they have been taken.
+    /// Returns invalid_configuration if the directory of the path is not
+    /// private or the path is occupied by other than such a socket.
+    code offer(const std::filesystem::path& path, descriptors&& handles,
+        result_handler&& handler) NOEXCEPT;
+
+    /// Cancel the offer (idempotent), the path is retained.
+    void stop() NOEXCEPT;
+
+private:
+    void do_accept() NOEXCEPT;
+
+    // These are protected by strand.
+    asio::strand& strand_;
+    descriptors handles_{};
+    result_handler handler_{};
+
+#if !defined(HAVE_MSC)
+    boost::asio::local::stream_protocol::acceptor acceptor_;
+#endif
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
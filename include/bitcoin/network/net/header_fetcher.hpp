@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_HEADER_FETCHER_HPP
+#define LIBBITCOIN_NETWORK_NET_HEADER_FETCHER_HPP
+
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Schedules disjoint header ranges across channels for parallel sync. Ranges
+/// are bounded by checkpoints (the first is the start), followed by an open
+/// range above the last checkpoint, which completes upon a partial headers
+/// message (the peer's top). Each received message must extend its range
+/// continuously and a closed range must end on its checkpoint. Headers are
+/// stitched to the sink in height order as they become contiguous.
+class BCT_API header_fetcher final
+{
+public:
+    DELETE_COPY_MOVE(header_fetcher);
+
+    /// Stitched headers interface, implemented by the node.
+    class BCT_API sink
+    {
+    public:
+        virtual ~sink() NOEXCEPT = default;
+
+        /// Accept contiguous headers, the first at the given height. Invoked
+        /// in height order under the fetcher lock (must not call fetcher).
+        virtual void accept(size_t height,
+            const system::chain::header_cptrs& headers) NOEXCEPT = 0;
+    };
+
+    /// A get_headers request, stop is null for the open range.
+    struct range
+    {
+        system::hash_digest start{};
+        system::hash_digest stop{};
+    };
+
+    /// Checkpoints must be ascending by height, and not empty.
+    header_fetcher(const system::chain::checkpoints& checkpoints,
+        sink& headers) NOEXCEPT;
+
+    /// The range of the channel, continued or newly assigned, false if none.
+    bool request(uint64_t channel, range& out) NOEXCEPT;
+
+    /// Accept headers (and their hashes) extending the range of the channel.
+    /// Returns error::protocol_violation if discontinuous or not ending on
+    /// the checkpoint of the range (which is then released, unchanged).
+    code received(uint64_t channel,
+        const system::chain::header_cptrs& headers,
+        const system::hashes& hashes) NOEXCEPT;
+
+    /// Release the range of the channel (retaining its progress).
+    void release(uint64_t channel) NOEXCEPT;
+
+    /// Properties.
+    /// -----------------------------------------------------------------------
+
+    /// The number of ranges not yet complete.
+    size_t remaining() const NOEXCEPT;
+
+    /// All ranges are complete and stitched.
+    bool complete() const NOEXCEPT;
+
+private:
+    struct segment
+    {
+        system::hash_digest stop{};
+        system::hash_digest tip{};
+        size_t stop_height{};
+        size_t top{};
+        system::chain::header_cptrs headers{};
+        uint64_t channel{};
+        bool assigned{};
+        bool complete{};
+    };
+
+    // These require the mutex to be held.
+    segment* find(uint64_t channel) NOEXCEPT;
+    void stitch() NOEXCEPT;
+
+    // This is thread safe.
+    sink& sink_;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_{};
+    std::vector<segment> segments_{};
+    size_t stitched_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
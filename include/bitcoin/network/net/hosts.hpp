@@ -20,17 +20,25 @@
 #define LIBBITCOIN_NETWORK_NET_HOSTS_HPP
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/asmap.hpp>
+#include <bitcoin/network/net/wire_cache.hpp>
 #include <bitcoin/network/settings.hpp>
 
 namespace libbitcoin {
@@ -41,11 +49,28 @@ namespace network {
 typedef std::function<void(const code&, const address_cptr&)> address_handler;
 typedef std::function<void(const code&, const address_item_cptr&)>
     address_item_handler;
+typedef std::function<void(const code&, const address_cptr&,
+    const wire_cache::ptr&)> fetch_handler;
 
-/// Virtual, thread safe (except start/stop).
+/// Virtual, not thread safe (except reservations and counts), callers
+/// serialize usage on a strand independent of the network strand.
+/// Reservations are guarded by mutexes sharded by address, as they are made
+/// from channel strands (admission), concurrent with usage and each other.
 /// Duplicate and invalid addresses are disacarded.
+/// Addresses are "new" (untried) until restored after a successful connect,
+/// at which point they are "tried" and bucketed by network group (the ASN
+/// of the optional asmap, otherwise the address prefix). Take
+/// alternates between tables, with tried hosts selected from a random group
+/// by lowest connect latency.
 /// The file is loaded and saved from/to the settings-specified path.
-/// The file is a line-oriented textual serialization (config::authority+).
+/// The file is a versioned binary serialization of fixed size wire records.
+/// A line-oriented textual serialization (config::address) is also loaded.
+/// Loaded addresses are filtered upon take, not upon load.
+/// Each table is indexed by advertised services, so that take may require
+/// services beyond services_minimum without connecting to discover them.
+/// Checkpoints append changes to a journal, replayed and removed on restart.
+/// Sweeps expire hosts by timestamp in bounded slices, and hosts that reach
+/// the failure limit upon restore are dropped.
 class BCT_API hosts
   : public reporter
 {
@@ -55,6 +80,10 @@ public:
     /// Construct an instance.
     hosts(const settings& settings, const logger& log) NOEXCEPT;
 
+    /// Read settings from the snapshot upon next use (thread safe).
+    /// The replaced snapshot is released once no longer in use.
+    void reload(const settings::cptr& snapshot) NOEXCEPT;
+
     /// Start/stop.
     /// -----------------------------------------------------------------------
 
@@ -64,35 +93,73 @@ public:
     /// Save addresses to file.
     virtual code stop() NOEXCEPT;
 
+    /// Write changes since last checkpoint to the journal, or compact the
+    /// journal into the file once larger than the pool. Writes are performed
+    /// on a dedicated low priority thread, on which handler is invoked.
+    virtual void checkpoint(result_handler&& handler) NOEXCEPT;
+
+    /// Drop expired (and excluded loaded) hosts from a slice of the new table
+    /// and expired hosts from one random group of the tried table. Live new
+    /// hosts of the slice rotate to the back, handler passes count dropped.
+    virtual void sweep(count_handler&& handler) NOEXCEPT;
+
     /// Properties.
     /// -----------------------------------------------------------------------
 
-    /// Count of pooled addresses.
+    /// Count of pooled addresses (new and tried).
     virtual size_t count() const NOEXCEPT;
 
+    /// Count of pooled addresses that have connected successfully.
+    virtual size_t tried() const NOEXCEPT;
+
     /// Count of reserved (currently connected) addresses.
     virtual size_t reserved() const NOEXCEPT;
 
+    /// Network group of the address, thread safe once started.
+    virtual uint64_t group(const messages::ip_address& ip) const NOEXCEPT;
+
     /// Usage.
     /// -----------------------------------------------------------------------
 
     /// Take one random address from the table (non-const).
     virtual void take(address_item_handler&& handler) NOEXCEPT;
 
+    /// Take one random address that advertises all of the given services.
+    /// Addresses that do not advertise the services remain in the table.
+    virtual void take(uint64_t services,
+        address_item_handler&& handler) NOEXCEPT;
+
+    /// Take the oldest new (untried) address, for a test (feeler) connection.
+    virtual void take_new(address_item_handler&& handler) NOEXCEPT;
+
     /// Store the address in the table (after use).
     virtual void restore(const address_item_cptr& host,
         result_handler&& handler) NOEXCEPT;
 
+    /// Store the address in the table (after connect attempt).
+    /// Success implies successful connect, which places the host into the
+    /// tried table with the given connect latency.
+    virtual void restore(const address_item_cptr& host, const code& ec,
+        const steady_clock::duration& latency,
+        result_handler&& handler) NOEXCEPT;
+
     /// Negotiation.
     /// -----------------------------------------------------------------------
 
-    /// Obtain a random set of addresses (for relay to peer).
-    virtual void fetch(address_handler&& handler) const NOEXCEPT;
+    /// Obtain a random set of addresses (for relay to peer), with its shared
+    /// wire encoding. Sets are handed out round robin from a rotation of
+    /// address_snapshots, reselected once per address_refresh or once a
+    /// quarter of the pool has been replaced since selection.
+    virtual void fetch(fetch_handler&& handler) const NOEXCEPT;
 
     /// Save random subset of addresses (from peer), count of accept.
     virtual void save(const address_cptr& message,
         count_handler&& handler) NOEXCEPT;
 
+    /// Save random subset of addresses (from peer), those accepted (new).
+    virtual void ingest(const address_cptr& message,
+        address_handler&& handler) NOEXCEPT;
+
     /// Reservation.
     /// -----------------------------------------------------------------------
 
@@ -103,44 +170,190 @@ public:
     virtual bool unreserve(const config::authority& host) NOEXCEPT;
 
 private:
-    typedef boost::circular_buffer<messages::address_item> buffer;
+    // Compact host, IPv4 inline and IPv6 by slot of a side table, so that a
+    // large pool is contiguous. Services above bit 31 are not retained (none
+    // are defined). The score of a tried host is its connect latency in
+    // milliseconds (saturating).
+    struct record
+    {
+        uint32_t timestamp;
+        uint32_t services;
+        uint32_t address;
+        uint16_t port;
+        uint16_t score;
+        bool ipv6;
+    };
+    static_assert(sizeof(record) < 24u);
+
+    typedef boost::circular_buffer<record> buffer;
+
+    // Maps each pooled host to its push sequence. The buffer is only pushed
+    // back and popped front, so its sequences are contiguous from the front.
+    // Tried hosts are indexed with the tried sentinel, as they are unbuffered.
+    typedef std::unordered_map<messages::address_key, size_t> index;
+    static constexpr size_t tried_sequence = max_size_t;
+
+    // Tried hosts are bucketed by network group, scored by connect latency.
+    typedef std::vector<record> records;
+    typedef std::unordered_map<uint64_t, records> buckets;
+
+    // Counts pooled hosts of each table by advertised services.
+    typedef std::unordered_map<uint64_t, size_t> service_counts;
 
-    // Equality ignores timestamp and services.
+    // O(1).
+    static inline void index_services(service_counts& table,
+        uint64_t services, bool add) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        if (add)
+        {
+            ++table[services];
+            return;
+        }
+
+        const auto it = table.find(services);
+        if (it != table.end() && is_zero(--it->second))
+            table.erase(it);
+        BC_POP_WARNING()
+    }
+
+    // O(S), for S distinct advertised service sets in the table.
+    static inline bool is_serviced(const service_counts& table,
+        uint64_t services) NOEXCEPT
+    {
+        return std::any_of(table.begin(), table.end(),
+            [=](const auto& entry) NOEXCEPT
+            {
+                return (entry.first & services) == services;
+            });
+    }
+
+    // O(1), equality ignores timestamp and services.
     inline buffer::iterator find(const messages::address_item& host) NOEXCEPT
     {
         BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-        return std::find(buffer_.begin(), buffer_.end(), host);
+        const auto it = index_.find(messages::to_key(host));
+        if (it == index_.end() || it->second == tried_sequence)
+            return buffer_.end();
+
+        const auto front = pushed_ - buffer_.size();
+        return std::next(buffer_.begin(), it->second - front);
         BC_POP_WARNING()
     }
 
-    // Equality ignores timestamp and services.
+    // O(1), equality ignores timestamp and services.
     inline bool is_pooled(const messages::address_item& host) NOEXCEPT
     {
         BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-        return find(host) != buffer_.end();
+        return index_.contains(messages::to_key(host));
         BC_POP_WARNING()
     }
 
+    inline messages::address_items snapshot() const NOEXCEPT;
+    inline address_cptr select() const NOEXCEPT;
+    inline bool churned() const NOEXCEPT;
+    inline void reselect(const steady_clock::time_point& now) const NOEXCEPT;
+    inline size_t pooled() const NOEXCEPT;
+    inline size_t tried_limit() const NOEXCEPT;
     inline messages::address_item::cptr pop() NOEXCEPT;
+    inline messages::address_item::cptr pop_tried() NOEXCEPT;
+    inline messages::address_item::cptr pop_tried(uint64_t services) NOEXCEPT;
+    inline messages::address_item::cptr pop_tried(buckets::iterator bucket,
+        records::iterator best) NOEXCEPT;
+    inline void update(buffer::iterator it,
+        const messages::address_item& host) NOEXCEPT;
+    inline void rotate(const messages::address_item& host) NOEXCEPT;
+    inline bool is_failed(const messages::address_item& host,
+        const code& ec) NOEXCEPT;
+    inline void push_tried(const messages::address_item& host,
+        uint16_t latency) NOEXCEPT;
     inline void push(const std::string& line) NOEXCEPT;
-    inline bool is_reserved(const config::authority& host) const NOEXCEPT;
+    inline void push(const messages::address_item& host) NOEXCEPT;
+    inline void push_back(const messages::address_item& host) NOEXCEPT;
+    inline void dirty(const messages::address_item& host) NOEXCEPT;
+    inline void clear() NOEXCEPT;
+    inline record encode(const messages::address_item& host,
+        uint16_t score=0) NOEXCEPT;
+    inline messages::address_item decode(const record& host) const NOEXCEPT;
+    inline messages::address_key key(const record& host) const NOEXCEPT;
+    inline void release(const record& host) NOEXCEPT;
+
+    template <typename Items>
+    static bool write_records(std::ostream& file, const Items& items) NOEXCEPT;
+    template <typename Items>
+    code save_file(const std::filesystem::path& path,
+        const Items& items) NOEXCEPT;
+
+    std::filesystem::path journal() const NOEXCEPT;
+    code load_file() NOEXCEPT;
+    code replay_journal() NOEXCEPT;
+    void drain() NOEXCEPT;
+
+    void do_compact(const messages::address_items_ptr& items,
+        const result_handler& handler) NOEXCEPT;
+    void do_journal(const messages::address_items_ptr& items,
+        const result_handler& handler) NOEXCEPT;
+    inline bool is_reserved(const messages::address_item& host) const NOEXCEPT;
 
     void do_take(const address_item_handler& handler) NOEXCEPT;
     void do_restore(const address_item_cptr& host,
         const result_handler& handler) NOEXCEPT;
-    void do_fetch(const address_handler& handler) const NOEXCEPT;
+    void do_fetch(const fetch_handler& handler) const NOEXCEPT;
     void do_save(const address_cptr& message,
         const count_handler& handler) NOEXCEPT;
 
+    settings::cptr current() const NOEXCEPT;
+
     // These are thread safe.
-    const settings& settings_;
+    mutable std::mutex settings_mutex_{};
+    settings::cptr settings_;
+    asmap asmap_{};
     std::atomic<size_t> hosts_count_{};
     std::atomic<size_t> authorities_count_{};
+    std::atomic<size_t> tried_count_{};
 
     // These are not thread safe.
     buffer buffer_;
+    index index_{};
+    size_t pushed_{};
+    size_t loaded_{};
+    size_t journaled_{};
+    bool alternate_{};
+    buckets tried_{};
+    service_counts new_services_{};
+    service_counts tried_services_{};
+    std::unordered_map<messages::address_key, size_t> failures_{};
+    std::vector<messages::ip_address> ipv6_{};
+    std::vector<uint32_t> ipv6_free_{};
+    messages::address_items dirty_{};
     bool stopped_{ true };
-    std::unordered_set<config::authority> authorities_{};
+
+    // Fetch selections and their shared encodings.
+    struct selection
+    {
+        address_cptr message;
+        wire_cache::ptr cache;
+    };
+
+    // These are not thread safe.
+    mutable std::vector<selection> fetched_{};
+    mutable size_t fetched_next_{};
+    mutable size_t fetched_pushed_{};
+    mutable steady_clock::time_point fetched_time_{};
+
+    // These are protected by their mutex.
+    struct reservations
+    {
+        std::unordered_set<messages::address_key> authorities{};
+        mutable std::shared_mutex mutex{};
+    };
+
+    static constexpr size_t reservation_shards = 16;
+    reservations& shard(const messages::address_key& key) const NOEXCEPT;
+    mutable std::array<reservations, reservation_shards> reservations_{};
+
+    // This is thread safe.
+    threadpool checkpointer_{ one, thread_priority::low };
 };
 
 } // namespace network
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_LZ4_HPP
+#define LIBBITCOIN_NETWORK_NET_LZ4_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// LZ4 block format codec (greedy single-probe matching), with an optional
+/// dictionary that precedes the data within the match window. The block
+/// does not carry its decompressed size, so the caller frames it.
+class BCT_API lz4 final
+{
+public:
+    /// Maximum match distance (offsets are two bytes).
+    static constexpr size_t window = 65'535;
+
+    /// Compress data, matching within the preceding dictionary and data.
+    static system::data_chunk compress(const system::data_slice& data,
+        const system::data_slice& dictionary={}) NOEXCEPT;
+
+    /// Decompress a block into out, which must be sized to the exact
+    /// decompressed size. False if the block is invalid for the size.
+    static bool decompress(const system::data_slab& out,
+        const system::data_slice& block,
+        const system::data_slice& dictionary={}) NOEXCEPT;
+
+    /// Fixed dictionary of common transaction byte sequences (shared by all
+    /// nodes, so it requires no exchange).
+    static const system::data_chunk& transaction_dictionary() NOEXCEPT;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
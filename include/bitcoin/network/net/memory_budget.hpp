@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_MEMORY_BUDGET_HPP
+#define LIBBITCOIN_NETWORK_NET_MEMORY_BUDGET_HPP
+
+#include <atomic>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Accounting of bytes held by the channels of a network (payload buffers,
+/// including those pending deserialization, and write queue backlogs),
+/// against a limit. Pressure applies above the high water mark (7/8 of the
+/// limit), under which new inbound channels are refused, buffers are not
+/// retained and channels holding more than a fair share pause reads.
+/// A zero limit disables pressure (accounting continues).
+class BCT_API memory_budget final
+{
+public:
+    typedef std::shared_ptr<memory_budget> ptr;
+
+    DELETE_COPY_MOVE(memory_budget);
+
+    memory_budget(size_t limit) NOEXCEPT;
+
+    /// Account bytes held or released by a channel.
+    void acquire(size_t bytes) NOEXCEPT;
+    void release(size_t bytes) NOEXCEPT;
+
+    /// Account a channel to the fair share.
+    void attach() NOEXCEPT;
+    void detach() NOEXCEPT;
+
+    /// Properties.
+    size_t limit() const NOEXCEPT;
+    size_t used() const NOEXCEPT;
+    size_t channels() const NOEXCEPT;
+
+    /// Used bytes are above the high water mark.
+    bool pressured() const NOEXCEPT;
+
+    /// Under pressure and the channel holds more than a fair share.
+    bool heavy(size_t held) const NOEXCEPT;
+
+private:
+    // These are thread safe.
+    const size_t limit_;
+    const size_t high_;
+    std::atomic<size_t> used_{};
+    std::atomic<size_t> channels_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_MESSAGE_EXPORTER_HPP
+#define LIBBITCOIN_NETWORK_NET_MESSAGE_EXPORTER_HPP
+
+#include <atomic>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/export_ring.hpp>
+#include <bitcoin/network/net/seen_filter.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Export of received payloads to a shared memory export_ring, shared by the
+/// channels of a network. Channels submit the payload (shared, not copied)
+/// and the exporter thread, as the single producer of the ring, drops any
+/// payload of a hash recently exported and writes the others. Submissions
+/// beyond a backlog of the ring capacity are dropped, so a slow exporter
+/// never holds a channel.
+class BCT_API message_exporter final
+{
+public:
+    DELETE_COPY_MOVE(message_exporter);
+
+    /// Payload hashes retained for deduplication.
+    static constexpr size_t deduplication = 100'000;
+
+    /// Construct an exporter of the named ring of arena bytes (empty name
+    /// disables), on its own thread.
+    message_exporter(const std::string& name, size_t arena) NOEXCEPT;
+
+    /// Stop and join the thread, pending payloads are not exported.
+    ~message_exporter() NOEXCEPT;
+
+    /// The ring was created.
+    bool enabled() const NOEXCEPT;
+
+    /// Queue the payload for export, hash is computed if null.
+    void submit(messages::identifier id, uint64_t channel, uint32_t version,
+        const system::chunk_ptr& payload,
+        const system::hash_cptr& hash) NOEXCEPT;
+
+    /// Payloads written to the ring.
+    size_t exported() const NOEXCEPT;
+
+    /// Payloads dropped as duplicates.
+    size_t duplicates() const NOEXCEPT;
+
+    /// Payloads dropped as over backlog or capacity.
+    size_t dropped() const NOEXCEPT;
+
+private:
+    void write(messages::identifier id, uint64_t channel, uint32_t version,
+        const system::chunk_ptr& payload,
+        const system::hash_cptr& hash) NOEXCEPT;
+
+    // This is protected by the exporter thread.
+    export_ring ring_;
+
+    // These are thread safe.
+    const bool enabled_;
+    seen_filter seen_{ deduplication };
+    std::atomic<size_t> backlog_{};
+    std::atomic<size_t> exported_{};
+    std::atomic<size_t> duplicates_{};
+    std::atomic<size_t> dropped_{};
+    threadpool pool_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_METRICS_HPP
+#define LIBBITCOIN_NETWORK_NET_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Traffic counters for capacity planning, recorded on hot paths as relaxed
+/// atomics (no locks or ordering). Messages and bytes are counted in and out
+/// by message identifier, along with socket read and write operations, the
+/// deepest write queue observed, off-strand deserialization time and message
+/// processing (deserialization, dispatch and handler) time. Each value of a
+/// snapshot is read independently, so totals may be skewed.
+class BCT_API metrics final
+{
+public:
+    static constexpr size_t identifiers = add1(static_cast<size_t>(
+        messages::identifier::request_sketch_extension));
+
+    struct counter
+    {
+        uint64_t messages;
+        uint64_t bytes;
+    };
+
+    typedef std::array<counter, identifiers> counters;
+
+    struct snapshot
+    {
+        counters received;
+        counters sent;
+        uint64_t reads;
+        uint64_t writes;
+        uint64_t queue_depth;
+        uint64_t deserializations;
+        uint64_t deserialize_nanoseconds;
+        uint64_t processing_nanoseconds;
+
+        /// Totals over all identifiers.
+        counter total_received() const NOEXCEPT;
+        counter total_sent() const NOEXCEPT;
+    };
+
+    DELETE_COPY_MOVE(metrics);
+
+    metrics() NOEXCEPT;
+
+    /// Record a message (including heading bytes).
+    void receive(messages::identifier id, size_t bytes) NOEXCEPT;
+    void send(messages::identifier id, size_t bytes) NOEXCEPT;
+
+    /// Record a socket operation.
+    void read() NOEXCEPT;
+    void write() NOEXCEPT;
+
+    /// Record a write queue depth, retaining the maximum.
+    void queue(size_t depth) NOEXCEPT;
+
+    /// Record an off-strand deserialization.
+    void deserialize(const nanoseconds& elapsed) NOEXCEPT;
+
+    /// Record message processing (on or off of the channel strand).
+    void process(const nanoseconds& elapsed) NOEXCEPT;
+
+    /// Read processing time alone (without a snapshot).
+    uint64_t processing() const NOEXCEPT;
+
+    /// Read all values.
+    snapshot get() const NOEXCEPT;
+
+private:
+    struct atomic_counter
+    {
+        std::atomic<uint64_t> messages{};
+        std::atomic<uint64_t> bytes{};
+    };
+
+    typedef std::array<atomic_counter, identifiers> atomic_counters;
+
+    static size_t to_index(messages::identifier id) NOEXCEPT;
+
+    // These are thread safe.
+    atomic_counters received_{};
+    atomic_counters sent_{};
+    std::atomic<uint64_t> reads_{};
+    std::atomic<uint64_t> writes_{};
+    std::atomic<uint64_t> queue_depth_{};
+    std::atomic<uint64_t> deserializations_{};
+    std::atomic<uint64_t> deserialize_nanoseconds_{};
+    std::atomic<uint64_t> processing_nanoseconds_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_NAME_RESOLVER_HPP
+#define LIBBITCOIN_NETWORK_NET_NAME_RESOLVER_HPP
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Host name resolution service shared by the connectors of a network.
+/// Lookups run in parallel on the resolver threads (the asio resolver of a
+/// service runs one blocking lookup at a time). Concurrent lookups of one
+/// name are coalesced, and results are cached for a positive (resolved) or
+/// negative (failed) duration. Each result is posted to the requesting strand.
+class BCT_API name_resolver final
+{
+public:
+    typedef steady_clock::duration duration;
+    typedef std::function<void(const error::boost_code&,
+        const asio::endpoints&)> handler;
+
+    DELETE_COPY_MOVE(name_resolver);
+
+    /// Names in excess of this are not cached (expired entries are purged).
+    static constexpr size_t cache_limit = 4'096;
+
+    /// Construct a resolver of the number of threads (minimum one).
+    /// A zero duration disables caching of the respective result.
+    name_resolver(size_t threads, const duration& positive,
+        const duration& negative) NOEXCEPT;
+
+    /// Stop and join threads, pending handlers are not invoked.
+    ~name_resolver() NOEXCEPT;
+
+    /// Resolve host:port, the handler is posted to strand with the result.
+    /// Returns a ticket for cancellation (zero if completed from cache).
+    size_t resolve(const std::string& host, uint16_t port,
+        asio::strand& strand, handler&& complete) NOEXCEPT;
+
+    /// Post the ticket's handler with operation_aborted, if still pending.
+    /// The lookup itself is not interrupted (its result is still cached).
+    void cancel(size_t ticket) NOEXCEPT;
+
+    /// The number of cached names (including unpurged expired names).
+    size_t cached() const NOEXCEPT;
+
+private:
+    struct waiter
+    {
+        size_t ticket;
+        asio::strand* strand;
+        handler complete;
+    };
+
+    struct entry
+    {
+        error::boost_code ec;
+        asio::endpoints endpoints;
+        steady_clock::time_point expiry;
+    };
+
+    typedef std::vector<waiter> waiters;
+
+    static std::string to_key(const std::string& host, uint16_t port) NOEXCEPT;
+    static void post(waiter&& item, const error::boost_code& ec,
+        const asio::endpoints& endpoints) NOEXCEPT;
+
+    void lookup(const std::string& key, const std::string& host,
+        uint16_t port) NOEXCEPT;
+    void store(const std::string& key, const error::boost_code& ec,
+        const asio::endpoints& endpoints) NOEXCEPT;
+
+    // These are thread safe.
+    const duration positive_;
+    const duration negative_;
+    threadpool pool_;
+
+    // These are protected by mutex.
+    std::unordered_map<std::string, entry> cache_{};
+    std::unordered_map<std::string, waiters> pending_{};
+    size_t ticket_{};
+    bool stopped_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -20,16 +20,57 @@
 #define LIBBITCOIN_NETWORK_NET_NET_HPP
 
 #include <bitcoin/network/net/acceptor.hpp>
+#include <bitcoin/network/net/anchors.hpp>
+#include <bitcoin/network/net/asmap.hpp>
+#include <bitcoin/network/net/bans.hpp>
+#include <bitcoin/network/net/block_stream.hpp>
+#include <bitcoin/network/net/blocklist.hpp>
+#include <bitcoin/network/net/bloom_filter.hpp>
 #include <bitcoin/network/net/broadcaster.hpp>
+#include <bitcoin/network/net/capture.hpp>
 #include <bitcoin/network/net/channel.hpp>
+#include <bitcoin/network/net/checksum_batcher.hpp>
 #include <bitcoin/network/net/connector.hpp>
 #include <bitcoin/network/net/deadline.hpp>
 #include <bitcoin/network/net/distributor.hpp>
+#include <bitcoin/network/net/eviction.hpp>
+#include <bitcoin/network/net/export_ring.hpp>
+#include <bitcoin/network/net/fetcher.hpp>
+#include <bitcoin/network/net/filter_cache.hpp>
+#include <bitcoin/network/net/filter_matcher.hpp>
+#include <bitcoin/network/net/handoff.hpp>
+#include <bitcoin/network/net/header_fetcher.hpp>
 #include <bitcoin/network/net/hosts.hpp>
+#include <bitcoin/network/net/lz4.hpp>
+#include <bitcoin/network/net/memory_budget.hpp>
+#include <bitcoin/network/net/message_exporter.hpp>
+#include <bitcoin/network/net/metrics.hpp>
+#include <bitcoin/network/net/name_resolver.hpp>
+#include <bitcoin/network/net/nonces.hpp>
+#include <bitcoin/network/net/payload_hash.hpp>
+#include <bitcoin/network/net/payload_pool.hpp>
+#include <bitcoin/network/net/pin_sketch.hpp>
+#include <bitcoin/network/net/pipe.hpp>
 #include <bitcoin/network/net/proxy.hpp>
+#include <bitcoin/network/net/recycler.hpp>
+#include <bitcoin/network/net/replay.hpp>
+#include <bitcoin/network/net/resources.hpp>
+#include <bitcoin/network/net/rolling_filter.hpp>
+#include <bitcoin/network/net/seeds.hpp>
+#include <bitcoin/network/net/seen_filter.hpp>
+#include <bitcoin/network/net/serve_cache.hpp>
+#include <bitcoin/network/net/short_id_table.hpp>
 #include <bitcoin/network/net/socket.hpp>
+#include <bitcoin/network/net/timeout_estimator.hpp>
+#include <bitcoin/network/net/timer_wheel.hpp>
+#include <bitcoin/network/net/upload_budget.hpp>
+#include <bitcoin/network/net/version_template.hpp>
+#include <bitcoin/network/net/wire_cache.hpp>
 
-// The network classes are entirely lock free.
+// The network classes are entirely lock free, excluding payload_pool and
+// wire_cache, which are shared across channel strands and guarded by a mutex,
+// hosts reservations, which are made concurrently with hosts strand use, and
+// timer_wheel, which schedules channel timers from any strand.
 
 // Each acceptor, connector, and channel::socket(proxy) operates on an
 // independent strand within a shared threadpool owned by the caller.
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_NONCES_HPP
+#define LIBBITCOIN_NETWORK_NET_NONCES_HPP
+
+#include <atomic>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe (lock-free), non-virtual.
+/// Fixed capacity open addressing set of non-zero nonces, linearly probed.
+/// Erased slots are marked and reused by subsequent insertion, so the probe
+/// bound is the capacity. Insertion fails when full. Concurrent insertion of
+/// the same nonce is not deduplicated (channel nonces are unique). Zero and
+/// the maximum value are reserved and are never contained.
+class BCT_API nonces final
+{
+public:
+    DELETE_COPY_MOVE(nonces);
+
+    /// Capacity is rounded up to a power of two (minimum two).
+    nonces(size_t capacity) NOEXCEPT;
+
+    /// Insert the nonce, false if reserved, contained or full.
+    bool insert(uint64_t nonce) NOEXCEPT;
+
+    /// Erase the nonce, false if not contained.
+    bool erase(uint64_t nonce) NOEXCEPT;
+
+    /// True if the nonce is contained.
+    bool contains(uint64_t nonce) const NOEXCEPT;
+
+    /// The number of contained nonces.
+    size_t size() const NOEXCEPT;
+
+    /// The number of slots.
+    size_t capacity() const NOEXCEPT;
+
+private:
+    typedef std::atomic<uint64_t> slot;
+
+    static constexpr uint64_t empty = 0;
+    static constexpr uint64_t erased = max_uint64;
+
+    size_t first(uint64_t nonce) const NOEXCEPT;
+
+    // These are thread safe (const).
+    const size_t mask_;
+    const std::unique_ptr<slot[]> slots_;
+
+    // This is thread safe.
+    std::atomic<size_t> size_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
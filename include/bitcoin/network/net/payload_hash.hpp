@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_PAYLOAD_HASH_HPP
+#define LIBBITCOIN_NETWORK_NET_PAYLOAD_HASH_HPP
+
+#include <array>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Incremental payload hash (double sha256), fed with consecutive chunks of
+/// the payload as they are read, so that each chunk is hashed while in cache
+/// and the hash is available upon arrival of the final chunk.
+class BCT_API payload_hash final
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(payload_hash);
+
+    /// The payload hash (double sha256) of each payload, in order.
+    /// Payloads are hashed in groups of lanes, each group compressing one
+    /// block per lane per step (interleaved state, which the compiler may
+    /// vectorize), so payloads of similar size should be grouped together.
+    static system::hashes batch(
+        const std::vector<system::data_slice>& payloads) NOEXCEPT;
+
+    /// The number of payloads hashed concurrently by batch.
+    static constexpr size_t lanes = 8;
+
+    payload_hash() NOEXCEPT;
+
+    /// Hash the next chunk of the payload.
+    void write(const system::data_slice& data) NOEXCEPT;
+
+    /// The double sha256 of all chunks written, and reset.
+    system::hash_digest flush() NOEXCEPT;
+
+    /// The number of bytes written since reset.
+    uint64_t size() const NOEXCEPT;
+
+private:
+    static constexpr size_t block_size = 64;
+    typedef std::array<uint32_t, 8> state;
+    typedef std::array<uint8_t, block_size> block;
+
+    typedef std::array<std::array<uint32_t, lanes>, 8> lane_state;
+
+    static void compress(state& out, const uint8_t* data) NOEXCEPT;
+    static void compress(lane_state& out,
+        const std::array<const uint8_t*, lanes>& data,
+        size_t active) NOEXCEPT;
+    static void batch(system::hashes& out,
+        const std::vector<system::data_slice>& payloads) NOEXCEPT;
+    system::hash_digest finalize() NOEXCEPT;
+    void reset() NOEXCEPT;
+
+    // These are not thread safe.
+    state state_{};
+    block buffer_{};
+    uint64_t size_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
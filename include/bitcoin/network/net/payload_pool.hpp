@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_PAYLOAD_POOL_HPP
+#define LIBBITCOIN_NETWORK_NET_PAYLOAD_POOL_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Size-classed pool of payload buffers shared by all channels of a network.
+/// Buffers are leased for the duration of a message read and released once
+/// subscribers have been notified. Classes are powers of two, from 4KiB up to
+/// the configured maximum, each retaining up to capacity released buffers.
+/// Buffers larger than the maximum class are freed upon release.
+/// A pooled buffer reserves its full class, so a buffer retained by the pool
+/// or by a channel may hold up to twice (just under) its payload size.
+/// Optionally, pooled classes of at least 2MiB are advised for transparent
+/// huge pages, reducing page faults and TLB misses for block-sized payloads.
+/// Where huge pages are unavailable the buffers remain on base pages.
+class BCT_API payload_pool final
+{
+public:
+    typedef std::shared_ptr<payload_pool> ptr;
+
+    DELETE_COPY_MOVE(payload_pool);
+
+    /// Smallest size class (2^12 = 4KiB).
+    static constexpr size_t minimum_class = 12;
+
+    /// Smallest size class advised for huge pages (2^21 = 2MiB).
+    static constexpr size_t huge_class = 21;
+
+    /// Zero capacity disables retention (buffers are freed upon release).
+    payload_pool(size_t capacity, size_t maximum,
+        bool huge_pages=false) NOEXCEPT;
+
+    /// Obtain a buffer of exactly size bytes, reusing a retained buffer when
+    /// one exists in the size class. Returns nullptr on allocation failure.
+    system::chunk_ptr lease(size_t size) NOEXCEPT;
+
+    /// Return a leased buffer to its size class, ok if null.
+    void release(system::chunk_ptr&& buffer) NOEXCEPT;
+
+    /// The number of buffers currently retained by the pool.
+    size_t retained() const NOEXCEPT;
+
+    /// The size class (log2 of class capacity) of the given size.
+    static size_t size_class(size_t size) NOEXCEPT;
+
+private:
+    typedef std::vector<system::chunk_ptr> buffers;
+
+    static void advise_huge(uint8_t* data, size_t size) NOEXCEPT;
+
+    // These are thread safe (const).
+    const size_t capacity_;
+    const size_t classes_;
+    const bool huge_pages_;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_;
+    std::vector<buffers> pool_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_PIN_SKETCH_HPP
+#define LIBBITCOIN_NETWORK_NET_PIN_SKETCH_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe.
+/// PinSketch (BCH syndrome) set sketch of nonzero 32 bit elements, as used by
+/// BIP330 transaction reconciliation. A sketch of capacity c is the c odd
+/// power sums of its elements over GF(2^32) (x^32 + x^7 + x^3 + x^2 + 1), so
+/// adding an element twice removes it, and the merge (sum) of the sketches of
+/// two sets is the sketch of their symmetric difference, which is decodable
+/// if it has no more than c elements. A larger difference is detected with
+/// probability of about 1 - 1/c!, so callers allow a capacity margin.
+/// Serialized as 4 little-endian bytes per power sum, as is a 32 bit minisketch,
+/// so the serialization of doubled capacity extends that of the capacity.
+class BCT_API pin_sketch
+{
+public:
+    typedef uint32_t element;
+    typedef std::vector<element> elements;
+
+    /// The serialized size of a sketch of the given capacity.
+    static size_t serialized_size(size_t capacity) NOEXCEPT;
+
+    /// An empty sketch of the capacity (maximum decodable difference).
+    pin_sketch(size_t capacity) NOEXCEPT;
+
+    /// A sketch from its serialization, capacity is implied by size (a
+    /// partial trailing power sum is ignored).
+    pin_sketch(const system::data_slice& data) NOEXCEPT;
+
+    /// The maximum number of decodable elements.
+    size_t capacity() const NOEXCEPT;
+
+    /// Add (or remove, if present) an element, zero is ignored.
+    void add(element value) NOEXCEPT;
+
+    /// Combine with the sketch of another set, leaving the sketch of their
+    /// symmetric difference, truncated to the lesser capacity.
+    void merge(const pin_sketch& other) NOEXCEPT;
+
+    /// Decode the elements of the sketch, false if more than capacity.
+    bool decode(elements& out) const NOEXCEPT;
+
+    /// The serialized sketch.
+    system::data_chunk serialize() const NOEXCEPT;
+
+private:
+    // Odd power sums of the elements (s1, s3, s5, ...).
+    elements sums_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
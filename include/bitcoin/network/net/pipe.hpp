@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_PIPE_HPP
+#define LIBBITCOIN_NETWORK_NET_PIPE_HPP
+
+#include <memory>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/socket.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Virtual, thread safe (see socket).
+/// In-process socket, one end of a connected pair. Writes are copied to the
+/// peer's receive buffer on the peer's strand, and reads complete from that
+/// buffer, so proxy/channel/protocol code runs unchanged at memory speed
+/// without kernel sockets or ports. Stopping either end fails the pending
+/// and subsequent reads of the other with error::peer_disconnect (once its
+/// buffered bytes are consumed). Accept and connect succeed immediately.
+class BCT_API pipe final
+  : public socket
+{
+public:
+    typedef std::shared_ptr<pipe> ptr;
+    typedef std::pair<ptr, ptr> pair;
+
+    DELETE_COPY_MOVE(pipe);
+
+    /// Construct a connected pair (first is inbound, second is outbound).
+    static pair create(const logger& log, asio::io_context& service) NOEXCEPT;
+
+    /// Use create() to obtain a connected pair.
+    pipe(const logger& log, asio::io_context& service, bool inbound) NOEXCEPT;
+
+    /// Asserts/logs stopped.
+    ~pipe() NOEXCEPT override;
+
+    /// Stop, disconnecting the peer (idempotent, thread safe).
+    void stop() NOEXCEPT override;
+
+    /// The pipe is already connected, handler posted to socket strand.
+    void accept(asio::acceptor& acceptor,
+        result_handler&& handler) NOEXCEPT override;
+    void connect(const asio::endpoints& range,
+        result_handler&& handler) NOEXCEPT override;
+    void connect(const asio::endpoint& point, bool fast_open,
+        result_handler&& handler) NOEXCEPT override;
+
+    /// Read from the peer's writes, handler posted to socket strand.
+    void read(const system::data_slab& out,
+        count_handler&& handler) NOEXCEPT override;
+
+    /// Write (copied) to the peer, handler posted to socket strand.
+    void write(const system::data_slice& in,
+        count_handler&& handler) NOEXCEPT override;
+    void write(const asio::const_buffers& in,
+        count_handler&& handler) NOEXCEPT override;
+
+    /// The pipe is the inbound end of its pair.
+    bool inbound() const NOEXCEPT override;
+
+private:
+    ptr self() NOEXCEPT;
+    void do_stop() NOEXCEPT;
+    void do_read(const asio::mutable_buffer& out,
+        const count_handler& handler) NOEXCEPT;
+    void do_write(const system::chunk_ptr& data,
+        const count_handler& handler) NOEXCEPT;
+    void do_receive(const system::chunk_ptr& data) NOEXCEPT;
+    void do_disconnect() NOEXCEPT;
+    void fill() NOEXCEPT;
+    void complete(const code& ec) NOEXCEPT;
+
+    // This is thread safe (const).
+    const bool inbound_;
+
+    // This is set by create(), before use.
+    std::weak_ptr<pipe> peer_{};
+
+    // These are protected by strand.
+    system::data_chunk buffer_{};
+    size_t offset_{};
+    asio::mutable_buffer pending_{};
+    size_t filled_{};
+    count_handler reader_{};
+    bool disconnected_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -19,17 +19,32 @@
 #ifndef LIBBITCOIN_NETWORK_NET_PROXY_HPP
 #define LIBBITCOIN_NETWORK_NET_PROXY_HPP
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/block_stream.hpp>
+#include <bitcoin/network/net/capture.hpp>
+#include <bitcoin/network/net/checksum_batcher.hpp>
+#include <bitcoin/network/net/deadline.hpp>
 #include <bitcoin/network/net/distributor.hpp>
+#include <bitcoin/network/net/memory_budget.hpp>
+#include <bitcoin/network/net/message_exporter.hpp>
+#include <bitcoin/network/net/metrics.hpp>
+#include <bitcoin/network/net/payload_hash.hpp>
+#include <bitcoin/network/net/payload_pool.hpp>
+#include <bitcoin/network/net/serve_cache.hpp>
 #include <bitcoin/network/net/socket.hpp>
+#include <bitcoin/network/net/upload_budget.hpp>
+#include <bitcoin/network/net/version_template.hpp>
+#include <bitcoin/network/net/wire_cache.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -42,6 +57,39 @@ class BCT_API proxy
 public:
     typedef std::shared_ptr<proxy> ptr;
     typedef subscriber<> stop_subscriber;
+    typedef subscriber<bool> congestion_subscriber;
+
+    /// Estimated memory of a channel by component, in bytes. Inline sizes
+    /// and heap allocations held by the channel, excluding allocator overhead
+    /// and memory shared by channels (payload pool, caches, broadcaster).
+    struct footprint
+    {
+        /// The channel (or proxy) object, including inline members.
+        size_t object{};
+
+        /// The socket object.
+        size_t socket{};
+
+        /// Held payload, read-ahead and block stream buffers.
+        size_t buffers{};
+
+        /// Queued sends and their indexes.
+        size_t queues{};
+
+        /// Message (distributor), stop and congestion subscriptions.
+        size_t subscribers{};
+
+        /// Allocated timers.
+        size_t timers{};
+
+        /// Attached protocol objects.
+        size_t protocols{};
+
+        /// Announcement filter and queue.
+        size_t filters{};
+
+        size_t total() const NOEXCEPT;
+    };
 
     DELETE_COPY_MOVE(proxy);
 
@@ -54,7 +102,35 @@ public:
 
         // TODO: build witness into feature w/magic and negotiated version.
         // TODO: if self and peer services show witness, set feature true.
-        const auto data = messages::serialize(message, protocol_magic(),
+        // Pooled buffers are released to the payload pool upon write.
+        const auto data = pool_sends() ?
+            messages::serialize(message, protocol_magic(), version(), true,
+                [this](size_t size) NOEXCEPT { return pool_->lease(size); }) :
+            messages::serialize(message, protocol_magic(), version());
+
+        if (!data)
+        {
+            // This is an internal error, should never happen.
+            LOGF("Serialization failure (" << Message::command << ").");
+            complete(error::unknown);
+            return;
+        }
+
+        write(data, std::move(complete));
+    }
+
+    /// Write a message to the peer using a shared encoding (requires strand).
+    /// The cache is a wire_cache, serve_cache (for blocks and transactions) or
+    /// version_template (for version messages).
+    /// Completion handler is always invoked on the channel strand.
+    template <class Message, class Cache>
+    void send(const Message& message, Cache& cache,
+        result_handler&& complete) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+
+        // Serialized only if not cached for the magic and negotiated version.
+        const auto data = cache.serialize(message, protocol_magic(),
             version());
 
         if (!data)
@@ -68,6 +144,54 @@ public:
         write(data, std::move(complete));
     }
 
+    /// Write the cached encoding of a served block or transaction of the hash
+    /// to the peer (requires strand), false if not cached for the magic and
+    /// negotiated version (handler is not invoked). Upon a miss the caller
+    /// loads the message and sends it with the cache, which then caches it.
+    /// Completion handler is always invoked on the channel strand.
+    template <class Message>
+    bool send(const system::hash_digest& hash, serve_cache& cache,
+        result_handler&& complete) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+
+        const auto data = cache.find<Message>(hash, protocol_magic(),
+            version());
+
+        if (!data)
+            return false;
+
+        write(data, std::move(complete));
+        return true;
+    }
+
+    /// Send a message whose payload is a file region (requires strand), such
+    /// as a serialized block of a raw block store, given its payload checksum.
+    /// The heading is queued as bulk and the payload follows it from the file
+    /// (zero-copy). Completion handler is always invoked on the channel strand.
+    template <class Message>
+    void send(const socket::file_region& payload, uint32_t checksum,
+        result_handler&& complete) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+
+        const auto data = std::make_shared<system::data_chunk>(
+            messages::heading::size());
+
+        if (system::is_limited<uint32_t>(payload.size) ||
+            !messages::heading{ protocol_magic(), Message::command,
+                system::possible_narrow_cast<uint32_t>(payload.size),
+                checksum }.serialize(*data))
+        {
+            // This is an internal error, should never happen.
+            LOGF("Serialization failure (" << Message::command << ").");
+            complete(error::unknown);
+            return;
+        }
+
+        write(Message::id, data, payload, std::move(complete));
+    }
+
     /// Subscribe to messages from peer (requires strand).
     /// Event handler is always invoked on the channel strand.
     template <class Message, typename Handler = distributor::handler<Message>>
@@ -77,6 +201,17 @@ public:
         distributor_.subscribe(std::forward<Handler>(handler));
     }
 
+    /// Subscribe to messages from peer in the lane (requires strand).
+    /// The lane applies to the message type, for all of its subscribers.
+    /// Event handler is always invoked on the channel strand.
+    template <class Message, typename Handler = distributor::handler<Message>>
+    void subscribe(Handler&& handler, distributor::lane priority) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+        distributor_.prioritize<Message>(priority);
+        distributor_.subscribe(std::forward<Handler>(handler));
+    }
+
     /// Asserts/logs stopped.
     virtual ~proxy() NOEXCEPT;
 
@@ -89,6 +224,22 @@ public:
     /// Reading from the socket is paused (requires strand).
     virtual bool paused() const NOEXCEPT;
 
+    /// Grant read credit, enabling flow control upon first grant (thread safe).
+    /// Each non-control message read consumes one message and its bytes of
+    /// credit, and reads are held while either is exhausted. Reads held for
+    /// credit resume upon grant, so a slow consumer bounds the messages read
+    /// ahead of it without stopping the channel.
+    virtual void grant(size_t messages, size_t bytes) NOEXCEPT;
+
+    /// Reading from the socket is held for lack of credit (requires strand).
+    virtual bool starved() const NOEXCEPT;
+
+    /// Set compressed relay (requires strand). If send, bulk messages of at
+    /// least compression_minimum payload bytes are sent as compressed
+    /// envelopes. If receive, envelopes are expanded, otherwise (as unknown
+    /// messages) they are ignored.
+    virtual void set_compression(bool send, bool receive) NOEXCEPT;
+
     /// Idempotent, may be called multiple times.
     virtual void stop(const code& ec) NOEXCEPT;
 
@@ -106,12 +257,35 @@ public:
     /// The proxy (socket) is stopped.
     bool stopped() const NOEXCEPT;
 
+    /// Subscribe to send backlog high/low water mark crossings (requires
+    /// strand). Event handler is invoked with true when the backlog reaches
+    /// the high water mark and with false when it drains to the low mark.
+    void subscribe_congestion(
+        congestion_subscriber::handler&& handler) NOEXCEPT;
+
+    /// The write backlog is above the low water mark after reaching the high
+    /// water mark (requires strand). Protocols may skip optional sends.
+    bool congested() const NOEXCEPT;
+
     /// The number of bytes in the write backlog.
     uint64_t backlog() const NOEXCEPT;
 
     /// The total number of bytes queued/sent to the peer.
     uint64_t total() const NOEXCEPT;
 
+    /// The total number of bytes of complete messages received from the peer.
+    uint64_t received() const NOEXCEPT;
+
+    /// The total nanoseconds of processing of messages from the peer
+    /// (deserialization, dispatch and protocol handlers), thread safe.
+    uint64_t processing() const NOEXCEPT;
+
+    /// Traffic counters of this channel (also recorded to the aggregate).
+    const metrics& traffic() const NOEXCEPT;
+
+    /// Estimated memory of the channel by component (requires strand).
+    virtual footprint memory() const NOEXCEPT;
+
     /// The socket was accepted (vs. connected).
     bool inbound() const NOEXCEPT;
 
@@ -122,23 +296,71 @@ public:
     const config::address& address() const NOEXCEPT;
 
 protected:
-    proxy(const socket::ptr& socket) NOEXCEPT;
+    /// The pool and budget are retained for release by the destructor.
+    proxy(const socket::ptr& socket, const payload_pool::ptr& pool,
+        const memory_budget::ptr& memory) NOEXCEPT;
 
     /// Property values provided to the proxy.
-    virtual size_t minimum_buffer() const NOEXCEPT = 0;
     virtual size_t maximum_payload() const NOEXCEPT = 0;
     virtual uint32_t protocol_magic() const NOEXCEPT = 0;
     virtual bool validate_checksum() const NOEXCEPT = 0;
+    virtual bool retain_payload() const NOEXCEPT = 0;
+    virtual size_t maximum_gather_count() const NOEXCEPT = 0;
+    virtual size_t maximum_gather_bytes() const NOEXCEPT = 0;
+    virtual size_t deserialize_threshold() const NOEXCEPT = 0;
+    virtual size_t read_chunk() const NOEXCEPT = 0;
+    virtual size_t read_ahead() const NOEXCEPT = 0;
+    virtual size_t write_slice() const NOEXCEPT = 0;
+    virtual size_t buffer_retain() const NOEXCEPT = 0;
+    virtual deadline::duration buffer_idle() const NOEXCEPT = 0;
+    virtual deadline::duration read_quantum() const NOEXCEPT = 0;
+    virtual bool batch_checksum() const NOEXCEPT = 0;
+    virtual bool deduplicate_sends() const NOEXCEPT = 0;
+    virtual bool pool_sends() const NOEXCEPT = 0;
+    virtual size_t rate_limit() const NOEXCEPT = 0;
+    virtual size_t send_high_water() const NOEXCEPT = 0;
+    virtual size_t send_low_water() const NOEXCEPT = 0;
+    virtual deadline::duration send_grace() const NOEXCEPT = 0;
+    virtual size_t compression_minimum() const NOEXCEPT = 0;
     virtual uint32_t version() const NOEXCEPT = 0;
 
+    /// A trusted channel is not held by the process upload budget.
+    virtual bool trusted() const NOEXCEPT = 0;
+
+    /// Per-message (LOGX) tracing is sampled 1-in-N, zero disables.
+    virtual size_t trace_sample() const NOEXCEPT = 0;
+
+    /// Identifier of traced spans (the channel identifier).
+    virtual uint64_t trace_id() const NOEXCEPT = 0;
+
+    /// Service for deserialization of payloads at or above the threshold.
+    virtual asio::io_context& deserializer() NOEXCEPT = 0;
+
+    /// Service for batched checksums of small payloads (if batch_checksum).
+    virtual checksum_batcher& checksums() NOEXCEPT = 0;
+
+    /// Traffic counters aggregated over all channels.
+    virtual metrics& aggregate() NOEXCEPT = 0;
+
+    /// Upload budget shared by all channels, bulk sends defer when spent.
+    virtual upload_budget& uploads() NOEXCEPT = 0;
+
+    /// Capture of the messages read, nullptr if not capturing.
+    virtual capture* recorder() NOEXCEPT = 0;
+
+    /// Export of the payloads read, nullptr if not exporting.
+    virtual message_exporter* exporter() NOEXCEPT = 0;
+
     /// Events provided by the proxy.
 
     /// A message has been received from the peer.
     virtual void signal_activity() NOEXCEPT = 0;
 
     /// Notify subscribers of a new message (requires strand).
+    /// Hash is the payload double sha256, null if checksum not validated.
     virtual code notify(messages::identifier id, uint32_t version,
-        const system::data_chunk& source) NOEXCEPT;
+        const system::chunk_ptr& source,
+        const system::hash_cptr& hash) NOEXCEPT;
 
     /// Send a serialized message to the peer.
     virtual void write(const system::chunk_ptr& payload,
@@ -148,36 +370,141 @@ protected:
     void subscribe_stop(result_handler&& handler) NOEXCEPT;
 
 private:
-    typedef messages::heading::cptr heading_ptr;
     typedef std::deque<std::pair<system::chunk_ptr, result_handler>> queue;
 
+    // Send lanes by priority (control, announcement, bulk), FIFO in each.
+    static constexpr size_t lanes = 3;
+    static constexpr size_t control_lane = 0;
+    static constexpr size_t announcement_lane = 1;
+    static constexpr size_t bulk_lane = 2;
+    static size_t send_lane(messages::identifier id) NOEXCEPT;
+    static uint64_t content_key(const system::data_chunk& payload) NOEXCEPT;
+
     void do_stop(const code& ec) NOEXCEPT;
     void do_subscribe_stop(const result_handler& handler,
         const result_handler& complete) NOEXCEPT;
 
+    void do_grant(size_t messages, size_t bytes) NOEXCEPT;
+    bool credited() const NOEXCEPT;
+    void consume(size_t bytes) NOEXCEPT;
+
     void read_heading() NOEXCEPT;
+    void read_ahead_heading() NOEXCEPT;
+    void handle_read_ahead(const code& ec, size_t bytes) NOEXCEPT;
+    size_t take_ahead(const system::data_slab& out) NOEXCEPT;
     void handle_read_heading(const code& ec, size_t heading_size) NOEXCEPT;
-    void handle_read_payload(const code& ec, size_t payload_size,
-        const heading_ptr& head) NOEXCEPT;
-
+    void handle_read_payload(const code& ec, size_t payload_size) NOEXCEPT;
+    void handle_checksum(const system::hash_cptr& hash) NOEXCEPT;
+    void handle_payload(const system::hash_cptr& hash) NOEXCEPT;
+    void handle_notify(const code& ec) NOEXCEPT;
+    void read_payload_chunk(size_t offset) NOEXCEPT;
+    void handle_read_payload_chunk(const code& ec, size_t bytes,
+        size_t offset) NOEXCEPT;
+    void handle_read_stream() NOEXCEPT;
+    void record() NOEXCEPT;
+    void publish(const system::hash_cptr& hash) NOEXCEPT;
+    void processed(const steady_clock::duration& elapsed) NOEXCEPT;
+    void read_limited(size_t bytes) NOEXCEPT;
+    deadline::duration quantum_delay() NOEXCEPT;
+    void handle_read_limited(const code& ec, size_t bytes) NOEXCEPT;
+    void lease_payload(size_t size) NOEXCEPT;
+    void release_payload() NOEXCEPT;
+    void return_payload() NOEXCEPT;
+    size_t held() const NOEXCEPT;
+    void handle_buffer_idle(const code& ec) NOEXCEPT;
+
+    system::chunk_ptr compress(const system::chunk_ptr& payload) NOEXCEPT;
+    bool enveloped() const NOEXCEPT;
+    bool expand() NOEXCEPT;
+
+    void deserialize(const system::hash_cptr& hash) NOEXCEPT;
+    void do_deserialize(messages::identifier id, const system::hash_cptr& hash,
+        uint32_t version, system::chunk_ptr&& payload) NOEXCEPT;
+    void handle_deserialize(const code& ec, distributor::delivery&& delivery,
+        system::chunk_ptr&& payload) NOEXCEPT;
+
+    void write(messages::identifier id, const system::chunk_ptr& heading,
+        const socket::file_region& payload,
+        const result_handler& handler) NOEXCEPT;
     void write() NOEXCEPT;
-    void handle_write(const code& ec, size_t bytes,
-        const system::chunk_ptr& payload,
+    void congest() NOEXCEPT;
+    size_t gather(asio::const_buffers& buffers, size_t limit) NOEXCEPT;
+    size_t file_size(const system::chunk_ptr& heading) const NOEXCEPT;
+    size_t queued() const NOEXCEPT;
+    bool merge(const system::chunk_ptr& payload,
         const result_handler& handler) NOEXCEPT;
+    void unmerge(const system::chunk_ptr& payload) NOEXCEPT;
+    void handle_write(const code& ec, size_t bytes) NOEXCEPT;
+    void handle_write_file(const code& ec, size_t sent,
+        size_t bytes) NOEXCEPT;
+    void handle_write_limited(const code& ec) NOEXCEPT;
+    void handle_congestion(const code& ec) NOEXCEPT;
+
+    bool sampled() NOEXCEPT;
+    void count_read() NOEXCEPT;
+    void count_write() NOEXCEPT;
+    void set_limits() NOEXCEPT;
+    deadline::duration limited(throttle& limit, size_t bytes) NOEXCEPT;
+    void wait(deadline::ptr& timer, const deadline::duration& delay,
+        result_handler&& handler) NOEXCEPT;
 
     // These are thread safe.
     std::atomic_bool paused_{ true };
     std::atomic<uint64_t> backlog_{};
     std::atomic<uint64_t> total_{};
+    std::atomic<uint64_t> received_{};
+    metrics traffic_{};
     socket::ptr socket_;
+    const payload_pool::ptr pool_;
+    const memory_budget::ptr memory_;
 
     // These are protected by strand.
-    queue queue_{};
-    system::data_chunk payload_buffer_{};
+    std::array<queue, lanes> queues_{};
+    std::array<size_t, lanes> writing_{};
+    size_t slice_lane_{};
+    size_t slice_offset_{};
+    bool slicing_{};
+    std::unordered_multimap<uint64_t, const system::data_chunk*> pending_{};
+    std::unordered_map<const system::data_chunk*, socket::file_region> files_{};
+    const system::data_chunk* filing_{};
+    system::chunk_ptr payload_buffer_{};
+    steady_clock::time_point retained_{};
+    deadline::ptr idle_timer_{};
+    size_t payload_average_{};
+    size_t leased_{};
+    bool retaining_{};
+    bool idling_{};
+    std::unique_ptr<block_stream> block_stream_{};
+    payload_hash payload_hash_{};
     system::data_array<messages::heading::size()> heading_buffer_{};
+    messages::fixed_heading heading_{};
     system::read::bytes::copy heading_reader_{ heading_buffer_ };
+    system::data_chunk ahead_{};
+    size_t ahead_begin_{};
+    size_t ahead_end_{};
+    size_t burst_{};
+    steady_clock::time_point round_{};
+    steady_clock::duration spent_{};
     stop_subscriber stop_subscriber_;
+    congestion_subscriber congestion_subscriber_;
     distributor distributor_;
+    deadline::ptr grace_timer_{};
+    bool congested_{};
+    bool compress_{};
+    bool expand_{};
+    bool flow_control_{};
+    bool starved_{};
+    size_t credit_messages_{};
+    size_t credit_bytes_{};
+    size_t samples_{};
+
+    // These are protected by strand (limits are set upon first resume).
+    bool limited_{};
+    throttle reads_{};
+    throttle writes_{};
+    deadline::ptr read_timer_{};
+    deadline::ptr write_timer_{};
+    bool deferring_{};
 };
 
 } // namespace network
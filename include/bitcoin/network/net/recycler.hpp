@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_RECYCLER_HPP
+#define LIBBITCOIN_NETWORK_NET_RECYCLER_HPP
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Free list of deserialized messages of one type, refilled by the deleter
+/// of each shared message, so that message vectors keep their capacity and
+/// steady state deserialization does not allocate. Messages are released
+/// from any thread, and the list outlives its owner while any message
+/// remains referenced. Messages beyond the retained limit (or with vector
+/// capacity above the retained capacity) are freed.
+template <class Message>
+class recycler final
+{
+public:
+    typedef typename Message::cptr cptr;
+
+    DELETE_COPY_MOVE(recycler);
+
+    /// Up to limit messages retained, of up to capacity vector elements.
+    recycler(size_t limit=4, size_t capacity=1024) NOEXCEPT
+      : store_(std::make_shared<store>(limit, capacity))
+    {
+    }
+
+    /// Deserialize into a recycled (or new) message, nullptr if invalid.
+    cptr deserialize(uint32_t version,
+        const system::data_chunk& data) NOEXCEPT
+    {
+        auto message = store_->acquire();
+        if (!message)
+            return {};
+
+        system::read::bytes::copy reader(data);
+        if constexpr (in_place)
+            Message::deserialize(version, reader, *message);
+        else
+            *message = Message::deserialize(version, reader);
+
+        if (!reader)
+        {
+            store_->release(std::move(message));
+            return {};
+        }
+
+        // The control block is slab allocated, and the deleter refills.
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        return cptr{ message.release(), deleter{ store_ },
+            slab_allocator<Message>{} };
+        BC_POP_WARNING()
+    }
+
+    /// The number of messages retained for reuse.
+    size_t retained() const NOEXCEPT
+    {
+        std::unique_lock lock(store_->mutex);
+        return store_->free.size();
+    }
+
+private:
+    typedef std::unique_ptr<Message> message_ptr;
+
+    static constexpr bool in_place = requires(system::reader& source,
+        Message& out) { Message::deserialize(uint32_t{}, source, out); };
+
+    // The vector capacity of the message (zero if none).
+    static size_t capacity(const Message& message) NOEXCEPT
+    {
+        if constexpr (requires { message.items.capacity(); })
+            return message.items.capacity();
+        else if constexpr (requires { message.addresses.capacity(); })
+            return message.addresses.capacity();
+        else
+            return zero;
+    }
+
+    // Shared by the recycler and its outstanding messages.
+    struct store
+    {
+        store(size_t maximum, size_t elements) NOEXCEPT
+          : limit(maximum), capacity(elements)
+        {
+        }
+
+        message_ptr acquire() NOEXCEPT
+        {
+            {
+                std::unique_lock lock(mutex);
+                if (!free.empty())
+                {
+                    auto message = std::move(free.back());
+                    free.pop_back();
+                    return message;
+                }
+            }
+
+            BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+            return std::make_unique<Message>();
+            BC_POP_WARNING()
+        }
+
+        void release(message_ptr&& message) NOEXCEPT
+        {
+            if (recycler::capacity(*message) > capacity)
+                return;
+
+            std::unique_lock lock(mutex);
+            if (free.size() < limit)
+            {
+                BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+                free.push_back(std::move(message));
+                BC_POP_WARNING()
+            }
+        }
+
+        // These are thread safe.
+        const size_t limit;
+        const size_t capacity;
+
+        // These are protected by mutex.
+        std::vector<message_ptr> free{};
+        std::mutex mutex{};
+    };
+
+    // Returns a released message to the store (or frees it).
+    struct deleter
+    {
+        // Invoked with the (non-const) pointer given to the shared pointer.
+        void operator()(Message* message) const NOEXCEPT
+        {
+            parent->release(message_ptr{ message });
+        }
+
+        std::shared_ptr<store> parent;
+    };
+
+    // This is thread safe.
+    const std::shared_ptr<store> store_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
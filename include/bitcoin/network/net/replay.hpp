@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_REPLAY_HPP
+#define LIBBITCOIN_NETWORK_NET_REPLAY_HPP
+
+#include <filesystem>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/capture.hpp>
+#include <bitcoin/network/net/deadline.hpp>
+#include <bitcoin/network/net/socket.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Writes the messages of a capture to a connected socket, as the peer of a
+/// channel under test, back to back or at the recorded pace. The channel,
+/// distributor and protocols of the other end are thereby driven by captured
+/// traffic, for reproducible benchmarks and regression tests.
+/// All methods other than stop must be called from the socket strand.
+class BCT_API replay final
+  : public std::enable_shared_from_this<replay>, public reporter,
+    protected tracker<replay>
+{
+public:
+    typedef std::shared_ptr<replay> ptr;
+
+    DELETE_COPY_MOVE(replay);
+
+    /// Construct a replay of the capture file to the socket.
+    replay(const logger& log, const socket::ptr& socket,
+        const std::filesystem::path& file, bool paced) NOEXCEPT;
+
+    /// Asserts/logs stopped.
+    ~replay() NOEXCEPT;
+
+    /// Write the capture, the handler is invoked with the count of messages
+    /// written, and success upon the end of the capture. A replay is started
+    /// once (a stopped replay cannot be restarted).
+    void start(count_handler&& handler) NOEXCEPT;
+
+    /// Cancel the replay (idempotent), the handler signals completion.
+    void stop() NOEXCEPT;
+
+private:
+    bool stranded() const NOEXCEPT;
+    void do_stop() NOEXCEPT;
+    void next() NOEXCEPT;
+    void finish(const code& ec) NOEXCEPT;
+    void handle_timer(const code& ec) NOEXCEPT;
+    void handle_write(const code& ec, size_t bytes) NOEXCEPT;
+
+    // These are thread safe.
+    const socket::ptr socket_;
+    const std::filesystem::path file_;
+    const bool paced_;
+
+    // These are not thread safe.
+    deadline::ptr timer_;
+    system::ifstream stream_{};
+    capture::record record_{};
+    steady_clock::time_point start_{};
+    count_handler handler_{};
+    size_t count_{};
+    bool stopped_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_RESOURCES_HPP
+#define LIBBITCOIN_NETWORK_NET_RESOURCES_HPP
+
+#include <atomic>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/net/blocklist.hpp>
+#include <bitcoin/network/net/checksum_batcher.hpp>
+#include <bitcoin/network/net/memory_budget.hpp>
+#include <bitcoin/network/net/message_exporter.hpp>
+#include <bitcoin/network/net/metrics.hpp>
+#include <bitcoin/network/net/name_resolver.hpp>
+#include <bitcoin/network/net/payload_pool.hpp>
+#include <bitcoin/network/net/seen_filter.hpp>
+#include <bitcoin/network/net/serve_cache.hpp>
+#include <bitcoin/network/net/timeout_estimator.hpp>
+#include <bitcoin/network/net/timer_wheel.hpp>
+#include <bitcoin/network/net/upload_budget.hpp>
+#include <bitcoin/network/net/version_template.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// The state shared by the channels of one network, owned by p2p and sized
+/// by its settings upon construction (not by reload). Channels and connectors
+/// retain the resources, as they may be released after their network.
+class BCT_API resources final
+{
+public:
+    typedef std::shared_ptr<resources> ptr;
+
+    DELETE_COPY_MOVE(resources);
+
+    resources(const settings& settings) NOEXCEPT;
+
+    /// Stop the deserialization threads (safe from any thread).
+    void stop() NOEXCEPT;
+
+    /// Block until the deserialization threads terminate.
+    /// Returns false if called from within the threadpool (would deadlock).
+    bool join() NOEXCEPT;
+
+    /// Payload buffer pool.
+    payload_pool& payload_buffers() NOEXCEPT;
+
+    /// Deserialization threadpool.
+    threadpool& deserializers() NOEXCEPT;
+
+    /// Timer wheel (one second resolution) for channel timers.
+    timer_wheel& timers() NOEXCEPT;
+
+    /// Payload checksum batcher.
+    checksum_batcher& checksums() NOEXCEPT;
+
+    /// Host name resolver.
+    name_resolver& resolutions() NOEXCEPT;
+
+    /// Serialized local version message templates.
+    version_template& versions() NOEXCEPT;
+
+    /// Traffic counters, aggregated over all channels.
+    metrics& traffic() NOEXCEPT;
+    const metrics& traffic() const NOEXCEPT;
+
+    /// Memory accounting of channels.
+    memory_budget& memory() NOEXCEPT;
+    const memory_budget& memory() const NOEXCEPT;
+
+    /// Recent connect and handshake durations (if adaptive).
+    timeout_estimator& connects() NOEXCEPT;
+    timeout_estimator& handshakes() NOEXCEPT;
+
+    /// Upload accounting of channels.
+    upload_budget& uploads() NOEXCEPT;
+
+    /// Recently seen inventory.
+    seen_filter& seen() NOEXCEPT;
+
+    /// Recently served blocks and transactions (wire encoded).
+    serve_cache& served() NOEXCEPT;
+
+    /// Export of received payloads to the export_name ring.
+    message_exporter& exporter() NOEXCEPT;
+
+    /// Bulk blocklist of blocklist_path (refreshed by p2p).
+    blocklist& blocked() NOEXCEPT;
+
+    /// Take one of the BIP152 high bandwidth relay slots (at most three).
+    bool take_high_bandwidth() NOEXCEPT;
+
+    /// Return a high bandwidth relay slot obtained by take_high_bandwidth.
+    void release_high_bandwidth() NOEXCEPT;
+
+private:
+    // These are thread safe.
+    payload_pool payload_buffers_;
+    threadpool deserializers_;
+    timer_wheel timers_;
+    checksum_batcher checksums_;
+    name_resolver resolutions_;
+    version_template versions_{};
+    metrics traffic_{};
+    memory_budget memory_;
+    timeout_estimator connects_{};
+    timeout_estimator handshakes_{};
+    upload_budget uploads_;
+    seen_filter seen_;
+    serve_cache served_;
+    message_exporter exporter_;
+    blocklist blocked_;
+    std::atomic<size_t> high_bandwidth_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_ROLLING_FILTER_HPP
+#define LIBBITCOIN_NETWORK_NET_ROLLING_FILTER_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Rolling bloom filter of hashes, retaining approximately the most recent
+/// capacity entries in two generations of half capacity each. When the
+/// current generation is full the older is cleared and becomes current, so
+/// membership is forgotten in insertion order. False negatives occur only
+/// for forgotten entries, and false positives at the specified rate. Bit
+/// positions are salted by a random tweak, so positions are not predictable
+/// from the (peer controlled) hash. A zero capacity filter contains nothing.
+class BCT_API rolling_filter final
+{
+public:
+    DELETE_COPY_MOVE(rolling_filter);
+
+    /// Construct a filter for the capacity (entries) and false positive rate.
+    rolling_filter(size_t capacity,
+        double false_positive=0.000001) NOEXCEPT;
+
+    /// Insert the hash, forgetting the oldest generation when full.
+    void insert(const system::hash_digest& hash) NOEXCEPT;
+
+    /// True if the hash has been inserted (or a false positive).
+    bool contains(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Forget all entries.
+    void clear() NOEXCEPT;
+
+    /// Heap bytes of the filter (both generations).
+    size_t bytes() const NOEXCEPT;
+
+private:
+    typedef std::vector<uint64_t> bits;
+
+    bool contains(size_t generation, uint64_t first,
+        uint64_t second) const NOEXCEPT;
+
+    // These are thread safe (const).
+    const size_t generation_;
+    const size_t words_;
+    const size_t hashes_;
+    const uint64_t tweak_;
+
+    // These are not thread safe.
+    bits bits_;
+    size_t current_{};
+    size_t count_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
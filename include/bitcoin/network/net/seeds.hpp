@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_SEEDS_HPP
+#define LIBBITCOIN_NETWORK_NET_SEEDS_HPP
+
+#include <filesystem>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Virtual, not thread safe, callers serialize usage on the network strand.
+/// Caches the resolved authority and yield of each configured seed, so that
+/// a restart may connect seeds without name resolution and in yield order.
+/// A resolved authority is used only within the configured time to live, and
+/// a seed that failed within that time (without yield) is skipped, unless
+/// all seeds would be skipped.
+/// The file is a line-oriented textual serialization loaded and saved from/to
+/// the settings-specified path. Unconfigured seeds are dropped upon load.
+class BCT_API seeds
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(seeds);
+
+    struct record
+    {
+        config::endpoint seed{};
+        config::authority authority{};
+        uint32_t timestamp{};
+        uint32_t yield{};
+        uint32_t successes{};
+        uint32_t failures{};
+    };
+
+    typedef std::vector<record> records;
+
+    /// Construct an instance.
+    seeds(const settings& settings) NOEXCEPT;
+
+    /// Load records from file (no-op if caching disabled).
+    virtual code load() NOEXCEPT;
+
+    /// Save records to file (no-op if caching disabled).
+    virtual code save() const NOEXCEPT;
+
+    /// Configured seeds, those that yielded most recently first.
+    virtual config::endpoints order() const NOEXCEPT;
+
+    /// The seed's cached authority if fresh, otherwise the seed itself.
+    virtual config::endpoint target(const config::endpoint& seed) const NOEXCEPT;
+
+    /// The cached record of the seed, or default if none.
+    virtual record get(const config::endpoint& seed) const NOEXCEPT;
+
+    /// Record the authority resolved upon successful connect.
+    virtual void connected(const config::endpoint& seed,
+        const config::authority& authority) NOEXCEPT;
+
+    /// Record a connect failure, discarding the cached authority.
+    virtual void failed(const config::endpoint& seed) NOEXCEPT;
+
+    /// Record the count of addresses obtained from the seed.
+    virtual void yielded(const config::endpoint& seed, size_t count) NOEXCEPT;
+
+protected:
+    bool enabled() const NOEXCEPT;
+    bool fresh(const record& record) const NOEXCEPT;
+    bool skipped(const record& record) const NOEXCEPT;
+    record& find(const config::endpoint& seed) NOEXCEPT;
+
+private:
+    // These are thread safe (const).
+    const settings& settings_;
+    const settings::cptr retained_;
+
+    // These are not thread safe.
+    records records_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_SEEN_FILTER_HPP
+#define LIBBITCOIN_NETWORK_NET_SEEN_FILTER_HPP
+
+#include <atomic>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe (lock free), non-virtual.
+/// Rolling bloom filter of hashes shared by channels, as rolling_filter but
+/// with atomic words, so it may be queried and updated from any strand. The
+/// older generation is cleared when the current fills, and an insert racing
+/// that clear may be forgotten (a false negative). Concurrent inserts of the
+/// same hash may both report it as novel. Either only admits a duplicate.
+/// A zero capacity filter contains nothing (every hash is novel).
+class BCT_API seen_filter final
+{
+public:
+    DELETE_COPY_MOVE(seen_filter);
+
+    /// Construct a filter for the capacity (entries) and false positive rate.
+    seen_filter(size_t capacity, double false_positive=0.000001) NOEXCEPT;
+
+    /// Insert the hash, true if it was not contained (novel).
+    bool insert(const system::hash_digest& hash) NOEXCEPT;
+
+    /// True if the hash has been inserted (or a false positive).
+    bool contains(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Heap bytes of the filter (both generations).
+    size_t bytes() const NOEXCEPT;
+
+private:
+    typedef std::vector<std::atomic<uint64_t>> bits;
+
+    bool contains(size_t generation, uint64_t first,
+        uint64_t second) const NOEXCEPT;
+    void roll() NOEXCEPT;
+
+    // These are thread safe (const).
+    const size_t generation_;
+    const size_t words_;
+    const size_t hashes_;
+    const uint64_t tweak_;
+
+    // These are thread safe.
+    bits bits_;
+    std::atomic<size_t> current_{};
+    std::atomic<size_t> count_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
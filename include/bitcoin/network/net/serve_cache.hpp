@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_SERVE_CACHE_HPP
+#define LIBBITCOIN_NETWORK_NET_SERVE_CACHE_HPP
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Least recently used cache of the wire encodings (heading and payload) of
+/// recently served blocks and transactions, keyed by message type, hash, magic
+/// and protocol version. Shared by all channels, so that the get_data requests
+/// of many peers for a new block are loaded and serialized only once.
+/// Capacity is the total bytes of cached encodings, zero disables.
+class BCT_API serve_cache final
+{
+public:
+    DELETE_COPY_MOVE(serve_cache);
+
+    /// Served messages are blocks and transactions.
+    template <class Message>
+    static constexpr bool is_served =
+        system::is_same_type<Message, messages::block> ||
+        system::is_same_type<Message, messages::transaction>;
+
+    serve_cache(size_t capacity) NOEXCEPT;
+
+    /// Obtain the cached encoding of the block or transaction of the hash,
+    /// nullptr if not cached.
+    template <class Message>
+    system::chunk_ptr find(const system::hash_digest& hash, uint32_t magic,
+        uint32_t version) NOEXCEPT
+    {
+        static_assert(is_served<Message>);
+        return find({ Message::id, hash, magic, version });
+    }
+
+    /// Obtain the encoding of the message, serializing and caching it only if
+    /// not cached. Returns nullptr on failure (or a null block/transaction).
+    template <class Message>
+    system::chunk_ptr serialize(const Message& message, uint32_t magic,
+        uint32_t version) NOEXCEPT
+    {
+        static_assert(is_served<Message>);
+        const auto pointer = identity(message);
+        if (!pointer)
+            return {};
+
+        const key value{ Message::id, *pointer, magic, version };
+        if (const auto data = find(value))
+            return data;
+
+        return store(value, messages::serialize(message, magic, version));
+    }
+
+    /// The number of cached encodings.
+    size_t size() const NOEXCEPT;
+
+    /// The total bytes of cached encodings.
+    size_t bytes() const NOEXCEPT;
+
+private:
+    typedef std::tuple<messages::identifier, system::hash_digest, uint32_t,
+        uint32_t> key;
+    typedef std::list<std::pair<key, system::chunk_ptr>> entries;
+
+    // Blocks are keyed by block hash and transactions by txid.
+    static std::optional<system::hash_digest> identity(
+        const messages::block& message) NOEXCEPT;
+    static std::optional<system::hash_digest> identity(
+        const messages::transaction& message) NOEXCEPT;
+
+    system::chunk_ptr find(const key& value) NOEXCEPT;
+    system::chunk_ptr store(const key& value,
+        const system::chunk_ptr& data) NOEXCEPT;
+
+    // This is thread safe (const).
+    const size_t capacity_;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_;
+    entries entries_{};
+    std::map<key, entries::iterator> index_{};
+    size_t bytes_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_SHORT_ID_TABLE_HPP
+#define LIBBITCOIN_NETWORK_NET_SHORT_ID_TABLE_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Not thread safe, non-virtual.
+/// Open addressing (linear probe) map of BIP152 short ids to positions.
+/// Short ids are 48 bit siphash values, so the low bits index the table
+/// directly and the all-ones word marks an empty slot. The table is sized
+/// upon construction to keep load under one half, and does not grow.
+class BCT_API short_id_table final
+{
+public:
+    DELETE_COPY_MOVE(short_id_table);
+
+    /// Construct a table for up to capacity distinct short ids.
+    short_id_table(size_t capacity) NOEXCEPT;
+
+    /// Insert the short id, false if it exists (its value is unchanged).
+    bool insert(uint64_t id, size_t value) NOEXCEPT;
+
+    /// The value of the short id, or nullptr if it does not exist.
+    size_t* find(uint64_t id) NOEXCEPT;
+
+    /// The number of short ids.
+    size_t size() const NOEXCEPT;
+
+private:
+    static constexpr uint64_t empty = max_uint64;
+
+    struct entry
+    {
+        uint64_t id;
+        size_t value;
+    };
+
+    size_t index(uint64_t id) const NOEXCEPT;
+
+    // These are not thread safe.
+    std::vector<entry> entries_;
+    const size_t mask_;
+    size_t size_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
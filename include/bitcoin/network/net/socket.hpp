@@ -41,6 +41,29 @@ class BCT_API socket
 public:
     typedef std::shared_ptr<socket> ptr;
 
+    /// Storage of sockets is recycled upon destruction (allocate_shared).
+    typedef slab_allocator<socket> allocator;
+
+    /// TCP options, zero values retain the system default.
+    struct options
+    {
+        bool no_delay;
+        uint32_t send_buffer;
+        uint32_t receive_buffer;
+        uint32_t keep_alive;
+        uint32_t not_sent_low_water;
+        uint32_t busy_poll;
+    };
+
+    /// A region of an open file, such as a serialized block of a raw block
+    /// store, sent without copying into user space (linux sendfile).
+    struct file_region
+    {
+        int descriptor;
+        uint64_t offset;
+        size_t size;
+    };
+
     DELETE_COPY_MOVE(socket);
 
     /// Use only for incoming connections (defaults outgoing address).
@@ -50,6 +73,11 @@ public:
     socket(const logger& log, asio::io_context& service,
         const config::address& address) NOEXCEPT;
 
+    /// Use only for connections accepted on the service (pre-filtered). The
+    /// connection is reassigned to the socket strand, stopped upon failure.
+    socket(const logger& log, asio::io_context& service,
+        asio::socket&& connection) NOEXCEPT;
+
     /// Asserts/logs stopped.
     virtual ~socket() NOEXCEPT;
 
@@ -76,14 +104,42 @@ public:
     virtual void connect(const asio::endpoints& range,
         result_handler&& handler) NOEXCEPT;
 
+    /// Create an outbound connection to a resolved endpoint, handler posted
+    /// to socket strand. With fast_open (linux) the first write may be sent
+    /// in the SYN (TCP_FASTOPEN_CONNECT), when the host has issued a cookie.
+    virtual void connect(const asio::endpoint& point, bool fast_open,
+        result_handler&& handler) NOEXCEPT;
+
     /// Read from the socket, handler posted to socket strand.
     virtual void read(const system::data_slab& out,
         count_handler&& handler) NOEXCEPT;
 
+    /// Read what is available (at least one byte) from the socket, up to the
+    /// size of the buffer, handler posted to socket strand.
+    virtual void read_some(const system::data_slab& out,
+        count_handler&& handler) NOEXCEPT;
+
     /// Write to the socket, handler posted to socket strand.
     virtual void write(const system::data_slice& in,
         count_handler&& handler) NOEXCEPT;
 
+    /// Write a buffer sequence to the socket (gather), handler posted to
+    /// socket strand. Buffers must remain valid until handler is invoked.
+    virtual void write(const asio::const_buffers& in,
+        count_handler&& handler) NOEXCEPT;
+
+    /// Write a file region to the socket (linux only, otherwise fails with
+    /// operation_failed), handler posted to socket strand. The descriptor
+    /// must remain open until handler is invoked.
+    virtual void write(const file_region& in,
+        count_handler&& handler) NOEXCEPT;
+
+    /// Apply TCP options to a connected socket, failures are ignored.
+    /// Call on the socket strand, or from an accept handler (not guarded).
+    /// Keep alive is idle seconds before probes, not_sent_low_water and
+    /// busy_poll (microseconds) are applied on linux only.
+    virtual void set_options(const options& value) NOEXCEPT;
+
     // Properties.
     // ------------------------------------------------------------------------
 
@@ -112,14 +168,26 @@ protected:
     asio::socket socket_;
     config::authority authority_{};
 
+    // Recycled operation memory, one read and one write at a time.
+    handler_memory read_memory_{};
+    handler_memory write_memory_{};
+
 private:
     void do_stop() NOEXCEPT;
     void do_connect(const asio::endpoints& range,
         const result_handler& handler) NOEXCEPT;
+    void do_connect_endpoint(const asio::endpoint& point, bool fast_open,
+        const result_handler& handler) NOEXCEPT;
     void do_read(const asio::mutable_buffer& out,
         const count_handler& handler) NOEXCEPT;
+    void do_read_some(const asio::mutable_buffer& out,
+        const count_handler& handler) NOEXCEPT;
     void do_write(const asio::const_buffer& in,
         const count_handler& handler) NOEXCEPT;
+    void do_write_buffers(const asio::const_buffers& in,
+        const count_handler& handler) NOEXCEPT;
+    void do_write_file(const file_region& in, size_t sent,
+        const count_handler& handler) NOEXCEPT;
 
     void handle_accept(const error::boost_code& ec,
         const result_handler& handler) NOEXCEPT;
@@ -127,6 +195,8 @@ private:
         const asio::endpoint& peer, const result_handler& handler) NOEXCEPT;
     void handle_io(const error::boost_code& ec, size_t size,
         const count_handler& handler) NOEXCEPT;
+    void handle_write_file(const error::boost_code& ec, const file_region& in,
+        size_t sent, const count_handler& handler) NOEXCEPT;
 };
 
 typedef std::function<void(const code&, const socket::ptr&)> socket_handler;
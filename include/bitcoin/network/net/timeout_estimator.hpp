@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_TIMEOUT_ESTIMATOR_HPP
+#define LIBBITCOIN_NETWORK_NET_TIMEOUT_ESTIMATOR_HPP
+
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Window of recently observed durations of an operation (e.g. connect or
+/// handshake), from which a timeout is estimated as twice the 95th percentile,
+/// within bounds. The maximum bound applies until the window has sixteen
+/// samples, so that a timeout is not derived from few (or no) observations.
+class BCT_API timeout_estimator final
+{
+public:
+    typedef steady_clock::duration duration;
+
+    DELETE_COPY_MOVE(timeout_estimator);
+
+    /// Window is the number of most recent samples retained (minimum one).
+    timeout_estimator(size_t window=128) NOEXCEPT;
+
+    /// Record the duration of a successful operation.
+    void sample(const duration& value) NOEXCEPT;
+
+    /// Count of retained samples.
+    size_t count() const NOEXCEPT;
+
+    /// Estimated timeout within [minimum, maximum].
+    duration estimate(const duration& minimum,
+        const duration& maximum) const NOEXCEPT;
+
+private:
+    // These are thread safe (const).
+    const size_t window_;
+
+    // These are protected by mutex.
+    std::vector<duration::rep> samples_{};
+    size_t next_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
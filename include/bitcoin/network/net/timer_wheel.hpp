@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_TIMER_WHEEL_HPP
+#define LIBBITCOIN_NETWORK_NET_TIMER_WHEEL_HPP
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Hashed timer wheel of coarse resolution, shared by many timers.
+/// Each timer is a key into one of the wheel slots, with a count of the
+/// remaining wheel rotations, so (re)starting or stopping a timer is a
+/// constant time slot move. Only the wheel's own tick timer is known to asio,
+/// and it runs only while there are timers pending. Timer handlers are posted
+/// to the strand of the timer, with error::success on expiration and
+/// error::operation_canceled on stop or restart. Expiration occurs within one
+/// resolution after the timeout (never before).
+class BCT_API timer_wheel final
+{
+public:
+    typedef uint64_t key;
+    typedef steady_clock::duration duration;
+
+    DELETE_COPY_MOVE(timer_wheel);
+
+    /// Construct a wheel of slots ticking at resolution on its own thread.
+    timer_wheel(const duration& resolution=seconds(1),
+        size_t slots=512) NOEXCEPT;
+
+    /// Stop ticking and join the thread, pending handlers are not invoked.
+    ~timer_wheel() NOEXCEPT;
+
+    /// The tick period of the wheel.
+    const duration& resolution() const NOEXCEPT;
+
+    /// The number of pending timers.
+    size_t size() const NOEXCEPT;
+
+    /// Start or restart the timer of the key, assigning a key if not pending.
+    /// A restarted timer posts its previous handler with operation_canceled.
+    void start(key& id, asio::strand& strand, result_handler&& handler,
+        const duration& timeout) NOEXCEPT;
+
+    /// Stop the timer of the key, ok if not pending. The handler is posted.
+    void stop(key id) NOEXCEPT;
+
+private:
+    typedef std::list<key> slot;
+
+    struct entry
+    {
+        asio::strand* strand;
+        result_handler handler;
+        size_t slot;
+        size_t rounds;
+        slot::iterator position;
+    };
+
+    static void post(asio::strand& strand, result_handler&& handler,
+        const code& ec) NOEXCEPT;
+
+    void arm() NOEXCEPT;
+    void handle_tick(const error::boost_code& ec) NOEXCEPT;
+
+    // These are thread safe.
+    const duration resolution_;
+    threadpool pool_{};
+
+    // These are protected by mutex.
+    key next_{};
+    size_t cursor_{};
+    bool ticking_{};
+    bool stopped_{};
+    std::vector<slot> slots_;
+    std::unordered_map<key, entry> entries_{};
+    mutable std::mutex mutex_{};
+
+    // This is protected by the wheel thread.
+    asio::steady_timer timer_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
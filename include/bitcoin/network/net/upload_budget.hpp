@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_UPLOAD_BUDGET_HPP
+#define LIBBITCOIN_NETWORK_NET_UPLOAD_BUDGET_HPP
+
+#include <atomic>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Accounting of bytes written by the channels of a network, against a limit
+/// per interval and a daily serving target. Once either is spent, bulk sends
+/// (blocks, transactions, filters) remain queued until the interval or day
+/// rolls over, while control and announcement sends are exempt (and still
+/// accounted). A zero limit or target disables that constraint.
+class BCT_API upload_budget final
+{
+public:
+    typedef steady_clock::duration duration;
+
+    DELETE_COPY_MOVE(upload_budget);
+
+    upload_budget(size_t limit, size_t target,
+        const duration& interval=seconds{ 1 }) NOEXCEPT;
+
+    /// Account bytes written by a channel.
+    void consume(size_t bytes) NOEXCEPT;
+
+    /// Properties.
+    size_t limit() const NOEXCEPT;
+    size_t target() const NOEXCEPT;
+    size_t sent() const NOEXCEPT;
+    size_t served() const NOEXCEPT;
+
+    /// The interval limit or the daily target is spent.
+    bool deferred() const NOEXCEPT;
+
+    /// Time until bulk sends may resume (zero if not deferred).
+    duration delay() const NOEXCEPT;
+
+private:
+    typedef duration::rep ticks;
+    static ticks now() NOEXCEPT;
+    void roll(std::atomic<ticks>& start, std::atomic<size_t>& count,
+        ticks span) const NOEXCEPT;
+
+    // These are thread safe.
+    const size_t limit_;
+    const size_t target_;
+    const ticks interval_;
+    const ticks day_;
+    mutable std::atomic<ticks> interval_start_;
+    mutable std::atomic<ticks> day_start_;
+    mutable std::atomic<size_t> sent_{};
+    mutable std::atomic<size_t> served_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_VERSION_TEMPLATE_HPP
+#define LIBBITCOIN_NETWORK_NET_VERSION_TEMPLATE_HPP
+
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Serialized local version messages shared by the handshakes of a network.
+/// The encoding of invariant fields (magic, versions, services, sender, user
+/// agent and relay) is cached, and per connection fields (timestamp, receiver
+/// endpoint, nonce and start height) are patched into a copy, followed by the
+/// checksum. Encodings are the same as messages::serialize.
+class BCT_API version_template final
+{
+public:
+    DELETE_COPY_MOVE(version_template);
+
+    /// Templates in excess of this replace the oldest.
+    static constexpr size_t capacity = 8;
+
+    version_template() NOEXCEPT;
+
+    /// Obtain the encoding of message for the given parameters, serializing
+    /// the message only if no template matches. Returns nullptr on failure.
+    system::chunk_ptr serialize(const messages::version& message,
+        uint32_t magic, uint32_t version) NOEXCEPT;
+
+    /// The number of cached templates.
+    size_t size() const NOEXCEPT;
+
+private:
+    struct entry
+    {
+        uint32_t magic;
+        uint32_t version;
+        messages::version message;
+        system::chunk_ptr data;
+    };
+
+    static bool matches(const entry& item, const messages::version& message,
+        uint32_t magic, uint32_t version) NOEXCEPT;
+    static system::chunk_ptr patch(const system::data_chunk& data,
+        const messages::version& message) NOEXCEPT;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_;
+    std::vector<entry> entries_{};
+    size_t next_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_NET_WIRE_CACHE_HPP
+#define LIBBITCOIN_NETWORK_NET_WIRE_CACHE_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Thread safe, non-virtual.
+/// Memoized wire encodings (heading and payload) of a single message instance,
+/// keyed by magic, protocol version and witness. A broadcast carries one cache
+/// to all channels, so that channels with the same negotiated parameters share
+/// one immutable serialized chunk and the checksum is computed only once.
+class BCT_API wire_cache final
+{
+public:
+    typedef std::shared_ptr<wire_cache> ptr;
+
+    DELETE_COPY_MOVE(wire_cache);
+
+    wire_cache() NOEXCEPT;
+
+    /// Obtain the encoding of message for the given parameters, serializing
+    /// the message only if not cached. The message must be the same instance
+    /// for every call against the cache. Returns nullptr on failure.
+    /// Witness and witness-stripped encodings (of block, transaction and
+    /// compact messages) are each cached, so relay to a mix of peers pays for
+    /// each at most once. Witness is ignored for other messages.
+    template <class Message>
+    system::chunk_ptr serialize(const Message& message, uint32_t magic,
+        uint32_t version, bool witness=true) NOEXCEPT
+    {
+        const auto encoding = witness ||
+            !messages::is_witness_payload<Message>;
+
+        if (const auto data = find(magic, version, encoding))
+            return data;
+
+        return store(magic, version, encoding,
+            messages::serialize(message, magic, version, encoding));
+    }
+
+    /// The number of cached encodings.
+    size_t size() const NOEXCEPT;
+
+private:
+    struct entry
+    {
+        uint32_t magic;
+        uint32_t version;
+        bool witness;
+        system::chunk_ptr data;
+    };
+
+    system::chunk_ptr find(uint32_t magic, uint32_t version,
+        bool witness) const NOEXCEPT;
+    system::chunk_ptr store(uint32_t magic, uint32_t version, bool witness,
+        const system::chunk_ptr& data) NOEXCEPT;
+
+    // These are protected by mutex.
+    mutable std::mutex mutex_;
+    std::vector<entry> entries_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -22,6 +22,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
@@ -59,9 +60,18 @@ public:
 
     DELETE_COPY_MOVE(p2p);
 
-    /// Construct an instance.
+    /// Construct an instance with its own threads.
     p2p(const settings& settings, const logger& log) NOEXCEPT;
 
+    /// Construct an instance on threads shared with other networks (each
+    /// with its own settings and hosts). Threads and network settings are
+    /// independent, settings.threads is not used. Close blocks until the
+    /// network is stopped, its sessions released and hosts saved, but threads
+    /// are stopped and joined by their owner, after close of all networks on
+    /// them (close of a network on stopped threads results in std::abort).
+    p2p(const settings& settings, const logger& log,
+        thread_context& threads) NOEXCEPT;
+
     /// Calls close().
     virtual ~p2p() NOEXCEPT;
 
@@ -118,14 +128,40 @@ public:
     /// Get the number of address reservations.
     virtual size_t reserved_count() const NOEXCEPT;
 
+    /// Get the network group (ASN or address prefix) of the address.
+    virtual uint64_t network_group(
+        const messages::ip_address& ip) const NOEXCEPT;
+
+    /// Get the number of banned addresses.
+    virtual size_t banned_count() const NOEXCEPT;
+
     /// Get the number of channels.
     virtual size_t channel_count() const NOEXCEPT;
 
     /// Get the number of inbound channels.
     virtual size_t inbound_channel_count() const NOEXCEPT;
 
-    /// Network configuration settings.
-    const settings& network_settings() const NOEXCEPT;
+    /// Get traffic counters aggregated over all channels (thread safe).
+    virtual metrics::snapshot traffic() const NOEXCEPT;
+
+    /// Get bytes held by all channels against the memory budget (thread safe).
+    virtual size_t memory_used() const NOEXCEPT;
+
+    /// Get live instance counts of all tracked classes (thread safe).
+    virtual census::entries instances() const NOEXCEPT;
+
+    /// Network configuration settings (current snapshot, thread safe).
+    /// Retain the snapshot (not a reference into it) beyond the expression.
+    settings::cptr network_settings() const NOEXCEPT;
+
+    /// Swap in a snapshot with the runtime fields of update (thread safe).
+    /// Sessions and hosts observe it upon next use, and new channels (with
+    /// their protocols), connectors and acceptors upon creation, as each
+    /// retains the snapshot with which it was created. A replaced snapshot is
+    /// freed once no longer retained. Only the fields copied by
+    /// settings::reload change, so threads, resources, peers and hosts timers
+    /// retain their configuration.
+    virtual void reload(const settings& update) NOEXCEPT;
 
     /// Return a reference to the network io_context (thread safe).
     asio::io_context& service() NOEXCEPT;
@@ -133,6 +169,14 @@ public:
     /// Return a reference to the network strand (thread safe).
     asio::strand& strand() NOEXCEPT;
 
+    /// Return a reference to the compute io_context (thread safe).
+    /// CPU-bound work posted here does not delay socket reads or timers.
+    /// This is the network io_context if settings.compute_threads is zero.
+    asio::io_context& compute() NOEXCEPT;
+
+    /// Return the state shared by channels of the network (thread safe).
+    const network::resources::ptr& resources() const NOEXCEPT;
+
     /// TEMP HACKS.
     /// -----------------------------------------------------------------------
     /// Not thread safe, read from stranded handler only.
@@ -183,17 +227,28 @@ protected:
     virtual session_manual::ptr attach_manual_session() NOEXCEPT;
     virtual session_inbound::ptr attach_inbound_session() NOEXCEPT;
     virtual session_outbound::ptr attach_outbound_session() NOEXCEPT;
+    virtual session_feeler::ptr attach_feeler_session() NOEXCEPT;
 
     /// Override for test injection.
     virtual acceptor::ptr create_acceptor() NOEXCEPT;
     virtual connector::ptr create_connector() NOEXCEPT;
 
-    /// Register nonces for loopback (true implies found), require strand.
+    /// Register nonces for loopback (true implies found), thread safe.
     virtual bool store_nonce(const channel& channel) NOEXCEPT;
     virtual bool unstore_nonce(const channel& channel) NOEXCEPT;
     virtual bool is_loopback(const channel& channel) const NOEXCEPT;
 
-    /// Count channel, guard loopback, reserve address.
+    /// Misbehavior scoring and bans of raw addresses, thread safe.
+    /// Loopback, peered and whitelisted authorities are exempt from scoring.
+    virtual bool banned(const messages::address_item& item) const NOEXCEPT;
+    virtual void misbehaved(const channel& channel, const code& ec) NOEXCEPT;
+
+    /// Anchor peers of the prior run, and those of this run, thread safe.
+    virtual bool take_anchor(address_item_cptr& out) NOEXCEPT;
+    virtual void record_anchor(const channel& channel) NOEXCEPT;
+
+    /// Count channel, guard loopback, reserve address, thread safe.
+    /// Invoked from the channel strand upon handshake completion.
     virtual code count_channel(const channel& channel) NOEXCEPT;
     virtual void uncount_channel(const channel& channel) NOEXCEPT;
 
@@ -202,9 +257,15 @@ protected:
 
     /// Maintain address pool.
     virtual void take(address_item_handler&& handler) NOEXCEPT;
+    virtual void take(uint64_t services,
+        address_item_handler&& handler) NOEXCEPT;
+    virtual void take_new(address_item_handler&& handler) NOEXCEPT;
     virtual void restore(const address_item_cptr& address,
         result_handler&& complete) NOEXCEPT;
-    virtual void fetch(address_handler&& handler) NOEXCEPT;
+    virtual void restore(const address_item_cptr& address, const code& ec,
+        const steady_clock::duration& latency,
+        result_handler&& complete) NOEXCEPT;
+    virtual void fetch(fetch_handler&& handler) NOEXCEPT;
     virtual void save(const address_cptr& message,
         count_handler&& complete) NOEXCEPT;
 
@@ -214,19 +275,39 @@ protected:
 private:
     code subscribe_close(stop_handler&& handler, object_key key) NOEXCEPT;
     connectors_ptr create_connectors(size_t count) NOEXCEPT;
+    acceptors create_acceptors() NOEXCEPT;
     object_key create_key() NOEXCEPT;
 
     virtual bool closed() const NOEXCEPT;
     virtual code start_hosts() NOEXCEPT;
     virtual code stop_hosts() NOEXCEPT;
+    bool hosts_stranded() const NOEXCEPT;
 
     void do_start(const result_handler& handler) NOEXCEPT;
     void do_run(const result_handler& handler) NOEXCEPT;
     void do_close() NOEXCEPT;
 
+    void do_start_hosts(const result_handler& handler) NOEXCEPT;
+    void handle_start_hosts(const code& ec,
+        const result_handler& handler) NOEXCEPT;
     void handle_start(const code& ec, const result_handler& handler) NOEXCEPT;
+    void start_seed(const result_handler& handler) NOEXCEPT;
     void handle_run(const code& ec, const result_handler& handler) NOEXCEPT;
 
+    void start_checkpoint() NOEXCEPT;
+    void handle_checkpoint(const code& ec) NOEXCEPT;
+    void stop_checkpoint() NOEXCEPT;
+
+    void start_sweep() NOEXCEPT;
+    void handle_sweep(const code& ec) NOEXCEPT;
+    void stop_sweep() NOEXCEPT;
+    void refresh_blocklist() NOEXCEPT;
+
+    p2p(const settings& settings, const logger& log,
+        thread_context* shared) NOEXCEPT;
+    void close_shared() NOEXCEPT;
+    void join_pools() NOEXCEPT;
+
     void do_unsubscribe_connect(object_key key) NOEXCEPT;
     void do_notify_connect(const channel::ptr& channel) NOEXCEPT;
     void do_subscribe_connect(const channel_notifier& handler,
@@ -241,34 +322,67 @@ private:
         const channel_notifier& handler) NOEXCEPT;
 
     void do_take(const address_item_handler& handler) NOEXCEPT;
+    void do_take_services(uint64_t services,
+        const address_item_handler& handler) NOEXCEPT;
+    void do_take_new(const address_item_handler& handler) NOEXCEPT;
     void do_restore(const address_item_cptr& address,
         const result_handler& handler) NOEXCEPT;
-    void do_fetch(const address_handler& handler) NOEXCEPT;
+    void do_restore_connected(const address_item_cptr& address,
+        const code& ec, const steady_clock::duration& latency,
+        const result_handler& handler) NOEXCEPT;
+    void do_fetch(const fetch_handler& handler) NOEXCEPT;
     void do_save(const address_cptr& message,
         const count_handler& handler) NOEXCEPT;
+    void handle_take(const code& ec, const address_item_cptr& host,
+        const address_item_handler& handler) NOEXCEPT;
+    void handle_restore(const code& ec,
+        const result_handler& handler) NOEXCEPT;
 
     // These are thread safe.
     const settings& settings_;
     std::atomic_bool closed_{ false };
+    std::atomic<size_t> sessions_{};
     std::atomic<size_t> total_channel_count_{};
     std::atomic<size_t> inbound_channel_count_{};
 
+    // Shared with channels and connectors, which may be released after close.
+    const network::resources::ptr resources_;
+
+    // The current snapshot (protected by mutex), the caller's until reload.
+    mutable std::mutex reload_mutex_{};
+    settings::cptr current_;
+
     // These are protected by strand.
     session_manual::ptr manual_{};
-    threadpool threadpool_;
+    size_t starting_{};
+    code start_code_{};
+
+    // These are thread safe.
+    std::unique_ptr<thread_context> owned_;
+    thread_context& threads_;
+    std::unique_ptr<threadpool> compute_;
 
-    // This is thread safe.
+    // These are thread safe.
     asio::strand strand_;
+    asio::strand hosts_strand_;
 
-    // These are protected by strand.
+    // These are protected by hosts strand (except reservations).
     hosts hosts_;
+    deadline::ptr checkpoint_{};
+    deadline::ptr sweep_{};
+
+    // These are thread safe.
+    bans bans_;
+    anchors anchors_;
+
+    // These are protected by strand.
     broadcaster broadcaster_;
     stop_subscriber stop_subscriber_;
     channel_subscriber connect_subscriber_;
     object_key keys_{};
 
-    // Guards loopback.
-    std::unordered_set<uint64_t> nonces_{};
+    // Guards loopback, thread safe (queried from channel strands).
+    nonces nonces_;
 };
 
 } // namespace network
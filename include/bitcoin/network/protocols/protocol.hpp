@@ -21,6 +21,7 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
@@ -57,18 +58,55 @@ public:
 private:
     template <class Message, typename Handler>
     bool handle_broadcast(const code& ec, const typename Message::cptr& message,
-        uint64_t sender, const Handler& handler) NOEXCEPT
+        const wire_cache::ptr& cache, uint64_t sender,
+        const Handler& handler) NOEXCEPT
     {
         if (stopped(ec))
             return false;
 
         // Invoke subscriber on channel strand with given parameters.
-        boost::asio::post(channel_->strand(),
-            std::bind(handler, ec, message, sender));
+        boost::asio::post(channel_->strand(), channel_timed(
+            [self = shared_from_this(), ec, message, cache, sender, handler]()
+            {
+                self->relay_broadcast<Message>(ec, message, cache, sender,
+                    handler);
+            }));
 
         return true;
     }
 
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+    // Resume the awaiting coroutine via the strand.
+    template <typename Handler, typename Result>
+    void resume_awaiting(const std::shared_ptr<Handler>& handler,
+        Result&& result) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        boost::asio::post(channel_->strand(),
+            [handler, result = std::forward<Result>(result)]() mutable
+            {
+                std::move(*handler)(std::move(result));
+            });
+        BC_POP_WARNING()
+    }
+#endif
+
+    template <class Message, typename Handler>
+    void relay_broadcast(const code& ec, const typename Message::cptr& message,
+        const wire_cache::ptr& cache, uint64_t sender,
+        const Handler& handler) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+
+        // The relay cache is set only for the duration of handler invocation,
+        // so that a send of the broadcast message reuses its wire encoding.
+        relay_message_ = message.get();
+        relay_cache_ = cache;
+        handler(ec, message, sender);
+        relay_message_ = nullptr;
+        relay_cache_.reset();
+    }
+
 protected:
     /// Messaging.
     /// -----------------------------------------------------------------------
@@ -85,9 +123,53 @@ protected:
     void send(const Message& message, Method&& method, Args&&... args) NOEXCEPT
     {
         BC_ASSERT_MSG(stranded(), "strand");
+
+        // Relay of a broadcast message shares the broadcast encoding.
+        if (relay_cache_ && relay_message_ == &message)
+        {
+            channel_->send<Message>(message, *relay_cache_,
+                BOUND_PROTOCOL(method, args));
+            return;
+        }
+
+        // Local version messages are patched from a shared template.
+        if constexpr (system::is_same_type<Message, messages::version>)
+        {
+            channel_->send<Message>(message, resources().versions(),
+                BOUND_PROTOCOL(method, args));
+            return;
+        }
+
+        // Served blocks and transactions share an encoding across channels.
+        if constexpr (serve_cache::is_served<Message>)
+        {
+            if (!is_zero(settings().serve_cache_megabytes))
+            {
+                channel_->send<Message>(message, resources().served(),
+                    BOUND_PROTOCOL(method, args));
+                return;
+            }
+        }
+
         channel_->send<Message>(message, BOUND_PROTOCOL(method, args));
     }
 
+    /// Send the cached encoding of a served block or transaction of the hash
+    /// to peer (use SERVE#), false if not cached (method is not invoked). Upon
+    /// a miss load the message and SEND# it, which caches its encoding.
+    template <class Protocol, class Message, typename Method, typename... Args>
+    bool serve(const system::hash_digest& hash, Method&& method,
+        Args&&... args) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+
+        if (is_zero(settings().serve_cache_megabytes))
+            return false;
+
+        return channel_->send<Message>(hash, resources().served(),
+            BOUND_PROTOCOL(method, args));
+    }
+
     /// Subscribe to channel messages by type (use SUBSCRIBE_CHANNEL#).
     /// Method is invoked with error::subscriber_stopped if already stopped.
     template <class Protocol, class Message, typename Method, typename... Args>
@@ -99,28 +181,217 @@ protected:
 
     /// Subscribe to messages broadcasts by type (use SUBSCRIBE_BROADCAST#).
     /// Method is invoked with error::subscriber_stopped if already stopped.
+    /// With broadcast_fanout the method is not invoked for own broadcasts.
     template <class Protocol, class Message, typename Method, typename... Args>
     void subscribe_broadcast(Method&& method, Args&&... args) NOEXCEPT
     {
         BC_ASSERT_MSG(stranded(), "strand");
 
+        // Fan-out handler is invoked on the channel strand by the broadcaster.
+        if (!is_zero(settings().broadcast_fanout))
+        {
+            const auto relay =
+            [self = shared_from_this(), handler = BOUND_PROTOCOL(method, args)]
+            (const auto& ec, const typename Message::cptr& message,
+                const wire_cache::ptr& cache, auto id)
+            {
+                if (self->stopped(ec))
+                    return false;
+
+                self->relay_broadcast<Message>(ec, message, cache, id,
+                    handler);
+                return true;
+            };
+
+            session_.subscribe_fanout<Message>(relay, channel_->identifier(),
+                channel_->strand(), channel_->capabilities());
+            return;
+        }
+
         // handler is a bool function, causes problem with std::bind.
         const auto bouncer =
         [self = shared_from_this(), handler = BOUND_PROTOCOL(method, args)]
-        (const auto& ec, const typename Message::cptr& message, auto id)
+        (const auto& ec, const typename Message::cptr& message,
+            const wire_cache::ptr& cache, auto id)
         {
-            return self->handle_broadcast<Message>(ec, message, id, handler);
+            return self->handle_broadcast<Message>(ec, message, cache, id,
+                handler);
         };
 
         session_.subscribe<Message>(bouncer, channel_->identifier());
     }
 
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+    /// Coroutines (optional alternative to BIND#/SEND#/SUBSCRIBE_CHANNEL#).
+    /// -----------------------------------------------------------------------
+    /// Coroutines run on the channel strand, launched by spawn(), which
+    /// retains the protocol for the coroutine's duration. A receive is a
+    /// one-shot subscription, so a message of the type that arrives while not
+    /// awaited is not delivered to the coroutine. Completions are posted to
+    /// the strand, so a coroutine never resumes within the distributor.
+
+    template <class Message>
+    using received = std::pair<code, typename Message::cptr>;
+
+    /// Launch a coroutine on the channel strand (detached).
+    void spawn(asio::awaitable<>&& routine) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        boost::asio::co_spawn(channel_->strand(),
+            [self = shared_from_this(), routine = std::move(routine)]()
+                mutable -> asio::awaitable<>
+            {
+                co_await std::move(routine);
+            }, boost::asio::detached);
+        BC_POP_WARNING()
+    }
+
+    /// Await the next message of the type (strand required).
+    template <class Message>
+    asio::awaitable<received<Message>> receive() NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        co_return co_await boost::asio::async_initiate<
+            decltype(boost::asio::use_awaitable), void(received<Message>)>(
+            [this](auto&& handler) NOEXCEPT
+            {
+                // Completion handlers are move-only, subscribers copyable.
+                const auto shared = std::make_shared<
+                    std::decay_t<decltype(handler)>>(std::move(handler));
+                channel_->subscribe<Message>(
+                    [self = shared_from_this(), shared](const code& ec,
+                        const typename Message::cptr& message) NOEXCEPT
+                    {
+                        self->resume_awaiting(shared, received<Message>
+                        {
+                            ec, message
+                        });
+
+                        return false;
+                    });
+            }, boost::asio::use_awaitable);
+        BC_POP_WARNING()
+    }
+
+    /// Await completion of a message send to peer (strand required).
+    template <class Message>
+    asio::awaitable<code> async_send(const Message& message) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        co_return co_await boost::asio::async_initiate<
+            decltype(boost::asio::use_awaitable), void(code)>(
+            [this, &message](auto&& handler) NOEXCEPT
+            {
+                const auto shared = std::make_shared<
+                    std::decay_t<decltype(handler)>>(std::move(handler));
+                channel_->send<Message>(message,
+                    [self = shared_from_this(), shared](const code& ec)
+                    {
+                        self->resume_awaiting(shared, ec);
+                    });
+            }, boost::asio::use_awaitable);
+        BC_POP_WARNING()
+    }
+
+    /// Await expiry or cancelation of a channel strand timer.
+    asio::awaitable<code> async_wait(const deadline::ptr& timer) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        co_return co_await boost::asio::async_initiate<
+            decltype(boost::asio::use_awaitable), void(code)>(
+            [this, &timer](auto&& handler) NOEXCEPT
+            {
+                const auto shared = std::make_shared<
+                    std::decay_t<decltype(handler)>>(std::move(handler));
+                timer->start([self = shared_from_this(), shared](
+                    const code& ec)
+                {
+                    self->resume_awaiting(shared, ec);
+                });
+            }, boost::asio::use_awaitable);
+        BC_POP_WARNING()
+    }
+#endif
+
+    /// Queue inventory for trickled announcement to peer (deduplicated).
+    virtual void announce(const messages::inventory_item& item) NOEXCEPT;
+
+    /// Queue a transaction for trickled announcement to peer, by wtxid if
+    /// negotiated (bip339), otherwise by txid (deduplicated).
+    virtual void announce(const system::chain::transaction& tx) NOEXCEPT;
+
+    /// The hash is known to the peer (check before relay of a broadcast).
+    virtual bool is_known(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Record a hash as known to the peer, such as upon its announcement by
+    /// other than inventory (requires strand).
+    virtual void set_known(const system::hash_digest& hash) NOEXCEPT;
+
+    /// The hash has not been seen recently on any channel, and is now seen.
+    /// Thread safe, so duplicates may be dropped before any strand hop.
+    virtual bool is_novel(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Set the fee rate announced by the peer, by which transaction
+    /// broadcasts to the channel are filtered (requires strand).
+    virtual void set_fee_filter(uint64_t rate) NOEXCEPT;
+
+    /// The fee rate announced by the peer, zero if none (requires strand).
+    virtual uint64_t fee_filter() const NOEXCEPT;
+
+    /// The channel send backlog is congested (requires strand).
+    virtual bool congested() const NOEXCEPT;
+
+    /// Subscribe to channel send backlog congestion crossings (requires
+    /// strand), handler is invoked with false upon drain to the low mark.
+    virtual void subscribe_congestion(
+        channel::congestion_subscriber::handler&& handler) NOEXCEPT;
+
     /// Broadcast a message instance to peers (use BROADCAST).
+    /// Fan-out peers not satisfying the requirement are not notified.
     template <class Message>
-    void broadcast(const typename Message::cptr& message) NOEXCEPT
+    void broadcast(const typename Message::cptr& message,
+        const broadcaster::requirement& required={}) NOEXCEPT
     {
         BC_ASSERT_MSG(stranded(), "strand");
-        session_.broadcast<Message>(message, channel_->identifier());
+        session_.broadcast<Message>(message, channel_->identifier(),
+            required);
+    }
+
+    /// Run CPU-bound work on the compute pool and invoke the handler with its
+    /// result (if any) on the channel strand. The protocol is retained until
+    /// the handler completes, which is invoked even if the channel stopped.
+    template <typename Work, typename Handler>
+    void offload(Work&& work, Handler&& handler) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        boost::asio::post(session_.compute(),
+            [self = shared_from_this(), work = std::forward<Work>(work),
+                handler = std::forward<Handler>(handler)]() mutable NOEXCEPT
+            {
+                auto& strand = self->channel_->strand();
+                if constexpr (std::is_void_v<std::invoke_result_t<Work&>>)
+                {
+                    work();
+                    boost::asio::post(strand,
+                        [self, handler = std::move(handler)]() mutable NOEXCEPT
+                        {
+                            handler();
+                        });
+                }
+                else
+                {
+                    boost::asio::post(strand,
+                        [self, result = work(), handler = std::move(handler)]()
+                            mutable NOEXCEPT
+                        {
+                            handler(std::move(result));
+                        });
+                }
+            });
+        BC_POP_WARNING()
     }
 
     /// Start/Stop.
@@ -147,6 +418,9 @@ protected:
     /// Pause the channel (strand required).
     virtual void pause() NOEXCEPT;
 
+    /// Grant the channel read credit, enabling flow control (thread safe).
+    virtual void grant(size_t messages, size_t bytes) NOEXCEPT;
+
     /// Properties.
     /// -----------------------------------------------------------------------
 
@@ -171,21 +445,45 @@ protected:
     /// Set protocol version of the peer (set only during handshake).
     virtual void set_peer_version(const messages::version::cptr& value) NOEXCEPT;
 
+    /// Set compressed relay of the channel (set only during handshake).
+    virtual void set_compression(bool send, bool receive) NOEXCEPT;
+
     /// The negotiated protocol version.
     virtual uint32_t negotiated_version() const NOEXCEPT;
 
     /// Set negotiated protocol version (set only during handshake).
     virtual void set_negotiated_version(uint32_t value) NOEXCEPT;
 
-    /// Network settings.
+    /// Transactions are announced to and by the peer by wtxid (bip339).
+    virtual bool wtxid_relay() const NOEXCEPT;
+
+    /// Set wtxid transaction relay (set only during handshake).
+    virtual void set_wtxid_relay(bool value) NOEXCEPT;
+
+    /// Transactions are reconciled with the peer (bip330).
+    virtual bool reconciliation() const NOEXCEPT;
+
+    /// The bip330 short id key (valid if reconciliation).
+    virtual const messages::siphash_key& reconciliation_key() const NOEXCEPT;
+
+    /// Set bip330 reconciliation short id key (set only during handshake).
+    virtual void set_reconciliation(const messages::siphash_key& key) NOEXCEPT;
+
+    /// Network settings, the snapshot with which the channel was created.
     virtual const network::settings& settings() const NOEXCEPT;
 
+    /// The state shared by channels of the network.
+    virtual network::resources& resources() const NOEXCEPT;
+
     /// Advertised addresses with own services and current timestamp.
     virtual messages::address selfs() const NOEXCEPT;
 
     /// Channel identifier (for broadcast identification).
     virtual uint64_t identifier() const NOEXCEPT;
 
+    /// Record a ping round trip sample with the channel (strand required).
+    virtual void set_round_trip(uint64_t nanoseconds) NOEXCEPT;
+
     /// Addresses.
     /// -----------------------------------------------------------------------
 
@@ -204,7 +502,9 @@ protected:
 
 private:
     void handle_fetch(const code& ec, const address_cptr& message,
-        const address_handler& handler) NOEXCEPT;
+        const wire_cache::ptr& cache, const address_handler& handler) NOEXCEPT;
+    void do_fetch(const code& ec, const address_cptr& message,
+        const wire_cache::ptr& cache, const address_handler& handler) NOEXCEPT;
     void handle_save(const code& ec, size_t accepted,
         const count_handler& handler) NOEXCEPT;
 
@@ -215,8 +515,10 @@ private:
     // This is thread safe.
     session& session_;
 
-    // This is protected by strand.
+    // These are protected by strand.
     bool started_{};
+    const void* relay_message_{};
+    wire_cache::ptr relay_cache_{};
 };
 
 #undef BOUND_PROTOCOL
@@ -230,6 +532,11 @@ private:
 #define SEND3(message, method, p1, p2, p3) \
     send<CLASS>(message, &CLASS::method, p1, p2, p3)
 
+#define SERVE1(Message, hash, method, p1) \
+    serve<CLASS, Message>(hash, &CLASS::method, p1)
+#define SERVE2(Message, hash, method, p1, p2) \
+    serve<CLASS, Message>(hash, &CLASS::method, p1, p2)
+
 #define SUBSCRIBE_CHANNEL1(message, method, p1) \
     subscribe_channel<CLASS, message>(&CLASS::method, p1)
 #define SUBSCRIBE_CHANNEL2(message, method, p1, p2) \
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NETWORK_PROTOCOL_ADDRESS_OUT_31402_HPP
 
 #include <memory>
+#include <unordered_set>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
@@ -45,6 +46,9 @@ public:
     /// Start protocol (strand required).
     void start() NOEXCEPT override;
 
+    /// The channel is stopping (called on strand by stop subscription).
+    void stopping(const code& ec) NOEXCEPT override;
+
 protected:
     virtual bool handle_receive_get_address(const code& ec,
         const messages::get_address::cptr& message) NOEXCEPT;
@@ -52,10 +56,16 @@ protected:
         const messages::address::cptr& message) NOEXCEPT;
     virtual bool handle_broadcast_address(const code& ec,
         const messages::address::cptr& message, uint64_t sender) NOEXCEPT;
+    virtual void handle_relay(const code& ec) NOEXCEPT;
 
 private:
-    // This is protected by strand.
+    void flush_relay() NOEXCEPT;
+
+    // These are protected by strand.
     bool sent_{};
+    deadline::ptr timer_;
+    messages::address_items batch_{};
+    std::unordered_set<messages::address_key> relayed_{};
 };
 
 } // namespace network
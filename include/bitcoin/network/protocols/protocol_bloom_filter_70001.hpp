@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_BLOOM_FILTER_70001_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_BLOOM_FILTER_70001_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// BIP37 bloom filter state, attach if negotiated >= bip37 (and node_bloom).
+/// Maintains the peer's filter from filterload, filteradd and filterclear,
+/// and matches transactions and blocks against it for filtered relay.
+class BCT_API protocol_bloom_filter_70001
+  : public protocol, protected tracker<protocol_bloom_filter_70001>
+{
+public:
+    typedef std::shared_ptr<protocol_bloom_filter_70001> ptr;
+
+    protocol_bloom_filter_70001(session& session,
+        const channel::ptr& channel) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// The peer has loaded a filter (strand required).
+    bool filtered() const NOEXCEPT;
+
+    /// True if the transaction is relevant, or not filtered (strand required).
+    bool match(const system::chain::transaction& tx) NOEXCEPT;
+
+    /// The merkle block of the block, and positions of the matched
+    /// transactions (all if not filtered) to follow it (strand required).
+    messages::merkle_block match(bloom_filter::indexes& matched,
+        const system::chain::block& block) NOEXCEPT;
+
+protected:
+    virtual bool handle_receive_bloom_filter_load(const code& ec,
+        const messages::bloom_filter_load::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_bloom_filter_add(const code& ec,
+        const messages::bloom_filter_add::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_bloom_filter_clear(const code& ec,
+        const messages::bloom_filter_clear::cptr& message) NOEXCEPT;
+
+private:
+    // This is protected by strand.
+    std::unique_ptr<bloom_filter> filter_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_CLIENT_FILTER_70015_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_CLIENT_FILTER_70015_HPP
+
+#include <deque>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// BIP157 compact client filter serving, attach if negotiated >= bip157.
+/// Answers filter, filter header and checkpoint requests from the store.
+/// Filter headers and checkpoints are obtained through the shared cache, and
+/// filter ranges are streamed, one filter per completed send, so that a large
+/// range is neither built in memory nor queued to the proxy all at once.
+class BCT_API protocol_client_filter_70015
+  : public protocol, protected tracker<protocol_client_filter_70015>
+{
+public:
+    typedef std::shared_ptr<protocol_client_filter_70015> ptr;
+
+    /// Filter store interface, implemented by the node (confirmed chain).
+    class BCT_API store
+    {
+    public:
+        virtual ~store() NOEXCEPT = default;
+
+        /// The height of the confirmed block, false if not confirmed.
+        virtual bool get_height(size_t& out,
+            const system::hash_digest& block) const NOEXCEPT = 0;
+
+        /// The hash of the confirmed block at height, false if none.
+        virtual bool get_hash(system::hash_digest& out,
+            size_t height) const NOEXCEPT = 0;
+
+        /// The filter of the block, false if type not supported or none.
+        virtual bool get_filter(system::data_chunk& out, uint8_t type,
+            const system::hash_digest& block) const NOEXCEPT = 0;
+
+        /// The filter hash and filter header of the block, false if none.
+        virtual bool get_filter_header(filter_cache::header& out,
+            uint8_t type, const system::hash_digest& block) const NOEXCEPT = 0;
+    };
+
+    protocol_client_filter_70015(session& session,
+        const channel::ptr& channel, store& filters,
+        filter_cache& cache) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+protected:
+    virtual bool handle_receive_get_client_filters(const code& ec,
+        const messages::get_client_filters::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_get_client_filter_headers(const code& ec,
+        const messages::get_client_filter_headers::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_get_client_filter_checkpoint(const code& ec,
+        const messages::get_client_filter_checkpoint::cptr& message) NOEXCEPT;
+
+    virtual void handle_send_client_filter(const code& ec) NOEXCEPT;
+
+private:
+    struct range
+    {
+        uint8_t type;
+        size_t next;
+        size_t stop;
+    };
+
+    // Resolve the range, false if not confirmed (stops channel if invalid).
+    bool to_range(range& out, uint8_t type, size_t start,
+        const system::hash_digest& stop_hash, size_t limit) NOEXCEPT;
+    bool get_filter_header(filter_cache::header& out, uint8_t type,
+        size_t height) const NOEXCEPT;
+    void send_client_filter() NOEXCEPT;
+
+    // These are thread safe.
+    store& store_;
+    filter_cache& cache_;
+
+    // These are protected by strand.
+    std::deque<range> ranges_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
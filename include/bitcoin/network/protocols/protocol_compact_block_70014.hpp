@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_COMPACT_BLOCK_70014_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_COMPACT_BLOCK_70014_HPP
+
+#include <memory>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// BIP152 compact block relay (receive), attach if negotiated >= bip152.
+/// Announces compact block support (high bandwidth if configured, of at most
+/// three peers of the network per BIP152, released upon stop), and
+/// reconstructs announced compact blocks from the transaction pool, obtaining
+/// missing transactions from the peer. Reconstructed blocks are not validated
+/// here, they are passed to the pool for validation and organization.
+class BCT_API protocol_compact_block_70014
+  : public protocol, protected tracker<protocol_compact_block_70014>
+{
+public:
+    typedef std::shared_ptr<protocol_compact_block_70014> ptr;
+
+    /// Transaction pool interface, implemented by the node.
+    class BCT_API pool
+    {
+    public:
+        virtual ~pool() NOEXCEPT = default;
+
+        /// Candidate transactions for reconstruction (called on strand).
+        virtual system::chain::transaction_cptrs
+            candidates() const NOEXCEPT = 0;
+
+        /// Accept a reconstructed (unvalidated) block from the channel.
+        virtual void accept(const system::chain::block::cptr& block,
+            uint64_t channel) NOEXCEPT = 0;
+    };
+
+    protocol_compact_block_70014(session& session,
+        const channel::ptr& channel, pool& transactions) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// Return the high bandwidth relay slot, if taken (strand required).
+    void stopping(const code& ec) NOEXCEPT override;
+
+    /// High bandwidth relay has been requested of the peer (strand required).
+    bool high_bandwidth() const NOEXCEPT;
+
+    /// The peer has requested high bandwidth relay (strand required).
+    bool peer_high_bandwidth() const NOEXCEPT;
+
+    /// The peer has announced compact block support (strand required).
+    bool peer_compact() const NOEXCEPT;
+
+protected:
+    virtual bool handle_receive_send_compact(const code& ec,
+        const messages::send_compact::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_compact_block(const code& ec,
+        const messages::compact_block::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_compact_transactions(const code& ec,
+        const messages::compact_transactions::cptr& message) NOEXCEPT;
+
+private:
+    typedef std::vector<size_t> indexes;
+
+    // Populate transactions from the pool, false if the message is invalid.
+    bool reconstruct(const messages::compact_block& message) NOEXCEPT;
+    void request() NOEXCEPT;
+    void complete() NOEXCEPT;
+    void reset() NOEXCEPT;
+
+    // This is thread safe.
+    pool& pool_;
+
+    // These are protected by strand.
+    bool high_bandwidth_{};
+    bool peer_high_bandwidth_{};
+    bool peer_compact_{};
+    bool witness_{ true };
+
+    // Pending reconstruction, at most one at a time.
+    system::chain::header::cptr header_{};
+    system::chain::transaction_cptrs transactions_{};
+    indexes missing_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
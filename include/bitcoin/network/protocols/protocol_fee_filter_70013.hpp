@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_FEE_FILTER_70013_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_FEE_FILTER_70013_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// Records the fee rate announced by the peer (bip133), so that transaction
+/// broadcasts below the rate are not relayed to the channel.
+class BCT_API protocol_fee_filter_70013
+  : public protocol, protected tracker<protocol_fee_filter_70013>
+{
+public:
+    typedef std::shared_ptr<protocol_fee_filter_70013> ptr;
+
+    protocol_fee_filter_70013(session& session,
+        const channel::ptr& channel) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+protected:
+    virtual bool handle_receive_fee_filter(const code& ec,
+        const messages::fee_filter::cptr& message) NOEXCEPT;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
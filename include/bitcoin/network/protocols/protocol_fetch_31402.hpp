@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_FETCH_31402_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_FETCH_31402_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// Scheduled get_data (blocks and transactions) from a shared fetcher.
+/// Requests are issued up to the channel's window, refilled upon each receipt
+/// and upon each stall interval, at which stalled items are also requeued.
+/// Unrequested items are ignored here. Upon stop all items in flight on the
+/// channel are requeued for other channels.
+class BCT_API protocol_fetch_31402
+  : public protocol, protected tracker<protocol_fetch_31402>
+{
+public:
+    typedef std::shared_ptr<protocol_fetch_31402> ptr;
+
+    /// Fetched item interface, implemented by the node.
+    class BCT_API sink
+    {
+    public:
+        virtual ~sink() NOEXCEPT = default;
+
+        /// Accept a fetched (unvalidated) block from the channel.
+        virtual void accept(const system::chain::block::cptr& block,
+            uint64_t channel) NOEXCEPT = 0;
+
+        /// Accept a fetched (unvalidated) transaction from the channel.
+        virtual void accept(const system::chain::transaction::cptr& tx,
+            uint64_t channel) NOEXCEPT = 0;
+    };
+
+    protocol_fetch_31402(session& session, const channel::ptr& channel,
+        fetcher& scheduler, sink& items) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// Request available items, such as after enqueue (strand required).
+    virtual void request() NOEXCEPT;
+
+protected:
+    void stopping(const code& ec) NOEXCEPT override;
+
+    virtual void handle_timer(const code& ec) NOEXCEPT;
+    virtual bool handle_receive_block(const code& ec,
+        const messages::block::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_transaction(const code& ec,
+        const messages::transaction::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_not_found(const code& ec,
+        const messages::not_found::cptr& message) NOEXCEPT;
+
+private:
+    // These are thread safe.
+    fetcher& fetcher_;
+    sink& sink_;
+
+    // This is protected by strand.
+    deadline::ptr timer_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
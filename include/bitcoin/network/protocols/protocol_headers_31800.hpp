@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_HEADERS_31800_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_HEADERS_31800_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// Parallel headers sync from a shared header fetcher, attach if negotiated
+/// >= headers_protocol. The channel requests its range of the fetcher by
+/// get_headers, continuing upon each headers receipt until the range is
+/// complete, and then takes another. Headers are hashed in batched lanes.
+/// A discontinuous response stops the channel, and a stalled request stops
+/// the channel with its range released (with progress) to other channels.
+/// Unrequested (announced) headers are ignored here.
+class BCT_API protocol_headers_31800
+  : public protocol, protected tracker<protocol_headers_31800>
+{
+public:
+    typedef std::shared_ptr<protocol_headers_31800> ptr;
+
+    protocol_headers_31800(session& session, const channel::ptr& channel,
+        header_fetcher& scheduler) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// Release the range of the channel (strand required).
+    void stopping(const code& ec) NOEXCEPT override;
+
+    /// Request the range of the channel, if any (strand required).
+    virtual void request() NOEXCEPT;
+
+protected:
+    virtual void handle_timer(const code& ec) NOEXCEPT;
+    virtual bool handle_receive_headers(const code& ec,
+        const messages::headers::cptr& message) NOEXCEPT;
+
+private:
+    static system::hashes hash(const messages::headers& message,
+        uint32_t version) NOEXCEPT;
+
+    // This is thread safe.
+    header_fetcher& fetcher_;
+
+    // These are protected by strand.
+    deadline::ptr timer_;
+    bool requested_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_MEMORY_POOL_60002_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_MEMORY_POOL_60002_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/protocols/protocol_bloom_filter_70001.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// BIP35 memory_pool responder, attach if negotiated >= bip35.
+/// The mempool is paged from a node cursor into inventory messages of up to
+/// max_inventory items, each page sent only once the prior has been written
+/// and the send backlog is not congested. Transactions below the peer's fee
+/// filter, known to the peer, or not matching its bloom filter are omitted.
+/// A request received while streaming is ignored. Transactions are paged by
+/// wtxid to peers that negotiated wtxid relay (bip339).
+class BCT_API protocol_memory_pool_60002
+  : public protocol, protected tracker<protocol_memory_pool_60002>
+{
+public:
+    typedef std::shared_ptr<protocol_memory_pool_60002> ptr;
+
+    /// A mempool transaction, tx is required only for bloom filtered peers,
+    /// and witness_hash (wtxid) only for wtxid relay peers.
+    struct entry
+    {
+        system::hash_digest hash{};
+        system::hash_digest witness_hash{};
+        uint64_t fee_rate{};
+        system::chain::transaction::cptr tx{};
+    };
+
+    /// Mempool position, implemented by the node (read on channel strand).
+    class BCT_API cursor
+    {
+    public:
+        virtual ~cursor() NOEXCEPT = default;
+
+        /// Obtain the next entry, false when exhausted.
+        virtual bool next(entry& out) NOEXCEPT = 0;
+    };
+
+    typedef std::unique_ptr<cursor> cursor_ptr;
+
+    /// Mempool interface, implemented by the node.
+    class BCT_API source
+    {
+    public:
+        virtual ~source() NOEXCEPT = default;
+
+        /// A cursor at the start of the mempool, nullptr if unavailable.
+        virtual cursor_ptr iterate() NOEXCEPT = 0;
+    };
+
+    /// The bloom filter protocol of the channel is optional.
+    protocol_memory_pool_60002(session& session, const channel::ptr& channel,
+        source& pool,
+        const protocol_bloom_filter_70001::ptr& bloom={}) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// Release the cursor (strand required).
+    void stopping(const code& ec) NOEXCEPT override;
+
+protected:
+    virtual bool handle_receive_memory_pool(const code& ec,
+        const messages::memory_pool::cptr& message) NOEXCEPT;
+    virtual void handle_congestion(const code& ec, bool congested) NOEXCEPT;
+    virtual void handle_send_page(const code& ec) NOEXCEPT;
+    virtual void send_page() NOEXCEPT;
+
+private:
+    bool include(const entry& item, const system::hash_digest& hash) NOEXCEPT;
+
+    // This is thread safe.
+    source& source_;
+
+    // These are protected by strand.
+    protocol_bloom_filter_70001::ptr bloom_;
+    cursor_ptr cursor_{};
+    bool waiting_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -56,8 +56,9 @@ protected:
         const messages::pong::cptr& message) NOEXCEPT;
 
 private:
-    // This is protected by strand.
+    // These are protected by strand.
     uint64_t nonce_;
+    logger::time sent_{};
 };
 
 } // namespace network
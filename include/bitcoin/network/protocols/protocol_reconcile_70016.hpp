@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_RECONCILE_70016_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_RECONCILE_70016_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// BIP330 transaction set reconciliation (Erlay), attach if reconciliation
+/// was negotiated in the handshake (implies bip339 wtxid relay).
+/// Transaction broadcasts are flooded (announced) to outbound peers for a
+/// fraction (reconciliation_flood_percent) selected by short id, and are
+/// otherwise added to the bounded set of the channel (overflow is flooded).
+/// The outbound side periodically requests a sketch of the peer's set,
+/// merges it with the sketch of its own, and decodes the difference. Its own
+/// missing from the peer are announced, and those of the peer are requested
+/// by short id, which the peer then announces. Upon decode failure the
+/// initiator requests a sketch extension (once), and both sides flood their
+/// sets if the extended sketch also fails to decode.
+class BCT_API protocol_reconcile_70016
+  : public protocol, protected tracker<protocol_reconcile_70016>
+{
+public:
+    typedef std::shared_ptr<protocol_reconcile_70016> ptr;
+
+    protocol_reconcile_70016(session& session,
+        const channel::ptr& channel) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// The channel is stopping (called on strand by stop subscription).
+    void stopping(const code& ec) NOEXCEPT override;
+
+protected:
+    /// Reconciliation set, wtxids by short id.
+    typedef std::unordered_map<uint32_t, system::hash_digest> set;
+
+    /// Add a wtxid to the set, flooded if selected or if the set is full.
+    virtual void add(const system::hash_digest& wtxid) NOEXCEPT;
+
+    /// Announce each wtxid of the set.
+    virtual void flood(const set& items) NOEXCEPT;
+
+    /// Initiator.
+    virtual void handle_timer(const code& ec) NOEXCEPT;
+    virtual bool handle_receive_sketch(const code& ec,
+        const messages::reconciliation_sketch::cptr& message) NOEXCEPT;
+    virtual bool reconcile(const pin_sketch& remote) NOEXCEPT;
+    virtual void fail() NOEXCEPT;
+
+    /// Responder.
+    virtual bool handle_receive_request(const code& ec,
+        const messages::request_reconciliation::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_extension(const code& ec,
+        const messages::request_sketch_extension::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_difference(const code& ec,
+        const messages::reconciliation_difference::cptr& message) NOEXCEPT;
+
+    virtual bool handle_broadcast_transaction(const code& ec,
+        const messages::transaction::cptr& message, uint64_t sender) NOEXCEPT;
+
+private:
+    static pin_sketch to_sketch(const set& items, size_t capacity) NOEXCEPT;
+
+    // These are thread safe (const).
+    const bool initiator_;
+    const uint32_t flood_percent_;
+
+    // These are protected by strand.
+    deadline::ptr timer_;
+    set set_{};
+    set snapshot_{};
+    system::data_chunk initial_{};
+    size_t capacity_{};
+    bool extended_{};
+    bool pending_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_PROTOCOL_SEND_HEADERS_70012_HPP
+#define LIBBITCOIN_NETWORK_PROTOCOL_SEND_HEADERS_70012_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class session;
+
+/// BIP130 block announcement, attach if negotiated >= bip130.
+/// Records the send_headers preference of the peer, and announces the headers
+/// broadcasts of new tips (by the node) to the channel. Peers that sent
+/// send_headers are sent the headers message itself, which is serialized once
+/// for all channels (the broadcast encoding), avoiding the round trips of
+/// inventory, get_headers and headers. Other peers are announced the block
+/// hashes by inventory. Headers known to the peer are not announced.
+class BCT_API protocol_send_headers_70012
+  : public protocol, protected tracker<protocol_send_headers_70012>
+{
+public:
+    typedef std::shared_ptr<protocol_send_headers_70012> ptr;
+
+    protocol_send_headers_70012(session& session,
+        const channel::ptr& channel) NOEXCEPT;
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+    /// The peer has requested headers announcement (strand required).
+    bool peer_send_headers() const NOEXCEPT;
+
+protected:
+    virtual bool handle_receive_send_headers(const code& ec,
+        const messages::send_headers::cptr& message) NOEXCEPT;
+    virtual bool handle_broadcast_headers(const code& ec,
+        const messages::headers::cptr& message, uint64_t sender) NOEXCEPT;
+
+private:
+    // This is protected by strand.
+    bool peer_send_headers_{};
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
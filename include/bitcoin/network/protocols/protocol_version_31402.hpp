@@ -69,6 +69,11 @@ protected:
     virtual bool handle_receive_acknowledge(const code& ec,
         const messages::version_acknowledge::cptr& message) NOEXCEPT;
 
+    virtual bool handle_receive_wtxid_relay(const code& ec,
+        const messages::wtxid_relay::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_send_reconciliation(const code& ec,
+        const messages::send_reconciliation::cptr& message) NOEXCEPT;
+
     // These are thread safe (const).
     const bool inbound_;
     const uint32_t minimum_version_;
@@ -82,8 +87,14 @@ private:
     bool sent_version_{};
     bool received_version_{};
     bool received_acknowledge_{};
+    bool sent_wtxid_relay_{};
+    bool sent_reconciliation_{};
+    bool received_reconciliation_{};
+    uint64_t local_salt_{};
+    uint64_t remote_salt_{};
     std::shared_ptr<result_handler> handler_{};
     deadline::ptr timer_;
+    steady_clock::time_point started_{};
 };
 
 } // namespace network
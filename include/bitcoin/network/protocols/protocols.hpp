@@ -23,10 +23,19 @@
 #include <bitcoin/network/protocols/protocol_address_in_31402.hpp>
 #include <bitcoin/network/protocols/protocol_address_out_31402.hpp>
 #include <bitcoin/network/protocols/protocol_alert_31402.hpp>
+#include <bitcoin/network/protocols/protocol_bloom_filter_70001.hpp>
+#include <bitcoin/network/protocols/protocol_client_filter_70015.hpp>
+#include <bitcoin/network/protocols/protocol_compact_block_70014.hpp>
+#include <bitcoin/network/protocols/protocol_fee_filter_70013.hpp>
+#include <bitcoin/network/protocols/protocol_fetch_31402.hpp>
+#include <bitcoin/network/protocols/protocol_headers_31800.hpp>
+#include <bitcoin/network/protocols/protocol_memory_pool_60002.hpp>
 #include <bitcoin/network/protocols/protocol_ping_31402.hpp>
 #include <bitcoin/network/protocols/protocol_ping_60001.hpp>
+#include <bitcoin/network/protocols/protocol_reconcile_70016.hpp>
 #include <bitcoin/network/protocols/protocol_reject_70002.hpp>
 #include <bitcoin/network/protocols/protocol_seed_31402.hpp>
+#include <bitcoin/network/protocols/protocol_send_headers_70012.hpp>
 #include <bitcoin/network/protocols/protocol_version_31402.hpp>
 #include <bitcoin/network/protocols/protocol_version_70001.hpp>
 #include <bitcoin/network/protocols/protocol_version_70002.hpp>
@@ -57,10 +57,10 @@ protected:
 private:
     template <typename Message>
     void do_broadcast(const typename Message::cptr& message,
-        channel_id sender) NOEXCEPT
+        channel_id sender, const broadcaster::requirement& required) NOEXCEPT
     {
         BC_ASSERT_MSG(stranded(), "strand");
-        broadcaster_.notify(message, sender);
+        broadcaster_.notify(message, sender, required);
     }
 
     template <typename Handler>
@@ -70,12 +70,28 @@ private:
         broadcaster_.subscribe(move_copy(handler), subscriber);
     }
 
+    template <class Message, typename Handler>
+    void do_subscribe_fanout(const Handler& handler, channel_id subscriber,
+        asio::strand& target,
+        const broadcaster::capabilities_ptr& peer) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+        broadcaster_.subscribe_fanout<Message>(move_copy(handler), subscriber,
+            target, peer);
+    }
+
     void do_unsubscribe(channel_id subscriber) NOEXCEPT
     {
         BC_ASSERT_MSG(stranded(), "strand");
         broadcaster_.unsubscribe(subscriber);
     }
 
+    void do_set_fee_filter(channel_id subscriber, uint64_t rate) NOEXCEPT
+    {
+        BC_ASSERT_MSG(stranded(), "strand");
+        broadcaster_.set_fee_filter(subscriber, rate);
+    }
+
 public:
     /// Broadcast.
     /// -----------------------------------------------------------------------
@@ -98,12 +114,33 @@ public:
         boost::asio::post(strand(), bouncer);
     }
 
+    /// Fan-out handler is invoked on the target strand, excluding sender.
+    /// With peer capabilities, only broadcasts satisfied by them are relayed.
+    template <class Message, typename Handler = broadcaster::handler<Message>>
+    void subscribe_fanout(Handler&& handler, channel_id id,
+        asio::strand& target,
+        const broadcaster::capabilities_ptr& peer={}) NOEXCEPT
+    {
+        // Handler is a bool function, causes problem with std::bind.
+        const auto bouncer =
+        [self = shared_from_this(), handler = std::move(handler), id,
+            &target, peer]()
+        {
+            self->do_subscribe_fanout<Message, Handler>(handler, id, target,
+                peer);
+        };
+
+        // Subscribe on network strand (protects broadcaster).
+        boost::asio::post(strand(), bouncer);
+    }
+
+    /// Fan-out subscribers are pre-filtered by the requirement.
     template <class Message>
-    void broadcast(const typename Message::cptr& message,
-        channel_id sender) NOEXCEPT
+    void broadcast(const typename Message::cptr& message, channel_id sender,
+        const broadcaster::requirement& required={}) NOEXCEPT
     {
-        boost::asio::post(strand(),
-            BIND2(do_broadcast<Message>, message, sender));
+        boost::asio::post(strand(), network_timed(
+            BIND3(do_broadcast<Message>, message, sender, required)));
     }
 
     virtual void unsubscribe(channel_id subscriber) NOEXCEPT
@@ -112,6 +149,13 @@ public:
             BIND1(do_unsubscribe, subscriber));
     }
 
+    /// Reindex the fan-out subscriber by its announced fee rate.
+    virtual void set_fee_filter(channel_id subscriber, uint64_t rate) NOEXCEPT
+    {
+        boost::asio::post(strand(),
+            BIND2(do_set_fee_filter, subscriber, rate));
+    }
+
     /// Start/stop.
     /// -----------------------------------------------------------------------
 
@@ -124,16 +168,24 @@ public:
     /// Utilities.
     /// -----------------------------------------------------------------------
 
-    /// Take an entry from address pool.
+    /// Take an entry advertising required_services() from address pool.
     virtual void take(address_item_handler&& handler) const NOEXCEPT;
 
+    /// Take a new (untried) entry from address pool.
+    virtual void take_new(address_item_handler&& handler) const NOEXCEPT;
+
     /// Fetch a subset of entries (count based on config) from address pool.
-    virtual void fetch(address_handler&& handler) const NOEXCEPT;
+    virtual void fetch(fetch_handler&& handler) const NOEXCEPT;
 
     /// Restore an address to the address pool.
     virtual void restore(const address_item_cptr& address,
         result_handler&& handler) const NOEXCEPT;
 
+    /// Restore an address to the address pool with its connect outcome.
+    virtual void restore(const address_item_cptr& address, const code& ec,
+        const steady_clock::duration& latency,
+        result_handler&& handler) const NOEXCEPT;
+
     /// Save a subset of entries (count based on config) from address pool.
     virtual void save(const address_cptr& message,
         count_handler&& handler) const NOEXCEPT;
@@ -144,12 +196,26 @@ public:
     /// Arbitrary identifier of the session (for p2p subscriber).
     uint64_t identifier() const NOEXCEPT;
 
-    /// Access network configuration settings.
-    const network::settings& settings() const NOEXCEPT;
+    /// Access the current network configuration snapshot (thread safe).
+    network::settings::cptr settings() const NOEXCEPT;
+
+    /// The io_context for CPU-bound work (thread safe).
+    asio::io_context& compute() NOEXCEPT;
+
+    /// The state shared by channels of the network (thread safe).
+    network::resources& resources() const NOEXCEPT;
 
     /// Number of entries in the address pool.
     virtual size_t address_count() const NOEXCEPT;
 
+    /// Network group (ASN or address prefix) of the address.
+    virtual uint64_t network_group(
+        const messages::ip_address& ip) const NOEXCEPT;
+
+    /// Services that taken addresses must advertise (services_minimum).
+    /// Override in derived sessions that require additional services.
+    virtual uint64_t required_services() const NOEXCEPT;
+
 protected:
     typedef uint64_t object_key;
     typedef desubscriber<object_key> subscriber;
@@ -178,6 +244,13 @@ protected:
     /// Override to change channel protocols (base calls from channel strand).
     virtual void attach_protocols(const channel::ptr& channel) NOEXCEPT;
 
+    /// Override to hold the channel handshaken and paused, without protocols
+    /// or connect notification, until promoted (base calls from channel strand).
+    virtual bool standby(const channel::ptr& channel) const NOEXCEPT;
+
+    /// Attach protocols to, notify and resume a started standby channel.
+    virtual void promote(const channel::ptr& channel) NOEXCEPT;
+
     /// Subscriptions.
     /// -----------------------------------------------------------------------
 
@@ -203,6 +276,10 @@ protected:
     /// Call to create channel acceptor, owned by caller.
     virtual acceptor::ptr create_acceptor() NOEXCEPT;
 
+    /// Call to create the acceptors of one bind, owned by caller. With
+    /// reuse_port there is one (sharded) acceptor per channel service.
+    virtual acceptors create_acceptors() NOEXCEPT;
+
     /// Call to create channel connector, owned by caller.
     virtual connector::ptr create_connector() NOEXCEPT;
 
@@ -231,15 +308,23 @@ protected:
     /// Number of outbound connected channels (including manual).
     virtual size_t outbound_channel_count() const NOEXCEPT;
 
-private:
+    /// The raw address is banned for misbehavior.
+    virtual bool banned(const messages::address_item& item) const NOEXCEPT;
+
+    /// Take an anchor peer of the prior run, false if none remain.
+    virtual bool take_anchor(address_item_cptr& out) const NOEXCEPT;
+
+    /// Record an outbound channel stopping at shutdown as an anchor peer.
+    virtual void record_anchor(const channel& channel) const NOEXCEPT;
+
+    /// The network strand.
     asio::strand& strand() NOEXCEPT;
-    object_key create_key() NOEXCEPT;
 
-    void handle_channel_start(const code& ec, const channel::ptr& channel,
-        const result_handler& started, const result_handler& stopped) NOEXCEPT;
+private:
+    object_key create_key() NOEXCEPT;
 
     void handle_handshake(const code& ec, const channel::ptr& channel,
-        const result_handler& start) NOEXCEPT;
+        const result_handler& started, const result_handler& stopped) NOEXCEPT;
     void handle_channel_started(const code& ec, const channel::ptr& channel,
         const result_handler& started) NOEXCEPT;
     void handle_channel_stopped(const code& ec,const channel::ptr& channel,
@@ -248,9 +333,10 @@ private:
     void do_attach_handshake(const channel::ptr& channel,
         const result_handler& handshake) NOEXCEPT;
     void do_handle_handshake(const code& ec, const channel::ptr& channel,
-        const result_handler& start) NOEXCEPT;
+        const result_handler& started, const result_handler& stopped) NOEXCEPT;
     void do_attach_protocols(const channel::ptr& channel,
         const result_handler& started) NOEXCEPT;
+    void do_promote(const channel::ptr& channel) NOEXCEPT;
     void do_handle_channel_started(const code& ec, const channel::ptr& channel,
         const result_handler& started) NOEXCEPT;
     void do_handle_channel_stopped(const code& ec, const channel::ptr& channel,
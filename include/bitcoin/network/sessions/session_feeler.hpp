@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_SESSION_FEELER_HPP
+#define LIBBITCOIN_NETWORK_SESSION_FEELER_HPP
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/sessions/session.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+class p2p;
+
+/// Feeler connections session, thread safe.
+/// One short-lived (quiet) connection at a time, once per feeler interval,
+/// to a new (untried) address of the pool. The channel is dropped upon
+/// handshake, which moves the address to the tried table. An address that
+/// fails to connect or handshake is dropped from the pool, so that outbound
+/// connections are not spent on dead addresses.
+class BCT_API session_feeler
+  : public session, protected tracker<session_feeler>
+{
+public:
+    typedef std::shared_ptr<session_feeler> ptr;
+
+    /// Construct an instance (network should be started).
+    session_feeler(p2p& network, uint64_t identifier) NOEXCEPT;
+
+    /// Start feeler connections (call from network strand).
+    void start(result_handler&& handler) NOEXCEPT override;
+
+protected:
+    /// Overridden to attach no protocols, the channel stops upon start.
+    void attach_protocols(const channel::ptr& channel) NOEXCEPT override;
+
+    /// Start a feeler connection (deferred by the feeler interval).
+    virtual void start_feeler(const code& ec) NOEXCEPT;
+
+private:
+    void handle_started(const code& ec,
+        const result_handler& handler) NOEXCEPT;
+    void do_feeler(const code& ec, const config::address& peer) NOEXCEPT;
+    void handle_connect(const code& ec, const socket::ptr& socket,
+        const config::address& peer, object_key key,
+        const steady_clock::time_point& start) NOEXCEPT;
+    void handle_channel_start(const code& ec, const channel::ptr& channel,
+        const steady_clock::duration& latency) NOEXCEPT;
+    void handle_channel_stop(const code& ec,
+        const channel::ptr& channel) NOEXCEPT;
+
+    /// Retain (restore) the address of a feeler that did not complete.
+    inline bool retain(const code& ec) const NOEXCEPT;
+    void schedule() NOEXCEPT;
+    void handle_reclaim(const code& ec) const NOEXCEPT;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
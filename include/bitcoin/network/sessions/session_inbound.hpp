@@ -19,8 +19,11 @@
 #ifndef LIBBITCOIN_NETWORK_SESSION_INBOUND_HPP
 #define LIBBITCOIN_NETWORK_SESSION_INBOUND_HPP
 
+#include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/net/net.hpp>
@@ -45,6 +48,24 @@ public:
     /// Start accepting inbound connections as configured (call from network strand).
     void start(result_handler&& handler) NOEXCEPT override;
 
+    /// Count of sockets passed to channels (thread safe).
+    size_t accepted() const NOEXCEPT;
+
+    /// Count of sockets dropped by accept pacing (thread safe).
+    size_t paced() const NOEXCEPT;
+
+    /// Count of sockets dropped as banned for misbehavior (thread safe).
+    size_t banned_count() const NOEXCEPT;
+
+    /// Count of sockets dropped at the inbound connection limit (thread safe).
+    size_t oversubscribed() const NOEXCEPT;
+
+    /// Count of sockets dropped under memory pressure (thread safe).
+    size_t pressured() const NOEXCEPT;
+
+    /// Count of channels evicted to admit a new connection (thread safe).
+    size_t evicted() const NOEXCEPT;
+
 protected:
     /// Overridden to change version protocol (base calls from channel strand).
     void attach_handshake(const channel::ptr& channel,
@@ -57,14 +78,35 @@ protected:
     virtual void start_accept(const code& ec,
         const acceptor::ptr& acceptor) NOEXCEPT;
 
+    /// The connection passes filters, pacing and capacity, as applied by the
+    /// acceptor before socket construction (requires strand).
+    virtual bool admit(const config::authority& remote) NOEXCEPT;
+
+    /// The connection passes lists, bans and memory pressure (thread safe).
+    virtual bool screen(const config::authority& remote) NOEXCEPT;
+
+    /// The connection passes pacing and capacity, evicting if configured
+    /// (requires strand).
+    virtual bool accommodate(const config::authority& remote) NOEXCEPT;
+
     /// The authority is blacklisted by configuration.
     virtual bool blacklisted(const config::address& address) const NOEXCEPT;
 
     /// The authority is not whitelisted by configuration (for non-empty list).
     virtual bool whitelisted(const config::address& address) const NOEXCEPT;
 
+    /// The authority is within accept rate limits, consumes (requires strand).
+    virtual bool admitted(const messages::address_item& item) NOEXCEPT;
+
+    /// Stop the least useful inbound channel, false if all are protected
+    /// (requires strand).
+    virtual bool evict() NOEXCEPT;
+
 private:
     void handle_started(const code& ec, const result_handler& handler) NOEXCEPT;
+    void handle_handoff(const code& ec) NOEXCEPT;
+    handoff::listeners take_listeners() const NOEXCEPT;
+    void offer_listeners() NOEXCEPT;
     void handle_accept(const code& ec, const socket::ptr& socket,
         const acceptor::ptr& acceptor) NOEXCEPT;
 
@@ -72,6 +114,25 @@ private:
         const channel::ptr& channel) NOEXCEPT;
     void handle_channel_stop(const code& ec,
         const channel::ptr& channel) NOEXCEPT;
+
+    // Bounds the per group pacing table under address diversity.
+    static constexpr size_t maximum_groups = 65'536;
+
+    // These are thread safe.
+    std::atomic<size_t> accepted_{};
+    std::atomic<size_t> paced_{};
+    std::atomic<size_t> banned_{};
+    std::atomic<size_t> oversubscribed_{};
+    std::atomic<size_t> pressured_{};
+    std::atomic<size_t> evicted_{};
+
+    // These are protected by strand.
+    throttle accepts_;
+    std::unordered_map<uint64_t, throttle> groups_{};
+    std::unordered_map<uint64_t, channel::ptr> channels_{};
+    acceptors acceptors_{};
+    handoff::ptr handoff_{};
+    bool handed_off_{};
 };
 
 } // namespace network
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NETWORK_SESSION_MANUAL_HPP
 
 #include <memory>
+#include <unordered_map>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/config/config.hpp>
 #include <bitcoin/network/define.hpp>
@@ -87,6 +88,10 @@ private:
     void handle_channel_stop(const code& ec, const channel::ptr& channel,
         const config::endpoint& peer, const connector::ptr& connector,
         const channel_notifier& handler) NOEXCEPT;
+
+    // This is protected by strand.
+    // Consecutive connect failures of each connection (its connector).
+    std::unordered_map<connector::ptr, size_t> attempts_{};
 };
 
 } // namespace network
@@ -19,7 +19,13 @@
 #ifndef LIBBITCOIN_NETWORK_SESSION_OUTBOUND_HPP
 #define LIBBITCOIN_NETWORK_SESSION_OUTBOUND_HPP
 
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
@@ -34,6 +40,11 @@ namespace network {
 class p2p;
 
 /// Outbound connections session, thread safe.
+/// Optionally holds a warm standby of handshaken (paused) channels, beyond the
+/// outbound connection target, one of which is promoted immediately upon the
+/// stop of an active outbound channel. Optionally the first of the active
+/// channels are block-relay only (no transaction or address relay), and
+/// optionally no two outbound channels share a network group (best effort).
 class BCT_API session_outbound
   : public session, protected tracker<session_outbound>
 {
@@ -54,32 +65,95 @@ protected:
     /// Overridden to change channel protocols (base calls from channel strand).
     void attach_protocols(const channel::ptr& channel) NOEXCEPT override;
 
+    /// Overridden to hold standby channels (base calls from channel strand).
+    bool standby(const channel::ptr& channel) const NOEXCEPT override;
+
     /// Start outbound connection loop.
     virtual void start_connect(const code& ec) NOEXCEPT;
 
 private:
-    typedef race_quality<const code&, const socket::ptr&> race;
+    typedef race_quality<const code&, const socket::ptr&,
+        const steady_clock::duration&> race;
+
+    // A connected socket that lost a race, with its connect latency.
+    struct spare
+    {
+        socket::ptr socket;
+        steady_clock::duration latency;
+        steady_clock::time_point connected;
+    };
 
     void handle_started(const code& ec,
         const result_handler& handler) NOEXCEPT;
+    void retry_connect(const code& ec, size_t attempts) NOEXCEPT;
     void do_one(const code& ec, const config::address& peer, object_key key,
-        const race::ptr& racer, const connector::ptr& connector) NOEXCEPT;
+        const race::ptr& racer, const connector::ptr& connector,
+        size_t tries) NOEXCEPT;
     void handle_one(const code& ec, const socket::ptr& socket,
-        object_key key, const race::ptr& racer) NOEXCEPT;
+        object_key key, const race::ptr& racer,
+        const steady_clock::time_point& start) NOEXCEPT;
     void handle_connect(const code& ec, const socket::ptr& socket,
-        object_key key) NOEXCEPT;
+        const steady_clock::duration& latency, object_key key,
+        size_t attempts, const race::ptr& racer,
+        const connectors_ptr& connectors) NOEXCEPT;
+    void start_outbound(const socket::ptr& socket,
+        const steady_clock::duration& latency) NOEXCEPT;
 
     void handle_channel_start(const code& ec,
         const channel::ptr& channel) NOEXCEPT;
-    void handle_channel_stop(const code& ec,
-        const channel::ptr& channel) NOEXCEPT;
+    void handle_channel_stop(const code& ec, const channel::ptr& channel,
+        const steady_clock::duration& latency) NOEXCEPT;
 
     /// Restore an address to the address pool.
     inline bool maybe_reclaim(const code& ec) const NOEXCEPT;
     inline bool always_reclaim(const code& ec) const NOEXCEPT;
-    void reclaim(const code& ec, const socket::ptr& socket) NOEXCEPT;
-    void reclaim(const code& ec, const channel::ptr& channel) NOEXCEPT;
+    void reclaim(const code& ec, const socket::ptr& socket,
+        const steady_clock::duration& latency) NOEXCEPT;
+    void reclaim(const code& ec, const channel::ptr& channel,
+        const steady_clock::duration& latency) NOEXCEPT;
     void handle_reclaim(const code& ec) const NOEXCEPT;
+
+    /// Hold or take a connected socket that lost a race.
+    bool put_spare(const socket::ptr& socket,
+        const steady_clock::duration& latency) NOEXCEPT;
+    std::optional<spare> take_spare() NOEXCEPT;
+    bool handle_stop(const code& ec) NOEXCEPT;
+
+    /// Recycle races of completed connect cycles.
+    race::ptr take_race() NOEXCEPT;
+    void put_race(const race::ptr& racer) NOEXCEPT;
+
+    /// Recycle connectors of completed connect cycles.
+    connectors_ptr take_connectors(size_t count) NOEXCEPT;
+    void put_connectors(const connectors_ptr& set) NOEXCEPT;
+
+    /// Size batches from the smoothed connect success rate of attempts.
+    size_t batch_size() const NOEXCEPT;
+    void record_attempt(const code& ec) NOEXCEPT;
+
+    /// Count outbound channels by network group (if diversity enabled).
+    bool is_connected_group(const config::address& peer) const NOEXCEPT;
+    void count_group(const config::address& peer, bool add) NOEXCEPT;
+
+    /// Track and promote standby channels.
+    bool is_standby(const channel::ptr& channel) const NOEXCEPT;
+    bool set_standby(const channel::ptr& channel, bool standby) NOEXCEPT;
+    void promote_standby() NOEXCEPT;
+
+    // These are protected by strand.
+    std::deque<spare> spares_{};
+    std::vector<race::ptr> races_{};
+    connectors idle_{};
+    std::deque<channel::ptr> standbys_{};
+    size_t active_{};
+    size_t block_relays_{};
+    std::unordered_map<uint64_t, size_t> groups_{};
+    double success_rate_{};
+    bool measured_{};
+
+    // These are protected by mutex (standby is read from channel strands).
+    std::unordered_set<uint64_t> standby_{};
+    mutable std::mutex standby_mutex_{};
 };
 
 } // namespace network
@@ -56,6 +56,10 @@ protected:
     /// Overridden to attach only seeding protocols upon channel start.
     void attach_protocols(const channel::ptr& channel) NOEXCEPT override;
 
+    /// Overridden to signal sufficiency as seeded addresses are saved.
+    void save(const address_cptr& message,
+        count_handler&& handler) const NOEXCEPT override;
+
     /// Start a seed connection (called from start).
     virtual void start_seed(const code& ec, const config::endpoint& seed,
         const connector::ptr& connector, const socket_handler& handler) NOEXCEPT;
@@ -72,8 +76,16 @@ private:
         const config::endpoint& seed, const race::ptr& racer) NOEXCEPT;
     void handle_channel_start(const code& ec,
         const channel::ptr& channel) NOEXCEPT;
-    void handle_channel_stop(const code& ec,
-        const channel::ptr& channel, const race::ptr& racer) NOEXCEPT;
+    void handle_channel_stop(const code& ec, const channel::ptr& channel,
+        const config::endpoint& seed, size_t start,
+        const race::ptr& racer) NOEXCEPT;
+
+    // This is thread safe.
+    p2p& network_;
+
+    // These are protected by strand (racer is set before seed channels).
+    seeds seeds_;
+    std::weak_ptr<race> racer_{};
 };
 
 } // namespace network
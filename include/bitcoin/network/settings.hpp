@@ -20,18 +20,25 @@
 #define LIBBITCOIN_NETWORK_SETTINGS_HPP
 
 #include <filesystem>
+#include <memory>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/socket.hpp>
+#include <bitcoin/network/net/timeout_estimator.hpp>
 
 namespace libbitcoin {
 namespace network {
 
 /// Common database configuration settings, properties not thread safe.
+/// Reloaded snapshots are shared, so that their readers may retain them.
 struct BCT_API settings
+  : public std::enable_shared_from_this<settings>
 {
+    typedef std::shared_ptr<const settings> cptr;
+
     DEFAULT_COPY_MOVE_DESTRUCT(settings);
 
     settings() NOEXCEPT;
@@ -39,6 +46,8 @@ struct BCT_API settings
 
     /// Properties.
     uint32_t threads;
+    uint32_t threads_maximum;
+    uint32_t thread_delay_microseconds;
     uint16_t address_upper;
     uint16_t address_lower;
     uint32_t protocol_maximum;
@@ -49,26 +58,114 @@ struct BCT_API settings
     bool enable_address;
     bool enable_alert;
     bool enable_reject;
+    bool enable_send_headers;
+    bool enable_wtxid_relay;
+    bool enable_reconciliation;
     bool enable_transaction;
     bool enable_ipv6;
     bool enable_loopback;
     bool validate_checksum;
+    bool retain_payload;
+    bool lazy_inactivity;
+    bool coarse_time;
+    bool payload_huge_pages;
+    bool context_per_thread;
+    bool compact_high_bandwidth;
+    bool inbound_eviction;
+    bool tcp_no_delay;
+    bool deduplicate_sends;
+    bool pool_sends;
+    bool peer_compression;
+    bool reuse_port;
+    bool outbound_diversity;
+    bool trusted_peers;
     uint32_t identifier;
     uint16_t inbound_connections;
+    uint16_t accept_rate;
+    uint16_t accept_group_rate;
     uint16_t outbound_connections;
     uint16_t connect_batch_size;
+    uint16_t connect_batch_minimum;
+    uint16_t outbound_standby;
+    uint16_t block_relay_connections;
+    uint16_t anchor_connections;
+    uint32_t anchor_lifetime_minutes;
     uint32_t retry_timeout_seconds;
+    uint32_t retry_maximum_seconds;
     uint32_t connect_timeout_seconds;
+    uint32_t connect_stagger_milliseconds;
+    uint32_t resolve_threads;
+    uint32_t resolve_cache_seconds;
+    uint32_t resolve_negative_seconds;
     uint32_t handshake_timeout_seconds;
+    uint32_t timeout_minimum_milliseconds;
     uint32_t seeding_timeout_seconds;
     uint32_t channel_heartbeat_minutes;
     uint32_t channel_inactivity_minutes;
     uint32_t channel_expiration_minutes;
+    uint32_t channel_jitter_percent;
     uint32_t host_pool_capacity;
+    uint32_t host_checkpoint_minutes;
+    uint32_t host_sweep_minutes;
+    uint32_t host_sweep_slice;
+    uint32_t host_expiration_days;
+    uint32_t host_failure_limit;
+    uint32_t ban_threshold;
+    uint32_t ban_minutes;
+    uint32_t ban_decay_minutes;
+    uint32_t address_refresh_seconds;
+    uint16_t address_snapshots;
     uint32_t minimum_buffer;
+    uint32_t payload_pool_capacity;
+    uint32_t buffer_retain_bytes;
+    uint32_t buffer_idle_seconds;
+    uint32_t read_quantum_microseconds;
+    uint32_t memory_budget_megabytes;
+    uint32_t upload_limit;
+    uint32_t upload_target_megabytes;
+    uint16_t gather_write_count;
+    uint32_t gather_write_bytes;
+    uint32_t deserialize_threshold;
+    uint32_t deserialize_threads;
+    uint32_t compute_threads;
+    uint32_t read_chunk_bytes;
+    uint32_t read_ahead_bytes;
+    uint32_t write_slice_bytes;
+    uint32_t compression_minimum;
+    uint32_t checksum_batch_microseconds;
+    uint32_t send_high_water;
+    uint32_t send_low_water;
+    uint32_t send_grace_seconds;
+    uint32_t shutdown_drain_seconds;
+    uint32_t broadcast_fanout;
+    uint32_t trickle_milliseconds;
+    uint32_t announce_capacity;
+    uint32_t seen_capacity;
+    uint32_t serve_cache_megabytes;
+    uint32_t export_megabytes;
+    uint32_t reconciliation_seconds;
+    uint32_t reconciliation_flood_percent;
+    uint32_t trace_sample;
+    uint32_t send_buffer_bytes;
+    uint32_t receive_buffer_bytes;
+    uint32_t keep_alive_seconds;
+    uint32_t not_sent_low_water;
+    uint32_t busy_poll_microseconds;
+    uint32_t fast_open_queue;
+    uint32_t seed_cache_minutes;
+    uint32_t seed_stagger_milliseconds;
+    uint32_t fetch_window;
+    uint32_t fetch_stall_seconds;
+    uint32_t address_relay_milliseconds;
+    uint32_t feeler_seconds;
     uint32_t rate_limit;
     std::string user_agent;
+    std::string export_name{};
     std::filesystem::path path{};
+    std::filesystem::path capture_path{};
+    std::filesystem::path asmap_path{};
+    std::filesystem::path blocklist_path{};
+    std::filesystem::path handoff_path{};
     config::endpoints peers{};
     config::endpoints seeds{};
     config::authorities selfs{};
@@ -76,10 +173,22 @@ struct BCT_API settings
     config::authorities blacklists{};
     config::authorities whitelists{};
     config::authorities friends{};
+    config::authorities traces{};
+    processor_set thread_processors{};
+    processor_set deserialize_processors{};
 
-    /// Set friends.
+    /// Set friends and compile filters (filters scan lists until compiled).
     virtual void initialize() NOEXCEPT;
 
+    /// Copy the fields that are read upon use, and so may change at runtime
+    /// (black/white/trace lists, inbound limit, channel rates and timeouts,
+    /// feeler interval, host sweep slice, expiration and failure limit),
+    /// from update. Filters are recompiled if compiled. Others are fixed.
+    virtual void reload(const settings& update) NOEXCEPT;
+
+    /// Shared ownership of this snapshot, empty if not shared (caller owned).
+    cptr retain() const NOEXCEPT;
+
     /// Helpers.
     virtual bool inbound_enabled() const NOEXCEPT;
     virtual bool outbound_enabled() const NOEXCEPT;
@@ -87,14 +196,52 @@ struct BCT_API settings
     virtual size_t maximum_payload() const NOEXCEPT;
     virtual config::authority first_self() const NOEXCEPT;
     virtual steady_clock::duration retry_timeout() const NOEXCEPT;
-    virtual steady_clock::duration connect_timeout() const NOEXCEPT;
-    virtual steady_clock::duration channel_handshake() const NOEXCEPT;
+    virtual steady_clock::duration retry_backoff(size_t attempts) const NOEXCEPT;
+    virtual steady_clock::duration connect_timeout(
+        const timeout_estimator& connects) const NOEXCEPT;
+    virtual steady_clock::duration connect_stagger() const NOEXCEPT;
+    virtual steady_clock::duration resolve_cache() const NOEXCEPT;
+    virtual steady_clock::duration resolve_negative() const NOEXCEPT;
+    virtual steady_clock::duration channel_handshake(
+        const timeout_estimator& handshakes) const NOEXCEPT;
     virtual steady_clock::duration channel_germination() const NOEXCEPT;
+    virtual steady_clock::duration anchor_lifetime() const NOEXCEPT;
     virtual steady_clock::duration channel_heartbeat() const NOEXCEPT;
     virtual steady_clock::duration channel_inactivity() const NOEXCEPT;
     virtual steady_clock::duration channel_expiration() const NOEXCEPT;
+
+    /// Randomized within channel_jitter_percent below span, so that channels
+    /// started together do not expire (or ping) together.
+    virtual steady_clock::duration staggered(
+        const steady_clock::duration& span) const NOEXCEPT;
+
+    virtual steady_clock::duration host_checkpoint() const NOEXCEPT;
+    virtual steady_clock::duration host_sweep() const NOEXCEPT;
+    virtual steady_clock::duration host_expiration() const NOEXCEPT;
+    virtual steady_clock::duration ban_duration() const NOEXCEPT;
+    virtual steady_clock::duration ban_decay() const NOEXCEPT;
+    virtual steady_clock::duration address_refresh() const NOEXCEPT;
+    virtual steady_clock::duration shutdown_drain() const NOEXCEPT;
+    virtual steady_clock::duration send_grace() const NOEXCEPT;
+    virtual steady_clock::duration buffer_idle() const NOEXCEPT;
+    virtual steady_clock::duration read_quantum() const NOEXCEPT;
+    virtual steady_clock::duration channel_trickle() const NOEXCEPT;
+    virtual steady_clock::duration channel_reconciliation() const NOEXCEPT;
+    virtual steady_clock::duration seed_stagger() const NOEXCEPT;
+    virtual steady_clock::duration fetch_stall() const NOEXCEPT;
+    virtual steady_clock::duration address_relay() const NOEXCEPT;
+    virtual steady_clock::duration feeler_interval() const NOEXCEPT;
+    virtual steady_clock::duration thread_delay() const NOEXCEPT;
     virtual size_t minimum_address_count() const NOEXCEPT;
+    virtual socket::options socket_options() const NOEXCEPT;
     virtual std::filesystem::path file() const NOEXCEPT;
+    virtual std::filesystem::path seeds_file() const NOEXCEPT;
+    virtual std::filesystem::path bans_file() const NOEXCEPT;
+    virtual std::filesystem::path anchors_file() const NOEXCEPT;
+
+    /// Capture file of the channel, capture is disabled for an empty path.
+    virtual std::filesystem::path capture_file(
+        uint64_t identifier) const NOEXCEPT;
 
     /// Filters.
     virtual bool disabled(const messages::address_item& item) const NOEXCEPT;
@@ -104,6 +251,20 @@ struct BCT_API settings
     virtual bool whitelisted(const messages::address_item& item) const NOEXCEPT;
     virtual bool peered(const messages::address_item& item) const NOEXCEPT;
     virtual bool excluded(const messages::address_item& item) const NOEXCEPT;
+    virtual bool traced(const messages::address_item& item) const NOEXCEPT;
+    virtual bool trusted(const messages::address_item& item) const NOEXCEPT;
+
+private:
+    steady_clock::duration adapted(const timeout_estimator& estimator,
+        const steady_clock::duration& maximum) const NOEXCEPT;
+    config::authorities rejections() const NOEXCEPT;
+
+    // These are compiled by initialize().
+    bool compiled_{};
+    config::subnets blacklisted_{};
+    config::subnets whitelisted_{};
+    config::subnets peered_{};
+    config::subnets rejected_{};
 };
 
 } // namespace network
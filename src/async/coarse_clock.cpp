@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/async/coarse_clock.hpp>
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+// Zero ticks implies not running (constant initialized, no static guard).
+static std::atomic<steady_clock::rep> steady_ticks_{};
+static std::atomic<wall_clock::rep> wall_ticks_{};
+static std::atomic_bool stopping_{};
+
+// The ticker is retained for the process and protected by mutex.
+static std::mutex& ticker_mutex() NOEXCEPT
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+static std::unique_ptr<thread>& ticker() NOEXCEPT
+{
+    static std::unique_ptr<thread> instance{};
+    return instance;
+}
+
+static size_t& users() NOEXCEPT
+{
+    static size_t count{};
+    return count;
+}
+
+void coarse_clock::start() NOEXCEPT
+{
+    std::unique_lock lock(ticker_mutex());
+    if (!is_zero(users()++))
+        return;
+
+    // Populate before running so that no read observes a zero tick.
+    tick();
+    stopping_.store(false, std::memory_order_relaxed);
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    ticker() = std::make_unique<thread>(&coarse_clock::run);
+    BC_POP_WARNING()
+}
+
+void coarse_clock::stop() NOEXCEPT
+{
+    std::unique_lock lock(ticker_mutex());
+    if (is_zero(users()) || !is_zero(--users()))
+        return;
+
+    stopping_.store(true, std::memory_order_relaxed);
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    ticker()->join();
+    BC_POP_WARNING()
+
+    ticker().reset();
+    steady_ticks_.store(zero, std::memory_order_relaxed);
+    wall_ticks_.store(zero, std::memory_order_relaxed);
+}
+
+bool coarse_clock::running() NOEXCEPT
+{
+    return !is_zero(steady_ticks_.load(std::memory_order_relaxed));
+}
+
+steady_clock::time_point coarse_clock::steady() NOEXCEPT
+{
+    const auto ticks = steady_ticks_.load(std::memory_order_relaxed);
+    if (is_zero(ticks))
+        return steady_clock::now();
+
+    return steady_clock::time_point{ steady_clock::duration{ ticks } };
+}
+
+wall_clock::time_point coarse_clock::wall() NOEXCEPT
+{
+    const auto ticks = wall_ticks_.load(std::memory_order_relaxed);
+    if (is_zero(ticks))
+        return wall_clock::now();
+
+    return wall_clock::time_point{ wall_clock::duration{ ticks } };
+}
+
+time_t coarse_clock::zulu() NOEXCEPT
+{
+    return wall_clock::to_time_t(wall());
+}
+
+// private
+void coarse_clock::tick() NOEXCEPT
+{
+    steady_ticks_.store(steady_clock::now().time_since_epoch().count(),
+        std::memory_order_relaxed);
+    wall_ticks_.store(wall_clock::now().time_since_epoch().count(),
+        std::memory_order_relaxed);
+}
+
+void coarse_clock::run() NOEXCEPT
+{
+    while (!stopping_.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_for(resolution);
+        tick();
+    }
+}
+
+} // namespace network
+} // namespace libbitcoin
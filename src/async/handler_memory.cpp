@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/async/handler_memory.hpp>
+
+#include <new>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+handler_memory::handler_memory() NOEXCEPT
+{
+}
+
+void* handler_memory::allocate(size_t size) NOEXCEPT
+{
+    if (!in_use_ && size <= capacity)
+    {
+        in_use_ = true;
+        return &storage_;
+    }
+
+    return ::operator new(size);
+}
+
+void handler_memory::deallocate(void* pointer) NOEXCEPT
+{
+    if (pointer == &storage_)
+    {
+        in_use_ = false;
+        return;
+    }
+
+    ::operator delete(pointer);
+}
+
+bool handler_memory::in_use() const NOEXCEPT
+{
+    return in_use_;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/async/object_slab.hpp>
+
+#include <mutex>
+#include <new>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+using namespace system;
+
+object_slab::object_slab(size_t size, size_t limit) NOEXCEPT
+  : size_(size), limit_(limit)
+{
+    free_.reserve(limit_);
+}
+
+object_slab::~object_slab() NOEXCEPT
+{
+    for (const auto block: free_)
+        ::operator delete(block);
+}
+
+void* object_slab::allocate() NOEXCEPT
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (!free_.empty())
+        {
+            const auto block = free_.back();
+            free_.pop_back();
+            return block;
+        }
+    }
+
+    return ::operator new(size_);
+}
+
+void object_slab::deallocate(void* block) NOEXCEPT
+{
+    if (is_null(block))
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (free_.size() < limit_)
+        {
+            free_.push_back(block);
+            return;
+        }
+    }
+
+    ::operator delete(block);
+}
+
+size_t object_slab::retained() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return free_.size();
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -26,6 +26,7 @@
 #else
     #include <unistd.h>
     #include <pthread.h>
+    #include <sched.h>
     #include <sys/resource.h>
     #include <sys/types.h>
     #ifndef PRIO_MAX
@@ -71,6 +72,39 @@ void set_priority(thread_priority priority) NOEXCEPT
 #endif
 }
 
+// Pin the current thread to one logical processor (false if not available).
+// Memory is allocated first-touch on Linux, so a pinned thread's allocations
+// are local to the NUMA node of its processor.
+bool set_affinity(uint32_t processor) NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    if (processor >= to_bits(sizeof(DWORD_PTR)))
+        return false;
+
+    const auto mask = DWORD_PTR{ 1 } << processor;
+    return !is_zero(SetThreadAffinityMask(GetCurrentThread(), mask));
+#elif defined(HAVE_LINUX)
+    if (processor >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t set{};
+    CPU_ZERO(&set);
+    CPU_SET(processor, &set);
+    return is_zero(pthread_setaffinity_np(pthread_self(), sizeof(set), &set));
+#else
+    return false;
+#endif
+}
+
+// Threads are assigned to processors of the set in rotation by index.
+bool set_affinity(const processor_set& processors, size_t index) NOEXCEPT
+{
+    if (processors.empty())
+        return true;
+
+    return set_affinity(processors[index % processors.size()]);
+}
+
 thread_priority priority(bool priority) NOEXCEPT
 {
     return priority ? thread_priority::high : thread_priority::normal;
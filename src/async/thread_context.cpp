@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/async/thread_context.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/asio.hpp>
+#include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/threadpool.hpp>
+#include <bitcoin/network/async/threadpools.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+thread_context::thread_context(size_t number_threads,
+    bool context_per_thread, const processor_set& processors,
+    size_t maximum_threads, const steady_clock::duration& threshold) NOEXCEPT
+  : threadpool_(context_per_thread ? one : number_threads,
+        thread_priority::normal, processors,
+        !context_per_thread && maximum_threads > number_threads),
+    services_(context_per_thread ? number_threads : zero,
+        thread_priority::normal, processors)
+{
+    BC_ASSERT_MSG(!is_zero(number_threads), "empty threadpool");
+
+    // Per thread services are single threaded by design (strand affinity).
+    threadpool_.adapt(maximum_threads, threshold);
+}
+
+thread_context::~thread_context() NOEXCEPT
+{
+    stop();
+    join();
+}
+
+void thread_context::stop() NOEXCEPT
+{
+    stopped_.store(true);
+    services_.stop();
+    threadpool_.stop();
+}
+
+bool thread_context::stopped() const NOEXCEPT
+{
+    return stopped_.load();
+}
+
+bool thread_context::join() NOEXCEPT
+{
+    return services_.join() && threadpool_.join();
+}
+
+bool thread_context::join(const steady_clock::time_point& deadline) NOEXCEPT
+{
+    return services_.join(deadline) && threadpool_.join(deadline);
+}
+
+asio::io_context& thread_context::service() NOEXCEPT
+{
+    return threadpool_.service();
+}
+
+threadpools& thread_context::services() NOEXCEPT
+{
+    return services_;
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -18,14 +18,19 @@
  */
 #include <bitcoin/network/async/threadpool.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/asio.hpp>
 #include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/time.hpp>
 #include <bitcoin/network/define.hpp>
 
 namespace libbitcoin {
 namespace network {
 
+static constexpr std::chrono::milliseconds zero_duration{ 0 };
+
 // Work keeps the threadpool alive when there are no threads running.
 threadpool::work_guard threadpool::keep_alive(asio::io_context& service) NOEXCEPT
 {
@@ -35,23 +40,38 @@ threadpool::work_guard threadpool::keep_alive(asio::io_context& service) NOEXCEP
     BC_POP_WARNING()
 }
 
-// The run() function blocks until all work has finished and there are no
-// more handlers to be dispatched, or until the io_context has been stopped.
-threadpool::threadpool(size_t number_threads, thread_priority priority) NOEXCEPT
-  : work_(keep_alive(service_))
+// Sampling period of handler queue delay when adapting.
+static constexpr std::chrono::milliseconds sample_period{ 100 };
+
+// Consecutive idle samples required to retire a thread (hysteresis).
+static constexpr size_t idle_samples = 50;
+
+// A sample is idle when its delay is below this fraction of threshold.
+static constexpr size_t idle_divisor = 8;
+
+// A hint of one enables the asio scheduler single thread optimization. This
+// remains safe for posts from other threads, unlike the unsafe hints, which
+// also disable reactor locking that socket registration across services
+// (and stop/cancel from other threads) relies upon.
+constexpr int threadpool::concurrency(size_t threads, bool adaptive) NOEXCEPT
 {
-    for (size_t thread = 0; thread < number_threads; ++thread)
-    {
-        threads_.push_back(network::thread([this, priority]() NOEXCEPT
-        {
-            set_priority(priority);
+    return (threads == one && !adaptive) ? 1 :
+        BOOST_ASIO_CONCURRENCY_HINT_DEFAULT;
+}
 
-            // If service.run throws, application will abort at startup.
-            BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-            service_.run();
-            BC_POP_WARNING()
-        }));
-    }
+// The run_one() function blocks until one handler has been dispatched, or
+// until the io_context has been stopped or has run out of work (returns zero).
+threadpool::threadpool(size_t number_threads, thread_priority priority,
+    const processor_set& processors, bool adaptive) NOEXCEPT
+  : service_(concurrency(number_threads, adaptive)),
+    priority_(priority),
+    processors_(processors),
+    minimum_(number_threads),
+    adaptive_(adaptive),
+    work_(keep_alive(service_))
+{
+    for (size_t thread = 0; thread < number_threads; ++thread)
+        spawn();
 }
 
 threadpool::~threadpool() NOEXCEPT
@@ -66,24 +86,202 @@ threadpool::~threadpool() NOEXCEPT
 // boost_asio.reference.io_context.stopping_the_io_context_from_running_out_of_work
 void threadpool::stop() NOEXCEPT
 {
+    {
+        std::lock_guard lock(mutex_);
+        stopped_.store(true);
+    }
+
+    // The sampler timer is work, so it must be cancelled on the service.
+    boost::asio::post(service_, [this]() NOEXCEPT
+    {
+        if (timer_)
+            timer_->cancel();
+    });
+
     // Clear the work keep-alive.
     // Allows all operations and handlers to finish normally.
     work_.reset();
 }
 
+// Threads.
+// ----------------------------------------------------------------------------
+
+// private
+void threadpool::spawn() NOEXCEPT
+{
+    // Caller holds mutex or is the constructor.
+    const auto index = spawned_++;
+    running_.fetch_add(one);
+
+    // If thread construction throws, application will abort.
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    threads_.push_back(network::thread([this, index]() NOEXCEPT
+    {
+        run(index);
+    }));
+    BC_POP_WARNING()
+}
+
+// private
+void threadpool::run(size_t index) NOEXCEPT
+{
+    set_priority(priority_);
+    set_affinity(processors_, index);
+
+    // If service.run_one throws, application will abort.
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    while (!retire())
+    {
+        if (is_zero(service_.run_one()))
+            return;
+    }
+    BC_POP_WARNING()
+}
+
+// private
+// A thread retires (exits) between handlers, when a retirement is pending.
+bool threadpool::retire() NOEXCEPT
+{
+    auto pending = retiring_.load();
+    while (!is_zero(pending))
+    {
+        if (retiring_.compare_exchange_weak(pending, sub1(pending)))
+        {
+            running_.fetch_sub(one);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// private
+void threadpool::grow() NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    if (stopped_.load())
+        return;
+
+    // Reap retired threads, excluding this (sampling) thread.
+    const auto this_id = boost::this_thread::get_id();
+    std::erase_if(threads_, [&](thread& thread) NOEXCEPT
+    {
+        // try_join_for should not throw on a thread other than this.
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        return thread.get_id() != this_id && thread.joinable() &&
+            thread.try_join_for(boost::chrono::milliseconds(0));
+        BC_POP_WARNING()
+    });
+
+    spawn();
+}
+
+// private
+void threadpool::shrink() NOEXCEPT
+{
+    retiring_.fetch_add(one);
+
+    // Wake a thread so that it observes the retirement.
+    boost::asio::post(service_, []() NOEXCEPT {});
+}
+
+// Adaptation.
+// ----------------------------------------------------------------------------
+// The sampler is a chain of single outstanding timer waits, so it executes
+// serially without a strand. Handler queue delay is measured as the lag
+// between timer expiry and dispatch of its completion handler.
+
+void threadpool::adapt(size_t maximum,
+    const steady_clock::duration& threshold) NOEXCEPT
+{
+    if (!adaptive_ || maximum <= minimum_ || is_zero(minimum_))
+        return;
+
+    boost::asio::post(service_, [this, maximum, threshold]() NOEXCEPT
+    {
+        if (timer_ || stopped_.load())
+            return;
+
+        maximum_ = maximum;
+        threshold_ = threshold;
+        timer_ = std::make_unique<asio::steady_timer>(service_);
+        sample();
+    });
+}
+
+size_t threadpool::size() const NOEXCEPT
+{
+    return running_.load();
+}
+
+// private
+void threadpool::sample() NOEXCEPT
+{
+    if (stopped_.load())
+        return;
+
+    timer_->expires_after(sample_period);
+    timer_->async_wait([this](const error::boost_code& ec) NOEXCEPT
+    {
+        handle_sample(ec);
+    });
+}
+
+// private
+void threadpool::handle_sample(const error::boost_code& ec) NOEXCEPT
+{
+    if (ec || stopped_.load())
+        return;
+
+    const auto lag = steady_clock::now() - timer_->expiry();
+    const auto count = running_.load() - std::min(retiring_.load(),
+        running_.load());
+
+    if (lag > threshold_)
+    {
+        idle_ = zero;
+        if (count < maximum_)
+            grow();
+    }
+    else if (lag < threshold_ / idle_divisor)
+    {
+        if (++idle_ >= idle_samples && count > minimum_)
+        {
+            idle_ = zero;
+            shrink();
+        }
+    }
+    else
+    {
+        idle_ = zero;
+    }
+
+    sample();
+}
+
+// Join.
+// ----------------------------------------------------------------------------
+
+// Threads are taken under lock and joined outside of it, as the sampler may
+// require the lock to grow (it observes stop before spawning).
 bool threadpool::join() NOEXCEPT
 {
     const auto this_id = boost::this_thread::get_id();
+    std::vector<thread> threads{};
+    {
+        std::lock_guard lock(mutex_);
+        std::swap(threads, threads_);
+    }
 
-    for (auto& thread: threads_)
+    for (auto& thread: threads)
     {
         // Thread must be joinable.
         if (!thread.joinable())
-            return false;
+            return restore(threads);
 
         // Join cannot be called from a thread in the threadpool (deadlock).
         if (this_id == thread.get_id())
-            return false;
+            return restore(threads);
 
         // Join should not throw given deadlock guard above, but just in case.
         try
@@ -92,14 +290,75 @@ bool threadpool::join() NOEXCEPT
         }
         catch (std::exception&)
         {
-            return false;
+            return restore(threads);
+        }
+    }
+
+    return true;
+}
+
+bool threadpool::join(const steady_clock::time_point& deadline) NOEXCEPT
+{
+    const auto this_id = boost::this_thread::get_id();
+    auto abandoned = false;
+    std::vector<thread> threads{};
+    {
+        std::lock_guard lock(mutex_);
+        std::swap(threads, threads_);
+    }
+
+    for (auto& thread: threads)
+    {
+        // Thread must be joinable.
+        if (!thread.joinable())
+            return restore(threads);
+
+        // Join cannot be called from a thread in the threadpool (deadlock).
+        if (this_id == thread.get_id())
+            return restore(threads);
+
+        try
+        {
+            if (!abandoned)
+            {
+                const auto remaining = std::max(zero_duration,
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - steady_clock::now()));
+
+                if (thread.try_join_for(
+                    boost::chrono::milliseconds(remaining.count())))
+                    continue;
+
+                // Handlers not yet invoked are destroyed with the service.
+                service_.stop();
+                abandoned = true;
+            }
+
+            thread.join();
+        }
+        catch (std::exception&)
+        {
+            return restore(threads);
         }
     }
 
-    threads_.clear();
     return true;
 }
 
+// private
+// Unjoined threads are returned to the pool so that join may be retried.
+bool threadpool::restore(std::vector<thread>& threads) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    for (auto& thread: threads)
+        if (thread.joinable())
+            threads_.push_back(std::move(thread));
+    BC_POP_WARNING()
+
+    return false;
+}
+
 asio::io_context& threadpool::service() NOEXCEPT
 {
     return service_;
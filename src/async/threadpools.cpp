@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/async/threadpools.hpp>
+
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/asio.hpp>
+#include <bitcoin/network/async/thread.hpp>
+#include <bitcoin/network/async/threadpool.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+threadpools::threadpools(size_t number_pools, thread_priority priority,
+    const processor_set& processors) NOEXCEPT
+{
+    pools_.reserve(number_pools);
+    for (size_t pool = 0; pool < number_pools; ++pool)
+    {
+        const auto processor = processors.empty() ? processor_set{} :
+            processor_set{ processors[pool % processors.size()] };
+
+        pools_.push_back(std::make_unique<threadpool>(one, priority,
+            processor));
+    }
+}
+
+BC_POP_WARNING()
+
+threadpools::~threadpools() NOEXCEPT
+{
+    stop();
+    join();
+}
+
+void threadpools::stop() NOEXCEPT
+{
+    for (auto& pool: pools_)
+        pool->stop();
+}
+
+bool threadpools::join() NOEXCEPT
+{
+    auto joined = true;
+    for (auto& pool: pools_)
+        joined &= pool->join();
+
+    return joined;
+}
+
+bool threadpools::join(const steady_clock::time_point& deadline) NOEXCEPT
+{
+    auto joined = true;
+    for (auto& pool: pools_)
+        joined &= pool->join(deadline);
+
+    return joined;
+}
+
+size_t threadpools::size() const NOEXCEPT
+{
+    return pools_.size();
+}
+
+asio::io_context& threadpools::service() NOEXCEPT
+{
+    BC_ASSERT_MSG(!pools_.empty(), "empty threadpools");
+    const auto index = next_.fetch_add(one, std::memory_order_relaxed);
+    return pools_[index % pools_.size()]->service();
+}
+
+asio::io_context& threadpools::service(size_t index) NOEXCEPT
+{
+    BC_ASSERT_MSG(index < pools_.size(), "invalid threadpool");
+    return pools_[index]->service();
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/async/throttle.hpp>
+
+#include <algorithm>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+throttle::throttle() NOEXCEPT
+  : throttle(zero, {})
+{
+}
+
+throttle::throttle(size_t tokens, const duration& period) NOEXCEPT
+  : limit_(tokens),
+    period_(std::max(period, duration{ one })),
+    tokens_(tokens),
+    updated_(steady_clock::now())
+{
+}
+
+bool throttle::unlimited() const NOEXCEPT
+{
+    return is_zero(limit_);
+}
+
+bool throttle::full(const time_point& now) NOEXCEPT
+{
+    refill(now);
+    return tokens_ == limit_;
+}
+
+bool throttle::consume(size_t tokens, const time_point& now) NOEXCEPT
+{
+    if (unlimited())
+        return true;
+
+    refill(now);
+
+    // Oversized requests drain a full bucket (otherwise never satisfied).
+    if (tokens > limit_ && tokens_ == limit_)
+    {
+        tokens_ = zero;
+        return true;
+    }
+
+    if (tokens > tokens_)
+        return false;
+
+    tokens_ -= tokens;
+    return true;
+}
+
+throttle::duration throttle::delay(size_t tokens,
+    const time_point& now) NOEXCEPT
+{
+    if (unlimited())
+        return {};
+
+    refill(now);
+    const auto needed = std::min(tokens, limit_);
+    if (needed <= tokens_)
+        return {};
+
+    // Ceiling of the time to replenish the deficit.
+    const auto deficit = needed - tokens_;
+    const auto ticks = possible_narrow_sign_cast<size_t>(period_.count());
+    return duration{ possible_narrow_sign_cast<duration::rep>(
+        ceilinged_divide(deficit * ticks, limit_)) };
+}
+
+// private
+// Elapsed time is capped at one period (full), so the product is bounded.
+void throttle::refill(const time_point& now) NOEXCEPT
+{
+    if (unlimited() || now <= updated_)
+        return;
+
+    const auto elapsed = std::min(duration{ now - updated_ }, period_);
+    const auto ticks = possible_narrow_sign_cast<size_t>(elapsed.count());
+    const auto period = possible_narrow_sign_cast<size_t>(period_.count());
+    const auto added = (ticks * limit_) / period;
+
+    if (elapsed == period_ || tokens_ + added >= limit_)
+    {
+        tokens_ = limit_;
+        updated_ = now;
+        return;
+    }
+
+    if (is_zero(added))
+        return;
+
+    // Advance only by the time consumed, retaining the fractional token.
+    tokens_ += added;
+    updated_ += duration{ possible_narrow_sign_cast<duration::rep>(
+        ceilinged_divide(added * period, limit_)) };
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -20,6 +20,7 @@
 
 #include <time.h>
 #include <bitcoin/system.hpp>
+#include <bitcoin/network/async/coarse_clock.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -57,10 +58,10 @@ inline bool zulu_time(tm& out_zulu, time_t time) NOEXCEPT
 // ----------------------------------------------------------------------------
 // BUGBUG: en.wikipedia.org/wiki/Year_2038_problem
 
+// Cached (within a millisecond) while the coarse clock is running.
 time_t zulu_time() NOEXCEPT
 {
-    const auto now = wall_clock::now();
-    return wall_clock::to_time_t(now);
+    return coarse_clock::zulu();
 }
 
 uint32_t unix_time() NOEXCEPT
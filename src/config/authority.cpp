@@ -132,6 +132,11 @@ messages::ip_address authority::to_ip_address() const NOEXCEPT
     return config::to_address(ip());
 }
 
+messages::address_key authority::to_key() const NOEXCEPT
+{
+    return { to_ip_address(), port() };
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/config/subnets.hpp>
+
+#include <algorithm>
+#include <bitcoin/network/config/authority.hpp>
+#include <bitcoin/network/config/utilities.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/system.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace config {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+using namespace system;
+
+// Mapped IPv4 addresses occupy the last four bytes of the ip_address.
+constexpr size_t ipv4_offset = ipv6_size - ipv4_size;
+constexpr size_t ipv4_bits = to_bits(ipv4_size);
+constexpr size_t ipv6_bits = to_bits(ipv6_size);
+
+// Big-endian bit of the address, from the offset byte.
+inline size_t bit(const messages::ip_address& ip, size_t offset,
+    size_t index) NOEXCEPT
+{
+    const auto byte = ip[offset + to_floored_bytes(index)];
+    return (byte >> (sub1(byte_bits) - (index % byte_bits))) & 1u;
+}
+
+// Contructors.
+// ----------------------------------------------------------------------------
+
+subnets::subnets() NOEXCEPT
+{
+}
+
+subnets::subnets(const authorities& values) NOEXCEPT
+{
+    for (const auto& value: values)
+        insert(value.to_ip_address(), value.cidr(), value.port());
+}
+
+subnets::subnets(const prefixes& values) NOEXCEPT
+{
+    for (const auto& value: values)
+        insert(value.ip, value.cidr, zero);
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+size_t subnets::size() const NOEXCEPT
+{
+    return size_;
+}
+
+bool subnets::empty() const NOEXCEPT
+{
+    return is_zero(size_);
+}
+
+// Methods.
+// ----------------------------------------------------------------------------
+
+// O(prefix).
+bool subnets::contains(const messages::address_item& item) const NOEXCEPT
+{
+    return is_v4(item.ip) ?
+        contains(v4_, item.ip, ipv4_offset, ipv4_bits, item.port) :
+        contains(v6_, item.ip, zero, ipv6_bits, item.port);
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Zero cidr is a host (full prefix), an overlong cidr cannot match (skipped).
+void subnets::insert(const messages::ip_address& ip, uint8_t cidr,
+    uint16_t port) NOEXCEPT
+{
+    const auto v4 = is_v4(ip);
+    const auto maximum = v4 ? ipv4_bits : ipv6_bits;
+    const auto offset = v4 ? ipv4_offset : zero;
+    const auto bits = is_zero(cidr) ? maximum : size_t{ cidr };
+
+    if (bits > maximum)
+        return;
+
+    auto& nodes = v4 ? v4_ : v6_;
+    size_t current = zero;
+    for (size_t index = 0; index < bits; ++index)
+    {
+        const auto side = bit(ip, offset, index);
+        if (is_zero(nodes[current].child[side]))
+        {
+            nodes[current].child[side] = possible_narrow_cast<uint32_t>(
+                nodes.size());
+            nodes.push_back({});
+        }
+
+        current = nodes[current].child[side];
+    }
+
+    auto& terminal = nodes[current];
+    if (is_zero(terminal.ports))
+    {
+        terminal.ports = possible_narrow_cast<uint32_t>(ports_.size());
+        ports_.emplace_back();
+    }
+
+    ports_[terminal.ports].push_back(port);
+    ++size_;
+}
+
+// Both non-zero ports must match (zero/non-zero or both zero are matched).
+bool subnets::match(const node& node, uint16_t port) const NOEXCEPT
+{
+    if (is_zero(node.ports))
+        return false;
+
+    const auto& ports = ports_[node.ports];
+    return is_zero(port) || std::any_of(ports.begin(), ports.end(),
+        [port](uint16_t value) NOEXCEPT
+        {
+            return is_zero(value) || value == port;
+        });
+}
+
+bool subnets::contains(const trie& nodes, const messages::ip_address& ip,
+    size_t offset, size_t bits, uint16_t port) const NOEXCEPT
+{
+    size_t current = zero;
+    for (size_t index = 0; index < bits; ++index)
+    {
+        if (match(nodes[current], port))
+            return true;
+
+        current = nodes[current].child[bit(ip, offset, index)];
+        if (is_zero(current))
+            return false;
+    }
+
+    return match(nodes[current], port);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace config
+} // namespace network
+} // namespace libbitcoin
@@ -90,6 +90,8 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { channel_dropped, "channel dropped" },
     { channel_expired, "channel expired" },
     { channel_inactive, "channel inactive" },
+    { channel_congested, "channel congested" },
+    { channel_evicted, "channel evicted" },
     { channel_stopped, "channel stopped" },
     { service_stopped, "service stopped" },
     { subscriber_exists, "subscriber exists" },
@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/aggregator.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/events.hpp>
+#include <bitcoin/network/log/logger.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+constexpr auto prefix = "bitcoin_network_";
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+aggregator::aggregator() NOEXCEPT
+{
+}
+
+void aggregator::subscribe(logger& log) NOEXCEPT
+{
+    log.subscribe_events([this](const code& ec, uint8_t event,
+        uint64_t value, const logger::time&) NOEXCEPT
+    {
+        if (ec)
+            return false;
+
+        record(event, value);
+        return true;
+    });
+}
+
+// Buckets [0..3] are exact, then four per power of two from four.
+size_t aggregator::to_bucket(uint64_t value) NOEXCEPT
+{
+    if (value < linear)
+        return possible_narrow_cast<size_t>(value);
+
+    const auto power = static_cast<size_t>(sub1(std::bit_width(value)));
+    const auto offset = (value >> (power - two)) - linear;
+    return linear + (power - two) * linear +
+        possible_narrow_cast<size_t>(offset);
+}
+
+uint64_t aggregator::to_upper(size_t bucket) NOEXCEPT
+{
+    if (bucket < linear)
+        return bucket;
+
+    const auto power = (bucket - linear) / linear + two;
+    const auto offset = (bucket - linear) % linear;
+    const auto lower = uint64_t{ linear + offset } << (power - two);
+    return lower + sub1(uint64_t{ 1 } << (power - two));
+}
+
+void aggregator::record(uint8_t event, uint64_t value) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (event == events::channel_stop)
+    {
+        ++stops_[value];
+        return;
+    }
+
+    auto& histogram = histograms_[event];
+    ++histogram.count;
+    histogram.sum = ceilinged_add(histogram.sum, value);
+    ++histogram.counts[to_bucket(value)];
+}
+
+uint64_t aggregator::count(uint8_t event) const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (event == events::channel_stop)
+    {
+        uint64_t total{};
+        for (const auto& stop: stops_)
+            total += stop.second;
+
+        return total;
+    }
+
+    const auto it = histograms_.find(event);
+    return it == histograms_.end() ? zero : it->second.count;
+}
+
+uint64_t aggregator::quantile(uint8_t event, double fraction) const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    const auto it = histograms_.find(event);
+    if (it == histograms_.end() || is_zero(it->second.count))
+        return zero;
+
+    const auto& histogram = it->second;
+    const auto clamped = std::clamp(fraction, 0.0, 1.0);
+    const auto rank = std::max<uint64_t>(one, static_cast<uint64_t>(
+        std::ceil(clamped * static_cast<double>(histogram.count))));
+
+    uint64_t cumulative{};
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+    {
+        cumulative += histogram.counts[bucket];
+        if (cumulative >= rank)
+            return to_upper(bucket);
+    }
+
+    return max_uint64;
+}
+
+static std::string to_name(uint8_t event) NOEXCEPT
+{
+    switch (event)
+    {
+        case events::ping_round_trip:
+            return "ping_round_trip_nanoseconds";
+        case events::handshake:
+            return "handshake_nanoseconds";
+        case events::outbound_connect:
+            return "outbound_connects";
+        case events::inbound_accept:
+            return "inbound_accepts";
+        case events::network_queued:
+            return "network_queued_nanoseconds";
+        case events::network_executed:
+            return "network_executed_nanoseconds";
+        case events::channel_queued:
+            return "channel_queued_nanoseconds";
+        case events::channel_executed:
+            return "channel_executed_nanoseconds";
+        default:
+            return "event_" + std::to_string(event);
+    }
+}
+
+static bool is_counter(uint8_t event) NOEXCEPT
+{
+    return event == events::outbound_connect ||
+        event == events::inbound_accept;
+}
+
+// Histogram bounds are at each power of two (less one, as bounds inclusive).
+std::string aggregator::exposition() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    std::ostringstream out{};
+
+    for (const auto& [event, histogram]: histograms_)
+    {
+        const auto name = prefix + to_name(event);
+        if (is_counter(event))
+        {
+            out << "# TYPE " << name << " counter\n"
+                << name << "_total " << histogram.count << "\n";
+            continue;
+        }
+
+        out << "# TYPE " << name << " histogram\n";
+
+        uint64_t cumulative{};
+        for (size_t bucket = 0; bucket < buckets; ++bucket)
+        {
+            cumulative += histogram.counts[bucket];
+            const auto upper = to_upper(bucket);
+            if (is_zero(upper) || (!std::has_single_bit(add1(upper)) &&
+                upper != max_uint64))
+                continue;
+
+            out << name << "_bucket{le=\"" << upper << "\"} "
+                << cumulative << "\n";
+        }
+
+        out << name << "_bucket{le=\"+Inf\"} " << histogram.count << "\n"
+            << name << "_sum " << histogram.sum << "\n"
+            << name << "_count " << histogram.count << "\n";
+    }
+
+    if (!stops_.empty())
+    {
+        const auto name = std::string{ prefix } + "channel_stops";
+        out << "# TYPE " << name << " counter\n";
+        for (const auto& [value, total]: stops_)
+            out << name << "_total{code=\"" << value << "\"} " << total
+                << "\n";
+    }
+
+    return out.str();
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
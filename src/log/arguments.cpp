@@ -0,0 +1,248 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/arguments.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// Tags are followed by 8 byte integers, or by a 2 byte length and content.
+// Codes are a 4 byte value and a 1 byte length category name.
+enum tag : char
+{
+    unsigned_tag = 'u',
+    signed_tag = 'i',
+    text_tag = 's',
+    bytes_tag = 'b',
+    code_tag = 'c'
+};
+
+constexpr size_t integer_size = sizeof(uint64_t);
+constexpr size_t length_size = sizeof(uint16_t);
+constexpr size_t value_size = sizeof(uint32_t);
+
+arguments::arguments() NOEXCEPT
+{
+}
+
+std::string_view arguments::data() const NOEXCEPT
+{
+    return { buffer_.data(), size_ };
+}
+
+// Encoding.
+// ----------------------------------------------------------------------------
+
+bool arguments::reserve(size_t bytes) NOEXCEPT
+{
+    return capacity - size_ >= bytes;
+}
+
+void arguments::put(uint8_t byte) NOEXCEPT
+{
+    buffer_[size_++] = static_cast<char>(byte);
+}
+
+void arguments::put(uint64_t value, size_t bytes) NOEXCEPT
+{
+    for (size_t byte = 0; byte < bytes; ++byte)
+        put(static_cast<uint8_t>(value >> (byte * byte_bits)));
+}
+
+void arguments::put(std::string_view value) NOEXCEPT
+{
+    std::copy(value.begin(), value.end(), std::next(buffer_.begin(), size_));
+    size_ += value.size();
+}
+
+void arguments::add_unsigned(uint64_t value) NOEXCEPT
+{
+    if (!reserve(add1(integer_size)))
+        return;
+
+    put(uint8_t{ unsigned_tag });
+    put(value, integer_size);
+}
+
+void arguments::add_signed(int64_t value) NOEXCEPT
+{
+    if (!reserve(add1(integer_size)))
+        return;
+
+    put(uint8_t{ signed_tag });
+    put(static_cast<uint64_t>(value), integer_size);
+}
+
+void arguments::add_text(std::string_view value) NOEXCEPT
+{
+    if (!reserve(add1(length_size)))
+        return;
+
+    const auto space = capacity - size_ - add1(length_size);
+    const auto size = std::min(value.size(), space);
+    put(uint8_t{ text_tag });
+    put(size, length_size);
+    put(value.substr(zero, size));
+}
+
+void arguments::add_bytes(const data_slice& value) NOEXCEPT
+{
+    if (!reserve(add1(length_size)))
+        return;
+
+    const auto space = capacity - size_ - add1(length_size);
+    const auto size = std::min(value.size(), space);
+    put(uint8_t{ bytes_tag });
+    put(size, length_size);
+    put({ pointer_cast<const char>(value.data()), size });
+}
+
+void arguments::add_code(int value, std::string_view category) NOEXCEPT
+{
+    const auto name = category.substr(zero,
+        std::min(category.size(), size_t{ max_uint8 }));
+
+    if (!reserve(add1(value_size) + add1(name.size())))
+        return;
+
+    put(uint8_t{ code_tag });
+    put(static_cast<uint32_t>(value), value_size);
+    put(possible_narrow_cast<uint8_t>(name.size()));
+    put(name);
+}
+
+// Decoding.
+// ----------------------------------------------------------------------------
+
+// Reads advance the view, returning false if insufficient.
+static bool get(std::string_view& data, uint64_t& out, size_t bytes) NOEXCEPT
+{
+    if (data.size() < bytes)
+        return false;
+
+    out = 0;
+    for (size_t byte = 0; byte < bytes; ++byte)
+        out |= uint64_t{ static_cast<uint8_t>(data[byte]) } <<
+            (byte * byte_bits);
+
+    data.remove_prefix(bytes);
+    return true;
+}
+
+static bool get(std::string_view& data, std::string_view& out,
+    size_t bytes) NOEXCEPT
+{
+    if (data.size() < bytes)
+        return false;
+
+    out = data.substr(zero, bytes);
+    data.remove_prefix(bytes);
+    return true;
+}
+
+// Decode one argument as text, empty if none or invalid (remainder dropped).
+static std::string next(std::string_view& data) NOEXCEPT
+{
+    if (data.empty())
+        return {};
+
+    const auto tag = data.front();
+    data.remove_prefix(one);
+
+    uint64_t value{};
+    std::string_view text{};
+    switch (tag)
+    {
+        case unsigned_tag:
+            if (get(data, value, integer_size))
+                return std::to_string(value);
+            break;
+        case signed_tag:
+            if (get(data, value, integer_size))
+                return std::to_string(static_cast<int64_t>(value));
+            break;
+        case text_tag:
+            if (get(data, value, length_size) && get(data, text, value))
+                return std::string{ text };
+            break;
+        case bytes_tag:
+            if (get(data, value, length_size) && get(data, text, value))
+                return encode_base16({ pointer_cast<const uint8_t>(
+                    text.data()), text.size() });
+            break;
+        case code_tag:
+        {
+            uint64_t size{};
+            if (get(data, value, value_size) && get(data, size, one) &&
+                get(data, text, size))
+            {
+                const auto number = static_cast<int>(value);
+                const code ec{ error::error_t{} };
+                if (text == ec.category().name())
+                    return code{ static_cast<error::error_t>(number) }
+                        .message();
+
+                return std::string{ text } + ":" + std::to_string(number);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    data = {};
+    return {};
+}
+
+std::string arguments::format(const char* pattern,
+    std::string_view data) NOEXCEPT
+{
+    constexpr std::string_view placeholder{ "{}" };
+    const std::string_view text{ pattern };
+
+    std::string out{};
+    size_t start{};
+    for (auto at = text.find(placeholder); at != std::string_view::npos;
+        at = text.find(placeholder, start))
+    {
+        out.append(text.substr(start, at - start));
+        out.append(next(data));
+        start = at + placeholder.size();
+    }
+
+    out.append(text.substr(start));
+    return out;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
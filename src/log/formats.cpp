@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/formats.hpp>
+
+#include <array>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace formats {
+
+constexpr std::array patterns
+{
+    "{}",
+    "Invalid {} payload from [{}] ({}) {}",
+    "Invalid heading magic (0x{}) from [{}]"
+};
+
+const char* to_pattern(uint16_t format) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+    return format < patterns.size() ? patterns[format] : "";
+    BC_POP_WARNING()
+}
+
+} // namespace formats
+} // namespace network
+} // namespace libbitcoin
@@ -20,6 +20,8 @@
 
 #include <utility>
 #include <bitcoin/system.hpp>
+#include <bitcoin/network/log/arguments.hpp>
+#include <bitcoin/network/log/formats.hpp>
 #include <bitcoin/network/log/levels.hpp>
 #include <bitcoin/network/log/timer.hpp>
 #include <bitcoin/network/async/async.hpp>
@@ -50,6 +52,32 @@ logger::writer logger::write(uint8_t level) const NOEXCEPT
     return { *this, level };
 }
 
+// levels
+// ----------------------------------------------------------------------------
+// Relaxed ordering, a level change need not be immediately visible.
+
+void logger::enable(uint8_t level, bool value) NOEXCEPT
+{
+    if (level >= mask_bits)
+        return;
+
+    const auto bit = uint32_t{ 1 } << level;
+    if (value)
+        mask_.fetch_or(bit, std::memory_order_relaxed);
+    else
+        mask_.fetch_and(~bit, std::memory_order_relaxed);
+}
+
+void logger::set_mask(uint32_t mask) NOEXCEPT
+{
+    mask_.store(mask, std::memory_order_relaxed);
+}
+
+uint32_t logger::mask() const NOEXCEPT
+{
+    return mask_.load(std::memory_order_relaxed);
+}
+
 bool logger::stranded() const NOEXCEPT
 {
     return strand_.running_in_this_thread();
@@ -87,6 +115,9 @@ void logger::do_stop(const code& ec, time_t zulu, const std::string& message,
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
+    // Deliver queued messages ahead of the final message.
+    drain();
+
     // Subscriber asserts if stopped with a success code.
     message_subscriber_.stop(ec, level, zulu, message);
     event_subscriber_.stop(ec, {}, {}, {});
@@ -100,11 +131,35 @@ void logger::do_stop(const code& ec, time_t zulu, const std::string& message,
 
 // protected
 void logger::notify(const code& ec, uint8_t level,
-    std::string&& message) const NOEXCEPT
+    std::string_view message) const NOEXCEPT
 {
-    boost::asio::post(strand_,
-        std::bind(&logger::do_notify_message, this, ec, level, zulu_time(),
-            std::move(message)));
+    // Coded messages are not queued, but are delivered after those queued.
+    if (ec)
+    {
+        boost::asio::post(strand_,
+            std::bind(&logger::do_notify_message, this, ec, level,
+                zulu_time(), std::string{ message }));
+        return;
+    }
+
+    // Writers obtained directly (not by macro) are filtered here.
+    if (!enabled(level))
+        return;
+
+    notify(level, formats::text, message);
+}
+
+// protected
+void logger::notify(uint8_t level, uint16_t format,
+    std::string_view data) const NOEXCEPT
+{
+    if (!records_.push(level, zulu_time(), data, format))
+        return;
+
+    // Only the first message pushed after a drain starts posts a drain.
+    if (!draining_.exchange(true))
+        boost::asio::post(strand_,
+            std::bind(&logger::do_drain, this));
 }
 
 // private
@@ -112,9 +167,39 @@ void logger::do_notify_message(const code& ec, uint8_t level, time_t zulu,
     const std::string& message) const NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    drain();
     message_subscriber_.notify(ec, level, zulu, message);
 }
 
+// private
+void logger::do_drain() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Cleared before draining, so a message pushed after is not stranded.
+    draining_.store(false);
+    drain();
+}
+
+// private
+void logger::drain() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Binary records are formatted here, off of the writing thread.
+    record_queue::record record{};
+    while (records_.pop(record))
+        message_subscriber_.notify(error::success, record.level, record.zulu,
+            record.format == formats::text ? std::string{ record.view() } :
+            arguments::format(formats::to_pattern(record.format),
+                record.view()));
+}
+
+size_t logger::dropped() const NOEXCEPT
+{
+    return records_.dropped();
+}
+
 void logger::subscribe_messages(message_notifier&& handler) NOEXCEPT
 {
     if (stopped_.load())
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/probe.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+struct counters
+{
+    std::atomic<uint64_t> count{};
+    std::atomic<uint64_t> total{};
+    std::array<std::atomic<uint64_t>, probes::bucket_count> buckets{};
+};
+
+typedef std::array<counters, probes::points> thread_counters;
+
+static constexpr std::array<std::string_view, probes::points> names
+{
+    "proxy_deserialize",
+    "distributor_notify",
+    "messages_serialize",
+    "hosts_save",
+    "session_start",
+    "session_handshake",
+    "session_channel_started",
+    "session_channel_stopped"
+};
+
+// Thread counters are retained for the process, as a snapshot may follow the
+// exit of a recording thread (bounded by the number of threads created).
+static std::mutex& registry_mutex() NOEXCEPT
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+static std::vector<std::unique_ptr<thread_counters>>& registry() NOEXCEPT
+{
+    static std::vector<std::unique_ptr<thread_counters>> threads{};
+    return threads;
+}
+
+static thread_counters& local() NOEXCEPT
+{
+    thread_local thread_counters* this_thread{};
+    if (is_null(this_thread))
+    {
+        std::unique_lock lock(registry_mutex());
+        registry().push_back(std::make_unique<thread_counters>());
+        this_thread = registry().back().get();
+    }
+
+    return *this_thread;
+}
+
+// Single writer, so increments need not be atomic read-modify-write.
+static inline void increment(std::atomic<uint64_t>& value,
+    uint64_t amount) NOEXCEPT
+{
+    value.store(value.load(std::memory_order_relaxed) + amount,
+        std::memory_order_relaxed);
+}
+
+void probes::record(probe_point point, const nanoseconds& elapsed) NOEXCEPT
+{
+    const auto value = static_cast<uint64_t>(
+        std::max(elapsed.count(), nanoseconds::rep{}));
+    const auto bucket = std::min(sub1(bucket_count),
+        static_cast<size_t>(std::bit_width(value)));
+
+    auto& point_counters = local().at(static_cast<size_t>(point));
+    increment(point_counters.count, one);
+    increment(point_counters.total, value);
+    increment(point_counters.buckets.at(bucket), one);
+}
+
+probes::profile probes::snapshot() NOEXCEPT
+{
+    profile out{};
+    std::unique_lock lock(registry_mutex());
+
+    for (const auto& thread: registry())
+    {
+        for (size_t point = 0; point < points; ++point)
+        {
+            const auto& from = thread->at(point);
+            auto& to = out.at(point);
+            to.count += from.count.load(std::memory_order_relaxed);
+            to.total += from.total.load(std::memory_order_relaxed);
+
+            for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+                to.buckets.at(bucket) +=
+                    from.buckets.at(bucket).load(std::memory_order_relaxed);
+        }
+    }
+
+    return out;
+}
+
+std::string_view probes::name(probe_point point) NOEXCEPT
+{
+    const auto index = static_cast<size_t>(point);
+    return index < points ? names.at(index) : std::string_view{};
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/record_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <string_view>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+std::string_view record_queue::record::view() const NOEXCEPT
+{
+    return { text.data(), size };
+}
+
+// Cells are allocated once, each sequence is initialized to its index.
+record_queue::record_queue(size_t capacity) NOEXCEPT
+  : mask_(sub1(std::bit_ceil(std::max(capacity, two)))),
+    cells_(std::make_unique<cell[]>(add1(mask_)))
+{
+    for (size_t index = 0; index <= mask_; ++index)
+        cells_[index].sequence.store(index, std::memory_order_relaxed);
+}
+
+// A cell is free to a producer when its sequence equals the position, and
+// is ready for the consumer when its sequence equals the position plus one.
+bool record_queue::push(uint8_t level, time_t zulu, std::string_view text,
+    uint16_t format) NOEXCEPT
+{
+    auto position = tail_.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto& cell = cells_[position & mask_];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<intptr_t>(sequence) -
+            static_cast<intptr_t>(position);
+
+        if (is_zero(difference))
+        {
+            if (tail_.compare_exchange_weak(position, add1(position),
+                std::memory_order_relaxed))
+            {
+                const auto size = std::min(text.size(), text_size);
+                cell.value.level = level;
+                cell.value.format = format;
+                cell.value.zulu = zulu;
+                cell.value.size = size;
+                std::copy_n(text.begin(), size, cell.value.text.begin());
+                cell.sequence.store(add1(position), std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            dropped_.fetch_add(one, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool record_queue::pop(record& out) NOEXCEPT
+{
+    auto& cell = cells_[head_ & mask_];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != add1(head_))
+        return false;
+
+    out = cell.value;
+    cell.sequence.store(head_ + add1(mask_), std::memory_order_release);
+    ++head_;
+    return true;
+}
+
+size_t record_queue::dropped() const NOEXCEPT
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+size_t record_queue::capacity() const NOEXCEPT
+{
+    return add1(mask_);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/tracer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/time.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// The mutex of a ring is contended only by snapshot and clear.
+struct ring
+{
+    std::mutex mutex{};
+    std::array<traces::event, traces::capacity> events{};
+    uint64_t written{};
+    uint32_t thread{};
+};
+
+static constexpr std::array<std::string_view, traces::points> names
+{
+    "channel",
+    "handshake",
+    "protocols",
+    "message",
+    "deserialize",
+    "dispatch"
+};
+
+static std::atomic_bool& recording() NOEXCEPT
+{
+    static std::atomic_bool enabled{ false };
+    return enabled;
+}
+
+// Thread rings are retained for the process, as a snapshot may follow the
+// exit of a recording thread (bounded by the number of threads created).
+static std::mutex& registry_mutex() NOEXCEPT
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+static std::vector<std::unique_ptr<ring>>& registry() NOEXCEPT
+{
+    static std::vector<std::unique_ptr<ring>> threads{};
+    return threads;
+}
+
+static ring& local() NOEXCEPT
+{
+    thread_local ring* this_thread{};
+    if (is_null(this_thread))
+    {
+        std::unique_lock lock(registry_mutex());
+        registry().push_back(std::make_unique<ring>());
+        this_thread = registry().back().get();
+        this_thread->thread = possible_narrow_cast<uint32_t>(
+            registry().size());
+    }
+
+    return *this_thread;
+}
+
+static char to_phase(traces::phase phase) NOEXCEPT
+{
+    switch (phase)
+    {
+        case traces::phase::begin:
+            return 'b';
+        case traces::phase::end:
+            return 'e';
+        default:
+            return 'n';
+    }
+}
+
+void traces::enable(bool value) NOEXCEPT
+{
+    recording().store(value, std::memory_order_relaxed);
+}
+
+bool traces::enabled() NOEXCEPT
+{
+    return recording().load(std::memory_order_relaxed);
+}
+
+void traces::record(trace_point point, phase phase, uint64_t id) NOEXCEPT
+{
+    if (!enabled() || point >= trace_point::count)
+        return;
+
+    const auto time = static_cast<uint64_t>(
+        std::chrono::duration_cast<nanoseconds>(
+            fine_clock::now().time_since_epoch()).count());
+
+    auto& thread = local();
+    std::unique_lock lock(thread.mutex);
+    thread.events.at(thread.written++ % capacity) =
+    {
+        time, id, thread.thread, point, phase
+    };
+}
+
+traces::events traces::snapshot() NOEXCEPT
+{
+    events out{};
+    std::unique_lock lock(registry_mutex());
+
+    for (const auto& thread: registry())
+    {
+        std::unique_lock thread_lock(thread->mutex);
+        const auto count = std::min<uint64_t>(thread->written, capacity);
+        for (auto index = thread->written - count; index < thread->written;
+            ++index)
+            out.push_back(thread->events.at(index % capacity));
+    }
+
+    std::stable_sort(out.begin(), out.end(),
+        [](const event& left, const event& right) NOEXCEPT
+        {
+            return left.time < right.time;
+        });
+
+    return out;
+}
+
+void traces::clear() NOEXCEPT
+{
+    std::unique_lock lock(registry_mutex());
+
+    for (const auto& thread: registry())
+    {
+        std::unique_lock thread_lock(thread->mutex);
+        thread->written = zero;
+    }
+}
+
+// chromium.org/developers/how-tos/trace-event-profiling-tool
+// Timestamps are microseconds (with nanosecond fraction) from the first event.
+bool traces::write(std::ostream& out, const events& values) NOEXCEPT
+{
+    const auto start = values.empty() ? uint64_t{} : values.front().time;
+    const auto fill = out.fill();
+    auto first = true;
+
+    out << "{\"traceEvents\":[";
+    for (const auto& value: values)
+    {
+        const auto time = floored_subtract(value.time, start);
+        out << (first ? "\n" : ",\n")
+            << "{\"name\":\"" << name(value.point) << "\""
+            << ",\"cat\":\"network\""
+            << ",\"ph\":\"" << to_phase(value.phase) << "\""
+            << ",\"id\":\"" << value.id << "\""
+            << ",\"pid\":0"
+            << ",\"tid\":" << value.thread
+            << ",\"ts\":" << (time / 1'000u) << "."
+            << std::setw(3) << std::setfill('0') << (time % 1'000u)
+            << std::setfill(fill) << "}";
+
+        first = false;
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    out.flush();
+    return out.good();
+}
+
+std::string_view traces::name(trace_point point) NOEXCEPT
+{
+    const auto index = static_cast<size_t>(point);
+    return index < points ? names.at(index) : std::string_view{};
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
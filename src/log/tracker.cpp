@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/log/tracker.hpp>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+struct enrollment
+{
+    const char* name;
+    const census::counter* count;
+};
+
+// Enrollment is during static initialization, so the registry is a local
+// static (initialized upon first use, regardless of translation unit order).
+static std::mutex& registry_mutex() NOEXCEPT
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+static std::vector<enrollment>& registry() NOEXCEPT
+{
+    static std::vector<enrollment> classes{};
+    return classes;
+}
+
+bool census::enroll(const char* name, const counter& count) NOEXCEPT
+{
+    std::unique_lock lock(registry_mutex());
+    registry().push_back({ name, &count });
+    return true;
+}
+
+census::entries census::snapshot() NOEXCEPT
+{
+    std::unique_lock lock(registry_mutex());
+    entries out{};
+    out.reserve(registry().size());
+
+    for (const auto& item: registry())
+        out.push_back({ item.name, item.count->load(
+            std::memory_order_relaxed) });
+
+    return out;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -50,19 +50,26 @@ typename address::cptr address::deserialize(uint32_t version,
 
 // static
 address address::deserialize(uint32_t version, system::reader& source) NOEXCEPT
+{
+    address out{};
+    deserialize(version, source, out);
+    return out;
+}
+
+// static
+void address::deserialize(uint32_t version, system::reader& source,
+    address& out) NOEXCEPT
 {
     if (version < version_minimum || version > version_maximum)
         source.invalidate();
 
     const auto size = source.read_size(max_address);
-    address_items addresses;
-    addresses.reserve(size);
+    out.addresses.clear();
+    out.addresses.reserve(size);
 
     for (size_t address = 0; address < size; ++address)
-        addresses.push_back(address_item::deserialize(version, source,
+        out.addresses.push_back(address_item::deserialize(version, source,
             with_timestamp));
-
-    return { addresses };
 }
 
 bool address::serialize(uint32_t version,
@@ -18,6 +18,8 @@
  */
 #include <bitcoin/network/messages/block.hpp>
 
+#include <iterator>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/messages/enums/identifier.hpp>
 #include <bitcoin/network/messages/enums/level.hpp>
@@ -44,14 +46,64 @@ typename block::cptr block::deserialize(uint32_t version,
     if (!reader)
         return nullptr;
 
-    // TODO: cache hashes for all transactions as well,
-    // TODO: using transaction::desegregated_hash(data, size).
-    constexpr auto size = chain::header::serialized_size();
-    const auto& header = message->block_ptr->header();
-    header.set_hash(bitcoin_hash(size, data.data()));
+    set_hashes(*message->block_ptr, data);
     return message;
 }
 
+// static
+void block::set_hashes(const chain::block& block,
+    const data_chunk& data) NOEXCEPT
+{
+    constexpr auto size = chain::header::serialized_size();
+    block.header().set_hash(bitcoin_hash(size, data.data()));
+
+    // Transactions end the data, each of its serialized size (the count is
+    // not assumed to be minimally encoded).
+    const auto& txs = *block.transactions_ptr();
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::vector<data_slice> slices{};
+    std::vector<size_t> sizes{};
+    slices.reserve(txs.size());
+    sizes.reserve(txs.size());
+
+    size_t total{};
+    for (const auto& tx: txs)
+    {
+        total += tx->serialized_size(true);
+        sizes.push_back(tx->serialized_size(false));
+    }
+
+    auto at = std::prev(data.end(), total);
+    for (const auto& tx: txs)
+    {
+        const auto end = std::next(at, tx->serialized_size(true));
+        slices.emplace_back(at, end);
+        at = end;
+    }
+    BC_POP_WARNING()
+
+    const auto hashes = transaction::desegregated_hashes(slices, sizes);
+    for (size_t index = 0; index < txs.size(); ++index)
+        txs.at(index)->set_hash(hashes.at(index));
+}
+
+// static
+typename block::cptr block::deserialize(uint32_t version,
+    const system::chunk_ptr& data, bool witness,
+    const system::hash_cptr& hash) NOEXCEPT
+{
+    if (!data)
+        return nullptr;
+
+    const auto message = deserialize(version, *data, witness);
+    if (!message)
+        return nullptr;
+
+    // The payload is shared with the proxy, which will not reuse it.
+    return to_shared(block{ message->block_ptr, data, hash });
+}
+
 // static
 block block::deserialize(uint32_t version, reader& source,
     bool witness) NOEXCEPT
@@ -70,13 +122,16 @@ bool block::serialize(uint32_t version,
     return writer;
 }
 
-void block::serialize(uint32_t BC_DEBUG_ONLY(version), writer& sink,
+void block::serialize(uint32_t version, writer& sink,
     bool witness) const NOEXCEPT
 {
-    BC_DEBUG_ONLY(const auto bytes = size(version, witness);)
+    const auto bytes = size(version, witness);
     BC_DEBUG_ONLY(const auto start = sink.get_write_position();)
 
-    if (block_ptr)
+    // Retained encoding is of the requested witness-ness if sizes match.
+    if (payload_ptr && payload_ptr->size() == bytes)
+        sink.write_bytes(*payload_ptr);
+    else if (block_ptr)
         block_ptr->to_data(sink, witness);
 
     BC_ASSERT(sink && sink.get_write_position() - start == bytes);
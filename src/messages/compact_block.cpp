@@ -115,6 +115,62 @@ void compact_block::serialize(uint32_t version, writer& sink,
     BC_ASSERT(sink && sink.get_write_position() - start == bytes);
 }
 
+// static
+siphash_key compact_block::to_key(const chain::header& header,
+    uint64_t nonce) NOEXCEPT
+{
+    data_chunk data(chain::header::serialized_size() + sizeof(uint64_t));
+    write::bytes::copy writer(data);
+    header.to_data(writer);
+    writer.write_8_bytes_little_endian(nonce);
+
+    const auto hash = sha256_hash(data);
+    siphash_key key{};
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+    {
+        key.k0 |= uint64_t{ hash.at(byte) } << to_bits(byte);
+        key.k1 |= uint64_t{ hash.at(byte + sizeof(uint64_t)) } <<
+            to_bits(byte);
+    }
+
+    return key;
+}
+
+// static
+uint64_t compact_block::to_short_id(const siphash_key& key,
+    const hash_digest& hash) NOEXCEPT
+{
+    constexpr auto mask = 0x0000ffffffffffff_u64;
+    return siphash(key, hash) & mask;
+}
+
+// static
+std::vector<uint64_t> compact_block::to_short_ids(const siphash_key& key,
+    const hashes& hashes) NOEXCEPT
+{
+    constexpr auto mask = 0x0000ffffffffffff_u64;
+    auto ids = siphash(key, hashes);
+    for (auto& id: ids)
+        id &= mask;
+
+    return ids;
+}
+
+// static
+uint64_t compact_block::to_number(const short_id& id) NOEXCEPT
+{
+    uint64_t value{};
+    for (size_t byte = 0; byte < mini_hash_size; ++byte)
+        value |= uint64_t{ id.at(byte) } << to_bits(byte);
+
+    return value;
+}
+
+siphash_key compact_block::key() const NOEXCEPT
+{
+    return header_ptr ? to_key(*header_ptr, nonce) : siphash_key{};
+}
+
 size_t compact_block::size(uint32_t version, bool witness) const NOEXCEPT
 {
     const auto txs_sizes = [=](size_t total,
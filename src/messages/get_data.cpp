@@ -49,18 +49,25 @@ typename get_data::cptr get_data::deserialize(uint32_t version,
 
 // static
 get_data get_data::deserialize(uint32_t version, reader& source) NOEXCEPT
+{
+    get_data get;
+    deserialize(version, source, get);
+    return get;
+}
+
+// static
+void get_data::deserialize(uint32_t version, reader& source,
+    get_data& out) NOEXCEPT
 {
     if (version < version_minimum || version > version_maximum)
         source.invalidate();
 
     const auto size = source.read_size(max_inventory);
-    get_data get;
-    get.items.reserve(size);
+    out.items.clear();
+    out.items.reserve(size);
 
     for (size_t item = 0; item < size; ++item)
-        get.items.push_back(inventory_item::deserialize(version, source));
-
-    return get;
+        out.items.push_back(inventory_item::deserialize(version, source));
 }
 
 bool get_data::serialize(uint32_t version,
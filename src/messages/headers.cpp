@@ -19,12 +19,16 @@
 #include <bitcoin/network/messages/headers.hpp>
 
 #include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/messages/enums/identifier.hpp>
 #include <bitcoin/network/messages/enums/level.hpp>
 #include <bitcoin/network/messages/enums/magic_numbers.hpp>
 #include <bitcoin/network/messages/inventory_item.hpp>
 #include <bitcoin/network/messages/message.hpp>
+#include <bitcoin/network/net/payload_hash.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -49,16 +53,38 @@ typename headers::cptr headers::deserialize(uint32_t version,
     if (!reader)
         return nullptr;
 
+    const auto digests = hash(data);
+    auto digest = digests.begin();
+    for (const auto& header: message->header_ptrs)
+        header->set_hash(*digest++);
+
+    return message;
+}
+
+// static
+// Headers are of uniform size, so fill all lanes of each batch group.
+hashes headers::hash(const data_slice& data) NOEXCEPT
+{
+    if (data.empty())
+        return {};
+
     constexpr auto size = chain::header::serialized_size();
-    auto hash = std::next(data.data(), size_variable(data.front()));
+    const auto start = size_variable(data.front());
+    const auto count = (data.size() - start) / add1(size);
 
-    for (const auto& header: message->header_ptrs)
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::vector<data_slice> slices{};
+    slices.reserve(count);
+
+    auto header = std::next(data.data(), start);
+    for (size_t index = 0; index < count; ++index)
     {
-        header->set_hash(bitcoin_hash(size, hash));
-        std::advance(hash, add1(size));
+        slices.emplace_back(header, std::next(header, size));
+        std::advance(header, add1(size));
     }
+    BC_POP_WARNING()
 
-    return message;
+    return payload_hash::batch(slices);
 }
 
 // static
@@ -68,22 +94,27 @@ headers headers::deserialize(uint32_t version, reader& source) NOEXCEPT
         source.invalidate();
 
     const auto size = source.read_size(max_get_headers);
-    chain::header_cptrs header_ptrs{};
-    header_ptrs.reserve(size);
+
+    // One arena allocation for all headers, each pointer aliases the arena.
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    const auto arena = std::make_shared<std::vector<chain::header>>();
+    arena->reserve(size);
 
     for (size_t header = 0; header < size; ++header)
     {
-        BC_PUSH_WARNING(NO_NEW_OR_DELETE)
-        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-        header_ptrs.emplace_back(new chain::header{ source });
-        BC_POP_WARNING()
-        BC_POP_WARNING()
+        arena->emplace_back(source);
 
         if (source.read_byte() != trail)
             source.invalidate();
     }
 
-    return { header_ptrs };
+    chain::header_cptrs header_ptrs{};
+    header_ptrs.reserve(arena->size());
+    for (const auto& header: *arena)
+        header_ptrs.emplace_back(arena, &header);
+    BC_POP_WARNING()
+
+    return { std::move(header_ptrs) };
 }
 
 bool headers::serialize(uint32_t version,
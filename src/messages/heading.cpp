@@ -18,7 +18,9 @@
  */
 #include <bitcoin/network/messages/heading.hpp>
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/messages/address.hpp>
 #include <bitcoin/network/messages/alert.hpp>
@@ -49,12 +51,18 @@
 #include <bitcoin/network/messages/not_found.hpp>
 #include <bitcoin/network/messages/ping.hpp>
 #include <bitcoin/network/messages/pong.hpp>
+#include <bitcoin/network/messages/reconciliation_difference.hpp>
+#include <bitcoin/network/messages/reconciliation_sketch.hpp>
 #include <bitcoin/network/messages/reject.hpp>
+#include <bitcoin/network/messages/request_reconciliation.hpp>
+#include <bitcoin/network/messages/request_sketch_extension.hpp>
 #include <bitcoin/network/messages/send_compact.hpp>
 #include <bitcoin/network/messages/send_headers.hpp>
+#include <bitcoin/network/messages/send_reconciliation.hpp>
 #include <bitcoin/network/messages/transaction.hpp>
 #include <bitcoin/network/messages/version_acknowledge.hpp>
 #include <bitcoin/network/messages/version.hpp>
+#include <bitcoin/network/messages/wtxid_relay.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -79,6 +87,112 @@ using namespace system;
 // with witness-enabled block size (4,000,000).
 // This calculation should be revisited given any protocol change.
 
+// Fixed size and list bounded messages are limited by their own maximal
+// serialization. The version user agent is bounded by its parser (max_uint8
+// characters), and its addresses are address items without timestamp.
+constexpr size_t address_item_size = 30;
+constexpr size_t header_item_size = 81;
+constexpr size_t inventory_item_size = sizeof(uint32_t) + hash_size;
+constexpr size_t version_size = sizeof(uint32_t) + sizeof(uint64_t) +
+    sizeof(uint64_t) + two * (address_item_size - sizeof(uint32_t)) +
+    sizeof(uint64_t) +
+    variable_size(max_uint8) + max_uint8 + sizeof(uint32_t) + sizeof(uint8_t);
+
+// static
+size_t heading::maximum_payload(identifier id, size_t limit) NOEXCEPT
+{
+    const auto bound = [=](size_t maximum) NOEXCEPT
+    {
+        return std::min(maximum, limit);
+    };
+
+    switch (id)
+    {
+        case identifier::bloom_filter_clear:
+        case identifier::get_address:
+        case identifier::memory_pool:
+        case identifier::request_sketch_extension:
+        case identifier::send_headers:
+        case identifier::version_acknowledge:
+        case identifier::wtxid_relay:
+            return zero;
+        case identifier::fee_filter:
+        case identifier::ping:
+        case identifier::pong:
+            return bound(sizeof(uint64_t));
+        case identifier::request_reconciliation:
+            return bound(sizeof(uint16_t) + sizeof(uint16_t));
+        case identifier::send_compact:
+            return bound(sizeof(uint8_t) + sizeof(uint64_t));
+        case identifier::send_reconciliation:
+            return bound(sizeof(uint32_t) + sizeof(uint64_t));
+        case identifier::get_client_filter_checkpoint:
+            return bound(sizeof(uint8_t) + hash_size);
+        case identifier::get_client_filter_headers:
+        case identifier::get_client_filters:
+            return bound(sizeof(uint8_t) + sizeof(uint32_t) + hash_size);
+        case identifier::version:
+            return bound(version_size);
+        case identifier::bloom_filter_add:
+            return bound(variable_size(max_bloom_filter_add) +
+                max_bloom_filter_add);
+        case identifier::bloom_filter_load:
+            return bound(variable_size(max_bloom_filter_load) +
+                max_bloom_filter_load + sizeof(uint32_t) + sizeof(uint32_t) +
+                sizeof(uint8_t));
+        case identifier::address:
+            return bound(variable_size(max_address) +
+                max_address * address_item_size);
+        case identifier::get_blocks:
+        case identifier::get_headers:
+            return bound(sizeof(uint32_t) + variable_size(max_get_headers) +
+                max_get_headers * hash_size + hash_size);
+        case identifier::headers:
+            return bound(variable_size(max_get_headers) +
+                max_get_headers * header_item_size);
+        case identifier::reconciliation_sketch:
+            return bound(variable_size(max_sketch_capacity) +
+                max_sketch_capacity * sizeof(uint32_t));
+        case identifier::reconciliation_difference:
+            return bound(sizeof(uint8_t) + variable_size(max_sketch_capacity) +
+                max_sketch_capacity * sizeof(uint32_t));
+        case identifier::get_data:
+        case identifier::inventory:
+        case identifier::not_found:
+            return bound(variable_size(max_inventory) +
+                max_inventory * inventory_item_size);
+        default:
+            return limit;
+    }
+}
+
+// static
+// Elements are fixed size, so the count determines the payload size.
+bool heading::prescan(identifier id, const data_slice& payload) NOEXCEPT
+{
+    const auto scan = [&](size_t maximum, size_t element) NOEXCEPT
+    {
+        read::bytes::copy source(payload);
+        const auto count = source.read_size(maximum);
+        return source && (count * element ==
+            payload.size() - source.get_read_position());
+    };
+
+    switch (id)
+    {
+        case identifier::address:
+            return scan(max_address, address_item_size);
+        case identifier::headers:
+            return scan(max_get_headers, header_item_size);
+        case identifier::get_data:
+        case identifier::inventory:
+        case identifier::not_found:
+            return scan(max_inventory, inventory_item_size);
+        default:
+            return true;
+    }
+}
+
 // static
 // Logging utility only.
 std::string heading::get_command(const data_chunk& payload) NOEXCEPT
@@ -156,54 +270,128 @@ void heading::serialize(writer& sink) const NOEXCEPT
     sink.write_4_bytes_little_endian(checksum);
 }
 
-#define COMMAND_ID(name) { name::command, name::id }
+bool fixed_heading::deserialize(reader& source) NOEXCEPT
+{
+    magic = source.read_4_bytes_little_endian();
+    command = source.read_forward<command_size>();
+    payload_size = source.read_4_bytes_little_endian();
+    checksum = source.read_4_bytes_little_endian();
+    id = heading::id(command);
+    return source;
+}
+
+// Logging utility only.
+std::string fixed_heading::command_text() const NOEXCEPT
+{
+    const auto end = std::find(command.begin(), command.end(), 0x00);
+    return { command.begin(), end };
+}
+
+// Commands are nul-padded to 12 bytes, packed here into integral keys so that
+// lookup is a small number of integer comparisons (no string compares).
+typedef std::pair<uint64_t, uint32_t> command_key;
+typedef std::pair<command_key, identifier> command_entry;
+
+static command_key to_key(const data_slice& command) NOEXCEPT
+{
+    uint64_t low{};
+    uint32_t high{};
+    size_t byte{};
+
+    // The command is terminated by the first nul, as with read_string_buffer.
+    for (const auto character: command)
+    {
+        if (character == 0x00 || byte == heading::command_size)
+            break;
+
+        if (byte < sizeof(uint64_t))
+            low |= static_cast<uint64_t>(character) << to_bits(byte);
+        else
+            high |= static_cast<uint32_t>(character) <<
+                to_bits(byte - sizeof(uint64_t));
+
+        ++byte;
+    }
+
+    return { low, high };
+}
+
+#define COMMAND_ID(name) command_entry{ to_key(name::command), name::id }
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-identifier heading::id() const NOEXCEPT
+
+// static
+identifier heading::id(const data_slice& command) NOEXCEPT
 {
     // Internal to function avoids static initialization race.
-    static const std::map<std::string, identifier> identifiers
+    static const auto identifiers = []() NOEXCEPT
     {
-        COMMAND_ID(address),
-        COMMAND_ID(alert),
-        COMMAND_ID(block),
-        COMMAND_ID(bloom_filter_add),
-        COMMAND_ID(bloom_filter_clear),
-        COMMAND_ID(bloom_filter_load),
-        COMMAND_ID(client_filter),
-        COMMAND_ID(client_filter_checkpoint),
-        COMMAND_ID(client_filter_headers),
-        COMMAND_ID(compact_block),
-        COMMAND_ID(compact_transactions),
-        COMMAND_ID(fee_filter),
-        COMMAND_ID(get_address),
-        COMMAND_ID(get_blocks),
-        COMMAND_ID(get_client_filter_checkpoint),
-        COMMAND_ID(get_client_filter_headers),
-        COMMAND_ID(get_client_filters),
-        COMMAND_ID(get_compact_transactions),
-        COMMAND_ID(get_data),
-        COMMAND_ID(get_headers),
-        COMMAND_ID(headers),
-        COMMAND_ID(inventory),
-        COMMAND_ID(memory_pool),
-        COMMAND_ID(merkle_block),
-        COMMAND_ID(not_found),
-        COMMAND_ID(ping),
-        COMMAND_ID(pong),
-        COMMAND_ID(reject),
-        COMMAND_ID(send_compact),
-        COMMAND_ID(send_headers),
-        COMMAND_ID(transaction),
-        COMMAND_ID(version),
-        COMMAND_ID(version_acknowledge)
-    };
+        std::array<command_entry, 39> table
+        {
+            COMMAND_ID(address),
+            COMMAND_ID(alert),
+            COMMAND_ID(block),
+            COMMAND_ID(bloom_filter_add),
+            COMMAND_ID(bloom_filter_clear),
+            COMMAND_ID(bloom_filter_load),
+            COMMAND_ID(client_filter),
+            COMMAND_ID(client_filter_checkpoint),
+            COMMAND_ID(client_filter_headers),
+            COMMAND_ID(compact_block),
+            COMMAND_ID(compact_transactions),
+            COMMAND_ID(fee_filter),
+            COMMAND_ID(get_address),
+            COMMAND_ID(get_blocks),
+            COMMAND_ID(get_client_filter_checkpoint),
+            COMMAND_ID(get_client_filter_headers),
+            COMMAND_ID(get_client_filters),
+            COMMAND_ID(get_compact_transactions),
+            COMMAND_ID(get_data),
+            COMMAND_ID(get_headers),
+            COMMAND_ID(headers),
+            COMMAND_ID(inventory),
+            COMMAND_ID(memory_pool),
+            COMMAND_ID(merkle_block),
+            COMMAND_ID(not_found),
+            COMMAND_ID(ping),
+            COMMAND_ID(pong),
+            COMMAND_ID(reconciliation_difference),
+            COMMAND_ID(reconciliation_sketch),
+            COMMAND_ID(reject),
+            COMMAND_ID(request_reconciliation),
+            COMMAND_ID(request_sketch_extension),
+            COMMAND_ID(send_compact),
+            COMMAND_ID(send_headers),
+            COMMAND_ID(send_reconciliation),
+            COMMAND_ID(transaction),
+            COMMAND_ID(version),
+            COMMAND_ID(version_acknowledge),
+            COMMAND_ID(wtxid_relay)
+        };
+
+        std::sort(table.begin(), table.end());
+        return table;
+    }();
+
+    // Binary search over 39 integral keys (at most six comparisons).
+    const auto key = to_key(command);
+    const auto it = std::lower_bound(identifiers.begin(), identifiers.end(),
+        key, [](const command_entry& entry, const command_key& value) NOEXCEPT
+        {
+            return entry.first < value;
+        });
 
-    const auto it = identifiers.find(command);
-    return (it == identifiers.end() ? identifier::unknown : it->second);
+    return it == identifiers.end() || it->first != key ? identifier::unknown :
+        it->second;
 }
+
 BC_POP_WARNING()
 
+identifier heading::id() const NOEXCEPT
+{
+    return id(command);
+}
+
 #undef COMMAND_ID
 
 } // namespace messages
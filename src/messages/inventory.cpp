@@ -79,18 +79,23 @@ typename inventory::cptr inventory::deserialize(uint32_t version,
 
 // static
 inventory inventory::deserialize(uint32_t version, reader& source) NOEXCEPT
+{
+    inventory out{};
+    deserialize(version, source, out);
+    return out;
+}
+
+// static
+void inventory::deserialize(uint32_t version, reader& source,
+    inventory& out) NOEXCEPT
 {
     if (version < version_minimum || version > version_maximum)
         source.invalidate();
 
-    const auto size = source.read_size(max_inventory);
-    inventory_items items;
-    items.reserve(size);
-
-    for (size_t item = 0; item < size; ++item)
-        items.push_back(inventory_item::deserialize(version, source));
-
-    return { items };
+    // Items are deserialized in place, within any retained capacity.
+    out.items.resize(source.read_size(max_inventory));
+    for (auto& item: out.items)
+        item = inventory_item::deserialize(version, source);
 }
 
 bool inventory::serialize(uint32_t version,
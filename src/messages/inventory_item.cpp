@@ -51,6 +51,8 @@ std::string inventory_item::to_string(type_id inventory_type) NOEXCEPT
             return "filtered_block";
         case type_id::compact_block:
             return "compact_block";
+        case type_id::wtxid:
+            return "wtxid";
         case type_id::witness_transaction:
             return "witness_transaction";
         case type_id::witness_block:
@@ -102,7 +104,8 @@ bool inventory_item::is_block_type() const NOEXCEPT
 bool inventory_item::is_transaction_type() const NOEXCEPT
 {
     return type == type_id::witness_transaction
-        || type == type_id::transaction;
+        || type == type_id::transaction
+        || type == type_id::wtxid;
 }
 
 bool inventory_item::is_witnessable_type() const NOEXCEPT
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/messages/inventory_view.hpp>
+
+#include <iterator>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/messages/enums/magic_numbers.hpp>
+#include <bitcoin/network/messages/inventory.hpp>
+#include <bitcoin/network/messages/inventory_item.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// The count prefix is validated as in inventory::deserialize, and the items
+// must exactly fill the remainder of the payload.
+static bool parse(const data_slice& payload, size_t& start,
+    size_t& count) NOEXCEPT
+{
+    read::bytes::copy reader(payload);
+    count = reader.read_size(max_inventory);
+    start = reader.get_read_position();
+
+    return reader && (payload.size() - start ==
+        count * (sizeof(uint32_t) + hash_size));
+}
+
+inventory_view::inventory_view(const data_slice& payload) NOEXCEPT
+  : items_(nullptr), size_(zero)
+{
+    size_t start{};
+    size_t count{};
+    if (parse(payload, start, count))
+    {
+        items_ = std::next(payload.data(), start);
+        size_ = count;
+    }
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+inventory_view::operator bool() const NOEXCEPT
+{
+    return !is_null(items_);
+}
+
+size_t inventory_view::size() const NOEXCEPT
+{
+    return size_;
+}
+
+bool inventory_view::empty() const NOEXCEPT
+{
+    return is_zero(size_);
+}
+
+inventory_view::type_id inventory_view::type(size_t index) const NOEXCEPT
+{
+    const auto bytes = at(index);
+    return inventory_item::to_type(
+        (uint32_t{ bytes[0] } << 0) |
+        (uint32_t{ bytes[1] } << 8) |
+        (uint32_t{ bytes[2] } << 16) |
+        (uint32_t{ bytes[3] } << 24));
+}
+
+const hash_digest& inventory_view::hash(size_t index) const NOEXCEPT
+{
+    return *pointer_cast<const hash_digest>(
+        std::next(at(index), sizeof(uint32_t)));
+}
+
+inventory_item inventory_view::item(size_t index) const NOEXCEPT
+{
+    return { type(index), hash(index) };
+}
+
+// Methods.
+// ----------------------------------------------------------------------------
+
+size_t inventory_view::count(type_id type) const NOEXCEPT
+{
+    size_t out{};
+    for (size_t index{}; index < size_; ++index)
+        if (this->type(index) == type)
+            ++out;
+
+    return out;
+}
+
+hashes inventory_view::to_hashes(type_id type) const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    hashes out{};
+    out.reserve(count(type));
+
+    for (size_t index{}; index < size_; ++index)
+        if (this->type(index) == type)
+            out.push_back(hash(index));
+
+    return out;
+    BC_POP_WARNING()
+}
+
+inventory inventory_view::to_inventory() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    inventory_items items(size_);
+    for (size_t index{}; index < size_; ++index)
+        items[index] = item(index);
+
+    return { std::move(items) };
+    BC_POP_WARNING()
+}
+
+// private
+const uint8_t* inventory_view::at(size_t index) const NOEXCEPT
+{
+    BC_ASSERT_MSG(index < size_, "index out of range");
+    return std::next(items_, index * item_size);
+}
+
+BC_POP_WARNING()
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/messages/reconciliation_sketch.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/messages/enums/identifier.hpp>
+#include <bitcoin/network/messages/enums/level.hpp>
+#include <bitcoin/network/messages/enums/magic_numbers.hpp>
+#include <bitcoin/network/messages/message.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+using namespace system;
+
+const std::string reconciliation_sketch::command = "sketch";
+const identifier reconciliation_sketch::id = identifier::reconciliation_sketch;
+const uint32_t reconciliation_sketch::version_minimum = level::bip339;
+const uint32_t reconciliation_sketch::version_maximum = level::maximum_protocol;
+
+// static
+typename reconciliation_sketch::cptr
+reconciliation_sketch::deserialize(uint32_t version,
+    const system::data_chunk& data) NOEXCEPT
+{
+    read::bytes::copy reader(data);
+    const auto message = to_shared(deserialize(version, reader));
+    return reader ? message : nullptr;
+}
+
+// static
+reconciliation_sketch reconciliation_sketch::deserialize(uint32_t version,
+    reader& source) NOEXCEPT
+{
+    if (version < version_minimum || version > version_maximum)
+        source.invalidate();
+
+    return { source.read_bytes(source.read_size(
+        max_sketch_capacity * sizeof(uint32_t))) };
+}
+
+bool reconciliation_sketch::serialize(uint32_t version,
+    const system::data_slab& data) const NOEXCEPT
+{
+    write::bytes::copy writer(data);
+    serialize(version, writer);
+    return writer;
+}
+
+void reconciliation_sketch::serialize(uint32_t BC_DEBUG_ONLY(version),
+    writer& sink) const NOEXCEPT
+{
+    BC_DEBUG_ONLY(const auto bytes = size(version);)
+    BC_DEBUG_ONLY(const auto start = sink.get_write_position();)
+
+    sink.write_variable(sketch.size());
+    sink.write_bytes(sketch);
+
+    BC_ASSERT(sink && sink.get_write_position() - start == bytes);
+}
+
+size_t reconciliation_sketch::size(uint32_t) const NOEXCEPT
+{
+    return variable_size(sketch.size()) + sketch.size();
+}
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/messages/request_reconciliation.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/messages/enums/identifier.hpp>
+#include <bitcoin/network/messages/enums/level.hpp>
+#include <bitcoin/network/messages/message.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+using namespace system;
+
+const std::string request_reconciliation::command = "reqrecon";
+const identifier request_reconciliation::id = identifier::request_reconciliation;
+const uint32_t request_reconciliation::version_minimum = level::bip339;
+const uint32_t request_reconciliation::version_maximum = level::maximum_protocol;
+
+// static
+size_t request_reconciliation::size(uint32_t) NOEXCEPT
+{
+    return sizeof(uint16_t)
+        + sizeof(uint16_t);
+}
+
+// static
+typename request_reconciliation::cptr
+request_reconciliation::deserialize(uint32_t version,
+    const system::data_chunk& data) NOEXCEPT
+{
+    read::bytes::copy reader(data);
+    const auto message = to_shared(deserialize(version, reader));
+    return reader ? message : nullptr;
+}
+
+// static
+request_reconciliation request_reconciliation::deserialize(uint32_t version,
+    reader& source) NOEXCEPT
+{
+    if (version < version_minimum || version > version_maximum)
+        source.invalidate();
+
+    const auto set_size = source.read_2_bytes_little_endian();
+    const auto coefficient = source.read_2_bytes_little_endian();
+    return { set_size, coefficient };
+}
+
+bool request_reconciliation::serialize(uint32_t version,
+    const system::data_slab& data) const NOEXCEPT
+{
+    write::bytes::copy writer(data);
+    serialize(version, writer);
+    return writer;
+}
+
+void request_reconciliation::serialize(uint32_t, writer& sink) const NOEXCEPT
+{
+    sink.write_2_bytes_little_endian(set_size);
+    sink.write_2_bytes_little_endian(coefficient);
+}
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2019 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/messages/request_sketch_extension.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/messages/enums/identifier.hpp>
+#include <bitcoin/network/messages/enums/level.hpp>
+#include <bitcoin/network/messages/message.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+using namespace system;
+
+const std::string request_sketch_extension::command = "reqsketchext";
+const identifier request_sketch_extension::id = identifier::request_sketch_extension;
+const uint32_t request_sketch_extension::version_minimum = level::bip339;
+const uint32_t request_sketch_extension::version_maximum = level::maximum_protocol;
+
+// static
+size_t request_sketch_extension::size(uint32_t) NOEXCEPT
+{
+    return zero;
+}
+
+// static
+typename request_sketch_extension::cptr request_sketch_extension::deserialize(uint32_t version,
+    const system::data_chunk& data) NOEXCEPT
+{
+    read::bytes::copy reader(data);
+    const auto message = to_shared(deserialize(version, reader));
+    return reader ? message : nullptr;
+}
+
+bool request_sketch_extension::serialize(uint32_t version,
+    const system::data_slab& data) const NOEXCEPT
+{
+    write::bytes::copy writer(data);
+    serialize(version, writer);
+    return writer;
+}
+
+request_sketch_extension request_sketch_extension::deserialize(uint32_t version, reader& source) NOEXCEPT
+{
+    if (version < version_minimum || version > version_maximum)
+        source.invalidate();
+
+    return {};
+}
+
+void request_sketch_extension::serialize(uint32_t BC_DEBUG_ONLY(version),
+    writer& BC_DEBUG_ONLY(sink)) const NOEXCEPT
+{
+    BC_DEBUG_ONLY(const auto bytes = size(version);)
+    BC_DEBUG_ONLY(const auto start = sink.get_write_position();)
+    BC_ASSERT(sink && sink.get_write_position() - start == bytes);
+}
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
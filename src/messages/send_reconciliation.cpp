@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/messages/send_reconciliation.hpp>
+
+#include <algorithm>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/messages/enums/identifier.hpp>
+#include <bitcoin/network/messages/enums/level.hpp>
+#include <bitcoin/network/messages/message.hpp>
+#include <bitcoin/network/messages/siphash.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+using namespace system;
+
+const std::string send_reconciliation::command = "sendtxrcncl";
+const identifier send_reconciliation::id = identifier::send_reconciliation;
+const uint32_t send_reconciliation::version_minimum = level::bip339;
+const uint32_t send_reconciliation::version_maximum = level::maximum_protocol;
+
+// static
+siphash_key send_reconciliation::to_key(uint64_t local_salt,
+    uint64_t remote_salt) NOEXCEPT
+{
+    // Tagged hash: sha256(sha256(tag) || sha256(tag) || salt1 || salt2).
+    const auto tag = sha256_hash(to_chunk(std::string{ "Tx Relay Salting" }));
+    data_chunk data(two * hash_size + two * sizeof(uint64_t));
+    write::bytes::copy writer(data);
+    writer.write_bytes(tag);
+    writer.write_bytes(tag);
+    writer.write_8_bytes_little_endian(std::min(local_salt, remote_salt));
+    writer.write_8_bytes_little_endian(std::max(local_salt, remote_salt));
+
+    const auto hash = sha256_hash(data);
+    siphash_key key{};
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+    {
+        key.k0 |= uint64_t{ hash.at(byte) } << to_bits(byte);
+        key.k1 |= uint64_t{ hash.at(byte + sizeof(uint64_t)) } <<
+            to_bits(byte);
+    }
+
+    return key;
+}
+
+// static
+uint32_t send_reconciliation::to_short_id(const siphash_key& key,
+    const hash_digest& wtxid) NOEXCEPT
+{
+    return possible_narrow_cast<uint32_t>(
+        add1(siphash(key, wtxid) % max_uint32));
+}
+
+// static
+size_t send_reconciliation::size(uint32_t) NOEXCEPT
+{
+    return sizeof(uint32_t)
+        + sizeof(uint64_t);
+}
+
+// static
+typename send_reconciliation::cptr
+send_reconciliation::deserialize(uint32_t version,
+    const system::data_chunk& data) NOEXCEPT
+{
+    read::bytes::copy reader(data);
+    const auto message = to_shared(deserialize(version, reader));
+    return reader ? message : nullptr;
+}
+
+// static
+send_reconciliation send_reconciliation::deserialize(uint32_t version,
+    reader& source) NOEXCEPT
+{
+    if (version < version_minimum || version > version_maximum)
+        source.invalidate();
+
+    const auto protocol = source.read_4_bytes_little_endian();
+    const auto salt = source.read_8_bytes_little_endian();
+    return { protocol, salt };
+}
+
+bool send_reconciliation::serialize(uint32_t version,
+    const system::data_slab& data) const NOEXCEPT
+{
+    write::bytes::copy writer(data);
+    serialize(version, writer);
+    return writer;
+}
+
+void send_reconciliation::serialize(uint32_t, writer& sink) const NOEXCEPT
+{
+    sink.write_4_bytes_little_endian(protocol_version);
+    sink.write_8_bytes_little_endian(salt);
+}
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
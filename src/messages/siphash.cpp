@@ -0,0 +1,323 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/messages/siphash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+namespace messages {
+
+using namespace system;
+
+// Little-endian word of the data at the byte offset (of the given length).
+static uint64_t to_word(const uint8_t* data, size_t bytes) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    uint64_t value{};
+    for (size_t byte = 0; byte < bytes; ++byte)
+        value |= uint64_t{ data[byte] } << to_bits(byte);
+
+    return value;
+    BC_POP_WARNING()
+}
+
+static constexpr uint64_t rotate(uint64_t value, size_t shift) NOEXCEPT
+{
+    return (value << shift) | (value >> (64u - shift));
+}
+
+struct state
+{
+    uint64_t v0;
+    uint64_t v1;
+    uint64_t v2;
+    uint64_t v3;
+};
+
+static constexpr void round(state& s) NOEXCEPT
+{
+    s.v0 += s.v1; s.v1 = rotate(s.v1, 13); s.v1 ^= s.v0;
+    s.v0 = rotate(s.v0, 32);
+    s.v2 += s.v3; s.v3 = rotate(s.v3, 16); s.v3 ^= s.v2;
+    s.v0 += s.v3; s.v3 = rotate(s.v3, 21); s.v3 ^= s.v0;
+    s.v2 += s.v1; s.v1 = rotate(s.v1, 17); s.v1 ^= s.v2;
+    s.v2 = rotate(s.v2, 32);
+}
+
+static constexpr state initialize(const siphash_key& key) NOEXCEPT
+{
+    return
+    {
+        0x736f6d6570736575_u64 ^ key.k0,
+        0x646f72616e646f6d_u64 ^ key.k1,
+        0x6c7967656e657261_u64 ^ key.k0,
+        0x7465646279746573_u64 ^ key.k1
+    };
+}
+
+static constexpr void compress(state& s, uint64_t word) NOEXCEPT
+{
+    s.v3 ^= word;
+    round(s);
+    round(s);
+    s.v0 ^= word;
+}
+
+static constexpr uint64_t finalize(state& s) NOEXCEPT
+{
+    s.v2 ^= 0xff;
+    round(s);
+    round(s);
+    round(s);
+    round(s);
+    return s.v0 ^ s.v1 ^ s.v2 ^ s.v3;
+}
+
+uint64_t siphash(const siphash_key& key, const data_slice& data) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    auto s = initialize(key);
+    const auto size = data.size();
+    const auto blocks = size / sizeof(uint64_t);
+    const auto begin = data.data();
+
+    for (size_t block = 0; block < blocks; ++block)
+        compress(s, to_word(begin + block * sizeof(uint64_t),
+            sizeof(uint64_t)));
+
+    // The final word carries the remaining bytes and the size (mod 256).
+    const auto remainder = size % sizeof(uint64_t);
+    const auto tail = to_word(begin + blocks * sizeof(uint64_t), remainder);
+    compress(s, tail | (uint64_t{ size } << 56));
+    return finalize(s);
+    BC_POP_WARNING()
+}
+
+uint64_t siphash(const siphash_key& key, const hash_digest& hash) NOEXCEPT
+{
+    auto s = initialize(key);
+    compress(s, to_word(&hash[0], sizeof(uint64_t)));
+    compress(s, to_word(&hash[8], sizeof(uint64_t)));
+    compress(s, to_word(&hash[16], sizeof(uint64_t)));
+    compress(s, to_word(&hash[24], sizeof(uint64_t)));
+    compress(s, uint64_t{ hash_size } << 56);
+    return finalize(s);
+}
+
+// Batched.
+// ----------------------------------------------------------------------------
+// Each step is applied across all lanes before the next, so that the lanes
+// form independent dependency chains (structure of arrays). There is no
+// branching within a batch, which allows the compiler to vectorize the lanes.
+
+constexpr size_t lanes = 4;
+typedef std::array<uint64_t, lanes> lane;
+
+struct lane_state
+{
+    lane v0;
+    lane v1;
+    lane v2;
+    lane v3;
+};
+
+static constexpr lane rotate(const lane& value, size_t shift) NOEXCEPT
+{
+    lane out{};
+    for (size_t index = 0; index < lanes; ++index)
+        out[index] = rotate(value[index], shift);
+
+    return out;
+}
+
+static constexpr void add(lane& to, const lane& value) NOEXCEPT
+{
+    for (size_t index = 0; index < lanes; ++index)
+        to[index] += value[index];
+}
+
+static constexpr void exclusive(lane& to, const lane& value) NOEXCEPT
+{
+    for (size_t index = 0; index < lanes; ++index)
+        to[index] ^= value[index];
+}
+
+static constexpr void round(lane_state& s) NOEXCEPT
+{
+    add(s.v0, s.v1); s.v1 = rotate(s.v1, 13); exclusive(s.v1, s.v0);
+    s.v0 = rotate(s.v0, 32);
+    add(s.v2, s.v3); s.v3 = rotate(s.v3, 16); exclusive(s.v3, s.v2);
+    add(s.v0, s.v3); s.v3 = rotate(s.v3, 21); exclusive(s.v3, s.v0);
+    add(s.v2, s.v1); s.v1 = rotate(s.v1, 17); exclusive(s.v1, s.v2);
+    s.v2 = rotate(s.v2, 32);
+}
+
+static constexpr void compress(lane_state& s, const lane& word) NOEXCEPT
+{
+    exclusive(s.v3, word);
+    round(s);
+    round(s);
+    exclusive(s.v0, word);
+}
+
+static constexpr lane_state initialize(const state& seed) NOEXCEPT
+{
+    lane_state s{};
+    s.v0.fill(seed.v0);
+    s.v1.fill(seed.v1);
+    s.v2.fill(seed.v2);
+    s.v3.fill(seed.v3);
+    return s;
+}
+
+static constexpr lane finalize(lane_state& s) NOEXCEPT
+{
+    for (size_t index = 0; index < lanes; ++index)
+        s.v2[index] ^= 0xff;
+
+    round(s);
+    round(s);
+    round(s);
+    round(s);
+
+    lane out{};
+    for (size_t index = 0; index < lanes; ++index)
+        out[index] = s.v0[index] ^ s.v1[index] ^ s.v2[index] ^ s.v3[index];
+
+    return out;
+}
+
+std::vector<uint64_t> siphash(const siphash_key& key,
+    const hashes& hashes) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::vector<uint64_t> out(hashes.size());
+    BC_POP_WARNING()
+
+    const auto seed = initialize(key);
+    const auto batches = hashes.size() / lanes;
+
+    for (size_t batch = 0; batch < batches; ++batch)
+    {
+        const auto first = batch * lanes;
+        auto s = initialize(seed);
+
+        for (size_t word = 0; word < hash_size / sizeof(uint64_t); ++word)
+        {
+            lane value{};
+            for (size_t index = 0; index < lanes; ++index)
+                value[index] = to_word(&hashes[first + index].at(
+                    word * sizeof(uint64_t)), sizeof(uint64_t));
+
+            compress(s, value);
+        }
+
+        lane length{};
+        length.fill(uint64_t{ hash_size } << 56);
+        compress(s, length);
+
+        const auto result = finalize(s);
+        for (size_t index = 0; index < lanes; ++index)
+            out[first + index] = result[index];
+    }
+
+    for (auto index = batches * lanes; index < hashes.size(); ++index)
+        out[index] = siphash(key, hashes[index]);
+
+    return out;
+}
+
+std::vector<uint64_t> siphash(const siphash_key& key,
+    const data_stack& items) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    std::vector<uint64_t> out(items.size());
+    std::vector<size_t> order(items.size());
+    std::iota(order.begin(), order.end(), zero);
+
+    // Runs of equal size are batched, stable so access remains ordered.
+    std::stable_sort(order.begin(), order.end(),
+        [&](size_t left, size_t right) NOEXCEPT
+        {
+            return items[left].size() < items[right].size();
+        });
+
+    const auto seed = initialize(key);
+    auto first = order.begin();
+    while (first != order.end())
+    {
+        const auto size = items[*first].size();
+        const auto last = std::find_if(first, order.end(),
+            [&](size_t index) NOEXCEPT
+            {
+                return items[index].size() != size;
+            });
+
+        const auto run = static_cast<size_t>(std::distance(first, last));
+        const auto blocks = size / sizeof(uint64_t);
+        const auto remainder = size % sizeof(uint64_t);
+
+        for (auto batch = run / lanes; !is_zero(batch); --batch)
+        {
+            auto s = initialize(seed);
+            for (size_t block = 0; block < blocks; ++block)
+            {
+                lane value{};
+                for (size_t index = 0; index < lanes; ++index)
+                    value[index] = to_word(items[first[index]].data() +
+                        block * sizeof(uint64_t), sizeof(uint64_t));
+
+                compress(s, value);
+            }
+
+            lane tail{};
+            for (size_t index = 0; index < lanes; ++index)
+                tail[index] = to_word(items[first[index]].data() +
+                    blocks * sizeof(uint64_t), remainder) |
+                    (uint64_t{ size } << 56);
+
+            compress(s, tail);
+
+            const auto result = finalize(s);
+            for (size_t index = 0; index < lanes; ++index)
+                out[first[index]] = result[index];
+
+            first += lanes;
+        }
+
+        for (; first != last; ++first)
+            out[*first] = siphash(key, items[*first]);
+    }
+
+    return out;
+    BC_POP_WARNING()
+    BC_POP_WARNING()
+}
+
+} // namespace messages
+} // namespace network
+} // namespace libbitcoin
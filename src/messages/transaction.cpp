@@ -19,10 +19,12 @@
 #include <bitcoin/network/messages/transaction.hpp>
 
 #include <iterator>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/messages/enums/identifier.hpp>
 #include <bitcoin/network/messages/enums/level.hpp>
 #include <bitcoin/network/messages/message.hpp>
+#include <bitcoin/network/net/payload_hash.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -39,23 +41,68 @@ const uint32_t transaction::version_maximum = level::maximum_protocol;
 hash_digest transaction::desegregated_hash(const data_chunk& data,
     size_t size) NOEXCEPT
 {
+    // Version, inputs and outputs (after marker and flag), and locktime.
     constexpr auto version = zero;
     constexpr auto preamble = sizeof(uint32_t) + two * sizeof(uint8_t);
+    const auto puts = size - two * sizeof(uint32_t);
     const auto locktime = data.size() - sizeof(uint32_t);
     const auto start = data.data();
 
     hash_digest digest{};
     hash::sha256x2::copy sink(digest);
     sink.write_bytes(std::next(start, version), sizeof(uint32_t));
-    sink.write_bytes(std::next(start, preamble), size - sizeof(uint32_t));
+    sink.write_bytes(std::next(start, preamble), puts);
     sink.write_bytes(std::next(start, locktime), sizeof(uint32_t));
     sink.flush();
     return digest;
 }
 
+// static
+hashes transaction::desegregated_hashes(const std::vector<data_slice>& data,
+    const std::vector<size_t>& sizes) NOEXCEPT
+{
+    BC_ASSERT(data.size() == sizes.size());
+    constexpr auto preamble = sizeof(uint32_t) + two * sizeof(uint8_t);
+
+    // Segregated transactions are stripped into one buffer (not reallocated).
+    size_t stripped{};
+    for (size_t index = 0; index < data.size(); ++index)
+        if (sizes.at(index) != data.at(index).size())
+            stripped += sizes.at(index);
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    data_chunk buffer(stripped);
+    std::vector<data_slice> slices{};
+    slices.reserve(data.size());
+
+    auto to = buffer.begin();
+    for (size_t index = 0; index < data.size(); ++index)
+    {
+        const auto& tx = data.at(index);
+        const auto size = sizes.at(index);
+        if (size == tx.size())
+        {
+            slices.push_back(tx);
+            continue;
+        }
+
+        const auto from = tx.begin();
+        const auto puts = size - two * sizeof(uint32_t);
+        const auto begin = to;
+        to = std::copy_n(from, sizeof(uint32_t), to);
+        to = std::copy_n(std::next(from, preamble), puts, to);
+        to = std::copy_n(std::prev(tx.end(), sizeof(uint32_t)),
+            sizeof(uint32_t), to);
+        slices.emplace_back(begin, to);
+    }
+    BC_POP_WARNING()
+
+    return payload_hash::batch(slices);
+}
+
 // static
 typename transaction::cptr transaction::deserialize(uint32_t version,
-    const data_chunk& data, bool witness) NOEXCEPT
+    const data_chunk& data, bool witness, const hash_cptr& hash) NOEXCEPT
 {
     read::bytes::copy reader(data);
     const auto message = to_shared(deserialize(version, reader, witness));
@@ -66,7 +113,8 @@ typename transaction::cptr transaction::deserialize(uint32_t version,
 
     // Optimized witness hash derivation using witness-serialized tx.
     // This will be non-witness if witness encoding is not enabled.
-    tx.set_witness_hash(bitcoin_hash(data));
+    // The payload checksum hash is the same digest, so reuse when provided.
+    tx.set_witness_hash(hash ? *hash : bitcoin_hash(data));
 
     // Wintess hash is cached above, can be copied if not segregated.
     tx.set_hash(tx.is_segregated() ? desegregated_hash(data,
@@ -76,6 +124,21 @@ typename transaction::cptr transaction::deserialize(uint32_t version,
     return message;
 }
 
+// static
+typename transaction::cptr transaction::deserialize(uint32_t version,
+    const chunk_ptr& data, bool witness, const hash_cptr& hash) NOEXCEPT
+{
+    if (!data)
+        return nullptr;
+
+    const auto message = deserialize(version, *data, witness, hash);
+    if (!message)
+        return nullptr;
+
+    // The payload is shared with the proxy, which will not reuse it.
+    return to_shared(transaction{ message->transaction_ptr, data });
+}
+
 // static
 transaction transaction::deserialize(uint32_t version, reader& source,
     bool witness) NOEXCEPT
@@ -94,13 +157,16 @@ bool transaction::serialize(uint32_t version,
     return writer;
 }
 
-void transaction::serialize(uint32_t BC_DEBUG_ONLY(version), writer& sink,
+void transaction::serialize(uint32_t version, writer& sink,
     bool witness) const NOEXCEPT
 {
-    BC_DEBUG_ONLY(const auto bytes = size(version, witness);)
+    const auto bytes = size(version, witness);
     BC_DEBUG_ONLY(const auto start = sink.get_write_position();)
 
-    if (transaction_ptr)
+    // Retained encoding is of the requested witness-ness if sizes match.
+    if (payload_ptr && payload_ptr->size() == bytes)
+        sink.write_bytes(*payload_ptr);
+    else if (transaction_ptr)
         transaction_ptr->to_data(sink, witness);
 
     BC_ASSERT(sink && sink.get_write_position() - start == bytes);
@@ -29,6 +29,12 @@
 #include <bitcoin/network/net/channel.hpp>
 #include <bitcoin/network/settings.hpp>
 
+#ifdef HAVE_LINUX
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+#endif
+
 namespace libbitcoin {
 namespace network {
 
@@ -51,7 +57,24 @@ inline asio::endpoint make_endpoint(bool enable_ipv6, uint16_t port) NOEXCEPT
 acceptor::acceptor(const logger& log, asio::strand& strand,
     asio::io_context& service, const settings& settings) NOEXCEPT
   : settings_(settings),
+    retained_(settings.retain()),
     service_(service),
+    services_(nullptr),
+    shard_(),
+    strand_(strand),
+    acceptor_(strand_),
+    reporter(log),
+    tracker<acceptor>(log)
+{
+}
+
+acceptor::acceptor(const logger& log, asio::strand& strand,
+    threadpools& services, const settings& settings) NOEXCEPT
+  : settings_(settings),
+    retained_(settings.retain()),
+    service_(strand.get_inner_executor().context()),
+    services_(&services),
+    shard_(),
     strand_(strand),
     acceptor_(strand_),
     reporter(log),
@@ -59,6 +82,20 @@ acceptor::acceptor(const logger& log, asio::strand& strand,
 {
 }
 
+acceptor::acceptor(const logger& log, asio::io_context& shard,
+    const settings& settings) NOEXCEPT
+  : settings_(settings),
+    retained_(settings.retain()),
+    service_(shard),
+    services_(nullptr),
+    shard_(std::make_unique<asio::strand>(shard.get_executor())),
+    strand_(*shard_),
+    acceptor_(strand_),
+    reporter(log),
+    tracker<acceptor>(log)
+{
+}
+
 acceptor::~acceptor() NOEXCEPT
 {
     BC_ASSERT_MSG(stopped_, "acceptor is not stopped");
@@ -99,9 +136,31 @@ code acceptor::start(const asio::endpoint& point) NOEXCEPT
     if (!ec)
         acceptor_.set_option(asio::reuse_address(true), ec);
 
+    // Each shard listens on the bind, with the kernel balancing connections.
+#if defined(HAVE_LINUX) && defined(SO_REUSEPORT)
+    if (!ec && settings_.reuse_port)
+    {
+        using reuse_port = boost::asio::detail::socket_option::boolean<
+            SOL_SOCKET, SO_REUSEPORT>;
+        acceptor_.set_option(reuse_port(true), ec);
+    }
+#endif
+
     if (!ec)
         acceptor_.bind(point, ec);
 
+    // Accept data in the SYN from clients with a fast open cookie.
+#if defined(HAVE_LINUX) && defined(TCP_FASTOPEN)
+    if (!ec && !is_zero(settings_.fast_open_queue))
+    {
+        using fast_open = boost::asio::detail::socket_option::integer<
+            IPPROTO_TCP, TCP_FASTOPEN>;
+        error::boost_code ignore;
+        acceptor_.set_option(fast_open(possible_narrow_sign_cast<int>(
+            settings_.fast_open_queue)), ignore);
+    }
+#endif
+
     if (!ec)
         acceptor_.listen(asio::max_connections, ec);
 
@@ -118,6 +177,21 @@ code acceptor::start(const asio::endpoint& point) NOEXCEPT
     return error::asio_to_error_code(ec);
 }
 
+code acceptor::adopt(const handoff::listener& listener) NOEXCEPT
+{
+    if (!stopped_)
+        return error::operation_failed;
+
+    // The socket is already bound and listening (with its options).
+    error::boost_code ec;
+    acceptor_.assign(listener.local.protocol(), listener.handle, ec);
+
+    if (!ec)
+        stopped_ = false;
+
+    return error::asio_to_error_code(ec);
+}
+
 void acceptor::stop() NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
@@ -137,9 +211,44 @@ config::authority acceptor::local() const NOEXCEPT
     return { stopped_ ? asio::endpoint{} : acceptor_.local_endpoint() };
 }
 
+handoff::descriptor acceptor::descriptor() NOEXCEPT
+{
+    return acceptor_.native_handle();
+}
+
+bool acceptor::sharded() const NOEXCEPT
+{
+    return shard_ != nullptr;
+}
+
+asio::strand& acceptor::strand() NOEXCEPT
+{
+    return strand_;
+}
+
 // Methods.
 // ----------------------------------------------------------------------------
 
+void acceptor::filter(filter_handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    filter_ = std::move(handler);
+}
+
+// protected
+bool acceptor::admitted(const config::authority& remote) const NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    return !filter_ || filter_(remote);
+}
+
+// protected
+// Accepted sockets are pinned to the (round robin) service of creation.
+asio::io_context& acceptor::socket_service() NOEXCEPT
+{
+    return is_null(services_) ? service_ : services_->service();
+}
+
 void acceptor::accept(socket_handler&& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
@@ -150,8 +259,29 @@ void acceptor::accept(socket_handler&& handler) NOEXCEPT
         return;
     }
 
+    // Filtered connections are accepted bare, the socket created if admitted.
+    if (filter_)
+    {
+        auto& service = socket_service();
+
+        try
+        {
+            acceptor_.async_accept(service,
+                std::bind(&acceptor::handle_connection,
+                    shared_from_this(), _1, _2, std::ref(service), handler));
+        }
+        catch (const std::exception& LOG_ONLY(e))
+        {
+            LOGF("Exception @ accept: " << e.what());
+            handler(error::accept_failed, nullptr);
+        }
+
+        return;
+    }
+
     // Create the socket.
-    const auto socket = std::make_shared<network::socket>(log, service_);
+    const auto socket = std::allocate_shared<network::socket>(
+        network::socket::allocator{}, log, socket_service());
 
     // Posts handle_accept to the acceptor's strand.
     // Establishes a socket connection by waiting on the socket.
@@ -180,7 +310,59 @@ void acceptor::handle_accept(const code& ec, const socket::ptr& socket,
         return;
     }
 
-    // Successful accept.
+    // Successful accept (options set before the socket is shared).
+    socket->set_options(settings_.socket_options());
+    handler(error::success, socket);
+}
+
+// private
+void acceptor::handle_connection(const error::boost_code& ec,
+    asio::socket&& connection, asio::io_context& service,
+    const socket_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    error::boost_code ignore;
+
+    if (error::asio_is_canceled(ec))
+    {
+        handler(error::operation_canceled, nullptr);
+        return;
+    }
+
+    if (ec)
+    {
+        handler(error::asio_to_error_code(ec), nullptr);
+        return;
+    }
+
+    if (stopped_)
+    {
+        connection.close(ignore);
+        handler(error::service_stopped, nullptr);
+        return;
+    }
+
+    // Rejection costs only the descriptor, the next connection is awaited.
+    error::boost_code error_code;
+    const auto remote = connection.remote_endpoint(error_code);
+    if (error_code || !admitted({ remote }))
+    {
+        connection.close(ignore);
+        accept(socket_handler{ handler });
+        return;
+    }
+
+    const auto socket = std::allocate_shared<network::socket>(
+        network::socket::allocator{}, log, service, std::move(connection));
+
+    if (socket->stopped())
+    {
+        handler(error::accept_failed, nullptr);
+        return;
+    }
+
+    // Successful accept (options set before the socket is shared).
+    socket->set_options(settings_.socket_options());
     handler(error::success, socket);
 }
 
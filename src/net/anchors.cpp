@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/anchors.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// The file is a heading followed by address_item wire (timestamped) records,
+// each followed by a block-relay byte.
+static constexpr uint32_t file_magic = 0x68636e61;
+static constexpr uint32_t file_version = 1;
+
+anchors::anchors(const settings& settings) NOEXCEPT
+  : settings_(settings)
+{
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+code anchors::start() NOEXCEPT
+{
+    if (is_zero(settings_.anchor_connections))
+        return error::success;
+
+    std::unique_lock lock(mutex_);
+
+    try
+    {
+        {
+            ifstream file{ settings_.anchors_file(),
+                ifstream::in | ifstream::binary };
+            if (!file.good())
+                return error::success;
+
+            read::bytes::istream source{ file };
+            if (source.read_4_bytes_little_endian() != file_magic ||
+                source.read_4_bytes_little_endian() != file_version)
+                return error::file_load;
+
+            while (!source.is_exhausted() &&
+                loaded_.size() < settings_.anchor_connections)
+            {
+                const auto item = address_item::deserialize(
+                    level::maximum_protocol, source, true);
+                source.skip_byte();
+                if (!source)
+                    return error::file_load;
+
+                loaded_.push_back(to_shared<address_item>(item));
+            }
+        }
+
+        // Anchors are dialed once, a crash must not redial them forever.
+        code ec;
+        std::filesystem::remove(settings_.anchors_file(), ec);
+        return ec ? error::file_load : error::success;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+}
+
+code anchors::stop() NOEXCEPT
+{
+    if (is_zero(settings_.anchor_connections))
+        return error::success;
+
+    std::unique_lock lock(mutex_);
+
+    if (recorded_.empty())
+        return error::success;
+
+    std::sort(recorded_.begin(), recorded_.end(),
+        [](const anchor& left, const anchor& right) NOEXCEPT
+        {
+            return left.block_relay != right.block_relay ? left.block_relay :
+                left.uptime > right.uptime;
+        });
+
+    try
+    {
+        ofstream file{ settings_.anchors_file(),
+            ofstream::out | ofstream::binary };
+        if (!file.good())
+            return error::file_save;
+
+        write::bytes::ostream sink{ file };
+        sink.write_4_bytes_little_endian(file_magic);
+        sink.write_4_bytes_little_endian(file_version);
+
+        const auto count = std::min(recorded_.size(),
+            size_t{ settings_.anchor_connections });
+        for (size_t index = 0; index < count; ++index)
+        {
+            const auto& entry = recorded_[index];
+            entry.item.serialize(level::maximum_protocol, sink, true);
+            sink.write_byte(static_cast<uint8_t>(entry.block_relay));
+        }
+
+        sink.flush();
+        if (!sink || file.bad())
+            return error::file_save;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+size_t anchors::count() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return loaded_.size();
+}
+
+// Usage.
+// ----------------------------------------------------------------------------
+
+bool anchors::take(address_item_cptr& out) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    if (loaded_.empty())
+        return false;
+
+    out = loaded_.front();
+    loaded_.pop_front();
+    return true;
+}
+
+void anchors::record(const address_item& item, bool block_relay,
+    const steady_clock::duration& uptime) NOEXCEPT
+{
+    if (is_zero(settings_.anchor_connections) ||
+        uptime < settings_.anchor_lifetime())
+        return;
+
+    std::unique_lock lock(mutex_);
+    recorded_.push_back({ item, block_relay, uptime });
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
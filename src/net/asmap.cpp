@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/asmap.hpp>
+
+#include <bit>
+#include <filesystem>
+#include <memory>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace boost::interprocess;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// Bytecode.
+// ----------------------------------------------------------------------------
+// The map is a bit stream (least significant bit of each byte first) of
+// instructions, each a type and a variable length integer argument.
+// github.com/bitcoin/bitcoin/blob/master/src/util/asmap.cpp
+
+constexpr uint32_t invalid = max_uint32;
+constexpr uint32_t unmapped = 0;
+constexpr size_t address_bits = 128;
+
+enum class instruction : uint32_t
+{
+    return_,
+    jump,
+    match,
+    default_
+};
+
+class bit_reader
+{
+public:
+    inline bit_reader(const data_slice& map) NOEXCEPT
+      : data_(map.data()), bits_(map.size() * byte_bits)
+    {
+    }
+
+    inline size_t remaining() const NOEXCEPT
+    {
+        return bits_ - position_;
+    }
+
+    inline bool exhausted() const NOEXCEPT
+    {
+        return is_zero(remaining());
+    }
+
+    inline bool read() NOEXCEPT
+    {
+        const auto bit = ((data_[position_ / byte_bits] >>
+            (position_ % byte_bits)) & 1u) != 0u;
+
+        ++position_;
+        return bit;
+    }
+
+    inline void skip(size_t bits) NOEXCEPT
+    {
+        position_ += bits;
+    }
+
+    // Exponent bits select a class (the last is implied), mantissa the value.
+    template <size_t Size>
+    inline uint32_t decode(uint32_t minimum,
+        const std::array<uint8_t, Size>& sizes) NOEXCEPT
+    {
+        auto value = minimum;
+        for (size_t index = 0; index < Size; ++index)
+        {
+            const auto size = sizes[index];
+            auto bit = false;
+            if (index != sub1(Size))
+            {
+                if (exhausted())
+                    return invalid;
+
+                bit = read();
+            }
+
+            if (bit)
+            {
+                value += (uint32_t{ 1 } << size);
+                continue;
+            }
+
+            for (size_t mantissa = 0; mantissa < size; ++mantissa)
+            {
+                if (exhausted())
+                    return invalid;
+
+                if (read())
+                    value += uint32_t{ 1 } << (sub1(size) - mantissa);
+            }
+
+            return value;
+        }
+
+        return invalid;
+    }
+
+private:
+    const uint8_t* data_;
+    const size_t bits_;
+    size_t position_{};
+};
+
+constexpr std::array<uint8_t, 3> type_sizes{ 0, 0, 1 };
+constexpr std::array<uint8_t, 10> asn_sizes
+{
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24
+};
+constexpr std::array<uint8_t, 8> match_sizes{ 1, 2, 3, 4, 5, 6, 7, 8 };
+constexpr std::array<uint8_t, 26> jump_sizes
+{
+    5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30
+};
+
+// Address bits are read most significant bit of each byte first.
+constexpr bool address_bit(const messages::ip_address& ip,
+    size_t bit) NOEXCEPT
+{
+    return ((ip[bit / byte_bits] >> (sub1(byte_bits) - (bit % byte_bits))) &
+        1u) != 0u;
+}
+
+// static
+uint32_t asmap::interpret(const data_slice& map,
+    const messages::ip_address& ip) NOEXCEPT
+{
+    bit_reader reader{ map };
+    uint32_t fallback{};
+    size_t bit{};
+
+    while (!reader.exhausted())
+    {
+        const auto type = reader.decode(0, type_sizes);
+        switch (static_cast<instruction>(type))
+        {
+            case instruction::return_:
+            {
+                const auto asn = reader.decode(1, asn_sizes);
+                return asn == invalid ? unmapped : asn;
+            }
+            case instruction::jump:
+            {
+                const auto jump = reader.decode(17, jump_sizes);
+                if (jump == invalid || bit == address_bits ||
+                    jump >= reader.remaining())
+                    return unmapped;
+
+                if (address_bit(ip, bit++))
+                    reader.skip(jump);
+
+                break;
+            }
+            case instruction::match:
+            {
+                const auto match = reader.decode(2, match_sizes);
+                if (match == invalid)
+                    return unmapped;
+
+                const size_t length = sub1(std::bit_width(match));
+                if (address_bits - bit < length)
+                    return unmapped;
+
+                for (size_t index = 0; index < length; ++index)
+                {
+                    const auto expected = ((match >> (sub1(length) - index)) &
+                        1u) != 0u;
+
+                    if (address_bit(ip, bit++) != expected)
+                        return fallback;
+                }
+
+                break;
+            }
+            case instruction::default_:
+            {
+                fallback = reader.decode(1, asn_sizes);
+                if (fallback == invalid)
+                    return unmapped;
+
+                break;
+            }
+            default:
+            {
+                return unmapped;
+            }
+        }
+    }
+
+    // Exhausted without return, an invalid map.
+    return unmapped;
+}
+
+// Mapping.
+// ----------------------------------------------------------------------------
+
+asmap::asmap() NOEXCEPT
+{
+}
+
+code asmap::load(const std::filesystem::path& file) NOEXCEPT
+{
+    try
+    {
+        auto mapping = std::make_unique<file_mapping>(file.string().c_str(),
+            read_only);
+        auto region = std::make_unique<mapped_region>(*mapping, read_only);
+        if (is_zero(region->get_size()))
+            return error::file_load;
+
+        const auto begin = pointer_cast<const uint8_t>(region->get_address());
+        map_ = { begin, std::next(begin, region->get_size()) };
+        file_ = std::move(mapping);
+        region_ = std::move(region);
+        return error::success;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_load;
+    }
+}
+
+bool asmap::loaded() const NOEXCEPT
+{
+    return !map_.empty();
+}
+
+uint32_t asmap::lookup(const messages::ip_address& ip) const NOEXCEPT
+{
+    return loaded() ? interpret(map_, ip) : unmapped;
+}
+
+uint32_t asmap::lookup(const config::authority& host) const NOEXCEPT
+{
+    return lookup(host.to_address_item().ip);
+}
+
+uint64_t asmap::group(const messages::ip_address& ip) const NOEXCEPT
+{
+    const auto asn = lookup(ip);
+    return is_zero(asn) ? uint64_t{ config::to_group(ip) } : asn_group | asn;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
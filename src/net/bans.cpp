@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/bans.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// The file is a heading followed by fixed size (ip, expiry) records.
+static constexpr uint32_t file_magic = 0x736e6162;
+static constexpr uint32_t file_version = 1;
+static constexpr uint64_t seconds_per_minute = 60;
+
+bans::bans(const settings& settings) NOEXCEPT
+  : settings_(settings)
+{
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+code bans::start() NOEXCEPT
+{
+    if (is_zero(settings_.host_pool_capacity))
+        return error::success;
+
+    const auto now = unix_time();
+    std::unique_lock lock(mutex_);
+
+    try
+    {
+        ifstream file{ settings_.bans_file(), ifstream::in | ifstream::binary };
+        if (!file.good())
+            return error::success;
+
+        read::bytes::istream source{ file };
+        if (source.read_4_bytes_little_endian() != file_magic ||
+            source.read_4_bytes_little_endian() != file_version)
+            return error::file_load;
+
+        while (!source.is_exhausted())
+        {
+            const auto ip = source.read_forward<std::tuple_size_v<ip_address>>();
+            const auto expiry = source.read_4_bytes_little_endian();
+            if (!source)
+                return error::file_load;
+
+            if (expiry > now && table_.size() < maximum_entries)
+                table_[ip] = { zero, now, expiry };
+        }
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+code bans::stop() NOEXCEPT
+{
+    if (is_zero(settings_.host_pool_capacity))
+        return error::success;
+
+    const auto now = unix_time();
+    std::unique_lock lock(mutex_);
+
+    const auto active = std::count_if(table_.begin(), table_.end(),
+        [now](const auto& entry) NOEXCEPT
+        {
+            return entry.second.expiry > now;
+        });
+
+    if (is_zero(active))
+    {
+        code ec;
+        std::filesystem::remove(settings_.bans_file(), ec);
+        return ec ? error::file_save : error::success;
+    }
+
+    try
+    {
+        ofstream file{ settings_.bans_file(), ofstream::out | ofstream::binary };
+        if (!file.good())
+            return error::file_save;
+
+        write::bytes::ostream sink{ file };
+        sink.write_4_bytes_little_endian(file_magic);
+        sink.write_4_bytes_little_endian(file_version);
+
+        for (const auto& entry: table_)
+        {
+            if (entry.second.expiry > now)
+            {
+                sink.write_bytes(entry.first);
+                sink.write_4_bytes_little_endian(entry.second.expiry);
+            }
+        }
+
+        sink.flush();
+        if (!sink || file.bad())
+            return error::file_save;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+size_t bans::count(uint32_t now) const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    return possible_narrow_sign_cast<size_t>(std::count_if(table_.begin(),
+        table_.end(), [now](const auto& entry) NOEXCEPT
+        {
+            return entry.second.expiry > now;
+        }));
+}
+
+// Usage.
+// ----------------------------------------------------------------------------
+
+// O(1).
+bool bans::banned(const address_item& item, uint32_t now) const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    const auto it = table_.find(item.ip);
+    return it != table_.end() && it->second.expiry > now;
+}
+
+// O(1), except O(N) prune at the table bound.
+bool bans::misbehaved(const address_item& item, const code& ec,
+    uint32_t now) NOEXCEPT
+{
+    const auto points = penalty(ec);
+    if (is_zero(points) || is_zero(settings_.ban_threshold))
+        return false;
+
+    std::unique_lock lock(mutex_);
+    auto it = table_.find(item.ip);
+    if (it == table_.end())
+    {
+        if (table_.size() >= maximum_entries)
+            prune(now);
+
+        // Reports are dropped while the table is full of active entries.
+        if (table_.size() >= maximum_entries)
+            return false;
+
+        it = table_.emplace(item.ip, record{}).first;
+    }
+
+    // A banned address is not scored further until expiry.
+    auto& entry = it->second;
+    if (entry.expiry > now)
+        return false;
+
+    entry.score = ceilinged_add(decayed(entry, now), points);
+    entry.updated = now;
+    if (entry.score < settings_.ban_threshold)
+        return false;
+
+    const auto duration = settings_.ban_minutes * seconds_per_minute;
+    entry.score = zero;
+    entry.expiry = limit<uint32_t>(ceilinged_add(uint64_t{ now }, duration));
+    return true;
+}
+
+// Protocol errors attributable to the peer, weighted by confidence.
+uint32_t bans::penalty(const code& ec) NOEXCEPT
+{
+    if (ec == error::invalid_magic ||
+        ec == error::invalid_heading ||
+        ec == error::oversized_payload)
+        return 100;
+
+    if (ec == error::invalid_checksum ||
+        ec == error::protocol_violation)
+        return 50;
+
+    if (ec == error::invalid_message)
+        return 20;
+
+    return zero;
+}
+
+// private
+// Halved over each whole decay period, linear toward the next halving.
+uint32_t bans::decayed(const record& entry, uint32_t now) const NOEXCEPT
+{
+    const auto half = settings_.ban_decay_minutes * seconds_per_minute;
+    if (is_zero(half))
+        return entry.score;
+
+    const uint64_t elapsed = floored_subtract(now, entry.updated);
+    const auto periods = elapsed / half;
+    if (periods >= to_bits(sizeof(uint32_t)))
+        return zero;
+
+    const uint64_t score = entry.score >> periods;
+    return possible_narrow_cast<uint32_t>(score -
+        (score * (elapsed % half)) / (two * half));
+}
+
+// private
+void bans::prune(uint32_t now) NOEXCEPT
+{
+    std::erase_if(table_, [&](const auto& entry) NOEXCEPT
+    {
+        return entry.second.expiry <= now && is_zero(decayed(entry.second, now));
+    });
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
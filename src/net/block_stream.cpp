@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/block_stream.hpp>
+
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+block_stream::block_stream(const chunk_ptr& payload, uint32_t version,
+    bool retain, bool witness) NOEXCEPT
+  : payload_(payload),
+    version_(version),
+    retain_(retain),
+    witness_(witness),
+    invalid_(!payload || version < block::version_minimum ||
+        version > block::version_maximum)
+{
+}
+
+bool block_stream::advance(size_t filled) NOEXCEPT
+{
+    if (invalid_)
+        return false;
+
+    BC_ASSERT_MSG(filled <= payload_->size(), "overfilled");
+    const auto complete = (filled == payload_->size());
+
+    if (!header_)
+    {
+        read::bytes::copy reader(remaining(filled));
+        auto header = to_shared<chain::header>(reader);
+        const auto count = reader.read_size();
+
+        if (!reader)
+        {
+            // Incomplete, unless there is nothing more to read.
+            invalid_ = complete;
+            return !invalid_;
+        }
+
+        // Each transaction is at least one byte (bounds the reservation).
+        if (count > payload_->size())
+        {
+            invalid_ = true;
+            return false;
+        }
+
+        header_ = std::move(header);
+        count_ = count;
+        offset_ = reader.get_read_position();
+        transactions_.reserve(static_cast<size_t>(count_));
+    }
+
+    while (transactions_.size() < count_ && offset_ < filled)
+    {
+        read::bytes::copy reader(remaining(filled));
+        auto tx = to_shared<chain::transaction>(reader, witness_);
+        if (!reader)
+        {
+            // Incomplete, unless there is nothing more to read.
+            invalid_ = complete;
+            return !invalid_;
+        }
+
+        offset_ += reader.get_read_position();
+        transactions_.push_back(std::move(tx));
+    }
+
+    // With nothing more to read the block must be exactly parsed.
+    invalid_ = complete && (transactions_.size() != count_ ||
+        offset_ != payload_->size());
+
+    return !invalid_;
+}
+
+size_t block_stream::parsed() const NOEXCEPT
+{
+    return transactions_.size();
+}
+
+block::cptr block_stream::finish(const hash_cptr& hash) NOEXCEPT
+{
+    if (invalid_ || !header_ || transactions_.size() != count_ ||
+        offset_ != payload_->size())
+        return nullptr;
+
+    const auto block_ptr = to_shared<chain::block>(header_,
+        to_shared(std::move(transactions_)));
+
+    block::set_hashes(*block_ptr, *payload_);
+
+    if (!retain_)
+        return to_shared(block{ block_ptr });
+
+    return to_shared(block{ block_ptr, payload_, hash });
+}
+
+// private
+data_slice block_stream::remaining(size_t filled) const NOEXCEPT
+{
+    return
+    {
+        std::next(payload_->begin(), offset_),
+        std::next(payload_->begin(), filled)
+    };
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/blocklist.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+static constexpr uint32_t file_magic = 0x6c626c62;
+static constexpr uint32_t file_version = 1;
+static constexpr size_t header_size = sizeof(file_magic) + sizeof(file_version);
+static constexpr size_t record_size = std::tuple_size_v<ip_address> + one;
+
+// Text is split for parallel parsing only above this size.
+static constexpr size_t minimum_chunk = 1'048'576;
+
+blocklist::blocklist(const std::filesystem::path& file,
+    size_t threads) NOEXCEPT
+  : file_(file), threads_(std::max(one, threads))
+{
+}
+
+// Methods.
+// ----------------------------------------------------------------------------
+
+code blocklist::refresh() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    std::error_code ec{};
+    const auto modified = std::filesystem::last_write_time(file_, ec);
+    if (ec)
+        return error::file_load;
+
+    if (subnets_.load(std::memory_order_acquire) && modified == modified_)
+        return error::success;
+
+    config::subnets::prefixes values{};
+    if (const auto code = load(values))
+        return code;
+
+    // Readers holding the prior trie retain it until their match completes.
+    subnets_.store(std::make_shared<const config::subnets>(values),
+        std::memory_order_release);
+
+    modified_ = modified;
+    return error::success;
+}
+
+bool blocklist::contains(const address_item& item) const NOEXCEPT
+{
+    const auto current = subnets_.load(std::memory_order_acquire);
+    return current && current->contains(item);
+}
+
+size_t blocklist::size() const NOEXCEPT
+{
+    const auto current = subnets_.load(std::memory_order_acquire);
+    return current ? current->size() : zero;
+}
+
+// static
+// Whitespace is trimmed, an overlong cidr is invalid (not skipped by trie).
+size_t blocklist::parse(config::subnets::prefixes& out,
+    std::string_view text) NOEXCEPT
+{
+    constexpr std::string_view whitespace{ " \t\r" };
+    size_t invalid{};
+
+    while (!text.empty())
+    {
+        const auto end = text.find('\n');
+        auto line = text.substr(zero, end);
+        text = end == std::string_view::npos ? std::string_view{} :
+            text.substr(add1(end));
+
+        line = line.substr(zero, line.find('#'));
+        const auto first = line.find_first_not_of(whitespace);
+        if (first == std::string_view::npos)
+            continue;
+
+        line = line.substr(first, add1(line.find_last_not_of(whitespace) -
+            first));
+
+        const auto slash = line.find('/');
+        const auto host = line.substr(zero, slash);
+
+        boost::system::error_code ec{};
+        const auto address = boost::asio::ip::make_address(std::string{ host },
+            ec);
+        if (ec)
+        {
+            ++invalid;
+            continue;
+        }
+
+        uint8_t cidr{};
+        if (slash != std::string_view::npos)
+        {
+            const auto digits = line.substr(add1(slash));
+            const auto end = std::next(digits.data(), digits.size());
+            const auto result = std::from_chars(digits.data(), end, cidr);
+            if (result.ec != std::errc{} || result.ptr != end ||
+                cidr > (address.is_v4() ? 32u : 128u))
+            {
+                ++invalid;
+                continue;
+            }
+        }
+
+        out.push_back({ config::to_address(address), cidr });
+    }
+
+    return invalid;
+}
+
+// static
+code blocklist::save(const std::filesystem::path& file,
+    const config::subnets::prefixes& values) NOEXCEPT
+{
+    try
+    {
+        ofstream stream{ file, ofstream::out | ofstream::binary };
+        if (!stream.good())
+            return error::file_save;
+
+        write::bytes::ostream sink{ stream };
+        sink.write_4_bytes_little_endian(file_magic);
+        sink.write_4_bytes_little_endian(file_version);
+
+        for (const auto& value: values)
+        {
+            sink.write_bytes(value.ip);
+            sink.write_byte(value.cidr);
+        }
+
+        sink.flush();
+        if (!sink || stream.bad())
+            return error::file_save;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// The file is read in one pass, and binary is identified by its magic.
+code blocklist::load(config::subnets::prefixes& out) const NOEXCEPT
+{
+    std::string text{};
+    try
+    {
+        ifstream stream{ file_, ifstream::in | ifstream::binary };
+        if (!stream.good())
+            return error::file_load;
+
+        std::ostringstream buffer{};
+        buffer << stream.rdbuf();
+        text = buffer.str();
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    const data_slice data{ text };
+    if (data.size() >= header_size)
+    {
+        read::bytes::copy source(data);
+        if (source.read_4_bytes_little_endian() == file_magic)
+        {
+            if (source.read_4_bytes_little_endian() != file_version ||
+                !is_zero((data.size() - header_size) % record_size))
+                return error::file_load;
+
+            out.reserve((data.size() - header_size) / record_size);
+            while (!source.is_exhausted())
+            {
+                const auto ip = source.read_forward<
+                    std::tuple_size_v<ip_address>>();
+                out.push_back({ ip, source.read_byte() });
+            }
+
+            return source ? error::success : error::file_load;
+        }
+    }
+
+    parallel(out, text);
+    return error::success;
+}
+
+// Chunks are split on line boundaries, and parsed results are concatenated
+// in order, so the trie is built single threaded from the joined prefixes.
+void blocklist::parallel(config::subnets::prefixes& out,
+    std::string_view text) const NOEXCEPT
+{
+    const auto count = std::min(threads_, add1(text.size() / minimum_chunk));
+    if (is_one(count))
+    {
+        parse(out, text);
+        return;
+    }
+
+    std::vector<std::string_view> chunks{};
+    chunks.reserve(count);
+    const auto target = ceilinged_divide(text.size(), count);
+    while (!text.empty())
+    {
+        auto end = text.find('\n', std::min(target, sub1(text.size())));
+        end = end == std::string_view::npos ? text.size() : add1(end);
+        chunks.push_back(text.substr(zero, end));
+        text = text.substr(end);
+    }
+
+    std::vector<config::subnets::prefixes> results(chunks.size());
+    threadpool pool(chunks.size(), thread_priority::low);
+    for (size_t index = 0; index < chunks.size(); ++index)
+    {
+        boost::asio::post(pool.service(), [&, index]() NOEXCEPT
+        {
+            parse(results.at(index), chunks.at(index));
+        });
+    }
+
+    pool.stop();
+    pool.join();
+
+    size_t total{};
+    for (const auto& result: results)
+        total += result.size();
+
+    out.reserve(total);
+    for (auto& result: results)
+        out.insert(out.end(), result.begin(), result.end());
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
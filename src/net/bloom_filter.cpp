@@ -0,0 +1,337 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/bloom_filter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Murmur3 (x86, 32 bit).
+// ----------------------------------------------------------------------------
+
+constexpr uint32_t c1 = 0xcc9e2d51;
+constexpr uint32_t c2 = 0x1b873593;
+constexpr uint32_t seed_factor = 0xfba4c795;
+
+typedef std::array<uint32_t, bloom_filter::maximum_hash_functions> lanes;
+
+constexpr uint32_t rotate(uint32_t value, size_t shift) NOEXCEPT
+{
+    return (value << shift) | (value >> (32u - shift));
+}
+
+// The block mix is independent of seed, so it is computed once for all lanes.
+constexpr uint32_t mix(uint32_t block) NOEXCEPT
+{
+    return rotate(block * c1, 15) * c2;
+}
+
+constexpr uint32_t finalize(uint32_t hash) NOEXCEPT
+{
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    return hash ^ (hash >> 16);
+}
+
+static uint32_t to_block(const data_slice& data, size_t offset) NOEXCEPT
+{
+    uint32_t value{};
+    for (size_t byte = 0; byte < sizeof(uint32_t); ++byte)
+        value |= uint32_t{ data[offset + byte] } << to_bits(byte);
+
+    return value;
+}
+
+static uint32_t to_tail(const data_slice& data) NOEXCEPT
+{
+    uint32_t value{};
+    const auto start = data.size() - (data.size() % sizeof(uint32_t));
+    for (auto byte = start; byte < data.size(); ++byte)
+        value |= uint32_t{ data[byte] } << to_bits(byte - start);
+
+    return value;
+}
+
+// Hash the data for count seeds (lanes), in one pass over the data.
+static void murmur3(lanes& hashes, size_t count, uint32_t tweak,
+    const data_slice& data) NOEXCEPT
+{
+    for (size_t lane = 0; lane < count; ++lane)
+        hashes[lane] = static_cast<uint32_t>(lane) * seed_factor + tweak;
+
+    const auto blocks = data.size() / sizeof(uint32_t);
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const auto value = mix(to_block(data, block * sizeof(uint32_t)));
+        for (size_t lane = 0; lane < count; ++lane)
+            hashes[lane] = rotate(hashes[lane] ^ value, 13) * 5 + 0xe6546b64;
+    }
+
+    const auto tail = (data.size() % sizeof(uint32_t)) != zero;
+    const auto value = tail ? mix(to_tail(data)) : 0u;
+    const auto size = static_cast<uint32_t>(data.size());
+    for (size_t lane = 0; lane < count; ++lane)
+        hashes[lane] = finalize(hashes[lane] ^ value ^ size);
+}
+
+// static
+uint32_t bloom_filter::murmur3(uint32_t seed, const data_slice& data) NOEXCEPT
+{
+    lanes hashes{};
+    network::murmur3(hashes, one, seed, data);
+    return hashes.front();
+}
+
+// Construct.
+// ----------------------------------------------------------------------------
+
+// static
+bool bloom_filter::is_valid(const bloom_filter_load& load) NOEXCEPT
+{
+    return load.filter.size() <= maximum_filter &&
+        load.hash_functions <= maximum_hash_functions;
+}
+
+bloom_filter::bloom_filter(const bloom_filter_load& load) NOEXCEPT
+  : hash_functions_(std::min(load.hash_functions,
+        static_cast<uint32_t>(maximum_hash_functions))),
+    tweak_(load.tweak),
+    flags_(load.flags & update_mask),
+    bits_(load.filter)
+{
+    BC_ASSERT_MSG(is_valid(load), "invalid bloom filter");
+}
+
+// Elements.
+// ----------------------------------------------------------------------------
+
+void bloom_filter::insert(const data_slice& element) NOEXCEPT
+{
+    if (bits_.empty())
+        return;
+
+    lanes hashes{};
+    network::murmur3(hashes, hash_functions_, tweak_, element);
+
+    const auto size = to_bits(bits_.size());
+    for (size_t lane = 0; lane < hash_functions_; ++lane)
+    {
+        const auto bit = hashes[lane] % size;
+        bits_[bit / byte_bits] |= (1u << (bit % byte_bits));
+    }
+}
+
+// An empty filter matches everything (as a full filter).
+bool bloom_filter::contains(const data_slice& element) const NOEXCEPT
+{
+    if (bits_.empty())
+        return true;
+
+    lanes hashes{};
+    network::murmur3(hashes, hash_functions_, tweak_, element);
+
+    const auto size = to_bits(bits_.size());
+    for (size_t lane = 0; lane < hash_functions_; ++lane)
+    {
+        const auto bit = hashes[lane] % size;
+        if (is_zero(bits_[bit / byte_bits] & (1u << (bit % byte_bits))))
+            return false;
+    }
+
+    return true;
+}
+
+// Transactions.
+// ----------------------------------------------------------------------------
+
+static std::array<uint8_t, hash_size + sizeof(uint32_t)> to_outpoint(
+    const hash_digest& hash, uint32_t index) NOEXCEPT
+{
+    std::array<uint8_t, hash_size + sizeof(uint32_t)> out{};
+    std::copy(hash.begin(), hash.end(), out.begin());
+    for (size_t byte = 0; byte < sizeof(uint32_t); ++byte)
+        out[hash_size + byte] = static_cast<uint8_t>(index >> to_bits(byte));
+
+    return out;
+}
+
+bool bloom_filter::match(const chain::transaction& tx) NOEXCEPT
+{
+    return match(tx, tx.hash(false));
+}
+
+// private
+bool bloom_filter::match(const chain::transaction& tx,
+    const hash_digest& hash) NOEXCEPT
+{
+    auto matched = contains(hash);
+
+    // Outputs are always evaluated, as matched outputs may be inserted.
+    const auto& outputs = *tx.outputs_ptr();
+    for (size_t index = 0; index < outputs.size(); ++index)
+    {
+        const auto& ops = outputs[index]->script().ops();
+        for (const auto& op: ops)
+        {
+            const auto& data = op.data();
+            if (data.empty() || !contains(data))
+                continue;
+
+            matched = true;
+            if (flags_ == update_all || (flags_ == update_pay_key_only &&
+                (chain::script::is_pay_key_pattern(ops) ||
+                chain::script::is_pay_multisig_pattern(ops))))
+                insert(to_outpoint(hash, static_cast<uint32_t>(index)));
+
+            break;
+        }
+    }
+
+    if (matched)
+        return true;
+
+    for (const auto& input: *tx.inputs_ptr())
+    {
+        const auto& point = input->point();
+        if (contains(to_outpoint(point.hash(), point.index())))
+            return true;
+
+        for (const auto& op: input->script().ops())
+        {
+            const auto& data = op.data();
+            if (!data.empty() && contains(data))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// Blocks.
+// ----------------------------------------------------------------------------
+
+typedef std::vector<hashes> hash_levels;
+typedef std::vector<std::vector<bool>> match_levels;
+
+static hash_digest to_parent(const hash_digest& left,
+    const hash_digest& right) NOEXCEPT
+{
+    std::array<uint8_t, two * hash_size> pair{};
+    std::copy(left.begin(), left.end(), pair.begin());
+    std::copy(right.begin(), right.end(), std::next(pair.begin(), hash_size));
+    return bitcoin_hash(pair);
+}
+
+// BIP37 partial merkle tree, depth first from the root.
+static void traverse(hashes& out, std::vector<bool>& bits,
+    const hash_levels& tree, const match_levels& matches, size_t height,
+    size_t position) NOEXCEPT
+{
+    const auto parent = matches[height][position];
+    bits.push_back(parent);
+
+    if (is_zero(height) || !parent)
+    {
+        out.push_back(tree[height][position]);
+        return;
+    }
+
+    const auto left = two * position;
+    traverse(out, bits, tree, matches, sub1(height), left);
+    if (add1(left) < tree[sub1(height)].size())
+        traverse(out, bits, tree, matches, sub1(height), add1(left));
+}
+
+merkle_block bloom_filter::match(indexes& matched,
+    const chain::block& block) NOEXCEPT
+{
+    const auto& txs = *block.transactions_ptr();
+    merkle_block out{ block.header_ptr(), static_cast<uint32_t>(txs.size()),
+        {}, {} };
+
+    matched.clear();
+    if (txs.empty())
+        return out;
+
+    // Match in order and build the leaves (txids) in the same pass.
+    hash_levels tree(one);
+    match_levels matches(one);
+    tree.front().reserve(txs.size());
+    matches.front().reserve(txs.size());
+    for (size_t index = 0; index < txs.size(); ++index)
+    {
+        const auto hash = txs[index]->hash(false);
+        const auto relevant = match(*txs[index], hash);
+        tree.front().push_back(hash);
+        matches.front().push_back(relevant);
+        if (relevant)
+            matched.push_back(index);
+    }
+
+    // Odd levels pair the last node with itself.
+    while (tree.back().size() > one)
+    {
+        const auto& below = tree.back();
+        const auto& found = matches.back();
+        hashes level{};
+        std::vector<bool> parents{};
+        level.reserve(ceilinged_divide(below.size(), two));
+        parents.reserve(level.capacity());
+
+        for (size_t left = 0; left < below.size(); left += two)
+        {
+            const auto right = std::min(add1(left), sub1(below.size()));
+            level.push_back(to_parent(below[left], below[right]));
+            parents.push_back(found[left] || found[right]);
+        }
+
+        tree.push_back(std::move(level));
+        matches.push_back(std::move(parents));
+    }
+
+    std::vector<bool> bits{};
+    traverse(out.hashes, bits, tree, matches, sub1(tree.size()), zero);
+
+    // Flag bits are packed least significant first.
+    out.flags.resize(ceilinged_divide(bits.size(), byte_bits));
+    for (size_t bit = 0; bit < bits.size(); ++bit)
+        if (bits[bit])
+            out.flags[bit / byte_bits] |= (1u << (bit % byte_bits));
+
+    return out;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -18,6 +18,10 @@
  */
 #include <bitcoin/network/net/broadcaster.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/messages/messages.hpp>
@@ -31,10 +35,12 @@ using namespace system;
 #define MAKE_SUBSCRIBER(name) SUBSCRIBER(name)(strand)
 #define STOP_SUBSCRIBER(name) SUBSCRIBER(name).stop_default(ec)
 #define UNSUBSCRIBER(name) SUBSCRIBER(name) \
-    .notify_one(subscriber, error::desubscribed, nullptr, subscriber)
+    .notify_one(subscriber, error::desubscribed, nullptr, nullptr, subscriber)
 
-broadcaster::broadcaster(asio::strand& strand) NOEXCEPT
-  : MAKE_SUBSCRIBER(address),
+broadcaster::broadcaster(asio::strand& strand, size_t slices) NOEXCEPT
+  : strand_(strand),
+    slices_(std::max(one, slices)),
+    MAKE_SUBSCRIBER(address),
     MAKE_SUBSCRIBER(alert),
     MAKE_SUBSCRIBER(block),
     MAKE_SUBSCRIBER(bloom_filter_add),
@@ -61,17 +67,24 @@ broadcaster::broadcaster(asio::strand& strand) NOEXCEPT
     MAKE_SUBSCRIBER(not_found),
     MAKE_SUBSCRIBER(ping),
     MAKE_SUBSCRIBER(pong),
+    MAKE_SUBSCRIBER(reconciliation_difference),
+    MAKE_SUBSCRIBER(reconciliation_sketch),
     MAKE_SUBSCRIBER(reject),
+    MAKE_SUBSCRIBER(request_reconciliation),
+    MAKE_SUBSCRIBER(request_sketch_extension),
     MAKE_SUBSCRIBER(send_compact),
     MAKE_SUBSCRIBER(send_headers),
+    MAKE_SUBSCRIBER(send_reconciliation),
     MAKE_SUBSCRIBER(transaction),
     MAKE_SUBSCRIBER(version),
-    MAKE_SUBSCRIBER(version_acknowledge)
+    MAKE_SUBSCRIBER(version_acknowledge),
+    MAKE_SUBSCRIBER(wtxid_relay)
 {
 }
 
 void broadcaster::unsubscribe(channel_id subscriber) NOEXCEPT
 {
+    unsubscribe_fanout(subscriber);
     UNSUBSCRIBER(address);
     UNSUBSCRIBER(alert);
     UNSUBSCRIBER(block);
@@ -99,16 +112,23 @@ void broadcaster::unsubscribe(channel_id subscriber) NOEXCEPT
     UNSUBSCRIBER(not_found);
     UNSUBSCRIBER(ping);
     UNSUBSCRIBER(pong);
+    UNSUBSCRIBER(reconciliation_difference);
+    UNSUBSCRIBER(reconciliation_sketch);
     UNSUBSCRIBER(reject);
+    UNSUBSCRIBER(request_reconciliation);
+    UNSUBSCRIBER(request_sketch_extension);
     UNSUBSCRIBER(send_compact);
     UNSUBSCRIBER(send_headers);
+    UNSUBSCRIBER(send_reconciliation);
     UNSUBSCRIBER(transaction);
     UNSUBSCRIBER(version);
     UNSUBSCRIBER(version_acknowledge);
+    UNSUBSCRIBER(wtxid_relay);
 }
 
 void broadcaster::stop(const code& ec) NOEXCEPT
 {
+    stop_fanout(ec);
     STOP_SUBSCRIBER(address);
     STOP_SUBSCRIBER(alert);
     STOP_SUBSCRIBER(block);
@@ -136,17 +156,285 @@ void broadcaster::stop(const code& ec) NOEXCEPT
     STOP_SUBSCRIBER(not_found);
     STOP_SUBSCRIBER(ping);
     STOP_SUBSCRIBER(pong);
+    STOP_SUBSCRIBER(reconciliation_difference);
+    STOP_SUBSCRIBER(reconciliation_sketch);
     STOP_SUBSCRIBER(reject);
+    STOP_SUBSCRIBER(request_reconciliation);
+    STOP_SUBSCRIBER(request_sketch_extension);
     STOP_SUBSCRIBER(send_compact);
     STOP_SUBSCRIBER(send_headers);
+    STOP_SUBSCRIBER(send_reconciliation);
     STOP_SUBSCRIBER(transaction);
     STOP_SUBSCRIBER(version);
     STOP_SUBSCRIBER(version_acknowledge);
+    STOP_SUBSCRIBER(wtxid_relay);
+}
+
+// Fan-out.
+// ----------------------------------------------------------------------------
+// Each fan-out subscriber is retained in one shard, identified by the
+// execution context of its strand and a slice of its channel identifier. A
+// broadcast posts one batch per shard to the shard's context, so that the
+// broadcast strand does work in proportion to the number of shards, and the
+// batches post to subscriber strands concurrently.
+
+bool broadcaster::requirement::satisfied(
+    const capabilities& peer) const NOEXCEPT
+{
+    return (peer.services & services) == services
+        && peer.version >= version
+        && (!relay || peer.relay)
+        && (is_zero(fee_rate) ||
+            peer.fee_filter.load(std::memory_order_relaxed) <= fee_rate);
+}
+
+template <typename Item>
+static bool precedes(const Item& item, uint64_t id) NOEXCEPT
+{
+    return item.id < id;
+}
+
+void broadcaster::post(const target& to, const code& ec,
+    const message_cptr& message, const wire_cache::ptr& cache,
+    channel_id sender) NOEXCEPT
+{
+    boost::asio::post(*to.strand,
+        [handler = to.handler, ec, message, cache, sender]() NOEXCEPT
+        {
+            /*bool*/ (*handler)(ec, message, cache, sender);
+        });
+}
+
+// Requirements are evaluated here in the batch, so that a subscriber that
+// cannot use the broadcast incurs no handler post (or closure invocation).
+void broadcaster::deliver(const shard& part, const message_cptr& message,
+    const wire_cache::ptr& cache, channel_id sender,
+    const requirement& required) NOEXCEPT
+{
+    const auto offer = [&](const target& to) NOEXCEPT
+    {
+        if (!to.peer || required.satisfied(*to.peer))
+            post(to, error::success, message, cache, sender);
+    };
+
+    // A fee rated broadcast visits only members with filter at or below rate.
+    if (!is_zero(required.fee_rate))
+    {
+        const auto& by_fee = *part.by_fee;
+        const auto accepts = std::upper_bound(by_fee.begin(), by_fee.end(),
+            required.fee_rate, [](uint64_t rate, const target& to) NOEXCEPT
+            {
+                return rate < to.fee_filter;
+            });
+
+        std::for_each(by_fee.begin(), accepts, [&](const target& to) NOEXCEPT
+        {
+            if (to.id != sender)
+                offer(to);
+        });
+
+        return;
+    }
+
+    // Members are ordered, so the sender is excluded by range, not by test.
+    const auto& members = part.members;
+    const auto begin = members->begin();
+    const auto end = members->end();
+    const auto split = std::lower_bound(begin, end, sender, precedes<target>);
+    const auto next = (split != end && split->id == sender) ?
+        std::next(split) : split;
+
+    std::for_each(begin, split, offer);
+    std::for_each(next, end, offer);
+}
+
+code broadcaster::do_subscribe_fanout(messages::identifier id,
+    std::shared_ptr<const relay>&& handler, channel_id subscriber,
+    asio::strand& strand, const capabilities_ptr& peer) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    const auto fee = peer ? peer->fee_filter.load(std::memory_order_relaxed) :
+        zero;
+    const target item{ subscriber, &strand, std::move(handler), peer, fee };
+    if (stopped_)
+    {
+        post(item, error::subscriber_stopped, {}, {}, subscriber);
+        return error::subscriber_stopped;
+    }
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    auto& group = fanouts_[id];
+    BC_POP_WARNING()
+
+    for (const auto& part: group)
+    {
+        const auto& members = *part.members;
+        const auto it = std::lower_bound(members.begin(), members.end(),
+            subscriber, precedes<target>);
+
+        if (it != members.end() && it->id == subscriber)
+        {
+            post(item, error::subscriber_exists, {}, {}, subscriber);
+            return error::subscriber_exists;
+        }
+    }
+
+    const auto context = &strand.get_inner_executor().context();
+    const auto slice = subscriber % slices_;
+    auto part = std::find_if(group.begin(), group.end(),
+        [&](const shard& value) NOEXCEPT
+        {
+            return value.context == context && value.slice == slice;
+        });
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    if (part == group.end())
+    {
+        group.push_back(
+        {
+            context,
+            slice,
+            strand.get_inner_executor(),
+            std::make_shared<const targets>(),
+            std::make_shared<const targets>()
+        });
+
+        part = std::prev(group.end());
+    }
+
+    // Copy on write, as a prior batch may still hold the members.
+    auto members = *part->members;
+    members.insert(std::lower_bound(members.begin(), members.end(),
+        subscriber, precedes<target>), item);
+    set_members(*part, std::move(members));
+    BC_POP_WARNING()
+    return error::success;
+}
+
+void broadcaster::set_members(shard& part, targets&& members) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    auto by_fee = members;
+    std::stable_sort(by_fee.begin(), by_fee.end(),
+        [](const target& left, const target& right) NOEXCEPT
+        {
+            return left.fee_filter < right.fee_filter;
+        });
+
+    part.members = std::make_shared<const targets>(std::move(members));
+    part.by_fee = std::make_shared<const targets>(std::move(by_fee));
+    BC_POP_WARNING()
+}
+
+// Copy on write (reindexed), as a prior batch may still hold the members.
+void broadcaster::set_fee_filter(channel_id subscriber, uint64_t rate) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    for (auto& group: fanouts_)
+    {
+        for (auto& part: group.second)
+        {
+            const auto& current = *part.members;
+            const auto it = std::lower_bound(current.begin(), current.end(),
+                subscriber, precedes<target>);
+
+            if (it == current.end() || it->id != subscriber ||
+                it->fee_filter == rate)
+                continue;
+
+            auto members = current;
+            members.at(std::distance(current.begin(), it)).fee_filter = rate;
+            set_members(part, std::move(members));
+            break;
+        }
+    }
+    BC_POP_WARNING()
+}
+
+void broadcaster::fanout(messages::identifier id, const message_cptr& message,
+    const wire_cache::ptr& cache, channel_id sender,
+    const requirement& required) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    const auto group = fanouts_.find(id);
+    if (group == fanouts_.end())
+        return;
+
+    // Transactions are not relayed to peers that disabled relay (bip37).
+    auto needed = required;
+    needed.relay = needed.relay || id == messages::identifier::transaction;
+
+    for (const auto& part: group->second)
+    {
+        boost::asio::post(part.executor,
+            [part, message, cache, sender, needed]() NOEXCEPT
+            {
+                deliver(part, message, cache, sender, needed);
+            });
+    }
+}
+
+void broadcaster::unsubscribe_fanout(channel_id subscriber) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    for (auto& group: fanouts_)
+    {
+        auto& parts = group.second;
+        for (auto part = parts.begin(); part != parts.end();)
+        {
+            const auto& current = *part->members;
+            const auto it = std::lower_bound(current.begin(), current.end(),
+                subscriber, precedes<target>);
+
+            if (it == current.end() || it->id != subscriber)
+            {
+                ++part;
+                continue;
+            }
+
+            post(*it, error::desubscribed, {}, {}, subscriber);
+
+            // Copy on write, as a prior batch may still hold the members.
+            auto members = current;
+            members.erase(std::next(members.begin(),
+                std::distance(current.begin(), it)));
+
+            if (members.empty())
+            {
+                part = parts.erase(part);
+                continue;
+            }
+
+            set_members(*part, std::move(members));
+            ++part;
+        }
+    }
+    BC_POP_WARNING()
+}
+
+void broadcaster::stop_fanout(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    stopped_ = true;
+    for (const auto& group: fanouts_)
+        for (const auto& part: group.second)
+            for (const auto& to: *part.members)
+                post(to, ec, {}, {}, to.id);
+
+    fanouts_.clear();
 }
 
 #undef SUBSCRIBER
 #undef MAKE_SUBSCRIBER
 #undef STOP_SUBSCRIBER
+#undef UNSUBSCRIBER
 
 } // namespace network
 } // namespace libbitcoin
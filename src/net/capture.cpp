@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/capture.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+using namespace system;
+
+capture::capture(const std::filesystem::path& file) NOEXCEPT
+  : file_(file, ofstream::out | ofstream::binary | ofstream::trunc)
+{
+    const auto magic = to_little_endian(file_magic);
+    file_.write(pointer_cast<const char>(magic.data()), magic.size());
+}
+
+bool capture::good() const NOEXCEPT
+{
+    return file_.good();
+}
+
+bool capture::write(const data_slice& heading,
+    const data_slice& payload) NOEXCEPT
+{
+    if (!file_.good())
+        return false;
+
+    const auto elapsed = std::chrono::duration_cast<microseconds>(
+        steady_clock::now() - start_).count();
+    const auto size = ceilinged_add(heading.size(), payload.size());
+    const auto time = to_little_endian(possible_narrow_sign_cast<uint64_t>(
+        elapsed));
+    const auto length = to_little_endian(
+        possible_narrow_cast<uint32_t>(size));
+
+    file_.write(pointer_cast<const char>(time.data()), time.size());
+    file_.write(pointer_cast<const char>(length.data()), length.size());
+    file_.write(pointer_cast<const char>(heading.data()), heading.size());
+    file_.write(pointer_cast<const char>(payload.data()), payload.size());
+    return file_.good();
+}
+
+bool capture::read_magic(std::istream& stream) NOEXCEPT
+{
+    read::bytes::istream source{ stream };
+    return source.read_4_bytes_little_endian() == file_magic && source;
+}
+
+bool capture::read(std::istream& stream, record& out) NOEXCEPT
+{
+    read::bytes::istream source{ stream };
+    if (source.is_exhausted())
+        return false;
+
+    out.microseconds = source.read_8_bytes_little_endian();
+    out.message = source.read_bytes(source.read_4_bytes_little_endian());
+    return source;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
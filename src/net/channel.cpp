@@ -18,6 +18,8 @@
  */
 #include <bitcoin/network/net/channel.hpp>
 
+#include <algorithm>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <bitcoin/system.hpp>
@@ -26,6 +28,7 @@
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/capture.hpp>
 #include <bitcoin/network/net/deadline.hpp>
 #include <bitcoin/network/net/proxy.hpp>
 #include <bitcoin/network/settings.hpp>
@@ -37,30 +40,48 @@ using namespace system;
 using namespace messages;
 using namespace std::placeholders;
 
-// Factory for fixed deadline timer pointer construction.
+// Factory for fixed deadline timer pointer construction (shared wheel).
 inline deadline::ptr timeout(const logger& log, asio::strand& strand,
-    const deadline::duration& span) NOEXCEPT
+    timer_wheel& wheel, const deadline::duration& span) NOEXCEPT
 {
     BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    return std::make_shared<deadline>(log, strand, span);
+    return std::allocate_shared<deadline>(deadline::allocator{}, log, strand,
+        wheel, span);
     BC_POP_WARNING()
 }
 
-// Factory for varied deadline timer pointer construction.
-inline deadline::ptr expiration(const logger& log, asio::strand& strand,
-    const deadline::duration& span) NOEXCEPT
+// Factory for capture pointer construction (nullptr if not capturing).
+inline capture::ptr recording(const std::filesystem::path& file) NOEXCEPT
 {
-    return timeout(log, strand, pseudo_random::duration(span));
+    if (file.empty())
+        return {};
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    return std::make_unique<capture>(file);
+    BC_POP_WARNING()
 }
 
+// The proxy pool and budget share ownership of the resources (aliased).
 channel::channel(const logger& log, const socket::ptr& socket,
-    const settings& settings, uint64_t identifier, bool quiet) NOEXCEPT
-  : proxy(socket),
+    const network::settings& settings, const resources::ptr& shared,
+    uint64_t identifier, bool quiet) NOEXCEPT
+  : proxy(socket, { shared, &shared->payload_buffers() },
+        { shared, &shared->memory() }),
     quiet_(quiet),
+    traced_(settings.traced(socket->authority().to_address_item())),
+    trusted_(settings.trusted(socket->authority().to_address_item())),
     settings_(settings),
+    retained_(settings.retain()),
+    resources_(shared),
     identifier_(identifier),
-    expiration_(expiration(log, socket->strand(), settings.channel_expiration())),
-    inactivity_(timeout(log, socket->strand(), settings.channel_inactivity())),
+    expiration_(timeout(log, socket->strand(), shared->timers(),
+        settings.staggered(settings.channel_expiration()))),
+    inactivity_(quiet ? deadline::ptr{} : timeout(log, socket->strand(),
+        shared->timers(), settings.channel_inactivity())),
+    trickle_(quiet ? deadline::ptr{} : timeout(log, socket->strand(),
+        shared->timers(), settings.channel_trickle())),
+    capture_(recording(settings.capture_file(identifier))),
+    known_(quiet ? zero : settings.announce_capacity),
     negotiated_version_(settings.protocol_maximum),
     tracker<channel>(log)
 {
@@ -89,8 +110,12 @@ void channel::stop(const code& ec) NOEXCEPT
 void channel::do_stop(const code&) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
-    inactivity_->stop();
     expiration_->stop();
+
+    // Quiet channels have neither inactivity nor trickle timers.
+    if (inactivity_) inactivity_->stop();
+    if (trickle_) trickle_->stop();
+    announcements_.clear();
 }
 
 // Pause/resume (paused upon create).
@@ -104,6 +129,16 @@ void channel::resume() NOEXCEPT
     BC_ASSERT_MSG(stranded(), "strand");
     start_expiration();
     start_inactivity();
+
+    // Announcements by the peer are known to the peer (once subscribed).
+    if (!inventoried_ && !quiet_ && !is_zero(settings_.announce_capacity))
+    {
+        inventoried_ = true;
+        subscribe<inventory>(
+            std::bind(&channel::handle_inventory,
+                shared_from_base<channel>(), _1, _2));
+    }
+
     proxy::resume();
 }
 
@@ -127,6 +162,16 @@ uint64_t channel::identifier() const NOEXCEPT
     return identifier_;
 }
 
+const network::settings& channel::settings() const NOEXCEPT
+{
+    return settings_;
+}
+
+steady_clock::duration channel::uptime() const NOEXCEPT
+{
+    return steady_clock::now() - created_;
+}
+
 size_t channel::start_height() const NOEXCEPT
 {
     return start_height_;
@@ -138,6 +183,44 @@ void channel::set_start_height(size_t height) NOEXCEPT
     start_height_ = height;
 }
 
+bool channel::block_relay() const NOEXCEPT
+{
+    return block_relay_;
+}
+
+void channel::set_block_relay(bool value) NOEXCEPT
+{
+    block_relay_ = value;
+}
+
+bool channel::wtxid_relay() const NOEXCEPT
+{
+    return wtxid_relay_;
+}
+
+void channel::set_wtxid_relay(bool value) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    wtxid_relay_ = value;
+}
+
+bool channel::reconciliation() const NOEXCEPT
+{
+    return reconciliation_;
+}
+
+const messages::siphash_key& channel::reconciliation_key() const NOEXCEPT
+{
+    return reconciliation_key_;
+}
+
+void channel::set_reconciliation(const messages::siphash_key& key) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    reconciliation_key_ = key;
+    reconciliation_ = true;
+}
+
 uint32_t channel::negotiated_version() const NOEXCEPT
 {
     return negotiated_version_;
@@ -167,6 +250,43 @@ void channel::set_peer_version(const version::cptr& value) NOEXCEPT
     peer_version_ = value;
 }
 
+broadcaster::capabilities_ptr channel::capabilities() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!capabilities_)
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        capabilities_ = std::make_shared<broadcaster::capabilities>();
+        BC_POP_WARNING()
+
+        const auto peer = peer_version();
+        capabilities_->services = peer->services;
+        capabilities_->version = negotiated_version();
+        capabilities_->relay = peer->relay && !block_relay_;
+    }
+
+    return capabilities_;
+}
+
+// The fee filter may be set before any subscription creates capabilities.
+void channel::set_fee_filter(uint64_t rate) NOEXCEPT
+{
+    boost::asio::dispatch(strand(),
+        [self = shared_from_base<channel>(), rate]() NOEXCEPT
+        {
+            self->capabilities()->fee_filter.store(rate,
+                std::memory_order_relaxed);
+        });
+}
+
+uint64_t channel::fee_filter() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return capabilities_ ? capabilities_->fee_filter.load(
+        std::memory_order_relaxed) : zero;
+}
+
 address_item_cptr channel::get_updated_address() const NOEXCEPT
 {
     // Copy peer address.
@@ -184,11 +304,6 @@ address_item_cptr channel::get_updated_address() const NOEXCEPT
 // ----------------------------------------------------------------------------
 // These are const except for version (safe) and signal_activity (stranded).
 
-size_t channel::minimum_buffer() const NOEXCEPT
-{
-    return settings_.minimum_buffer;
-}
-
 size_t channel::maximum_payload() const NOEXCEPT
 {
     return settings_.maximum_payload();
@@ -199,9 +314,145 @@ uint32_t channel::protocol_magic() const NOEXCEPT
     return settings_.identifier;
 }
 
+// A trusted channel (own infrastructure) does not validate checksums.
 bool channel::validate_checksum() const NOEXCEPT
 {
-    return settings_.validate_checksum;
+    return !trusted_ && settings_.validate_checksum;
+}
+
+bool channel::retain_payload() const NOEXCEPT
+{
+    return settings_.retain_payload;
+}
+
+size_t channel::maximum_gather_count() const NOEXCEPT
+{
+    return std::max(one, size_t{ settings_.gather_write_count });
+}
+
+size_t channel::maximum_gather_bytes() const NOEXCEPT
+{
+    return settings_.gather_write_bytes;
+}
+
+size_t channel::deserialize_threshold() const NOEXCEPT
+{
+    return settings_.deserialize_threshold;
+}
+
+size_t channel::read_chunk() const NOEXCEPT
+{
+    return settings_.read_chunk_bytes;
+}
+
+size_t channel::read_ahead() const NOEXCEPT
+{
+    return settings_.read_ahead_bytes;
+}
+
+size_t channel::write_slice() const NOEXCEPT
+{
+    return settings_.write_slice_bytes;
+}
+
+// A trusted channel retains its buffer regardless of recent payload sizes.
+size_t channel::buffer_retain() const NOEXCEPT
+{
+    return trusted_ && !is_zero(settings_.buffer_retain_bytes) ? one :
+        settings_.buffer_retain_bytes;
+}
+
+deadline::duration channel::buffer_idle() const NOEXCEPT
+{
+    return settings_.buffer_idle();
+}
+
+deadline::duration channel::read_quantum() const NOEXCEPT
+{
+    return settings_.read_quantum();
+}
+
+bool channel::batch_checksum() const NOEXCEPT
+{
+    return !is_zero(settings_.checksum_batch_microseconds);
+}
+
+bool channel::deduplicate_sends() const NOEXCEPT
+{
+    return settings_.deduplicate_sends;
+}
+
+bool channel::pool_sends() const NOEXCEPT
+{
+    return settings_.pool_sends;
+}
+
+// Configured in kilobytes per second, in each direction (trusted unlimited).
+size_t channel::rate_limit() const NOEXCEPT
+{
+    return trusted_ ? zero :
+        ceilinged_multiply(size_t{ settings_.rate_limit }, size_t{ 1024 });
+}
+
+size_t channel::send_high_water() const NOEXCEPT
+{
+    return settings_.send_high_water;
+}
+
+size_t channel::send_low_water() const NOEXCEPT
+{
+    return settings_.send_low_water;
+}
+
+deadline::duration channel::send_grace() const NOEXCEPT
+{
+    return settings_.send_grace();
+}
+
+size_t channel::compression_minimum() const NOEXCEPT
+{
+    return settings_.compression_minimum;
+}
+
+size_t channel::trace_sample() const NOEXCEPT
+{
+    return traced_ ? one : settings_.trace_sample;
+}
+
+uint64_t channel::trace_id() const NOEXCEPT
+{
+    return identifier_;
+}
+
+asio::io_context& channel::deserializer() NOEXCEPT
+{
+    return resources_->deserializers().service();
+}
+
+checksum_batcher& channel::checksums() NOEXCEPT
+{
+    return resources_->checksums();
+}
+
+metrics& channel::aggregate() NOEXCEPT
+{
+    return resources_->traffic();
+}
+
+upload_budget& channel::uploads() NOEXCEPT
+{
+    return resources_->uploads();
+}
+
+capture* channel::recorder() NOEXCEPT
+{
+    return capture_.get();
+}
+
+message_exporter* channel::exporter() NOEXCEPT
+{
+    return settings_.export_name.empty() ? nullptr :
+        &resources_->exporter();
 }
 
 uint32_t channel::version() const NOEXCEPT
@@ -209,16 +460,29 @@ uint32_t channel::version() const NOEXCEPT
     return negotiated_version();
 }
 
+bool channel::trusted() const NOEXCEPT
+{
+    return trusted_;
+}
+
 // Cancels previous timer and retains configured duration.
+// Lazy inactivity only records the time, checked when the timer fires.
 void channel::signal_activity() NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
-    return start_inactivity();
+
+    if (settings_.lazy_inactivity)
+    {
+        activity_ = coarse_clock::steady();
+        return;
+    }
+
+    start_inactivity();
 }
 
 // Timers.
 // ----------------------------------------------------------------------------
-// TODO: build DoS protection around rate_limit_, backlog(), total(), and time.
+// TODO: build DoS protection around backlog(), total(), and time.
 
 // Called from start or strand.
 // A restarted timer invokes completion handler with error::operation_canceled.
@@ -257,14 +521,21 @@ void channel::handle_expiration(const code& ec) NOEXCEPT
 void channel::start_inactivity() NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    activity_ = coarse_clock::steady();
+    start_inactivity(settings_.channel_inactivity());
+}
 
-    if (stopped())
+void channel::start_inactivity(const deadline::duration& timeout) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped() || !inactivity_)
         return;
 
     // Handler is posted to the socket strand.
     inactivity_->start(
         std::bind(&channel::handle_inactivity,
-            shared_from_base<channel>(), _1));
+            shared_from_base<channel>(), _1), timeout);
 }
 
 // There is no timeout set on individual sends and receives, just inactivity.
@@ -283,8 +554,216 @@ void channel::handle_inactivity(const code& ec) NOEXCEPT
         return;
     }
 
+    // Lazy inactivity restarts for the remainder if there has been activity.
+    if (settings_.lazy_inactivity)
+    {
+        const auto idle = coarse_clock::steady() - activity_;
+        const auto limit = settings_.channel_inactivity();
+        if (idle < limit)
+        {
+            start_inactivity(limit - idle);
+            return;
+        }
+    }
+
     stop(error::channel_inactive);
 }
 
+// Announcements.
+// ----------------------------------------------------------------------------
+// Queued inventory is flushed as one message, so that relay incurs one
+// heading and checksum per interval, and timing does not reveal origination.
+
+void channel::announce(const inventory_item& item) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped() || is_known(item.hash))
+        return;
+
+    set_known(item.hash);
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    announcements_.push_back(item);
+    BC_POP_WARNING()
+
+    // Without a trickle interval (or when full) the queue is sent now.
+    if (!trickle_ || is_zero(settings_.trickle_milliseconds) ||
+        announcements_.size() >= max_inventory)
+    {
+        flush_announcements();
+        return;
+    }
+
+    // The trickle timer runs only while there are queued announcements.
+    if (is_one(announcements_.size()))
+        start_trickle();
+}
+
+// Known hashes are retained in a rolling filter, oldest forgotten first.
+void channel::set_known(const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    known_.insert(hash);
+}
+
+bool channel::is_known(const hash_digest& hash) const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return known_.contains(hash);
+}
+
+// Round trip.
+// ----------------------------------------------------------------------------
+// Smoothing follows rfc6298: srtt += (sample - srtt) / 8 and
+// rttvar += (|srtt - sample| - rttvar) / 4, the first sample seeds both.
+
+channel::latency channel::round_trip() const NOEXCEPT
+{
+    return
+    {
+        rtt_smoothed_.load(std::memory_order_relaxed),
+        rtt_minimum_.load(std::memory_order_relaxed),
+        rtt_jitter_.load(std::memory_order_relaxed)
+    };
+}
+
+void channel::set_round_trip(uint64_t nanoseconds) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Zero is the unsampled sentinel, so samples are at least one.
+    const auto sample = std::max<uint64_t>(nanoseconds, one);
+    const auto smoothed = rtt_smoothed_.load(std::memory_order_relaxed);
+    const auto minimum = rtt_minimum_.load(std::memory_order_relaxed);
+    const auto jitter = rtt_jitter_.load(std::memory_order_relaxed);
+
+    if (is_zero(smoothed))
+    {
+        rtt_smoothed_.store(sample, std::memory_order_relaxed);
+        rtt_minimum_.store(sample, std::memory_order_relaxed);
+        rtt_jitter_.store(sample / two, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto deviation = sample > smoothed ? sample - smoothed :
+        smoothed - sample;
+
+    // Weighted sums of unsigned terms, so there is no underflow.
+    const auto next_smoothed = smoothed - smoothed / 8u + sample / 8u;
+    const auto next_jitter = jitter - jitter / 4u + deviation / 4u;
+
+    rtt_smoothed_.store(std::max<uint64_t>(next_smoothed, one),
+        std::memory_order_relaxed);
+    rtt_minimum_.store(std::min(minimum, sample), std::memory_order_relaxed);
+    rtt_jitter_.store(next_jitter, std::memory_order_relaxed);
+}
+
+// Memory.
+// ----------------------------------------------------------------------------
+// Protocol objects are counted as attached (retained until channel stop).
+
+proxy::footprint channel::memory() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    const auto timer = [](const deadline::ptr& value) NOEXCEPT
+    {
+        return value ? sizeof(deadline) : zero;
+    };
+
+    auto out = proxy::memory();
+    out.object = sizeof(channel) +
+        (capabilities_ ? sizeof(broadcaster::capabilities) : zero);
+
+    if (peer_version_)
+        out.object += sizeof(messages::version) +
+            peer_version_->user_agent.capacity();
+
+    out.buffers += capture_ ? sizeof(capture) : zero;
+    out.timers += timer(expiration_) + timer(inactivity_) + timer(trickle_);
+    out.protocols = protocols_;
+    out.filters = known_.bytes() +
+        announcements_.capacity() * sizeof(inventory_item);
+
+    return out;
+}
+
+// private
+bool channel::handle_inventory(const code& ec,
+    const inventory::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped() || ec)
+        return false;
+
+    for (const auto& item: message->items)
+        known_.insert(item.hash);
+
+    return true;
+}
+
+// A restarted timer invokes completion handler with error::operation_canceled.
+void channel::start_trickle() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped())
+        return;
+
+    // Handler is posted to the socket strand, interval varies by start.
+    trickle_->start(
+        std::bind(&channel::handle_trickle,
+            shared_from_base<channel>(), _1), settings_.channel_trickle());
+}
+
+void channel::handle_trickle(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // error::operation_canceled is set by timer reset (channel not stopped).
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        LOGF("Trickle timer fail [" << authority() << "] " << ec.message());
+        stop(ec);
+        return;
+    }
+
+    flush_announcements();
+}
+
+void channel::flush_announcements() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (announcements_.empty())
+        return;
+
+    // A flush before the interval leaves an idle timer, cancel it.
+    if (trickle_) trickle_->stop();
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    const inventory message{ std::move(announcements_) };
+    announcements_.clear();
+    BC_POP_WARNING()
+
+    send<inventory>(message,
+        std::bind(&channel::handle_announce,
+            shared_from_base<channel>(), _1));
+}
+
+void channel::handle_announce(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (ec && !stopped())
+    {
+        LOGF("Announcement fail [" << authority() << "] " << ec.message());
+    }
+}
+
 } // namespace network
 } // namespace libbitcoin
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/checksum_batcher.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/net/payload_hash.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+checksum_batcher::checksum_batcher(const duration& window) NOEXCEPT
+  : window_(std::max(window, duration{ 1 })),
+    timer_(pool_.service())
+{
+}
+
+checksum_batcher::~checksum_batcher() NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        stopped_ = true;
+    }
+
+    boost::asio::post(pool_.service(), [this]() NOEXCEPT
+    {
+        timer_.cancel();
+    });
+
+    pool_.stop();
+    pool_.join();
+}
+
+// A full group of lanes is hashed without waiting for the window.
+void checksum_batcher::submit(const chunk_ptr& payload, asio::strand& strand,
+    handler&& complete) NOEXCEPT
+{
+    jobs batch{};
+    auto arming = false;
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (stopped_)
+            return;
+
+        pending_.push_back({ payload, &strand, std::move(complete) });
+        if (pending_.size() >= payload_hash::lanes)
+            std::swap(batch, pending_);
+        else if (!armed_)
+            armed_ = arming = true;
+    }
+
+    if (!batch.empty())
+        boost::asio::post(pool_.service(),
+            [this, batch = std::move(batch)]() mutable NOEXCEPT
+            {
+                hash(std::move(batch));
+            });
+
+    if (arming)
+        boost::asio::post(pool_.service(),
+            std::bind(&checksum_batcher::arm, this));
+}
+
+// private
+// Called on the batcher thread only.
+void checksum_batcher::arm() NOEXCEPT
+{
+    timer_.expires_after(window_);
+    timer_.async_wait(std::bind(&checksum_batcher::handle_window, this, _1));
+}
+
+// Called on the batcher thread only.
+void checksum_batcher::handle_window(const error::boost_code& ec) NOEXCEPT
+{
+    jobs batch{};
+
+    {
+        std::unique_lock lock(mutex_);
+        armed_ = false;
+
+        if (stopped_ || ec)
+            return;
+
+        std::swap(batch, pending_);
+    }
+
+    hash(std::move(batch));
+}
+
+// Called on the batcher thread only.
+void checksum_batcher::hash(jobs&& batch) NOEXCEPT
+{
+    if (batch.empty())
+        return;
+
+    std::sort(batch.begin(), batch.end(),
+        [](const job& left, const job& right) NOEXCEPT
+        {
+            return left.payload->size() < right.payload->size();
+        });
+
+    std::vector<data_slice> payloads{};
+    payloads.reserve(batch.size());
+    for (const auto& item: batch)
+        payloads.emplace_back(*item.payload);
+
+    const auto hashes = payload_hash::batch(payloads);
+
+    for (size_t index = 0; index < batch.size(); ++index)
+    {
+        auto& item = batch[index];
+        item.payload.reset();
+        boost::asio::post(*item.strand,
+            [complete = std::move(item.complete),
+                hash = to_shared(hashes[index])]() NOEXCEPT
+            {
+                complete(hash);
+            });
+    }
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
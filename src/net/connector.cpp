@@ -21,6 +21,7 @@
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
@@ -39,16 +40,68 @@ using namespace system;
 using namespace network::config;
 using namespace std::placeholders;
 
+// Split resolved endpoints by address family, the family of the first is
+// primary. The secondary is empty if the name resolves to only one family.
+static std::pair<asio::endpoints, asio::endpoints> split(
+    const asio::endpoints& range) NOEXCEPT
+{
+    if (range.empty())
+        return {};
+
+    const auto v6 = range.begin()->endpoint().address().is_v6();
+    std::vector<asio::endpoint> primary{};
+    std::vector<asio::endpoint> secondary{};
+    for (const auto& entry: range)
+    {
+        auto& family = entry.endpoint().address().is_v6() == v6 ? primary :
+            secondary;
+        family.push_back(entry.endpoint());
+    }
+
+    const auto& first = *range.begin();
+    const auto host = first.host_name();
+    const auto service = first.service_name();
+    return
+    {
+        asio::endpoints::create(primary.begin(), primary.end(), host,
+            service),
+        asio::endpoints::create(secondary.begin(), secondary.end(), host,
+            service)
+    };
+}
+
 // Construct.
 // ----------------------------------------------------------------------------
 
 connector::connector(const logger& log, asio::strand& strand,
-    asio::io_context& service, const settings& settings) NOEXCEPT
+    asio::io_context& service, const settings& settings,
+    const resources::ptr& shared) NOEXCEPT
   : settings_(settings),
+    retained_(settings.retain()),
+    resources_(shared),
     service_(service),
+    services_(nullptr),
     strand_(strand),
     resolver_(strand),
-    timer_(std::make_shared<deadline>(log, strand, settings.connect_timeout())),
+    timer_(std::make_shared<deadline>(log, strand,
+        settings.connect_timeout(shared->connects()))),
+    reporter(log),
+    tracker<connector>(log)
+{
+}
+
+connector::connector(const logger& log, asio::strand& strand,
+    threadpools& services, const settings& settings,
+    const resources::ptr& shared) NOEXCEPT
+  : settings_(settings),
+    retained_(settings.retain()),
+    resources_(shared),
+    service_(strand.get_inner_executor().context()),
+    services_(&services),
+    strand_(strand),
+    resolver_(strand),
+    timer_(std::make_shared<deadline>(log, strand,
+        settings.connect_timeout(shared->connects()))),
     reporter(log),
     tracker<connector>(log)
 {
@@ -75,22 +128,41 @@ void connector::stop() NOEXCEPT
 // Methods.
 // ----------------------------------------------------------------------------
 
+// protected
+// Connected sockets are pinned to the (round robin) service of creation.
+asio::io_context& connector::socket_service() NOEXCEPT
+{
+    return is_null(services_) ? service_ : services_->service();
+}
+
+// Addresses and authorities are numeric, so are not resolved.
 void connector::connect(const address& host,
     socket_handler&& handler) NOEXCEPT
 {
-    start(host.to_host(), host.port(), host, std::move(handler));
+    start(asio::endpoint{ host.to_ip(), host.port() }, host,
+        std::move(handler));
 }
 
 void connector::connect(const authority& host,
     socket_handler&& handler) NOEXCEPT
 {
-    start(host.to_host(), host.port(), host.to_address_item(),
-        std::move(handler));
+    start(asio::endpoint{ config::denormalize(host.ip()), host.port() },
+        host.to_address_item(), std::move(handler));
 }
 
+// Endpoints are resolved unless numeric.
 void connector::connect(const endpoint& host,
     socket_handler&& handler) NOEXCEPT
 {
+    error::boost_code ec;
+    const auto ip = boost::asio::ip::make_address(host.host(), ec);
+    if (!ec)
+    {
+        start(asio::endpoint{ ip, host.port() }, host.to_address(),
+            std::move(handler));
+        return;
+    }
+
     start(host.host(), host.port(), host.to_address(), std::move(handler));
 }
 
@@ -108,16 +180,28 @@ void connector::start(const std::string& hostname, uint16_t port,
 
     // Capture the handler.
     racer_.start(std::move(handler));
+    dual_.reset();
 
     // Create a socket and shared finish context.
     const auto finish = std::make_shared<bool>(false);
-    const auto socket = std::make_shared<network::socket>(log, service_,
-        host);
+    const auto socket = std::allocate_shared<network::socket>(
+        network::socket::allocator{}, log, socket_service(), host);
 
-    // Posts handle_timer to strand.
+    // Posts handle_timer to strand (timeout may adapt to recent connects).
+    started_ = steady_clock::now();
     timer_->start(
         std::bind(&connector::handle_timer,
-            shared_from_this(), _1, finish, socket));
+            shared_from_this(), _1, finish, socket),
+        settings_.connect_timeout(resources_->connects()));
+
+    // Posts handle_resolve to strand, parallel and cached if configured.
+    if (!is_zero(settings_.resolve_threads))
+    {
+        ticket_ = resources_->resolutions().resolve(hostname, port, strand_,
+            std::bind(&connector::handle_resolve,
+                shared_from_this(), _1, _2, finish, socket));
+        return;
+    }
 
     // Posts handle_resolve to strand (async_resolve copies strings).
     resolver_.async_resolve(hostname, std::to_string(port),
@@ -125,12 +209,47 @@ void connector::start(const std::string& hostname, uint16_t port,
             shared_from_this(), _1, _2, finish, socket));
 }
 
+// protected
+void connector::start(const asio::endpoint& point,
+    const config::address& host, socket_handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    if (racer_.running())
+    {
+        handler(error::operation_failed, nullptr);
+        return;
+    }
+
+    // Capture the handler.
+    racer_.start(std::move(handler));
+    dual_.reset();
+
+    // Create a socket and shared finish context.
+    const auto finish = std::make_shared<bool>(false);
+    const auto socket = std::allocate_shared<network::socket>(
+        network::socket::allocator{}, log, socket_service(), host);
+
+    // Posts handle_timer to strand (timeout may adapt to recent connects).
+    started_ = steady_clock::now();
+    timer_->start(
+        std::bind(&connector::handle_timer,
+            shared_from_this(), _1, finish, socket),
+        settings_.connect_timeout(resources_->connects()));
+
+    // Posts do_handle_connect to the socket's strand (no resolve).
+    socket->connect(point, !is_zero(settings_.fast_open_queue),
+        std::bind(&connector::do_handle_connect,
+            shared_from_this(), _1, finish, socket));
+}
+
 // private
 void connector::handle_resolve(const error::boost_code& ec,
     const asio::endpoints& range, const finish_ptr& finish,
     const socket::ptr& socket) NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    ticket_ = zero;
 
     // Timer stopped the socket, it wins (with timeout/failure).
     if (socket->stopped())
@@ -148,6 +267,17 @@ void connector::handle_resolve(const error::boost_code& ec,
         return;
     }
 
+    // Race address families when the name resolves to both (RFC 8305).
+    if (!is_zero(settings_.connect_stagger_milliseconds))
+    {
+        const auto families = split(range);
+        if (!families.second.empty())
+        {
+            start_dual(families.first, families.second, finish, socket);
+            return;
+        }
+    }
+
     // Posts do_handle_connect to the socket's strand.
     // Establishes a socket connection by trying each endpoint in sequence.
     socket->connect(range,
@@ -155,12 +285,120 @@ void connector::handle_resolve(const error::boost_code& ec,
             shared_from_this(), _1, finish, socket));
 }
 
+// private
+// The primary family is connected on the socket, the secondary on an
+// alternate socket once staggered or the primary has failed. The first to
+// connect wins and the other is stopped, otherwise the last failure is
+// reported. Exactly one handle_connect results, with the winning socket.
+void connector::start_dual(const asio::endpoints& primary,
+    const asio::endpoints& secondary, const finish_ptr& finish,
+    const socket::ptr& socket) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    dual_ = std::make_shared<dual>(dual
+    {
+        std::allocate_shared<network::socket>(network::socket::allocator{},
+            log, socket_service(), socket->address()),
+        std::make_shared<deadline>(log, strand_, settings_.connect_stagger()),
+        two
+    });
+
+    // Posts handle_stagger to strand.
+    dual_->stagger->start(
+        std::bind(&connector::handle_stagger,
+            shared_from_this(), _1, secondary, finish, socket, dual_));
+
+    // Posts do_handle_attempt to the socket's strand.
+    socket->connect(primary,
+        std::bind(&connector::do_handle_attempt,
+            shared_from_this(), _1, finish, socket, socket, dual_));
+}
+
+// private
+void connector::handle_stagger(const code&, const asio::endpoints& range,
+    const finish_ptr& finish, const socket::ptr& socket,
+    const dual_ptr& state) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    // Stagger is also canceled by primary failure, which starts alternate.
+    // Winner or timer stopped the race, alternate is not started.
+    if (*finish || socket->stopped())
+    {
+        handle_attempt(error::operation_canceled, finish, state->alternate,
+            socket, state);
+        return;
+    }
+
+    // Posts do_handle_attempt to the alternate socket's strand.
+    state->alternate->connect(range,
+        std::bind(&connector::do_handle_attempt,
+            shared_from_this(), _1, finish, state->alternate, socket, state));
+}
+
+// private
+void connector::do_handle_attempt(const code& ec, const finish_ptr& finish,
+    const socket::ptr& attempt, const socket::ptr& socket,
+    const dual_ptr& state) NOEXCEPT
+{
+    BC_ASSERT_MSG(attempt->stranded(), "strand");
+
+    if (!ec)
+        attempt->set_options(settings_.socket_options());
+
+    boost::asio::post(strand_,
+        std::bind(&connector::handle_attempt,
+            shared_from_this(), ec, finish, attempt, socket, state));
+}
+
+// private
+void connector::handle_attempt(const code& ec, const finish_ptr& finish,
+    const socket::ptr& attempt, const socket::ptr& socket,
+    const dual_ptr& state) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    BC_ASSERT_MSG(!is_zero(state->attempts), "attempts");
+
+    const auto primary = (attempt == socket);
+    const auto last = is_zero(--state->attempts);
+
+    // Another attempt won, discard this one.
+    if (*finish)
+    {
+        attempt->stop();
+        return;
+    }
+
+    // First to connect wins (unless timer has stopped the race).
+    if (!ec && !socket->stopped())
+    {
+        state->stagger->stop();
+        (primary ? state->alternate : socket)->stop();
+        handle_connect(ec, finish, attempt);
+        return;
+    }
+
+    // Primary failure starts the alternate without further delay.
+    if (primary)
+        state->stagger->stop();
+    else
+        attempt->stop();
+
+    // The primary socket remains unstopped (unless by timer) for reporting.
+    if (last)
+        handle_connect(ec ? ec : error::operation_canceled, finish, socket);
+}
+
 // private
 void connector::do_handle_connect(const code& ec, const finish_ptr& finish,
     const socket::ptr& socket) NOEXCEPT
 {
     BC_ASSERT_MSG(socket->stranded(), "strand");
 
+    if (!ec)
+        socket->set_options(settings_.socket_options());
+
     boost::asio::post(strand_,
         std::bind(&connector::handle_connect,
             shared_from_this(), ec, finish, socket));
@@ -171,6 +409,7 @@ void connector::handle_connect(const code& ec, const finish_ptr& finish,
     const socket::ptr& socket) NOEXCEPT
 {
     BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    USDT2(connect, socket->stopped(), ec.value());
 
     // Timer stopped the socket, it wins (with timeout/failure).
     if (socket->stopped())
@@ -191,6 +430,11 @@ void connector::handle_connect(const code& ec, const finish_ptr& finish,
     // Successful connect (error::success), inform and cancel timer.
     *finish = true;
     timer_->stop();
+
+    // Connect durations are observed only if timeouts are adaptive.
+    if (!is_zero(settings_.timeout_minimum_milliseconds))
+        resources_->connects().sample(steady_clock::now() - started_);
+
     racer_.finish(error::success, socket);
 }
 
@@ -212,7 +456,8 @@ void connector::handle_timer(const code& ec, const finish_ptr& finish,
     if (ec)
     {
         socket->stop();
-        resolver_.cancel();
+        stop_dual();
+        cancel_resolve();
         racer_.finish(ec, socket);
         return;
     }
@@ -221,10 +466,38 @@ void connector::handle_timer(const code& ec, const finish_ptr& finish,
     // Timer fires with error::success, change to error::operation_timeout.
     // Stopped socket returned with failure code for option of host recovery.
     socket->stop();
-    resolver_.cancel();
+    stop_dual();
+    cancel_resolve();
     racer_.finish(error::operation_timeout, socket);
 }
 
+// private
+// A pending shared resolution is abandoned (its lookup is not interrupted).
+void connector::cancel_resolve() NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    resolver_.cancel();
+    if (!is_zero(ticket_))
+    {
+        resources_->resolutions().cancel(ticket_);
+        ticket_ = zero;
+    }
+}
+
+// private
+void connector::stop_dual() NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    if (dual_)
+    {
+        dual_->stagger->stop();
+        dual_->alternate->stop();
+        dual_.reset();
+    }
+}
+
 BC_POP_WARNING()
 
 } // namespace network
@@ -35,6 +35,18 @@ BC_DEBUG_ONLY(static const steady_clock::time_point epoch{};)
 deadline::deadline(const logger& log, asio::strand& strand,
     const duration& timeout) NOEXCEPT
   : duration_(timeout),
+    strand_(strand),
+    wheel_(nullptr),
+    timer_(strand),
+    tracker<deadline>(log)
+{
+}
+
+deadline::deadline(const logger& log, asio::strand& strand,
+    timer_wheel& wheel, const duration& timeout) NOEXCEPT
+  : duration_(timeout),
+    strand_(strand),
+    wheel_(&wheel),
     timer_(strand),
     tracker<deadline>(log)
 {
@@ -54,6 +66,23 @@ void deadline::start(result_handler&& handle) NOEXCEPT
 // Start/stop must not be called concurrently.
 void deadline::start(result_handler&& handle, const duration& timeout) NOEXCEPT
 {
+    // Timeouts below the wheel resolution fall back to the asio timer.
+    if (!is_null(wheel_) && timeout >= wheel_->resolution())
+    {
+        if (waiting_)
+        {
+            waiting_ = false;
+            timer_.cancel();
+        }
+
+        wheel_->start(key_, strand_, std::move(handle), timeout);
+        return;
+    }
+
+    if (!is_null(wheel_))
+        wheel_->stop(key_);
+
+    waiting_ = true;
     timer_.cancel();
     timer_.expires_after(timeout);
 
@@ -65,6 +94,10 @@ void deadline::start(result_handler&& handle, const duration& timeout) NOEXCEPT
 
 void deadline::stop() NOEXCEPT
 {
+    if (!is_null(wheel_))
+        wheel_->stop(key_);
+
+    waiting_ = false;
     timer_.cancel();
     BC_DEBUG_ONLY(timer_.expires_at(epoch);)
 }
@@ -18,8 +18,11 @@
  */
 #include <bitcoin/network/net/distributor.hpp>
 
+#include <array>
+#include <memory>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/log/log.hpp>
 #include <bitcoin/network/messages/messages.hpp>
 
 namespace libbitcoin {
@@ -27,135 +30,248 @@ namespace network {
 
 using namespace system;
 
-#define SUBSCRIBER(name) name##_subscriber_
-#define MAKE_SUBSCRIBER(name) SUBSCRIBER(name)(strand)
-#define STOP_SUBSCRIBER(name) SUBSCRIBER(name).stop_default(ec)
-#define CASE_NOTIFY(name) case messages::identifier::name: \
-    return do_notify<messages::name>(SUBSCRIBER(name), version, data)
+#define NOTIFIER(name) &distributor::do_notify<messages::name, Data>
+#define PREPARER(name) &distributor::do_prepare<messages::name, Data>
+
+using lane = distributor::lane;
+
+// Tables are indexed by identifier, with unknown (zero) unmapped, and sized by
+// their entries so that an identifier not added to a table fails to compile.
+// Default lanes, handshake and keep-alive ahead of large payloads.
+static constexpr std::array default_lanes
+{
+    lane::normal,   // unknown
+    lane::normal,   // address
+    lane::normal,   // alert
+    lane::bulk,     // block
+    lane::normal,   // bloom_filter_add
+    lane::normal,   // bloom_filter_clear
+    lane::normal,   // bloom_filter_load
+    lane::bulk,     // client_filter
+    lane::normal,   // client_filter_checkpoint
+    lane::normal,   // client_filter_headers
+    lane::bulk,     // compact_block
+    lane::normal,   // compact_transactions
+    lane::control,  // fee_filter
+    lane::normal,   // get_address
+    lane::normal,   // get_blocks
+    lane::normal,   // get_client_filter_checkpoint
+    lane::normal,   // get_client_filter_headers
+    lane::normal,   // get_client_filters
+    lane::normal,   // get_compact_transactions
+    lane::normal,   // get_data
+    lane::normal,   // get_headers
+    lane::normal,   // headers
+    lane::normal,   // inventory
+    lane::normal,   // memory_pool
+    lane::bulk,     // merkle_block
+    lane::normal,   // not_found
+    lane::control,  // ping
+    lane::control,  // pong
+    lane::control,  // reject
+    lane::control,  // send_compact
+    lane::control,  // send_headers
+    lane::normal,   // transaction
+    lane::control,  // version
+    lane::control,  // version_acknowledge
+    lane::control,  // wtxid_relay
+    lane::normal,   // reconciliation_difference
+    lane::normal,   // reconciliation_sketch
+    lane::control,  // request_reconciliation
+    lane::control,  // send_reconciliation
+    lane::control   // request_sketch_extension
+};
+
+static_assert(default_lanes.size() == distributor::identifiers,
+    "update dispatch tables");
 
 distributor::distributor(asio::strand& strand) NOEXCEPT
-  : MAKE_SUBSCRIBER(address),
-    MAKE_SUBSCRIBER(alert),
-    MAKE_SUBSCRIBER(block),
-    MAKE_SUBSCRIBER(bloom_filter_add),
-    MAKE_SUBSCRIBER(bloom_filter_clear),
-    MAKE_SUBSCRIBER(bloom_filter_load),
-    MAKE_SUBSCRIBER(client_filter),
-    MAKE_SUBSCRIBER(client_filter_checkpoint),
-    MAKE_SUBSCRIBER(client_filter_headers),
-    MAKE_SUBSCRIBER(compact_block),
-    MAKE_SUBSCRIBER(compact_transactions),
-    MAKE_SUBSCRIBER(fee_filter),
-    MAKE_SUBSCRIBER(get_address),
-    MAKE_SUBSCRIBER(get_blocks),
-    MAKE_SUBSCRIBER(get_client_filter_checkpoint),
-    MAKE_SUBSCRIBER(get_client_filter_headers),
-    MAKE_SUBSCRIBER(get_client_filters),
-    MAKE_SUBSCRIBER(get_compact_transactions),
-    MAKE_SUBSCRIBER(get_data),
-    MAKE_SUBSCRIBER(get_headers),
-    MAKE_SUBSCRIBER(headers),
-    MAKE_SUBSCRIBER(inventory),
-    MAKE_SUBSCRIBER(memory_pool),
-    MAKE_SUBSCRIBER(merkle_block),
-    MAKE_SUBSCRIBER(not_found),
-    MAKE_SUBSCRIBER(ping),
-    MAKE_SUBSCRIBER(pong),
-    MAKE_SUBSCRIBER(reject),
-    MAKE_SUBSCRIBER(send_compact),
-    MAKE_SUBSCRIBER(send_headers),
-    MAKE_SUBSCRIBER(transaction),
-    MAKE_SUBSCRIBER(version),
-    MAKE_SUBSCRIBER(version_acknowledge)
+  : strand_(strand), lanes_(default_lanes)
 {
 }
 
-code distributor::notify(messages::identifier id, uint32_t version,
-    const data_chunk& data) NOEXCEPT
+template <typename Data>
+code distributor::notify_data(messages::identifier id, uint32_t version,
+    const Data& data, const hash_cptr& hash) NOEXCEPT
 {
-    switch (id)
+    static constexpr auto notifiers = std::to_array<notifier<Data>>(
     {
-        CASE_NOTIFY(address);
-        CASE_NOTIFY(alert);
-        CASE_NOTIFY(block);
-        CASE_NOTIFY(bloom_filter_add);
-        CASE_NOTIFY(bloom_filter_clear);
-        CASE_NOTIFY(bloom_filter_load);
-        CASE_NOTIFY(client_filter);
-        CASE_NOTIFY(client_filter_checkpoint);
-        CASE_NOTIFY(client_filter_headers);
-        CASE_NOTIFY(compact_block);
-        CASE_NOTIFY(compact_transactions);
-        CASE_NOTIFY(fee_filter);
-        CASE_NOTIFY(get_address);
-        CASE_NOTIFY(get_blocks);
-        CASE_NOTIFY(get_client_filter_checkpoint);
-        CASE_NOTIFY(get_client_filter_headers);
-        CASE_NOTIFY(get_client_filters);
-        CASE_NOTIFY(get_compact_transactions);
-        CASE_NOTIFY(get_data);
-        CASE_NOTIFY(get_headers);
-        CASE_NOTIFY(headers);
-        CASE_NOTIFY(inventory);
-        CASE_NOTIFY(memory_pool);
-        CASE_NOTIFY(merkle_block);
-        CASE_NOTIFY(not_found);
-        CASE_NOTIFY(ping);
-        CASE_NOTIFY(pong);
-        CASE_NOTIFY(reject);
-        CASE_NOTIFY(send_compact);
-        CASE_NOTIFY(send_headers);
-        CASE_NOTIFY(transaction);
-        CASE_NOTIFY(version);
-        CASE_NOTIFY(version_acknowledge);
-        case messages::identifier::unknown:
-        default:
-            return error::unknown_message;
-    }
+        nullptr,
+        NOTIFIER(address),
+        NOTIFIER(alert),
+        NOTIFIER(block),
+        NOTIFIER(bloom_filter_add),
+        NOTIFIER(bloom_filter_clear),
+        NOTIFIER(bloom_filter_load),
+        NOTIFIER(client_filter),
+        NOTIFIER(client_filter_checkpoint),
+        NOTIFIER(client_filter_headers),
+        NOTIFIER(compact_block),
+        NOTIFIER(compact_transactions),
+        NOTIFIER(fee_filter),
+        NOTIFIER(get_address),
+        NOTIFIER(get_blocks),
+        NOTIFIER(get_client_filter_checkpoint),
+        NOTIFIER(get_client_filter_headers),
+        NOTIFIER(get_client_filters),
+        NOTIFIER(get_compact_transactions),
+        NOTIFIER(get_data),
+        NOTIFIER(get_headers),
+        NOTIFIER(headers),
+        NOTIFIER(inventory),
+        NOTIFIER(memory_pool),
+        NOTIFIER(merkle_block),
+        NOTIFIER(not_found),
+        NOTIFIER(ping),
+        NOTIFIER(pong),
+        NOTIFIER(reject),
+        NOTIFIER(send_compact),
+        NOTIFIER(send_headers),
+        NOTIFIER(transaction),
+        NOTIFIER(version),
+        NOTIFIER(version_acknowledge),
+        NOTIFIER(wtxid_relay),
+        NOTIFIER(reconciliation_difference),
+        NOTIFIER(reconciliation_sketch),
+        NOTIFIER(request_reconciliation),
+        NOTIFIER(send_reconciliation),
+        NOTIFIER(request_sketch_extension)
+    });
+
+    static_assert(notifiers.size() == identifiers, "update dispatch tables");
+
+    const auto index = static_cast<size_t>(id);
+    if (index >= notifiers.size() || is_zero(index))
+        return error::unknown_message;
+
+    return (this->*notifiers.at(index))(version, data, hash);
+}
+
+template <typename Data>
+code distributor::prepare_data(delivery& out, messages::identifier id,
+    uint32_t version, const Data& data, const hash_cptr& hash) NOEXCEPT
+{
+    static constexpr auto preparers = std::to_array<preparer<Data>>(
+    {
+        nullptr,
+        PREPARER(address),
+        PREPARER(alert),
+        PREPARER(block),
+        PREPARER(bloom_filter_add),
+        PREPARER(bloom_filter_clear),
+        PREPARER(bloom_filter_load),
+        PREPARER(client_filter),
+        PREPARER(client_filter_checkpoint),
+        PREPARER(client_filter_headers),
+        PREPARER(compact_block),
+        PREPARER(compact_transactions),
+        PREPARER(fee_filter),
+        PREPARER(get_address),
+        PREPARER(get_blocks),
+        PREPARER(get_client_filter_checkpoint),
+        PREPARER(get_client_filter_headers),
+        PREPARER(get_client_filters),
+        PREPARER(get_compact_transactions),
+        PREPARER(get_data),
+        PREPARER(get_headers),
+        PREPARER(headers),
+        PREPARER(inventory),
+        PREPARER(memory_pool),
+        PREPARER(merkle_block),
+        PREPARER(not_found),
+        PREPARER(ping),
+        PREPARER(pong),
+        PREPARER(reject),
+        PREPARER(send_compact),
+        PREPARER(send_headers),
+        PREPARER(transaction),
+        PREPARER(version),
+        PREPARER(version_acknowledge),
+        PREPARER(wtxid_relay),
+        PREPARER(reconciliation_difference),
+        PREPARER(reconciliation_sketch),
+        PREPARER(request_reconciliation),
+        PREPARER(send_reconciliation),
+        PREPARER(request_sketch_extension)
+    });
+
+    static_assert(preparers.size() == identifiers, "update dispatch tables");
+
+    const auto index = static_cast<size_t>(id);
+    if (index >= preparers.size() || is_zero(index))
+        return error::unknown_message;
+
+    return (this->*preparers.at(index))(out, version, data, hash);
+}
+
+distributor::lane distributor::priority(
+    messages::identifier id) const NOEXCEPT
+{
+    const auto index = static_cast<size_t>(id);
+    if (index >= lanes_.size())
+        return lane::normal;
+
+    return lanes_[index];
+}
+
+bool distributor::subscribed(messages::identifier id) const NOEXCEPT
+{
+    const auto index = static_cast<size_t>(id);
+    if (index >= slots_.size() || !slots_[index])
+        return false;
+
+    return !is_zero(slots_[index]->size());
+}
+
+size_t distributor::memory() const NOEXCEPT
+{
+    size_t bytes{};
+    for (const auto& entry: slots_)
+        if (entry) bytes += entry->bytes();
+
+    return bytes;
+}
+
+code distributor::notify(messages::identifier id, uint32_t version,
+    const data_chunk& data, const hash_cptr& hash) NOEXCEPT
+{
+    PROBE(distributor_notify);
+    const auto ec = notify_data(id, version, data, hash);
+    USDT4(notify, id, version, data.size(), ec.value());
+    return ec;
+}
+
+code distributor::notify(messages::identifier id, uint32_t version,
+    const chunk_ptr& data, const hash_cptr& hash) NOEXCEPT
+{
+    PROBE(distributor_notify);
+    const auto ec = notify_data(id, version, data, hash);
+    USDT4(notify, id, version, data->size(), ec.value());
+    return ec;
+}
+
+code distributor::prepare(delivery& out, messages::identifier id,
+    uint32_t version, const data_chunk& data, const hash_cptr& hash) NOEXCEPT
+{
+    return prepare_data(out, id, version, data, hash);
+}
+
+code distributor::prepare(delivery& out, messages::identifier id,
+    uint32_t version, const chunk_ptr& data, const hash_cptr& hash) NOEXCEPT
+{
+    return prepare_data(out, id, version, data, hash);
 }
 
 void distributor::stop(const code& ec) NOEXCEPT
 {
-    STOP_SUBSCRIBER(address);
-    STOP_SUBSCRIBER(address);
-    STOP_SUBSCRIBER(alert);
-    STOP_SUBSCRIBER(block);
-    STOP_SUBSCRIBER(bloom_filter_add);
-    STOP_SUBSCRIBER(bloom_filter_clear);
-    STOP_SUBSCRIBER(bloom_filter_load);
-    STOP_SUBSCRIBER(client_filter);
-    STOP_SUBSCRIBER(client_filter_checkpoint);
-    STOP_SUBSCRIBER(client_filter_headers);
-    STOP_SUBSCRIBER(compact_block);
-    STOP_SUBSCRIBER(compact_transactions);
-    STOP_SUBSCRIBER(fee_filter);
-    STOP_SUBSCRIBER(get_address);
-    STOP_SUBSCRIBER(get_blocks);
-    STOP_SUBSCRIBER(get_client_filter_checkpoint);
-    STOP_SUBSCRIBER(get_client_filter_headers);
-    STOP_SUBSCRIBER(get_client_filters);
-    STOP_SUBSCRIBER(get_compact_transactions);
-    STOP_SUBSCRIBER(get_data);
-    STOP_SUBSCRIBER(get_headers);
-    STOP_SUBSCRIBER(headers);
-    STOP_SUBSCRIBER(inventory);
-    STOP_SUBSCRIBER(memory_pool);
-    STOP_SUBSCRIBER(merkle_block);
-    STOP_SUBSCRIBER(not_found);
-    STOP_SUBSCRIBER(ping);
-    STOP_SUBSCRIBER(pong);
-    STOP_SUBSCRIBER(reject);
-    STOP_SUBSCRIBER(send_compact);
-    STOP_SUBSCRIBER(send_headers);
-    STOP_SUBSCRIBER(transaction);
-    STOP_SUBSCRIBER(version);
-    STOP_SUBSCRIBER(version_acknowledge);
+    // Subsequent subscriptions are rejected without creating a slot.
+    stopped_ = true;
+    for (const auto& entry: slots_)
+        if (entry) entry->stop(ec);
 }
 
-#undef SUBSCRIBER
-#undef MAKE_SUBSCRIBER
-#undef CASE_NOTIFY
-#undef STOP_SUBSCRIBER
+#undef NOTIFIER
+#undef PREPARER
 
 } // namespace network
 } // namespace libbitcoin
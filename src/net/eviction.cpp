@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/eviction.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Sort so that the protected candidates are the last count, then drop them.
+template <typename Less>
+static void protect(eviction::candidates& peers, size_t count,
+    Less&& less) NOEXCEPT
+{
+    count = std::min(count, peers.size());
+    std::sort(peers.begin(), peers.end(), std::forward<Less>(less));
+    peers.resize(peers.size() - count);
+}
+
+// Protect the longest lived member of each of count distinct groups. Groups
+// are ordered by a keyed mix, so that which are protected is unpredictable.
+static void protect_groups(eviction::candidates& peers, size_t count) NOEXCEPT
+{
+    static const auto key = pseudo_random::next<uint64_t>();
+    const auto keyed = [](uint64_t group) NOEXCEPT
+    {
+        return (group ^ key) * 0x9e3779b97f4a7c15_u64;
+    };
+
+    std::sort(peers.begin(), peers.end(), [&](const auto& left,
+        const auto& right) NOEXCEPT
+    {
+        const auto lefts = keyed(left.group);
+        const auto rights = keyed(right.group);
+        return lefts != rights ? lefts < rights : left.uptime > right.uptime;
+    });
+
+    // The first of each group run is its longest lived member.
+    auto group = peers.begin();
+    while (!is_zero(count) && group != peers.end())
+    {
+        const auto end = std::find_if(group, peers.end(), [&](const auto& peer)
+        {
+            return peer.group != group->group;
+        });
+
+        const auto run = std::distance(group, end);
+        group = std::next(peers.erase(group), sub1(run));
+        --count;
+    }
+}
+
+static uint64_t round_trip(const eviction::candidate& peer) NOEXCEPT
+{
+    return is_zero(peer.round_trip) ? max_uint64 : peer.round_trip;
+}
+
+// Processing nanoseconds per nanosecond of uptime.
+static double cost(const eviction::candidate& peer) NOEXCEPT
+{
+    const auto uptime = std::max(peer.uptime.count(), decltype(
+        peer.uptime.count()){ 1 });
+    return static_cast<double>(peer.processing) / static_cast<double>(uptime);
+}
+
+bool eviction::select(uint64_t& out, candidates peers) NOEXCEPT
+{
+    // Protect network group diversity.
+    protect_groups(peers, protect_group);
+
+    // Protect the lowest round trip (slowest sorted first).
+    protect(peers, protect_round_trip, [](const auto& left, const auto& right)
+    {
+        return round_trip(left) > round_trip(right);
+    });
+
+    // Protect the most bytes received (useful relay).
+    protect(peers, protect_received, [](const auto& left, const auto& right)
+    {
+        return left.received < right.received;
+    });
+
+    // Protect the longest lived of half of those remaining.
+    protect(peers, peers.size() / two, [](const auto& left, const auto& right)
+    {
+        return left.uptime < right.uptime;
+    });
+
+    if (peers.empty())
+        return false;
+
+    // Identify the group with most candidates, then the most costly member
+    // (ties to the youngest member).
+    std::unordered_map<uint32_t, size_t> counts{};
+    for (const auto& peer: peers)
+        ++counts[peer.group];
+
+    const auto worst = std::min_element(peers.begin(), peers.end(),
+        [&](const auto& left, const auto& right)
+        {
+            const auto lefts = counts[left.group];
+            const auto rights = counts[right.group];
+            if (lefts != rights)
+                return lefts > rights;
+
+            const auto left_cost = cost(left);
+            const auto right_cost = cost(right);
+            return left_cost != right_cost ? left_cost > right_cost :
+                left.uptime < right.uptime;
+        });
+
+    out = worst->identifier;
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
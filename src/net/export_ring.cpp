@@ -0,0 +1,312 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/export_ring.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+#if !defined(HAVE_MSC)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+
+constexpr auto identity = (uint64_t{ export_ring::ring_format } << 32) |
+    export_ring::ring_magic;
+
+// Sequence values of a slot being written (odd) and published (even).
+constexpr uint64_t writing(uint64_t sequence) NOEXCEPT
+{
+    return add1(two * sequence);
+}
+
+constexpr uint64_t published(uint64_t sequence) NOEXCEPT
+{
+    return two * add1(sequence);
+}
+
+constexpr size_t region(size_t slots, size_t arena) NOEXCEPT
+{
+    return ceilinged_add(ceilinged_multiply(add1(slots), size_t{ 64 }),
+        arena);
+}
+
+#if !defined(HAVE_MSC)
+
+export_ring::export_ring(const std::string& name, size_t arena,
+    size_t slots) NOEXCEPT
+  : name_(name), producer_(true)
+{
+    if (name.empty() || is_zero(arena))
+        return;
+
+    auto count = one;
+    while (count < slots && count < max_size_t / two)
+        count *= two;
+
+    // A prior region of the name (such as of a crashed process) is replaced.
+    // Payloads are peer traffic, so the region is private to the user.
+    ::shm_unlink(name_.c_str());
+    const auto descriptor = ::shm_open(name_.c_str(),
+        O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+    if (descriptor < 0)
+        return;
+
+    const auto size = region(count, arena);
+    const auto sized = ::ftruncate(descriptor,
+        possible_narrow_sign_cast<off_t>(size)) == 0;
+
+    if (!sized || !map(descriptor, size, true))
+    {
+        ::close(descriptor);
+        ::shm_unlink(name_.c_str());
+        return;
+    }
+
+    ::close(descriptor);
+    mask_ = sub1(count);
+    arena_ = arena;
+
+    // The region is zero filled, the identity is published last.
+    header_->slots.store(count, std::memory_order_relaxed);
+    header_->arena.store(arena, std::memory_order_relaxed);
+    header_->identity.store(identity, std::memory_order_release);
+}
+
+export_ring::export_ring(const std::string& name) NOEXCEPT
+  : name_(name), producer_(false)
+{
+    if (name.empty())
+        return;
+
+    const auto descriptor = ::shm_open(name_.c_str(), O_RDONLY, 0);
+    if (descriptor < 0)
+        return;
+
+    struct stat info{};
+    const auto sized = ::fstat(descriptor, &info) == 0 &&
+        info.st_size >= 64;
+
+    if (!sized || !map(descriptor,
+        possible_narrow_sign_cast<size_t>(info.st_size), false))
+    {
+        ::close(descriptor);
+        return;
+    }
+
+    ::close(descriptor);
+    const auto count = header_->slots.load(std::memory_order_relaxed);
+    const auto arena = header_->arena.load(std::memory_order_relaxed);
+
+    if (header_->identity.load(std::memory_order_acquire) != identity ||
+        is_zero(count) || !is_zero(count & sub1(count)) || is_zero(arena) ||
+        region(possible_narrow_cast<size_t>(count),
+            possible_narrow_cast<size_t>(arena)) != size_)
+    {
+        ::munmap(header_, size_);
+        header_ = nullptr;
+        return;
+    }
+
+    mask_ = possible_narrow_cast<size_t>(sub1(count));
+    arena_ = possible_narrow_cast<size_t>(arena);
+}
+
+export_ring::~export_ring() NOEXCEPT
+{
+    if (!is_null(header_))
+        ::munmap(header_, size_);
+
+    if (producer_ && !name_.empty())
+        ::shm_unlink(name_.c_str());
+}
+
+bool export_ring::map(int descriptor, size_t size, bool writable) NOEXCEPT
+{
+    const auto address = ::mmap(nullptr, size, writable ?
+        PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+
+    if (address == MAP_FAILED)
+        return false;
+
+    header_ = reinterpret_cast<header*>(address);
+    size_ = size;
+    return true;
+}
+
+#else
+
+export_ring::export_ring(const std::string& name, size_t, size_t) NOEXCEPT
+  : name_(name), producer_(true)
+{
+}
+
+export_ring::export_ring(const std::string& name) NOEXCEPT
+  : name_(name), producer_(false)
+{
+}
+
+export_ring::~export_ring() NOEXCEPT
+{
+}
+
+bool export_ring::map(int, size_t, bool) NOEXCEPT
+{
+    return false;
+}
+
+#endif
+
+bool export_ring::good() const NOEXCEPT
+{
+    return !is_null(header_);
+}
+
+size_t export_ring::capacity() const NOEXCEPT
+{
+    return arena_;
+}
+
+// The arena cursor is advanced before any byte of an older record is
+// overwritten, so a reader that sees overwritten bytes also sees the cursor.
+bool export_ring::write(messages::identifier id, uint64_t channel,
+    uint32_t version, const data_slice& payload) NOEXCEPT
+{
+    const auto size = payload.size();
+    if (!producer_ || !good() || size > arena_)
+        return false;
+
+    const auto sequence = header_->head.load(std::memory_order_relaxed);
+    auto position = header_->cursor.load(std::memory_order_relaxed);
+
+    // A payload is contiguous, so one that would wrap starts the arena.
+    const auto offset = position % arena_;
+    if (offset + size > arena_)
+        position += arena_ - offset;
+
+    auto& entry = at(sequence);
+    header_->cursor.store(position + size, std::memory_order_relaxed);
+    entry.sequence.store(writing(sequence), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (!is_zero(size))
+        std::memcpy(arena() + position % arena_, payload.data(), size);
+
+    entry.position.store(position, std::memory_order_relaxed);
+    entry.channel.store(channel, std::memory_order_relaxed);
+    entry.size.store(size, std::memory_order_relaxed);
+    entry.id.store(static_cast<uint64_t>(id), std::memory_order_relaxed);
+    entry.version.store(version, std::memory_order_relaxed);
+    entry.sequence.store(published(sequence), std::memory_order_release);
+    header_->head.store(add1(sequence), std::memory_order_release);
+    return true;
+}
+
+uint64_t export_ring::head() const NOEXCEPT
+{
+    return good() ? header_->head.load(std::memory_order_acquire) : zero;
+}
+
+uint64_t export_ring::tail() const NOEXCEPT
+{
+    const auto next = head();
+    const auto slots = add1<uint64_t>(mask_);
+    return next > slots ? next - slots : zero;
+}
+
+export_ring::status export_ring::read(record& out,
+    uint64_t sequence) const NOEXCEPT
+{
+    if (!good())
+        return status::pending;
+
+    const auto& entry = at(sequence);
+    const auto current = entry.sequence.load(std::memory_order_acquire);
+    if (current < published(sequence))
+        return status::pending;
+
+    if (current > published(sequence))
+        return status::lapped;
+
+    const auto position = entry.position.load(std::memory_order_relaxed);
+    const auto size = entry.size.load(std::memory_order_relaxed);
+    const auto offset = position % arena_;
+
+    // Values of an overwritten slot are not trusted to bound the payload.
+    if (size > arena_ || offset + size > arena_)
+        return status::lapped;
+
+    const auto begin = arena() + offset;
+    out.sequence = sequence;
+    out.position = position;
+    out.channel = entry.channel.load(std::memory_order_relaxed);
+    out.version = possible_narrow_cast<uint32_t>(
+        entry.version.load(std::memory_order_relaxed));
+    out.id = static_cast<messages::identifier>(
+        entry.id.load(std::memory_order_relaxed));
+    out.payload = { begin, std::next(begin, possible_narrow_cast<size_t>(
+        size)) };
+    return status::ready;
+}
+
+bool export_ring::intact(const record& record) const NOEXCEPT
+{
+    if (!good())
+        return false;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto& entry = at(record.sequence);
+    const auto cursor = header_->cursor.load(std::memory_order_relaxed);
+    return entry.sequence.load(std::memory_order_relaxed) ==
+        published(record.sequence) && cursor - record.position <= arena_;
+}
+
+// private
+export_ring::slot& export_ring::at(uint64_t sequence) const NOEXCEPT
+{
+    const auto slots = reinterpret_cast<slot*>(std::next(header_));
+    return slots[sequence & mask_];
+}
+
+uint8_t* export_ring::arena() const NOEXCEPT
+{
+    return reinterpret_cast<uint8_t*>(header_) + region(add1(mask_), zero);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
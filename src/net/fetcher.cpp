@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/fetcher.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+using namespace std::chrono;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Exponentially weighted (1/8) moving average, seeded by the first sample.
+static uint64_t smooth(uint64_t average, uint64_t sample) NOEXCEPT
+{
+    return is_zero(average) ? sample : (average * 7u + sample) / 8u;
+}
+
+fetcher::fetcher(size_t window, const steady_clock::duration& stall) NOEXCEPT
+  : window_(std::max(one, window)), stall_(stall)
+{
+}
+
+// Methods.
+// ----------------------------------------------------------------------------
+
+void fetcher::enqueue(const inventory_items& items) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    for (const auto& item: items)
+    {
+        if (flights_.contains(item.hash) || !queued_.insert(item.hash).second)
+            continue;
+
+        queue_.push_back({ item, {} });
+    }
+}
+
+inventory_items fetcher::request(uint64_t channel) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    auto& value = peers_[channel];
+    const auto limit = window(value);
+    if (value.in_flight >= limit)
+        return {};
+
+    inventory_items out{};
+    const auto now = steady_clock::now();
+    for (auto it = queue_.begin(); it != queue_.end() &&
+        value.in_flight < limit;)
+    {
+        // Exclusions are cleared once every known channel has failed.
+        auto& excluded = it->excluded;
+        if (excluded.size() >= peers_.size())
+            excluded.clear();
+
+        if (std::find(excluded.begin(), excluded.end(), channel) !=
+            excluded.end())
+        {
+            ++it;
+            continue;
+        }
+
+        out.push_back(it->item);
+        queued_.erase(it->item.hash);
+        flights_.emplace(it->item.hash,
+            flight{ it->item, std::move(excluded), channel, now });
+
+        ++value.in_flight;
+        it = queue_.erase(it);
+    }
+
+    return out;
+}
+
+bool fetcher::received(uint64_t channel, const hash_digest& hash) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    const auto it = flights_.find(hash);
+    if (it == flights_.end() || it->second.channel != channel)
+        return false;
+
+    auto& value = peers_[channel];
+    const auto now = steady_clock::now();
+    const auto trip = duration_cast<microseconds>(now - it->second.sent);
+    const auto sample = std::max<uint64_t>(one,
+        possible_narrow_sign_cast<uint64_t>(trip.count()));
+
+    value.round_trip = smooth(value.round_trip, sample);
+    value.minimum = is_zero(value.minimum) ? sample :
+        std::min(value.minimum, sample);
+
+    // Delivery rate is sampled only while pipelined (others in flight).
+    if (value.in_flight > one && value.last != steady_clock::time_point{})
+    {
+        const auto gap = duration_cast<microseconds>(now - value.last);
+        const auto interval = std::max<uint64_t>(one,
+            possible_narrow_sign_cast<uint64_t>(gap.count()));
+
+        value.rate = smooth(value.rate, 1'000'000u / interval);
+    }
+
+    value.last = now;
+    --value.in_flight;
+    flights_.erase(it);
+    return true;
+}
+
+bool fetcher::not_found(uint64_t channel, const hash_digest& hash) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    const auto it = flights_.find(hash);
+    if (it == flights_.end() || it->second.channel != channel)
+        return false;
+
+    requeue(it, true);
+    return true;
+}
+
+size_t fetcher::expire(uint64_t channel) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    size_t count{};
+    const auto now = steady_clock::now();
+    for (auto it = flights_.begin(); it != flights_.end();)
+    {
+        const auto next = std::next(it);
+        if (it->second.channel == channel && now - it->second.sent >= stall_)
+        {
+            requeue(it, true);
+            ++count;
+        }
+
+        it = next;
+    }
+
+    return count;
+}
+
+void fetcher::release(uint64_t channel) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    for (auto it = flights_.begin(); it != flights_.end();)
+    {
+        const auto next = std::next(it);
+        if (it->second.channel == channel)
+            requeue(it, false);
+
+        it = next;
+    }
+
+    peers_.erase(channel);
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+size_t fetcher::window(uint64_t channel) const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    const auto it = peers_.find(channel);
+    return it == peers_.end() ? window_ : window(it->second);
+}
+
+steady_clock::duration fetcher::round_trip(uint64_t channel) const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    const auto it = peers_.find(channel);
+    return it == peers_.end() ? steady_clock::duration::zero() :
+        microseconds(it->second.round_trip);
+}
+
+size_t fetcher::queued() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return queue_.size();
+}
+
+size_t fetcher::in_flight() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return flights_.size();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Twice the delivery rate over the minimum round trip (queueing excluded),
+// plus one to allow growth, bounded by the maximum.
+size_t fetcher::window(const peer& value) const NOEXCEPT
+{
+    if (is_zero(value.rate) || is_zero(value.minimum))
+        return window_;
+
+    const auto product = ceilinged_multiply(value.rate, value.minimum) /
+        1'000'000u;
+
+    const auto window = ceilinged_add(ceilinged_multiply(product, two), one);
+    return std::clamp(limit<size_t>(window), one, window_);
+}
+
+// Requeued items precede others, a failed channel is excluded.
+void fetcher::requeue(flights::iterator it, bool failed) NOEXCEPT
+{
+    auto& entry = it->second;
+    auto& value = peers_[entry.channel];
+    if (!is_zero(value.in_flight))
+        --value.in_flight;
+
+    if (failed)
+        entry.excluded.push_back(entry.channel);
+
+    queued_.insert(entry.item.hash);
+    queue_.push_front({ entry.item, std::move(entry.excluded) });
+    flights_.erase(it);
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/filter_cache.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// BIP157 checkpoints are at each 1000 blocks.
+constexpr size_t checkpoint_interval = 1'000;
+
+// The found entry is moved to the front (most recent), caller must lock.
+template <typename List, typename Index>
+static bool touch(List& list, Index& index,
+    const typename Index::key_type& key) NOEXCEPT
+{
+    const auto it = index.find(key);
+    if (it == index.end())
+        return false;
+
+    list.splice(list.begin(), list, it->second);
+    return true;
+}
+
+// Existing entries are replaced, the least recent is evicted, caller must lock.
+template <typename List, typename Index, typename Value>
+static void emplace(List& list, Index& index, size_t capacity,
+    const typename Index::key_type& key, const Value& value) NOEXCEPT
+{
+    if (is_zero(capacity))
+        return;
+
+    if (touch(list, index, key))
+    {
+        list.front().second = value;
+        return;
+    }
+
+    if (list.size() >= capacity)
+    {
+        index.erase(list.back().first);
+        list.pop_back();
+    }
+
+    list.emplace_front(key, value);
+    index.emplace(key, list.begin());
+}
+
+filter_cache::filter_cache(size_t capacity) NOEXCEPT
+  : header_capacity_(capacity),
+    checkpoint_capacity_(is_zero(capacity) ? zero :
+        std::max(one, capacity / checkpoint_interval))
+{
+}
+
+bool filter_cache::find(header& out, uint8_t type,
+    const hash_digest& block) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    if (!touch(headers_, header_index_, { type, block }))
+        return false;
+
+    out = headers_.front().second;
+    return true;
+}
+
+void filter_cache::store(uint8_t type, const hash_digest& block,
+    const header& value) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    emplace(headers_, header_index_, header_capacity_, { type, block }, value);
+}
+
+client_filter_checkpoint::cptr filter_cache::find(uint8_t type,
+    const hash_digest& stop) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    if (!touch(checkpoints_, checkpoint_index_, { type, stop }))
+        return {};
+
+    return checkpoints_.front().second;
+}
+
+void filter_cache::store(
+    const client_filter_checkpoint::cptr& checkpoint) NOEXCEPT
+{
+    if (!checkpoint)
+        return;
+
+    std::lock_guard lock(mutex_);
+    emplace(checkpoints_, checkpoint_index_, checkpoint_capacity_,
+        { checkpoint->filter_type, checkpoint->stop_hash }, checkpoint);
+}
+
+size_t filter_cache::size() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return headers_.size();
+}
+
+size_t filter_cache::checkpoints() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return checkpoints_.size();
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
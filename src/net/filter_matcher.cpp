@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/filter_matcher.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+
+// Big-endian (most significant first) bit stream, buffered a word at a time.
+// Unbuffered (low) bits of the word are always zero.
+class golomb_reader
+{
+public:
+    golomb_reader(const uint8_t* begin, const uint8_t* end) NOEXCEPT
+      : it_(begin), end_(end)
+    {
+    }
+
+    // The quotient, a run of one bits terminated by a zero bit.
+    bool read_unary(uint64_t& out) NOEXCEPT
+    {
+        out = zero;
+        while (true)
+        {
+            fill();
+            if (is_zero(bits_))
+                return false;
+
+            const auto ones = possible_narrow_cast<size_t>(
+                std::countl_one(buffer_));
+
+            if (ones < bits_)
+            {
+                out += ones;
+                skip(add1(ones));
+                return true;
+            }
+
+            out += ones;
+            skip(ones);
+        }
+    }
+
+    // The remainder, of the given bit width (at most 56).
+    bool read_bits(uint64_t& out, size_t width) NOEXCEPT
+    {
+        fill();
+        if (bits_ < width)
+            return false;
+
+        out = buffer_ >> (64u - width);
+        skip(width);
+        return true;
+    }
+
+private:
+    void fill() NOEXCEPT
+    {
+        while (bits_ <= 56u && it_ != end_)
+        {
+            buffer_ |= uint64_t{ *it_++ } << (56u - bits_);
+            bits_ += byte_bits;
+        }
+    }
+
+    void skip(size_t bits) NOEXCEPT
+    {
+        buffer_ = bits < 64u ? buffer_ << bits : 0;
+        bits_ -= bits;
+    }
+
+    const uint8_t* it_;
+    const uint8_t* end_;
+    uint64_t buffer_{};
+    size_t bits_{};
+};
+
+// static
+siphash_key filter_matcher::to_key(const hash_digest& block_hash) NOEXCEPT
+{
+    siphash_key key{};
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+    {
+        key.k0 |= uint64_t{ block_hash.at(byte) } << to_bits(byte);
+        key.k1 |= uint64_t{ block_hash.at(byte + sizeof(uint64_t)) } <<
+            to_bits(byte);
+    }
+
+    return key;
+}
+
+// static
+uint64_t filter_matcher::to_range(uint64_t hash, uint64_t range) NOEXCEPT
+{
+    // High word of the 128 bit product, from the four 32 bit partials.
+    constexpr auto mask = 0x00000000ffffffff_u64;
+    const auto low = (hash & mask) * (range & mask);
+    const auto middle1 = (hash >> 32) * (range & mask);
+    const auto middle2 = (hash & mask) * (range >> 32);
+    const auto high = (hash >> 32) * (range >> 32);
+    const auto carry = ((low >> 32) + (middle1 & mask) + (middle2 & mask)) >>
+        32;
+    return high + (middle1 >> 32) + (middle2 >> 32) + carry;
+}
+
+filter_matcher::filter_matcher(const data_stack& items) NOEXCEPT
+  : items_(items)
+{
+}
+
+size_t filter_matcher::size() const NOEXCEPT
+{
+    return items_.size();
+}
+
+bool filter_matcher::match(const hash_digest& block_hash,
+    const data_slice& filter) const NOEXCEPT
+{
+    if (items_.empty())
+        return false;
+
+    read::bytes::copy source(filter);
+    const auto count = source.read_size();
+
+    // A count beyond 32 bits cannot be coded within a block (invalid).
+    if (!source || count > max_uint32)
+        return true;
+
+    if (is_zero(count))
+        return false;
+
+    const auto range = count * golomb_range;
+    auto targets = siphash(to_key(block_hash), items_);
+    for (auto& target: targets)
+        target = to_range(target, range);
+
+    std::sort(targets.begin(), targets.end());
+
+    const auto begin = std::next(filter.data(), source.get_read_position());
+    golomb_reader reader(begin, std::next(filter.data(), filter.size()));
+    auto target = targets.begin();
+    uint64_t value{};
+
+    for (size_t item = 0; item < count; ++item)
+    {
+        uint64_t quotient{}, remainder{};
+        if (!reader.read_unary(quotient) ||
+            !reader.read_bits(remainder, golomb_bits))
+            return true;
+
+        value += (quotient << golomb_bits) | remainder;
+        while (*target < value)
+            if (++target == targets.end())
+                return false;
+
+        if (*target == value)
+            return true;
+    }
+
+    return false;
+}
+
+bool filter_matcher::match(const client_filter& filter) const NOEXCEPT
+{
+    return filter.filter_type != basic ||
+        match(filter.block_hash, filter.filter);
+}
+
+std::vector<size_t> filter_matcher::match(
+    const filters& filters) const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::vector<size_t> out{};
+    for (size_t index = 0; index < filters.size(); ++index)
+        if (filters.at(index) && match(*filters.at(index)))
+            out.push_back(index);
+
+    return out;
+    BC_POP_WARNING()
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,343 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/handoff.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+#if !defined(HAVE_MSC)
+    #include <cerrno>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+#if !defined(HAVE_MSC)
+
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+
+constexpr auto control_size = CMSG_SPACE(sizeof(int) *
+    handoff::maximum_listeners);
+
+// The peer of the connection is a process of this (effective) user.
+static bool is_owner(int connection) NOEXCEPT
+{
+#if defined(SO_PEERCRED)
+    ucred credentials{};
+    auto size = static_cast<socklen_t>(sizeof(credentials));
+    return ::getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials,
+        &size) == 0 && credentials.uid == ::geteuid();
+#else
+    uid_t user{};
+    gid_t group{};
+    return ::getpeereid(connection, &user, &group) == 0 &&
+        user == ::geteuid();
+#endif
+}
+
+// The directory is created private (0700) if missing, and must otherwise be
+// owned by this user without group or other access, so that the socket is
+// not reachable by others (including between bind and chmod).
+static bool is_private(const std::filesystem::path& directory) NOEXCEPT
+{
+    const auto text = directory.empty() ? std::string{ "." } :
+        directory.string();
+
+    if (::mkdir(text.c_str(), S_IRWXU) < 0 && errno != EEXIST)
+        return false;
+
+    struct stat info{};
+    return ::lstat(text.c_str(), &info) == 0 && S_ISDIR(info.st_mode) &&
+        info.st_uid == ::geteuid() &&
+        is_zero(info.st_mode & (S_IRWXG | S_IRWXO));
+}
+
+// A prior socket at the path is removed only if it is a socket of this user,
+// false if the path is otherwise occupied.
+static bool is_released(const std::filesystem::path& path) NOEXCEPT
+{
+    struct stat info{};
+    const auto text = path.string();
+    if (::lstat(text.c_str(), &info) < 0)
+        return errno == ENOENT;
+
+    if (!S_ISSOCK(info.st_mode) || info.st_uid != ::geteuid())
+        return false;
+
+    return ::unlink(text.c_str()) == 0 || errno == ENOENT;
+}
+
+// Send the count and the descriptors in one message (blocking).
+static code give(int connection, const handoff::descriptors& handles) NOEXCEPT
+{
+    if (handles.size() > handoff::maximum_listeners)
+        return error::operation_failed;
+
+    auto count = possible_narrow_cast<uint8_t>(handles.size());
+    iovec vector{ &count, sizeof(count) };
+    std::array<char, control_size> control{};
+
+    msghdr message{};
+    message.msg_iov = &vector;
+    message.msg_iovlen = one;
+    message.msg_control = control.data();
+    message.msg_controllen = CMSG_SPACE(sizeof(int) * handles.size());
+
+    const auto header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int) * handles.size());
+    std::memcpy(CMSG_DATA(header), handles.data(),
+        sizeof(int) * handles.size());
+
+    return ::sendmsg(connection, &message, MSG_NOSIGNAL) ==
+        sizeof(count) ? error::success : error::bad_stream;
+}
+
+// static
+code handoff::take(listeners& out, const std::filesystem::path& path,
+    const steady_clock::duration& timeout) NOEXCEPT
+{
+    out.clear();
+    const auto text = path.string();
+    sockaddr_un address{};
+    if (text.empty() || text.size() >= sizeof(address.sun_path))
+        return error::invalid_configuration;
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, text.data(), text.size());
+
+    const auto connection = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (connection < 0)
+        return error::operation_failed;
+
+    using namespace std::chrono;
+    const auto micro = duration_cast<microseconds>(timeout).count();
+    timeval wait{};
+    wait.tv_sec = static_cast<decltype(wait.tv_sec)>(micro / 1'000'000);
+    wait.tv_usec = static_cast<decltype(wait.tv_usec)>(micro % 1'000'000);
+    ::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &wait, sizeof(wait));
+
+    // Descriptors are taken only from a process of this user.
+    if (::connect(connection, reinterpret_cast<const sockaddr*>(&address),
+        sizeof(address)) < 0 || !is_owner(connection))
+    {
+        ::close(connection);
+        return error::connect_failed;
+    }
+
+    uint8_t count{};
+    iovec vector{ &count, sizeof(count) };
+    std::array<char, control_size> control{};
+
+    msghdr message{};
+    message.msg_iov = &vector;
+    message.msg_iovlen = one;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    const auto received = ::recvmsg(connection, &message, MSG_CMSG_CLOEXEC);
+    ::close(connection);
+
+    for (auto header = CMSG_FIRSTHDR(&message); header != nullptr;
+        header = CMSG_NXTHDR(&message, header))
+    {
+        if (header->cmsg_level != SOL_SOCKET ||
+            header->cmsg_type != SCM_RIGHTS)
+            continue;
+
+        const auto handles = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t index = 0; index < handles; ++index)
+        {
+            descriptor handle{};
+            std::memcpy(&handle, CMSG_DATA(header) + index * sizeof(int),
+                sizeof(int));
+
+            // The bound endpoint identifies the listener for adoption.
+            asio::endpoint local{};
+            auto size = static_cast<socklen_t>(local.capacity());
+            if (::getsockname(handle, local.data(), &size) < 0)
+            {
+                ::close(handle);
+                continue;
+            }
+
+            local.resize(size);
+            out.push_back({ local, handle });
+        }
+    }
+
+    // Truncated control implies a lost descriptor (the rest are valid).
+    if (received != sizeof(count) || out.size() != count ||
+        to_bool(message.msg_flags & MSG_CTRUNC))
+    {
+        release(out);
+        out.clear();
+        return error::bad_stream;
+    }
+
+    return error::success;
+}
+
+// static
+void handoff::release(const listeners& listeners) NOEXCEPT
+{
+    for (const auto& listener: listeners)
+        ::close(listener.handle);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+handoff::handoff(asio::strand& strand) NOEXCEPT
+  : strand_(strand), acceptor_(strand)
+{
+}
+
+code handoff::offer(const std::filesystem::path& path, descriptors&& handles,
+    result_handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+
+    if (acceptor_.is_open())
+        return error::operation_failed;
+
+    // The prior process (if any) has released the path, or is gone.
+    if (!is_private(path.parent_path()) || !is_released(path))
+        return error::invalid_configuration;
+
+    error::boost_code ec{};
+    const boost::asio::local::stream_protocol::endpoint point(path.string());
+    acceptor_.open(point.protocol(), ec);
+
+    if (!ec)
+        acceptor_.bind(point, ec);
+
+    // Owner only, though the private directory already excludes others.
+    if (!ec && ::chmod(path.c_str(), S_IRUSR | S_IWUSR) < 0)
+        ec = error::boost_code{ errno, boost::system::system_category() };
+
+    if (!ec)
+        acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+
+    if (ec)
+    {
+        error::boost_code ignored{};
+        acceptor_.close(ignored);
+        return error::listen_failed;
+    }
+
+    handles_ = std::move(handles);
+    handler_ = std::move(handler);
+    do_accept();
+    return error::success;
+}
+
+void handoff::do_accept() NOEXCEPT
+{
+    acceptor_.async_accept(
+        [self = shared_from_this()](const error::boost_code& ec,
+            boost::asio::local::stream_protocol::socket connection) NOEXCEPT
+        {
+            BC_ASSERT_MSG(self->strand_.running_in_this_thread(), "strand");
+
+            // Canceled (stopped), the handler is not invoked.
+            if (ec == boost::asio::error::operation_aborted ||
+                !self->acceptor_.is_open())
+                return;
+
+            // Listeners are given only to a process of this user, and a failed
+            // transfer leaves the listeners here, so offer again.
+            if (ec || !is_owner(connection.native_handle()) ||
+                give(connection.native_handle(), self->handles_))
+            {
+                self->do_accept();
+                return;
+            }
+
+            error::boost_code ignore{};
+            self->acceptor_.close(ignore);
+            self->handler_(error::success);
+        });
+}
+
+void handoff::stop() NOEXCEPT
+{
+    BC_ASSERT_MSG(strand_.running_in_this_thread(), "strand");
+    error::boost_code ignore{};
+    acceptor_.close(ignore);
+}
+
+#else
+
+// static
+code handoff::take(listeners& out, const std::filesystem::path&,
+    const steady_clock::duration&) NOEXCEPT
+{
+    out.clear();
+    return error::not_allowed;
+}
+
+// static
+void handoff::release(const listeners&) NOEXCEPT
+{
+}
+
+handoff::handoff(asio::strand& strand) NOEXCEPT
+  : strand_(strand)
+{
+}
+
+code handoff::offer(const std::filesystem::path&, descriptors&&,
+    result_handler&&) NOEXCEPT
+{
+    return error::not_allowed;
+}
+
+void handoff::do_accept() NOEXCEPT
+{
+}
+
+void handoff::stop() NOEXCEPT
+{
+}
+
+#endif
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/header_fetcher.hpp>
+
+#include <iterator>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/error.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// The open range is a segment without stop (unbounded height).
+header_fetcher::header_fetcher(const chain::checkpoints& checkpoints,
+    sink& headers) NOEXCEPT
+  : sink_(headers)
+{
+    BC_ASSERT_MSG(!checkpoints.empty(), "empty checkpoints");
+
+    segments_.reserve(checkpoints.size());
+    for (auto it = checkpoints.begin(); it != checkpoints.end(); ++it)
+    {
+        const auto next = std::next(it);
+        const auto open = next == checkpoints.end();
+        segments_.push_back(
+        {
+            open ? null_hash : next->hash(),
+            it->hash(),
+            open ? max_size_t : next->height(),
+            it->height()
+        });
+    }
+}
+
+// Methods.
+// ----------------------------------------------------------------------------
+
+bool header_fetcher::request(uint64_t channel, range& out) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    auto value = find(channel);
+    if (is_null(value))
+    {
+        for (auto& segment: segments_)
+        {
+            if (!segment.assigned && !segment.complete)
+            {
+                segment.assigned = true;
+                segment.channel = channel;
+                value = &segment;
+                break;
+            }
+        }
+    }
+
+    if (is_null(value))
+        return false;
+
+    out = { value->tip, value->stop };
+    return true;
+}
+
+// Validation is completed before any state change, so that a rejected
+// message leaves the range as it was (prior messages were valid).
+code header_fetcher::received(uint64_t channel,
+    const chain::header_cptrs& headers, const hashes& hashes) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    const auto value = find(channel);
+    if (is_null(value))
+        return error::success;
+
+    // A closed range must be served in full (an empty response included).
+    const auto open = value->stop == null_hash;
+    if (headers.size() != hashes.size() || (headers.empty() && !open))
+    {
+        value->assigned = false;
+        return error::protocol_violation;
+    }
+
+    auto tip = value->tip;
+    auto top = value->top;
+    for (size_t index = 0; index < headers.size(); ++index)
+    {
+        if (headers.at(index)->previous_block_hash() != tip ||
+            top++ == value->stop_height)
+        {
+            value->assigned = false;
+            return error::protocol_violation;
+        }
+
+        tip = hashes.at(index);
+    }
+
+    if (!open && top == value->stop_height && tip != value->stop)
+    {
+        value->assigned = false;
+        return error::protocol_violation;
+    }
+
+    value->tip = tip;
+    value->top = top;
+    value->headers.insert(value->headers.end(), headers.begin(),
+        headers.end());
+
+    if (open ? headers.size() < max_get_headers : top == value->stop_height)
+    {
+        value->complete = true;
+        value->assigned = false;
+    }
+
+    stitch();
+    return error::success;
+}
+
+void header_fetcher::release(uint64_t channel) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (const auto value = find(channel))
+        value->assigned = false;
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+size_t header_fetcher::remaining() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    size_t count{};
+    for (const auto& segment: segments_)
+        if (!segment.complete)
+            ++count;
+
+    return count;
+}
+
+bool header_fetcher::complete() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return stitched_ == segments_.size();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+header_fetcher::segment* header_fetcher::find(uint64_t channel) NOEXCEPT
+{
+    for (auto& segment: segments_)
+        if (segment.assigned && segment.channel == channel)
+            return &segment;
+
+    return nullptr;
+}
+
+// Headers of the lowest unstitched range are contiguous with those stitched,
+// so are passed on as received, bounding retention to the higher ranges.
+void header_fetcher::stitch() NOEXCEPT
+{
+    while (stitched_ < segments_.size())
+    {
+        auto& segment = segments_.at(stitched_);
+        if (!segment.headers.empty())
+        {
+            const auto height = add1(segment.top - segment.headers.size());
+            sink_.accept(height, segment.headers);
+            segment.headers.clear();
+            segment.headers.shrink_to_fit();
+        }
+
+        if (!segment.complete)
+            return;
+
+        ++stitched_;
+    }
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -18,7 +18,15 @@
  */
 #include <bitcoin/network/net/hosts.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
@@ -35,19 +43,50 @@ using namespace messages;
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
+// The binary file is a heading followed by fixed size address_item records,
+// in wire (timestamped) format. Any other file is loaded as legacy text.
+static constexpr uint32_t file_magic = 0x736f6862;
+static constexpr uint32_t file_version = 1;
+
 hosts::hosts(const settings& settings, const logger& log) NOEXCEPT
-  : settings_(settings),
+  : settings_(settings::cptr{}, &settings),
     buffer_(settings.host_pool_capacity),
     reporter(log)
 {
 }
 
+void hosts::reload(const settings::cptr& snapshot) NOEXCEPT
+{
+    std::unique_lock lock(settings_mutex_);
+    settings_ = snapshot;
+}
+
+// private
+settings::cptr hosts::current() const NOEXCEPT
+{
+    std::unique_lock lock(settings_mutex_);
+    return settings_;
+}
+
 // Start/stop.
 // ----------------------------------------------------------------------------
 
 // O(N).
 code hosts::start() NOEXCEPT
 {
+    // The asmap is mapped upon first start and retained (immutable).
+    if (!current()->asmap_path.empty() && !asmap_.loaded())
+    {
+        if (const auto ec = asmap_.load(current()->asmap_path))
+        {
+            LOGF("Asmap failed to load, " << ec.message());
+        }
+        else
+        {
+            LOGN("Loaded asmap " << current()->asmap_path << ".");
+        }
+    }
+
     // Not idempotent start.
     if (is_zero(buffer_.capacity()))
         return error::success;
@@ -58,31 +97,28 @@ code hosts::start() NOEXCEPT
     // Restartable.
     stopped_ = false;
 
-    try
-    {
-        ifstream file{ settings_.file(), ifstream::in };
-        if (!file.good())
-            return error::success;
+    // The index is bounded by the ring and tried tables, so reserve once.
+    index_.reserve(buffer_.capacity() + tried_limit());
 
-        for (std::string line{}; std::getline(file, line);)
-            push(line);
+    // The journal holds changes checkpointed since the file was last saved.
+    if (const auto ec = load_file())
+        return ec;
 
-        if (file.bad())
-            return error::file_load;
-    }
-    catch (const std::exception&)
-    {
-        return error::file_exception;
-    }
+    if (const auto ec = replay_journal())
+        return ec;
+
+    loaded_ = pushed_;
+    dirty_.clear();
 
     if (buffer_.empty())
     {
         code ec;
-        std::filesystem::remove(settings_.file(), ec);
+        std::filesystem::remove(current()->file(), ec);
+        std::filesystem::remove(journal(), ec);
     }
 
     LOGN("Loaded (" << buffer_.size() << ") addresses.");
-    hosts_count_.store(buffer_.size());
+    hosts_count_.store(pooled());
     return error::success;
 }
 
@@ -95,34 +131,179 @@ code hosts::stop() NOEXCEPT
 
     stopped_ = true;
 
-    if (buffer_.empty())
+    // Outstanding checkpoint writes must complete before the file is saved.
+    drain();
+    dirty_.clear();
+    journaled_ = zero;
+
+    code ec;
+    std::filesystem::remove(journal(), ec);
+
+    if (is_zero(pooled()))
     {
-        code ec;
-        std::filesystem::remove(settings_.file(), ec);
+        std::filesystem::remove(current()->file(), ec);
         return ec ? error::file_save : error::success;
     }
 
-    try
+    // Tried hosts are saved with new hosts, and are loaded as new.
+    if (const auto error_code = save_file(current()->file(), snapshot()))
+        return error_code;
+
+    LOGN("Saved (" << pooled() << ") addresses.");
+    clear();
+    hosts_count_.store(zero);
+    return error::success;
+}
+
+// O(N) when compacting, otherwise O(C) for C changes since last checkpoint.
+void hosts::checkpoint(result_handler&& handler) NOEXCEPT
+{
+    if (is_zero(buffer_.capacity()) || stopped_)
     {
-        ofstream file{ settings_.file(), ofstream::out };
-        if (!file.good())
-            return error::file_save;
+        handler(error::service_stopped);
+        return;
+    }
 
-        for (const auto& entry: buffer_)
-            file << config::address{ entry } << std::endl;
+    // Compact once the journal would exceed the pool.
+    if (journaled_ + dirty_.size() > pooled())
+    {
+        const auto items = std::make_shared<address_items>(snapshot());
 
-        if (file.bad())
-            return error::file_save;
+        dirty_.clear();
+        journaled_ = zero;
+        boost::asio::post(checkpointer_.service(),
+            std::bind(&hosts::do_compact, this, items, std::move(handler)));
+        return;
+    }
+
+    const auto items = std::make_shared<address_items>(std::move(dirty_));
+    dirty_.clear();
+    journaled_ += items->size();
+    boost::asio::post(checkpointer_.service(),
+        std::bind(&hosts::do_journal, this, items, std::move(handler)));
+}
+
+// private (checkpoint thread)
+void hosts::do_compact(const address_items_ptr& items,
+    const result_handler& handler) NOEXCEPT
+{
+    auto temporary = current()->file();
+    temporary += ".tmp";
+
+    auto ec = save_file(temporary, *items);
+    if (!ec)
+    {
+        code fault{};
+        std::filesystem::rename(temporary, current()->file(), fault);
+        if (!fault) std::filesystem::remove(journal(), fault);
+        if (fault) ec = error::file_save;
+    }
+
+    if (!ec)
+    {
+        LOGN("Compacted (" << items->size() << ") addresses.");
+    }
+
+    handler(ec);
+}
+
+// private (checkpoint thread)
+void hosts::do_journal(const address_items_ptr& items,
+    const result_handler& handler) NOEXCEPT
+{
+    if (items->empty())
+    {
+        handler(error::success);
+        return;
+    }
+
+    try
+    {
+        ofstream file{ journal(), ofstream::out | ofstream::binary |
+            ofstream::app };
+
+        if (!file.good() || !write_records(file, *items))
+        {
+            handler(error::file_save);
+            return;
+        }
     }
     catch (const std::exception&)
     {
-        return error::file_exception;
+        handler(error::file_exception);
+        return;
     }
 
-    LOGN("Saved (" << buffer_.size() << ") addresses.");
-    buffer_.clear();
-    hosts_count_.store(zero);
-    return error::success;
+    LOGN("Checkpointed (" << items->size() << ") addresses.");
+    handler(error::success);
+}
+
+// O(S) for slice S, plus the size of one tried group.
+// Hosts without timestamp do not expire. Drops are not journaled, so a
+// crash before compaction may restore dropped hosts (swept again later).
+void hosts::sweep(count_handler&& handler) NOEXCEPT
+{
+    if (stopped_)
+    {
+        handler(error::service_stopped, zero);
+        return;
+    }
+
+    const auto now = unix_time();
+    const auto snapshot = current();
+    const uint64_t horizon = std::chrono::duration_cast<seconds>(
+        snapshot->host_expiration()).count();
+
+    const auto stale = [=](uint32_t timestamp) NOEXCEPT
+    {
+        return !is_zero(horizon) && !is_zero(timestamp) &&
+            floored_subtract(now, timestamp) > horizon;
+    };
+
+    size_t swept{};
+    auto slice = std::min<size_t>(snapshot->host_sweep_slice, buffer_.size());
+    for (; !is_zero(slice); --slice)
+    {
+        // Loaded hosts precede all others in sequence, and are not filtered.
+        const auto loaded = (pushed_ - buffer_.size()) < loaded_;
+        const auto host = pop();
+
+        if ((loaded && snapshot->excluded(*host)) || stale(host->timestamp))
+        {
+            failures_.erase(to_key(*host));
+            ++swept;
+        }
+        else
+        {
+            rotate(*host);
+        }
+    }
+
+    if (!tried_.empty())
+    {
+        const auto bucket = std::next(tried_.begin(),
+            pseudo_random::next(zero, sub1(tried_.size())));
+
+        swept += std::erase_if(bucket->second, [&](const record& host) NOEXCEPT
+        {
+            if (!stale(host.timestamp))
+                return false;
+
+            const auto hash = key(host);
+            index_.erase(hash);
+            failures_.erase(hash);
+            index_services(tried_services_, host.services, false);
+            release(host);
+            --tried_count_;
+            return true;
+        });
+
+        if (bucket->second.empty())
+            tried_.erase(bucket);
+    }
+
+    hosts_count_.store(pooled());
+    handler(error::success, swept);
 }
 
 // Properties.
@@ -133,11 +314,21 @@ size_t hosts::count() const NOEXCEPT
     return hosts_count_.load();
 }
 
+size_t hosts::tried() const NOEXCEPT
+{
+    return tried_count_.load();
+}
+
 size_t hosts::reserved() const NOEXCEPT
 {
     return authorities_count_.load();
 }
 
+uint64_t hosts::group(const ip_address& ip) const NOEXCEPT
+{
+    return asmap_.group(ip);
+}
+
 // Usage.
 // ----------------------------------------------------------------------------
 
@@ -151,22 +342,129 @@ void hosts::take(address_item_handler&& handler) NOEXCEPT
     }
 
     // O(1) average, O(N) worst case.
+    while (!is_zero(pooled()))
+    {
+        // Alternate tables when both are populated (bias toward tried).
+        const auto tried = !tried_.empty() &&
+            (buffer_.empty() || (alternate_ = !alternate_));
+
+        // Loaded hosts precede all others in sequence, and are not filtered.
+        const auto loaded = !tried && (pushed_ - buffer_.size()) < loaded_;
+        const auto host = tried ? pop_tried() : pop();
+
+        if (loaded && current()->excluded(*host))
+        {
+            LOGF("Address excluded upon take ["
+                << config::address{ *host } << "].");
+        }
+        else if (!is_reserved(*host))
+        {
+            hosts_count_.store(pooled());
+            USDT2(hosts_take, error::success, pooled());
+            handler(error::success, host);
+            return;
+        }
+    }
+
+    hosts_count_.store(zero);
+    USDT2(hosts_take, error::address_not_found, zero);
+    handler(error::address_not_found, {});
+}
+
+// O(S) average, O(N) worst case.
+void hosts::take(uint64_t services, address_item_handler&& handler) NOEXCEPT
+{
+    // Pooled hosts are filtered by services_minimum upon save and take.
+    if ((services & current()->services_minimum) == services)
+    {
+        take(std::move(handler));
+        return;
+    }
+
+    if (stopped_)
+    {
+        handler(error::service_stopped, {});
+        return;
+    }
+
+    // Unserviced hosts are not popped, so the service index terminates this.
+    while (true)
+    {
+        const auto serviced_new = is_serviced(new_services_, services);
+        const auto serviced_tried = is_serviced(tried_services_, services);
+        if (!serviced_new && !serviced_tried)
+            break;
+
+        // Alternate tables when both are serviced (bias toward tried).
+        const auto tried = serviced_tried &&
+            (!serviced_new || (alternate_ = !alternate_));
+
+        // Loaded hosts precede all others in sequence, and are not filtered.
+        const auto loaded = !tried && (pushed_ - buffer_.size()) < loaded_;
+        const auto host = tried ? pop_tried(services) : pop();
+
+        if (!host)
+            break;
+
+        if (loaded && current()->excluded(*host))
+        {
+            LOGF("Address excluded upon take ["
+                << config::address{ *host } << "].");
+        }
+        else if ((host->services & services) != services)
+        {
+            // Rotate the unserviced new host to the back of the buffer.
+            rotate(*host);
+        }
+        else if (!is_reserved(*host))
+        {
+            hosts_count_.store(pooled());
+            USDT2(hosts_take, error::success, pooled());
+            handler(error::success, host);
+            return;
+        }
+    }
+
+    hosts_count_.store(pooled());
+    USDT2(hosts_take, error::address_not_found, pooled());
+    handler(error::address_not_found, {});
+}
+
+// O(1) average, O(N) worst case.
+void hosts::take_new(address_item_handler&& handler) NOEXCEPT
+{
+    if (stopped_)
+    {
+        handler(error::service_stopped, {});
+        return;
+    }
+
     while (!buffer_.empty())
     {
+        // Loaded hosts precede all others in sequence, and are not filtered.
+        const auto loaded = (pushed_ - buffer_.size()) < loaded_;
         const auto host = pop();
-        if (!is_reserved(*host))
+
+        if (loaded && current()->excluded(*host))
         {
-            hosts_count_.store(buffer_.size());
+            LOGF("Address excluded upon take ["
+                << config::address{ *host } << "].");
+        }
+        else if (!is_reserved(*host))
+        {
+            hosts_count_.store(pooled());
+            USDT2(hosts_take, error::success, pooled());
             handler(error::success, host);
             return;
         }
     }
 
-    hosts_count_.store(zero);
+    hosts_count_.store(pooled());
+    USDT2(hosts_take, error::address_not_found, pooled());
     handler(error::address_not_found, {});
 }
 
-// O(N) <= could be O(1) with O(1) search.
+// O(1).
 void hosts::restore(const address_item_cptr& host,
     result_handler&& handler) NOEXCEPT
 {
@@ -176,44 +474,121 @@ void hosts::restore(const address_item_cptr& host,
         return;
     }
 
-    // O(N) <= could be resolved with O(1) search.
+    // O(1).
     const auto it = find(*host);
 
-    // O(1).
+    // O(1), index key is unchanged as equality ignores timestamp/services.
     if (it != buffer_.end())
     {
-        *it = *host;
+        update(it, *host);
+        dirty(*host);
+        handler(error::success);
+        return;
+    }
+
+    // O(1), host is tried.
+    if (is_pooled(*host))
+    {
         handler(error::success);
         return;
     }
 
     // O(1).
-    buffer_.push_back(*host);
-    hosts_count_.store(buffer_.size());
+    push_back(*host);
+    hosts_count_.store(pooled());
+    handler(error::success);
+}
+
+// O(1).
+void hosts::restore(const address_item_cptr& host, const code& ec,
+    const steady_clock::duration& latency, result_handler&& handler) NOEXCEPT
+{
+    // A host that reaches the failure limit is dropped.
+    if (is_failed(*host, ec))
+    {
+        LOGF("Address dropped upon failures ["
+            << config::address{ *host } << "].");
+        handler(stopped_ ? error::service_stopped : error::success);
+        return;
+    }
+
+    // Failed hosts are new, and tried table capacity is limited.
+    if (ec || is_pooled(*host) || tried_count_ >= tried_limit())
+    {
+        restore(host, std::move(handler));
+        return;
+    }
+
+    if (stopped_)
+    {
+        handler(error::service_stopped);
+        return;
+    }
+
+    const auto milliseconds = std::chrono::duration_cast<
+        std::chrono::milliseconds>(latency).count();
+
+    push_tried(*host, limit<uint16_t>(milliseconds));
+    hosts_count_.store(pooled());
     handler(error::success);
 }
 
 // Negotiation.
 // ----------------------------------------------------------------------------
 
-// O(N).
-void hosts::fetch(address_handler&& handler) const NOEXCEPT
+// O(1), amortized over the address_refresh interval.
+void hosts::fetch(fetch_handler&& handler) const NOEXCEPT
 {
     if (stopped_)
     {
-        handler(error::service_stopped, {});
+        handler(error::service_stopped, {}, {});
         return;
     }
 
     if (buffer_.empty())
     {
-        handler(error::address_not_found, {});
+        handler(error::address_not_found, {}, {});
         return;
     }
 
+    // Selections and encodings are shared until refresh expiry or churn.
+    const auto now = steady_clock::now();
+    if (fetched_.empty() || churned() ||
+        now >= fetched_time_ + current()->address_refresh())
+        reselect(now);
+
+    // Round robin preserves variation across requesters (fingerprinting).
+    const auto& out = fetched_.at(fetched_next_++ % fetched_.size());
+    handler(error::success, out.message, out.cache);
+}
+
+// O(1).
+inline bool hosts::churned() const NOEXCEPT
+{
+    return (pushed_ - fetched_pushed_) > (buffer_.size() / 4u);
+}
+
+// O(N*M).
+inline void hosts::reselect(const steady_clock::time_point& now) const NOEXCEPT
+{
+    const auto count = std::max<size_t>(one, current()->address_snapshots);
+    fetched_.clear();
+    fetched_.reserve(count);
+
+    for (auto index = zero; index < count; ++index)
+        fetched_.push_back({ select(), std::make_shared<wire_cache>() });
+
+    fetched_next_ = zero;
+    fetched_pushed_ = pushed_;
+    fetched_time_ = now;
+}
+
+// O(N).
+inline address_cptr hosts::select() const NOEXCEPT
+{
     // Vary the return count (quantity fingerprinting).
     const auto divide = pseudo_random::next<size_t>(
-        settings_.address_lower, settings_.address_upper);
+        current()->address_lower, current()->address_upper);
     const auto size = std::min(messages::max_address, buffer_.size() / divide);
 
     // Vary the start position (value fingerprinting).
@@ -226,14 +601,16 @@ void hosts::fetch(address_handler&& handler) const NOEXCEPT
 
     // O(N).
     for (auto count = zero; count < size; ++count)
-        out->addresses.push_back(buffer_.at(index++ % limit));
+        out->addresses.push_back(decode(buffer_.at(index++ % limit)));
 
-    handler(error::success, out);
+    return out;
 }
 
-// O(N^2) <= could be O(N) with O(1) search.
+// O(N).
 void hosts::save(const address_cptr& message, count_handler&& handler) NOEXCEPT
 {
+    PROBE(hosts_save);
+
     if (stopped_)
     {
         handler(error::service_stopped, zero);
@@ -246,100 +623,581 @@ void hosts::save(const address_cptr& message, count_handler&& handler) NOEXCEPT
         return;
     }
 
-    const auto start_size = buffer_.size();
+    // O(N).
+    // Push addresses into the buffer, counting those evicting others.
+    auto accepted = zero;
+    for (const auto& host: message->addresses)
+    {
+        // O(1).
+        if (!is_reserved(host) && !is_pooled(host))
+        {
+            // O(1).
+            push_back(host);
+            ++accepted;
+        }
+    }
+
+    hosts_count_.store(pooled());
+    USDT3(hosts_save, message->addresses.size(), accepted, pooled());
+    handler(error::success, accepted);
+}
+
+// O(N).
+void hosts::ingest(const address_cptr& message,
+    address_handler&& handler) NOEXCEPT
+{
+    if (stopped_)
+    {
+        handler(error::service_stopped, {});
+        return;
+    }
 
-    // O(N^2).
-    // Push addresses into the buffer.
+    if (message->addresses.empty())
+    {
+        handler(error::address_not_found, {});
+        return;
+    }
+
+    // Allocate non-const message (converted to const by return).
+    const auto out = to_shared<messages::address>();
+    out->addresses.reserve(message->addresses.size());
+
+    // O(N).
+    // Push addresses into the buffer, collecting those evicting others.
     for (const auto& host: message->addresses)
     {
-        // O(N) <= could be resolved with O(1) search.
+        // O(1).
         if (!is_reserved(host) && !is_pooled(host))
         {
             // O(1).
-            buffer_.push_back(host);
-            hosts_count_.store(buffer_.size());
+            push_back(host);
+            out->addresses.push_back(host);
         }
     }
 
-    handler(error::success, buffer_.size() - start_size);
+    hosts_count_.store(pooled());
+    handler(error::success, out);
 }
 
 // private
 // ----------------------------------------------------------------------------
 
+// O(N).
+inline address_items hosts::snapshot() const NOEXCEPT
+{
+    address_items items{};
+    items.reserve(pooled());
+    for (const auto& host: buffer_)
+        items.push_back(decode(host));
+
+    for (const auto& bucket: tried_)
+        for (const auto& host: bucket.second)
+            items.push_back(decode(host));
+
+    return items;
+}
+
+// O(1).
+inline size_t hosts::pooled() const NOEXCEPT
+{
+    return buffer_.size() + tried_count_.load();
+}
+
+// O(1).
+inline size_t hosts::tried_limit() const NOEXCEPT
+{
+    return std::max(one, buffer_.capacity() / 4u);
+}
+
+// O(G + B) for G groups and B hosts per group.
+// Select a random group, and the lowest latency host in the group.
+inline address_item::cptr hosts::pop_tried() NOEXCEPT
+{
+    BC_ASSERT_MSG(!tried_.empty(), "pop from empty tried");
+
+    const auto bucket = std::next(tried_.begin(),
+        pseudo_random::next(zero, sub1(tried_.size())));
+
+    auto& group = bucket->second;
+    const auto best = std::min_element(group.begin(), group.end(),
+        [](const record& left, const record& right) NOEXCEPT
+        {
+            return left.score < right.score;
+        });
+
+    return pop_tried(bucket, best);
+}
+
+// O(N) worst case.
+// Lowest latency serviced host of the first serviced group from a random one.
+inline address_item::cptr hosts::pop_tried(uint64_t services) NOEXCEPT
+{
+    BC_ASSERT_MSG(!tried_.empty(), "pop from empty tried");
+
+    auto bucket = std::next(tried_.begin(),
+        pseudo_random::next(zero, sub1(tried_.size())));
+
+    for (size_t groups = tried_.size(); !is_zero(groups); --groups)
+    {
+        auto& group = bucket->second;
+        auto best = group.end();
+        for (auto it = group.begin(); it != group.end(); ++it)
+        {
+            if (((it->services & services) == services) &&
+                (best == group.end() || it->score < best->score))
+                best = it;
+        }
+
+        if (best != group.end())
+            return pop_tried(bucket, best);
+
+        if (++bucket == tried_.end())
+            bucket = tried_.begin();
+    }
+
+    return {};
+}
+
+// O(1).
+inline address_item::cptr hosts::pop_tried(buckets::iterator bucket,
+    records::iterator best) NOEXCEPT
+{
+    auto& group = bucket->second;
+    const auto host = to_shared<address_item>(decode(*best));
+    index_services(tried_services_, best->services, false);
+    release(*best);
+
+    if (best != std::prev(group.end()))
+        *best = group.back();
+
+    group.pop_back();
+    if (group.empty())
+        tried_.erase(bucket);
+
+    index_.erase(to_key(*host));
+    --tried_count_;
+    return host;
+}
+
+// O(1).
+inline void hosts::push_tried(const address_item& host,
+    uint16_t latency) NOEXCEPT
+{
+    BC_ASSERT_MSG(!is_pooled(host), "push of pooled host");
+
+    const auto item = encode(host, latency);
+    tried_[asmap_.group(host.ip)].push_back(item);
+    index_.emplace(to_key(host), tried_sequence);
+    index_services(tried_services_, item.services, true);
+    ++tried_count_;
+    dirty(host);
+}
+
 // O(1).
 inline address_item::cptr hosts::pop() NOEXCEPT
 {
     BC_ASSERT_MSG(!buffer_.empty(), "pop from empty buffer");
 
-    const auto host = to_shared<address_item>(std::move(buffer_.front()));
+    const auto& front = buffer_.front();
+    const auto host = to_shared<address_item>(decode(front));
+    index_.erase(to_key(*host));
+    index_services(new_services_, front.services, false);
+    release(front);
     buffer_.pop_front();
     return host;
 }
 
+// O(1).
+// Index is kept consistent with the ring, which evicts its front when full.
+inline void hosts::push_back(const address_item& host) NOEXCEPT
+{
+    BC_ASSERT_MSG(!is_pooled(host), "push of pooled host");
+
+    if (is_zero(buffer_.capacity()))
+        return;
+
+    if (buffer_.full())
+    {
+        const auto& front = buffer_.front();
+        const auto hash = key(front);
+        index_.erase(hash);
+        failures_.erase(hash);
+        index_services(new_services_, front.services, false);
+        release(front);
+    }
+
+    const auto item = encode(host);
+    buffer_.push_back(item);
+    index_.emplace(to_key(host), pushed_++);
+    index_services(new_services_, item.services, true);
+    dirty(host);
+}
+
+// O(1).
+// Services of a buffered host may change in place, as may its timestamp.
+inline void hosts::update(buffer::iterator it,
+    const address_item& host) NOEXCEPT
+{
+    index_services(new_services_, it->services, false);
+    release(*it);
+    *it = encode(host);
+    index_services(new_services_, it->services, true);
+}
+
+// O(1).
+// Requeue a host popped from the front, which is neither a change nor churn.
+inline void hosts::rotate(const address_item& host) NOEXCEPT
+{
+    BC_ASSERT_MSG(!buffer_.full(), "rotate into full buffer");
+
+    const auto item = encode(host);
+    buffer_.push_back(item);
+    index_.emplace(to_key(host), pushed_++);
+    index_services(new_services_, item.services, true);
+    ++fetched_pushed_;
+}
+
+// O(1).
+// Connect failures are counted (not cancelation), and cleared by success.
+inline bool hosts::is_failed(const address_item& host, const code& ec) NOEXCEPT
+{
+    const size_t limit = current()->host_failure_limit;
+    if (is_zero(limit) || ec == error::operation_canceled ||
+        ec == error::service_stopped)
+        return false;
+
+    const auto key = to_key(host);
+    if (!ec)
+    {
+        failures_.erase(key);
+        return false;
+    }
+
+    if (++failures_[key] < limit)
+        return false;
+
+    failures_.erase(key);
+    return true;
+}
+
+// O(1).
+inline void hosts::dirty(const address_item& host) NOEXCEPT
+{
+    // Changes are only retained for checkpoint.
+    if (!is_zero(current()->host_checkpoint_minutes))
+        dirty_.push_back(host);
+}
+
+// O(N).
+inline void hosts::clear() NOEXCEPT
+{
+    buffer_.clear();
+    tried_.clear();
+    tried_count_ = zero;
+    index_.clear();
+    new_services_.clear();
+    tried_services_.clear();
+    failures_.clear();
+    ipv6_.clear();
+    ipv6_free_.clear();
+    pushed_ = zero;
+    loaded_ = zero;
+    fetched_.clear();
+}
+
+// Records.
+// ----------------------------------------------------------------------------
+// IPv4 (mapped) addresses are held in the record, IPv6 in a side table slot.
+
+constexpr auto ipv4_at = config::ipv6_size - config::ipv4_size;
+
+// O(1).
+inline hosts::record hosts::encode(const address_item& host,
+    uint16_t score) NOEXCEPT
+{
+    record out
+    {
+        host.timestamp,
+        possible_narrow_cast<uint32_t>(host.services),
+        {},
+        host.port,
+        score,
+        config::is_v6(host.ip)
+    };
+
+    if (!out.ipv6)
+    {
+        const auto& ip = host.ip;
+        out.address = (uint32_t{ ip[ipv4_at] } << 24) |
+            (uint32_t{ ip[ipv4_at + 1u] } << 16) |
+            (uint32_t{ ip[ipv4_at + 2u] } << 8) | ip[ipv4_at + 3u];
+    }
+    else if (ipv6_free_.empty())
+    {
+        out.address = possible_narrow_cast<uint32_t>(ipv6_.size());
+        ipv6_.push_back(host.ip);
+    }
+    else
+    {
+        out.address = ipv6_free_.back();
+        ipv6_free_.pop_back();
+        ipv6_.at(out.address) = host.ip;
+    }
+
+    return out;
+}
+
+// O(1).
+inline address_item hosts::decode(const record& host) const NOEXCEPT
+{
+    address_item out{ host.timestamp, host.services, {}, host.port };
+    if (host.ipv6)
+    {
+        out.ip = ipv6_.at(host.address);
+    }
+    else
+    {
+        auto& ip = out.ip;
+        std::copy(config::ip_map_prefix.begin(), config::ip_map_prefix.end(),
+            ip.begin());
+        ip[ipv4_at] = possible_narrow_cast<uint8_t>(host.address >> 24);
+        ip[ipv4_at + 1u] = possible_narrow_cast<uint8_t>(host.address >> 16);
+        ip[ipv4_at + 2u] = possible_narrow_cast<uint8_t>(host.address >> 8);
+        ip[ipv4_at + 3u] = possible_narrow_cast<uint8_t>(host.address);
+    }
+
+    return out;
+}
+
+// O(1).
+inline address_key hosts::key(const record& host) const NOEXCEPT
+{
+    return to_key(decode(host));
+}
+
+// O(1).
+inline void hosts::release(const record& host) NOEXCEPT
+{
+    if (host.ipv6)
+        ipv6_free_.push_back(host.address);
+}
+
 // O(1).
 inline void hosts::push(const std::string& line) NOEXCEPT
 {
     try
     {
-        const config::address item{ line };
+        push(config::address{ line });
+    }
+    catch (std::exception&)
+    {
+        LOGF("Address failed to deserialize [" << line << "].");
+    }
+}
 
-        if (!messages::is_specified(item))
-        {
-            LOGF("Address unspecified upon load [" << line << "].");
-        }
-        else if (settings_.disabled(item))
-        {
-            LOGF("Address disabled upon load [" << line << "].");
-        }
-        else if (settings_.insufficient(item))
-        {
-            LOGF("Address insufficient upon load [" << line << "].");
-        }
-        else if (settings_.unsupported(item))
-        {
-            LOGF("Address unsupported upon load [" << line << "].");
-        }
-        else if (settings_.peered(item))
-        {
-            LOGF("Address peered upon load [" << line << "].");
-        }
-        else if (settings_.blacklisted(item))
+// O(1).
+inline void hosts::push(const address_item& host) NOEXCEPT
+{
+    if (!messages::is_specified(host))
+    {
+        LOGF("Address unspecified upon load ["
+            << config::address{ host } << "].");
+    }
+    else if (is_pooled(host))
+    {
+        LOGF("Address duplicated upon load ["
+            << config::address{ host } << "].");
+    }
+    else
+    {
+        push_back(host);
+    }
+}
+
+// Files.
+// ----------------------------------------------------------------------------
+// Records are address_item wire (timestamped) format. The file is a heading
+// followed by records, and the journal is records only (append-only).
+
+// private
+std::filesystem::path hosts::journal() const NOEXCEPT
+{
+    auto path = current()->file();
+    path += ".journal";
+    return path;
+}
+
+// private
+template <typename Items>
+bool hosts::write_records(std::ostream& file, const Items& items) NOEXCEPT
+{
+    write::bytes::ostream sink{ file };
+    for (const auto& item: items)
+        item.serialize(level::maximum_protocol, sink, true);
+
+    sink.flush();
+    return sink && !file.bad();
+}
+
+// private
+template <typename Items>
+code hosts::save_file(const std::filesystem::path& path,
+    const Items& items) NOEXCEPT
+{
+    try
+    {
+        ofstream file{ path, ofstream::out | ofstream::binary };
+        if (!file.good())
+            return error::file_save;
+
+        write::bytes::ostream sink{ file };
+        sink.write_4_bytes_little_endian(file_magic);
+        sink.write_4_bytes_little_endian(file_version);
+        sink.flush();
+
+        if (!sink || !write_records(file, items))
+            return error::file_save;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+// private
+// Records are bulk read, without filtering (applied upon take).
+code hosts::load_file() NOEXCEPT
+{
+    try
+    {
+        ifstream file{ current()->file(), ifstream::in | ifstream::binary };
+        if (!file.good())
+            return error::success;
+
+        read::bytes::istream source{ file };
+        if (source.read_4_bytes_little_endian() == file_magic)
         {
-            LOGF("Address blacklisted upon load [" << line << "].");
+            if (source.read_4_bytes_little_endian() != file_version)
+                return error::file_load;
+
+            while (!source.is_exhausted())
+            {
+                const auto item = address_item::deserialize(
+                    level::maximum_protocol, source, true);
+
+                if (!source)
+                    return error::file_load;
+
+                push(item);
+            }
         }
-        else if (!settings_.whitelisted(item))
+        else
         {
-            LOGF("Address not whitelisted upon load [" << line << "].");
+            ifstream text{ current()->file(), ifstream::in };
+            if (!text.good())
+                return error::file_load;
+
+            for (std::string line{}; std::getline(text, line);)
+                push(line);
+
+            if (text.bad())
+                return error::file_load;
         }
-        else
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+// private
+// Journal records update pooled entries, otherwise are pushed.
+code hosts::replay_journal() NOEXCEPT
+{
+    try
+    {
+        ifstream file{ journal(), ifstream::in | ifstream::binary };
+        if (!file.good())
+            return error::success;
+
+        read::bytes::istream source{ file };
+        while (!source.is_exhausted())
         {
-            buffer_.push_back(item);
-            ////LOGF("Address excluded upon load [" << line << "].");
+            const auto item = address_item::deserialize(
+                level::maximum_protocol, source, true);
+
+            // A torn final record implies a crash during checkpoint.
+            if (!source)
+                break;
+
+            const auto it = find(item);
+            if (it != buffer_.end())
+                update(it, item);
+            else
+                push(item);
+
+            ++journaled_;
         }
     }
-    catch (std::exception&)
+    catch (const std::exception&)
     {
-        LOGF("Address failed to deserialize [" << line << "].");
+        return error::file_exception;
     }
+
+    return error::success;
+}
+
+// private
+// Posting to the single checkpoint thread completes after prior writes.
+void hosts::drain() NOEXCEPT
+{
+    std::promise<bool> promise{};
+    boost::asio::post(checkpointer_.service(), [&]() NOEXCEPT
+    {
+        promise.set_value(true);
+    });
+
+    promise.get_future().wait();
 }
 
 // Reservation.
 // ----------------------------------------------------------------------------
-// atomic unordered set: contains, insert, erase.
+// Reservations are made from channel strands, concurrent with take and each
+// other, so are sharded by address to avoid a common lock.
+
+// private
+hosts::reservations& hosts::shard(const address_key& key) const NOEXCEPT
+{
+    constexpr auto mask = sub1(reservation_shards);
+    static_assert(is_zero(reservation_shards & mask), "power of two");
+
+    BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+    return reservations_[std::hash<address_key>{}(key) & mask];
+    BC_POP_WARNING()
+}
 
 // O(1).
 // private
-inline bool hosts::is_reserved(const config::authority& host) const NOEXCEPT
+inline bool hosts::is_reserved(const address_item& host) const NOEXCEPT
 {
-    return authorities_.contains(host);
+    const auto key = to_key(host);
+    const auto& reserved = shard(key);
+    std::shared_lock lock(reserved.mutex);
+    return reserved.authorities.contains(key);
 }
 
 // O(1).
 // Channel is connected (infrequent).
 bool hosts::reserve(const config::authority& host) NOEXCEPT
 {
-    const auto result = authorities_.insert(host).second;
+    const auto key = host.to_key();
+    auto& reserved = shard(key);
+    std::unique_lock lock(reserved.mutex);
+    const auto result = reserved.authorities.insert(key).second;
     if (result) ++authorities_count_;
     return result;
 }
@@ -348,7 +1206,10 @@ bool hosts::reserve(const config::authority& host) NOEXCEPT
 // Channel is unconnected (infrequent).
 bool hosts::unreserve(const config::authority& host) NOEXCEPT
 {
-    const auto result = to_bool(authorities_.erase(host));
+    const auto key = host.to_key();
+    auto& reserved = shard(key);
+    std::unique_lock lock(reserved.mutex);
+    const auto result = to_bool(reserved.authorities.erase(key));
     if (result) --authorities_count_;
     return result;
 }
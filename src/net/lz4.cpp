@@ -0,0 +1,243 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/lz4.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// The final five bytes are literals, and the final match starts at least
+// twelve bytes before the end of the block (as required by the format).
+constexpr size_t minimum_match = 4;
+constexpr size_t last_literals = 5;
+constexpr size_t match_limit = 12;
+constexpr size_t hash_bits = 12;
+constexpr uint8_t run_mask = 0x0f;
+constexpr uint8_t extension = 0xff;
+
+static inline uint32_t load32(const data_chunk& data, size_t position) NOEXCEPT
+{
+    return uint32_t{ data[position] } | (uint32_t{ data[position + 1] } << 8) |
+        (uint32_t{ data[position + 2] } << 16) |
+        (uint32_t{ data[position + 3] } << 24);
+}
+
+static inline size_t hash(uint32_t sequence) NOEXCEPT
+{
+    return (sequence * 2654435761u) >> (32u - hash_bits);
+}
+
+static void put_length(data_chunk& out, size_t length) NOEXCEPT
+{
+    for (; length >= extension; length -= extension)
+        out.push_back(extension);
+
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+static void put_sequence(data_chunk& out, const data_chunk& buffer,
+    size_t anchor, size_t position, size_t offset, size_t length) NOEXCEPT
+{
+    const auto literals = position - anchor;
+    const auto match = length - minimum_match;
+    out.push_back(static_cast<uint8_t>(
+        (std::min<size_t>(literals, run_mask) << 4) |
+        std::min<size_t>(match, run_mask)));
+
+    if (literals >= run_mask)
+        put_length(out, literals - run_mask);
+
+    out.insert(out.end(), std::next(buffer.begin(), anchor),
+        std::next(buffer.begin(), position));
+
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+
+    if (match >= run_mask)
+        put_length(out, match - run_mask);
+}
+
+data_chunk lz4::compress(const data_slice& data,
+    const data_slice& dictionary) NOEXCEPT
+{
+    // The dictionary is the start of the match window.
+    data_chunk buffer{};
+    buffer.reserve(dictionary.size() + data.size());
+    buffer.insert(buffer.end(), dictionary.begin(), dictionary.end());
+    buffer.insert(buffer.end(), data.begin(), data.end());
+
+    const auto start = dictionary.size();
+    const auto end = buffer.size();
+
+    // Positions are stored plus one, so that zero is empty.
+    std::vector<size_t> table(size_t{ 1 } << hash_bits, zero);
+    for (size_t position = 0; position + minimum_match <= start; ++position)
+        table[hash(load32(buffer, position))] = add1(position);
+
+    data_chunk out{};
+    out.reserve(data.size() / 2u + 16u);
+
+    auto anchor = start;
+    auto position = start;
+    const auto limit = end >= start + match_limit ? end - match_limit : start;
+    while (position < limit)
+    {
+        const auto sequence = load32(buffer, position);
+        auto& entry = table[hash(sequence)];
+        const auto candidate = entry;
+        entry = add1(position);
+
+        if (is_zero(candidate) || position - sub1(candidate) > window ||
+            load32(buffer, sub1(candidate)) != sequence)
+        {
+            ++position;
+            continue;
+        }
+
+        const auto match = sub1(candidate);
+        auto length = minimum_match;
+        while (position + length < end - last_literals &&
+            buffer[match + length] == buffer[position + length])
+            ++length;
+
+        put_sequence(out, buffer, anchor, position, position - match, length);
+        position += length;
+        anchor = position;
+    }
+
+    // Final literals (token without match).
+    const auto literals = end - anchor;
+    out.push_back(static_cast<uint8_t>(std::min<size_t>(literals, run_mask)
+        << 4));
+
+    if (literals >= run_mask)
+        put_length(out, literals - run_mask);
+
+    out.insert(out.end(), std::next(buffer.begin(), anchor), buffer.end());
+    return out;
+}
+
+bool lz4::decompress(const data_slab& out, const data_slice& block,
+    const data_slice& dictionary) NOEXCEPT
+{
+    data_chunk buffer(dictionary.size() + out.size());
+    std::copy(dictionary.begin(), dictionary.end(), buffer.begin());
+
+    const auto input = block.data();
+    const auto size = block.size();
+    auto written = dictionary.size();
+    size_t read{};
+
+    const auto get_length = [&](size_t& length) NOEXCEPT
+    {
+        uint8_t byte{};
+        do
+        {
+            if (read == size)
+                return false;
+
+            byte = input[read++];
+            length += byte;
+        } while (byte == extension);
+        return true;
+    };
+
+    while (true)
+    {
+        if (read == size)
+            return false;
+
+        const auto token = input[read++];
+        size_t literals = token >> 4;
+        if (literals == run_mask && !get_length(literals))
+            return false;
+
+        if (literals > size - read || literals > buffer.size() - written)
+            return false;
+
+        std::copy_n(std::next(input, read), literals,
+            std::next(buffer.begin(), written));
+        read += literals;
+        written += literals;
+
+        // The block ends with literals.
+        if (read == size)
+            break;
+
+        if (size - read < two)
+            return false;
+
+        const size_t offset = input[read] | (input[add1(read)] << 8);
+        read += two;
+        if (is_zero(offset) || offset > written)
+            return false;
+
+        size_t length = token & run_mask;
+        if (length == run_mask && !get_length(length))
+            return false;
+
+        length += minimum_match;
+        if (length > buffer.size() - written)
+            return false;
+
+        // Byte copy, as the match may overlap its own output.
+        for (auto source = written - offset; !is_zero(length); --length)
+            buffer[written++] = buffer[source++];
+    }
+
+    if (written != buffer.size())
+        return false;
+
+    std::copy(std::next(buffer.begin(), dictionary.size()), buffer.end(),
+        out.begin());
+    return true;
+}
+
+const data_chunk& lz4::transaction_dictionary() NOEXCEPT
+{
+    // Versions, segwit marker, null/final outpoint fields, sequences, witness
+    // and signature pushes, and standard output script templates.
+    static const auto dictionary = base16_chunk(
+        "0100000002000000000101000000000000000000000000000000000000000000"
+        "0000000000000000000000ffffffff00000000feffffff00000000fdffffff02"
+        "4730440220000000000000000000000000000000000000000000000000000000"
+        "00000000000220024830450221000121020121036a1976a91400000000000000"
+        "0000000000000000000000000088ac17a9140000000000000000000000000000"
+        "0000000000008716001400000000000000000000000000000000000000002200"
+        "2000000000000000000000000000000000000000000000000000000000000000"
+        "0022512000000000000000000000000000000000000000000000000000000000"
+        "00000000");
+
+    return dictionary;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
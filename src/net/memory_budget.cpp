@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/memory_budget.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+// Subtraction is floored, a release does not exceed its acquire.
+static void decrease(std::atomic<size_t>& value, size_t amount) NOEXCEPT
+{
+    auto current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current,
+        floored_subtract(current, amount), std::memory_order_relaxed));
+}
+
+memory_budget::memory_budget(size_t limit) NOEXCEPT
+  : limit_(limit),
+    high_(limit - limit / 8u)
+{
+}
+
+void memory_budget::acquire(size_t bytes) NOEXCEPT
+{
+    used_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void memory_budget::release(size_t bytes) NOEXCEPT
+{
+    decrease(used_, bytes);
+}
+
+void memory_budget::attach() NOEXCEPT
+{
+    channels_.fetch_add(one, std::memory_order_relaxed);
+}
+
+void memory_budget::detach() NOEXCEPT
+{
+    decrease(channels_, one);
+}
+
+size_t memory_budget::limit() const NOEXCEPT
+{
+    return limit_;
+}
+
+size_t memory_budget::used() const NOEXCEPT
+{
+    return used_.load(std::memory_order_relaxed);
+}
+
+size_t memory_budget::channels() const NOEXCEPT
+{
+    return channels_.load(std::memory_order_relaxed);
+}
+
+bool memory_budget::pressured() const NOEXCEPT
+{
+    return !is_zero(limit_) && used() >= high_;
+}
+
+bool memory_budget::heavy(size_t held) const NOEXCEPT
+{
+    return pressured() && held > used() / std::max(one, channels());
+}
+
+} // namespace network
+} // namespace libbitcoin
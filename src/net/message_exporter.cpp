@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/message_exporter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/export_ring.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Slots are provided for records averaging 256 bytes (transactions).
+message_exporter::message_exporter(const std::string& name,
+    size_t arena) NOEXCEPT
+  : ring_(name, arena, std::max(arena / 256u, size_t{ 1'024 })),
+    enabled_(ring_.good())
+{
+}
+
+message_exporter::~message_exporter() NOEXCEPT
+{
+    pool_.stop();
+    pool_.join();
+}
+
+bool message_exporter::enabled() const NOEXCEPT
+{
+    return enabled_;
+}
+
+// The backlog is bound by the arena, and payloads retained by the exporter
+// are not returned to the channel buffer pools until written.
+void message_exporter::submit(messages::identifier id, uint64_t channel,
+    uint32_t version, const chunk_ptr& payload, const hash_cptr& hash) NOEXCEPT
+{
+    if (!enabled_ || !payload)
+        return;
+
+    const auto size = payload->size();
+    if (backlog_.fetch_add(size, std::memory_order_relaxed) + size >
+        ring_.capacity())
+    {
+        backlog_.fetch_sub(size, std::memory_order_relaxed);
+        dropped_.fetch_add(one, std::memory_order_relaxed);
+        return;
+    }
+
+    boost::asio::post(pool_.service(),
+        [this, id, channel, version, payload, hash]() NOEXCEPT
+        {
+            write(id, channel, version, payload, hash);
+        });
+}
+
+size_t message_exporter::exported() const NOEXCEPT
+{
+    return exported_.load(std::memory_order_relaxed);
+}
+
+size_t message_exporter::duplicates() const NOEXCEPT
+{
+    return duplicates_.load(std::memory_order_relaxed);
+}
+
+size_t message_exporter::dropped() const NOEXCEPT
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+// private
+// Called on the exporter thread only (the single producer of the ring).
+void message_exporter::write(messages::identifier id, uint64_t channel,
+    uint32_t version, const chunk_ptr& payload, const hash_cptr& hash) NOEXCEPT
+{
+    backlog_.fetch_sub(payload->size(), std::memory_order_relaxed);
+
+    // A payload not checksummed by the channel is hashed here, off strand.
+    const auto digest = hash ? *hash : bitcoin_hash(*payload);
+    if (!seen_.insert(digest))
+    {
+        duplicates_.fetch_add(one, std::memory_order_relaxed);
+        return;
+    }
+
+    if (ring_.write(id, channel, version, *payload))
+        exported_.fetch_add(one, std::memory_order_relaxed);
+    else
+        dropped_.fetch_add(one, std::memory_order_relaxed);
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/metrics.hpp>
+
+#include <atomic>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+constexpr auto relaxed = std::memory_order_relaxed;
+
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+metrics::metrics() NOEXCEPT
+{
+}
+
+// static
+size_t metrics::to_index(identifier id) NOEXCEPT
+{
+    const auto index = static_cast<size_t>(id);
+    return index < identifiers ? index : zero;
+}
+
+void metrics::receive(identifier id, size_t bytes) NOEXCEPT
+{
+    auto& entry = received_[to_index(id)];
+    entry.messages.fetch_add(one, relaxed);
+    entry.bytes.fetch_add(bytes, relaxed);
+}
+
+void metrics::send(identifier id, size_t bytes) NOEXCEPT
+{
+    auto& entry = sent_[to_index(id)];
+    entry.messages.fetch_add(one, relaxed);
+    entry.bytes.fetch_add(bytes, relaxed);
+}
+
+void metrics::read() NOEXCEPT
+{
+    reads_.fetch_add(one, relaxed);
+}
+
+void metrics::write() NOEXCEPT
+{
+    writes_.fetch_add(one, relaxed);
+}
+
+void metrics::queue(size_t depth) NOEXCEPT
+{
+    // Contention is rare, as depth rarely exceeds the recorded maximum.
+    auto current = queue_depth_.load(relaxed);
+    while (depth > current &&
+        !queue_depth_.compare_exchange_weak(current, depth, relaxed))
+    {
+    }
+}
+
+void metrics::deserialize(const nanoseconds& elapsed) NOEXCEPT
+{
+    deserializations_.fetch_add(one, relaxed);
+    deserialize_nanoseconds_.fetch_add(
+        possible_narrow_sign_cast<uint64_t>(elapsed.count()), relaxed);
+}
+
+void metrics::process(const nanoseconds& elapsed) NOEXCEPT
+{
+    processing_nanoseconds_.fetch_add(
+        possible_narrow_sign_cast<uint64_t>(elapsed.count()), relaxed);
+}
+
+uint64_t metrics::processing() const NOEXCEPT
+{
+    return processing_nanoseconds_.load(relaxed);
+}
+
+metrics::snapshot metrics::get() const NOEXCEPT
+{
+    snapshot out{};
+    for (size_t index = 0; index < identifiers; ++index)
+    {
+        out.received[index] =
+        {
+            received_[index].messages.load(relaxed),
+            received_[index].bytes.load(relaxed)
+        };
+
+        out.sent[index] =
+        {
+            sent_[index].messages.load(relaxed),
+            sent_[index].bytes.load(relaxed)
+        };
+    }
+
+    out.reads = reads_.load(relaxed);
+    out.writes = writes_.load(relaxed);
+    out.queue_depth = queue_depth_.load(relaxed);
+    out.deserializations = deserializations_.load(relaxed);
+    out.deserialize_nanoseconds = deserialize_nanoseconds_.load(relaxed);
+    out.processing_nanoseconds = processing_nanoseconds_.load(relaxed);
+    return out;
+}
+
+static metrics::counter sum(const metrics::counters& counters) NOEXCEPT
+{
+    metrics::counter out{};
+    for (const auto& entry: counters)
+    {
+        out.messages += entry.messages;
+        out.bytes += entry.bytes;
+    }
+
+    return out;
+}
+
+metrics::counter metrics::snapshot::total_received() const NOEXCEPT
+{
+    return sum(received);
+}
+
+metrics::counter metrics::snapshot::total_sent() const NOEXCEPT
+{
+    return sum(sent);
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
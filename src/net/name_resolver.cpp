@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/name_resolver.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+name_resolver::name_resolver(size_t threads, const duration& positive,
+    const duration& negative) NOEXCEPT
+  : positive_(positive),
+    negative_(negative),
+    pool_(std::max(one, threads), thread_priority::low)
+{
+}
+
+name_resolver::~name_resolver() NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        stopped_ = true;
+        pending_.clear();
+    }
+
+    pool_.stop();
+    pool_.join();
+}
+
+// Cached results are posted without a lookup, and a name already being looked
+// up gains a waiter without a second lookup (coalesced).
+size_t name_resolver::resolve(const std::string& host, uint16_t port,
+    asio::strand& strand, handler&& complete) NOEXCEPT
+{
+    auto key = to_key(host, port);
+    size_t ticket{};
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (stopped_)
+            return zero;
+
+        const auto found = cache_.find(key);
+        if (found != cache_.end())
+        {
+            if (steady_clock::now() < found->second.expiry)
+            {
+                const auto result = found->second;
+                lock.unlock();
+                post({ zero, &strand, std::move(complete) }, result.ec,
+                    result.endpoints);
+                return zero;
+            }
+
+            cache_.erase(found);
+        }
+
+        ticket = ++ticket_;
+        auto& list = pending_[key];
+        list.push_back({ ticket, &strand, std::move(complete) });
+        if (list.size() > one)
+            return ticket;
+    }
+
+    boost::asio::post(pool_.service(),
+        [this, key = std::move(key), host, port]() NOEXCEPT
+        {
+            lookup(key, host, port);
+        });
+
+    return ticket;
+}
+
+void name_resolver::cancel(size_t ticket) NOEXCEPT
+{
+    if (is_zero(ticket))
+        return;
+
+    waiter item{};
+
+    {
+        std::unique_lock lock(mutex_);
+        for (auto& list: pending_)
+        {
+            auto& items = list.second;
+            const auto it = std::find_if(items.begin(), items.end(),
+                [ticket](const waiter& value) NOEXCEPT
+                {
+                    return value.ticket == ticket;
+                });
+
+            if (it != items.end())
+            {
+                item = std::move(*it);
+                items.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (item.complete)
+        post(std::move(item), boost::asio::error::operation_aborted, {});
+}
+
+size_t name_resolver::cached() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return cache_.size();
+}
+
+// private
+std::string name_resolver::to_key(const std::string& host,
+    uint16_t port) NOEXCEPT
+{
+    return host + ":" + std::to_string(port);
+}
+
+// private
+void name_resolver::post(waiter&& item, const error::boost_code& ec,
+    const asio::endpoints& endpoints) NOEXCEPT
+{
+    boost::asio::post(*item.strand,
+        std::bind(std::move(item.complete), ec, endpoints));
+}
+
+// private
+// Called on a resolver thread, blocks for the duration of the lookup.
+void name_resolver::lookup(const std::string& key, const std::string& host,
+    uint16_t port) NOEXCEPT
+{
+    error::boost_code ec{};
+    asio::resolver resolver{ pool_.service() };
+    const auto endpoints = resolver.resolve(host, std::to_string(port), ec);
+    store(key, ec, endpoints);
+}
+
+// private
+void name_resolver::store(const std::string& key,
+    const error::boost_code& ec, const asio::endpoints& endpoints) NOEXCEPT
+{
+    waiters items{};
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (stopped_)
+            return;
+
+        const auto found = pending_.find(key);
+        if (found != pending_.end())
+        {
+            std::swap(items, found->second);
+            pending_.erase(found);
+        }
+
+        const auto& life = ec ? negative_ : positive_;
+        if (life > duration::zero())
+        {
+            // Purge expired names when full, and do not cache if still full.
+            if (cache_.size() >= cache_limit)
+                std::erase_if(cache_, [now = steady_clock::now()](
+                    const auto& item) NOEXCEPT
+                {
+                    return item.second.expiry <= now;
+                });
+
+            if (cache_.size() < cache_limit)
+                cache_[key] = { ec, endpoints, steady_clock::now() + life };
+        }
+    }
+
+    for (auto& item: items)
+        post(std::move(item), ec, endpoints);
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/nonces.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// Slots are allocated once, value initialized to empty.
+nonces::nonces(size_t capacity) NOEXCEPT
+  : mask_(sub1(std::bit_ceil(std::max(capacity, two)))),
+    slots_(std::make_unique<slot[]>(add1(mask_)))
+{
+}
+
+// The first unused slot is claimed after the probe confirms absence, and the
+// probe is repeated if the slot is concurrently claimed.
+bool nonces::insert(uint64_t nonce) NOEXCEPT
+{
+    if (nonce == empty || nonce == erased)
+        return false;
+
+    while (true)
+    {
+        slot* unused{};
+        auto expected = empty;
+        auto index = first(nonce);
+
+        for (size_t probe = 0; probe <= mask_; ++probe)
+        {
+            auto& value = slots_[index];
+            const auto current = value.load(std::memory_order_acquire);
+            if (current == nonce)
+                return false;
+
+            if (is_null(unused) && (current == empty || current == erased))
+            {
+                unused = &value;
+                expected = current;
+            }
+
+            if (current == empty)
+                break;
+
+            index = add1(index) & mask_;
+        }
+
+        if (is_null(unused))
+            return false;
+
+        if (unused->compare_exchange_strong(expected, nonce,
+            std::memory_order_acq_rel))
+        {
+            ++size_;
+            return true;
+        }
+    }
+}
+
+bool nonces::erase(uint64_t nonce) NOEXCEPT
+{
+    if (nonce == empty || nonce == erased)
+        return false;
+
+    auto index = first(nonce);
+    for (size_t probe = 0; probe <= mask_; ++probe)
+    {
+        auto& value = slots_[index];
+        auto current = value.load(std::memory_order_acquire);
+        if (current == empty)
+            return false;
+
+        if (current == nonce && value.compare_exchange_strong(current, erased,
+            std::memory_order_acq_rel))
+        {
+            --size_;
+            return true;
+        }
+
+        index = add1(index) & mask_;
+    }
+
+    return false;
+}
+
+bool nonces::contains(uint64_t nonce) const NOEXCEPT
+{
+    if (nonce == empty || nonce == erased)
+        return false;
+
+    auto index = first(nonce);
+    for (size_t probe = 0; probe <= mask_; ++probe)
+    {
+        const auto current = slots_[index].load(std::memory_order_acquire);
+        if (current == nonce)
+            return true;
+
+        if (current == empty)
+            return false;
+
+        index = add1(index) & mask_;
+    }
+
+    return false;
+}
+
+size_t nonces::size() const NOEXCEPT
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+size_t nonces::capacity() const NOEXCEPT
+{
+    return add1(mask_);
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Fibonacci hashing, as queried nonces are peer provided.
+size_t nonces::first(uint64_t nonce) const NOEXCEPT
+{
+    constexpr uint64_t golden = 0x9e3779b97f4a7c15;
+    return possible_narrow_cast<size_t>((nonce * golden) >> 32) & mask_;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,351 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/payload_hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+constexpr std::array<uint32_t, 8> initial
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+constexpr std::array<uint32_t, 64> constants
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static constexpr uint32_t rotate(uint32_t value, size_t shift) NOEXCEPT
+{
+    return (value >> shift) | (value << (32u - shift));
+}
+
+static uint32_t to_word(const uint8_t* data) NOEXCEPT
+{
+    return (uint32_t{ data[0] } << 24) | (uint32_t{ data[1] } << 16) |
+        (uint32_t{ data[2] } << 8) | uint32_t{ data[3] };
+}
+
+payload_hash::payload_hash() NOEXCEPT
+  : state_(initial)
+{
+}
+
+// static
+void payload_hash::compress(state& out, const uint8_t* data) NOEXCEPT
+{
+    std::array<uint32_t, 64> words{};
+    for (size_t index = 0; index < 16; ++index)
+        words[index] = to_word(data + index * sizeof(uint32_t));
+
+    for (size_t index = 16; index < 64; ++index)
+    {
+        const auto x = words[index - 15];
+        const auto y = words[index - 2];
+        const auto s0 = rotate(x, 7) ^ rotate(x, 18) ^ (x >> 3);
+        const auto s1 = rotate(y, 17) ^ rotate(y, 19) ^ (y >> 10);
+        words[index] = words[index - 16] + s0 + words[index - 7] + s1;
+    }
+
+    auto s = out;
+    for (size_t index = 0; index < 64; ++index)
+    {
+        const auto e = s[4];
+        const auto a = s[0];
+        const auto choose = (e & s[5]) ^ (~e & s[6]);
+        const auto majority = (a & s[1]) ^ (a & s[2]) ^ (s[1] & s[2]);
+        const auto t1 = s[7] + (rotate(e, 6) ^ rotate(e, 11) ^
+            rotate(e, 25)) + choose + constants[index] + words[index];
+        const auto t2 = (rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22)) +
+            majority;
+
+        s[7] = s[6];
+        s[6] = s[5];
+        s[5] = s[4];
+        s[4] = s[3] + t1;
+        s[3] = s[2];
+        s[2] = s[1];
+        s[1] = s[0];
+        s[0] = t1 + t2;
+    }
+
+    for (size_t index = 0; index < out.size(); ++index)
+        out[index] += s[index];
+}
+
+// Whole blocks are compressed directly from the chunk (not buffered).
+void payload_hash::write(const data_slice& data) NOEXCEPT
+{
+    auto it = data.data();
+    auto remaining = data.size();
+    auto buffered = static_cast<size_t>(size_ % block_size);
+    size_ += remaining;
+
+    if (!is_zero(buffered))
+    {
+        const auto fill = std::min(block_size - buffered, remaining);
+        std::copy_n(it, fill, std::next(buffer_.begin(), buffered));
+        it += fill;
+        remaining -= fill;
+        buffered += fill;
+        if (buffered < block_size)
+            return;
+
+        compress(state_, buffer_.data());
+    }
+
+    for (; remaining >= block_size; remaining -= block_size, it += block_size)
+        compress(state_, it);
+
+    std::copy_n(it, remaining, buffer_.begin());
+}
+
+hash_digest payload_hash::flush() NOEXCEPT
+{
+    const auto first = finalize();
+    write(first);
+    const auto second = finalize();
+    return second;
+}
+
+uint64_t payload_hash::size() const NOEXCEPT
+{
+    return size_;
+}
+
+// Batched.
+// ----------------------------------------------------------------------------
+
+// static
+hashes payload_hash::batch(const std::vector<data_slice>& payloads) NOEXCEPT
+{
+    hashes first{};
+    batch(first, payloads);
+
+    std::vector<data_slice> digests{};
+    digests.reserve(first.size());
+    for (const auto& digest: first)
+        digests.emplace_back(digest);
+
+    hashes second{};
+    batch(second, digests);
+    return second;
+}
+
+// static
+// Lanes are stepped together, one block each, inactive lanes are unchanged.
+void payload_hash::compress(lane_state& out,
+    const std::array<const uint8_t*, lanes>& data, size_t active) NOEXCEPT
+{
+    std::array<std::array<uint32_t, lanes>, 64> words{};
+    for (size_t index = 0; index < 16; ++index)
+        for (size_t lane = 0; lane < lanes; ++lane)
+            words[index][lane] = to_word(data[lane] +
+                index * sizeof(uint32_t));
+
+    for (size_t index = 16; index < 64; ++index)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto x = words[index - 15][lane];
+            const auto y = words[index - 2][lane];
+            const auto s0 = rotate(x, 7) ^ rotate(x, 18) ^ (x >> 3);
+            const auto s1 = rotate(y, 17) ^ rotate(y, 19) ^ (y >> 10);
+            words[index][lane] = words[index - 16][lane] + s0 +
+                words[index - 7][lane] + s1;
+        }
+    }
+
+    auto s = out;
+    for (size_t index = 0; index < 64; ++index)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto e = s[4][lane];
+            const auto a = s[0][lane];
+            const auto choose = (e & s[5][lane]) ^ (~e & s[6][lane]);
+            const auto majority = (a & s[1][lane]) ^ (a & s[2][lane]) ^
+                (s[1][lane] & s[2][lane]);
+            const auto t1 = s[7][lane] + (rotate(e, 6) ^ rotate(e, 11) ^
+                rotate(e, 25)) + choose + constants[index] +
+                words[index][lane];
+            const auto t2 = (rotate(a, 2) ^ rotate(a, 13) ^
+                rotate(a, 22)) + majority;
+
+            s[7][lane] = s[6][lane];
+            s[6][lane] = s[5][lane];
+            s[5][lane] = s[4][lane];
+            s[4][lane] = s[3][lane] + t1;
+            s[3][lane] = s[2][lane];
+            s[2][lane] = s[1][lane];
+            s[1][lane] = s[0][lane];
+            s[0][lane] = t1 + t2;
+        }
+    }
+
+    for (size_t word = 0; word < out.size(); ++word)
+        for (size_t lane = 0; lane < lanes; ++lane)
+            if (!is_zero(active & (one << lane)))
+                out[word][lane] += s[word][lane];
+}
+
+// static
+// Single sha256 of each payload, with padded tails prepared for each lane.
+void payload_hash::batch(hashes& out,
+    const std::vector<data_slice>& payloads) NOEXCEPT
+{
+    constexpr auto length = sizeof(uint64_t);
+    out.resize(payloads.size());
+
+    for (size_t group = 0; group < payloads.size(); group += lanes)
+    {
+        const auto count = std::min(lanes, payloads.size() - group);
+        std::array<std::array<uint8_t, two * block_size>, lanes> tails{};
+        std::array<size_t, lanes> blocks{};
+        std::array<size_t, lanes> totals{};
+        size_t steps{};
+
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            const auto& payload = payloads[group + lane];
+            const auto size = payload.size();
+            const auto remainder = size % block_size;
+            auto& tail = tails[lane];
+
+            blocks[lane] = size / block_size;
+            std::copy_n(payload.data() + blocks[lane] * block_size, remainder,
+                tail.begin());
+            tail[remainder] = 0x80;
+
+            const auto padded = remainder < block_size - length ? one : two;
+            const auto bits = uint64_t{ size } * byte_bits;
+            for (size_t byte = 0; byte < length; ++byte)
+                tail[sub1(padded * block_size) - byte] =
+                    static_cast<uint8_t>(bits >> to_bits(byte));
+
+            totals[lane] = blocks[lane] + padded;
+            steps = std::max(steps, totals[lane]);
+        }
+
+        lane_state state{};
+        for (size_t word = 0; word < state.size(); ++word)
+            state[word].fill(initial[word]);
+
+        std::array<const uint8_t*, lanes> data{};
+        for (size_t step = 0; step < steps; ++step)
+        {
+            size_t active{};
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                // Inactive lanes compress their (valid) tail, discarded.
+                data[lane] = tails[lane].data();
+                if (lane >= count || step >= totals[lane])
+                    continue;
+
+                active |= (one << lane);
+                data[lane] = step < blocks[lane] ?
+                    payloads[group + lane].data() + step * block_size :
+                    tails[lane].data() + (step - blocks[lane]) * block_size;
+            }
+
+            compress(state, data, active);
+        }
+
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            auto& digest = out[group + lane];
+            for (size_t word = 0; word < state.size(); ++word)
+                for (size_t byte = 0; byte < sizeof(uint32_t); ++byte)
+                    digest[word * sizeof(uint32_t) + byte] =
+                        static_cast<uint8_t>(state[word][lane] >>
+                            to_bits(sub1(sizeof(uint32_t)) - byte));
+        }
+    }
+}
+
+// private
+// Pads the buffered tail with the bit length, and resets.
+hash_digest payload_hash::finalize() NOEXCEPT
+{
+    const auto bits = size_ * byte_bits;
+    const auto buffered = static_cast<size_t>(size_ % block_size);
+
+    buffer_[buffered] = 0x80;
+    std::fill(std::next(buffer_.begin(), add1(buffered)), buffer_.end(), 0);
+    if (buffered >= block_size - sizeof(uint64_t))
+    {
+        compress(state_, buffer_.data());
+        buffer_.fill(0);
+    }
+
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        buffer_[sub1(block_size) - byte] =
+            static_cast<uint8_t>(bits >> to_bits(byte));
+
+    compress(state_, buffer_.data());
+
+    hash_digest out{};
+    for (size_t word = 0; word < state_.size(); ++word)
+        for (size_t byte = 0; byte < sizeof(uint32_t); ++byte)
+            out[word * sizeof(uint32_t) + byte] = static_cast<uint8_t>(
+                state_[word] >> to_bits(sub1(sizeof(uint32_t)) - byte));
+
+    reset();
+    return out;
+}
+
+void payload_hash::reset() NOEXCEPT
+{
+    state_ = initial;
+    buffer_.fill(0);
+    size_ = zero;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
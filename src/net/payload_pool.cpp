@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/payload_pool.hpp>
+
+#include <bit>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+#ifdef HAVE_LINUX
+    #include <sys/mman.h>
+#endif
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+payload_pool::payload_pool(size_t capacity, size_t maximum,
+    bool huge_pages) NOEXCEPT
+  : capacity_(capacity),
+    classes_(is_zero(capacity) || is_zero(maximum) ? zero :
+        add1(size_class(maximum) - minimum_class)),
+    huge_pages_(huge_pages),
+    pool_(classes_)
+{
+}
+
+// static
+size_t payload_pool::size_class(size_t size) NOEXCEPT
+{
+    // Buffers of up to 2^minimum_class bytes share the smallest class.
+    constexpr auto minimum = power2(minimum_class);
+    return size <= minimum ? minimum_class :
+        static_cast<size_t>(std::bit_width(sub1(size)));
+}
+
+// Retained buffers are not cleared, so shrinking to size is free and growing
+// within the class capacity zero-fills only the difference. Allocation
+// failure of a new buffer is returned as nullptr.
+chunk_ptr payload_pool::lease(size_t size) NOEXCEPT
+{
+    const auto index = size_class(size) - minimum_class;
+
+    if (index < classes_)
+    {
+        std::lock_guard lock(mutex_);
+        auto& buffers = pool_.at(index);
+        if (!buffers.empty())
+        {
+            auto buffer = std::move(buffers.back());
+            buffers.pop_back();
+            buffer->resize(size);
+            return buffer;
+        }
+    }
+
+    try
+    {
+        // Reserve the full class so that the buffer is reusable for the class.
+        const auto buffer = std::make_shared<data_chunk>();
+        buffer->reserve(index < classes_ ? power2(size_class(size)) : size);
+
+        // Advise before the fill faults in the (untouched) reservation, as
+        // pooled buffers retain their backing for the life of the process.
+        if (huge_pages_ && index < classes_ && size_class(size) >= huge_class)
+            advise_huge(buffer->data(), buffer->capacity());
+
+        buffer->resize(size);
+        return buffer;
+    }
+    catch (const std::exception&)
+    {
+        return {};
+    }
+}
+
+// A buffer referenced elsewhere (e.g. retained by a message) is not pooled.
+void payload_pool::release(chunk_ptr&& buffer) NOEXCEPT
+{
+    if (!buffer || buffer.use_count() != one)
+        return;
+
+    // Floor of capacity, as the buffer must be able to hold any class size.
+    const auto capacity = buffer->capacity();
+    if (capacity < power2(minimum_class))
+        return;
+
+    const auto index = sub1(static_cast<size_t>(std::bit_width(capacity))) -
+        minimum_class;
+    if (index >= classes_)
+        return;
+
+    std::lock_guard lock(mutex_);
+    auto& buffers = pool_.at(index);
+    if (buffers.size() < capacity_)
+        buffers.push_back(std::move(buffer));
+}
+
+// private
+// Only whole huge pages within the allocation can be advised, and failure
+// (e.g. transparent huge pages disabled) leaves the buffer on base pages.
+void payload_pool::advise_huge([[maybe_unused]] uint8_t* data,
+    [[maybe_unused]] size_t size) NOEXCEPT
+{
+#if defined(HAVE_LINUX) && defined(MADV_HUGEPAGE)
+    constexpr uintptr_t mask = sub1(power2(huge_class));
+    BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+    const auto start = reinterpret_cast<uintptr_t>(data);
+    BC_POP_WARNING()
+    const auto begin = (start + mask) & ~mask;
+    const auto end = (start + size) & ~mask;
+    if (begin < end)
+    {
+        BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+        BC_POP_WARNING()
+    }
+#endif
+}
+
+size_t payload_pool::retained() const NOEXCEPT
+{
+    size_t count{};
+    std::lock_guard lock(mutex_);
+    for (const auto& buffers: pool_)
+        count += buffers.size();
+
+    return count;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/pin_sketch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+using element = pin_sketch::element;
+using elements = pin_sketch::elements;
+
+// Coefficients in ascending order, without trailing zeros (zero is empty).
+typedef std::vector<element> polynomial;
+
+constexpr size_t field_bits = to_bits(sizeof(element));
+
+// Field arithmetic.
+// ----------------------------------------------------------------------------
+
+// Fold the bits above 32 by x^32 = x^7 + x^3 + x^2 + 1.
+static constexpr uint64_t fold(uint64_t value) NOEXCEPT
+{
+    const auto high = value >> field_bits;
+    return (value & max_uint32) ^ high ^ (high << 2) ^ (high << 3) ^
+        (high << 7);
+}
+
+// Carryless product by two bit windows, then reduced in two folds.
+static constexpr element multiply(element left, element right) NOEXCEPT
+{
+    const uint64_t wide{ left };
+    const std::array<uint64_t, 4> window
+    {
+        0, wide, wide << 1, (wide << 1) ^ wide
+    };
+
+    uint64_t product{};
+    for (size_t bit = 0; bit < field_bits; bit += two)
+        product ^= window[(right >> bit) & 3u] << bit;
+
+    return static_cast<element>(fold(fold(product)));
+}
+
+static constexpr element square(element value) NOEXCEPT
+{
+    return multiply(value, value);
+}
+
+// The multiplicative group has order 2^32 - 1, so a^-1 = a^(2^32 - 2).
+static constexpr element invert(element value) NOEXCEPT
+{
+    element result{ 1 };
+    auto power = square(value);
+    for (size_t bit = 1; bit < field_bits; ++bit)
+    {
+        result = multiply(result, power);
+        power = square(power);
+    }
+
+    return result;
+}
+
+// Polynomial arithmetic (characteristic two, so subtraction is addition).
+// ----------------------------------------------------------------------------
+
+static void trim(polynomial& value) NOEXCEPT
+{
+    while (!value.empty() && is_zero(value.back()))
+        value.pop_back();
+}
+
+static polynomial remainder(polynomial value,
+    const polynomial& modulus) NOEXCEPT
+{
+    const auto inverse = invert(modulus.back());
+    while (value.size() >= modulus.size())
+    {
+        const auto factor = multiply(value.back(), inverse);
+        const auto shift = value.size() - modulus.size();
+        for (size_t index = 0; index < modulus.size(); ++index)
+            value[shift + index] ^= multiply(factor, modulus[index]);
+
+        trim(value);
+    }
+
+    return value;
+}
+
+// The quotient of an exact division.
+static polynomial divide(polynomial value, const polynomial& divisor) NOEXCEPT
+{
+    polynomial quotient(add1(value.size() - divisor.size()));
+    const auto inverse = invert(divisor.back());
+    while (value.size() >= divisor.size())
+    {
+        const auto factor = multiply(value.back(), inverse);
+        const auto shift = value.size() - divisor.size();
+        quotient[shift] = factor;
+        for (size_t index = 0; index < divisor.size(); ++index)
+            value[shift + index] ^= multiply(factor, divisor[index]);
+
+        trim(value);
+    }
+
+    trim(quotient);
+    return quotient;
+}
+
+// Squaring is linear in characteristic two: (sum a.x^i)^2 = sum a^2.x^2i.
+static polynomial square(const polynomial& value,
+    const polynomial& modulus) NOEXCEPT
+{
+    if (value.empty())
+        return {};
+
+    polynomial product(sub1(value.size() * two));
+    for (size_t index = 0; index < value.size(); ++index)
+        product[index * two] = square(value[index]);
+
+    return remainder(std::move(product), modulus);
+}
+
+static polynomial monic(polynomial value) NOEXCEPT
+{
+    if (value.empty())
+        return value;
+
+    const auto inverse = invert(value.back());
+    for (auto& coefficient: value)
+        coefficient = multiply(coefficient, inverse);
+
+    return value;
+}
+
+static polynomial gcd(polynomial left, polynomial right) NOEXCEPT
+{
+    while (!right.empty())
+    {
+        left = remainder(std::move(left), right);
+        std::swap(left, right);
+    }
+
+    return monic(std::move(left));
+}
+
+// Decoding.
+// ----------------------------------------------------------------------------
+
+// The connection polynomial of the power sums (Berlekamp-Massey), with roots
+// that are the inverses of the elements.
+static polynomial connection(const elements& sums) NOEXCEPT
+{
+    polynomial current{ 1 };
+    polynomial prior{ 1 };
+    element discrepancy{ 1 };
+    size_t length{};
+    size_t shift{ 1 };
+
+    for (size_t index = 0; index < sums.size(); ++index)
+    {
+        auto delta = sums[index];
+        for (size_t term = 1; term <= length && term < current.size(); ++term)
+            delta ^= multiply(current[term], sums[index - term]);
+
+        if (is_zero(delta))
+        {
+            ++shift;
+            continue;
+        }
+
+        const auto factor = multiply(delta, invert(discrepancy));
+        const auto previous = current;
+        if (current.size() < prior.size() + shift)
+            current.resize(prior.size() + shift);
+
+        for (size_t term = 0; term < prior.size(); ++term)
+            current[term + shift] ^= multiply(factor, prior[term]);
+
+        if (length * two <= index)
+        {
+            length = add1(index) - length;
+            prior = previous;
+            discrepancy = delta;
+            shift = one;
+        }
+        else
+        {
+            ++shift;
+        }
+    }
+
+    trim(current);
+    return current.size() == add1(length) ? current : polynomial{};
+}
+
+// The polynomial divides x^(2^32) - x, so it has distinct roots in the field.
+static bool is_splitting(const polynomial& value) NOEXCEPT
+{
+    const auto identity = remainder({ 0, 1 }, value);
+    auto power = identity;
+    for (size_t bit = 0; bit < field_bits; ++bit)
+        power = square(power, value);
+
+    return power == identity;
+}
+
+// Berlekamp trace algorithm, each basis element beta splits the roots by the
+// trace of beta.root, and any two distinct roots differ by some basis trace.
+// The trace sum (beta.x)^(2^i) is sum beta^(2^i).x^(2^i), so the powers of x
+// are squared once for all betas.
+static bool roots(const polynomial& value, size_t basis,
+    elements& out) NOEXCEPT
+{
+    if (value.size() <= one)
+        return true;
+
+    // Monic linear x + r has the root r.
+    if (value.size() == two)
+    {
+        out.push_back(value.front());
+        return true;
+    }
+
+    std::vector<polynomial> powers(field_bits);
+    powers.front() = remainder({ 0, 1 }, value);
+    for (size_t bit = 1; bit < field_bits; ++bit)
+        powers[bit] = square(powers[sub1(bit)], value);
+
+    for (; basis < field_bits; ++basis)
+    {
+        polynomial trace(sub1(value.size()));
+        auto beta = element{ 1 } << basis;
+        for (const auto& power: powers)
+        {
+            for (size_t index = 0; index < power.size(); ++index)
+                trace[index] ^= multiply(beta, power[index]);
+
+            beta = square(beta);
+        }
+
+        trim(trace);
+        const auto factor = gcd(value, trace);
+        if (factor.size() > one && factor.size() < value.size())
+            return roots(factor, add1(basis), out) &&
+                roots(monic(divide(value, factor)), add1(basis), out);
+    }
+
+    return false;
+}
+
+// pin_sketch.
+// ----------------------------------------------------------------------------
+
+size_t pin_sketch::serialized_size(size_t capacity) NOEXCEPT
+{
+    return capacity * sizeof(element);
+}
+
+pin_sketch::pin_sketch(size_t capacity) NOEXCEPT
+  : sums_(capacity)
+{
+}
+
+pin_sketch::pin_sketch(const data_slice& data) NOEXCEPT
+  : sums_(data.size() / sizeof(element))
+{
+    for (size_t index = 0; index < sums_.size(); ++index)
+        for (size_t byte = 0; byte < sizeof(element); ++byte)
+            sums_[index] |= element{ data[index * sizeof(element) + byte] } <<
+                to_bits(byte);
+}
+
+size_t pin_sketch::capacity() const NOEXCEPT
+{
+    return sums_.size();
+}
+
+void pin_sketch::add(element value) NOEXCEPT
+{
+    if (is_zero(value))
+        return;
+
+    const auto squared = square(value);
+    auto power = value;
+    for (auto& sum: sums_)
+    {
+        sum ^= power;
+        power = multiply(power, squared);
+    }
+}
+
+void pin_sketch::merge(const pin_sketch& other) NOEXCEPT
+{
+    if (other.sums_.size() < sums_.size())
+        sums_.resize(other.sums_.size());
+
+    for (size_t index = 0; index < sums_.size(); ++index)
+        sums_[index] ^= other.sums_[index];
+}
+
+bool pin_sketch::decode(elements& out) const NOEXCEPT
+{
+    out.clear();
+    if (std::all_of(sums_.begin(), sums_.end(),
+        [](element sum) NOEXCEPT { return is_zero(sum); }))
+        return true;
+
+    // Even power sums are implied, s(2k) = s(k)^2 (sums[n] is s(n + 1)).
+    elements sums(sums_.size() * two);
+    for (size_t index = 0; index < sums.size(); ++index)
+        sums[index] = is_even(index) ? sums_[index / two] :
+            square(sums[sub1(add1(index) / two)]);
+
+    // The reversed connection polynomial has the elements as roots.
+    auto locator = connection(sums);
+    if (locator.size() <= one || sub1(locator.size()) > capacity())
+        return false;
+
+    std::reverse(locator.begin(), locator.end());
+    locator = monic(std::move(locator));
+    if (!is_splitting(locator))
+        return false;
+
+    if (!roots(locator, zero, out) || out.size() != sub1(locator.size()))
+    {
+        out.clear();
+        return false;
+    }
+
+    return true;
+}
+
+data_chunk pin_sketch::serialize() const NOEXCEPT
+{
+    data_chunk out(serialized_size(capacity()));
+    for (size_t index = 0; index < sums_.size(); ++index)
+        for (size_t byte = 0; byte < sizeof(element); ++byte)
+            out[index * sizeof(element) + byte] =
+                static_cast<uint8_t>(sums_[index] >> to_bits(byte));
+
+    return out;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/pipe.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Completions are posted (not invoked) to preclude recursion through the
+// proxy read and write loops, which would otherwise complete synchronously.
+
+// Construction.
+// ----------------------------------------------------------------------------
+
+pipe::pair pipe::create(const logger& log, asio::io_context& service) NOEXCEPT
+{
+    const auto inbound = std::make_shared<pipe>(log, service, true);
+    const auto outbound = std::make_shared<pipe>(log, service, false);
+    inbound->peer_ = outbound;
+    outbound->peer_ = inbound;
+    return { inbound, outbound };
+}
+
+pipe::pipe(const logger& log, asio::io_context& service, bool inbound) NOEXCEPT
+  : socket(log, service), inbound_(inbound)
+{
+}
+
+pipe::~pipe() NOEXCEPT
+{
+    BC_ASSERT_MSG(stopped(), "pipe is not stopped");
+    if (!stopped()) { LOGF("~pipe is not stopped."); }
+}
+
+pipe::ptr pipe::self() NOEXCEPT
+{
+    return std::static_pointer_cast<pipe>(shared_from_this());
+}
+
+// Stop.
+// ----------------------------------------------------------------------------
+
+void pipe::stop() NOEXCEPT
+{
+    if (stopped_.load())
+        return;
+
+    stopped_.store(true);
+    boost::asio::post(strand_,
+        std::bind(&pipe::do_stop, self()));
+}
+
+// private
+void pipe::do_stop() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (reader_)
+        complete(error::channel_stopped);
+
+    buffer_.clear();
+    offset_ = zero;
+
+    if (const auto peer = peer_.lock())
+        boost::asio::post(peer->strand(),
+            std::bind(&pipe::do_disconnect, peer));
+}
+
+// Connection.
+// ----------------------------------------------------------------------------
+
+void pipe::accept(asio::acceptor&, result_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(strand_,
+        std::bind(std::move(handler), error::success));
+}
+
+void pipe::connect(const asio::endpoints&, result_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(strand_,
+        std::bind(std::move(handler), error::success));
+}
+
+void pipe::connect(const asio::endpoint&, bool,
+    result_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(strand_,
+        std::bind(std::move(handler), error::success));
+}
+
+// I/O.
+// ----------------------------------------------------------------------------
+
+void pipe::read(const data_slab& out, count_handler&& handler) NOEXCEPT
+{
+    boost::asio::dispatch(strand_,
+        std::bind(&pipe::do_read, self(),
+            asio::mutable_buffer{ out.data(), out.size() },
+                std::move(handler)));
+}
+
+void pipe::write(const data_slice& in, count_handler&& handler) NOEXCEPT
+{
+    // The caller's buffer need only remain valid until the copy.
+    boost::asio::dispatch(strand_,
+        std::bind(&pipe::do_write, self(),
+            to_shared<data_chunk>(in.begin(), in.end()),
+                std::move(handler)));
+}
+
+void pipe::write(const asio::const_buffers& in,
+    count_handler&& handler) NOEXCEPT
+{
+    const auto data = std::make_shared<data_chunk>();
+    data->reserve(boost::asio::buffer_size(in));
+    for (const auto& buffer: in)
+    {
+        const auto begin = pointer_cast<const uint8_t>(buffer.data());
+        data->insert(data->end(), begin, std::next(begin, buffer.size()));
+    }
+
+    boost::asio::dispatch(strand_,
+        std::bind(&pipe::do_write, self(), data, std::move(handler)));
+}
+
+// private
+void pipe::do_read(const asio::mutable_buffer& out,
+    const count_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    BC_ASSERT_MSG(!reader_, "concurrent pipe read");
+
+    if (stopped())
+    {
+        boost::asio::post(strand_,
+            std::bind(handler, error::channel_stopped, zero));
+        return;
+    }
+
+    pending_ = out;
+    filled_ = zero;
+    reader_ = handler;
+    fill();
+}
+
+// private
+void pipe::do_write(const chunk_ptr& data,
+    const count_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto peer = peer_.lock();
+    const auto ec = stopped() ? error::channel_stopped :
+        (disconnected_ || !peer ? error::peer_disconnect : error::success);
+
+    if (!ec)
+        boost::asio::post(peer->strand(),
+            std::bind(&pipe::do_receive, peer, data));
+
+    boost::asio::post(strand_,
+        std::bind(handler, ec, ec ? zero : data->size()));
+}
+
+// private
+void pipe::do_receive(const chunk_ptr& data) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped())
+        return;
+
+    buffer_.insert(buffer_.end(), data->begin(), data->end());
+    if (reader_)
+        fill();
+}
+
+// private
+void pipe::do_disconnect() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    disconnected_ = true;
+    if (reader_)
+        fill();
+}
+
+// Copy buffered bytes to the pending read, completing it if full.
+void pipe::fill() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto available = buffer_.size() - offset_;
+    const auto needed = pending_.size() - filled_;
+    const auto bytes = std::min(available, needed);
+    const auto from = std::next(buffer_.begin(), offset_);
+    std::copy(from, std::next(from, bytes),
+        std::next(pointer_cast<uint8_t>(pending_.data()), filled_));
+
+    filled_ += bytes;
+    offset_ += bytes;
+
+    // Reclaim consumed bytes when empty or mostly consumed.
+    if (offset_ == buffer_.size())
+    {
+        buffer_.clear();
+        offset_ = zero;
+    }
+    else if (offset_ > (buffer_.size() / two))
+    {
+        buffer_.erase(buffer_.begin(), std::next(buffer_.begin(), offset_));
+        offset_ = zero;
+    }
+
+    if (filled_ == pending_.size())
+        complete(error::success);
+    else if (disconnected_)
+        complete(error::peer_disconnect);
+}
+
+void pipe::complete(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto handler = std::move(reader_);
+    reader_ = {};
+    pending_ = {};
+    boost::asio::post(strand_,
+        std::bind(handler, ec, filled_));
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+bool pipe::inbound() const NOEXCEPT
+{
+    return inbound_;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -20,11 +20,14 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/lz4.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -39,26 +42,47 @@ using namespace system;
 using namespace messages;
 using namespace std::placeholders;
 
+// Read deferral of a channel holding excess memory under pressure.
+constexpr auto pressure_delay = milliseconds(100);
+
+// Buffered messages dispatched in one strand turn before yielding the strand.
+constexpr size_t read_burst = 16;
+
+// Scheduling round in which a channel may spend its read quantum.
+constexpr auto read_round = milliseconds(100);
+
 // Dump up to this size of payload as hex in order to diagnose failure.
 static constexpr size_t invalid_payload_dump_size = chain::max_block_size;
 static constexpr uint32_t http_magic  = 0x20544547;
 static constexpr uint32_t https_magic = 0x02010316;
 
+// A compressed envelope is the command of the message, the size of its
+// payload, and the payload compressed with the transaction dictionary.
+static const std::string envelope_command{ "compressed" };
+static constexpr size_t envelope_prefix = heading::command_size +
+    sizeof(uint32_t);
+
 // This is created in a started state and must be stopped, as the subscribers
 // assert if not stopped. Subscribers may hold protocols even if the service
 // is not started.
-proxy::proxy(const socket::ptr& socket) NOEXCEPT
+proxy::proxy(const socket::ptr& socket, const payload_pool::ptr& pool,
+    const memory_budget::ptr& memory) NOEXCEPT
   : socket_(socket),
+    pool_(pool),
+    memory_(memory),
     stop_subscriber_(socket->strand()),
+    congestion_subscriber_(socket->strand()),
     distributor_(socket->strand()),
     reporter(socket->log)
 {
+    memory_->attach();
 }
 
 proxy::~proxy() NOEXCEPT
 {
     BC_ASSERT_MSG(stopped(), "proxy is not stopped");
     if (!stopped()) { LOGF("~proxy is not stopped."); }
+    memory_->detach();
 }
 
 // Pause (proxy is created paused).
@@ -73,6 +97,7 @@ void proxy::pause() NOEXCEPT
 void proxy::resume() NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    set_limits();
     paused_ = false;
     read_heading();
 }
@@ -83,6 +108,58 @@ bool proxy::paused() const NOEXCEPT
     return paused_;
 }
 
+// Flow control (credit granted by consumers, held reads resume on grant).
+// ----------------------------------------------------------------------------
+
+void proxy::grant(size_t messages, size_t bytes) NOEXCEPT
+{
+    boost::asio::dispatch(strand(),
+        std::bind(&proxy::do_grant,
+            shared_from_this(), messages, bytes));
+}
+
+void proxy::do_grant(size_t messages, size_t bytes) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    flow_control_ = true;
+    credit_messages_ = ceilinged_add(credit_messages_, messages);
+    credit_bytes_ = ceilinged_add(credit_bytes_, bytes);
+
+    // A read in progress is not held, so only a held read is restarted.
+    if (starved_ && credited())
+    {
+        starved_ = false;
+        read_heading();
+    }
+}
+
+bool proxy::starved() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return starved_;
+}
+
+bool proxy::credited() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return !flow_control_ ||
+        (!is_zero(credit_messages_) && !is_zero(credit_bytes_));
+}
+
+// Control messages do not consume credit (but are held with other reads).
+void proxy::consume(size_t bytes) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!flow_control_ ||
+        distributor_.priority(heading_.id) == distributor::lane::control)
+        return;
+
+    credit_messages_ = floored_subtract(credit_messages_, one);
+    credit_bytes_ = floored_subtract(credit_bytes_, bytes);
+}
+
 // Stop (socket/proxy started upon create).
 // ----------------------------------------------------------------------------
 
@@ -112,7 +189,26 @@ void proxy::do_stop(const code& ec) NOEXCEPT
     BC_ASSERT_MSG(stranded(), "strand");
     
     // Clear the write buffer, which holds handlers.
-    queue_.clear();
+    memory_->release(backlog_.load());
+    for (auto& queue: queues_)
+        queue.clear();
+
+    pending_.clear();
+    files_.clear();
+    filing_ = nullptr;
+
+    // Cancel rate limit waits (handlers ignore cancelation).
+    if (read_timer_) read_timer_->stop();
+    if (write_timer_) write_timer_->stop();
+    if (grace_timer_) grace_timer_->stop();
+    if (idle_timer_) idle_timer_->stop();
+
+    // Post congestion handlers to strand and clear/stop accepting them.
+    congestion_subscriber_.stop(ec, false);
+
+    // Return any outstanding payload lease (or retained buffer) to the pool.
+    retaining_ = false;
+    return_payload();
 
     // Post message handlers to strand and clear/stop accepting subscriptions.
     // On channel_stopped message subscribers should ignore and perform no work.
@@ -156,13 +252,25 @@ void proxy::do_subscribe_stop(const result_handler& handler,
 // ----------------------------------------------------------------------------
 
 code proxy::notify(identifier id, uint32_t version,
-    const data_chunk& source) NOEXCEPT
+    const chunk_ptr& source, const hash_cptr& hash) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    TRACE_SCOPE(dispatch, trace_id());
 
     // TODO: build witness into feature w/magic and negotiated version.
     // TODO: if self and peer services show witness, set feature true.
-    return distributor_.notify(id, version, source);
+
+    // Processing time is accounted to the channel (and any read quantum).
+    const auto start = steady_clock::now();
+
+    // A retained (block/transaction) payload is not returned to the pool.
+    const auto ec = retain_payload() ?
+        distributor_.notify(id, version, source, hash) :
+        distributor_.notify(id, version, *source, hash);
+
+    processed(steady_clock::now() - start);
+
+    return ec;
 }
 
 void proxy::read_heading() NOEXCEPT
@@ -174,12 +282,112 @@ void proxy::read_heading() NOEXCEPT
     if (stopped() || paused())
         return;
 
+    // Holds the read loop until credit is granted.
+    if (!credited())
+    {
+        starved_ = true;
+        return;
+    }
+
+    // Under memory pressure channels holding over a fair share defer reads.
+    if (memory_->heavy(held()))
+    {
+        wait(read_timer_, pressure_delay,
+            std::bind(&proxy::handle_read_limited,
+                shared_from_this(), _1, zero));
+        return;
+    }
+
+    if (!is_zero(read_ahead()))
+    {
+        read_ahead_heading();
+        return;
+    }
+
     // Post handle_read_heading to strand upon stop, error, or buffer full.
+    count_read();
     socket_->read(heading_buffer_,
         std::bind(&proxy::handle_read_heading,
             shared_from_this(), _1, _2));
 }
 
+// Read-ahead (each socket read takes what is available, up to the buffer).
+// ----------------------------------------------------------------------------
+// Small messages are framed from the buffer without further socket reads, and
+// payloads are read directly once their buffered prefix is taken.
+
+void proxy::read_ahead_heading() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Buffered messages are dispatched within the strand turn of their read,
+    // up to the burst limit, after which the strand is yielded (and the
+    // recursion bounded) by posting the next.
+    if (ahead_end_ - ahead_begin_ >= heading::size())
+    {
+        take_ahead(heading_buffer_);
+        if (++burst_ < read_burst)
+        {
+            handle_read_heading(error::success, heading::size());
+            return;
+        }
+
+        burst_ = zero;
+        boost::asio::post(strand(),
+            std::bind(&proxy::handle_read_heading,
+                shared_from_this(), error::success, heading::size()));
+        return;
+    }
+
+    if (ahead_.empty())
+        ahead_.resize(std::max(read_ahead(), heading::size()));
+
+    // Shift a partial heading to the front, making room for the remainder.
+    const auto begin = ahead_.begin();
+    std::copy(std::next(begin, ahead_begin_), std::next(begin, ahead_end_),
+        begin);
+    ahead_end_ -= ahead_begin_;
+    ahead_begin_ = zero;
+
+    // Post handle_read_ahead to strand upon stop, error, or any bytes read.
+    count_read();
+    socket_->read_some({ std::next(begin, ahead_end_), ahead_.end() },
+        std::bind(&proxy::handle_read_ahead,
+            shared_from_this(), _1, _2));
+}
+
+void proxy::handle_read_ahead(const code& ec, size_t bytes) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Stop and failure are handled (and logged) as a heading read.
+    if (stopped() || ec)
+    {
+        handle_read_heading(ec, zero);
+        return;
+    }
+
+    ahead_end_ += bytes;
+    burst_ = zero;
+    read_ahead_heading();
+}
+
+// Buffered bytes are moved to the front of out, returning the number taken.
+size_t proxy::take_ahead(const data_slab& out) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto size = std::min(out.size(), ahead_end_ - ahead_begin_);
+    const auto begin = std::next(ahead_.begin(), ahead_begin_);
+    std::copy(begin, std::next(begin, size), out.begin());
+    ahead_begin_ += size;
+
+    if (ahead_begin_ == ahead_end_)
+        ahead_begin_ = ahead_end_ = zero;
+
+    return size;
+}
+
 void proxy::handle_read_heading(const code& ec, size_t) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
@@ -203,57 +411,108 @@ void proxy::handle_read_heading(const code& ec, size_t) NOEXCEPT
         return;
     }
 
+    // The read loop is sequential, so the heading is parsed in place.
     heading_reader_.set_position(zero);
-    const auto head = to_shared(heading::deserialize(heading_reader_));
-
-    if (!heading_reader_)
+    if (!heading_.deserialize(heading_reader_))
     {
         LOGR("Invalid heading from [" << authority() << "]");
         stop(error::invalid_heading);
         return;
     }
 
-    if (head->magic != protocol_magic())
+    if (heading_.magic != protocol_magic())
     {
-        if (head->magic == http_magic || head->magic == https_magic)
+        if (heading_.magic == http_magic || heading_.magic == https_magic)
         {
             LOGR("Http/s request from [" << authority() << "]");
         }
         else
         {
-            LOGR("Invalid heading magic (0x"
-                << encode_base16(to_little_endian(head->magic))
-                << ") from [" << authority() << "]");
+            LOGRB(invalid_magic, to_little_endian(heading_.magic),
+                authority().to_string());
         }
 
         stop(error::invalid_magic);
         return;
     }
 
-    if (head->payload_size > maximum_payload())
+    // Each message is limited by its own maximal size, before allocation.
+    if (heading_.payload_size > heading::maximum_payload(heading_.id,
+        maximum_payload()))
     {
-        LOGR("Oversized payload indicated by " << head->command
+        LOGR("Oversized payload indicated by " << heading_.command_text()
             << " heading from [" << authority() << "] ("
-            << head->payload_size << " bytes)");
+            << heading_.payload_size << " bytes)");
 
         stop(error::oversized_payload);
         return;
     }
 
-    // Buffer reserve increases with each larger message (up to maximum).
-    payload_buffer_.resize(head->payload_size);
+    // The message span ends upon notification (or stop).
+    TRACE_BEGIN(message, trace_id());
+    USDT4(read_heading, trace_id(), heading_.id, heading_.command.data(),
+        heading_.payload_size);
+
+    // Lease a buffer (or reuse the retained one), released once notified.
+    lease_payload(heading_.payload_size);
+    if (!payload_buffer_)
+    {
+        LOGF("Payload allocation failed for " << heading_.command_text()
+            << " heading from [" << authority() << "] ("
+            << heading_.payload_size << " bytes)");
+
+        stop(error::operation_failed);
+        return;
+    }
+
+    // Bytes buffered by read-ahead are taken first (the remainder is read).
+    const auto taken = take_ahead(*payload_buffer_);
+
+    // Large payloads are hashed as chunks arrive, and blocks also parsed.
+    const auto chunk = read_chunk();
+    const auto stream = heading_.id == identifier::block &&
+        distributor_.subscribed(heading_.id);
+    if (!is_zero(chunk) && heading_.payload_size > chunk &&
+        (stream || validate_checksum()))
+    {
+        if (stream)
+        {
+            BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+            block_stream_ = std::make_unique<block_stream>(payload_buffer_,
+                version(), retain_payload());
+            BC_POP_WARNING()
+        }
+
+        if (is_zero(taken))
+            read_payload_chunk(zero);
+        else
+            handle_read_payload_chunk(error::success, taken, zero);
+
+        return;
+    }
+
+    // An empty or fully buffered payload requires no read.
+    if (taken == heading_.payload_size)
+    {
+        handle_read_payload(error::success, taken);
+        return;
+    }
 
     // Post handle_read_payload to strand upon stop, error, or buffer full.
-    socket_->read(payload_buffer_,
+    count_read();
+    socket_->read({ std::next(payload_buffer_->begin(), taken),
+        payload_buffer_->end() },
         std::bind(&proxy::handle_read_payload,
-            shared_from_this(), _1, _2, head));
+            shared_from_this(), _1, _2));
 }
 
 // Handle errors and post message to subscribers.
-void proxy::handle_read_payload(const code& ec, size_t LOG_ONLY(payload_size),
-    const heading_ptr& head) NOEXCEPT
+void proxy::handle_read_payload(const code& ec, size_t) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    PROBE(proxy_deserialize);
+    USDT4(read_payload, trace_id(), heading_.command.data(),
+        heading_.payload_size, ec.value());
 
     if (stopped())
     {
@@ -274,12 +533,26 @@ void proxy::handle_read_payload(const code& ec, size_t LOG_ONLY(payload_size),
         return;
     }
 
+    record();
+
+    // Small payloads may be hashed together with those of other channels.
+    if (validate_checksum() && batch_checksum() &&
+        heading_.payload_size <= checksum_batcher::maximum_payload)
+    {
+        checksums().submit(payload_buffer_, strand(),
+            std::bind(&proxy::handle_checksum,
+                shared_from_this(), _1));
+        return;
+    }
+
+    // The payload hash is passed to deserialization for identity reuse.
+    hash_cptr hash{};
     if (validate_checksum())
     {
-        // This hash could be reused as w/txid, but simpler to disable check.
-        if (head->checksum != network_checksum(bitcoin_hash(payload_buffer_)))
+        hash = to_shared(bitcoin_hash(*payload_buffer_));
+        if (heading_.checksum != network_checksum(*hash))
         {
-            LOGR("Invalid " << head->command << " payload from ["
+            LOGR("Invalid " << heading_.command_text() << " payload from ["
                 << authority() << "] bad checksum.");
 
             stop(error::invalid_checksum);
@@ -287,139 +560,1318 @@ void proxy::handle_read_payload(const code& ec, size_t LOG_ONLY(payload_size),
         }
     }
 
-    // Notify subscribers of the new message.
-    const auto code = notify(head->id(), version(), payload_buffer_);
+    handle_payload(hash);
+}
 
-    if (code)
-    {
-        LOGR("Invalid " << head->command << " payload from [" << authority()
-            << "] (" << encode_base16({ payload_buffer_.begin(),
-                std::next(payload_buffer_.begin(), std::min(payload_size,
-                invalid_payload_dump_size))}) << ") " << code.message());
+void proxy::handle_checksum(const hash_cptr& hash) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
 
-        stop(code);
+    if (stopped())
+    {
+        LOGQ("Payload checksum abort [" << authority() << "]");
+        stop(error::channel_stopped);
         return;
     }
 
-    // Don't retain larger than configured (time-space tradeoff).
-    payload_buffer_.resize(std::min(payload_buffer_.size(), minimum_buffer()));
-    payload_buffer_.shrink_to_fit();
+    if (heading_.checksum != network_checksum(*hash))
+    {
+        LOGR("Invalid " << heading_.command_text() << " payload from ["
+            << authority() << "] bad checksum.");
 
-    LOGX("Recv " << head->command << " from [" << authority()
-        << "] (" << payload_size << " bytes)");
+        stop(error::invalid_checksum);
+        return;
+    }
 
-    signal_activity();
-    read_heading();
+    handle_payload(hash);
 }
 
-// Send cycle (send continues until queue is empty).
-// ----------------------------------------------------------------------------
-// stackoverflow.com/questions/7754695/boost-asio-async-write-how-to-not-
-// interleaving-async-write-calls
-
-void proxy::write(const system::chunk_ptr& payload,
-    const result_handler& handler) NOEXCEPT
+void proxy::handle_payload(const hash_cptr& hash) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
-    if (stopped())
+    // The envelope hash does not identify the message, so it is dropped.
+    if (expand_ && heading_.id == identifier::unknown && enveloped())
     {
-        LOGQ("Payload write abort [" << authority() << "]");
-        handler(error::channel_stopped);
+        if (!expand())
+        {
+            LOGR("Invalid compressed payload from [" << authority() << "]");
+            handle_notify(error::invalid_message);
+            return;
+        }
+
+        handle_payload({});
         return;
     }
 
-    const auto started = !queue_.empty();
-    queue_.push_back(std::make_pair(payload, handler));
-    total_ = ceilinged_add(total_.load(), payload->size());
-    backlog_ = ceilinged_add(backlog_.load(), payload->size());
+    publish(hash);
+
+    // List messages are rejected by count and size before element parsing.
+    if (distributor_.subscribed(heading_.id) &&
+        !heading::prescan(heading_.id, *payload_buffer_))
+    {
+        LOGR("Malformed " << heading_.command_text() << " payload from ["
+            << authority() << "] (" << heading_.payload_size << " bytes)");
+        handle_notify(error::invalid_message);
+        return;
+    }
 
-    LOGX("Queue for [" << authority() << "]: " << queue_.size()
-        << " (" << backlog_.load() << " of " << total_.load() << " bytes)");
+    // Large payloads are parsed off of the strand, with the read loop held
+    // until delivery, so that message order is preserved for the channel.
+    // Control messages are always parsed on the strand and bulk messages
+    // always off of it, so that bulk parsing does not hold network threads.
+    const auto threshold = deserialize_threshold();
+    const auto lane = distributor_.priority(heading_.id);
+    const auto large = heading_.payload_size >= threshold;
+    if (!is_zero(threshold) && lane != distributor::lane::control &&
+        (lane == distributor::lane::bulk || large) &&
+        distributor_.subscribed(heading_.id))
+    {
+        deserialize(hash);
+        return;
+    }
 
-    // Start the loop if it wasn't already started.
-    if (!started)
-        write();
+    // Notify subscribers of the new message.
+    handle_notify(notify(heading_.id, version(), payload_buffer_, hash));
 }
 
-void proxy::write() NOEXCEPT
+void proxy::handle_notify(const code& ec) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    TRACE_END(message, trace_id());
 
-    if (queue_.empty())
+    if (ec)
+    {
+        // Payload bytes are copied raw (up to the record), formatted later.
+        LOGRB(invalid_payload, heading_.command_text(), authority().to_string(),
+            data_slice{ payload_buffer_->begin(),
+                std::next(payload_buffer_->begin(), std::min(
+                size_t{ heading_.payload_size }, invalid_payload_dump_size)) },
+            ec);
+
+        return_payload();
+        stop(ec);
         return;
+    }
 
-    auto& job = queue_.front();
-    socket_->write(*job.first,
-        std::bind(&proxy::handle_write,
-            shared_from_this(), _1, _2, job.first, job.second));
+    // Pool does not reclaim the buffer if retained by a message (zero-copy).
+    release_payload();
+
+    if (sampled())
+    {
+        LOGX("Recv " << heading_.command_text() << " from [" << authority()
+            << "] (" << heading_.payload_size << " bytes)");
+    }
+
+    const auto bytes = heading::size() + heading_.payload_size;
+    received_.fetch_add(bytes, std::memory_order_relaxed);
+    traffic_.receive(heading_.id, bytes);
+    aggregate().receive(heading_.id, bytes);
+    signal_activity();
+    consume(bytes);
+    read_limited(bytes);
 }
 
-void proxy::handle_write(const code& ec, size_t,
-    const system::chunk_ptr& LOG_ONLY(payload),
-    const result_handler& handler) NOEXCEPT
+// Chunked read (payload hashed, and block parsed, incrementally).
+// ----------------------------------------------------------------------------
+
+void proxy::read_payload_chunk(size_t offset) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto begin = std::next(payload_buffer_->begin(), offset);
+    const auto size = std::min(read_chunk(), payload_buffer_->size() - offset);
+
+    // Post handle_read_payload_chunk to strand upon stop, error, or full.
+    count_read();
+    socket_->read({ begin, std::next(begin, size) },
+        std::bind(&proxy::handle_read_payload_chunk,
+            shared_from_this(), _1, _2, offset));
+}
+
+void proxy::handle_read_payload_chunk(const code& ec, size_t bytes,
+    size_t offset) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
     if (stopped())
     {
-        LOGQ("Send abort [" << authority() << "]");
+        LOGQ("Payload read abort [" << authority() << "]");
+        block_stream_.reset();
         stop(error::channel_stopped);
         return;
     }
 
-    // guarded by write().
-    backlog_ = floored_subtract(backlog_.load(), queue_.front().first->size());
-    queue_.pop_front();
-
-    LOGX("Dequeue for [" << authority() << "]: " << queue_.size()
-        << " (" << backlog_.load() << " bytes)");
-
-    // All handlers must be invoked, so continue regardless of error state.
-    // Handlers are invoked in queued order, after all outstanding complete.
-    write();
-
     if (ec)
     {
         if (ec != error::peer_disconnect && ec != error::operation_canceled)
         {
-            LOGF("Send failure " << heading::get_command(*payload) << " to ["
-                << authority() << "] (" << payload->size() << " bytes) "
+            LOGF("Payload read failure [" << authority() << "] "
                 << ec.message());
         }
 
+        block_stream_.reset();
         stop(ec);
-        handler(ec);
         return;
     }
 
-    LOGX("Sent " <<  heading::get_command(*payload) << " to ["
-        << authority() << "] (" << payload->size() << " bytes)");
+    // The next read is started before this chunk is processed, so that
+    // hashing and parsing overlap the transfer of the remainder.
+    const auto filled = offset + bytes;
+    if (filled < payload_buffer_->size())
+        read_payload_chunk(filled);
+
+    if (validate_checksum())
+        payload_hash_.write({ std::next(payload_buffer_->begin(), offset),
+            std::next(payload_buffer_->begin(), filled) });
+
+    if (block_stream_ && !block_stream_->advance(filled))
+    {
+        LOGR("Invalid " << heading_.command_text() << " payload from ["
+            << authority() << "] at (" << filled << ") bytes");
+
+        block_stream_.reset();
+        stop(error::invalid_message);
+        return;
+    }
 
-    handler(ec);
+    if (filled == payload_buffer_->size())
+    {
+        record();
+        handle_read_stream();
+    }
 }
 
-// Properties.
+void proxy::handle_read_stream() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // The checksum is available upon arrival of the final chunk.
+    hash_cptr hash{};
+    if (validate_checksum())
+    {
+        hash = to_shared(payload_hash_.flush());
+        if (heading_.checksum != network_checksum(*hash))
+        {
+            LOGR("Invalid " << heading_.command_text() << " payload from ["
+                << authority() << "] bad checksum.");
+
+            block_stream_.reset();
+            stop(error::invalid_checksum);
+            return;
+        }
+    }
+
+    // Not parsed incrementally, so it is dispatched as a whole payload.
+    if (!block_stream_)
+    {
+        handle_payload(hash);
+        return;
+    }
+
+    const auto message = block_stream_->finish(hash);
+    block_stream_.reset();
+
+    if (!message)
+    {
+        handle_notify(error::invalid_message);
+        return;
+    }
+
+    publish(hash);
+    const auto start = steady_clock::now();
+    distributor_.deliver<messages::block>(message);
+    processed(steady_clock::now() - start);
+    handle_notify(error::success);
+}
+
+// On-strand processing is charged to the channel, aggregate and read quantum.
+void proxy::processed(const steady_clock::duration& elapsed) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    traffic_.process(elapsed);
+    aggregate().process(elapsed);
+
+    if (read_quantum() != deadline::duration::zero())
+        spent_ += elapsed;
+}
+
+// The raw heading and payload are captured as read, before any processing.
+void proxy::record() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (const auto capture = recorder())
+        capture->write(heading_buffer_, *payload_buffer_);
+}
+
+// Validated (and expanded) payloads are exported as shared, not copied.
+void proxy::publish(const hash_cptr& hash) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (const auto sink = exporter())
+        sink->submit(heading_.id, trace_id(), version(), payload_buffer_,
+            hash);
+}
+
+// Rate limiting (pauses the read/write loops for time to replenish).
 // ----------------------------------------------------------------------------
 
-asio::strand& proxy::strand() NOEXCEPT
+// Property values are virtual, so the limits are set upon first resume.
+void proxy::set_limits() NOEXCEPT
 {
-    return socket_->strand();
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (limited_)
+        return;
+
+    limited_ = true;
+    reads_ = { rate_limit(), seconds{ 1 } };
+    writes_ = { rate_limit(), seconds{ 1 } };
 }
 
-bool proxy::stranded() const NOEXCEPT
+deadline::duration proxy::limited(throttle& limit, size_t bytes) NOEXCEPT
 {
-    return socket_->stranded();
+    BC_ASSERT_MSG(stranded(), "strand");
+    return limit.consume(bytes) ? deadline::duration{} : limit.delay(bytes);
 }
 
-uint64_t proxy::backlog() const NOEXCEPT
+void proxy::wait(deadline::ptr& timer, const deadline::duration& delay,
+    result_handler&& handler) NOEXCEPT
 {
-    return backlog_.load(std::memory_order_relaxed);
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!timer)
+        timer = std::make_shared<deadline>(log, strand(), delay);
+
+    timer->start(std::move(handler), delay);
 }
 
-uint64_t proxy::total() const NOEXCEPT
+// Bytes of a message received over budget hold the next heading read.
+void proxy::read_limited(size_t bytes) NOEXCEPT
 {
-    return total_.load(std::memory_order_relaxed);
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (const auto delay = limited(reads_, bytes); delay != delay.zero())
+    {
+        LOGX("Read limited [" << authority() << "] ("
+            << bytes << " bytes)");
+
+        wait(read_timer_, delay,
+            std::bind(&proxy::handle_read_limited,
+                shared_from_this(), _1, bytes));
+        return;
+    }
+
+    // Processing over the quantum holds the next heading read, so that each
+    // channel takes a fair share of processing under load.
+    if (const auto delay = quantum_delay(); delay != delay.zero())
+    {
+        LOGX("Read deferred [" << authority() << "] ("
+            << std::chrono::duration_cast<microseconds>(spent_).count()
+            << " us)");
+
+        wait(read_timer_, delay,
+            std::bind(&proxy::handle_read_limited,
+                shared_from_this(), _1, zero));
+        return;
+    }
+
+    read_heading();
+}
+
+// Deficit round robin, by processing time. Each elapsed round grants the
+// quantum against time spent, and time spent in excess of the quantum is
+// carried as a deficit, holding reads until the round in which it is repaid.
+// So a channel of many cheap messages and one of a costly message are held
+// to the same processing time per round.
+deadline::duration proxy::quantum_delay() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto quantum = read_quantum();
+    if (quantum == deadline::duration::zero())
+        return {};
+
+    const auto now = steady_clock::now();
+    if (const auto elapsed = now - round_; elapsed >= read_round)
+    {
+        const auto granted = quantum * (elapsed / read_round);
+        spent_ = spent_ > granted ? spent_ - granted : decltype(spent_){};
+        round_ = now;
+    }
+
+    if (spent_ < quantum)
+        return {};
+
+    return read_round - (now - round_);
+}
+
+void proxy::handle_read_limited(const code& ec, size_t bytes) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        LOGF("Read limit timer failure [" << authority() << "] "
+            << ec.message());
+        stop(ec);
+        return;
+    }
+
+    read_limited(bytes);
+}
+
+void proxy::handle_write_limited(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // A send to another lane may cancel a deferral (and write directly).
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        LOGF("Write limit timer failure [" << authority() << "] "
+            << ec.message());
+        stop(ec);
+        return;
+    }
+
+    deferring_ = false;
+    write();
+}
+
+// Buffer retention (channels relaying large payloads hold their buffer).
+// ----------------------------------------------------------------------------
+// A channel keeps its payload buffer across messages while its recent payload
+// sizes (weighted 1/8) average at least buffer_retain bytes, saving the pool
+// round trip (and any reallocation) for block relay. A retained buffer is
+// returned to the pool once the channel has not released a message into it
+// for buffer_idle, so idle channels do not hold large buffers.
+
+void proxy::lease_payload(size_t size) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    payload_average_ -= payload_average_ / 8u;
+    payload_average_ += size / 8u;
+
+    if (retaining_)
+    {
+        retaining_ = false;
+        if (payload_buffer_->capacity() >= size)
+        {
+            payload_buffer_->resize(size);
+            return;
+        }
+
+        return_payload();
+    }
+
+    payload_buffer_ = pool_->lease(size);
+    if (payload_buffer_)
+    {
+        leased_ = payload_buffer_->capacity();
+        memory_->acquire(leased_);
+    }
+}
+
+void proxy::release_payload() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // A buffer shared by a message (zero-copy) cannot be retained.
+    const auto retain = buffer_retain();
+    const auto idle = buffer_idle();
+    if (is_zero(retain) || idle == idle.zero() || payload_average_ < retain ||
+        payload_buffer_.use_count() != one || memory_->pressured())
+    {
+        return_payload();
+        return;
+    }
+
+    retaining_ = true;
+    retained_ = steady_clock::now();
+
+    // A running idle timer is not restarted, it rearms for the remainder.
+    if (!idling_)
+    {
+        idling_ = true;
+        wait(idle_timer_, idle,
+            std::bind(&proxy::handle_buffer_idle,
+                shared_from_this(), _1));
+    }
+}
+
+void proxy::handle_buffer_idle(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    idling_ = false;
+
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        LOGF("Buffer idle timer failure [" << authority() << "] "
+            << ec.message());
+        stop(ec);
+        return;
+    }
+
+    // The buffer is leased to a read in progress, rearmed upon its release.
+    if (!retaining_)
+        return;
+
+    const auto remaining = retained_ + buffer_idle() - steady_clock::now();
+    if (remaining > remaining.zero())
+    {
+        idling_ = true;
+        wait(idle_timer_, remaining,
+            std::bind(&proxy::handle_buffer_idle,
+                shared_from_this(), _1));
+        return;
+    }
+
+    retaining_ = false;
+    return_payload();
+}
+
+// Accounted bytes are released as the buffer is returned to the pool.
+void proxy::return_payload() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    memory_->release(leased_);
+    leased_ = zero;
+    pool_->release(std::move(payload_buffer_));
+}
+
+size_t proxy::held() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return ceilinged_add(leased_, size_t{ backlog_.load() });
+}
+
+// Compressed relay.
+// ----------------------------------------------------------------------------
+
+void proxy::set_compression(bool send, bool receive) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    compress_ = send;
+    expand_ = receive;
+}
+
+// The message is sent as is unless the envelope is smaller.
+chunk_ptr proxy::compress(const chunk_ptr& payload) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto size = payload->size() - heading::size();
+    if (!compress_ || size < compression_minimum())
+        return payload;
+
+    const auto command = std::next(payload->begin(), sizeof(uint32_t));
+    const auto body = std::next(payload->begin(), heading::size());
+    const auto block = lz4::compress({ body, payload->end() },
+        lz4::transaction_dictionary());
+
+    const auto envelope = envelope_prefix + block.size();
+    if (envelope >= size)
+        return payload;
+
+    const auto packet = std::make_shared<data_chunk>(heading::size() +
+        envelope);
+    const auto start = std::next(packet->begin(), heading::size());
+    const auto length = to_little_endian(possible_narrow_cast<uint32_t>(size));
+    std::copy_n(command, heading::command_size, start);
+    std::copy(length.begin(), length.end(),
+        std::next(start, heading::command_size));
+    std::copy(block.begin(), block.end(), std::next(start, envelope_prefix));
+
+    const auto head = heading::factory(protocol_magic(), envelope_command,
+        { start, packet->end() });
+    head.serialize({ packet->begin(), start });
+    return packet;
+}
+
+bool proxy::enveloped() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Commands are nul padded, and the envelope command is shorter.
+    const auto& command = heading_.command;
+    const auto end = std::next(command.begin(), envelope_command.size());
+    return std::equal(command.begin(), end, envelope_command.begin()) &&
+        is_zero(*end);
+}
+
+// The payload buffer is replaced by the expanded payload, and the heading
+// by that of the enveloped message (sized as expanded, for accounting).
+bool proxy::expand() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (payload_buffer_->size() < envelope_prefix)
+        return false;
+
+    const auto start = payload_buffer_->begin();
+    const auto sizer = std::next(start, heading::command_size);
+    const auto size = from_little_endian<uint32_t>({ sizer,
+        std::next(sizer, sizeof(uint32_t)) });
+
+    // An unknown enveloped command is invalid, as it cannot be dispatched.
+    const auto id = heading::id({ start, sizer });
+    if (id == identifier::unknown)
+        return false;
+
+    // The enveloped message is limited by its own maximal size, as if read.
+    if (size > heading::maximum_payload(id, maximum_payload()))
+        return false;
+
+    auto expanded = pool_->lease(size);
+    if (!expanded || !lz4::decompress(*expanded,
+        { std::next(start, envelope_prefix), payload_buffer_->end() },
+        lz4::transaction_dictionary()))
+    {
+        pool_->release(std::move(expanded));
+        return false;
+    }
+
+    std::copy(start, sizer, heading_.command.begin());
+    heading_.id = id;
+    heading_.payload_size = size;
+
+    return_payload();
+    payload_buffer_ = std::move(expanded);
+    leased_ = payload_buffer_->capacity();
+    memory_->acquire(leased_);
+    return true;
+}
+
+// Off-strand deserialization.
+// ----------------------------------------------------------------------------
+// The payload lease moves with the job, so it is not shared when released.
+
+void proxy::deserialize(const hash_cptr& hash) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    boost::asio::post(deserializer(),
+        [self = shared_from_this(), id = heading_.id, hash,
+            version = version(), payload = std::move(payload_buffer_)]()
+            mutable NOEXCEPT
+        {
+            self->do_deserialize(id, hash, version, std::move(payload));
+        });
+}
+
+// Subscribers are not accessed here, only upon delivery to the strand.
+void proxy::do_deserialize(identifier id, const hash_cptr& hash,
+    uint32_t version, chunk_ptr&& payload) NOEXCEPT
+{
+    TRACE_SCOPE(deserialize, trace_id());
+    distributor::delivery delivery{};
+    const auto start = steady_clock::now();
+    const auto ec = retain_payload() ?
+        distributor_.prepare(delivery, id, version, payload, hash) :
+        distributor_.prepare(delivery, id, version, *payload, hash);
+
+    const auto elapsed = steady_clock::now() - start;
+    traffic_.deserialize(elapsed);
+    aggregate().deserialize(elapsed);
+    traffic_.process(elapsed);
+    aggregate().process(elapsed);
+
+    boost::asio::post(strand(), channel_timed(
+        [self = shared_from_this(), ec, delivery = std::move(delivery),
+            payload = std::move(payload)]() mutable NOEXCEPT
+        {
+            self->handle_deserialize(ec, std::move(delivery),
+                std::move(payload));
+        }));
+}
+
+void proxy::handle_deserialize(const code& ec,
+    distributor::delivery&& delivery, chunk_ptr&& payload) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    payload_buffer_ = std::move(payload);
+
+    if (stopped())
+    {
+        LOGQ("Payload deserialize abort [" << authority() << "]");
+        return_payload();
+        stop(error::channel_stopped);
+        return;
+    }
+
+    // Subscribers are notified only with stop code or error::success.
+    if (!ec)
+    {
+        // Processing time of the delivery is accounted as for notify.
+        const auto start = steady_clock::now();
+        delivery();
+        processed(steady_clock::now() - start);
+    }
+
+    handle_notify(ec);
+}
+
+// Send cycle (send continues until queue is empty).
+// ----------------------------------------------------------------------------
+// stackoverflow.com/questions/7754695/boost-asio-async-write-how-to-not-
+// interleaving-async-write-calls
+
+void proxy::write(const system::chunk_ptr& payload,
+    const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped())
+    {
+        LOGQ("Payload write abort [" << authority() << "]");
+        handler(error::channel_stopped);
+        return;
+    }
+
+    // Serialized payloads always begin with a heading (command at offset).
+    const auto command = std::next(payload->begin(), sizeof(uint32_t));
+    const auto id = heading::id({ command,
+        std::next(command, heading::command_size) });
+    const auto lane = send_lane(id);
+
+    // A duplicate of a waiting announcement completes with it, unsent.
+    if (lane == announcement_lane && deduplicate_sends() &&
+        merge(payload, handler))
+        return;
+
+    // Only bulk messages are compressed, so announcements remain mergeable.
+    const auto packet = lane == bulk_lane ? compress(payload) : payload;
+    USDT4(write, trace_id(), id, &(*command), packet->size());
+
+    const auto started = !is_zero(queued());
+    total_ = ceilinged_add(total_.load(), packet->size());
+    backlog_ = ceilinged_add(backlog_.load(), packet->size());
+    memory_->acquire(packet->size());
+    queues_.at(lane).push_back(std::make_pair(packet, handler));
+    traffic_.send(id, packet->size());
+    traffic_.queue(queued());
+    aggregate().send(id, packet->size());
+    aggregate().queue(queued());
+
+    if (sampled())
+    {
+        LOGX("Queue for [" << authority() << "]: " << queued()
+            << " (" << backlog_.load() << " of " << total_.load()
+            << " bytes)");
+    }
+
+    congest();
+
+    // Start the loop if it wasn't already started, or if it waits only for
+    // the upload budget on bulk, which does not hold other lanes.
+    if (!started)
+    {
+        write();
+    }
+    else if (deferring_ && lane != bulk_lane)
+    {
+        deferring_ = false;
+        write_timer_->stop();
+        write();
+    }
+}
+
+// A file payload is queued (and accounted) with its heading, in the bulk lane
+// (uncompressed and unmerged), and is written upon write of the heading.
+void proxy::write(identifier id, const chunk_ptr& heading,
+    const socket::file_region& payload, const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped())
+    {
+        LOGQ("File write abort [" << authority() << "]");
+        handler(error::channel_stopped);
+        return;
+    }
+
+    const auto started = !is_zero(queued());
+    const auto size = ceilinged_add(heading->size(), payload.size);
+    USDT4(write, trace_id(), id, std::next(heading->data(), sizeof(uint32_t)),
+        size);
+    total_ = ceilinged_add(total_.load(), size);
+    backlog_ = ceilinged_add(backlog_.load(), size);
+    memory_->acquire(size);
+    files_.emplace(heading.get(), payload);
+    queues_.at(bulk_lane).push_back(std::make_pair(heading, handler));
+    traffic_.send(id, size);
+    traffic_.queue(queued());
+    aggregate().send(id, size);
+    aggregate().queue(queued());
+
+    congest();
+
+    // Start the loop if it wasn't already started.
+    if (!started)
+        write();
+}
+
+size_t proxy::file_size(const chunk_ptr& heading) const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (files_.empty())
+        return zero;
+
+    const auto it = files_.find(heading.get());
+    return it == files_.end() ? zero : it->second.size;
+}
+
+void proxy::congest() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Reaching the high water mark notifies subscribers and starts the grace
+    // period, after which the channel is dropped if still congested.
+    const auto high = send_high_water();
+    if (!congested_ && !is_zero(high) && backlog_.load() >= high)
+    {
+        LOGX("Send congested [" << authority() << "] ("
+            << backlog_.load() << " bytes)");
+
+        congested_ = true;
+        congestion_subscriber_.notify(error::success, true);
+
+        if (const auto grace = send_grace(); grace != grace.zero())
+            wait(grace_timer_, grace,
+                std::bind(&proxy::handle_congestion,
+                    shared_from_this(), _1));
+    }
+}
+
+// Responses to liveness and negotiation are never held behind data, and
+// announcements are not held behind bulk data. Messages are reordered only
+// across lanes, so the order of each type (and of the handshake) is kept.
+size_t proxy::send_lane(identifier id) NOEXCEPT
+{
+    switch (id)
+    {
+        case identifier::version:
+        case identifier::version_acknowledge:
+        case identifier::ping:
+        case identifier::pong:
+        case identifier::reject:
+        case identifier::send_compact:
+        case identifier::send_headers:
+        case identifier::wtxid_relay:
+        case identifier::send_reconciliation:
+        case identifier::request_reconciliation:
+        case identifier::request_sketch_extension:
+        case identifier::fee_filter:
+            return control_lane;
+        case identifier::block:
+        case identifier::transaction:
+        case identifier::merkle_block:
+        case identifier::compact_transactions:
+        case identifier::client_filter:
+        case identifier::client_filter_checkpoint:
+        case identifier::client_filter_headers:
+            return bulk_lane;
+        default:
+            return announcement_lane;
+    }
+}
+
+// Duplicate sends (deduplicate_sends).
+// ----------------------------------------------------------------------------
+// Pending announcements are keyed by heading checksum and size, so a miss is
+// constant time. A hit is confirmed by content and by position, as payloads
+// of the write in progress are no longer waiting and cannot be merged.
+
+uint64_t proxy::content_key(const data_chunk& payload) NOEXCEPT
+{
+    constexpr auto offset = heading::size() - sizeof(uint32_t);
+
+    uint64_t key{ payload.size() };
+    for (auto byte = offset; byte < heading::size(); ++byte)
+        key = (key << byte_bits) | payload.at(byte);
+
+    return key;
+}
+
+bool proxy::merge(const chunk_ptr& payload,
+    const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto key = content_key(*payload);
+    const auto range = pending_.equal_range(key);
+    auto& queue = queues_.at(announcement_lane);
+    const auto sliced = slicing_ && slice_lane_ == announcement_lane;
+    const auto waiting = std::next(queue.begin(), std::min(queue.size(),
+        writing_.at(announcement_lane) + (sliced ? one : zero)));
+
+    for (auto entry = range.first; entry != range.second; ++entry)
+    {
+        if (*entry->second != *payload)
+            continue;
+
+        const auto job = std::find_if(waiting, queue.end(),
+            [&](const auto& pending) NOEXCEPT
+            {
+                return pending.first.get() == entry->second;
+            });
+
+        if (job == queue.end())
+            continue;
+
+        job->second = [first = std::move(job->second), handler](
+            const code& ec) NOEXCEPT
+        {
+            first(ec);
+            handler(ec);
+        };
+
+        if (sampled())
+        {
+            LOGX("Merged " << heading::get_command(*payload) << " for ["
+                << authority() << "] (" << payload->size() << " bytes)");
+        }
+
+        return true;
+    }
+
+    pending_.emplace(key, payload.get());
+    return false;
+}
+
+void proxy::unmerge(const chunk_ptr& payload) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto range = pending_.equal_range(content_key(*payload));
+    for (auto entry = range.first; entry != range.second; ++entry)
+    {
+        if (entry->second == payload.get())
+        {
+            pending_.erase(entry);
+            return;
+        }
+    }
+}
+
+size_t proxy::queued() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    size_t count{};
+    for (const auto& queue: queues_)
+        count += queue.size();
+
+    return count;
+}
+
+// Queued payloads are gathered into a single write, up to configured limits,
+// taking lanes in priority order. The first payload is always sent, even if
+// it alone exceeds the byte limit. A payload over the slice size is written
+// alone in slices, so that the rate limit applies with slice granularity.
+// Payloads cannot interleave on the wire, so a higher priority message is
+// sent at the next message boundary (after the sliced payload) at the latest.
+// Lanes are taken below the given limit, so that bulk can be held back.
+size_t proxy::gather(asio::const_buffers& buffers, size_t limit) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    size_t bytes{};
+    const auto slice = write_slice();
+    const auto count = std::min(queued(), maximum_gather_count());
+    buffers.reserve(count);
+    writing_.fill(zero);
+
+    for (size_t lane{}; lane < limit; ++lane)
+    {
+        for (const auto& job: queues_.at(lane))
+        {
+            const auto size = job.first->size();
+            const auto sliced = !is_zero(slice) && size > slice;
+
+            // A file heading ends the gather, as its payload must follow it.
+            if (!is_zero(file_size(job.first)))
+            {
+                if (!buffers.empty())
+                    return bytes;
+
+                buffers.emplace_back(job.first->data(), size);
+                ++writing_.at(lane);
+                filing_ = job.first.get();
+                return size;
+            }
+
+            if (buffers.empty() && sliced)
+            {
+                slicing_ = true;
+                slice_lane_ = lane;
+                slice_offset_ = zero;
+                return zero;
+            }
+
+            if (!buffers.empty() && (buffers.size() == count || sliced ||
+                ceilinged_add(bytes, size) > maximum_gather_bytes()))
+                return bytes;
+
+            buffers.emplace_back(job.first->data(), size);
+            ++writing_.at(lane);
+            bytes += size;
+        }
+    }
+
+    return bytes;
+}
+
+void proxy::write() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (is_zero(queued()))
+        return;
+
+    size_t bytes{};
+    asio::const_buffers buffers{};
+
+    // Bulk sends over the process upload budget remain queued until it is
+    // replenished, while control and announcement lanes (and trusted
+    // channels) are exempt.
+    const auto deferred = !trusted() && uploads().deferred();
+
+    // A sliced payload is completed before any other is sent.
+    if (!slicing_)
+        bytes = gather(buffers, deferred ? bulk_lane : lanes);
+
+    // Nothing but (sliced) bulk remains, so wait for the budget.
+    if (deferred && (slicing_ ? slice_lane_ == bulk_lane : buffers.empty()))
+    {
+        LOGX("Upload deferred [" << authority() << "] ("
+            << backlog_.load() << " bytes)");
+
+        deferring_ = true;
+        wait(write_timer_, uploads().delay(),
+            std::bind(&proxy::handle_write_limited,
+                shared_from_this(), _1));
+        return;
+    }
+
+    if (slicing_)
+    {
+        const auto& payload = *queues_.at(slice_lane_).front().first;
+        bytes = std::min(write_slice(), payload.size() - slice_offset_);
+        buffers.emplace_back(std::next(payload.data(), slice_offset_), bytes);
+    }
+
+    // Writes over budget remain queued (backpressure) until replenished.
+    if (const auto delay = limited(writes_, bytes); delay != delay.zero())
+    {
+        LOGX("Write limited [" << authority() << "] ("
+            << bytes << " bytes)");
+
+        wait(write_timer_, delay,
+            std::bind(&proxy::handle_write_limited,
+                shared_from_this(), _1));
+        return;
+    }
+
+    // Written bytes (with any file payload) are accounted to the budget.
+    uploads().consume(is_null(filing_) ? bytes :
+        ceilinged_add(bytes, files_.at(filing_).size));
+
+    // Queued payloads remain valid until popped by handle_write.
+    count_write();
+    socket_->write(buffers,
+        std::bind(&proxy::handle_write,
+            shared_from_this(), _1, _2));
+}
+
+void proxy::handle_write(const code& ec, size_t bytes) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    USDT3(handle_write, trace_id(), bytes, ec.value());
+
+    if (stopped())
+    {
+        LOGQ("Send abort [" << authority() << "]");
+        stop(error::channel_stopped);
+        return;
+    }
+
+    // A written file heading is followed by its payload, then completed.
+    if (!is_null(filing_))
+    {
+        const auto heading = filing_;
+        filing_ = nullptr;
+
+        if (!ec)
+        {
+            count_write();
+            socket_->write(files_.at(heading),
+                std::bind(&proxy::handle_write_file,
+                    shared_from_this(), _1, _2, bytes));
+            return;
+        }
+    }
+
+    // A sliced payload completes upon its last slice (or any failure).
+    queue jobs{};
+    if (slicing_)
+    {
+        auto& lane = queues_.at(slice_lane_);
+        slice_offset_ += bytes;
+        if (ec || slice_offset_ >= lane.front().first->size())
+        {
+            jobs.push_back(std::move(lane.front()));
+            lane.pop_front();
+            if (slice_lane_ == announcement_lane && !pending_.empty())
+                unmerge(jobs.front().first);
+
+            slicing_ = false;
+            slice_offset_ = zero;
+        }
+    }
+    else
+    {
+        // guarded by write().
+        for (size_t lane{}; lane < lanes; ++lane)
+        {
+            auto& queue = queues_.at(lane);
+            const auto count = writing_.at(lane);
+            BC_ASSERT_MSG(count <= queue.size(), "write overflow");
+            const auto end = std::next(queue.begin(), count);
+            std::move(queue.begin(), end, std::back_inserter(jobs));
+            queue.erase(queue.begin(), end);
+
+            if (lane == announcement_lane && !pending_.empty())
+                for (auto job = std::prev(jobs.end(), count);
+                    job != jobs.end(); ++job)
+                    unmerge(job->first);
+        }
+
+        writing_.fill(zero);
+    }
+
+    for (const auto& job: jobs)
+    {
+        const auto size = job.first->size() + file_size(job.first);
+        backlog_ = floored_subtract(backlog_.load(), size);
+        memory_->release(size);
+        if (!files_.empty())
+            files_.erase(job.first.get());
+    }
+
+    if (sampled())
+    {
+        LOGX("Dequeue for [" << authority() << "]: " << queued()
+            << " (" << backlog_.load() << " bytes)");
+    }
+
+    // Draining to the low water mark clears congestion and the grace period.
+    if (congested_ && backlog_.load() <= send_low_water())
+    {
+        LOGX("Send decongested [" << authority() << "] ("
+            << backlog_.load() << " bytes)");
+
+        congested_ = false;
+        if (grace_timer_) grace_timer_->stop();
+        congestion_subscriber_.notify(error::success, false);
+    }
+
+    // All handlers must be invoked, so continue regardless of error state.
+    // Handlers are invoked in written order, after all outstanding complete.
+    write();
+
+    if (ec)
+    {
+        if (ec != error::peer_disconnect && ec != error::operation_canceled)
+        {
+            LOGF("Send failure of " << jobs.size() << " messages to ["
+                << authority() << "] " << ec.message());
+        }
+
+        stop(ec);
+    }
+
+    for (auto& job: jobs)
+    {
+        if (!ec && sampled())
+        {
+            LOGX("Sent " << heading::get_command(*job.first) << " to ["
+                << authority() << "] (" << job.first->size() << " bytes)");
+        }
+
+        job.second(ec);
+
+        // Unshared encodings return to the pool (shared are not pooled).
+        if (pool_sends())
+            pool_->release(std::move(job.first));
+    }
+}
+
+// The file payload write completes the job of its heading.
+void proxy::handle_write_file(const code& ec, size_t sent,
+    size_t bytes) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    handle_write(ec, ceilinged_add(bytes, sent));
+}
+
+void proxy::handle_congestion(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        LOGF("Send grace timer failure [" << authority() << "] "
+            << ec.message());
+        stop(ec);
+        return;
+    }
+
+    if (congested_)
+    {
+        LOGS("Send congestion exceeded grace [" << authority() << "] ("
+            << backlog_.load() << " bytes)");
+        stop(error::channel_congested);
+    }
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+void proxy::subscribe_congestion(
+    congestion_subscriber::handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    congestion_subscriber_.subscribe(std::move(handler));
+}
+
+bool proxy::congested() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return congested_;
+}
+
+asio::strand& proxy::strand() NOEXCEPT
+{
+    return socket_->strand();
+}
+
+bool proxy::stranded() const NOEXCEPT
+{
+    return socket_->stranded();
+}
+
+uint64_t proxy::backlog() const NOEXCEPT
+{
+    return backlog_.load(std::memory_order_relaxed);
+}
+
+uint64_t proxy::total() const NOEXCEPT
+{
+    return total_.load(std::memory_order_relaxed);
+}
+
+uint64_t proxy::received() const NOEXCEPT
+{
+    return received_.load(std::memory_order_relaxed);
+}
+
+uint64_t proxy::processing() const NOEXCEPT
+{
+    return traffic_.processing();
+}
+
+const metrics& proxy::traffic() const NOEXCEPT
+{
+    return traffic_;
+}
+
+size_t proxy::footprint::total() const NOEXCEPT
+{
+    return object + socket + buffers + queues + subscribers + timers +
+        protocols + filters;
+}
+
+// Hash table nodes are estimated as the value and two pointers.
+proxy::footprint proxy::memory() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    constexpr auto node = two * sizeof(void*);
+    const auto timer = [](const deadline::ptr& value) NOEXCEPT
+    {
+        return value ? sizeof(deadline) : zero;
+    };
+
+    footprint out{};
+    out.object = sizeof(proxy);
+    out.socket = sizeof(network::socket);
+    out.buffers = ahead_.capacity() +
+        (payload_buffer_ ? payload_buffer_->capacity() : zero) +
+        (block_stream_ ? sizeof(block_stream) : zero);
+
+    for (const auto& lane: queues_)
+    {
+        out.queues += lane.size() * sizeof(queue::value_type);
+        for (const auto& job: lane)
+            out.queues += job.first->capacity();
+    }
+
+    out.queues +=
+        pending_.size() * (sizeof(decltype(pending_)::value_type) + node) +
+        files_.size() * (sizeof(decltype(files_)::value_type) + node);
+
+    out.subscribers = distributor_.memory() + sizeof(result_handler) *
+        (stop_subscriber_.size() + congestion_subscriber_.size());
+
+    out.timers = timer(idle_timer_) + timer(grace_timer_) +
+        timer(read_timer_) + timer(write_timer_);
+
+    return out;
+}
+
+// Sampled per-message tracing, counted over sends and receives (strand).
+bool proxy::sampled() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if constexpr (levels::proxy_defined)
+    {
+        const auto rate = trace_sample();
+        return !is_zero(rate) && is_zero(samples_++ % rate);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void proxy::count_read() NOEXCEPT
+{
+    traffic_.read();
+    aggregate().read();
+}
+
+void proxy::count_write() NOEXCEPT
+{
+    traffic_.write();
+    aggregate().write();
 }
 
 bool proxy::inbound() const NOEXCEPT
@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/replay.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/net/capture.hpp>
+#include <bitcoin/network/net/deadline.hpp>
+#include <bitcoin/network/net/socket.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+using namespace system;
+using namespace std::placeholders;
+
+replay::replay(const logger& log, const socket::ptr& socket,
+    const std::filesystem::path& file, bool paced) NOEXCEPT
+  : socket_(socket),
+    file_(file),
+    paced_(paced),
+    timer_(std::make_shared<deadline>(log, socket->strand())),
+    reporter(log),
+    tracker<replay>(log)
+{
+}
+
+replay::~replay() NOEXCEPT
+{
+    BC_ASSERT_MSG(!handler_, "replay is not stopped");
+    if (handler_) { LOGF("~replay is not stopped."); }
+}
+
+bool replay::stranded() const NOEXCEPT
+{
+    return socket_->stranded();
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+void replay::start(count_handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped_ || handler_)
+    {
+        handler(error::operation_failed, zero);
+        return;
+    }
+
+    try
+    {
+        stream_.open(file_, ifstream::in | ifstream::binary);
+    }
+    catch (const std::exception&)
+    {
+        handler(error::file_exception, zero);
+        return;
+    }
+
+    if (!stream_.good() || !capture::read_magic(stream_))
+    {
+        handler(error::file_load, zero);
+        return;
+    }
+
+    handler_ = std::move(handler);
+    start_ = steady_clock::now();
+    count_ = zero;
+    next();
+}
+
+void replay::stop() NOEXCEPT
+{
+    boost::asio::post(socket_->strand(),
+        std::bind(&replay::do_stop, shared_from_this()));
+}
+
+void replay::do_stop() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // A pending wait or write completes the replay as canceled.
+    stopped_ = true;
+    timer_->stop();
+    finish(error::operation_canceled);
+}
+
+// Replay.
+// ----------------------------------------------------------------------------
+
+void replay::next() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!capture::read(stream_, record_))
+    {
+        finish(stream_.eof() ? error::success : error::file_load);
+        return;
+    }
+
+    // A paced message is held until its recorded offset from the start.
+    if (paced_)
+    {
+        const auto due = start_ + microseconds{ record_.microseconds };
+        const auto now = steady_clock::now();
+        if (due > now)
+        {
+            timer_->start(std::bind(&replay::handle_timer,
+                shared_from_this(), _1), due - now);
+            return;
+        }
+    }
+
+    handle_timer(error::success);
+}
+
+void replay::handle_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped_ || ec)
+    {
+        finish(ec);
+        return;
+    }
+
+    // The record remains unchanged until the write completes.
+    socket_->write(record_.message,
+        std::bind(&replay::handle_write,
+            shared_from_this(), _1, _2));
+}
+
+void replay::handle_write(const code& ec, size_t) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped_ || ec)
+    {
+        finish(ec);
+        return;
+    }
+
+    ++count_;
+    next();
+}
+
+void replay::finish(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!handler_)
+        return;
+
+    stream_.close();
+    const auto handler = std::move(handler_);
+    handler_ = {};
+    handler(ec, count_);
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/resources.hpp>
+
+#include <algorithm>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+// BIP152: high bandwidth relay should be requested of at most three peers.
+constexpr size_t maximum_high_bandwidth = 3;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Megabyte configurations, zero limits and capacities disable each.
+resources::resources(const settings& settings) NOEXCEPT
+  : payload_buffers_(settings.payload_pool_capacity, settings.minimum_buffer,
+        settings.payload_huge_pages),
+    deserializers_(std::max(one, size_t{ settings.deserialize_threads }),
+        thread_priority::low, settings.deserialize_processors),
+    timers_(seconds(1)),
+    checksums_(microseconds(settings.checksum_batch_microseconds)),
+    resolutions_(settings.resolve_threads, settings.resolve_cache(),
+        settings.resolve_negative()),
+    memory_(ceilinged_multiply(size_t{ settings.memory_budget_megabytes },
+        size_t{ 1'000'000 })),
+    uploads_(settings.upload_limit, ceilinged_multiply(
+        size_t{ settings.upload_target_megabytes }, size_t{ 1'000'000 })),
+    seen_(settings.seen_capacity),
+    served_(ceilinged_multiply(size_t{ settings.serve_cache_megabytes },
+        size_t{ 1'000'000 })),
+    exporter_(settings.export_name, ceilinged_multiply(
+        size_t{ settings.export_megabytes }, size_t{ 1'000'000 })),
+    blocked_(settings.blocklist_path, thread_ceiling(settings.compute_threads))
+{
+}
+
+BC_POP_WARNING()
+
+void resources::stop() NOEXCEPT
+{
+    deserializers_.stop();
+}
+
+bool resources::join() NOEXCEPT
+{
+    return deserializers_.join();
+}
+
+payload_pool& resources::payload_buffers() NOEXCEPT
+{
+    return payload_buffers_;
+}
+
+threadpool& resources::deserializers() NOEXCEPT
+{
+    return deserializers_;
+}
+
+timer_wheel& resources::timers() NOEXCEPT
+{
+    return timers_;
+}
+
+checksum_batcher& resources::checksums() NOEXCEPT
+{
+    return checksums_;
+}
+
+name_resolver& resources::resolutions() NOEXCEPT
+{
+    return resolutions_;
+}
+
+version_template& resources::versions() NOEXCEPT
+{
+    return versions_;
+}
+
+metrics& resources::traffic() NOEXCEPT
+{
+    return traffic_;
+}
+
+const metrics& resources::traffic() const NOEXCEPT
+{
+    return traffic_;
+}
+
+memory_budget& resources::memory() NOEXCEPT
+{
+    return memory_;
+}
+
+const memory_budget& resources::memory() const NOEXCEPT
+{
+    return memory_;
+}
+
+timeout_estimator& resources::connects() NOEXCEPT
+{
+    return connects_;
+}
+
+timeout_estimator& resources::handshakes() NOEXCEPT
+{
+    return handshakes_;
+}
+
+upload_budget& resources::uploads() NOEXCEPT
+{
+    return uploads_;
+}
+
+seen_filter& resources::seen() NOEXCEPT
+{
+    return seen_;
+}
+
+serve_cache& resources::served() NOEXCEPT
+{
+    return served_;
+}
+
+message_exporter& resources::exporter() NOEXCEPT
+{
+    return exporter_;
+}
+
+blocklist& resources::blocked() NOEXCEPT
+{
+    return blocked_;
+}
+
+bool resources::take_high_bandwidth() NOEXCEPT
+{
+    auto count = high_bandwidth_.load();
+    while (count < maximum_high_bandwidth)
+        if (high_bandwidth_.compare_exchange_weak(count, add1(count)))
+            return true;
+
+    return false;
+}
+
+void resources::release_high_bandwidth() NOEXCEPT
+{
+    BC_ASSERT_MSG(!is_zero(high_bandwidth_.load()), "unbalanced release");
+    high_bandwidth_.fetch_sub(one);
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/rolling_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+constexpr size_t word_bits = to_bits(sizeof(uint64_t));
+constexpr size_t maximum_hashes = 32;
+
+// Optimal bits per generation: -n * ln(p) / ln(2)^2, rounded to words.
+static size_t to_words(size_t entries, double false_positive) NOEXCEPT
+{
+    if (is_zero(entries))
+        return zero;
+
+    const auto rate = std::clamp(false_positive, 1e-12, 0.5);
+    const auto bits = std::ceil(-static_cast<double>(entries) *
+        std::log(rate) / (std::log(2.0) * std::log(2.0)));
+    return ceilinged_divide(static_cast<size_t>(bits), word_bits);
+}
+
+// Optimal hash count: bits / n * ln(2).
+static size_t to_hashes(size_t entries, size_t words) NOEXCEPT
+{
+    if (is_zero(entries))
+        return zero;
+
+    const auto bits = static_cast<double>(words * word_bits);
+    const auto count = std::max(std::lround(bits / entries * std::log(2.0)),
+        1L);
+    return std::min(static_cast<size_t>(count), maximum_hashes);
+}
+
+// Little-endian word of the hash at the byte offset.
+static uint64_t to_word(const hash_digest& hash, size_t offset) NOEXCEPT
+{
+    uint64_t value{};
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        value |= uint64_t{ hash.at(offset + byte) } << to_bits(byte);
+
+    return value;
+}
+
+rolling_filter::rolling_filter(size_t capacity, double false_positive) NOEXCEPT
+  : generation_(ceilinged_divide(capacity, two)),
+    words_(to_words(generation_, false_positive)),
+    hashes_(to_hashes(generation_, words_)),
+    tweak_(pseudo_random::next<uint64_t>(zero, max_uint64)),
+    bits_(two * words_, 0)
+{
+}
+
+void rolling_filter::insert(const hash_digest& hash) NOEXCEPT
+{
+    if (is_zero(words_) || contains(hash))
+        return;
+
+    // Retire the older generation, which becomes current (empty).
+    if (count_ == generation_)
+    {
+        current_ = is_zero(current_) ? one : zero;
+        const auto begin = std::next(bits_.begin(), current_ * words_);
+        std::fill(begin, std::next(begin, words_), 0);
+        count_ = zero;
+    }
+
+    // Double hashing of the salted hash yields each bit position.
+    const auto first = to_word(hash, 0) ^ tweak_;
+    const auto second = (to_word(hash, 8) ^ (tweak_ >> 1)) | 1;
+    const auto size = words_ * word_bits;
+    for (size_t index = 0; index < hashes_; ++index)
+    {
+        const auto bit = (first + index * second) % size;
+        bits_.at(current_ * words_ + bit / word_bits) |=
+            (uint64_t{ 1 } << (bit % word_bits));
+    }
+
+    ++count_;
+}
+
+bool rolling_filter::contains(const hash_digest& hash) const NOEXCEPT
+{
+    if (is_zero(words_))
+        return false;
+
+    const auto first = to_word(hash, 0) ^ tweak_;
+    const auto second = (to_word(hash, 8) ^ (tweak_ >> 1)) | 1;
+    return contains(zero, first, second) || contains(one, first, second);
+}
+
+void rolling_filter::clear() NOEXCEPT
+{
+    std::fill(bits_.begin(), bits_.end(), 0);
+    current_ = zero;
+    count_ = zero;
+}
+
+size_t rolling_filter::bytes() const NOEXCEPT
+{
+    return bits_.capacity() * sizeof(bits::value_type);
+}
+
+// private
+bool rolling_filter::contains(size_t generation, uint64_t first,
+    uint64_t second) const NOEXCEPT
+{
+    const auto size = words_ * word_bits;
+    for (size_t index = 0; index < hashes_; ++index)
+    {
+        const auto bit = (first + index * second) % size;
+        if (is_zero(bits_.at(generation * words_ + bit / word_bits) &
+            (uint64_t{ 1 } << (bit % word_bits))))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace network
+} // namespace libbitcoin
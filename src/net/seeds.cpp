@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/seeds.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/settings.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Each line is: seed authority timestamp yield successes failures.
+// An unresolved authority is serialized as the default (unspecified) value.
+
+seeds::seeds(const settings& settings) NOEXCEPT
+  : settings_(settings),
+    retained_(settings.retain())
+{
+}
+
+// File.
+// ----------------------------------------------------------------------------
+
+code seeds::load() NOEXCEPT
+{
+    if (!enabled())
+        return error::success;
+
+    try
+    {
+        ifstream file{ settings_.seeds_file(), ifstream::in };
+        if (!file.good())
+            return error::success;
+
+        for (std::string line{}; std::getline(file, line);)
+        {
+            std::istringstream text{ line };
+            record item{};
+            text >> item.seed >> item.authority >> item.timestamp
+                >> item.yield >> item.successes >> item.failures;
+
+            if (text.fail())
+                return error::file_load;
+
+            // Configured seeds are assumed to be distinct.
+            if (contains(settings_.seeds, item.seed))
+                find(item.seed) = item;
+        }
+
+        if (file.bad())
+            return error::file_load;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+code seeds::save() const NOEXCEPT
+{
+    if (!enabled())
+        return error::success;
+
+    if (records_.empty())
+    {
+        code ec;
+        std::filesystem::remove(settings_.seeds_file(), ec);
+        return ec ? error::file_save : error::success;
+    }
+
+    try
+    {
+        ofstream file{ settings_.seeds_file(), ofstream::out };
+        if (!file.good())
+            return error::file_save;
+
+        for (const auto& item: records_)
+            file << item.seed << " " << item.authority << " "
+                << item.timestamp << " " << item.yield << " "
+                << item.successes << " " << item.failures << std::endl;
+
+        if (!file.good())
+            return error::file_save;
+    }
+    catch (const std::exception&)
+    {
+        return error::file_exception;
+    }
+
+    return error::success;
+}
+
+// Usage.
+// ----------------------------------------------------------------------------
+
+config::endpoints seeds::order() const NOEXCEPT
+{
+    config::endpoints out{};
+    out.reserve(settings_.seeds.size());
+
+    for (const auto& seed: settings_.seeds)
+        if (!skipped(get(seed)))
+            out.push_back(seed);
+
+    // Never skip all seeds, as the pool is insufficient.
+    if (out.empty())
+        out = settings_.seeds;
+
+    // Stable, so configured order is retained among equal (or no) yield.
+    std::stable_sort(out.begin(), out.end(),
+        [this](const config::endpoint& left, const config::endpoint& right)
+        {
+            return get(left).yield > get(right).yield;
+        });
+
+    return out;
+}
+
+config::endpoint seeds::target(const config::endpoint& seed) const NOEXCEPT
+{
+    const auto item = get(seed);
+    return item.authority && fresh(item) ? config::endpoint{ item.authority } :
+        seed;
+}
+
+seeds::record seeds::get(const config::endpoint& seed) const NOEXCEPT
+{
+    const auto it = std::find_if(records_.begin(), records_.end(),
+        [&](const record& item) { return item.seed == seed; });
+
+    return it == records_.end() ? record{ seed } : *it;
+}
+
+void seeds::connected(const config::endpoint& seed,
+    const config::authority& authority) NOEXCEPT
+{
+    auto& item = find(seed);
+    item.authority = authority;
+    item.timestamp = unix_time();
+    item.successes = ceilinged_add(item.successes, 1_u32);
+    item.failures = 0;
+}
+
+void seeds::failed(const config::endpoint& seed) NOEXCEPT
+{
+    auto& item = find(seed);
+    item.authority = {};
+    item.timestamp = unix_time();
+    item.failures = ceilinged_add(item.failures, 1_u32);
+}
+
+void seeds::yielded(const config::endpoint& seed, size_t count) NOEXCEPT
+{
+    find(seed).yield = limit<uint32_t>(count);
+}
+
+// protected
+// ----------------------------------------------------------------------------
+
+bool seeds::enabled() const NOEXCEPT
+{
+    return !is_zero(settings_.seed_cache_minutes);
+}
+
+bool seeds::fresh(const record& item) const NOEXCEPT
+{
+    const auto age = floored_subtract(unix_time(), item.timestamp);
+    return !is_zero(item.timestamp) &&
+        age < settings_.seed_cache_minutes * 60_u64;
+}
+
+bool seeds::skipped(const record& item) const NOEXCEPT
+{
+    return !is_zero(item.failures) && is_zero(item.yield) && fresh(item);
+}
+
+seeds::record& seeds::find(const config::endpoint& seed) NOEXCEPT
+{
+    const auto it = std::find_if(records_.begin(), records_.end(),
+        [&](const record& item) { return item.seed == seed; });
+
+    if (it != records_.end())
+        return *it;
+
+    records_.push_back({ seed });
+    return records_.back();
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/serve_cache.hpp>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+serve_cache::serve_cache(size_t capacity) NOEXCEPT
+  : capacity_(capacity)
+{
+}
+
+std::optional<hash_digest> serve_cache::identity(
+    const messages::block& message) NOEXCEPT
+{
+    if (!message.block_ptr)
+        return {};
+
+    return message.block_ptr->hash();
+}
+
+std::optional<hash_digest> serve_cache::identity(
+    const messages::transaction& message) NOEXCEPT
+{
+    if (!message.transaction_ptr)
+        return {};
+
+    return message.transaction_ptr->hash(false);
+}
+
+// The found entry is moved to the front (most recent).
+chunk_ptr serve_cache::find(const key& value) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    const auto it = index_.find(value);
+    if (it == index_.end())
+        return {};
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return entries_.front().second;
+}
+
+// An encoding larger than capacity is returned but not cached, the least
+// recent entries are evicted until the encoding fits.
+chunk_ptr serve_cache::store(const key& value, const chunk_ptr& data) NOEXCEPT
+{
+    if (!data || data->size() > capacity_)
+        return data;
+
+    std::lock_guard lock(mutex_);
+
+    // Another channel may have stored the same encoding concurrently.
+    const auto it = index_.find(value);
+    if (it != index_.end())
+    {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return entries_.front().second;
+    }
+
+    while (!entries_.empty() && bytes_ + data->size() > capacity_)
+    {
+        bytes_ -= entries_.back().second->size();
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+
+    bytes_ += data->size();
+    entries_.emplace_front(value, data);
+    index_.emplace(value, entries_.begin());
+    return data;
+}
+
+size_t serve_cache::size() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+size_t serve_cache::bytes() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/short_id_table.hpp>
+
+#include <bit>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+// At least twice capacity, and a power of two (for masking).
+static size_t to_slots(size_t capacity) NOEXCEPT
+{
+    return std::bit_ceil(std::max(two, capacity * two));
+}
+
+short_id_table::short_id_table(size_t capacity) NOEXCEPT
+  : entries_(to_slots(capacity), entry{ empty, zero }),
+    mask_(sub1(entries_.size()))
+{
+}
+
+bool short_id_table::insert(uint64_t id, size_t value) NOEXCEPT
+{
+    BC_ASSERT_MSG(id != empty, "invalid short id");
+    BC_ASSERT_MSG(size_ < mask_, "short id table full");
+
+    for (auto slot = index(id);; slot = (add1(slot) & mask_))
+    {
+        auto& item = entries_[slot];
+        if (item.id == id)
+            return false;
+
+        if (item.id == empty)
+        {
+            item = { id, value };
+            ++size_;
+            return true;
+        }
+    }
+}
+
+size_t* short_id_table::find(uint64_t id) NOEXCEPT
+{
+    for (auto slot = index(id);; slot = (add1(slot) & mask_))
+    {
+        auto& item = entries_[slot];
+        if (item.id == id)
+            return &item.value;
+
+        if (item.id == empty)
+            return nullptr;
+    }
+}
+
+size_t short_id_table::size() const NOEXCEPT
+{
+    return size_;
+}
+
+// private
+size_t short_id_table::index(uint64_t id) const NOEXCEPT
+{
+    return static_cast<size_t>(id) & mask_;
+}
+
+} // namespace network
+} // namespace libbitcoin
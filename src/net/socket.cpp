@@ -27,6 +27,17 @@
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
 
+#ifdef HAVE_LINUX
+    #include <cerrno>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/sendfile.h>
+    #include <sys/socket.h>
+    #define LINUX_ONLY(name) name
+#else
+    #define LINUX_ONLY(name)
+#endif
+
 namespace libbitcoin {
 namespace network {
 
@@ -59,6 +70,33 @@ socket::socket(const logger& log, asio::io_context& service,
 {
 }
 
+// Release/assign rebinds the connection to the strand executor, as a moved
+// socket retains the executor of the service upon which it was accepted.
+socket::socket(const logger& log, asio::io_context& service,
+    asio::socket&& connection) NOEXCEPT
+  : socket(log, service)
+{
+    error::boost_code ec;
+    const auto remote = connection.remote_endpoint(ec);
+
+    if (!ec)
+    {
+        const auto handle = connection.release(ec);
+        if (!ec)
+            socket_.assign(remote.protocol(), handle, ec);
+    }
+
+    if (ec)
+    {
+        error::boost_code ignore;
+        connection.close(ignore);
+        stopped_.store(true);
+        return;
+    }
+
+    authority_ = { remote };
+}
+
 socket::~socket() NOEXCEPT
 {
     BC_ASSERT_MSG(stopped(), "socket is not stopped");
@@ -138,23 +176,138 @@ void socket::connect(const asio::endpoints& range,
             shared_from_this(), range, std::move(handler)));
 }
 
+void socket::connect(const asio::endpoint& point, bool fast_open,
+    result_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(strand_,
+        std::bind(&socket::do_connect_endpoint,
+            shared_from_this(), point, fast_open, std::move(handler)));
+}
+
 // Read into pre-allocated buffer (bitcoin).
+// Operations requested on the strand (the channel read and write loops) are
+// started in place, avoiding the socket reference bound for the dispatch.
 void socket::read(const data_slab& out, count_handler&& handler) NOEXCEPT
 {
     // asio::mutable_buffer is essentially a data_slab.
+    const asio::mutable_buffer buffer{ out.data(), out.size() };
+
+    if (stranded())
+    {
+        do_read(buffer, handler);
+        return;
+    }
+
+    boost::asio::dispatch(strand_,
+        std::bind(&socket::do_read, shared_from_this(), buffer,
+            std::move(handler)));
+}
+
+void socket::read_some(const data_slab& out, count_handler&& handler) NOEXCEPT
+{
+    const asio::mutable_buffer buffer{ out.data(), out.size() };
+
+    if (stranded())
+    {
+        do_read_some(buffer, handler);
+        return;
+    }
+
     boost::asio::dispatch(strand_,
-        std::bind(&socket::do_read, shared_from_this(),
-            asio::mutable_buffer{ out.data(), out.size() },
-                std::move(handler)));
+        std::bind(&socket::do_read_some, shared_from_this(), buffer,
+            std::move(handler)));
 }
 
 void socket::write(const data_slice& in, count_handler&& handler) NOEXCEPT
 {
     // asio::const_buffer is essentially a data_slice.
+    const asio::const_buffer buffer{ in.data(), in.size() };
+
+    if (stranded())
+    {
+        do_write(buffer, handler);
+        return;
+    }
+
+    boost::asio::dispatch(strand_,
+        std::bind(&socket::do_write, shared_from_this(), buffer,
+            std::move(handler)));
+}
+
+void socket::write(const asio::const_buffers& in,
+    count_handler&& handler) NOEXCEPT
+{
+    if (stranded())
+    {
+        do_write_buffers(in, handler);
+        return;
+    }
+
     boost::asio::dispatch(strand_,
-        std::bind(&socket::do_write, shared_from_this(),
-            asio::const_buffer{ in.data(), in.size() },
-                std::move(handler)));
+        std::bind(&socket::do_write_buffers, shared_from_this(),
+            in, std::move(handler)));
+}
+
+void socket::write(const file_region& in, count_handler&& handler) NOEXCEPT
+{
+    if (stranded())
+    {
+        do_write_file(in, zero, handler);
+        return;
+    }
+
+    boost::asio::dispatch(strand_,
+        std::bind(&socket::do_write_file, shared_from_this(), in, zero,
+            std::move(handler)));
+}
+
+// Options.
+// ----------------------------------------------------------------------------
+
+void socket::set_options(const options& value) NOEXCEPT
+{
+    using base = boost::asio::socket_base;
+    error::boost_code ignore;
+
+    socket_.set_option(asio::tcp::no_delay(value.no_delay), ignore);
+
+    if (!is_zero(value.send_buffer))
+        socket_.set_option(base::send_buffer_size(
+            possible_narrow_sign_cast<int>(value.send_buffer)), ignore);
+
+    if (!is_zero(value.receive_buffer))
+        socket_.set_option(base::receive_buffer_size(
+            possible_narrow_sign_cast<int>(value.receive_buffer)), ignore);
+
+    if (!is_zero(value.keep_alive))
+    {
+        socket_.set_option(base::keep_alive(true), ignore);
+
+#ifdef HAVE_LINUX
+        using idle = boost::asio::detail::socket_option::integer<IPPROTO_TCP,
+            TCP_KEEPIDLE>;
+        socket_.set_option(idle(possible_narrow_sign_cast<int>(
+            value.keep_alive)), ignore);
+#endif
+    }
+
+#ifdef HAVE_LINUX
+    if (!is_zero(value.not_sent_low_water))
+    {
+        using low_water = boost::asio::detail::socket_option::integer<
+            IPPROTO_TCP, TCP_NOTSENT_LOWAT>;
+        socket_.set_option(low_water(possible_narrow_sign_cast<int>(
+            value.not_sent_low_water)), ignore);
+    }
+
+    if (!is_zero(value.busy_poll))
+    {
+        using busy_poll = boost::asio::detail::socket_option::integer<
+            SOL_SOCKET, SO_BUSY_POLL>;
+        socket_.set_option(busy_poll(possible_narrow_sign_cast<int>(
+            value.busy_poll)), ignore);
+    }
+#endif
 }
 
 // executors (private).
@@ -181,6 +334,44 @@ void socket::do_connect(const asio::endpoints& range,
     }
 }
 
+void socket::do_connect_endpoint(const asio::endpoint& point,
+    bool LINUX_ONLY(fast_open), const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    BC_ASSERT_MSG(!socket_.is_open(), "connect on open socket");
+
+    // The socket is opened here (vs. by async_connect) to allow options.
+    error::boost_code ec;
+    socket_.open(point.protocol(), ec);
+    if (ec)
+    {
+        handle_connect(ec, point, handler);
+        return;
+    }
+
+#if defined(HAVE_LINUX) && defined(TCP_FASTOPEN_CONNECT)
+    if (fast_open)
+    {
+        using fast_connect = boost::asio::detail::socket_option::integer<
+            IPPROTO_TCP, TCP_FASTOPEN_CONNECT>;
+        error::boost_code ignore;
+        socket_.set_option(fast_connect(1), ignore);
+    }
+#endif
+
+    try
+    {
+        socket_.async_connect(point,
+            std::bind(&socket::handle_connect,
+                shared_from_this(), _1, point, handler));
+    }
+    catch (const std::exception& LOG_ONLY(e))
+    {
+        LOGF("Exception @ do_connect_endpoint: " << e.what());
+        handler(error::connect_failed);
+    }
+}
+
 // Read into pre-allocated buffer (bitcoin).
 void socket::do_read(const asio::mutable_buffer& out,
     const count_handler& handler) NOEXCEPT
@@ -190,9 +381,9 @@ void socket::do_read(const asio::mutable_buffer& out,
     try
     {
         // This composed operation posts all intermediate handlers to the strand.
-        boost::asio::async_read(socket_, out,
+        boost::asio::async_read(socket_, out, make_allocated(read_memory_,
             std::bind(&socket::handle_io,
-                shared_from_this(), _1, _2, handler));
+                shared_from_this(), _1, _2, handler)));
     }
     catch (const std::exception& LOG_ONLY(e))
     {
@@ -201,6 +392,24 @@ void socket::do_read(const asio::mutable_buffer& out,
     }
 }
 
+void socket::do_read_some(const asio::mutable_buffer& out,
+    const count_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    try
+    {
+        socket_.async_read_some(out, make_allocated(read_memory_,
+            std::bind(&socket::handle_io,
+                shared_from_this(), _1, _2, handler)));
+    }
+    catch (const std::exception& LOG_ONLY(e))
+    {
+        LOGF("Exception @ do_read_some: " << e.what());
+        handler(error::operation_failed, zero);
+    }
+}
+
 void socket::do_write(const asio::const_buffer& in,
     const count_handler& handler) NOEXCEPT
 {
@@ -209,9 +418,9 @@ void socket::do_write(const asio::const_buffer& in,
     try
     {
         // This composed operation posts all intermediate handlers to the strand.
-        boost::asio::async_write(socket_, in,
+        boost::asio::async_write(socket_, in, make_allocated(write_memory_,
             std::bind(&socket::handle_io,
-                shared_from_this(), _1, _2, handler));
+                shared_from_this(), _1, _2, handler)));
     }
     catch (const std::exception& LOG_ONLY(e))
     {
@@ -220,6 +429,70 @@ void socket::do_write(const asio::const_buffer& in,
     }
 }
 
+void socket::do_write_buffers(const asio::const_buffers& in,
+    const count_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    try
+    {
+        // The composed operation retains its own copy of the buffer sequence.
+        boost::asio::async_write(socket_, in, make_allocated(write_memory_,
+            std::bind(&socket::handle_io,
+                shared_from_this(), _1, _2, handler)));
+    }
+    catch (const std::exception& LOG_ONLY(e))
+    {
+        LOGF("Exception @ do_write_buffers: " << e.what());
+        handler(error::operation_failed, zero);
+    }
+}
+
+// The kernel copies from the page cache to the socket, writing until the
+// socket buffer is full and then awaiting writability (reactor) to continue.
+void socket::do_write_file(const file_region& in, size_t sent,
+    const count_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+#ifdef HAVE_LINUX
+    error::boost_code ec{};
+    socket_.native_non_blocking(true, ec);
+
+    while (!ec && sent < in.size)
+    {
+        auto offset = possible_narrow_sign_cast<off_t>(in.offset + sent);
+        const auto result = ::sendfile(socket_.native_handle(), in.descriptor,
+            &offset, in.size - sent);
+
+        if (result > 0)
+        {
+            sent += possible_narrow_sign_cast<size_t>(result);
+        }
+        else if (is_zero(result))
+        {
+            // The file ends within the region.
+            ec = boost::asio::error::eof;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            socket_.async_wait(asio::socket::wait_write,
+                std::bind(&socket::handle_write_file,
+                    shared_from_this(), _1, in, sent, handler));
+            return;
+        }
+        else if (errno != EINTR)
+        {
+            ec = { errno, boost::system::system_category() };
+        }
+    }
+
+    handle_io(ec, sent, handler);
+#else
+    handler(error::operation_failed, sent);
+#endif
+}
+
 // handlers (private).
 // ----------------------------------------------------------------------------
 // These are invoked on strand upon failure, socket cancel, or completion.
@@ -275,6 +548,20 @@ void socket::handle_connect(const error::boost_code& ec,
     handler(code);
 }
 
+void socket::handle_write_file(const error::boost_code& ec,
+    const file_region& in, size_t sent, const count_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (ec)
+    {
+        handle_io(ec, sent, handler);
+        return;
+    }
+
+    do_write_file(in, sent, handler);
+}
+
 void socket::handle_io(const error::boost_code& ec, size_t size,
     const count_handler& handler) NOEXCEPT
 {
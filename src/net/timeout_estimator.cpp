@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/timeout_estimator.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+constexpr size_t minimum_samples = 16;
+constexpr size_t percentile = 95;
+constexpr size_t margin = 2;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+timeout_estimator::timeout_estimator(size_t window) NOEXCEPT
+  : window_(std::max(window, one))
+{
+    samples_.reserve(window_);
+}
+
+void timeout_estimator::sample(const duration& value) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    // Samples are retained in a ring, the oldest overwritten first.
+    if (samples_.size() < window_)
+    {
+        samples_.push_back(value.count());
+        return;
+    }
+
+    samples_.at(next_) = value.count();
+    next_ = add1(next_) % window_;
+}
+
+size_t timeout_estimator::count() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return samples_.size();
+}
+
+timeout_estimator::duration timeout_estimator::estimate(
+    const duration& minimum, const duration& maximum) const NOEXCEPT
+{
+    std::vector<duration::rep> sorted{};
+    {
+        std::unique_lock lock(mutex_);
+        if (samples_.size() < minimum_samples)
+            return maximum;
+
+        sorted = samples_;
+    }
+
+    const auto index = (sorted.size() * percentile) / 100u;
+    const auto nth = std::next(sorted.begin(), std::min(index,
+        sub1(sorted.size())));
+    std::nth_element(sorted.begin(), nth, sorted.end());
+
+    return std::clamp(duration{ *nth * margin }, minimum,
+        std::max(minimum, maximum));
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/timer_wheel.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+timer_wheel::timer_wheel(const duration& resolution, size_t slots) NOEXCEPT
+  : resolution_(std::max(resolution, duration{ 1 })),
+    slots_(std::max(one, slots)),
+    timer_(pool_.service())
+{
+}
+
+timer_wheel::~timer_wheel() NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        stopped_ = true;
+    }
+
+    boost::asio::post(pool_.service(), [this]() NOEXCEPT
+    {
+        timer_.cancel();
+    });
+
+    pool_.stop();
+    pool_.join();
+}
+
+const timer_wheel::duration& timer_wheel::resolution() const NOEXCEPT
+{
+    return resolution_;
+}
+
+size_t timer_wheel::size() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return entries_.size();
+}
+
+void timer_wheel::start(key& id, asio::strand& strand,
+    result_handler&& handler, const duration& timeout) NOEXCEPT
+{
+    result_handler canceled{};
+    asio::strand* canceled_strand{};
+    auto arming = false;
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (stopped_)
+            return;
+
+        // A running tick may be imminent, so count it as no progress.
+        const auto span = std::max(timeout, duration::zero());
+        const auto count = ceilinged_divide(
+            possible_narrow_sign_cast<size_t>(span.count()),
+            possible_narrow_sign_cast<size_t>(resolution_.count()));
+        const auto ticks = std::max(one, ticking_ ? add1(count) : count);
+        const auto index = (cursor_ + ticks) % slots_.size();
+        const auto rounds = sub1(ticks) / slots_.size();
+
+        if (const auto it = entries_.find(id); it != entries_.end())
+        {
+            auto& item = it->second;
+            canceled = std::move(item.handler);
+            canceled_strand = item.strand;
+
+            // Splice relinks the node, so the position remains valid.
+            slots_[index].splice(slots_[index].end(), slots_[item.slot],
+                item.position);
+
+            item.strand = &strand;
+            item.handler = std::move(handler);
+            item.slot = index;
+            item.rounds = rounds;
+        }
+        else
+        {
+            id = ++next_;
+            auto& list = slots_[index];
+            list.push_back(id);
+            entries_.emplace(id, entry{ &strand, std::move(handler), index,
+                rounds, std::prev(list.end()) });
+        }
+
+        if (!ticking_)
+            ticking_ = arming = true;
+    }
+
+    if (canceled)
+        post(*canceled_strand, std::move(canceled),
+            error::operation_canceled);
+
+    if (arming)
+        boost::asio::post(pool_.service(),
+            std::bind(&timer_wheel::arm, this));
+}
+
+void timer_wheel::stop(key id) NOEXCEPT
+{
+    result_handler canceled{};
+    asio::strand* canceled_strand{};
+
+    {
+        std::unique_lock lock(mutex_);
+        const auto it = entries_.find(id);
+        if (it == entries_.end())
+            return;
+
+        auto& item = it->second;
+        canceled = std::move(item.handler);
+        canceled_strand = item.strand;
+        slots_[item.slot].erase(item.position);
+        entries_.erase(it);
+    }
+
+    post(*canceled_strand, std::move(canceled), error::operation_canceled);
+}
+
+// private
+void timer_wheel::post(asio::strand& strand, result_handler&& handler,
+    const code& ec) NOEXCEPT
+{
+    boost::asio::post(strand,
+        [handler = std::move(handler), ec]() NOEXCEPT
+        {
+            handler(ec);
+        });
+}
+
+// Called on the wheel thread only.
+void timer_wheel::arm() NOEXCEPT
+{
+    timer_.expires_after(resolution_);
+    timer_.async_wait(std::bind(&timer_wheel::handle_tick, this, _1));
+}
+
+// Called on the wheel thread only.
+void timer_wheel::handle_tick(const error::boost_code& ec) NOEXCEPT
+{
+    std::vector<std::pair<asio::strand*, result_handler>> expired{};
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (stopped_ || ec)
+        {
+            ticking_ = false;
+            return;
+        }
+
+        cursor_ = add1(cursor_) % slots_.size();
+        auto& list = slots_[cursor_];
+
+        for (auto it = list.begin(); it != list.end();)
+        {
+            const auto item = entries_.find(*it);
+            if (is_zero(item->second.rounds))
+            {
+                expired.emplace_back(item->second.strand,
+                    std::move(item->second.handler));
+                entries_.erase(item);
+                it = list.erase(it);
+            }
+            else
+            {
+                --item->second.rounds;
+                ++it;
+            }
+        }
+
+        // Stop ticking when idle, the next start rearms.
+        ticking_ = !entries_.empty();
+        if (ticking_)
+        {
+            timer_.expires_at(timer_.expiry() + resolution_);
+            timer_.async_wait(std::bind(&timer_wheel::handle_tick, this, _1));
+        }
+    }
+
+    for (auto& item: expired)
+        post(*item.first, std::move(item.second), error::success);
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/upload_budget.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+constexpr auto day = std::chrono::hours{ 24 };
+
+upload_budget::upload_budget(size_t limit, size_t target,
+    const duration& interval) NOEXCEPT
+  : limit_(limit),
+    target_(target),
+    interval_(std::max(interval.count(), duration::rep{ 1 })),
+    day_(std::chrono::duration_cast<duration>(day).count()),
+    interval_start_(now()),
+    day_start_(now())
+{
+}
+
+void upload_budget::consume(size_t bytes) NOEXCEPT
+{
+    roll(interval_start_, sent_, interval_);
+    roll(day_start_, served_, day_);
+    sent_.fetch_add(bytes, std::memory_order_relaxed);
+    served_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+size_t upload_budget::limit() const NOEXCEPT
+{
+    return limit_;
+}
+
+size_t upload_budget::target() const NOEXCEPT
+{
+    return target_;
+}
+
+size_t upload_budget::sent() const NOEXCEPT
+{
+    roll(interval_start_, sent_, interval_);
+    return sent_.load(std::memory_order_relaxed);
+}
+
+size_t upload_budget::served() const NOEXCEPT
+{
+    roll(day_start_, served_, day_);
+    return served_.load(std::memory_order_relaxed);
+}
+
+bool upload_budget::deferred() const NOEXCEPT
+{
+    return (!is_zero(limit_) && sent() >= limit_)
+        || (!is_zero(target_) && served() >= target_);
+}
+
+// The daily target outlasts the interval, so it determines the delay.
+upload_budget::duration upload_budget::delay() const NOEXCEPT
+{
+    const auto remaining = [](const std::atomic<ticks>& start,
+        ticks span) NOEXCEPT
+    {
+        const auto end = start.load(std::memory_order_relaxed) + span;
+        return duration{ std::max(end - now(), ticks{}) };
+    };
+
+    if (!is_zero(target_) && served() >= target_)
+        return remaining(day_start_, day_);
+
+    if (!is_zero(limit_) && sent() >= limit_)
+        return remaining(interval_start_, interval_);
+
+    return {};
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+upload_budget::ticks upload_budget::now() NOEXCEPT
+{
+    return steady_clock::now().time_since_epoch().count();
+}
+
+// Concurrent rollover is resolved by the start exchange, bytes accounted by
+// a racing consume may be lost to the reset (accounting is approximate).
+void upload_budget::roll(std::atomic<ticks>& start, std::atomic<size_t>& count,
+    ticks span) const NOEXCEPT
+{
+    const auto current = now();
+    auto began = start.load(std::memory_order_relaxed);
+    if (current - began < span)
+        return;
+
+    if (start.compare_exchange_strong(began, current,
+        std::memory_order_relaxed))
+        count.store(zero, std::memory_order_relaxed);
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/version_template.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+using namespace messages;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Field offsets within the version payload (addresses without timestamp).
+constexpr size_t timestamp_offset = 12;
+constexpr size_t receiver_ip_offset = 28;
+constexpr size_t receiver_port_offset = 44;
+constexpr size_t nonce_offset = 72;
+constexpr size_t user_agent_offset = 80;
+
+// Checksum offset within the heading (follows magic, command and size).
+constexpr size_t checksum_offset = 20;
+
+template <typename Bytes>
+static inline void put(data_chunk& data, size_t offset,
+    const Bytes& bytes) NOEXCEPT
+{
+    std::copy(bytes.begin(), bytes.end(), std::next(data.begin(), offset));
+}
+
+version_template::version_template() NOEXCEPT
+{
+}
+
+chunk_ptr version_template::serialize(const messages::version& message,
+    uint32_t magic, uint32_t version) NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        for (const auto& item: entries_)
+            if (matches(item, message, magic, version))
+                return patch(*item.data, message);
+    }
+
+    const auto data = messages::serialize(message, magic, version);
+    if (!data)
+        return {};
+
+    std::unique_lock lock(mutex_);
+    if (entries_.size() < capacity)
+        entries_.push_back({ magic, version, message, data });
+    else
+        entries_.at(next_++ % capacity) = { magic, version, message, data };
+
+    return data;
+}
+
+size_t version_template::size() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return entries_.size();
+}
+
+// private
+// The receiver address timestamp is not serialized in version messages.
+bool version_template::matches(const entry& item,
+    const messages::version& message, uint32_t magic,
+    uint32_t version) NOEXCEPT
+{
+    const auto& base = item.message;
+    return item.magic == magic
+        && item.version == version
+        && base.value == message.value
+        && base.services == message.services
+        && base.address_receiver.services == message.address_receiver.services
+        && base.address_sender.services == message.address_sender.services
+        && base.address_sender.ip == message.address_sender.ip
+        && base.address_sender.port == message.address_sender.port
+        && base.user_agent == message.user_agent
+        && base.relay == message.relay;
+}
+
+// private
+chunk_ptr version_template::patch(const data_chunk& data,
+    const messages::version& message) NOEXCEPT
+{
+    const auto out = std::make_shared<data_chunk>(data);
+    auto& chunk = *out;
+
+    const auto start = heading::size();
+    const auto height_offset = user_agent_offset +
+        variable_size(message.user_agent.size()) + message.user_agent.size();
+
+    put(chunk, start + timestamp_offset, to_little_endian(message.timestamp));
+    put(chunk, start + receiver_ip_offset, message.address_receiver.ip);
+    put(chunk, start + receiver_port_offset,
+        to_big_endian(message.address_receiver.port));
+    put(chunk, start + nonce_offset, to_little_endian(message.nonce));
+    put(chunk, start + height_offset, to_little_endian(message.start_height));
+
+    const auto payload = std::next(chunk.data(), start);
+    const auto size = chunk.size() - start;
+    put(chunk, checksum_offset, to_little_endian(
+        network_checksum(bitcoin_hash(size, payload))));
+
+    return out;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
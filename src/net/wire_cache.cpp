@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/net/wire_cache.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+wire_cache::wire_cache() NOEXCEPT
+{
+}
+
+size_t wire_cache::size() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+// The number of distinct negotiated parameters is small, so this is linear.
+chunk_ptr wire_cache::find(uint32_t magic, uint32_t version,
+    bool witness) const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    const auto it = std::find_if(entries_.begin(), entries_.end(),
+        [&](const entry& item) NOEXCEPT
+        {
+            return item.magic == magic && item.version == version &&
+                item.witness == witness;
+        });
+
+    return it == entries_.end() ? chunk_ptr{} : it->data;
+}
+
+// Concurrent serializations of the same key resolve to the first stored.
+chunk_ptr wire_cache::store(uint32_t magic, uint32_t version, bool witness,
+    const chunk_ptr& data) NOEXCEPT
+{
+    if (!data)
+        return data;
+
+    std::lock_guard lock(mutex_);
+    const auto it = std::find_if(entries_.begin(), entries_.end(),
+        [&](const entry& item) NOEXCEPT
+        {
+            return item.magic == magic && item.version == version &&
+                item.witness == witness;
+        });
+
+    if (it != entries_.end())
+        return it->data;
+
+    entries_.push_back({ magic, version, witness, data });
+    return data;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
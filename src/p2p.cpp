@@ -20,7 +20,9 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
@@ -41,37 +43,102 @@ using namespace system;
 using namespace std::placeholders;
 
 p2p::p2p(const settings& settings, const logger& log) NOEXCEPT
+  : p2p(settings, log, nullptr)
+{
+}
+
+p2p::p2p(const settings& settings, const logger& log,
+    thread_context& threads) NOEXCEPT
+  : p2p(settings, log, &threads)
+{
+}
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// private
+p2p::p2p(const settings& settings, const logger& log,
+    thread_context* shared) NOEXCEPT
   : settings_(settings),
-    threadpool_(settings.threads),
-    strand_(threadpool_.service().get_executor()),
+    resources_(std::make_shared<network::resources>(settings)),
+    current_(settings::cptr{}, &settings),
+    owned_(shared ? nullptr : std::make_unique<thread_context>(
+        settings.threads, settings.context_per_thread,
+        settings.thread_processors, settings.threads_maximum,
+        settings.thread_delay())),
+    threads_(shared ? *shared : *owned_),
+    compute_(is_zero(settings.compute_threads) ? nullptr :
+        std::make_unique<threadpool>(settings.compute_threads,
+            thread_priority::low)),
+    strand_(threads_.service().get_executor()),
+    hosts_strand_(threads_.service().get_executor()),
     hosts_(settings, log),
-    broadcaster_(strand_),
+    bans_(settings),
+    anchors_(settings),
+    broadcaster_(strand_, settings.broadcast_fanout),
     stop_subscriber_(strand_),
     connect_subscriber_(strand_),
+    nonces_(two * (settings.outbound_connections + settings.outbound_standby +
+        settings.block_relay_connections + settings.peers.size() +
+        settings.seeds.size() + (is_zero(settings.feeler_seconds) ? 0 : 1))),
     reporter(log)
 {
-    BC_ASSERT_MSG(!is_zero(settings.threads), "empty threadpool");
+    BC_ASSERT_MSG(shared || !is_zero(settings.threads), "empty threadpool");
+
+    if (settings.coarse_time)
+        coarse_clock::start();
 }
 
+BC_POP_WARNING()
+
 p2p::~p2p() NOEXCEPT
 {
     // Weak references in threadpool closures safe as p2p joins threads here.
     p2p::close();
+
+    if (settings_.coarse_time)
+        coarse_clock::stop();
 }
 
 // I/O factories.
 // ----------------------------------------------------------------------------
 
+// With context per thread, sockets (and so channels) are assigned round robin
+// to single threaded services, and the network strand has its own thread.
+
 acceptor::ptr p2p::create_acceptor() NOEXCEPT
 {
+    if (!is_zero(threads_.services().size()))
+        return std::make_shared<acceptor>(log, strand(), threads_.services(),
+            *network_settings());
+
     return std::make_shared<acceptor>(log, strand(), service(),
-        network_settings());
+        *network_settings());
 }
 
 connector::ptr p2p::create_connector() NOEXCEPT
 {
+    if (!is_zero(threads_.services().size()))
+        return std::make_shared<connector>(log, strand(), threads_.services(),
+            *network_settings(), resources_);
+
     return std::make_shared<connector>(log, strand(), service(),
-        network_settings());
+        *network_settings(), resources_);
+}
+
+// One acceptor per service shard when reuse_port is set, otherwise one.
+acceptors p2p::create_acceptors() NOEXCEPT
+{
+    auto& shards = threads_.services();
+    if (!network_settings()->reuse_port || is_zero(shards.size()))
+        return { create_acceptor() };
+
+    acceptors out{};
+    out.reserve(shards.size());
+    for (size_t shard = 0; shard < shards.size(); ++shard)
+        out.push_back(std::make_shared<acceptor>(log, shards.service(shard),
+            *network_settings()));
+
+    return out;
 }
 
 connectors_ptr p2p::create_connectors(size_t count) NOEXCEPT
@@ -95,32 +162,205 @@ void p2p::start(result_handler&& handler) NOEXCEPT
         std::bind(&p2p::do_start, this, std::move(handler)));
 }
 
+// Hosts are loaded on the hosts strand concurrently with manual session
+// start, joined on the network strand before seeding (which sizes the pool).
 void p2p::do_start(const result_handler& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    starting_ = two;
+    start_code_ = error::success;
+
+    boost::asio::post(hosts_strand_,
+        std::bind(&p2p::do_start_hosts, this, handler));
+
     manual_ = attach_manual_session();
     manual_->start(std::bind(&p2p::handle_start, this, _1, handler));
 }
 
+void p2p::do_start_hosts(const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    // The blocklist is loaded before any connection is attempted.
+    refresh_blocklist();
+
+    // Deserialize hosts from file.
+    const auto ec = start_hosts();
+    if (ec)
+    {
+        LOGF("Hosts file failed to deserialize, " << ec.message());
+    }
+    else
+    {
+        start_checkpoint();
+        start_sweep();
+    }
+
+    boost::asio::post(strand_, network_timed(
+        std::bind(&p2p::handle_start_hosts, this, ec, handler)));
+}
+
+void p2p::handle_start_hosts(const code& ec,
+    const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // A manual session failure takes precedence over a hosts failure.
+    if (ec && !start_code_)
+        start_code_ = ec;
+
+    start_seed(handler);
+}
+
 void p2p::handle_start(const code& ec, const result_handler& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
     if (ec)
+        start_code_ = ec;
+
+    start_seed(handler);
+}
+
+// Failure is reported once both manual session and hosts have completed.
+void p2p::start_seed(const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!is_zero(--starting_))
+        return;
+
+    if (start_code_)
     {
-        handler(ec);
+        handler(start_code_);
         return;
     }
 
-    // Deserialize hosts from file.
-    if (const auto error_code = start_hosts())
+    attach_seed_session()->start(move_copy(handler));
+}
+
+// Hosts checkpoint sequence (periodic, stopped on close).
+// ----------------------------------------------------------------------------
+// The checkpoint timer is started, stopped and handled on the hosts strand.
+
+void p2p::start_checkpoint() NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    if (is_zero(network_settings()->host_checkpoint_minutes) || closed())
+        return;
+
+    if (!checkpoint_)
+        checkpoint_ = std::make_shared<deadline>(log, hosts_strand_,
+            network_settings()->host_checkpoint());
+
+    checkpoint_->start(std::bind(&p2p::handle_checkpoint, this, _1));
+}
+
+void p2p::handle_checkpoint(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    if (closed() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
     {
-        LOGF("Hosts file failed to deserialize, " << error_code.message());
-        handler(error_code);
+        LOGF("Hosts checkpoint timer failure, " << ec.message());
         return;
     }
 
-    attach_seed_session()->start(move_copy(handler));
+    // Writes are performed on the hosts checkpoint thread.
+    hosts_.checkpoint([this](const code& ec) NOEXCEPT
+    {
+        if (ec && ec != error::service_stopped)
+        {
+            LOGF("Hosts checkpoint failed, " << ec.message());
+        }
+    });
+
+    start_checkpoint();
+}
+
+void p2p::stop_checkpoint() NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    // Handler ignores cancelation.
+    if (checkpoint_) checkpoint_->stop();
+}
+
+// Hosts sweep sequence (periodic, stopped on close).
+// ----------------------------------------------------------------------------
+// The sweep timer is started, stopped and handled on the hosts strand.
+
+void p2p::start_sweep() NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    if (is_zero(network_settings()->host_sweep_minutes) || closed())
+        return;
+
+    if (!sweep_)
+        sweep_ = std::make_shared<deadline>(log, hosts_strand_,
+            network_settings()->host_sweep());
+
+    sweep_->start(std::bind(&p2p::handle_sweep, this, _1));
+}
+
+void p2p::handle_sweep(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    if (closed() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        LOGF("Hosts sweep timer failure, " << ec.message());
+        return;
+    }
+
+    // Sweep is bounded by slice, so completes on the hosts strand.
+    hosts_.sweep([this](const code& ec, size_t swept) NOEXCEPT
+    {
+        if (!ec && !is_zero(swept))
+        {
+            LOGN("Swept (" << swept << ") addresses.");
+        }
+    });
+
+    // A changed blocklist file is reloaded off the network strands.
+    if (!network_settings()->blocklist_path.empty())
+        boost::asio::post(compute(),
+            std::bind(&p2p::refresh_blocklist, this));
+
+    start_sweep();
+}
+
+void p2p::refresh_blocklist() NOEXCEPT
+{
+    if (network_settings()->blocklist_path.empty() || closed())
+        return;
+
+    auto& list = resources_->blocked();
+    const auto prior = list.size();
+    if (const auto ec = list.refresh())
+    {
+        LOGF("Blocklist failed to load, " << ec.message());
+    }
+    else if (list.size() != prior)
+    {
+        LOGN("Loaded (" << list.size() << ") blocklist prefixes.");
+    }
+}
+
+void p2p::stop_sweep() NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+
+    // Handler ignores cancelation.
+    if (sweep_) sweep_->stop();
 }
 
 // Run sequence (seeding may be ongoing after its handler is invoked).
@@ -149,7 +389,8 @@ void p2p::do_run(const result_handler& handler) NOEXCEPT
         return;
     }
 
-    for (const auto& peer: settings_.peers)
+    const auto current = network_settings();
+    for (const auto& peer: current->peers)
         do_connect(peer);
 
     attach_inbound_session()->start(
@@ -166,6 +407,10 @@ void p2p::handle_run(const code& ec, const result_handler& handler) NOEXCEPT
         return;
     }
 
+    // Feelers are independent of the outbound session (and its result).
+    if (!is_zero(network_settings()->feeler_seconds))
+        attach_feeler_session()->start([](const code&) NOEXCEPT {});
+
     attach_outbound_session()->start(move_copy(handler));
 }
 
@@ -175,17 +420,40 @@ void p2p::handle_run(const code& ec, const result_handler& handler) NOEXCEPT
 // Results in std::abort if called from a thread within the threadpool.
 void p2p::close() NOEXCEPT
 {
+    if (!owned_)
+    {
+        close_shared();
+        return;
+    }
+
     closed_.store(true);
     boost::asio::post(strand_,
         std::bind(&p2p::do_close, this));
 
-    // Blocks on join of all threadpool threads.
-    if (!threadpool_.join())
+    // Blocks on join of all threadpool threads, channel services first so
+    // that their final posts to the network strand are not orphaned.
+    // A configured drain bounds the join, abandoning work outstanding at the
+    // deadline (orphaned handlers are destroyed with their services).
+    if (!is_zero(network_settings()->shutdown_drain_seconds))
+    {
+        const auto deadline = steady_clock::now() +
+            network_settings()->shutdown_drain();
+        if (!owned_->join(deadline))
+        {
+            BC_ASSERT_MSG(false, "failed to join threadpool");
+            std::abort();
+        }
+    }
+    else if (!owned_->join())
     {
         BC_ASSERT_MSG(false, "failed to join threadpool");
         std::abort();
     }
 
+    // Outstanding compute and deserializer completions post to stopped
+    // strands (orphaned).
+    join_pools();
+
     // Serialize hosts to file.
     if (const auto error_code = stop_hosts())
     {
@@ -193,6 +461,63 @@ void p2p::close() NOEXCEPT
     }
 }
 
+// Shared threads may have been joined by their owner, so close is not repeated.
+// Results in std::abort if the owner has stopped the shared threads, as the
+// network could not then be stopped on its strands (precondition).
+void p2p::close_shared() NOEXCEPT
+{
+    if (closed_.exchange(true))
+        return;
+
+    if (threads_.stopped())
+    {
+        BC_ASSERT_MSG(false, "shared threads stopped before network close");
+        std::abort();
+    }
+
+    // Blocks until the network is stopped and its hosts serialized, the
+    // hosts strand following the checkpoint stop posted by do_close.
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::promise<code> promise{};
+    boost::asio::post(strand_, [this, &promise]() NOEXCEPT
+    {
+        do_close();
+        boost::asio::post(hosts_strand_, [this, &promise]() NOEXCEPT
+        {
+            promise.set_value(stop_hosts());
+        });
+    });
+
+    // The compute and deserializer pools are owned even when network threads
+    // are shared.
+    join_pools();
+
+    if (const auto error_code = promise.get_future().get())
+    {
+        LOGF("Hosts file failed to serialize, " << error_code.message());
+    }
+
+    // Channel handlers hold sessions, which reference this network, so wait
+    // for the stopped channels to release all sessions.
+    for (auto count = sessions_.load(); !is_zero(count);
+        count = sessions_.load())
+        sessions_.wait(count);
+
+    // Handlers posted to the network strands before the last session release
+    // are then drained in order, so none remain to reference this network.
+    std::promise<bool> drained{};
+    boost::asio::post(strand_, [this, &drained]() NOEXCEPT
+    {
+        boost::asio::post(hosts_strand_, [&drained]() NOEXCEPT
+        {
+            drained.set_value(true);
+        });
+    });
+
+    drained.get_future().wait();
+    BC_POP_WARNING()
+}
+
 void p2p::do_close() NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
@@ -200,6 +525,12 @@ void p2p::do_close() NOEXCEPT
     // Release reference to manual session (also held by stop subscriber).
     if (manual_) manual_.reset();
 
+    // Stop the hosts checkpoint and sweep timers (on their strand).
+    boost::asio::post(hosts_strand_,
+        std::bind(&p2p::stop_checkpoint, this));
+    boost::asio::post(hosts_strand_,
+        std::bind(&p2p::stop_sweep, this));
+
     // Notify and delete all stop subscribers (all sessions).
     stop_subscriber_.stop(error::service_stopped);
 
@@ -210,7 +541,25 @@ void p2p::do_close() NOEXCEPT
     broadcaster_.stop(error::service_stopped);
 
     // Stop threadpool keep-alive, all work must self-terminate to affect join.
-    threadpool_.stop();
+    // Shared threads are stopped by their owner.
+    if (owned_) owned_->stop();
+    if (compute_) compute_->stop();
+    resources_->stop();
+}
+
+void p2p::join_pools() NOEXCEPT
+{
+    if (compute_ && !compute_->join())
+    {
+        BC_ASSERT_MSG(false, "failed to join compute threadpool");
+        std::abort();
+    }
+
+    if (!resources_->join())
+    {
+        BC_ASSERT_MSG(false, "failed to join deserializer threadpool");
+        std::abort();
+    }
 }
 
 // Subscriptions.
@@ -250,8 +599,8 @@ void p2p::do_subscribe_connect(const channel_notifier& handler,
 // protected
 void p2p::notify_connect(const channel::ptr& channel) NOEXCEPT
 {
-    boost::asio::post(strand_,
-        std::bind(&p2p::do_notify_connect, this, channel));
+    boost::asio::post(strand_, network_timed(
+        std::bind(&p2p::do_notify_connect, this, channel)));
 }
 
 void p2p::do_notify_connect(const channel::ptr& channel) NOEXCEPT
@@ -336,8 +685,8 @@ p2p::object_key p2p::create_key() NOEXCEPT
 
 void p2p::connect(const config::endpoint& endpoint) NOEXCEPT
 {
-    boost::asio::post(strand_,
-        std::bind(&p2p::do_connect, this, endpoint));
+    boost::asio::post(strand_, network_timed(
+        std::bind(&p2p::do_connect, this, endpoint)));
 }
 
 void p2p::do_connect(const config::endpoint& endpoint) NOEXCEPT
@@ -356,9 +705,9 @@ void p2p::connect(const config::endpoint& endpoint,
         return;
     }
 
-    boost::asio::post(strand_,
+    boost::asio::post(strand_, network_timed(
         std::bind(&p2p::do_connect_handled, this, endpoint,
-            std::move(handler)));
+            std::move(handler))));
 }
 
 void p2p::do_connect_handled(const config::endpoint& endpoint,
@@ -391,6 +740,16 @@ size_t p2p::reserved_count() const NOEXCEPT
     return hosts_.reserved();
 }
 
+uint64_t p2p::network_group(const messages::ip_address& ip) const NOEXCEPT
+{
+    return hosts_.group(ip);
+}
+
+size_t p2p::banned_count() const NOEXCEPT
+{
+    return bans_.count();
+}
+
 size_t p2p::channel_count() const NOEXCEPT
 {
     return total_channel_count_;
@@ -401,14 +760,44 @@ size_t p2p::inbound_channel_count() const NOEXCEPT
     return inbound_channel_count_;
 }
 
-const settings& p2p::network_settings() const NOEXCEPT
+metrics::snapshot p2p::traffic() const NOEXCEPT
+{
+    return resources_->traffic().get();
+}
+
+size_t p2p::memory_used() const NOEXCEPT
+{
+    return resources_->memory().used();
+}
+
+census::entries p2p::instances() const NOEXCEPT
+{
+    return census::snapshot();
+}
+
+settings::cptr p2p::network_settings() const NOEXCEPT
 {
-    return settings_;
+    std::unique_lock lock(reload_mutex_);
+    return current_;
+}
+
+// The replaced snapshot is freed here unless retained by a reader.
+void p2p::reload(const settings& update) NOEXCEPT
+{
+    std::unique_lock lock(reload_mutex_);
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    const auto next = std::make_shared<settings>(*current_);
+    BC_POP_WARNING()
+
+    next->reload(update);
+    hosts_.reload(next);
+    current_ = next;
 }
 
 asio::io_context& p2p::service() NOEXCEPT
 {
-    return threadpool_.service();
+    return threads_.service();
 }
 
 asio::strand& p2p::strand() NOEXCEPT
@@ -416,68 +805,156 @@ asio::strand& p2p::strand() NOEXCEPT
     return strand_;
 }
 
+asio::io_context& p2p::compute() NOEXCEPT
+{
+    return compute_ ? compute_->service() : threads_.service();
+}
+
+const network::resources::ptr& p2p::resources() const NOEXCEPT
+{
+    return resources_;
+}
+
 // protected
 bool p2p::stranded() const NOEXCEPT
 {
     return strand_.running_in_this_thread();
 }
 
+// private
+bool p2p::hosts_stranded() const NOEXCEPT
+{
+    return hosts_strand_.running_in_this_thread();
+}
+
 // Hosts collection.
 // ----------------------------------------------------------------------------
 // Protected, called from session (network strand) and channel (network pool).
+// Hosts work is serialized on the hosts strand, independent of the network
+// strand. Take and restore handlers are returned to the network strand, as
+// they are invoked by sessions. Fetch and save handlers are invoked on the
+// hosts strand, as protocols return them to the channel strand.
 
 // private
 code p2p::start_hosts() NOEXCEPT
 {
+    if (const auto ec = bans_.start())
+        return ec;
+
+    if (const auto ec = anchors_.start())
+        return ec;
+
     return hosts_.start();
 }
 
 // private
 code p2p::stop_hosts() NOEXCEPT
 {
-    return hosts_.stop();
+    const auto ec = bans_.stop();
+    const auto anchor_code = anchors_.stop();
+    const auto error_code = hosts_.stop();
+    return ec ? ec : (anchor_code ? anchor_code : error_code);
 }
 
 void p2p::take(address_item_handler&& handler) NOEXCEPT
 {
-    boost::asio::post(strand_,
+    boost::asio::post(hosts_strand_,
         std::bind(&p2p::do_take, this, std::move(handler)));
 }
 
 void p2p::do_take(const address_item_handler& handler) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
-    hosts_.take(move_copy(handler));
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+    hosts_.take(std::bind(&p2p::handle_take, this, _1, _2, handler));
+}
+
+void p2p::take(uint64_t services, address_item_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(hosts_strand_,
+        std::bind(&p2p::do_take_services, this, services,
+            std::move(handler)));
+}
+
+void p2p::do_take_services(uint64_t services,
+    const address_item_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+    hosts_.take(services,
+        std::bind(&p2p::handle_take, this, _1, _2, handler));
+}
+
+void p2p::take_new(address_item_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(hosts_strand_,
+        std::bind(&p2p::do_take_new, this, std::move(handler)));
+}
+
+void p2p::do_take_new(const address_item_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+    hosts_.take_new(std::bind(&p2p::handle_take, this, _1, _2, handler));
+}
+
+void p2p::handle_take(const code& ec, const address_item_cptr& host,
+    const address_item_handler& handler) NOEXCEPT
+{
+    // Return to network strand.
+    boost::asio::post(strand_, network_timed(std::bind(handler, ec, host)));
 }
 
 void p2p::restore(const address_item_cptr& address,
     result_handler&& handler) NOEXCEPT
 {
-    boost::asio::post(strand_,
+    boost::asio::post(hosts_strand_,
         std::bind(&p2p::do_restore, this, address, std::move(handler)));
 }
 
 void p2p::do_restore(const address_item_cptr& address,
     const result_handler& handler) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
-    hosts_.restore(address, move_copy(handler));
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+    hosts_.restore(address,
+        std::bind(&p2p::handle_restore, this, _1, handler));
 }
 
-void p2p::fetch(address_handler&& handler) NOEXCEPT
+void p2p::restore(const address_item_cptr& address, const code& ec,
+    const steady_clock::duration& latency, result_handler&& handler) NOEXCEPT
 {
-    boost::asio::post(strand_,
+    boost::asio::post(hosts_strand_,
+        std::bind(&p2p::do_restore_connected,
+            this, address, ec, latency, std::move(handler)));
+}
+
+void p2p::do_restore_connected(const address_item_cptr& address,
+    const code& ec, const steady_clock::duration& latency,
+    const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
+    hosts_.restore(address, ec, latency,
+        std::bind(&p2p::handle_restore, this, _1, handler));
+}
+
+void p2p::handle_restore(const code& ec,
+    const result_handler& handler) NOEXCEPT
+{
+    // Return to network strand.
+    boost::asio::post(strand_, network_timed(std::bind(handler, ec)));
+}
+
+void p2p::fetch(fetch_handler&& handler) NOEXCEPT
+{
+    boost::asio::post(hosts_strand_,
         std::bind(&p2p::do_fetch, this, std::move(handler)));
 }
 
-void p2p::do_fetch(const address_handler& handler) NOEXCEPT
+void p2p::do_fetch(const fetch_handler& handler) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
 
     // Accelerate stop, since hosts keeps running until all threads closed.
     if (closed())
     {
-        handler(error::service_stopped, {});
+        handler(error::service_stopped, {}, {});
         return;
     }
 
@@ -486,14 +963,14 @@ void p2p::do_fetch(const address_handler& handler) NOEXCEPT
 
 void p2p::save(const address_cptr& message, count_handler&& handler) NOEXCEPT
 {
-    boost::asio::post(strand_,
+    boost::asio::post(hosts_strand_,
         std::bind(&p2p::do_save, this, message, std::move(handler)));
 }
 
 void p2p::do_save(const address_cptr& message,
     const count_handler& handler) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
+    BC_ASSERT_MSG(hosts_stranded(), "hosts strand");
 
     // Accelerate stop, since hosts keeps running until all threads closed.
     if (closed())
@@ -510,12 +987,10 @@ void p2p::do_save(const address_cptr& message,
 
 bool p2p::store_nonce(const channel& channel) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
-
-    if (settings_.enable_loopback || channel.inbound())
+    if (network_settings()->enable_loopback || channel.inbound())
         return true;
 
-    if (!nonces_.insert(channel.nonce()).second)
+    if (!nonces_.insert(channel.nonce()))
     {
         LOGF("Failed to store nonce for [" << channel.authority() << "].");
         return false;
@@ -526,12 +1001,10 @@ bool p2p::store_nonce(const channel& channel) NOEXCEPT
 
 bool p2p::unstore_nonce(const channel& channel) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
-
-    if (settings_.enable_loopback || channel.inbound())
+    if (network_settings()->enable_loopback || channel.inbound())
         return true;
 
-    if (!to_bool(nonces_.erase(channel.nonce())))
+    if (!nonces_.erase(channel.nonce()))
     {
         LOGF("Failed to unstore nonce for [" << channel.authority() << "].");
         return false;
@@ -542,21 +1015,78 @@ bool p2p::unstore_nonce(const channel& channel) NOEXCEPT
 
 bool p2p::is_loopback(const channel& channel) const NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
-
-    if (settings_.enable_loopback || !channel.inbound())
+    if (network_settings()->enable_loopback || !channel.inbound())
         return false;
 
-    return to_bool(nonces_.count(channel.peer_version()->nonce));
+    return nonces_.contains(channel.peer_version()->nonce);
+}
+
+bool p2p::banned(const messages::address_item& item) const NOEXCEPT
+{
+    return bans_.banned(item);
+}
+
+// Configured (peers, trusted, explicitly whitelisted) and loopback (such as a
+// local Tor proxy, shared by many remote peers) authorities are not scored.
+void p2p::misbehaved(const channel& channel, const code& ec) NOEXCEPT
+{
+    const auto& authority = channel.authority();
+    const auto item = authority.to_address_item();
+    const auto current = network_settings();
+    if (authority.ip().is_loopback() || current->peered(item) ||
+        (!current->whitelists.empty() && current->whitelisted(item)))
+        return;
+
+    if (bans_.misbehaved(item, ec))
+    {
+        LOGS("Banned [" << channel.authority() << "] for " << ec.message());
+    }
+}
+
+bool p2p::take_anchor(address_item_cptr& out) NOEXCEPT
+{
+    return anchors_.take(out);
+}
+
+void p2p::record_anchor(const channel& channel) NOEXCEPT
+{
+    anchors_.record(*channel.get_updated_address(), channel.block_relay(),
+        channel.uptime());
 }
 
-// Channel counting with address deconfliction.
+// Channel admission with address deconfliction.
 // ----------------------------------------------------------------------------
+// Admission is invoked directly from channel strands. Loopback and counts are
+// lock-free, and address reservation locks only the address's shard.
 
-code p2p::count_channel(const channel& channel) NOEXCEPT
+// Increment unless at maximum (concurrent with other channel strands).
+static bool increment(std::atomic<size_t>& count) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
+    auto value = count.load();
+    do
+    {
+        if (is_zero(add1(value)))
+            return false;
+    }
+    while (!count.compare_exchange_weak(value, add1(value)));
+    return true;
+}
 
+// Decrement unless at zero (concurrent with other channel strands).
+static bool decrement(std::atomic<size_t>& count) NOEXCEPT
+{
+    auto value = count.load();
+    do
+    {
+        if (is_zero(value))
+            return false;
+    }
+    while (!count.compare_exchange_weak(value, sub1(value)));
+    return true;
+}
+
+code p2p::count_channel(const channel& channel) NOEXCEPT
+{
     if (closed())
         return error::service_stopped;
 
@@ -566,56 +1096,45 @@ code p2p::count_channel(const channel& channel) NOEXCEPT
         return error::accept_failed;
     }
 
-    if (channel.inbound() && is_zero(add1(inbound_channel_count_.load())))
+    if (channel.inbound() && !increment(inbound_channel_count_))
     {
         LOGF("Overflow: inbound channel count.");
         return error::channel_overflow;
     }
 
-    if (!channel.quiet() && is_zero(add1(total_channel_count_.load())))
+    if (!channel.quiet() && !increment(total_channel_count_))
     {
         LOGF("Overflow: total channel count.");
+        if (channel.inbound()) decrement(inbound_channel_count_);
         return error::channel_overflow;
     }
 
     if (!hosts_.reserve(channel.authority()))
     {
         LOGS("Duplicate connection to [" << channel.authority() << "].");
+        if (channel.inbound()) decrement(inbound_channel_count_);
+        if (!channel.quiet()) decrement(total_channel_count_);
         return error::address_in_use;
     }
 
-    if (channel.inbound())
-        ++inbound_channel_count_;
-
-    if (!channel.quiet())
-        ++total_channel_count_;
-
     return error::success;
 }
 
 void p2p::uncount_channel(const channel& channel) NOEXCEPT
 {
-    BC_ASSERT_MSG(stranded(), "strand");
-
     hosts_.unreserve(channel.authority());
 
-    if (channel.inbound() && is_zero(inbound_channel_count_.load()))
+    if (channel.inbound() && !decrement(inbound_channel_count_))
     {
         LOGF("Underflow: inbound channel count.");
         return;
     }
 
-    if (!channel.quiet() && is_zero(total_channel_count_.load()))
+    if (!channel.quiet() && !decrement(total_channel_count_))
     {
         LOGF("Underflow: total channel count.");
         return;
     }
-
-    if (channel.inbound())
-        --inbound_channel_count_;
-
-    if (!channel.quiet())
-        --total_channel_count_;
 }
 
 // Specializations (protected).
@@ -645,6 +1164,12 @@ session_outbound::ptr p2p::attach_outbound_session() NOEXCEPT
     return attach<session_outbound>(*this);
 }
 
+session_feeler::ptr p2p::attach_feeler_session() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return attach<session_feeler>(*this);
+}
+
 BC_POP_WARNING()
 
 } // namespace network
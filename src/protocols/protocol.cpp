@@ -95,6 +95,39 @@ void protocol::pause() NOEXCEPT
     channel_->pause();
 }
 
+// Hold reads beyond the granted message and byte credit.
+void protocol::grant(size_t messages, size_t bytes) NOEXCEPT
+{
+    channel_->grant(messages, bytes);
+}
+
+// Capabilities are updated for subscriptions, and the broadcast index.
+void protocol::set_fee_filter(uint64_t rate) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "stranded");
+    channel_->set_fee_filter(rate);
+    session_.set_fee_filter(channel_->identifier(), rate);
+}
+
+uint64_t protocol::fee_filter() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return channel_->fee_filter();
+}
+
+bool protocol::congested() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return channel_->congested();
+}
+
+void protocol::subscribe_congestion(
+    channel::congestion_subscriber::handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    channel_->subscribe_congestion(std::move(handler));
+}
+
 // Properties.
 // ----------------------------------------------------------------------------
 // The public properties may be accessed outside the strand, except during
@@ -137,6 +170,11 @@ void protocol::set_peer_version(const version::cptr& value) NOEXCEPT
     channel_->set_peer_version(value);
 }
 
+void protocol::set_compression(bool send, bool receive) NOEXCEPT
+{
+    channel_->set_compression(send, receive);
+}
+
 uint32_t protocol::negotiated_version() const NOEXCEPT
 {
     return channel_->negotiated_version();
@@ -148,9 +186,41 @@ void protocol::set_negotiated_version(uint32_t value) NOEXCEPT
     channel_->set_negotiated_version(value);
 }
 
+bool protocol::wtxid_relay() const NOEXCEPT
+{
+    return channel_->wtxid_relay();
+}
+
+// Call only from handshake (version protocol), for thread safety.
+void protocol::set_wtxid_relay(bool value) NOEXCEPT
+{
+    channel_->set_wtxid_relay(value);
+}
+
+bool protocol::reconciliation() const NOEXCEPT
+{
+    return channel_->reconciliation();
+}
+
+const siphash_key& protocol::reconciliation_key() const NOEXCEPT
+{
+    return channel_->reconciliation_key();
+}
+
+// Call only from handshake (version protocol), for thread safety.
+void protocol::set_reconciliation(const siphash_key& key) NOEXCEPT
+{
+    channel_->set_reconciliation(key);
+}
+
 const network::settings& protocol::settings() const NOEXCEPT
 {
-    return session_.settings();
+    return channel_->settings();
+}
+
+network::resources& protocol::resources() const NOEXCEPT
+{
+    return session_.resources();
 }
 
 address protocol::selfs() const NOEXCEPT
@@ -172,6 +242,43 @@ uint64_t protocol::identifier() const NOEXCEPT
     return channel_->identifier();
 }
 
+void protocol::set_round_trip(uint64_t nanoseconds) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    channel_->set_round_trip(nanoseconds);
+}
+
+void protocol::announce(const messages::inventory_item& item) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    channel_->announce(item);
+}
+
+void protocol::announce(const system::chain::transaction& tx) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    channel_->announce(wtxid_relay() ?
+        inventory_item{ inventory_item::type_id::wtxid, tx.hash(true) } :
+        inventory_item{ inventory_item::type_id::transaction, tx.hash(false) });
+}
+
+bool protocol::is_known(const system::hash_digest& hash) const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return channel_->is_known(hash);
+}
+
+void protocol::set_known(const system::hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    channel_->set_known(hash);
+}
+
+bool protocol::is_novel(const system::hash_digest& hash) const NOEXCEPT
+{
+    return resources().seen().insert(hash);
+}
+
 // Addresses.
 // ----------------------------------------------------------------------------
 // Channel and network strands share same pool, and as long as a job is
@@ -186,15 +293,27 @@ size_t protocol::address_count() const NOEXCEPT
 void protocol::fetch(address_handler&& handler) NOEXCEPT
 {
     session_.fetch(
-        BIND3(handle_fetch, _1, _2, std::move(handler)));
+        BIND4(handle_fetch, _1, _2, _3, std::move(handler)));
 }
 
 void protocol::handle_fetch(const code& ec, const address_cptr& message,
-    const address_handler& handler) NOEXCEPT
+    const wire_cache::ptr& cache, const address_handler& handler) NOEXCEPT
 {
     // Return to channel strand.
-    boost::asio::post(channel_->strand(),
-        std::bind(handler, ec, message));
+    boost::asio::post(channel_->strand(), channel_timed(
+        BIND4(do_fetch, ec, message, cache, handler)));
+}
+
+// A send of the fetched message within handler shares the fetched encoding.
+void protocol::do_fetch(const code& ec, const address_cptr& message,
+    const wire_cache::ptr& cache, const address_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    relay_message_ = message.get();
+    relay_cache_ = cache;
+    handler(ec, message);
+    relay_message_ = nullptr;
+    relay_cache_.reset();
 }
 
 void protocol::save(const address_cptr& message,
@@ -208,8 +327,8 @@ void protocol::handle_save(const code& ec, size_t accepted,
     const count_handler& handler) NOEXCEPT
 {
     // Return to channel strand.
-    boost::asio::post(channel_->strand(),
-        std::bind(handler, ec, accepted));
+    boost::asio::post(channel_->strand(), channel_timed(
+        std::bind(handler, ec, accepted)));
 }
 
 // Send.
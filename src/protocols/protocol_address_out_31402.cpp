@@ -38,9 +38,22 @@ using namespace std::placeholders;
 // Bind throws (ok).
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
+// Relay is batched only if there is a relay interval (nullptr otherwise).
+static deadline::ptr relay_timer(session& session,
+    const channel::ptr& channel) NOEXCEPT
+{
+    const auto interval = channel->settings().address_relay();
+    if (interval == interval.zero())
+        return {};
+
+    return std::make_shared<deadline>(session.log, channel->strand(),
+        session.resources().timers(), interval);
+}
+
 protocol_address_out_31402::protocol_address_out_31402(session& session,
     const channel::ptr& channel) NOEXCEPT
   : protocol(session, channel),
+    timer_(relay_timer(session, channel)),
     tracker<protocol_address_out_31402>(session.log)
 {
 }
@@ -129,13 +142,81 @@ bool protocol_address_out_31402::handle_broadcast_address(const code& ec,
         return true;
     }
 
-    LOGP("Relay (" << message->addresses.size() << ") addresses to ["
-        << authority() << "].");
+    // Addresses already relayed to the peer are not relayed again, and the
+    // record is forgotten once it exceeds the maximum address message size.
+    if (relayed_.size() > max_address)
+        relayed_.clear();
+
+    const auto waiting = !batch_.empty();
+    for (const auto& item: message->addresses)
+        if (relayed_.insert(to_key(item)).second)
+            batch_.push_back(item);
+
+    if (batch_.empty())
+        return true;
+
+    // Without a relay interval (or when full) the batch is sent now.
+    if (!timer_ || batch_.size() >= max_address)
+    {
+        flush_relay();
+        return true;
+    }
+
+    // The relay timer runs only while there are batched addresses.
+    if (!waiting)
+        timer_->start(BIND1(handle_relay, _1));
 
-    SEND1(*message, handle_send, _1);
     return true;
 }
 
+void protocol_address_out_31402::handle_relay(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_address_out_31402");
+
+    // error::operation_canceled is set by flush or stop (not stopped).
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        stop(ec);
+        return;
+    }
+
+    flush_relay();
+}
+
+void protocol_address_out_31402::stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_address_out_31402");
+
+    if (timer_)
+        timer_->stop();
+
+    batch_.clear();
+}
+
+// private
+// Batched addresses (from any number of broadcasts) are sent as one message.
+void protocol_address_out_31402::flush_relay() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_address_out_31402");
+
+    if (batch_.empty())
+        return;
+
+    if (timer_)
+        timer_->stop();
+
+    const address message{ std::move(batch_) };
+    batch_.clear();
+
+    LOGP("Relay (" << message.addresses.size() << ") addresses to ["
+        << authority() << "].");
+
+    SEND1(message, handle_send, _1);
+}
+
 BC_POP_WARNING()
 BC_POP_WARNING()
 BC_POP_WARNING()
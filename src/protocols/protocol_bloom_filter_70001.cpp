@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_bloom_filter_70001.hpp>
+
+#include <functional>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_bloom_filter_70001
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+protocol_bloom_filter_70001::protocol_bloom_filter_70001(session& session,
+    const channel::ptr& channel) NOEXCEPT
+  : protocol(session, channel),
+    tracker<protocol_bloom_filter_70001>(session.log)
+{
+}
+
+// Start.
+// ----------------------------------------------------------------------------
+
+void protocol_bloom_filter_70001::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(bloom_filter_load, handle_receive_bloom_filter_load,
+        _1, _2);
+    SUBSCRIBE_CHANNEL2(bloom_filter_add, handle_receive_bloom_filter_add,
+        _1, _2);
+    SUBSCRIBE_CHANNEL2(bloom_filter_clear, handle_receive_bloom_filter_clear,
+        _1, _2);
+
+    protocol::start();
+}
+
+// Matching.
+// ----------------------------------------------------------------------------
+
+bool protocol_bloom_filter_70001::filtered() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+    return !!filter_;
+}
+
+bool protocol_bloom_filter_70001::match(
+    const chain::transaction& tx) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+    return !filter_ || filter_->match(tx);
+}
+
+merkle_block protocol_bloom_filter_70001::match(bloom_filter::indexes& matched,
+    const chain::block& block) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+
+    if (filter_)
+        return filter_->match(matched, block);
+
+    // Unfiltered, all transactions match (empty filter).
+    bloom_filter all(bloom_filter_load{});
+    return all.match(matched, block);
+}
+
+// Inbound.
+// ----------------------------------------------------------------------------
+
+bool protocol_bloom_filter_70001::handle_receive_bloom_filter_load(
+    const code& ec, const bloom_filter_load::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+
+    if (stopped(ec))
+        return false;
+
+    if (!bloom_filter::is_valid(*message))
+    {
+        LOGR("Oversized bloom filter from [" << authority() << "]");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    filter_ = std::make_unique<bloom_filter>(*message);
+    BC_POP_WARNING()
+    return true;
+}
+
+bool protocol_bloom_filter_70001::handle_receive_bloom_filter_add(
+    const code& ec, const bloom_filter_add::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+
+    if (stopped(ec))
+        return false;
+
+    if (!filter_ || message->data.size() > bloom_filter::maximum_element)
+    {
+        LOGR("Invalid bloom filter add from [" << authority() << "]");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    filter_->insert(message->data);
+    return true;
+}
+
+bool protocol_bloom_filter_70001::handle_receive_bloom_filter_clear(
+    const code& ec, const bloom_filter_clear::cptr&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_bloom_filter_70001");
+
+    if (stopped(ec))
+        return false;
+
+    filter_.reset();
+    return true;
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,285 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_client_filter_70015.hpp>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_client_filter_70015
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+// BIP157 request limits and checkpoint interval.
+constexpr size_t maximum_filters = 1'000;
+constexpr size_t maximum_filter_headers = 2'000;
+constexpr size_t checkpoint_interval = 1'000;
+
+// Filter ranges pending behind the streaming range, excess is dropped.
+constexpr size_t maximum_ranges = 8;
+
+protocol_client_filter_70015::protocol_client_filter_70015(session& session,
+    const channel::ptr& channel, store& filters, filter_cache& cache) NOEXCEPT
+  : protocol(session, channel),
+    store_(filters),
+    cache_(cache),
+    tracker<protocol_client_filter_70015>(session.log)
+{
+}
+
+// Start.
+// ----------------------------------------------------------------------------
+
+void protocol_client_filter_70015::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_client_filter_70015");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(get_client_filters,
+        handle_receive_get_client_filters, _1, _2);
+    SUBSCRIBE_CHANNEL2(get_client_filter_headers,
+        handle_receive_get_client_filter_headers, _1, _2);
+    SUBSCRIBE_CHANNEL2(get_client_filter_checkpoint,
+        handle_receive_get_client_filter_checkpoint, _1, _2);
+
+    protocol::start();
+}
+
+// Inbound (filters).
+// ----------------------------------------------------------------------------
+
+bool protocol_client_filter_70015::handle_receive_get_client_filters(
+    const code& ec, const get_client_filters::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_client_filter_70015");
+
+    if (stopped(ec))
+        return false;
+
+    range value{};
+    if (!to_range(value, message->filter_type, message->start_height,
+        message->stop_hash, maximum_filters))
+        return !stopped();
+
+    if (ranges_.size() >= maximum_ranges)
+    {
+        LOGP("Dropped client filter range from [" << authority() << "]");
+        return true;
+    }
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    ranges_.push_back(value);
+    BC_POP_WARNING()
+
+    // The first range starts the stream, others follow upon completion.
+    if (is_one(ranges_.size()))
+        send_client_filter();
+
+    return true;
+}
+
+// One filter is sent at a time, so storage reads are paced by the peer.
+void protocol_client_filter_70015::send_client_filter() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_client_filter_70015");
+
+    while (!ranges_.empty())
+    {
+        auto& current = ranges_.front();
+        if (current.next > current.stop)
+        {
+            ranges_.pop_front();
+            continue;
+        }
+
+        client_filter message{ current.type, {}, {} };
+        const auto height = current.next++;
+        if (!store_.get_hash(message.block_hash, height) ||
+            !store_.get_filter(message.filter, current.type,
+                message.block_hash))
+        {
+            // Reorganized or unavailable, the remainder is abandoned.
+            LOGP("Client filter unavailable at (" << height << ") for ["
+                << authority() << "]");
+            ranges_.pop_front();
+            continue;
+        }
+
+        SEND1(message, handle_send_client_filter, _1);
+        return;
+    }
+}
+
+void protocol_client_filter_70015::handle_send_client_filter(
+    const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_client_filter_70015");
+
+    if (stopped(ec))
+        return;
+
+    send_client_filter();
+}
+
+// Inbound (headers).
+// ----------------------------------------------------------------------------
+
+bool protocol_client_filter_70015::handle_receive_get_client_filter_headers(
+    const code& ec, const get_client_filter_headers::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_client_filter_70015");
+
+    if (stopped(ec))
+        return false;
+
+    range value{};
+    const auto type = message->filter_type;
+    if (!to_range(value, type, message->start_height, message->stop_hash,
+        maximum_filter_headers))
+        return !stopped();
+
+    client_filter_headers response{ type, message->stop_hash, {}, {} };
+
+    // The previous filter header of genesis is null_hash.
+    filter_cache::header header{};
+    if (!is_zero(value.next))
+    {
+        if (!get_filter_header(header, type, sub1(value.next)))
+            return true;
+
+        response.previous_filter_header = header.filter_header;
+    }
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    response.filter_hashes.reserve(add1(value.stop - value.next));
+    for (auto height = value.next; height <= value.stop; ++height)
+    {
+        if (!get_filter_header(header, type, height))
+            return true;
+
+        response.filter_hashes.push_back(header.filter_hash);
+    }
+    BC_POP_WARNING()
+
+    SEND1(response, handle_send, _1);
+    return true;
+}
+
+bool protocol_client_filter_70015::handle_receive_get_client_filter_checkpoint(
+    const code& ec, const get_client_filter_checkpoint::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_client_filter_70015");
+
+    if (stopped(ec))
+        return false;
+
+    const auto type = message->filter_type;
+    if (const auto cached = cache_.find(type, message->stop_hash))
+    {
+        SEND1(*cached, handle_send, _1);
+        return true;
+    }
+
+    size_t stop{};
+    if (!store_.get_height(stop, message->stop_hash))
+    {
+        LOGP("Unknown client filter checkpoint stop from ["
+            << authority() << "]");
+        return true;
+    }
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    const auto response = std::make_shared<client_filter_checkpoint>(
+        client_filter_checkpoint{ type, message->stop_hash, {} });
+
+    filter_cache::header header{};
+    response->filter_headers.reserve(stop / checkpoint_interval);
+    for (auto height = checkpoint_interval; height <= stop;
+        height += checkpoint_interval)
+    {
+        if (!get_filter_header(header, type, height))
+            return true;
+
+        response->filter_headers.push_back(header.filter_header);
+    }
+    BC_POP_WARNING()
+
+    cache_.store(response);
+    SEND1(*response, handle_send, _1);
+    return true;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+bool protocol_client_filter_70015::to_range(range& out, uint8_t type,
+    size_t start, const hash_digest& stop_hash, size_t limit) NOEXCEPT
+{
+    size_t height{};
+    if (!store_.get_height(height, stop_hash))
+    {
+        LOGP("Unknown client filter stop from [" << authority() << "]");
+        return false;
+    }
+
+    // Inverted or oversized ranges are protocol violations (BIP157).
+    if (start > height || (height - start) >= limit)
+    {
+        LOGR("Invalid client filter range from [" << authority() << "]");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    out = { type, start, height };
+    return true;
+}
+
+bool protocol_client_filter_70015::get_filter_header(
+    filter_cache::header& out, uint8_t type, size_t height) const NOEXCEPT
+{
+    hash_digest block{};
+    if (!store_.get_hash(block, height))
+        return false;
+
+    if (cache_.find(out, type, block))
+        return true;
+
+    if (!store_.get_filter_header(out, type, block))
+        return false;
+
+    cache_.store(type, block, out);
+    return true;
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_compact_block_70014.hpp>
+
+#include <functional>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_compact_block_70014
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+// Version 1 short ids are of txids, version 2 of wtxids (BIP152/BIP144).
+constexpr uint64_t transaction_version = 1;
+constexpr uint64_t witness_version = 2;
+
+// Short id slot marker for collisions, resolved by requesting the position.
+constexpr auto collision = max_size_t;
+
+protocol_compact_block_70014::protocol_compact_block_70014(session& session,
+    const channel::ptr& channel, pool& transactions) NOEXCEPT
+  : protocol(session, channel),
+    pool_(transactions),
+    tracker<protocol_compact_block_70014>(session.log)
+{
+}
+
+// Start.
+// ----------------------------------------------------------------------------
+
+void protocol_compact_block_70014::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(send_compact, handle_receive_send_compact, _1, _2);
+    SUBSCRIBE_CHANNEL2(compact_block, handle_receive_compact_block, _1, _2);
+    SUBSCRIBE_CHANNEL2(compact_transactions,
+        handle_receive_compact_transactions, _1, _2);
+
+    // High bandwidth mode requests unsolicited compact block announcement.
+    high_bandwidth_ = settings().compact_high_bandwidth &&
+        resources().take_high_bandwidth();
+
+    const send_compact announcement{ high_bandwidth_, witness_version };
+    SEND1(announcement, handle_send, _1);
+    protocol::start();
+}
+
+void protocol_compact_block_70014::stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+
+    if (high_bandwidth_)
+        resources().release_high_bandwidth();
+
+    high_bandwidth_ = false;
+    reset();
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+bool protocol_compact_block_70014::high_bandwidth() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+    return high_bandwidth_;
+}
+
+bool protocol_compact_block_70014::peer_high_bandwidth() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+    return peer_high_bandwidth_;
+}
+
+bool protocol_compact_block_70014::peer_compact() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+    return peer_compact_;
+}
+
+// Inbound (negotiation).
+// ----------------------------------------------------------------------------
+
+bool protocol_compact_block_70014::handle_receive_send_compact(const code& ec,
+    const send_compact::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+
+    if (stopped(ec))
+        return false;
+
+    // Unknown versions are ignored, and version 2 is preferred once seen.
+    const auto version = message->compact_version;
+    if (version != transaction_version && version != witness_version)
+        return true;
+
+    if (version == transaction_version && peer_compact_ && witness_)
+        return true;
+
+    peer_compact_ = true;
+    witness_ = (version == witness_version);
+    peer_high_bandwidth_ = message->high_bandwidth;
+
+    LOGP("Compact blocks (v" << version << ", "
+        << (peer_high_bandwidth_ ? "high" : "low") << ") for ["
+        << authority() << "].");
+
+    return true;
+}
+
+// Inbound (reconstruction).
+// ----------------------------------------------------------------------------
+
+bool protocol_compact_block_70014::handle_receive_compact_block(const code& ec,
+    const compact_block::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+
+    if (stopped(ec))
+        return false;
+
+    // A new announcement supersedes any pending reconstruction.
+    reset();
+
+    if (!reconstruct(*message))
+    {
+        LOGR("Invalid compact block from [" << authority() << "]");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    if (missing_.empty())
+        complete();
+    else
+        request();
+
+    return true;
+}
+
+bool protocol_compact_block_70014::handle_receive_compact_transactions(
+    const code& ec, const compact_transactions::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_compact_block_70014");
+
+    if (stopped(ec))
+        return false;
+
+    // Superseded or unrequested, ignore.
+    if (!header_ || message->block_hash != header_->hash())
+    {
+        LOGP("Unexpected compact transactions from [" << authority() << "]");
+        return true;
+    }
+
+    if (message->transaction_ptrs.size() != missing_.size())
+    {
+        LOGR("Invalid compact transactions from [" << authority() << "]");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    for (size_t index = 0; index < missing_.size(); ++index)
+        transactions_.at(missing_.at(index)) =
+            message->transaction_ptrs.at(index);
+
+    complete();
+    return true;
+}
+
+// private
+bool protocol_compact_block_70014::reconstruct(
+    const compact_block& message) NOEXCEPT
+{
+    const auto prefilled = message.transactions.size();
+    const auto count = prefilled + message.short_ids.size();
+    if (is_zero(count) || count > chain::max_block_size)
+        return false;
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    transactions_.resize(count);
+
+    // Prefilled indexes are differentially encoded, and strictly increasing.
+    size_t next{};
+    for (const auto& item: message.transactions)
+    {
+        if (!item.transaction_ptr || item.index >= count - next)
+            return false;
+
+        const auto position = next + item.index;
+        transactions_.at(position) = item.transaction_ptr;
+        next = add1(position);
+    }
+
+    // Short ids are in the order of the remaining (unfilled) positions.
+    size_t id{};
+    short_id_table table{ message.short_ids.size() };
+    for (size_t position = 0; position < count; ++position)
+    {
+        if (transactions_.at(position))
+            continue;
+
+        const auto number = compact_block::to_number(
+            message.short_ids.at(id++));
+
+        // A duplicate short id in the block is requested for each position.
+        if (!table.insert(number, position))
+            *table.find(number) = collision;
+    }
+
+    // Pool short ids are computed in one batch, before matching.
+    const auto candidates = pool_.candidates();
+    hashes txids{};
+    txids.reserve(candidates.size());
+    for (const auto& tx: candidates)
+        txids.push_back(tx->hash(witness_));
+
+    const auto ids = compact_block::to_short_ids(message.key(), txids);
+
+    // A short id matched by more than one pool transaction is requested.
+    for (size_t index = 0; index < ids.size(); ++index)
+    {
+        const auto value = table.find(ids.at(index));
+        if (is_null(value) || *value == collision)
+            continue;
+
+        auto& slot = transactions_.at(*value);
+        if (!slot)
+        {
+            slot = candidates.at(index);
+            continue;
+        }
+
+        slot.reset();
+        *value = collision;
+    }
+
+    for (size_t position = 0; position < count; ++position)
+        if (!transactions_.at(position))
+            missing_.push_back(position);
+
+    header_ = message.header_ptr;
+    BC_POP_WARNING()
+    return true;
+}
+
+// Missing positions are requested by differentially encoded index.
+void protocol_compact_block_70014::request() NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    get_compact_transactions message{ header_->hash(), {} };
+    message.indexes.reserve(missing_.size());
+
+    size_t next{};
+    for (const auto position: missing_)
+    {
+        message.indexes.push_back(position - next);
+        next = add1(position);
+    }
+    BC_POP_WARNING()
+
+    LOGP("Requesting (" << missing_.size() << ") of ("
+        << transactions_.size() << ") compact transactions from ["
+        << authority() << "].");
+
+    SEND1(message, handle_send, _1);
+}
+
+void protocol_compact_block_70014::complete() NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    const auto block = to_shared<chain::block>(header_,
+        to_shared<chain::transaction_cptrs>(std::move(transactions_)));
+    BC_POP_WARNING()
+
+    pool_.accept(block, identifier());
+    reset();
+}
+
+void protocol_compact_block_70014::reset() NOEXCEPT
+{
+    header_.reset();
+    transactions_.clear();
+    missing_.clear();
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_fee_filter_70013.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_fee_filter_70013
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+protocol_fee_filter_70013::protocol_fee_filter_70013(session& session,
+    const channel::ptr& channel) NOEXCEPT
+  : protocol(session, channel),
+    tracker<protocol_fee_filter_70013>(session.log)
+{
+}
+
+// Start.
+// ----------------------------------------------------------------------------
+
+void protocol_fee_filter_70013::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fee_filter_70013");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(fee_filter, handle_receive_fee_filter, _1, _2);
+
+    protocol::start();
+}
+
+// Inbound (set fee filter).
+// ----------------------------------------------------------------------------
+
+// The peer may change its filter at any time, each replaces the prior.
+bool protocol_fee_filter_70013::handle_receive_fee_filter(const code& ec,
+    const fee_filter::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fee_filter_70013");
+
+    if (stopped(ec))
+        return false;
+
+    LOGP("Fee filter (" << message->minimum_fee << ") from ["
+        << authority() << "].");
+
+    set_fee_filter(message->minimum_fee);
+    return true;
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_fetch_31402.hpp>
+
+#include <functional>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_fetch_31402
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+protocol_fetch_31402::protocol_fetch_31402(session& session,
+    const channel::ptr& channel, fetcher& scheduler, sink& items) NOEXCEPT
+  : protocol(session, channel),
+    fetcher_(scheduler),
+    sink_(items),
+    timer_(std::make_shared<deadline>(session.log, channel->strand(),
+        session.resources().timers(), channel->settings().fetch_stall())),
+    tracker<protocol_fetch_31402>(session.log)
+{
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+void protocol_fetch_31402::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(block, handle_receive_block, _1, _2);
+    SUBSCRIBE_CHANNEL2(transaction, handle_receive_transaction, _1, _2);
+    SUBSCRIBE_CHANNEL2(not_found, handle_receive_not_found, _1, _2);
+    timer_->start(BIND1(handle_timer, _1));
+
+    protocol::start();
+    request();
+}
+
+void protocol_fetch_31402::stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    timer_->stop();
+    fetcher_.release(identifier());
+}
+
+// Outgoing (request [on receipt or timer] => handle_send).
+// ----------------------------------------------------------------------------
+
+void protocol_fetch_31402::request() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    if (stopped())
+        return;
+
+    auto items = fetcher_.request(identifier());
+    if (items.empty())
+        return;
+
+    SEND1(get_data{ std::move(items) }, handle_send, _1);
+}
+
+void protocol_fetch_31402::handle_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    if (stopped())
+        return;
+
+    // error::operation_canceled implies stopped, so this is something else.
+    if (ec)
+    {
+        stop(ec);
+        return;
+    }
+
+    // Stalled items are requeued excluding this channel, available to others.
+    if (const auto stalled = fetcher_.expire(identifier()))
+    {
+        LOGP("Stalled [" << stalled << "] items from [" << authority()
+            << "].");
+    }
+
+    timer_->start(BIND1(handle_timer, _1));
+    request();
+}
+
+// Incoming (receive_block/transaction/not_found => request).
+// ----------------------------------------------------------------------------
+
+bool protocol_fetch_31402::handle_receive_block(const code& ec,
+    const block::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    if (stopped(ec))
+        return false;
+
+    // Unrequested (e.g. announced) blocks are left to other protocols.
+    const auto& value = message->block_ptr;
+    if (fetcher_.received(identifier(), value->hash()))
+    {
+        sink_.accept(value, identifier());
+        request();
+    }
+
+    return true;
+}
+
+bool protocol_fetch_31402::handle_receive_transaction(const code& ec,
+    const transaction::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    if (stopped(ec))
+        return false;
+
+    // Unrequested transactions are left to other protocols.
+    const auto& value = message->transaction_ptr;
+    if (fetcher_.received(identifier(), value->hash(false)))
+    {
+        sink_.accept(value, identifier());
+        request();
+    }
+
+    return true;
+}
+
+bool protocol_fetch_31402::handle_receive_not_found(const code& ec,
+    const not_found::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_fetch_31402");
+
+    if (stopped(ec))
+        return false;
+
+    // Not found items are requeued excluding this channel.
+    for (const auto& item: message->items)
+        fetcher_.not_found(identifier(), item.hash);
+
+    request();
+    return true;
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_headers_31800.hpp>
+
+#include <functional>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_headers_31800
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+protocol_headers_31800::protocol_headers_31800(session& session,
+    const channel::ptr& channel, header_fetcher& scheduler) NOEXCEPT
+  : protocol(session, channel),
+    fetcher_(scheduler),
+    timer_(std::make_shared<deadline>(session.log, channel->strand(),
+        session.resources().timers(), channel->settings().fetch_stall())),
+    tracker<protocol_headers_31800>(session.log)
+{
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+void protocol_headers_31800::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_headers_31800");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(headers, handle_receive_headers, _1, _2);
+
+    protocol::start();
+    request();
+}
+
+void protocol_headers_31800::stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_headers_31800");
+
+    timer_->stop();
+    fetcher_.release(identifier());
+}
+
+// Outgoing (request [on receipt] => handle_send).
+// ----------------------------------------------------------------------------
+
+void protocol_headers_31800::request() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_headers_31800");
+
+    if (stopped() || requested_)
+        return;
+
+    header_fetcher::range range{};
+    if (!fetcher_.request(identifier(), range))
+        return;
+
+    requested_ = true;
+    timer_->start(BIND1(handle_timer, _1));
+    SEND1(get_headers{ { range.start }, range.stop }, handle_send, _1);
+}
+
+void protocol_headers_31800::handle_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_headers_31800");
+
+    if (stopped() || ec == error::operation_canceled)
+        return;
+
+    if (ec)
+    {
+        stop(ec);
+        return;
+    }
+
+    LOGP("Stalled headers request to [" << authority() << "].");
+    stop(error::channel_timeout);
+}
+
+// Incoming (receive_headers => request).
+// ----------------------------------------------------------------------------
+
+bool protocol_headers_31800::handle_receive_headers(const code& ec,
+    const headers::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_headers_31800");
+
+    if (stopped(ec))
+        return false;
+
+    // Unrequested (e.g. announced) headers are left to other protocols.
+    if (!requested_)
+        return true;
+
+    requested_ = false;
+    timer_->stop();
+
+    const auto hashes = hash(*message, negotiated_version());
+    if (const auto code = fetcher_.received(identifier(),
+        message->header_ptrs, hashes))
+    {
+        LOGR("Discontinuous headers from [" << authority() << "] "
+            << code.message());
+        stop(code);
+        return false;
+    }
+
+    request();
+    return true;
+}
+
+// private
+// Serialized for the batched hash of the wire payload (not retained).
+hashes protocol_headers_31800::hash(const headers& message,
+    uint32_t version) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    data_chunk data(message.size(version));
+    BC_POP_WARNING()
+
+    return message.serialize(version, data) ? headers::hash(data) : hashes{};
+}
+
+} // namespace network
+} // namespace libbitcoin
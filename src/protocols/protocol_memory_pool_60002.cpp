@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_memory_pool_60002.hpp>
+
+#include <functional>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_memory_pool_60002
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+protocol_memory_pool_60002::protocol_memory_pool_60002(session& session,
+    const channel::ptr& channel, source& pool,
+    const protocol_bloom_filter_70001::ptr& bloom) NOEXCEPT
+  : protocol(session, channel),
+    source_(pool),
+    bloom_(bloom),
+    tracker<protocol_memory_pool_60002>(session.log)
+{
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+void protocol_memory_pool_60002::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_memory_pool_60002");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(memory_pool, handle_receive_memory_pool, _1, _2);
+    subscribe_congestion(BIND2(handle_congestion, _1, _2));
+
+    protocol::start();
+}
+
+void protocol_memory_pool_60002::stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_memory_pool_60002");
+
+    cursor_.reset();
+    bloom_.reset();
+}
+
+// Inbound (memory_pool => send_page).
+// ----------------------------------------------------------------------------
+
+bool protocol_memory_pool_60002::handle_receive_memory_pool(const code& ec,
+    const memory_pool::cptr&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_memory_pool_60002");
+
+    if (stopped(ec))
+        return false;
+
+    if (cursor_)
+    {
+        LOGP("Memory pool request while streaming to [" << authority()
+            << "].");
+        return true;
+    }
+
+    cursor_ = source_.iterate();
+    if (!cursor_)
+        return true;
+
+    send_page();
+    return true;
+}
+
+// Outbound (send_page => handle_send_page [=> handle_congestion]).
+// ----------------------------------------------------------------------------
+
+// Only one page is held at a time, so memory is bounded by max_inventory.
+void protocol_memory_pool_60002::send_page() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_memory_pool_60002");
+
+    if (stopped() || !cursor_)
+        return;
+
+    inventory_items items{};
+    items.reserve(max_inventory);
+
+    const auto wtxid = wtxid_relay();
+    const auto type = wtxid ? inventory::type_id::wtxid :
+        inventory::type_id::transaction;
+
+    entry item{};
+    while (items.size() < max_inventory && cursor_->next(item))
+    {
+        const auto& hash = wtxid ? item.witness_hash : item.hash;
+        if (include(item, hash))
+            items.push_back({ type, hash });
+    }
+
+    // An exhausted cursor sends its final (partial) page, if any.
+    if (items.size() < max_inventory)
+        cursor_.reset();
+
+    if (items.empty())
+        return;
+
+    SEND1(inventory{ std::move(items) }, handle_send_page, _1);
+}
+
+void protocol_memory_pool_60002::handle_send_page(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_memory_pool_60002");
+
+    if (stopped(ec) || !cursor_)
+        return;
+
+    // Resume upon drain of the send backlog to the low water mark.
+    if (congested())
+    {
+        waiting_ = true;
+        return;
+    }
+
+    send_page();
+}
+
+void protocol_memory_pool_60002::handle_congestion(const code& ec,
+    bool congested) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_memory_pool_60002");
+
+    if (stopped(ec) || congested || !waiting_)
+        return;
+
+    waiting_ = false;
+    send_page();
+}
+
+// private
+bool protocol_memory_pool_60002::include(const entry& item,
+    const hash_digest& hash) NOEXCEPT
+{
+    if (item.fee_rate < fee_filter() || is_known(hash))
+        return false;
+
+    if (!bloom_ || !bloom_->filtered())
+        return true;
+
+    return item.tx && bloom_->match(*item.tx);
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -39,7 +39,7 @@ protocol_ping_31402::protocol_ping_31402(session& session,
     const channel::ptr& channel) NOEXCEPT
   : protocol(session, channel),
     timer_(std::make_shared<deadline>(session.log, channel->strand(),
-        session.settings().channel_heartbeat())),
+        session.resources().timers(), channel->settings().channel_heartbeat())),
     tracker<protocol_ping_31402>(session.log)
 {
 }
@@ -82,7 +82,9 @@ void protocol_ping_31402::handle_send_ping(const code& ec) NOEXCEPT
     if (stopped(ec))
         return;
 
-    timer_->start(BIND1(handle_timer, _1));
+    // Each interval is staggered, so that channels do not ping together.
+    timer_->start(BIND1(handle_timer, _1),
+        settings().staggered(settings().channel_heartbeat()));
     protocol::handle_send(ec);
 }
 
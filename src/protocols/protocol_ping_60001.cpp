@@ -18,6 +18,7 @@
  */
 #include <bitcoin/network/protocols/protocol_ping_60001.hpp>
 
+#include <chrono>
 #include <functional>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
@@ -79,6 +80,7 @@ void protocol_ping_60001::send_ping() NOEXCEPT
 
     // The ping/pong nonce is arbitrary and distinct from the channel nonce.
     nonce_ = pseudo_random::next<uint64_t>(add1(minimum_nonce), bc::max_int64);
+    sent_ = logger::now();
     SEND1(ping{ nonce_ }, handle_send, _1);
 }
 
@@ -109,7 +111,11 @@ bool protocol_ping_60001::handle_receive_pong(const code& ec,
         return false;
     }
 
-    // Correct pong nonce, set sentinel.
+    // Correct pong nonce, record round trip and set sentinel.
+    using namespace std::chrono;
+    const auto elapsed = duration_cast<nanoseconds>(logger::now() - sent_);
+    set_round_trip(possible_narrow_sign_cast<uint64_t>(elapsed.count()));
+    span(events::ping_round_trip, sent_);
     nonce_ = received;
     return true;
 }
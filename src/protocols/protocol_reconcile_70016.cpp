@@ -0,0 +1,397 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_reconcile_70016.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_reconcile_70016
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+// The set is bounded, as is the sketch (and so the decodable difference).
+constexpr size_t maximum_set = 3'000;
+
+// bip330: q is the fixed point (2^15-1) estimate of the relative difference.
+constexpr uint16_t coefficient = 8'191;
+constexpr uint64_t coefficient_precision = 32'767;
+
+// Bind throws (ok).
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+protocol_reconcile_70016::protocol_reconcile_70016(session& session,
+    const channel::ptr& channel) NOEXCEPT
+  : protocol(session, channel),
+    initiator_(!channel->inbound()),
+    flood_percent_(channel->settings().reconciliation_flood_percent),
+    timer_(std::make_shared<deadline>(session.log, channel->strand(),
+        session.resources().timers(),
+        channel->settings().channel_reconciliation())),
+    tracker<protocol_reconcile_70016>(session.log)
+{
+}
+
+// Start/stop.
+// ----------------------------------------------------------------------------
+
+void protocol_reconcile_70016::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (started())
+        return;
+
+    if (initiator_)
+    {
+        SUBSCRIBE_CHANNEL2(reconciliation_sketch, handle_receive_sketch,
+            _1, _2);
+        timer_->start(BIND1(handle_timer, _1));
+    }
+    else
+    {
+        SUBSCRIBE_CHANNEL2(request_reconciliation, handle_receive_request,
+            _1, _2);
+        SUBSCRIBE_CHANNEL2(request_sketch_extension,
+            handle_receive_extension, _1, _2);
+        SUBSCRIBE_CHANNEL2(reconciliation_difference,
+            handle_receive_difference, _1, _2);
+    }
+
+    SUBSCRIBE_BROADCAST3(transaction, handle_broadcast_transaction, _1, _2, _3);
+    protocol::start();
+}
+
+void protocol_reconcile_70016::stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+    timer_->stop();
+}
+
+// Set.
+// ----------------------------------------------------------------------------
+
+// Only outbound peers are flooded, as inbound peers reconcile with us.
+void protocol_reconcile_70016::add(const hash_digest& wtxid) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    constexpr auto percent = 100u;
+    const auto id = send_reconciliation::to_short_id(reconciliation_key(),
+        wtxid);
+
+    if ((initiator_ && (id % percent) < flood_percent_) ||
+        set_.size() >= maximum_set)
+    {
+        announce({ inventory_item::type_id::wtxid, wtxid });
+        return;
+    }
+
+    set_.emplace(id, wtxid);
+}
+
+void protocol_reconcile_70016::flood(const set& items) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    for (const auto& item: items)
+        announce({ inventory_item::type_id::wtxid, item.second });
+}
+
+// static
+pin_sketch protocol_reconcile_70016::to_sketch(const set& items,
+    size_t capacity) NOEXCEPT
+{
+    pin_sketch sketch(capacity);
+    for (const auto& item: items)
+        sketch.add(item.first);
+
+    return sketch;
+}
+
+bool protocol_reconcile_70016::handle_broadcast_transaction(const code& ec,
+    const transaction::cptr& message, uint64_t sender) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (stopped(ec))
+        return false;
+
+    // Transactions are not relayed to the peer that provided them.
+    if (sender == identifier())
+        return true;
+
+    const auto wtxid = message->transaction_ptr->hash(true);
+    if (!is_known(wtxid))
+        add(wtxid);
+
+    return true;
+}
+
+// Initiator (request => sketch => difference).
+// ----------------------------------------------------------------------------
+
+void protocol_reconcile_70016::handle_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (stopped())
+        return;
+
+    // error::operation_canceled implies stopped, so this is something else.
+    if (ec)
+    {
+        stop(ec);
+        return;
+    }
+
+    // The prior round is awaiting a sketch.
+    if (!pending_)
+    {
+        // Transactions added during the round are reconciled in the next.
+        snapshot_ = std::move(set_);
+        set_.clear();
+        pending_ = true;
+
+        const auto size = std::min(snapshot_.size(), size_t{ max_uint16 });
+        SEND1((request_reconciliation{ possible_narrow_cast<uint16_t>(size),
+            coefficient }), handle_send, _1);
+    }
+
+    timer_->start(BIND1(handle_timer, _1));
+}
+
+bool protocol_reconcile_70016::handle_receive_sketch(const code& ec,
+    const reconciliation_sketch::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (stopped(ec))
+        return false;
+
+    if (!pending_)
+    {
+        LOGR("Unrequested reconciliation sketch from [" << authority() << "].");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    // An extension is the higher power sums of the initial sketch's set.
+    if (extended_)
+    {
+        pending_ = false;
+        extended_ = false;
+        initial_.insert(initial_.end(), message->sketch.begin(),
+            message->sketch.end());
+
+        // Power sums above the limit are ignored, bounding the difference.
+        initial_.resize(std::min(initial_.size(),
+            pin_sketch::serialized_size(max_sketch_capacity)));
+
+        if (!reconcile(pin_sketch{ initial_ }))
+            fail();
+
+        initial_.clear();
+        return true;
+    }
+
+    // An empty sketch implies that the peer has no set (nothing to ask).
+    const pin_sketch remote(message->sketch);
+    if (is_zero(remote.capacity()))
+    {
+        pending_ = false;
+        fail();
+        return true;
+    }
+
+    if (reconcile(remote))
+    {
+        pending_ = false;
+        return true;
+    }
+
+    // bip330: upon decode failure the sketch is extended (once) to double its
+    // capacity, unless that would exceed the sketch (and difference) limit.
+    if (remote.capacity() < max_sketch_capacity)
+    {
+        extended_ = true;
+        initial_ = message->sketch;
+        SEND1(request_sketch_extension{}, handle_send, _1);
+        return true;
+    }
+
+    pending_ = false;
+    fail();
+    return true;
+}
+
+// Elements of the difference not of the snapshot are of the peer's set, so
+// are requested, and the others are announced.
+bool protocol_reconcile_70016::reconcile(const pin_sketch& remote) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    pin_sketch::elements difference{};
+    auto local = to_sketch(snapshot_, remote.capacity());
+    local.merge(remote);
+    if (!local.decode(difference))
+        return false;
+
+    std::vector<uint32_t> asks{};
+    for (const auto id: difference)
+    {
+        const auto it = snapshot_.find(id);
+        if (it == snapshot_.end())
+            asks.push_back(id);
+        else
+            announce({ inventory_item::type_id::wtxid, it->second });
+    }
+
+    SEND1((reconciliation_difference{ true, std::move(asks) }), handle_send,
+        _1);
+    snapshot_.clear();
+    return true;
+}
+
+void protocol_reconcile_70016::fail() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    SEND1((reconciliation_difference{ false, {} }), handle_send, _1);
+    flood(snapshot_);
+    snapshot_.clear();
+}
+
+// Responder (request => sketch => difference).
+// ----------------------------------------------------------------------------
+
+bool protocol_reconcile_70016::handle_receive_request(const code& ec,
+    const request_reconciliation::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (stopped(ec))
+        return false;
+
+    if (pending_)
+    {
+        LOGR("Overlapping reconciliation request from [" << authority()
+            << "].");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    snapshot_ = std::move(set_);
+    set_.clear();
+    pending_ = true;
+    extended_ = false;
+
+    // bip330: capacity is |local - remote| + q * min(local, remote) + 1.
+    const uint64_t remote = message->set_size;
+    const uint64_t local = snapshot_.size();
+    const auto estimate = add1((std::max(local, remote) -
+        std::min(local, remote)) + (message->coefficient *
+            std::min(local, remote)) / coefficient_precision);
+
+    capacity_ = possible_narrow_cast<size_t>(std::min(estimate,
+        uint64_t{ max_sketch_capacity }));
+
+    const auto sketch = to_sketch(snapshot_, capacity_);
+    SEND1((reconciliation_sketch{ sketch.serialize() }), handle_send, _1);
+    return true;
+}
+
+bool protocol_reconcile_70016::handle_receive_extension(const code& ec,
+    const request_sketch_extension::cptr&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (stopped(ec))
+        return false;
+
+    if (!pending_ || extended_)
+    {
+        LOGR("Unrequested sketch extension from [" << authority() << "].");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    // The extension is the power sums above the sent capacity, bounded so
+    // that the extended sketch does not exceed the sketch limit.
+    extended_ = true;
+    const auto extra = std::min(capacity_, max_sketch_capacity - capacity_);
+    const auto sketch = to_sketch(snapshot_, capacity_ + extra).serialize();
+    const data_chunk extension(std::next(sketch.begin(),
+        pin_sketch::serialized_size(capacity_)), sketch.end());
+
+    SEND1(reconciliation_sketch{ extension }, handle_send, _1);
+    return true;
+}
+
+bool protocol_reconcile_70016::handle_receive_difference(const code& ec,
+    const reconciliation_difference::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_reconcile_70016");
+
+    if (stopped(ec))
+        return false;
+
+    if (!pending_)
+    {
+        LOGR("Unrequested reconciliation difference from [" << authority()
+            << "].");
+        stop(error::protocol_violation);
+        return false;
+    }
+
+    pending_ = false;
+    extended_ = false;
+
+    if (!message->success)
+    {
+        flood(snapshot_);
+        snapshot_.clear();
+        return true;
+    }
+
+    // Unknown short ids are ignored (such as a decode collision).
+    for (const auto id: message->short_ids)
+        if (const auto it = snapshot_.find(id); it != snapshot_.end())
+            announce({ inventory_item::type_id::wtxid, it->second });
+
+    snapshot_.clear();
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
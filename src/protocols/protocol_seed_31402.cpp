@@ -20,6 +20,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/define.hpp>
 #include <bitcoin/network/log/log.hpp>
@@ -44,7 +47,7 @@ protocol_seed_31402::protocol_seed_31402(session& session,
     const channel::ptr& channel) NOEXCEPT
   : protocol(session, channel),
     timer_(std::make_shared<deadline>(session.log, channel->strand(),
-        session.settings().channel_germination())),
+        channel->settings().channel_germination())),
     tracker<protocol_seed_31402>(session.log)
 {
 }
@@ -129,21 +132,26 @@ address::cptr protocol_seed_31402::filter(
     // Returns zero if minimum > maximum.
     const size_t select = pseudo_random::next(minimum, maximum);
 
+    const auto message = to_shared<address>();
     if (is_zero(select))
-        return to_shared<address>();
+        return message;
 
-    // CLang doesn't like emplacement with default constructors, so use new.
-    BC_PUSH_WARNING(NO_NEW_OR_DELETE)
-    const auto message = std::shared_ptr<address>(new address{ items });
-    BC_POP_WARNING()
+    // Partially shuffle an index permutation, so that only the selected items
+    // are visited and only the unexcluded of those are copied.
+    std::vector<size_t> order(items.size());
+    std::iota(order.begin(), order.end(), zero);
+    message->addresses.reserve(select);
 
-    // Shuffle, reduce, and filter to the target amount.
-    pseudo_random::shuffle(message->addresses);
-    message->addresses.resize(select);
-    std::erase_if(message->addresses, [&](const auto& address) NOEXCEPT
+    const auto last = sub1(order.size());
+    for (auto index = zero; index < select; ++index)
     {
-        return settings().excluded(address);
-    });
+        std::swap(order.at(index),
+            order.at(pseudo_random::next(index, last)));
+
+        const auto& item = items.at(order.at(index));
+        if (!settings().excluded(item))
+            message->addresses.push_back(item);
+    }
 
     return message;
 }
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/protocols/protocol_send_headers_70012.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/define.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/messages/messages.hpp>
+#include <bitcoin/network/net/net.hpp>
+#include <bitcoin/network/protocols/protocol.hpp>
+#include <bitcoin/network/sessions/sessions.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS protocol_send_headers_70012
+
+using namespace system;
+using namespace messages;
+using namespace std::placeholders;
+
+// Bind throws (ok).
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+protocol_send_headers_70012::protocol_send_headers_70012(session& session,
+    const channel::ptr& channel) NOEXCEPT
+  : protocol(session, channel),
+    tracker<protocol_send_headers_70012>(session.log)
+{
+}
+
+// Start.
+// ----------------------------------------------------------------------------
+
+void protocol_send_headers_70012::start() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_send_headers_70012");
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL2(send_headers, handle_receive_send_headers, _1, _2);
+    SUBSCRIBE_BROADCAST3(headers, handle_broadcast_headers, _1, _2, _3);
+    protocol::start();
+}
+
+bool protocol_send_headers_70012::peer_send_headers() const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_send_headers_70012");
+    return peer_send_headers_;
+}
+
+// Inbound (record preference).
+// ----------------------------------------------------------------------------
+
+// The preference cannot be withdrawn (repeats are redundant).
+bool protocol_send_headers_70012::handle_receive_send_headers(const code& ec,
+    const send_headers::cptr&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_send_headers_70012");
+
+    if (stopped(ec))
+        return false;
+
+    LOGP("Headers announcement requested by [" << authority() << "].");
+    peer_send_headers_ = true;
+    return true;
+}
+
+// Outbound (announce tips).
+// ----------------------------------------------------------------------------
+
+bool protocol_send_headers_70012::handle_broadcast_headers(const code& ec,
+    const headers::cptr& message, uint64_t sender) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_send_headers_70012");
+
+    if (stopped(ec))
+        return false;
+
+    // Headers are not announced to the peer that provided them.
+    if (sender == identifier() || message->header_ptrs.empty())
+        return true;
+
+    // A tip known to the peer implies that its ancestors are known.
+    const auto tip = message->header_ptrs.back()->hash();
+    if (is_known(tip))
+        return true;
+
+    if (!peer_send_headers_)
+    {
+        for (const auto& header: message->header_ptrs)
+            announce({ inventory_item::type_id::block, header->hash() });
+
+        return true;
+    }
+
+    for (const auto& header: message->header_ptrs)
+        set_known(header->hash());
+
+    // The broadcast encoding is shared with all channels (see protocol::send).
+    SEND1(*message, handle_send, _1);
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
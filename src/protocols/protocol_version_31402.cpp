@@ -44,8 +44,8 @@ using namespace std::placeholders;
 protocol_version_31402::protocol_version_31402(session& session,
     const channel::ptr& channel) NOEXCEPT
   : protocol_version_31402(session, channel,
-      session.settings().services_minimum,
-      session.settings().services_maximum)
+      channel->settings().services_minimum,
+      channel->settings().services_maximum)
 {
 }
 
@@ -55,13 +55,14 @@ protocol_version_31402::protocol_version_31402(session& session,
     uint64_t maximum_services) NOEXCEPT
   : protocol(session, channel),
     inbound_(channel->inbound()),
-    minimum_version_(session.settings().protocol_minimum),
-    maximum_version_(session.settings().protocol_maximum),
+    minimum_version_(channel->settings().protocol_minimum),
+    maximum_version_(channel->settings().protocol_maximum),
     minimum_services_(minimum_services),
     maximum_services_(maximum_services),
-    invalid_services_(session.settings().invalid_services),
+    invalid_services_(channel->settings().invalid_services),
     timer_(std::make_shared<deadline>(session.log, channel->strand(),
-        session.settings().channel_handshake())),
+        channel->settings().channel_handshake(
+            session.resources().handshakes()))),
     tracker<protocol_version_31402>(session.log)
 {
 }
@@ -77,10 +78,14 @@ messages::version protocol_version_31402::version_factory(
 {
     const auto timestamp = unix_time();
 
+    // Compression is advertised in the version only (not as an address).
+    const auto services = settings().peer_compression ?
+        maximum_services_ | service::node_compression : maximum_services_;
+
     return
     {
         maximum_version_,
-        maximum_services_,
+        services,
         timestamp,
 
         // ********************************************************************
@@ -168,6 +173,9 @@ void protocol_version_31402::shake(result_handler&& handler) NOEXCEPT
 
     SUBSCRIBE_CHANNEL2(version, handle_receive_version, _1, _2);
     SUBSCRIBE_CHANNEL2(version_acknowledge, handle_receive_acknowledge, _1, _2);
+    SUBSCRIBE_CHANNEL2(wtxid_relay, handle_receive_wtxid_relay, _1, _2);
+    SUBSCRIBE_CHANNEL2(send_reconciliation, handle_receive_send_reconciliation,
+        _1, _2);
     SEND1(version_factory(), handle_send_version, _1);
 
     protocol::start();
@@ -198,6 +206,10 @@ void protocol_version_31402::callback(const code& ec) NOEXCEPT
     if (!handler_)
         return;
 
+    // Handshake durations are observed only if timeouts are adaptive.
+    if (!ec && !is_zero(settings().timeout_minimum_milliseconds))
+        resources().handshakes().sample(steady_clock::now() - started_);
+
     // There may be a post-handshake message already waiting on the socket.
     // The channel must be paused while still on the channel strand to prevent
     // acceptance until after protocol attachment (and resume). So session will
@@ -236,6 +248,7 @@ void protocol_version_31402::handle_send_version(const code& ec) NOEXCEPT
         return;
 
     timer_->start(BIND1(handle_timer, _1));
+    started_ = steady_clock::now();
     sent_version_ = true;
 
     if (complete())
@@ -259,6 +272,11 @@ bool protocol_version_31402::handle_receive_acknowledge(const code& ec,
 
     received_acknowledge_ = true;
 
+    // BIP330 reconciliation requires that both sides also relay by wtxid.
+    if (sent_reconciliation_ && received_reconciliation_ && wtxid_relay())
+        set_reconciliation(send_reconciliation::to_key(local_salt_,
+            remote_salt_));
+
     // Ensure that no message is read after two required.
     // The reader is suspended within this handler by the strand.
     if (received_version_)
@@ -324,6 +342,15 @@ bool protocol_version_31402::handle_receive_version(const code& ec,
     set_negotiated_version(version);
     set_peer_version(message);
 
+    // Envelopes are exchanged only with peered authorities advertising
+    // compression, as expansion costs the receiver (otherwise ignored).
+    if (settings().peer_compression &&
+        to_bool(message->services & service::node_compression) &&
+        settings().peered(authority().to_address_item()))
+    {
+        set_compression(true, true);
+    }
+
     ////LOGP("Negotiated protocol version (" << version << ") "
     ////    << "for [" << authority() << "].");
 
@@ -332,9 +359,23 @@ bool protocol_version_31402::handle_receive_version(const code& ec,
     ////    << "as {" << config::authority(message->address_sender) << "} "
     ////    << "us {" << config::authority(message->address_receiver) << "}.");
 
-    SEND1(version_acknowledge{}, handle_send_acknowledge, _1);
+    // BIP339 wtxid_relay must be sent between version and verack.
+    if (settings().enable_wtxid_relay && version >= level::bip339)
+    {
+        SEND1(wtxid_relay{}, handle_send_acknowledge, _1);
+        sent_wtxid_relay_ = true;
+    }
+
+    // BIP330 send_reconciliation must also be sent between version and verack.
+    if (settings().enable_reconciliation && sent_wtxid_relay_)
+    {
+        local_salt_ = pseudo_random::next<uint64_t>();
+        SEND1((send_reconciliation{ send_reconciliation::reconciliation_version,
+            local_salt_ }), handle_send_acknowledge, _1);
+        sent_reconciliation_ = true;
+    }
 
-    // Handle in handle_send_acknowledge.
+    SEND1(version_acknowledge{}, handle_send_acknowledge, _1);
     received_version_ = true;
 
     // Ensure that no message is read after two required.
@@ -342,18 +383,76 @@ bool protocol_version_31402::handle_receive_version(const code& ec,
     if (received_acknowledge_)
         pause();
 
+    // Writes are ordered, so the handshake completes with verack queued, and
+    // post-handshake messages are written behind it without awaiting its send.
+    if (complete())
+        callback(error::success);
+
     return true;
 }
 
-void protocol_version_31402::handle_send_acknowledge(const code& ec) NOEXCEPT
+// Incoming [receive_wtxid_relay].
+// ----------------------------------------------------------------------------
+
+// Transactions are announced to the peer by wtxid if both sides sent it. The
+// peer's wtxid_relay precedes its verack, and the verack arrival stops reads
+// until protocol attachment, so relay mode is set before relay protocols.
+bool protocol_version_31402::handle_receive_wtxid_relay(const code& ec,
+    const wtxid_relay::cptr&) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "protocol_version_31402");
 
     if (stopped(ec))
-        return;
+        return false;
 
-    if (complete())
-        callback(error::success);
+    // Disallowed before version or after verack (persists for channel life).
+    if (!received_version_ || received_acknowledge_)
+    {
+        rejection(error::protocol_violation);
+        return false;
+    }
+
+    if (sent_wtxid_relay_)
+        set_wtxid_relay(true);
+
+    return true;
+}
+
+// Incoming [receive_send_reconciliation].
+// ----------------------------------------------------------------------------
+
+// Salts are combined upon verack, by which time the peer's wtxid_relay (also
+// required for reconciliation) has been received if it was sent.
+bool protocol_version_31402::handle_receive_send_reconciliation(const code& ec,
+    const send_reconciliation::cptr& message) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_version_31402");
+
+    if (stopped(ec))
+        return false;
+
+    // Disallowed before version or after verack (persists for channel life).
+    if (!received_version_ || received_acknowledge_ || received_reconciliation_)
+    {
+        rejection(error::protocol_violation);
+        return false;
+    }
+
+    // Reconciliation versions below our own are not supported.
+    constexpr auto minimum = send_reconciliation::reconciliation_version;
+    if (message->protocol_version >= minimum)
+    {
+        remote_salt_ = message->salt;
+        received_reconciliation_ = true;
+    }
+
+    return true;
+}
+
+// Send failure stops the channel, which terminates an incomplete handshake.
+void protocol_version_31402::handle_send_acknowledge(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "protocol_version_31402");
 }
 
 BC_POP_WARNING()
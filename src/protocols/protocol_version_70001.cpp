@@ -38,9 +38,9 @@ using namespace bc::network::messages;
 protocol_version_70001::protocol_version_70001(session& session,
     const channel::ptr& channel) NOEXCEPT
   : protocol_version_70001(session, channel,
-        session.settings().services_minimum,
-        session.settings().services_maximum,
-        session.settings().enable_transaction)
+        channel->settings().services_minimum,
+        channel->settings().services_maximum,
+        channel->settings().enable_transaction && !channel->block_relay())
 {
 }
 
@@ -42,9 +42,9 @@ static const std::string insufficient_services = "insufficient-services";
 protocol_version_70002::protocol_version_70002(session& session,
     const channel::ptr& channel) NOEXCEPT
   : protocol_version_70002(session, channel,
-        session.settings().services_minimum,
-        session.settings().services_maximum,
-        session.settings().enable_transaction)
+        channel->settings().services_minimum,
+        channel->settings().services_maximum,
+        channel->settings().enable_transaction && !channel->block_relay())
 {
 }
 
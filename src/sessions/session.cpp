@@ -18,6 +18,7 @@
  */
 #include <bitcoin/network/sessions/session.hpp>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -52,17 +53,23 @@ session::session(p2p& network, uint64_t identifier) NOEXCEPT
     stop_subscriber_(network.strand()),
     reporter(network.log)
 {
+    network_.sessions_.fetch_add(one);
 }
 
 session::~session() NOEXCEPT
 {
     BC_ASSERT_MSG(stopped(), "The session was not stopped.");
     if (!stopped()) { LOGF("~session is not stopped."); }
+
+    // Releases a shared network close waiting on its sessions.
+    if (is_one(network_.sessions_.fetch_sub(one)))
+        network_.sessions_.notify_all();
 }
 
 void session::start(result_handler&& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(network_.stranded(), "strand");
+    PROBE(session_start);
 
     if (!stopped())
     {
@@ -117,18 +124,19 @@ void session::start_channel(const channel::ptr& channel,
 
     // Pend channel for connection duration (for quick stop).
     pend(channel);
-
-    result_handler start =
-        BIND4(handle_channel_start, _1, channel, std::move(starter),
-            std::move(stopper));
+    TRACE_BEGIN(channel, channel->identifier());
+    USDT2(channel_start, channel->identifier(), channel->inbound());
+    fire(channel->inbound() ? events::inbound_accept :
+        events::outbound_connect);
 
     result_handler shake =
-        BIND3(handle_handshake, _1, channel, std::move(start));
+        BIND4(handle_handshake, _1, channel, std::move(starter),
+            std::move(stopper));
 
-    // Switch to channel context.
+    // Switch to channel context, where the channel remains until attached.
     // Channel/network strands share same pool.
-    boost::asio::post(channel->strand(),
-        BIND2(do_attach_handshake, channel, std::move(shake)));
+    boost::asio::post(channel->strand(), channel_timed(
+        BIND2(do_attach_handshake, channel, std::move(shake))));
 }
 
 void session::do_attach_handshake(const channel::ptr& channel,
@@ -136,6 +144,7 @@ void session::do_attach_handshake(const channel::ptr& channel,
 {
     BC_ASSERT_MSG(channel->stranded(), "channel strand");
     BC_ASSERT_MSG(channel->paused(), "channel not paused for handshake attach");
+    TRACE_BEGIN(handshake, channel->identifier());
 
     attach_handshake(channel, move_copy(handshake));
 
@@ -151,9 +160,9 @@ void session::attach_handshake(const channel::ptr& channel,
 
     // Weak reference safe as sessions outlive protocols.
     auto& self = *this;
-    const auto maximum_version = settings().protocol_maximum;
+    const auto maximum_version = settings()->protocol_maximum;
     const auto extended_version = maximum_version >= messages::level::bip37;
-    const auto enable_reject = settings().enable_reject &&
+    const auto enable_reject = settings()->enable_reject &&
         maximum_version >= messages::level::bip61;
 
     // Protocol must pause the channel after receiving version and verack.
@@ -172,59 +181,51 @@ void session::attach_handshake(const channel::ptr& channel,
             ->shake(std::move(handler));
 }
 
+// Counting is thread safe, so a successful handshake is counted, subscribed
+// and attached without leaving the channel strand. Only failures, stop
+// notification and the started handler return to the network strand.
 void session::handle_handshake(const code& ec, const channel::ptr& channel,
-    const result_handler& start) NOEXCEPT
+    const result_handler& started, const result_handler& stopped) NOEXCEPT
 {
     BC_ASSERT_MSG(channel->stranded(), "channel strand");
-
-    // Return to network context.
-    boost::asio::post(network_.strand(),
-        BIND3(do_handle_handshake, ec, channel, start));
-}
-
-void session::do_handle_handshake(const code& ec, const channel::ptr& channel,
-    const result_handler& start) NOEXCEPT
-{
-    BC_ASSERT_MSG(network_.stranded(), "strand");
+    TRACE_END(handshake, channel->identifier());
 
     // Handles channel and protocol start failures.
-    if (ec)
+    const auto code = ec ? ec : network_.count_channel(*channel);
+    if (code)
     {
-        unpend(channel);
-        network_.unstore_nonce(*channel);
-        channel->stop(ec);
-        start(ec);
+        // Return to network context.
+        boost::asio::post(network_.strand(), network_timed(
+            BIND4(do_handle_handshake, code, channel, started, stopped)));
         return;
     }
 
-    if (const auto code = network_.count_channel(*channel))
-    {
-        unpend(channel);
-        network_.unstore_nonce(*channel);
-        channel->stop(code);
-        start(code);
-        return;
-    }
+    // Channel creation immediately precedes start, so uptime is handshake.
+    const auto elapsed = std::chrono::duration_cast<nanoseconds>(
+        channel->uptime());
+    fire(events::handshake, possible_narrow_sign_cast<size_t>(
+        elapsed.count()));
 
     // Requires uncount_channel/unstore_nonce on stop if and only if success.
-    start(ec);
+    // Subscription is dispatched, so completes here on the channel strand.
+    channel->subscribe_stop(
+        BIND3(handle_channel_stopped, _1, channel, stopped),
+        BIND3(handle_channel_started, _1, channel, started));
 }
 
-void session::handle_channel_start(const code& ec, const channel::ptr& channel,
+void session::do_handle_handshake(const code& ec, const channel::ptr& channel,
     const result_handler& started, const result_handler& stopped) NOEXCEPT
 {
     BC_ASSERT_MSG(network_.stranded(), "strand");
+    PROBE(session_handshake);
+    TRACE_END(channel, channel->identifier());
+    USDT2(channel_stop, channel->identifier(), ec.value());
 
-    if (ec)
-    {
-        started(ec);
-        stopped(ec);
-        return;
-    }
-
-    channel->subscribe_stop(
-        BIND3(handle_channel_stopped, _1, channel, stopped),
-        BIND3(handle_channel_started, _1, channel, started));
+    unpend(channel);
+    network_.unstore_nonce(*channel);
+    channel->stop(ec);
+    started(ec);
+    stopped(ec);
 }
 
 void session::handle_channel_started(const code& ec,
@@ -232,15 +233,24 @@ void session::handle_channel_started(const code& ec,
 {
     BC_ASSERT_MSG(channel->stranded() || network_.stranded(), "strand");
 
+    // Subscription completes on the channel strand, where protocols attach,
+    // so the network strand is bypassed. Failures return to network context.
+    if (!ec && channel->stranded())
+    {
+        do_attach_protocols(channel, started);
+        return;
+    }
+
     // Return to network context.
-    boost::asio::post(network_.strand(),
-        BIND3(do_handle_channel_started, ec, channel, started));
+    boost::asio::post(network_.strand(), network_timed(
+        BIND3(do_handle_channel_started, ec, channel, started)));
 }
 
 void session::do_handle_channel_started(const code& ec,
     const channel::ptr& channel, const result_handler& started) NOEXCEPT
 {
     BC_ASSERT_MSG(network_.stranded(), "strand");
+    PROBE(session_channel_started);
 
     // Handles channel subscribe_stop code.
     if (ec)
@@ -250,8 +260,8 @@ void session::do_handle_channel_started(const code& ec,
     }
 
     // Switch to channel context (started is invoked on network strand).
-    boost::asio::post(channel->strand(),
-        BIND2(do_attach_protocols, channel, started));
+    boost::asio::post(channel->strand(), channel_timed(
+        BIND2(do_attach_protocols, channel, started)));
 }
 
 void session::do_attach_protocols(const channel::ptr& channel,
@@ -260,19 +270,25 @@ void session::do_attach_protocols(const channel::ptr& channel,
     BC_ASSERT_MSG(channel->stranded(), "channel strand");
     BC_ASSERT_MSG(channel->paused(), "channel not paused for protocol attach");
 
-    // Protocol attach is always synchronous, complete here.
-    attach_protocols(channel);
+    // Standby channels remain paused, attached and resumed upon promotion.
+    if (!standby(channel))
+    {
+        TRACE_SCOPE(protocols, channel->identifier());
 
-    // Notify channel subscribers of fully-attached non-seed channel.
-    if (!channel->quiet())
-        network_.notify_connect(channel);
+        // Protocol attach is always synchronous, complete here.
+        attach_protocols(channel);
 
-    // Resume accepting messages on the channel, timers restarted.
-    channel->resume();
+        // Notify channel subscribers of fully-attached non-seed channel.
+        if (!channel->quiet())
+            network_.notify_connect(channel);
+
+        // Resume accepting messages on the channel, timers restarted.
+        channel->resume();
+    }
 
     // Complete on network strand.
-    boost::asio::post(network_.strand(),
-        std::bind(started, error::success));
+    boost::asio::post(network_.strand(), network_timed(
+        std::bind(started, error::success)));
 }
 
 // Override in derived sessions to attach protocols.
@@ -283,12 +299,19 @@ void session::attach_protocols(const channel::ptr& channel) NOEXCEPT
 
     // Weak reference safe as sessions outlive protocols.
     auto& self = *this;
-    const auto enable_alert = settings().enable_alert;
-    const auto enable_address = settings().enable_address;
+    const auto block_relay = channel->block_relay();
+    const auto enable_alert = settings()->enable_alert;
+    const auto enable_address = settings()->enable_address && !block_relay;
     const auto negotiated_version = channel->negotiated_version();
     const auto enable_pong = negotiated_version >= messages::level::bip31;
-    const auto enable_reject = settings().enable_reject &&
+    const auto enable_reject = settings()->enable_reject &&
         negotiated_version >= messages::level::bip61;
+    const auto enable_fee_filter = settings()->enable_transaction &&
+        !block_relay && negotiated_version >= messages::level::bip133;
+    const auto enable_send_headers = settings()->enable_send_headers &&
+        negotiated_version >= messages::level::bip130;
+    const auto enable_reconciliation = settings()->enable_reconciliation &&
+        !block_relay && channel->reconciliation();
 
     if (enable_pong)
         channel->attach<protocol_ping_60001>(self)->start();
@@ -303,21 +326,61 @@ void session::attach_protocols(const channel::ptr& channel) NOEXCEPT
     if (enable_reject)
         channel->attach<protocol_reject_70002>(self)->start();
 
+    if (enable_fee_filter)
+        channel->attach<protocol_fee_filter_70013>(self)->start();
+
+    if (enable_send_headers)
+        channel->attach<protocol_send_headers_70012>(self)->start();
+
+    if (enable_reconciliation)
+        channel->attach<protocol_reconcile_70016>(self)->start();
+
     if (enable_address)
     {
-        channel->attach<protocol_address_in_31402>(self)->start();
-        channel->attach<protocol_address_out_31402>(self)->start();
+        const auto [in, out] = channel->attach_all<protocol_address_in_31402,
+            protocol_address_out_31402>(self);
+
+        in->start();
+        out->start();
     }
 }
 
+bool session::standby(const channel::ptr&) const NOEXCEPT
+{
+    return false;
+}
+
+void session::promote(const channel::ptr& channel) NOEXCEPT
+{
+    boost::asio::post(channel->strand(), channel_timed(
+        BIND1(do_promote, channel)));
+}
+
+void session::do_promote(const channel::ptr& channel) NOEXCEPT
+{
+    BC_ASSERT_MSG(channel->stranded(), "channel strand");
+
+    BC_ASSERT_MSG(channel->paused(), "channel not paused for protocol attach");
+
+    if (channel->stopped())
+        return;
+
+    attach_protocols(channel);
+
+    if (!channel->quiet())
+        network_.notify_connect(channel);
+
+    channel->resume();
+}
+
 void session::handle_channel_stopped(const code& ec,
     const channel::ptr& channel, const result_handler& stopped) NOEXCEPT
 {
     BC_ASSERT_MSG(channel->stranded() || network_.stranded(), "strand");
 
     // Return to network context.
-    boost::asio::post(network_.strand(),
-        BIND3(do_handle_channel_stopped, ec, channel, stopped));
+    boost::asio::post(network_.strand(), network_timed(
+        BIND3(do_handle_channel_stopped, ec, channel, stopped)));
 }
 
 // Unnonce in stop vs. handshake to avoid loopback race (in/out same strand).
@@ -325,11 +388,16 @@ void session::do_handle_channel_stopped(const code& ec,
     const channel::ptr& channel, const result_handler& stopped) NOEXCEPT
 {
     BC_ASSERT_MSG(network_.stranded(), "strand");
+    PROBE(session_channel_stopped);
+    TRACE_END(channel, channel->identifier());
+    USDT2(channel_stop, channel->identifier(), ec.value());
 
     unpend(channel);
     network_.unstore_nonce(*channel);
     network_.uncount_channel(*channel);
+    network_.misbehaved(*channel, ec);
     unsubscribe(channel->identifier());
+    fire(events::channel_stop, possible_narrow_sign_cast<size_t>(ec.value()));
 
     // Assume stop notification, but may be subscribe failure (idempotent).
     // Handles stop reason code, stop subscribe failure or stop notification.
@@ -342,7 +410,7 @@ void session::do_handle_channel_stopped(const code& ec,
 void session::defer(result_handler&& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(network_.stranded(), "strand");
-    defer(settings().retry_timeout(), std::move(handler));
+    defer(settings()->retry_timeout(), std::move(handler));
 }
 
 void session::defer(const steady_clock::duration& timeout,
@@ -357,7 +425,8 @@ void session::defer(const steady_clock::duration& timeout,
     }
 
     const auto key = create_key();
-    const auto timer = std::make_shared<deadline>(log, network_.strand());
+    const auto timer = std::make_shared<deadline>(log, network_.strand(),
+        resources().timers());
 
     timer->start(
         BIND3(handle_timer, _1, key, std::move(handler)), timeout);
@@ -430,6 +499,11 @@ acceptor::ptr session::create_acceptor() NOEXCEPT
     return network_.create_acceptor();
 }
 
+acceptors session::create_acceptors() NOEXCEPT
+{
+    return network_.create_acceptors();
+}
+
 connector::ptr session::create_connector() NOEXCEPT
 {
     return network_.create_connector();
@@ -447,7 +521,8 @@ channel::ptr session::create_channel(const socket::ptr& socket,
 
     // Channel id must be created using create_key().
     const auto id = create_key();
-    return std::make_shared<channel>(log, socket, settings(), id, quiet);
+    return std::allocate_shared<channel>(channel::allocator{}, log, socket,
+        *settings(), network_.resources(), id, quiet);
 }
 
 // At one object/session/ns, this overflows in ~585 years (and handled).
@@ -482,6 +557,11 @@ size_t session::address_count() const NOEXCEPT
     return network_.address_count();
 }
 
+uint64_t session::network_group(const messages::ip_address& ip) const NOEXCEPT
+{
+    return network_.network_group(ip);
+}
+
 size_t session::channel_count() const NOEXCEPT
 {
     return network_.channel_count();
@@ -497,16 +577,46 @@ size_t session::outbound_channel_count() const NOEXCEPT
     return floored_subtract(channel_count(), inbound_channel_count());
 }
 
-const network::settings& session::settings() const NOEXCEPT
+bool session::banned(const messages::address_item& item) const NOEXCEPT
+{
+    return network_.banned(item);
+}
+
+bool session::take_anchor(address_item_cptr& out) const NOEXCEPT
+{
+    return network_.take_anchor(out);
+}
+
+void session::record_anchor(const channel& channel) const NOEXCEPT
+{
+    network_.record_anchor(channel);
+}
+
+network::settings::cptr session::settings() const NOEXCEPT
 {
     return network_.network_settings();
 }
 
+asio::io_context& session::compute() NOEXCEPT
+{
+    return network_.compute();
+}
+
+network::resources& session::resources() const NOEXCEPT
+{
+    return *network_.resources();
+}
+
 uint64_t session::identifier() const NOEXCEPT
 {
     return identifier_;
 }
 
+uint64_t session::required_services() const NOEXCEPT
+{
+    return settings()->services_minimum;
+}
+
 // Utilities.
 // ----------------------------------------------------------------------------
 // stackoverflow.com/questions/57411283/
@@ -514,10 +624,15 @@ uint64_t session::identifier() const NOEXCEPT
 
 void session::take(address_item_handler&& handler) const NOEXCEPT
 {
-    network_.take(std::move(handler));
+    network_.take(required_services(), std::move(handler));
+}
+
+void session::take_new(address_item_handler&& handler) const NOEXCEPT
+{
+    network_.take_new(std::move(handler));
 }
 
-void session::fetch(address_handler&& handler) const NOEXCEPT
+void session::fetch(fetch_handler&& handler) const NOEXCEPT
 {
     network_.fetch(std::move(handler));
 }
@@ -528,6 +643,13 @@ void session::restore(const address_item_cptr& address,
     network_.restore(address, std::move(handler));
 }
 
+void session::restore(const address_item_cptr& address, const code& ec,
+    const steady_clock::duration& latency,
+    result_handler&& handler) const NOEXCEPT
+{
+    network_.restore(address, ec, latency, std::move(handler));
+}
+
 void session::save(const address_cptr& message,
     count_handler&& handler) const NOEXCEPT
 {
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/network/sessions/session_feeler.hpp>
+
+#include <functional>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/network/async/async.hpp>
+#include <bitcoin/network/config/config.hpp>
+#include <bitcoin/network/log/log.hpp>
+#include <bitcoin/network/p2p.hpp>
+#include <bitcoin/network/sessions/session.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+#define CLASS session_feeler
+
+using namespace system;
+using namespace config;
+using namespace std::placeholders;
+
+// Bind throws (ok).
+// Shared pointers required in handler parameters so closures control lifetime.
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
+session_feeler::session_feeler(p2p& network, uint64_t identifier) NOEXCEPT
+  : session(network, identifier), tracker<session_feeler>(network.log)
+{
+}
+
+// Start/stop sequence.
+// ----------------------------------------------------------------------------
+
+void session_feeler::start(result_handler&& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (is_zero(settings()->feeler_seconds) ||
+        is_zero(settings()->outbound_connections) ||
+        is_zero(settings()->host_pool_capacity))
+    {
+        LOGN("Bypassed feeler connections because disabled.");
+        handler(error::success);
+        unsubscribe_close();
+        return;
+    }
+
+    session::start(BIND2(handle_started, _1, std::move(handler)));
+}
+
+void session_feeler::handle_started(const code& ec,
+    const result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (ec)
+    {
+        handler(ec);
+        unsubscribe_close();
+        return;
+    }
+
+    LOGN("Feeler connections every (" << settings()->feeler_seconds
+        << ") seconds.");
+
+    handler(error::success);
+    schedule();
+}
+
+// Feeler sequence.
+// ----------------------------------------------------------------------------
+
+// Feelers are sequential, the next is deferred upon completion of the last.
+void session_feeler::schedule() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped())
+        return;
+
+    defer(settings()->feeler_interval(), BIND1(start_feeler, _1));
+}
+
+// ec is set if deferral canceled.
+void session_feeler::start_feeler(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (ec || stopped())
+        return;
+
+    take_new(BIND2(do_feeler, _1, _2));
+}
+
+void session_feeler::do_feeler(const code& ec,
+    const config::address& peer) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // There are no new addresses to test (or the pool is stopped).
+    if (ec)
+    {
+        schedule();
+        return;
+    }
+
+    // Guard restartable connector (shutdown delay).
+    if (stopped())
+    {
+        restore(peer, BIND1(handle_reclaim, _1));
+        return;
+    }
+
+    const auto connector = create_connector();
+    const auto key = subscribe_stop([=](const code&) NOEXCEPT
+    {
+        connector->stop();
+        return false;
+    });
+
+    // Connect latency is measured from the start of the attempt.
+    const auto start = steady_clock::now();
+    connector->connect(peer, BIND5(handle_connect, _1, _2, peer, key, start));
+}
+
+void session_feeler::handle_connect(const code& ec, const socket::ptr& socket,
+    const config::address& peer, object_key key,
+    const steady_clock::time_point& start) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // Unregister the connector.
+    notify(key);
+
+    if (ec)
+    {
+        BC_ASSERT_MSG(!socket || socket->stopped(), "unexpected socket");
+        LOGS("Feeler failed to connect [" << peer << "] " << ec.message());
+
+        // An address that fails to connect is dropped from the pool.
+        if (stopped() || retain(ec))
+            restore(peer, BIND1(handle_reclaim, _1));
+
+        schedule();
+        return;
+    }
+
+    const auto latency = steady_clock::now() - start;
+    const auto channel = create_channel(socket, true);
+
+    start_channel(channel,
+        BIND3(handle_channel_start, _1, channel, latency),
+        BIND2(handle_channel_stop, _1, channel));
+}
+
+void session_feeler::attach_protocols(const channel::ptr&) NOEXCEPT
+{
+}
+
+void session_feeler::handle_channel_start(const code& ec,
+    const channel::ptr& channel, const steady_clock::duration& latency) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // An address that fails to handshake is dropped from the pool.
+    if (ec)
+    {
+        LOGS("Feeler failed to handshake [" << channel->authority() << "] "
+            << ec.message());
+
+        if (stopped() || retain(ec))
+            restore(channel->address(), BIND1(handle_reclaim, _1));
+
+        return;
+    }
+
+    // The address is tried, and the channel is no longer required.
+    restore(channel->get_updated_address(), error::success, latency,
+        BIND1(handle_reclaim, _1));
+
+    channel->stop(error::operation_canceled);
+}
+
+void session_feeler::handle_channel_stop(const code&,
+    const channel::ptr&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    schedule();
+}
+
+// private
+inline bool session_feeler::retain(const code& ec) const NOEXCEPT
+{
+    // Feelers that did not test the address (canceled or already connected).
+    return ec == error::operation_canceled
+        || ec == error::service_stopped
+        || ec == error::channel_conflict
+        || ec == error::address_in_use;
+}
+
+void session_feeler::handle_reclaim(const code&) const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace network
+} // namespace libbitcoin
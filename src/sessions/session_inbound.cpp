@@ -18,7 +18,9 @@
  */
 #include <bitcoin/network/sessions/session_inbound.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/log/log.hpp>
@@ -40,7 +42,9 @@ BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
 BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
 
 session_inbound::session_inbound(p2p& network, uint64_t identifier) NOEXCEPT
-  : session(network, identifier), tracker<session_inbound>(network.log)
+  : session(network, identifier),
+    tracker<session_inbound>(network.log),
+    accepts_(network.network_settings()->accept_rate, seconds{ 1 })
 {
 }
 
@@ -51,7 +55,7 @@ void session_inbound::start(result_handler&& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
-    if (!settings().inbound_enabled())
+    if (!settings()->inbound_enabled())
     {
         LOGN("Not configured for inbound connections.");
         handler(error::success);
@@ -75,33 +79,157 @@ void session_inbound::handle_started(const code& ec,
         return;
     }
 
-    LOGN("Accepting " << settings().inbound_connections << " connections on "
-        << settings().binds.size() << " bindings.");
+    const auto current = settings();
+    LOGN("Accepting " << current->inbound_connections << " connections on "
+        << current->binds.size() << " bindings.");
 
-    for (const auto& bind: settings().binds)
-    {
-        const auto acceptor = create_acceptor();
+    auto listeners = take_listeners();
 
-        // Require that all acceptors at least start.
-        if (const auto error_code = acceptor->start(bind))
+    for (const auto& bind: current->binds)
+    {
+        // With reuse_port there is one listener per bind on each shard.
+        for (const auto& acceptor: create_acceptors())
         {
-            handler(error_code);
-            return;
+            // Listeners taken from a prior process are adopted by endpoint.
+            const auto taken = std::find_if(listeners.begin(), listeners.end(),
+                [&](const handoff::listener& listener) NOEXCEPT
+                {
+                    return config::authority{ listener.local } == bind;
+                });
+
+            const auto adopted = taken != listeners.end();
+            const auto error_code = adopted ? acceptor->adopt(*taken) :
+                acceptor->start(bind);
+
+            // Require that all acceptors at least start.
+            if (error_code)
+            {
+                handoff::release(listeners);
+                handler(error_code);
+                return;
+            }
+
+            if (adopted)
+            {
+                LOGN("Adopted listener on endpoint [" << bind << "].");
+                listeners.erase(taken);
+            }
+
+            acceptors_.push_back(acceptor);
+
+            // Subscribe acceptor to stop desubscriber.
+            subscribe_stop([=](const code&) NOEXCEPT
+            {
+                boost::asio::dispatch(acceptor->strand(), [=]() NOEXCEPT
+                {
+                    acceptor->stop();
+                });
+
+                return false;
+            });
+
+            if (acceptor->sharded())
+            {
+                // Shards screen on their own strand (pacing and capacity are
+                // applied upon return to the network strand).
+                LOGN("Bound shard to endpoint [" << bind << "].");
+                boost::asio::post(acceptor->strand(),
+                    [acceptor, screener = BIND1(screen, _1)]() mutable NOEXCEPT
+                    {
+                        acceptor->filter(std::move(screener));
+                    });
+            }
+            else
+            {
+                // Connections are filtered before socket and channel creation.
+                LOGN("Bound to endpoint [" << acceptor->local() << "].");
+                acceptor->filter(BIND1(admit, _1));
+            }
+
+            start_accept(error::success, acceptor);
         }
+    }
+
+    // Listeners not configured here are closed.
+    handoff::release(listeners);
+    offer_listeners();
+    handler(error::success);
+}
 
-        LOGN("Bound to endpoint [" << acceptor->local() << "].");
+// Handoff.
+// ----------------------------------------------------------------------------
 
-        // Subscribe acceptor to stop desubscriber.
-        subscribe_stop([=](const code&) NOEXCEPT
+// Blocking (once at start), bounded by connect timeout, none if not offered.
+handoff::listeners session_inbound::take_listeners() const NOEXCEPT
+{
+    handoff::listeners out{};
+    const auto path = settings()->handoff_path;
+    if (path.empty())
+        return out;
+
+    if (const auto ec = handoff::take(out, path,
+        settings()->connect_timeout(resources().connects())))
+    {
+        LOGN("No listeners taken at [" << path.string() << "] "
+            << ec.message());
+    }
+    else
+    {
+        LOGN("Took (" << out.size() << ") listeners at [" << path.string()
+            << "].");
+    }
+
+    return out;
+}
+
+// The listeners are offered for the next process, until session stop.
+void session_inbound::offer_listeners() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto path = settings()->handoff_path;
+    if (path.empty())
+        return;
+
+    handoff::descriptors handles{};
+    for (const auto& acceptor: acceptors_)
+        handles.push_back(acceptor->descriptor());
+
+    handoff_ = std::make_shared<handoff>(strand());
+    if (const auto ec = handoff_->offer(path, std::move(handles),
+        BIND1(handle_handoff, _1)))
+    {
+        LOGN("Listeners not offered at [" << path.string() << "] "
+            << ec.message());
+        return;
+    }
+
+    subscribe_stop([offer = handoff_](const code&) NOEXCEPT
+    {
+        offer->stop();
+        return false;
+    });
+}
+
+// The next process accepts on the listeners, so accepting stops here and the
+// channels here are retained until session stop.
+void session_inbound::handle_handoff(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (stopped() || ec)
+        return;
+
+    LOGN("Handed off (" << acceptors_.size() << ") listeners.");
+    handed_off_ = true;
+
+    for (const auto& acceptor: acceptors_)
+    {
+        boost::asio::dispatch(acceptor->strand(), [=]() NOEXCEPT
         {
             acceptor->stop();
-            return false;
         });
-
-        start_accept(error::success, acceptor);
     }
-
-    handler(error::success);
 }
 
 // Accept cycle.
@@ -114,10 +242,28 @@ void session_inbound::start_accept(const code&,
     BC_ASSERT_MSG(stranded(), "strand");
 
     // Terminates accept loop (and acceptor is restartable).
-    if (stopped())
+    if (stopped() || handed_off_)
         return;
 
-    acceptor->accept(BIND3(handle_accept, _1, _2, acceptor));
+    if (!acceptor->sharded())
+    {
+        acceptor->accept(BIND3(handle_accept, _1, _2, acceptor));
+        return;
+    }
+
+    // Sharded accepts are issued and complete on the shard strand, creating
+    // the socket on its shard, and are then returned to the network strand.
+    const auto self = shared_from_base<session_inbound>();
+    boost::asio::post(acceptor->strand(), [self, acceptor]() NOEXCEPT
+    {
+        acceptor->accept([self, acceptor](const code& ec,
+            const socket::ptr& socket) NOEXCEPT
+        {
+            boost::asio::post(self->strand(),
+                std::bind(&session_inbound::handle_accept, self, ec, socket,
+                    acceptor));
+        });
+    });
 }
 
 void session_inbound::handle_accept(const code& ec,
@@ -132,6 +278,10 @@ void session_inbound::handle_accept(const code& ec,
         return;
     }
 
+    // Accept is canceled by handoff, as the listeners are now shared.
+    if (ec && handed_off_)
+        return;
+
     // There was an error accepting the channel, so try again after delay.
     if (ec)
     {
@@ -144,48 +294,209 @@ void session_inbound::handle_accept(const code& ec,
     // There was no error, so listen again without delay.
     start_accept(error::success, acceptor);
 
-    const auto address = socket->authority().to_address_item();
-
-    if (!whitelisted(address))
+    // Shards only screen, as pacing and capacity are protected by strand.
+    if (acceptor->sharded() && !accommodate(socket->authority()))
     {
-        ////LOGS("Dropping not whitelisted connection [" << socket->authority() << "].");
         socket->stop();
         return;
     }
 
+    ++accepted_;
+
+    const auto channel = create_channel(socket, false);
+
+    // The shard acceptor's local endpoint is protected by its own strand.
+    if (acceptor->sharded())
+    {
+        LOGS("Accepted inbound connection [" << channel->authority() << "] on shard.");
+    }
+    else
+    {
+        LOGS("Accepted inbound connection [" << channel->authority() << "] on binding ["
+            << acceptor->local() << "].");
+    }
+
+    start_channel(channel,
+        BIND2(handle_channel_start, _1, channel),
+        BIND2(handle_channel_stop, _1, channel));
+}
+
+// Applied by the acceptor before socket construction (rejects are silent).
+bool session_inbound::admit(const config::authority& remote) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    return !stopped() && screen(remote) && accommodate(remote);
+}
+
+// Thread safe, as applied by sharded acceptors on their own strands.
+bool session_inbound::screen(const config::authority& remote) NOEXCEPT
+{
+    const auto address = remote.to_address_item();
+
+    if (!whitelisted(address))
+    {
+        ////LOGS("Dropping not whitelisted connection [" << remote << "].");
+        return false;
+    }
+
     if (blacklisted(address))
     {
-        ////LOGS("Dropping blacklisted connection [" << socket->authority() << "].");
-        socket->stop();
-        return;
+        ////LOGS("Dropping blacklisted connection [" << remote << "].");
+        return false;
     }
 
-    // Could instead stop listening when at limit, though this is simpler.
-    if (inbound_channel_count() >= settings().inbound_connections)
+    // Misbehaving peers are refused before the cost of channel handshake.
+    if (banned(address))
     {
-        LOGS("Dropping oversubscribed connection [" << socket->authority() << "].");
-        socket->stop();
-        return;
+        ////LOGS("Dropping banned connection [" << remote << "].");
+        ++banned_;
+        return false;
     }
 
-    const auto channel = create_channel(socket, false);
+    // Under memory pressure new channels are refused (existing are held).
+    if (resources().memory().pressured())
+    {
+        LOGS("Dropping connection under memory pressure [" << remote << "].");
+        ++pressured_;
+        return false;
+    }
 
-    LOGS("Accepted inbound connection [" << channel->authority() << "] on binding ["
-        << acceptor->local() << "].");
+    return true;
+}
 
-    start_channel(channel,
-        BIND2(handle_channel_start, _1, channel),
-        BIND2(handle_channel_stop, _1, channel));
+bool session_inbound::accommodate(const config::authority& remote) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    const auto address = remote.to_address_item();
+
+    // Pacing precedes socket construction, so excess connections are cheap.
+    if (!admitted(address))
+    {
+        ////LOGS("Dropping paced connection [" << remote << "].");
+        ++paced_;
+        return false;
+    }
+
+    // Could instead stop listening when at limit, though this is simpler.
+    // With eviction enabled the least useful channel yields its slot. The
+    // evicted channel stops asynchronously, so the count briefly overshoots.
+    if (inbound_channel_count() >= settings()->inbound_connections &&
+        (!settings()->inbound_eviction || !evict()))
+    {
+        LOGS("Dropping oversubscribed connection [" << remote << "].");
+        ++oversubscribed_;
+        return false;
+    }
+
+    return true;
 }
 
 bool session_inbound::blacklisted(const config::address& address) const NOEXCEPT
 {
-    return settings().blacklisted(address);
+    return settings()->blacklisted(address);
 }
 
 bool session_inbound::whitelisted(const config::address& address) const NOEXCEPT
 {
-    return settings().whitelisted(address);
+    return settings()->whitelisted(address);
+}
+
+// Token buckets, overall per second and per network group per minute.
+bool session_inbound::admitted(const messages::address_item& item) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto now = steady_clock::now();
+    if (!is_zero(settings()->accept_group_rate))
+    {
+        // Idle groups are pruned once the table reaches its bound.
+        if (groups_.size() >= maximum_groups)
+            std::erase_if(groups_, [&](auto& group) NOEXCEPT
+            {
+                return group.second.full(now);
+            });
+
+        const auto group = network_group(item.ip);
+        auto it = groups_.find(group);
+        if (it == groups_.end())
+        {
+            if (groups_.size() >= maximum_groups)
+                return false;
+
+            it = groups_.emplace(group, throttle{
+                settings()->accept_group_rate, minutes{ 1 } }).first;
+        }
+
+        if (!it->second.consume(one, now))
+            return false;
+    }
+
+    return accepts_.consume(one, now);
+}
+
+// Scores are read from channels off of their strands (atomic properties).
+bool session_inbound::evict() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    eviction::candidates peers{};
+    peers.reserve(channels_.size());
+    for (const auto& [id, channel]: channels_)
+    {
+        peers.push_back(
+        {
+            id,
+            network_group(channel->authority().to_address_item().ip),
+            channel->round_trip().smoothed,
+            channel->received(),
+            channel->uptime(),
+            channel->processing()
+        });
+    }
+
+    uint64_t id{};
+    if (!eviction::select(id, std::move(peers)))
+        return false;
+
+    const auto it = channels_.find(id);
+    LOGS("Evicting inbound channel [" << it->second->authority() << "].");
+    it->second->stop(error::channel_evicted);
+    channels_.erase(it);
+    ++evicted_;
+    return true;
+}
+
+// Properties.
+// ----------------------------------------------------------------------------
+
+size_t session_inbound::accepted() const NOEXCEPT
+{
+    return accepted_.load();
+}
+
+size_t session_inbound::paced() const NOEXCEPT
+{
+    return paced_.load();
+}
+
+size_t session_inbound::banned_count() const NOEXCEPT
+{
+    return banned_.load();
+}
+
+size_t session_inbound::oversubscribed() const NOEXCEPT
+{
+    return oversubscribed_.load();
+}
+
+size_t session_inbound::pressured() const NOEXCEPT
+{
+    return pressured_.load();
+}
+
+size_t session_inbound::evicted() const NOEXCEPT
+{
+    return evicted_.load();
 }
 
 // Completion sequence.
@@ -202,11 +513,11 @@ void session_inbound::attach_handshake(const channel::ptr& channel,
 
     // Weak reference safe as sessions outlive protocols.
     auto& self = *this;
-    const auto maximum_version = settings().protocol_maximum;
-    const auto maximum_services = settings().services_maximum;
+    const auto maximum_version = settings()->protocol_maximum;
+    const auto maximum_services = settings()->services_maximum;
     const auto extended_version = maximum_version >= messages::level::bip37;
-    const auto enable_transaction = settings().enable_transaction;
-    const auto enable_reject = settings().enable_reject &&
+    const auto enable_transaction = settings()->enable_transaction;
+    const auto enable_reject = settings()->enable_reject &&
         maximum_version >= messages::level::bip61;
 
     // Protocol must pause the channel after receiving version and verack.
@@ -225,10 +536,15 @@ void session_inbound::attach_handshake(const channel::ptr& channel,
             maximum_services)->shake(std::move(handler));
 }
 
-void session_inbound::handle_channel_start(const code&,
-    const channel::ptr&) NOEXCEPT
+void session_inbound::handle_channel_start(const code& ec,
+    const channel::ptr& channel) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+
+    // Started (handshaked) channels are eviction candidates.
+    if (!ec && !channel->stopped())
+        channels_.emplace(channel->identifier(), channel);
+
     ////LOGS("Inbound channel start [" << channel->authority() << "] "
     ////    << ec.message());
 }
@@ -240,9 +556,10 @@ void session_inbound::attach_protocols(
 }
 
 void session_inbound::handle_channel_stop(const code& LOG_ONLY(ec),
-    const channel::ptr& LOG_ONLY(channel)) NOEXCEPT
+    const channel::ptr& channel) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+    channels_.erase(channel->identifier());
     LOGS("Inbound channel stop [" << channel->authority() << "] "
         << ec.message());
 }
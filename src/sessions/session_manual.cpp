@@ -141,14 +141,18 @@ void session_manual::handle_connect(const code& ec, const socket::ptr& socket,
         {
             // TODO: drop connector subscription.
             LOGS("Manual channel dropped at connect [" << peer << "].");
+            attempts_.erase(connector);
             return;
         }
 
-        // Avoid tight loop with delay timer.
-        defer(BIND4(start_connect, _1, peer, connector, handler));
+        // Avoid tight loop with delay timer, backing off (reset on start).
+        const auto delay = settings()->retry_backoff(attempts_[connector]++);
+        defer(delay, BIND4(start_connect, _1, peer, connector, handler));
         return;
     }
 
+    // Connected, so consecutive failures are reset.
+    attempts_.erase(connector);
     const auto channel = create_channel(socket, false);
 
     // It is possible for start_channel to directly invoke the handlers.
@@ -196,6 +200,7 @@ void session_manual::handle_channel_stop(const code& ec,
     {
         // TODO: drop connector subscription.
         LOGS("Manual channel dropped [" << peer << "].");
+        attempts_.erase(connector);
         return;
     }
 
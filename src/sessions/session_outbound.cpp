@@ -19,7 +19,9 @@
 #include <bitcoin/network/sessions/session_outbound.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <mutex>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
@@ -56,7 +58,7 @@ void session_outbound::start(result_handler&& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
-    if (!settings().outbound_enabled())
+    if (!settings()->outbound_enabled())
     {
         LOGN("Not configured for outbound connections.");
         handler(error::success);
@@ -72,7 +74,7 @@ void session_outbound::start(result_handler&& handler) NOEXCEPT
         return;
     }
 
-    if (!settings().enable_address)
+    if (!settings()->enable_address)
     {
         LOGN("Address protocol disabled, may cause empty address pool.");
     }
@@ -93,9 +95,14 @@ void session_outbound::handle_started(const code& ec,
         return;
     }
 
-    const auto peers = settings().outbound_connections;
+    // Connected sockets that lost a race are held for other connect cycles.
+    subscribe_stop(BIND1(handle_stop, _1));
 
-    LOG_ONLY(const auto batch = settings().connect_batch_size;)
+    // Standby channels are filled by additional connect cycles.
+    const auto peers = settings()->outbound_connections +
+        settings()->outbound_standby;
+
+    LOG_ONLY(const auto batch = settings()->connect_batch_size;)
     LOGN("Create " << peers << " connections " << batch << " at a time.");
 
     for (size_t peer = 0; peer < peers; ++peer)
@@ -109,7 +116,14 @@ void session_outbound::handle_started(const code& ec,
 // ----------------------------------------------------------------------------
 
 // Attempt to connect one peer using a batch of connectors.
-void session_outbound::start_connect(const code&) NOEXCEPT
+void session_outbound::start_connect(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+    retry_connect(ec, zero);
+}
+
+// Attempts is the number of consecutive failed cycles, for retry backoff.
+void session_outbound::retry_connect(const code&, size_t attempts) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
@@ -117,8 +131,15 @@ void session_outbound::start_connect(const code&) NOEXCEPT
     if (stopped())
         return;
 
-    // Create a set of connectors for batched stop.
-    const auto connectors = create_connectors(settings().connect_batch_size);
+    // Fill this connection from a socket that lost a prior race, if any.
+    if (const auto spare = take_spare())
+    {
+        start_outbound(spare->socket, spare->latency);
+        return;
+    }
+
+    // Take a set of connectors for batched stop (recycled when complete).
+    const auto connectors = take_connectors(batch_size());
 
     // Subscribe connector set to stop desubscriber.
     const auto key = subscribe_stop([=](const code&) NOEXCEPT
@@ -130,21 +151,33 @@ void session_outbound::start_connect(const code&) NOEXCEPT
 
     // Bogus warning, this pointer is copied into std::bind().
     BC_PUSH_WARNING(NO_UNUSED_LOCAL_SMART_PTR)
-    const auto racer = std::make_shared<race>(connectors->size());
+    const auto racer = take_race();
     BC_POP_WARNING()
-            
-    // Race to first success or last failure.
-    racer->start(BIND3(handle_connect, _1, _2, key));
+
+    // Race to first success or last failure (the handler holds the race
+    // until invoked, at which point it is recycled).
+    racer->start(connectors->size(),
+        BIND7(handle_connect, _1, _2, _3, key, attempts, racer, connectors));
 
     // Attempt to connect with unique address for each connector of batch.
+    // The first connector of a cycle dials an anchor peer while any remain.
+    address_item_cptr anchor{};
     for (const auto& connector: *connectors)
-        take(BIND5(do_one, _1, _2, key, racer, connector));
+    {
+        if (!anchor && take_anchor(anchor))
+            do_one(error::success, anchor, key, racer, connector, zero);
+        else
+            take(BIND6(do_one, _1, _2, key, racer, connector, zero));
+    }
 }
 
+// Retakes of an address in a connected group before accepting it.
+constexpr size_t diversity_retries = 8;
+
 // Attempt to connect the given peer and invoke handle_one.
 void session_outbound::do_one(const code& ec, const config::address& peer,
-    object_key key, const race::ptr& racer,
-    const connector::ptr& connector) NOEXCEPT
+    object_key key, const race::ptr& racer, const connector::ptr& connector,
+    size_t tries) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
     ////COUNT(events::outbound1, key);
@@ -152,7 +185,7 @@ void session_outbound::do_one(const code& ec, const config::address& peer,
     if (ec)
     {
         ////LOGS("Address pool is empty.");
-        racer->finish(ec, nullptr);
+        racer->finish(ec, nullptr, {});
         return;
     }
 
@@ -160,69 +193,133 @@ void session_outbound::do_one(const code& ec, const config::address& peer,
     if (stopped())
     {
         restore(peer, BIND1(handle_reclaim, _1));
-        racer->finish(error::service_stopped, nullptr);
+        racer->finish(error::service_stopped, nullptr, {});
         return;
     }
 
-    connector->connect(peer, BIND4(handle_one, _1, _2, key, racer));
+    // Exchange an address of a connected group, accepted after retries.
+    if (tries < diversity_retries && is_connected_group(peer))
+    {
+        restore(peer, BIND1(handle_reclaim, _1));
+        take(BIND6(do_one, _1, _2, key, racer, connector, add1(tries)));
+        return;
+    }
+
+    // Connect latency is measured from the start of each attempt.
+    const auto start = steady_clock::now();
+    connector->connect(peer, BIND5(handle_one, _1, _2, key, racer, start));
 }
 
 // Handle each do_one connection attempt, stopping on first success.
 void session_outbound::handle_one(const code& ec, const socket::ptr& socket,
-    object_key key, const race::ptr& racer) NOEXCEPT
+    object_key key, const race::ptr& racer,
+    const steady_clock::time_point& start) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
     ////COUNT(events::outbound2, key);
 
+    const auto latency = steady_clock::now() - start;
+    record_attempt(ec);
+
     // Winner in quality race is first to pass success.
-    if (racer->finish(ec, socket))
+    if (racer->finish(ec, socket, latency))
     {
         // Since there is a winner, accelerate connector stop.
         notify(key);
         return;
     }
 
+    // Hold a connected loser for another connection, otherwise reclaim.
+    if (!ec && put_spare(socket, latency))
+        return;
+
     // Stop socket and reclaim address if not the winning finisher.
-    reclaim(ec, socket);
+    reclaim(ec, socket, latency);
 }
 
 // Handle the singular batch result.
 void session_outbound::handle_connect(const code& ec,
-    const socket::ptr& socket, object_key key) NOEXCEPT
+    const socket::ptr& socket, const steady_clock::duration& latency,
+    object_key key, size_t attempts, const race::ptr& racer,
+    const connectors_ptr& connectors) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
     ////COUNT(events::outbound3, key);
 
+    // The race is complete (cleared), so may be restarted by another cycle.
+    put_race(racer);
+
     // Unregister connectors, in case there was no winner.
     notify(key);
 
+    // Each connector has finished its attempt, so may be reused.
+    put_connectors(connectors);
+
     // Guard restartable timer (shutdown delay).
     if (stopped())
     {
-        reclaim(ec, socket);
+        reclaim(ec, socket, latency);
         return;
     }
 
+    // Consecutive failures back off (with jitter), reset upon success.
+    const auto delay = settings()->retry_backoff(attempts);
+    const auto retries = add1(attempts);
+
     if (ec == error::address_not_found)
     {
         LOGS("Address pool is empty.");
-        defer(settings().connect_timeout(), BIND1(start_connect, _1));
+        defer(std::max(settings()->connect_timeout(resources().connects()),
+            delay),
+            BIND2(retry_connect, _1, retries));
         return;
     }
 
     // There was an error connecting a channel, so try again after delay.
     if (ec)
     {
+        // A socket that lost another race avoids the delay.
+        if (const auto spare = take_spare())
+        {
+            start_outbound(spare->socket, spare->latency);
+            return;
+        }
+
         // Avoid tight loop with delay timer.
-        defer(BIND1(start_connect, _1));
+        defer(delay, BIND2(retry_connect, _1, retries));
         return;
     }
 
+    start_outbound(socket, latency);
+}
+
+void session_outbound::start_outbound(const socket::ptr& socket,
+    const steady_clock::duration& latency) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
     const auto channel = create_channel(socket, false);
+    count_group(channel->address(), true);
+
+    // Fill the outbound target first, the remainder are held in standby.
+    // Block-relay channels are the first of the active outbound target.
+    if (active_ < settings()->outbound_connections)
+    {
+        ++active_;
+        if (block_relays_ < settings()->block_relay_connections)
+        {
+            ++block_relays_;
+            channel->set_block_relay(true);
+        }
+    }
+    else
+    {
+        set_standby(channel, true);
+    }
 
     start_channel(channel,
         BIND2(handle_channel_start, _1, channel),
-        BIND2(handle_channel_stop, _1, channel));
+        BIND3(handle_channel_stop, _1, channel, latency));
 }
 
 void session_outbound::attach_handshake(const channel::ptr& channel,
@@ -231,11 +328,15 @@ void session_outbound::attach_handshake(const channel::ptr& channel,
     session::attach_handshake(channel, std::move(handler));
 }
 
-void session_outbound::handle_channel_start(const code&,
-    const channel::ptr&) NOEXCEPT
+void session_outbound::handle_channel_start(const code& ec,
+    const channel::ptr& channel) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
+    // A started standby channel is available for promotion.
+    if (!ec && is_standby(channel))
+        standbys_.push_back(channel);
+
     ////LOGS("Outbound channel start [" << channel->authority() << "] "
     ////    "(" << key << ") " << ec.message());
 }
@@ -247,19 +348,286 @@ void session_outbound::attach_protocols(
 }
 
 void session_outbound::handle_channel_stop(const code& ec,
-    const channel::ptr& channel) NOEXCEPT
+    const channel::ptr& channel, const steady_clock::duration& latency) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
     ////LOGS("Outbound channel stop [" << channel->authority() << "] "
     ////    "(" << key << ") " << ec.message());
 
-    reclaim(ec, channel);
+    // An active channel stop promotes a standby, leaving its cycle to refill
+    // the standby (the outbound target is filled first). A block-relay stop
+    // is not promoted, as its cycle refills the block-relay channel.
+    if (set_standby(channel, false))
+    {
+        std::erase(standbys_, channel);
+    }
+    else if (channel->block_relay())
+    {
+        --active_;
+        --block_relays_;
+    }
+    else
+    {
+        --active_;
+        promote_standby();
+    }
+
+    count_group(channel->address(), false);
+
+    // Channels that outlive the session (shutdown) are candidate anchors.
+    if (stopped())
+        record_anchor(*channel);
+
+    reclaim(ec, channel, latency);
 
     // Cannot be tight loop due to handshake.
     start_connect(ec);
 }
 
+bool session_outbound::standby(const channel::ptr& channel) const NOEXCEPT
+{
+    return is_standby(channel);
+}
+
+// Adaptive batch size.
+// ----------------------------------------------------------------------------
+// private
+
+// Connect success is smoothed over recent attempts (1/16 per attempt).
+constexpr auto success_weight = 1.0 / 16.0;
+
+// The batch size at which at least one connect succeeds at this probability.
+constexpr auto batch_confidence = 0.95;
+
+// Until attempts are measured the configured maximum is used, so an unhealthy
+// pool is not undersized at startup. Bounds are minimum and batch size.
+size_t session_outbound::batch_size() const NOEXCEPT
+{
+    const size_t maximum = settings()->connect_batch_size;
+    const auto minimum = std::clamp<size_t>(settings()->connect_batch_minimum,
+        one, maximum);
+
+    if (!measured_ || success_rate_ <= 0.0)
+        return maximum;
+
+    if (success_rate_ >= 1.0)
+        return minimum;
+
+    // n = log(1 - confidence) / log(1 - p), for p success per attempt.
+    const auto size = std::ceil(std::log(1.0 - batch_confidence) /
+        std::log(1.0 - success_rate_));
+
+    return std::clamp(static_cast<size_t>(size), minimum, maximum);
+}
+
+// Attempts canceled after a race is won (or by stop) are not outcomes.
+void session_outbound::record_attempt(const code& ec) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (ec == error::operation_canceled || ec == error::service_stopped)
+        return;
+
+    const auto sample = ec ? 0.0 : 1.0;
+    success_rate_ = measured_ ? success_rate_ + success_weight *
+        (sample - success_rate_) : sample;
+
+    measured_ = true;
+}
+
+// Network groups.
+// ----------------------------------------------------------------------------
+// private
+
+bool session_outbound::is_connected_group(
+    const config::address& peer) const NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    return settings()->outbound_diversity &&
+        groups_.contains(network_group(peer.ip()));
+}
+
+void session_outbound::count_group(const config::address& peer,
+    bool add) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!settings()->outbound_diversity)
+        return;
+
+    const auto group = network_group(peer.ip());
+    if (add)
+    {
+        ++groups_[group];
+        return;
+    }
+
+    const auto it = groups_.find(group);
+    if (it != groups_.end() && is_zero(--it->second))
+        groups_.erase(it);
+}
+
+// Spare sockets (connected losers of a race).
+// ----------------------------------------------------------------------------
+// private
+
+// Spares are limited to the connection target and expire at connect timeout,
+// as the peer may drop an idle connection before it is handshaken.
+bool session_outbound::put_spare(const socket::ptr& socket,
+    const steady_clock::duration& latency) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (!socket || stopped() ||
+        spares_.size() >= settings()->outbound_connections)
+        return false;
+
+    spares_.push_back({ socket, latency, steady_clock::now() });
+    return true;
+}
+
+std::optional<session_outbound::spare>
+session_outbound::take_spare() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    const auto expiry = steady_clock::now() -
+        settings()->connect_timeout(resources().connects());
+    while (!spares_.empty())
+    {
+        auto value = std::move(spares_.front());
+        spares_.pop_front();
+
+        if (value.connected >= expiry && !value.socket->stopped())
+            return value;
+
+        // Expired spares connected, so they are reclaimed as successful.
+        reclaim(error::success, value.socket, value.latency);
+    }
+
+    return {};
+}
+
+// Races.
+// ----------------------------------------------------------------------------
+// private
+
+// One race completes per connect cycle, and cycles are bounded by the number
+// of connections, so the pool is as well. Pooled races hold no handler.
+session_outbound::race::ptr session_outbound::take_race() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (races_.empty())
+        return std::make_shared<race>(zero);
+
+    const auto racer = races_.back();
+    races_.pop_back();
+    return racer;
+}
+
+void session_outbound::put_race(const race::ptr& racer) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (races_.size() < settings()->outbound_connections +
+        settings()->outbound_standby)
+        races_.push_back(racer);
+}
+
+// Connectors are restartable once their attempt completes, so a cycle reuses
+// the resolvers and timers of prior cycles, creating only the shortfall.
+connectors_ptr session_outbound::take_connectors(size_t count) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    if (idle_.empty())
+        return create_connectors(count);
+
+    const auto out = std::make_shared<connectors>();
+    out->reserve(count);
+
+    while (!idle_.empty() && out->size() < count)
+    {
+        out->push_back(std::move(idle_.back()));
+        idle_.pop_back();
+    }
+
+    while (out->size() < count)
+        out->push_back(create_connector());
+
+    return out;
+}
+
+void session_outbound::put_connectors(const connectors_ptr& set) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    // The pool is cleared by stop, so don't refill it.
+    if (stopped())
+        return;
+
+    const size_t limit = settings()->connect_batch_size *
+        (settings()->outbound_connections + settings()->outbound_standby);
+
+    for (const auto& connector: *set)
+        if (idle_.size() < limit)
+            idle_.push_back(connector);
+}
+
+bool session_outbound::handle_stop(const code&) NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    for (const auto& value: spares_)
+        reclaim(error::success, value.socket, value.latency);
+
+    spares_.clear();
+    standbys_.clear();
+    idle_.clear();
+    return false;
+}
+
+// Standby channels (handshaken and paused).
+// ----------------------------------------------------------------------------
+// private
+
+bool session_outbound::is_standby(const channel::ptr& channel) const NOEXCEPT
+{
+    std::unique_lock lock(standby_mutex_);
+    return standby_.contains(channel->identifier());
+}
+
+// Returns true if the standby state of the channel was changed.
+bool session_outbound::set_standby(const channel::ptr& channel,
+    bool standby) NOEXCEPT
+{
+    std::unique_lock lock(standby_mutex_);
+    const auto id = channel->identifier();
+    return standby ? standby_.insert(id).second : to_bool(standby_.erase(id));
+}
+
+// Stopped standbys are skipped, their stop handlers remove them from standby.
+void session_outbound::promote_standby() NOEXCEPT
+{
+    BC_ASSERT_MSG(stranded(), "strand");
+
+    while (!standbys_.empty())
+    {
+        const auto channel = std::move(standbys_.front());
+        standbys_.pop_front();
+
+        if (channel->stopped() || !set_standby(channel, false))
+            continue;
+
+        ++active_;
+        promote(channel);
+        return;
+    }
+}
+
 // Address reclaim and socket/channel stop.
 // ----------------------------------------------------------------------------
 // private
@@ -267,7 +635,7 @@ void session_outbound::handle_channel_stop(const code& ec,
 inline bool session_outbound::maybe_reclaim(const code& ec) const NOEXCEPT
 {
     // Bypass if host pool is full (don't allow these to evict others).
-    if (address_count() >= settings().host_pool_capacity)
+    if (address_count() >= settings()->host_pool_capacity)
         return false;
 
     // Failures that might work later (timeouts can drain pool).
@@ -285,8 +653,9 @@ inline bool session_outbound::always_reclaim(const code& ec) const NOEXCEPT
 }
 
 // Use initial address time and services, since connection not completed.
-void session_outbound::reclaim(const code& ec,
-    const socket::ptr& socket) NOEXCEPT
+// A connected socket that lost the race is reported as a successful connect.
+void session_outbound::reclaim(const code& ec, const socket::ptr& socket,
+    const steady_clock::duration& latency) NOEXCEPT
 {
     if (!socket)
         return;
@@ -296,13 +665,14 @@ void session_outbound::reclaim(const code& ec,
 
     if (stopped() || always_reclaim(ec) || maybe_reclaim(ec))
     {
-        restore(socket->address(), BIND1(handle_reclaim, _1));
+        restore(socket->address(), ec, latency, BIND1(handle_reclaim, _1));
     }
 }
 
 // Set address to current time and services from peer version message.
-void session_outbound::reclaim(const code& ec,
-    const channel::ptr& channel) NOEXCEPT
+// A channel that terminated as having worked is reported as successful.
+void session_outbound::reclaim(const code& ec, const channel::ptr& channel,
+    const steady_clock::duration& latency) NOEXCEPT
 {
     if (!channel)
         return;
@@ -312,7 +682,9 @@ void session_outbound::reclaim(const code& ec,
 
     if (stopped() || always_reclaim(ec) || maybe_reclaim(ec))
     {
-        restore(channel->get_updated_address(), BIND1(handle_reclaim, _1));
+        const auto outcome = always_reclaim(ec) ? error::success : ec;
+        restore(channel->get_updated_address(), outcome, latency,
+            BIND1(handle_reclaim, _1));
     }
 }
 
@@ -43,7 +43,10 @@ BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
 BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
 
 session_seed::session_seed(p2p& network, uint64_t identifier) NOEXCEPT
-  : session(network, identifier), tracker<session_seed>(network.log)
+  : session(network, identifier),
+    tracker<session_seed>(network.log),
+    network_(network),
+    seeds_(*network.network_settings())
 {
 }
 
@@ -56,8 +59,8 @@ void session_seed::start(result_handler&& handler) NOEXCEPT
 
     // Seeding is allowed even with !enable_address configured.
 
-    if (is_zero(settings().outbound_connections) ||
-        is_zero(settings().connect_batch_size))
+    if (is_zero(settings()->outbound_connections) ||
+        is_zero(settings()->connect_batch_size))
     {
         LOGN("Bypassed seeding because outbound connections disabled.");
         handler(error::success);
@@ -65,17 +68,17 @@ void session_seed::start(result_handler&& handler) NOEXCEPT
         return;
     }
 
-    if (address_count() >= settings().minimum_address_count())
+    if (address_count() >= settings()->minimum_address_count())
     {
         LOGN("Bypassed seeding because of sufficient ("
-            << address_count() << " of " << settings().minimum_address_count()
+            << address_count() << " of " << settings()->minimum_address_count()
             << ") address quantity.");
         handler(error::success);
         unsubscribe_close();
         return;
     }
 
-    if (is_zero(settings().host_pool_capacity))
+    if (is_zero(settings()->host_pool_capacity))
     {
         LOGN("Cannot seed because no address pool capacity configured.");
         handler(error::seeding_unsuccessful);
@@ -83,7 +86,7 @@ void session_seed::start(result_handler&& handler) NOEXCEPT
         return;
     }
 
-    if (settings().seeds.empty())
+    if (settings()->seeds.empty())
     {
         LOGN("Cannot seed because no seeds configured");
         handler(error::seeding_unsuccessful);
@@ -106,21 +109,34 @@ void session_seed::handle_started(const code& ec,
         return;
     }
 
-    const auto seeds = settings().seeds.size();
-    const auto required = settings().minimum_address_count();
+    const auto required = settings()->minimum_address_count();
 
     LOGN("Seeding because of insufficient ("
         << address_count() << " of " << required << ") address quantity.");
 
+    // Cache failure is not fatal, seeds are then connected as configured.
+    if (const auto error = seeds_.load())
+    {
+        LOGN("Failed to load seed cache, " << error.message());
+    }
+
+    // Best yielding seeds first, recently failed (without yield) skipped.
+    const auto seeds = seeds_.order();
+
     // Bogus warning, this pointer is copied into std::bind().
     BC_PUSH_WARNING(NO_UNUSED_LOCAL_SMART_PTR)
-    const auto racer = std::make_shared<race>(seeds, required);
+    const auto racer = std::make_shared<race>(seeds.size(), required);
     BC_POP_WARNING()
 
     // Invoke sufficient on count, invoke complete with all seeds stopped.
+    // Sufficiency is signaled as addresses are saved, so that start is not
+    // held by slower seeds, which continue to fill the pool until stopped.
     racer->start(move_copy(handler), BIND1(stop_seed, _1));
+    racer_ = racer;
 
-    for (const auto& seed: settings().seeds)
+    // Seeds are raced in yield order, each start staggered by the setting.
+    auto delay = steady_clock::duration::zero();
+    for (const auto& seed: seeds)
     {
         const auto connector = create_connector();
         subscribe_stop([=](const code&) NOEXCEPT
@@ -129,19 +145,35 @@ void session_seed::handle_started(const code& ec,
             return false;
         });
 
-        start_seed(error::success, seed, connector,
-            BIND4(handle_connect, _1, _2, seed, racer));
+        // A fresh cached authority is connected without name resolution.
+        const auto target = seeds_.target(seed);
+        const socket_handler connect = BIND4(handle_connect, _1, _2, seed,
+            racer);
+
+        if (is_zero(delay.count()))
+            start_seed(error::success, target, connector, connect);
+        else
+            defer(delay, BIND4(start_seed, _1, target, connector, connect));
+
+        delay += settings()->seed_stagger();
     }
 }
 
 // Seed sequence.
 // ----------------------------------------------------------------------------
 
-// Attempt to connect one seed.
-void session_seed::start_seed(const code&, const config::endpoint& seed,
+// Attempt to connect one seed (ec is set if deferral canceled).
+void session_seed::start_seed(const code& ec, const config::endpoint& seed,
     const connector::ptr& connector, const socket_handler& handler) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
+
+    if (ec)
+    {
+        handler(ec, nullptr);
+        return;
+    }
+
     LOGN("Connecting to seed [" << seed << "]");
 
     // Guard restartable connector (shutdown delay).
@@ -155,7 +187,7 @@ void session_seed::start_seed(const code&, const config::endpoint& seed,
 }
 
 void session_seed::handle_connect(const code& ec, const socket::ptr& socket,
-    const config::endpoint& LOG_ONLY(seed), const race::ptr& racer) NOEXCEPT
+    const config::endpoint& seed, const race::ptr& racer) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
@@ -163,15 +195,24 @@ void session_seed::handle_connect(const code& ec, const socket::ptr& socket,
     {
         BC_ASSERT_MSG(!socket || socket->stopped(), "unexpected socket");
         LOGN("Failed to connect seed address [" << seed << "] " << ec.message());
+
+        // A seed canceled by stop is not recorded as failed.
+        if (ec != error::service_stopped && ec != error::operation_canceled)
+            seeds_.failed(seed);
+
         racer->finish(address_count());
         return;
     }
 
+    seeds_.connected(seed, socket->authority());
+
+    // Yield is the pool growth over the channel, approximate when concurrent.
     const auto channel = create_channel(socket, true);
+    const auto start = address_count();
 
     start_channel(channel,
         BIND2(handle_channel_start, _1, channel),
-        BIND3(handle_channel_stop, _1, channel, racer));
+        BIND5(handle_channel_stop, _1, channel, seed, start, racer));
 }
 
 void session_seed::attach_handshake(const channel::ptr& channel,
@@ -190,9 +231,9 @@ void session_seed::attach_handshake(const channel::ptr& channel,
 
     // Weak reference safe as sessions outlive protocols.
     auto& self = *this;
-    const auto maximum_version = settings().protocol_maximum;
+    const auto maximum_version = settings()->protocol_maximum;
     const auto extended_version = maximum_version >= messages::level::bip37;
-    const auto enable_reject = settings().enable_reject &&
+    const auto enable_reject = settings()->enable_reject &&
         maximum_version >= messages::level::bip61;
 
     // Protocol must pause the channel after receiving version and verack.
@@ -211,6 +252,25 @@ void session_seed::attach_handshake(const channel::ptr& channel,
             maximum_services)->shake(std::move(handler));
 }
 
+void session_seed::save(const address_cptr& message,
+    count_handler&& handler) const NOEXCEPT
+{
+    const auto racer = racer_;
+    session::save(message,
+        [this, &network = network_, racer, handler = std::move(handler)](
+            const code& ec, size_t accepted) NOEXCEPT
+        {
+            // A running race retains the session (stop_seed is bound).
+            boost::asio::post(network.strand(), [this, racer]() NOEXCEPT
+            {
+                if (const auto racing = racer.lock())
+                    racing->sufficient(address_count());
+            });
+
+            handler(ec, accepted);
+        });
+}
+
 void session_seed::handle_channel_start(const code& ec,
     const channel::ptr& LOG_ONLY(channel)) NOEXCEPT
 {
@@ -228,34 +288,26 @@ void session_seed::attach_protocols(const channel::ptr& channel) NOEXCEPT
 
     // Weak reference safe as sessions outlive protocols.
     auto& self = *this;
-    const auto enable_alert = settings().enable_alert;
     const auto negotiated_version = channel->negotiated_version();
     const auto enable_pong = negotiated_version >= messages::level::bip31;
-    const auto enable_reject = settings().enable_reject &&
-        negotiated_version >= messages::level::bip61;
 
+    // Seeds dispatch only handshake, ping and address (no alert or reject).
     if (enable_pong)
         channel->attach<protocol_ping_60001>(self)->start();
     else
         channel->attach<protocol_ping_31402>(self)->start();
 
-    // Alert is deprecated.
-    if (enable_alert)
-        channel->attach<protocol_alert_31402>(self)->start();
-
-    // Reject is deprecated.
-    if (enable_reject)
-        channel->attach<protocol_reject_70002>(self)->start();
-
     // Seed protocol stops upon completion, causing session removal.
     channel->attach<protocol_seed_31402>(self)->start();
 }
 
 void session_seed::handle_channel_stop(const code& LOG_ONLY(ec),
-    const channel::ptr& LOG_ONLY(channel), const race::ptr& racer) NOEXCEPT
+    const channel::ptr& LOG_ONLY(channel), const config::endpoint& seed,
+    size_t start, const race::ptr& racer) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
     LOGN("Seed stop [" << channel->authority() << "] " << ec.message());
+    seeds_.yielded(seed, floored_subtract(address_count(), start));
     racer->finish(address_count());
 }
 
@@ -263,6 +315,11 @@ void session_seed::stop_seed(const code&) NOEXCEPT
 {
     BC_ASSERT_MSG(stranded(), "strand");
 
+    if (const auto error = seeds_.save())
+    {
+        LOGN("Failed to save seed cache, " << error.message());
+    }
+
     LOGN("Seed session complete.");
     unsubscribe_close();
 }
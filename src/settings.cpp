@@ -18,7 +18,9 @@
  */
 #include <bitcoin/network/settings.hpp>
 
+#include <algorithm>
 #include <filesystem>
+#include <string>
 #include <bitcoin/system.hpp>
 #include <bitcoin/network/async/async.hpp>
 #include <bitcoin/network/config/config.hpp>
@@ -37,6 +39,8 @@ static_assert(heading::maximum_payload(level::canonical, false) == 1'800'003);
 // Common default values (no settings context).
 settings::settings() NOEXCEPT
   : threads(1),
+    threads_maximum(0),
+    thread_delay_microseconds(1000),
     address_upper(10),
     address_lower(5),
     protocol_maximum(level::maximum_protocol),
@@ -47,24 +51,107 @@ settings::settings() NOEXCEPT
     enable_address(false),
     enable_alert(false),
     enable_reject(false),
+    enable_send_headers(false),
+    enable_wtxid_relay(false),
+    enable_reconciliation(false),
     enable_transaction(false),
     enable_ipv6(false),
     enable_loopback(false),
     validate_checksum(false),
+    retain_payload(false),
+    lazy_inactivity(false),
+    coarse_time(false),
+    payload_huge_pages(false),
+    context_per_thread(false),
+    compact_high_bandwidth(false),
+    inbound_eviction(false),
+    tcp_no_delay(true),
+    deduplicate_sends(false),
+    pool_sends(false),
+    peer_compression(false),
+    reuse_port(false),
+    outbound_diversity(false),
+    trusted_peers(false),
     identifier(0),
     inbound_connections(0),
+    accept_rate(0),
+    accept_group_rate(0),
     outbound_connections(10),
     connect_batch_size(5),
+    connect_batch_minimum(1),
+    outbound_standby(0),
+    block_relay_connections(0),
+    anchor_connections(0),
+    anchor_lifetime_minutes(10),
     retry_timeout_seconds(1),
+    retry_maximum_seconds(0),
     connect_timeout_seconds(5),
+    connect_stagger_milliseconds(250),
+    resolve_threads(0),
+    resolve_cache_seconds(300),
+    resolve_negative_seconds(30),
     handshake_timeout_seconds(30),
+    timeout_minimum_milliseconds(0),
     seeding_timeout_seconds(30),
     channel_heartbeat_minutes(5),
     channel_inactivity_minutes(10),
     channel_expiration_minutes(1440),
+    channel_jitter_percent(50),
     host_pool_capacity(0),
+    host_checkpoint_minutes(0),
+    host_sweep_minutes(0),
+    host_sweep_slice(1000),
+    host_expiration_days(30),
+    host_failure_limit(0),
+    ban_threshold(100),
+    ban_minutes(1440),
+    ban_decay_minutes(60),
+    address_refresh_seconds(60),
+    address_snapshots(4),
     rate_limit(1024),
     minimum_buffer(4'000'000),
+    payload_pool_capacity(16),
+    buffer_retain_bytes(65'536),
+    buffer_idle_seconds(60),
+    read_quantum_microseconds(0),
+    memory_budget_megabytes(0),
+    upload_limit(0),
+    upload_target_megabytes(0),
+    gather_write_count(32),
+    gather_write_bytes(262'144),
+    deserialize_threshold(0),
+    deserialize_threads(1),
+    compute_threads(0),
+    read_chunk_bytes(0),
+    read_ahead_bytes(0),
+    write_slice_bytes(0),
+    compression_minimum(1'024),
+    checksum_batch_microseconds(0),
+    send_high_water(0),
+    send_low_water(0),
+    send_grace_seconds(0),
+    shutdown_drain_seconds(0),
+    broadcast_fanout(0),
+    trickle_milliseconds(0),
+    announce_capacity(0),
+    seen_capacity(0),
+    serve_cache_megabytes(0),
+    export_megabytes(64),
+    reconciliation_seconds(8),
+    reconciliation_flood_percent(10),
+    trace_sample(1),
+    send_buffer_bytes(0),
+    receive_buffer_bytes(0),
+    keep_alive_seconds(0),
+    not_sent_low_water(0),
+    busy_poll_microseconds(0),
+    fast_open_queue(0),
+    seed_cache_minutes(0),
+    seed_stagger_milliseconds(0),
+    fetch_window(16),
+    fetch_stall_seconds(10),
+    address_relay_milliseconds(0),
+    feeler_seconds(0),
     user_agent(BC_USER_AGENT)
 {
 }
@@ -123,6 +210,75 @@ void settings::initialize() NOEXCEPT
 
     // Dynamic conversion of peers is O(N^2), so set on initialize.
     friends = system::projection<config::authorities>(peers);
+
+    // Linear scans of large subnet lists are replaced by prefix tries.
+    blacklisted_ = { blacklists };
+    whitelisted_ = { whitelists };
+    peered_ = { friends };
+    rejected_ = { rejections() };
+    compiled_ = true;
+}
+
+void settings::reload(const settings& update) NOEXCEPT
+{
+    blacklists = update.blacklists;
+    whitelists = update.whitelists;
+    traces = update.traces;
+    inbound_connections = update.inbound_connections;
+    rate_limit = update.rate_limit;
+    trace_sample = update.trace_sample;
+    send_high_water = update.send_high_water;
+    send_low_water = update.send_low_water;
+    send_grace_seconds = update.send_grace_seconds;
+    retry_timeout_seconds = update.retry_timeout_seconds;
+    retry_maximum_seconds = update.retry_maximum_seconds;
+    connect_timeout_seconds = update.connect_timeout_seconds;
+    handshake_timeout_seconds = update.handshake_timeout_seconds;
+    channel_heartbeat_minutes = update.channel_heartbeat_minutes;
+    channel_inactivity_minutes = update.channel_inactivity_minutes;
+    channel_expiration_minutes = update.channel_expiration_minutes;
+    channel_jitter_percent = update.channel_jitter_percent;
+    fetch_stall_seconds = update.fetch_stall_seconds;
+    feeler_seconds = update.feeler_seconds;
+    host_sweep_slice = update.host_sweep_slice;
+    host_expiration_days = update.host_expiration_days;
+    host_failure_limit = update.host_failure_limit;
+
+    // Friends are projected from peers, which do not reload.
+    if (compiled_)
+    {
+        blacklisted_ = { blacklists };
+        whitelisted_ = { whitelists };
+        rejected_ = { rejections() };
+    }
+}
+
+settings::cptr settings::retain() const NOEXCEPT
+{
+    return weak_from_this().lock();
+}
+
+// private
+// The configured timeout is the maximum, and applies if not adaptive.
+steady_clock::duration settings::adapted(const timeout_estimator& estimator,
+    const steady_clock::duration& maximum) const NOEXCEPT
+{
+    if (is_zero(timeout_minimum_milliseconds))
+        return maximum;
+
+    return estimator.estimate(milliseconds(timeout_minimum_milliseconds),
+        maximum);
+}
+
+// private
+// Blacklisted and peered authorities both exclude, so share one trie.
+config::authorities settings::rejections() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    config::authorities out{ blacklists };
+    out.insert(out.end(), friends.begin(), friends.end());
+    return out;
+    BC_POP_WARNING()
 }
 
 bool settings::inbound_enabled() const NOEXCEPT
@@ -161,17 +317,53 @@ steady_clock::duration settings::retry_timeout() const NOEXCEPT
     return milliseconds{ system::pseudo_random::next(from, to) };
 }
 
-// Randomized from 50% to maximum milliseconds (specified in seconds).
-steady_clock::duration settings::connect_timeout() const NOEXCEPT
+// Retry timeout doubled for each prior attempt, up to the maximum (if above
+// retry timeout), randomized from 50% to maximum milliseconds.
+steady_clock::duration settings::retry_backoff(size_t attempts) const NOEXCEPT
+{
+    const auto maximum = std::max(retry_maximum_seconds, retry_timeout_seconds);
+    const auto shift = std::min<size_t>(attempts, 32);
+    const auto base = std::min<uint64_t>(
+        uint64_t{ retry_timeout_seconds } << shift, maximum);
+
+    const auto from = base * 500_u64;
+    const auto to = base * 1'000_u64;
+    return milliseconds{ system::pseudo_random::next(from, to) };
+}
+
+// Randomized from 50% to maximum milliseconds (specified in seconds). With a
+// timeout minimum the maximum adapts to recently observed connect durations.
+steady_clock::duration settings::connect_timeout(
+    const timeout_estimator& connects) const NOEXCEPT
 {
-    const auto from = connect_timeout_seconds * 500_u64;
-    const auto to = connect_timeout_seconds * 1'000_u64;
+    const auto maximum = std::chrono::duration_cast<milliseconds>(
+        adapted(connects, seconds(connect_timeout_seconds))).count();
+    const auto to = possible_narrow_sign_cast<uint64_t>(maximum);
+    const auto from = to / two;
     return milliseconds{ system::pseudo_random::next(from, to) };
 }
 
-steady_clock::duration settings::channel_handshake() const NOEXCEPT
+// Address family stagger (RFC 8305 connection attempt delay).
+steady_clock::duration settings::connect_stagger() const NOEXCEPT
 {
-    return seconds(handshake_timeout_seconds);
+    return milliseconds(connect_stagger_milliseconds);
+}
+
+steady_clock::duration settings::resolve_cache() const NOEXCEPT
+{
+    return seconds(resolve_cache_seconds);
+}
+
+steady_clock::duration settings::resolve_negative() const NOEXCEPT
+{
+    return seconds(resolve_negative_seconds);
+}
+
+// With a timeout minimum the timeout adapts to recent handshake durations.
+steady_clock::duration settings::channel_handshake(
+    const timeout_estimator& handshakes) const NOEXCEPT
+{
+    return adapted(handshakes, seconds(handshake_timeout_seconds));
 }
 
 steady_clock::duration settings::channel_germination() const NOEXCEPT
@@ -179,6 +371,11 @@ steady_clock::duration settings::channel_germination() const NOEXCEPT
     return seconds(seeding_timeout_seconds);
 }
 
+steady_clock::duration settings::anchor_lifetime() const NOEXCEPT
+{
+    return minutes(anchor_lifetime_minutes);
+}
+
 steady_clock::duration settings::channel_heartbeat() const NOEXCEPT
 {
     return minutes(channel_heartbeat_minutes);
@@ -194,6 +391,107 @@ steady_clock::duration settings::channel_expiration() const NOEXCEPT
     return minutes(channel_expiration_minutes);
 }
 
+// Randomized from (100 - percent)% to maximum milliseconds, zero is fixed.
+steady_clock::duration settings::staggered(
+    const steady_clock::duration& span) const NOEXCEPT
+{
+    const auto percent = std::min(channel_jitter_percent, 100u);
+    const auto to = std::chrono::duration_cast<milliseconds>(span).count();
+    if (is_zero(percent) || to <= 0)
+        return span;
+
+    const auto from = to - to / 100 * percent - to % 100 * percent / 100;
+    return milliseconds{ system::pseudo_random::next(from, to) };
+}
+
+steady_clock::duration settings::host_checkpoint() const NOEXCEPT
+{
+    return minutes(host_checkpoint_minutes);
+}
+
+steady_clock::duration settings::host_sweep() const NOEXCEPT
+{
+    return minutes(host_sweep_minutes);
+}
+
+steady_clock::duration settings::host_expiration() const NOEXCEPT
+{
+    return hours(24u * host_expiration_days);
+}
+
+steady_clock::duration settings::ban_duration() const NOEXCEPT
+{
+    return minutes(ban_minutes);
+}
+
+steady_clock::duration settings::ban_decay() const NOEXCEPT
+{
+    return minutes(ban_decay_minutes);
+}
+
+steady_clock::duration settings::address_refresh() const NOEXCEPT
+{
+    return seconds(address_refresh_seconds);
+}
+
+steady_clock::duration settings::shutdown_drain() const NOEXCEPT
+{
+    return seconds(shutdown_drain_seconds);
+}
+
+steady_clock::duration settings::send_grace() const NOEXCEPT
+{
+    return seconds(send_grace_seconds);
+}
+
+steady_clock::duration settings::buffer_idle() const NOEXCEPT
+{
+    return seconds(buffer_idle_seconds);
+}
+
+steady_clock::duration settings::read_quantum() const NOEXCEPT
+{
+    return microseconds(read_quantum_microseconds);
+}
+
+// Randomized from 50% to maximum microseconds (specified in milliseconds).
+steady_clock::duration settings::channel_trickle() const NOEXCEPT
+{
+    const auto from = trickle_milliseconds * 500_u64;
+    const auto to = trickle_milliseconds * 1'000_u64;
+    return microseconds{ system::pseudo_random::next(from, to) };
+}
+
+steady_clock::duration settings::channel_reconciliation() const NOEXCEPT
+{
+    return seconds(reconciliation_seconds);
+}
+
+steady_clock::duration settings::seed_stagger() const NOEXCEPT
+{
+    return milliseconds(seed_stagger_milliseconds);
+}
+
+steady_clock::duration settings::fetch_stall() const NOEXCEPT
+{
+    return seconds(fetch_stall_seconds);
+}
+
+steady_clock::duration settings::address_relay() const NOEXCEPT
+{
+    return milliseconds(address_relay_milliseconds);
+}
+
+steady_clock::duration settings::feeler_interval() const NOEXCEPT
+{
+    return seconds(feeler_seconds);
+}
+
+steady_clock::duration settings::thread_delay() const NOEXCEPT
+{
+    return microseconds(thread_delay_microseconds);
+}
+
 size_t settings::minimum_address_count() const NOEXCEPT
 {
     // Cannot overflow as long as both are uint16_t.
@@ -202,6 +500,19 @@ size_t settings::minimum_address_count() const NOEXCEPT
     BC_POP_WARNING()
 }
 
+socket::options settings::socket_options() const NOEXCEPT
+{
+    return
+    {
+        tcp_no_delay,
+        send_buffer_bytes,
+        receive_buffer_bytes,
+        keep_alive_seconds,
+        not_sent_low_water,
+        busy_poll_microseconds
+    };
+}
+
 std::filesystem::path settings::file() const NOEXCEPT
 {
     BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
@@ -209,6 +520,38 @@ std::filesystem::path settings::file() const NOEXCEPT
     BC_POP_WARNING()
 }
 
+std::filesystem::path settings::seeds_file() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    return path / "seeds.cache";
+    BC_POP_WARNING()
+}
+
+std::filesystem::path settings::bans_file() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    return path / "bans.cache";
+    BC_POP_WARNING()
+}
+
+std::filesystem::path settings::anchors_file() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    return path / "anchors.cache";
+    BC_POP_WARNING()
+}
+
+std::filesystem::path settings::capture_file(
+    uint64_t identifier) const NOEXCEPT
+{
+    if (capture_path.empty())
+        return {};
+
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    return capture_path / (std::to_string(identifier) + ".capture");
+    BC_POP_WARNING()
+}
+
 bool settings::disabled(const address_item& item) const NOEXCEPT
 {
     return !enable_ipv6 && config::is_v6(item.ip);
@@ -226,22 +569,40 @@ bool settings::unsupported(const address_item& item) const NOEXCEPT
 
 bool settings::blacklisted(const address_item& item) const NOEXCEPT
 {
-    return contains(blacklists, item);
+    if (!blocklist_path.empty() && blocked().contains(item))
+        return true;
+
+    return compiled_ ? blacklisted_.contains(item) :
+        contains(blacklists, item);
 }
 
 bool settings::whitelisted(const address_item& item) const NOEXCEPT
 {
-    return whitelists.empty() || contains(whitelists, item);
+    return compiled_ ? whitelisted_.empty() || whitelisted_.contains(item) :
+        whitelists.empty() || contains(whitelists, item);
 }
 
 bool settings::peered(const address_item& item) const NOEXCEPT
 {
     // Friends should be mapped from peers by initialize().
-    return contains(friends, item);
+    return compiled_ ? peered_.contains(item) : contains(friends, item);
 }
 
+// Compiled filters evaluate in one pass over the item: one services mask
+// (insufficient or unsupported), one trie for blacklisted or peered and the
+// whitelist trie. (item & (minimum | invalid)) != minimum is exactly
+// insufficient(item) || unsupported(item), regardless of bit overlap.
 bool settings::excluded(const address_item& item) const NOEXCEPT
 {
+    if (compiled_)
+        return !is_specified(item)
+            || ((item.services & (services_minimum | invalid_services)) !=
+                services_minimum)
+            || disabled(item)
+            || rejected_.contains(item)
+            || (!blocklist_path.empty() && blocked().contains(item))
+            || !(whitelisted_.empty() || whitelisted_.contains(item));
+
     return !is_specified(item)
         || disabled(item)
         || insufficient(item)
@@ -251,5 +612,17 @@ bool settings::excluded(const address_item& item) const NOEXCEPT
         || !whitelisted(item);
 }
 
+// Channels to traced authorities log every message regardless of sampling.
+bool settings::traced(const address_item& item) const NOEXCEPT
+{
+    return contains(traces, item);
+}
+
+// Channels to peered authorities (own infrastructure) take the fast path.
+bool settings::trusted(const address_item& item) const NOEXCEPT
+{
+    return trusted_peers && peered(item);
+}
+
 } // namespace network
 } // namespace libbitcoin
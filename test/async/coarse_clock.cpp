@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(coarse_clock_tests)
+
+BOOST_AUTO_TEST_CASE(coarse_clock__steady__not_running__precise)
+{
+    BOOST_REQUIRE(!coarse_clock::running());
+    const auto before = steady_clock::now();
+    const auto now = coarse_clock::steady();
+    BOOST_REQUIRE(now >= before);
+    BOOST_REQUIRE(now <= steady_clock::now());
+}
+
+BOOST_AUTO_TEST_CASE(coarse_clock__start__running__within_resolution)
+{
+    coarse_clock::start();
+    BOOST_REQUIRE(coarse_clock::running());
+
+    constexpr auto tolerance = coarse_clock::resolution * 100;
+    const auto steady = coarse_clock::steady();
+    BOOST_REQUIRE(steady <= steady_clock::now());
+    BOOST_REQUIRE(steady_clock::now() - steady < tolerance);
+
+    const auto wall = coarse_clock::wall();
+    BOOST_REQUIRE(wall_clock::now() - wall < tolerance);
+    BOOST_REQUIRE(coarse_clock::zulu() <=
+        wall_clock::to_time_t(wall_clock::now()));
+
+    coarse_clock::stop();
+    BOOST_REQUIRE(!coarse_clock::running());
+}
+
+BOOST_AUTO_TEST_CASE(coarse_clock__stop__paired__running_until_last)
+{
+    coarse_clock::start();
+    coarse_clock::start();
+    coarse_clock::stop();
+    BOOST_REQUIRE(coarse_clock::running());
+    coarse_clock::stop();
+    BOOST_REQUIRE(!coarse_clock::running());
+
+    // An unpaired stop is ignored.
+    coarse_clock::stop();
+    BOOST_REQUIRE(!coarse_clock::running());
+}
+
+BOOST_AUTO_TEST_CASE(coarse_clock__steady__running__advances)
+{
+    coarse_clock::start();
+    const auto first = coarse_clock::steady();
+    std::this_thread::sleep_for(coarse_clock::resolution * 20);
+    BOOST_REQUIRE(coarse_clock::steady() > first);
+    coarse_clock::stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -402,6 +402,46 @@ BOOST_AUTO_TEST_CASE(desubscriber__notify__twice_false__expected)
     BOOST_REQUIRE(result);
 }
 
+BOOST_AUTO_TEST_CASE(desubscriber__notify__subscribed_by_handler__deferred_to_next)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    test_desubscriber instance(strand);
+
+    auto inner = zero;
+    auto result = true;
+    size_t first_size{};
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        result &= !instance.subscribe([&](code, size_t) NOEXCEPT
+        {
+            result &= !instance.subscribe([&](code, size_t) NOEXCEPT
+            {
+                ++inner;
+                return true;
+            }, 1);
+
+            return false;
+        }, 0);
+
+        instance.notify({}, {});
+        first_size = instance.size();
+        result &= is_zero(inner);
+
+        instance.notify({}, {});
+        result &= is_one(inner);
+
+        // Prevents unstopped assertion (uncleared).
+        instance.stop_default(error::address_blocked);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE_EQUAL(first_size, 1u);
+    BOOST_REQUIRE_EQUAL(inner, 2u);
+    BOOST_REQUIRE(result);
+}
+
 BOOST_AUTO_TEST_CASE(desubscriber__notify_one__stopped__dropped)
 {
     threadpool pool(2);
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(handler_memory_tests)
+
+BOOST_AUTO_TEST_CASE(handler_memory__allocate__fits__storage_recycled)
+{
+    handler_memory instance{};
+    BOOST_REQUIRE(!instance.in_use());
+
+    const auto first = instance.allocate(42);
+    BOOST_REQUIRE(instance.in_use());
+    instance.deallocate(first);
+    BOOST_REQUIRE(!instance.in_use());
+
+    const auto second = instance.allocate(handler_memory::capacity);
+    BOOST_REQUIRE(second == first);
+    instance.deallocate(second);
+    BOOST_REQUIRE(!instance.in_use());
+}
+
+BOOST_AUTO_TEST_CASE(handler_memory__allocate__in_use__heap)
+{
+    handler_memory instance{};
+    const auto first = instance.allocate(42);
+    const auto second = instance.allocate(42);
+    BOOST_REQUIRE(second != first);
+
+    instance.deallocate(second);
+    BOOST_REQUIRE(instance.in_use());
+    instance.deallocate(first);
+    BOOST_REQUIRE(!instance.in_use());
+}
+
+BOOST_AUTO_TEST_CASE(handler_memory__allocate__oversized__heap)
+{
+    handler_memory instance{};
+    const auto pointer = instance.allocate(add1(handler_memory::capacity));
+    BOOST_REQUIRE(!instance.in_use());
+    instance.deallocate(pointer);
+}
+
+BOOST_AUTO_TEST_CASE(handler_memory__make_allocated__invoked__associated)
+{
+    handler_memory memory{};
+    size_t value{};
+    auto handler = make_allocated(memory, [&](size_t size) NOEXCEPT
+    {
+        value = size;
+    });
+
+    auto allocator = boost::asio::get_associated_allocator(handler);
+    const auto pointer = allocator.allocate(1);
+    BOOST_REQUIRE(memory.in_use());
+    allocator.deallocate(pointer, 1);
+    BOOST_REQUIRE(!memory.in_use());
+
+    handler(42u);
+    BOOST_REQUIRE_EQUAL(value, 42u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
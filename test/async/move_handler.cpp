@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(move_handler_tests)
+
+typedef move_handler<bool(const code&, size_t)> test_handler;
+
+BOOST_AUTO_TEST_CASE(move_handler__construct__default__empty)
+{
+    const test_handler instance{};
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE(!instance.inlined());
+}
+
+BOOST_AUTO_TEST_CASE(move_handler__construct__small_lambda__inlined_invoked)
+{
+    size_t value{};
+    const test_handler instance([&](const code& ec, size_t size) NOEXCEPT
+    {
+        value = size;
+        return !ec;
+    });
+
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE(instance.inlined());
+    BOOST_REQUIRE(instance(error::success, 42));
+    BOOST_REQUIRE_EQUAL(value, 42u);
+}
+
+BOOST_AUTO_TEST_CASE(move_handler__construct__large_lambda__allocated_invoked)
+{
+    const std::array<uint8_t, 2 * move_handler_capacity> large{ 42 };
+    const test_handler instance([large](const code&, size_t) NOEXCEPT
+    {
+        return large.front() == 42;
+    });
+
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE(!instance.inlined());
+    BOOST_REQUIRE(instance(error::success, 0));
+}
+
+BOOST_AUTO_TEST_CASE(move_handler__move__shared_state__moved_retained)
+{
+    const auto pointer = std::make_shared<size_t>(42);
+    test_handler instance([pointer](const code&, size_t size) NOEXCEPT
+    {
+        return *pointer == size;
+    });
+
+    BOOST_REQUIRE_EQUAL(pointer.use_count(), 2);
+    test_handler moved(std::move(instance));
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE(moved(error::success, 42));
+    BOOST_REQUIRE_EQUAL(pointer.use_count(), 2);
+
+    moved = nullptr;
+    BOOST_REQUIRE(!moved);
+    BOOST_REQUIRE_EQUAL(pointer.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(move_handler__construct__move_only__invoked)
+{
+    auto unique = std::make_unique<size_t>(42);
+    const test_handler instance([unique = std::move(unique)](const code&,
+        size_t size) NOEXCEPT
+    {
+        return *unique == size;
+    });
+
+    BOOST_REQUIRE(instance(error::success, 42));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
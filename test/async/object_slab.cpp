@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(object_slab_tests)
+
+BOOST_AUTO_TEST_CASE(object_slab__deallocate__within_limit__reused)
+{
+    object_slab instance{ 64, 1 };
+    const auto block = instance.allocate();
+    BOOST_REQUIRE(!is_null(block));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+
+    instance.deallocate(block);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(), block);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+    instance.deallocate(block);
+}
+
+BOOST_AUTO_TEST_CASE(object_slab__deallocate__over_limit__freed)
+{
+    object_slab instance{ 64, 1 };
+    const auto block1 = instance.allocate();
+    const auto block2 = instance.allocate();
+    instance.deallocate(block1);
+    instance.deallocate(block2);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(object_slab__deallocate__null__not_retained)
+{
+    object_slab instance{ 64, 1 };
+    instance.deallocate(nullptr);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+struct slab_object
+{
+    size_t value;
+};
+
+BOOST_AUTO_TEST_CASE(slab_allocator__allocate_shared__released__storage_reused)
+{
+    const slab_allocator<slab_object> allocator{};
+    auto first = std::allocate_shared<slab_object>(allocator, 42u);
+    BOOST_REQUIRE_EQUAL(first->value, 42u);
+
+    const auto address = first.get();
+    first.reset();
+
+    const auto second = std::allocate_shared<slab_object>(allocator, 24u);
+    BOOST_REQUIRE_EQUAL(second->value, 24u);
+    BOOST_REQUIRE_EQUAL(second.get(), address);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
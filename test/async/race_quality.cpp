@@ -153,4 +153,35 @@ BOOST_AUTO_TEST_CASE(race_quality__finish__3_of_3__resources_deleted)
     BOOST_REQUIRE(deleted);
 }
 
+BOOST_AUTO_TEST_CASE(race_quality__start__sized__size_runners)
+{
+    race_quality_t race_quality{ 3 };
+    BOOST_REQUIRE(race_quality.start(1, [&](code, size_t) NOEXCEPT {}));
+    BOOST_REQUIRE(race_quality.running());
+    BOOST_REQUIRE(race_quality.finish({}, {}));
+    BOOST_REQUIRE(!race_quality.running());
+}
+
+BOOST_AUTO_TEST_CASE(race_quality__finish__restarted_by_handler__restarted)
+{
+    race_quality_t race_quality{ 1 };
+    size_t second{};
+    BOOST_REQUIRE(race_quality.start([&](code, size_t) NOEXCEPT
+    {
+        // The race is cleared before invocation, so it may be recycled.
+        BOOST_REQUIRE(!race_quality.running());
+        BOOST_REQUIRE(race_quality.start(2, [&](code, size_t value) NOEXCEPT
+        {
+            second = value;
+        }));
+    }));
+
+    BOOST_REQUIRE(race_quality.finish({}, 1));
+    BOOST_REQUIRE(race_quality.running());
+    BOOST_REQUIRE(race_quality.finish({}, 2));
+    BOOST_REQUIRE(!race_quality.finish({}, 3));
+    BOOST_REQUIRE(!race_quality.running());
+    BOOST_REQUIRE_EQUAL(second, 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -319,4 +319,42 @@ BOOST_AUTO_TEST_CASE(race_volume__finish__late_sufficiency__resources_deleted_as
     BOOST_REQUIRE(bar_deleted);
 }
 
+BOOST_AUTO_TEST_CASE(race_volume__sufficient__unstarted__false)
+{
+    race_volume_t race_volume{ 2, 10 };
+    BOOST_REQUIRE(!race_volume.sufficient(10));
+}
+
+BOOST_AUTO_TEST_CASE(race_volume__sufficient__reached__sufficient_before_complete)
+{
+    race_volume_t race_volume{ 2, 10 };
+
+    code complete{ error::unknown };
+    code sufficient{ error::unknown };
+    BOOST_REQUIRE(race_volume.start(
+        [&](code ec) NOEXCEPT
+        {
+            sufficient = ec;
+        },
+        [&](code ec) NOEXCEPT
+        {
+            complete = ec;
+        }));
+
+    BOOST_REQUIRE(race_volume.sufficient(9));
+    BOOST_REQUIRE_EQUAL(sufficient, error::unknown);
+    BOOST_REQUIRE(race_volume.sufficient(10));
+    BOOST_REQUIRE_EQUAL(sufficient, error::success);
+    BOOST_REQUIRE_EQUAL(complete, error::unknown);
+    BOOST_REQUIRE(race_volume.running());
+
+    // Sufficient is not invoked again by finishers.
+    sufficient = error::unknown;
+    BOOST_REQUIRE(race_volume.finish(0));
+    BOOST_REQUIRE(race_volume.finish(0));
+    BOOST_REQUIRE_EQUAL(sufficient, error::unknown);
+    BOOST_REQUIRE_EQUAL(complete, error::success);
+    BOOST_REQUIRE(!race_volume.running());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -98,4 +98,14 @@ BOOST_AUTO_TEST_CASE(thread__set_thread_priorites__all__set_as_expected)
 
 #endif
 
+BOOST_AUTO_TEST_CASE(thread__set_affinity__empty_set__true)
+{
+    BOOST_REQUIRE(set_affinity(processor_set{}, 42));
+}
+
+BOOST_AUTO_TEST_CASE(thread__set_affinity__excessive_processor__false)
+{
+    BOOST_REQUIRE(!set_affinity(max_uint32));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(thread_context_tests)
+
+BOOST_AUTO_TEST_CASE(thread_context__services__shared__empty)
+{
+    thread_context threads{ 2 };
+    BOOST_REQUIRE_EQUAL(threads.services().size(), 0u);
+    threads.stop();
+    BOOST_REQUIRE(threads.join());
+}
+
+BOOST_AUTO_TEST_CASE(thread_context__services__per_thread__thread_count)
+{
+    thread_context threads{ 3, true };
+    BOOST_REQUIRE_EQUAL(threads.services().size(), 3u);
+    BOOST_REQUIRE(&threads.services().service() != &threads.service());
+    threads.stop();
+    BOOST_REQUIRE(threads.join());
+}
+
+BOOST_AUTO_TEST_CASE(thread_context__service__posted__executed)
+{
+    thread_context threads{ 1 };
+    std::promise<bool> promise{};
+    boost::asio::post(threads.service(), [&]() NOEXCEPT
+    {
+        promise.set_value(true);
+    });
+
+    BOOST_REQUIRE(promise.get_future().get());
+    threads.stop();
+    BOOST_REQUIRE(threads.join());
+}
+
+BOOST_AUTO_TEST_CASE(thread_context__stopped__stop__true)
+{
+    thread_context threads{ 1 };
+    BOOST_REQUIRE(!threads.stopped());
+    threads.stop();
+    BOOST_REQUIRE(threads.stopped());
+    BOOST_REQUIRE(threads.join());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -55,4 +55,67 @@ BOOST_AUTO_TEST_CASE(threadpool__join__stopped__stopped)
     BOOST_REQUIRE(pool.service().stopped());
 }
 
+BOOST_AUTO_TEST_CASE(threadpool__join_deadline__outstanding_work__abandoned)
+{
+    threadpool pool{ 2 };
+    asio::steady_timer timer{ pool.service(), std::chrono::hours(1) };
+    timer.async_wait([](const error::boost_code&) NOEXCEPT {});
+    pool.stop();
+
+    const auto deadline = steady_clock::now() + std::chrono::milliseconds(10);
+    BOOST_REQUIRE(pool.join(deadline));
+    BOOST_REQUIRE(pool.service().stopped());
+}
+
+BOOST_AUTO_TEST_CASE(threadpool__size__constructed__thread_count)
+{
+    threadpool pool{ 3 };
+    BOOST_REQUIRE_EQUAL(pool.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(threadpool__adapt__not_adaptive__unchanged)
+{
+    threadpool pool{ 1 };
+    pool.adapt(2, std::chrono::microseconds(1));
+    boost::asio::post(pool.service(), []() NOEXCEPT
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(threadpool__adapt__maximum_not_above_minimum__unchanged)
+{
+    threadpool pool{ 2, thread_priority::normal, {}, true };
+    pool.adapt(2, std::chrono::microseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    BOOST_REQUIRE_EQUAL(pool.size(), 2u);
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(threadpool__adapt__delayed_handlers__grows_to_maximum)
+{
+    threadpool pool{ 1, thread_priority::normal, {}, true };
+    pool.adapt(2, std::chrono::microseconds(1));
+
+    // Block the only thread so that the sampler observes queue delay.
+    boost::asio::post(pool.service(), []() NOEXCEPT
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    });
+
+    const auto deadline = steady_clock::now() + std::chrono::seconds(5);
+    while (pool.size() < 2u && steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    BOOST_REQUIRE_EQUAL(pool.size(), 2u);
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(threadpools_tests)
+
+BOOST_AUTO_TEST_CASE(threadpools__construct__default__empty_joins)
+{
+    threadpools pools{};
+    BOOST_REQUIRE_EQUAL(pools.size(), 0u);
+    BOOST_REQUIRE(pools.join());
+}
+
+BOOST_AUTO_TEST_CASE(threadpools__service__two_pools__round_robin)
+{
+    threadpools pools{ 2, thread_priority::low };
+    BOOST_REQUIRE_EQUAL(pools.size(), 2u);
+
+    auto& first = pools.service();
+    auto& second = pools.service();
+    BOOST_REQUIRE(&first != &second);
+    BOOST_REQUIRE(&pools.service() == &first);
+    BOOST_REQUIRE(&pools.service() == &second);
+}
+
+BOOST_AUTO_TEST_CASE(threadpools__service__indexed__round_robin_order)
+{
+    threadpools pools{ 2, thread_priority::low };
+    BOOST_REQUIRE(&pools.service(0) == &pools.service());
+    BOOST_REQUIRE(&pools.service(1) == &pools.service());
+    BOOST_REQUIRE(&pools.service(0) != &pools.service(1));
+}
+
+BOOST_AUTO_TEST_CASE(threadpools__join__stopped__joins)
+{
+    threadpools pools{ 3 };
+    pools.stop();
+    BOOST_REQUIRE(pools.join());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
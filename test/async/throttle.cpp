@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(throttle_tests)
+
+BOOST_AUTO_TEST_CASE(throttle__construct__default__unlimited)
+{
+    throttle instance{};
+    BOOST_REQUIRE(instance.unlimited());
+    BOOST_REQUIRE(instance.consume(max_size_t));
+    BOOST_REQUIRE(instance.delay(max_size_t) == throttle::duration{});
+}
+
+BOOST_AUTO_TEST_CASE(throttle__consume__burst__exhausted)
+{
+    throttle instance{ 3, seconds{ 1 } };
+    const auto now = steady_clock::now();
+    BOOST_REQUIRE(!instance.unlimited());
+    BOOST_REQUIRE(instance.full(now));
+    BOOST_REQUIRE(instance.consume(1, now));
+    BOOST_REQUIRE(instance.consume(2, now));
+    BOOST_REQUIRE(!instance.consume(1, now));
+    BOOST_REQUIRE(!instance.full(now));
+}
+
+BOOST_AUTO_TEST_CASE(throttle__consume__elapsed__replenished)
+{
+    throttle instance{ 4, seconds{ 1 } };
+    const auto now = steady_clock::now();
+    BOOST_REQUIRE(instance.consume(4, now));
+    BOOST_REQUIRE(!instance.consume(1, now));
+    BOOST_REQUIRE(instance.consume(2, now + milliseconds{ 500 }));
+    BOOST_REQUIRE(!instance.consume(1, now + milliseconds{ 500 }));
+    BOOST_REQUIRE(instance.full(now + seconds{ 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(throttle__consume__oversized_full__drained)
+{
+    throttle instance{ 2, seconds{ 1 } };
+    const auto now = steady_clock::now();
+    BOOST_REQUIRE(instance.consume(5, now));
+    BOOST_REQUIRE(!instance.consume(5, now));
+    BOOST_REQUIRE(!instance.consume(1, now));
+}
+
+BOOST_AUTO_TEST_CASE(throttle__delay__empty__time_to_replenish)
+{
+    throttle instance{ 10, seconds{ 1 } };
+    const auto now = steady_clock::now();
+    BOOST_REQUIRE(instance.delay(1, now) == throttle::duration{});
+    BOOST_REQUIRE(instance.consume(10, now));
+    BOOST_REQUIRE(instance.delay(1, now) == milliseconds{ 100 });
+    BOOST_REQUIRE(instance.delay(5, now) == milliseconds{ 500 });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -402,4 +402,39 @@ BOOST_AUTO_TEST_CASE(unsubscriber__notify__twice_false__expected)
     BOOST_REQUIRE_EQUAL(notify_result.second, expected);
 }
 
+BOOST_AUTO_TEST_CASE(unsubscriber__notify__stopped_by_handler__cleared)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    test_unsubscriber instance(strand);
+
+    auto count = zero;
+    auto result = true;
+    size_t size{ 42 };
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        result &= !instance.subscribe([&](code, size_t) NOEXCEPT
+        {
+            ++count;
+            instance.stop_default(error::address_blocked);
+            return true;
+        });
+
+        result &= !instance.subscribe([&](code, size_t) NOEXCEPT
+        {
+            ++count;
+            return true;
+        });
+
+        instance.notify({}, {});
+        size = instance.size();
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE_EQUAL(size, zero);
+    BOOST_REQUIRE_EQUAL(count, 2u);
+    BOOST_REQUIRE(result);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
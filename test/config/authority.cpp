@@ -475,6 +475,37 @@ BOOST_AUTO_TEST_CASE(authority__to_address_item2__parameters__expected)
     BOOST_REQUIRE(net_equal(host.to_address_item(expected.timestamp, expected.services), expected));
 }
 
+// to_key
+
+BOOST_AUTO_TEST_CASE(authority__to_key__ipv4_mapped_ip_address__expected)
+{
+    const messages::address_item item
+    {
+        42, 24, test_mapped_ip_address, 42,
+    };
+
+    const authority host(from_address(item.ip), item.port);
+    BOOST_REQUIRE(host.to_key() == messages::to_key(item));
+}
+
+BOOST_AUTO_TEST_CASE(authority__to_key__distinct_port__unequal)
+{
+    const authority host1(from_address(test_ipv6_address), 42);
+    const authority host2(from_address(test_ipv6_address), 24);
+    BOOST_REQUIRE(host1.to_key() != host2.to_key());
+}
+
+// hash
+
+BOOST_AUTO_TEST_CASE(authority__hash__distinct_port__equal)
+{
+    // Equality treats zero port as *, so hash excludes port.
+    const authority host1(from_address(test_ipv6_address), 42);
+    const authority host2(from_address(test_ipv6_address), 0);
+    BOOST_REQUIRE(host1 == host2);
+    BOOST_REQUIRE_EQUAL(std::hash<authority>{}(host1), std::hash<authority>{}(host2));
+}
+
 // bool
 
 BOOST_AUTO_TEST_CASE(authority__bool__default__false)
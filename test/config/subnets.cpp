@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(subnets_tests)
+
+using namespace network::config;
+
+BOOST_AUTO_TEST_CASE(subnets__construct__default__empty)
+{
+    const subnets instance{};
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE(is_zero(instance.size()));
+    BOOST_REQUIRE(!instance.contains(address{ "42.42.42.42" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__construct__authorities__expected_size)
+{
+    const subnets instance{ { authority{ "42.42.42.0/24" },
+        authority{ "[2020:db8::2]/64" }, authority{ "24.24.24.24:8333" } } };
+    BOOST_REQUIRE(!instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__ipv4_subnet__expected)
+{
+    const subnets instance{ { authority{ "42.42.42.0/24" } } };
+    BOOST_REQUIRE(instance.contains(address{ "42.42.42.42" }));
+    BOOST_REQUIRE(instance.contains(address{ "42.42.42.1:8333" }));
+    BOOST_REQUIRE(!instance.contains(address{ "42.42.43.42" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__ipv4_host__expected)
+{
+    const subnets instance{ { authority{ "24.24.24.24" } } };
+    BOOST_REQUIRE(instance.contains(address{ "24.24.24.24" }));
+    BOOST_REQUIRE(!instance.contains(address{ "24.24.24.25" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__ipv6_subnet__expected)
+{
+    const subnets instance{ { authority{ "[2020:db8::2]/64" } } };
+    BOOST_REQUIRE(instance.contains(address{ "[2020:db8::3]" }));
+    BOOST_REQUIRE(!instance.contains(address{ "[2020:db9::3]" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__ipv6_host__expected)
+{
+    const subnets instance{ { authority{ "[2020:db8::3]" } } };
+    BOOST_REQUIRE(instance.contains(address{ "[2020:db8::3]" }));
+    BOOST_REQUIRE(!instance.contains(address{ "[2020:db8::2]" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__ipv6_subnet_ipv4_host__false)
+{
+    // IPv4 hosts are not members of IPv6 subnets (as with is_member).
+    const subnets instance{ { authority{ "[::]/8" } } };
+    BOOST_REQUIRE(!instance.contains(address{ "42.42.42.42" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__port__expected_port_matching)
+{
+    const subnets instance{ { authority{ "24.24.24.24:8333" },
+        authority{ "42.42.42.42" } } };
+    BOOST_REQUIRE(instance.contains(address{ "24.24.24.24:8333" }));
+    BOOST_REQUIRE(instance.contains(address{ "24.24.24.24" }));
+    BOOST_REQUIRE(!instance.contains(address{ "24.24.24.24:8334" }));
+    BOOST_REQUIRE(instance.contains(address{ "42.42.42.42:8334" }));
+}
+
+BOOST_AUTO_TEST_CASE(subnets__contains__authority_equality__consistent)
+{
+    const authorities values{ authority{ "42.42.42.0/24" },
+        authority{ "[2020:db8::2]/64" }, authority{ "24.24.24.24:8333" } };
+    const subnets instance{ values };
+
+    for (const auto& host: { "42.42.42.42", "42.42.43.42", "[2020:db8::3]",
+        "[2020:db9::3]", "24.24.24.24:8333", "24.24.24.24:8334" })
+    {
+        const address value{ host };
+        const messages::address_item& item = value;
+        const auto expected = std::any_of(values.begin(), values.end(),
+            [&](const authority& subnet) NOEXCEPT
+            {
+                return subnet == item;
+            });
+
+        BOOST_REQUIRE_EQUAL(instance.contains(item), expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
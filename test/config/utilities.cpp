@@ -69,6 +69,36 @@ BOOST_AUTO_TEST_CASE(utilities__is_v6__loopback_mapped__false)
     BOOST_REQUIRE(!is_v6(mapped));
 }
 
+// to_group
+
+BOOST_AUTO_TEST_CASE(utilities__to_group__mapped__slash_16)
+{
+    constexpr asio::ipv6::bytes_type mapped1
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xff, 0xff, 42, 24, 1, 2
+    };
+    constexpr asio::ipv6::bytes_type mapped2
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xff, 0xff, 42, 24, 3, 4
+    };
+
+    static_assert(to_group(mapped1) == ((42u << 8) | 24u));
+    BOOST_REQUIRE_EQUAL(to_group(mapped1), to_group(mapped2));
+}
+
+BOOST_AUTO_TEST_CASE(utilities__to_group__v6__slash_32)
+{
+    constexpr asio::ipv6::bytes_type v6
+    {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    };
+
+    BOOST_REQUIRE_EQUAL(to_group(v6), 0x20010db8u);
+}
+
 // is_member
 
 BOOST_AUTO_TEST_CASE(utilities__is_member__defaults_zero__false)
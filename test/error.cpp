@@ -419,6 +419,24 @@ BOOST_AUTO_TEST_CASE(error_t__code__channel_inactive__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "channel inactive");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__channel_congested__true_exected_message)
+{
+    constexpr auto value = error::channel_congested;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "channel congested");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__channel_evicted__true_exected_message)
+{
+    constexpr auto value = error::channel_evicted;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "channel evicted");
+}
+
 BOOST_AUTO_TEST_CASE(error_t__code__channel_stopped__true_exected_message)
 {
     constexpr auto value = error::channel_stopped;
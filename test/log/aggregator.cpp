@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(aggregator_tests)
+
+BOOST_AUTO_TEST_CASE(aggregator__to_bucket__small_values__exact)
+{
+    BOOST_REQUIRE_EQUAL(aggregator::to_bucket(0), 0u);
+    BOOST_REQUIRE_EQUAL(aggregator::to_bucket(3), 3u);
+    BOOST_REQUIRE_EQUAL(aggregator::to_bucket(4), 4u);
+    BOOST_REQUIRE_EQUAL(aggregator::to_bucket(7), 7u);
+    BOOST_REQUIRE_EQUAL(aggregator::to_bucket(8), 8u);
+    BOOST_REQUIRE_EQUAL(aggregator::to_bucket(9), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(aggregator__to_upper__all_buckets__round_trip)
+{
+    for (size_t bucket = 0; bucket < aggregator::buckets; ++bucket)
+        BOOST_REQUIRE_EQUAL(aggregator::to_bucket(
+            aggregator::to_upper(bucket)), bucket);
+
+    BOOST_REQUIRE_EQUAL(aggregator::to_upper(sub1(aggregator::buckets)),
+        max_uint64);
+}
+
+BOOST_AUTO_TEST_CASE(aggregator__count__recorded__expected)
+{
+    aggregator instance{};
+    BOOST_REQUIRE_EQUAL(instance.count(events::ping_round_trip), 0u);
+
+    instance.record(events::ping_round_trip, 1000);
+    instance.record(events::ping_round_trip, 2000);
+    instance.record(events::channel_stop, 3);
+    BOOST_REQUIRE_EQUAL(instance.count(events::ping_round_trip), 2u);
+    BOOST_REQUIRE_EQUAL(instance.count(events::channel_stop), 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(events::handshake), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(aggregator__quantile__recorded__bucket_upper)
+{
+    aggregator instance{};
+    BOOST_REQUIRE_EQUAL(instance.quantile(events::handshake, 0.5), 0u);
+
+    for (uint64_t value = 1; value <= 100u; ++value)
+        instance.record(events::handshake, value);
+
+    // 50 is in bucket [48..55], 100 is in bucket [96..111].
+    BOOST_REQUIRE_EQUAL(instance.quantile(events::handshake, 0.5), 55u);
+    BOOST_REQUIRE_EQUAL(instance.quantile(events::handshake, 1.0), 111u);
+    BOOST_REQUIRE_EQUAL(instance.quantile(events::handshake, 0.0), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(aggregator__exposition__recorded__expected_lines)
+{
+    aggregator instance{};
+    instance.record(events::inbound_accept, 0);
+    instance.record(events::inbound_accept, 0);
+    instance.record(events::ping_round_trip, 5);
+    instance.record(events::channel_stop, 42);
+
+    const auto text = instance.exposition();
+    const auto has = [&](const std::string& line)
+    {
+        return text.find(line + "\n") != std::string::npos;
+    };
+
+    BOOST_REQUIRE(has("# TYPE bitcoin_network_inbound_accepts counter"));
+    BOOST_REQUIRE(has("bitcoin_network_inbound_accepts_total 2"));
+
+    const std::string rtt{ "bitcoin_network_ping_round_trip_nanoseconds" };
+    BOOST_REQUIRE(has("# TYPE " + rtt + " histogram"));
+    BOOST_REQUIRE(has(rtt + "_bucket{le=\"3\"} 0"));
+    BOOST_REQUIRE(has(rtt + "_bucket{le=\"7\"} 1"));
+    BOOST_REQUIRE(has(rtt + "_bucket{le=\"+Inf\"} 1"));
+    BOOST_REQUIRE(has(rtt + "_sum 5"));
+    BOOST_REQUIRE(has(rtt + "_count 1"));
+    BOOST_REQUIRE(has("bitcoin_network_channel_stops_total{code=\"42\"} 1"));
+}
+
+BOOST_AUTO_TEST_CASE(aggregator__exposition__strand_spans__named_histograms)
+{
+    aggregator instance{};
+    instance.record(events::network_queued, 1);
+    instance.record(events::channel_executed, 2);
+
+    const auto text = instance.exposition();
+    BOOST_REQUIRE(text.find("# TYPE bitcoin_network_network_queued_nanoseconds"
+        " histogram\n") != std::string::npos);
+    BOOST_REQUIRE(text.find("# TYPE bitcoin_network_channel_executed_nanoseconds"
+        " histogram\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
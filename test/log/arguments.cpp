@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(arguments_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(arguments__format__no_arguments__pattern)
+{
+    const arguments instance{};
+    BOOST_REQUIRE(instance.data().empty());
+    BOOST_REQUIRE_EQUAL(arguments::format("abc", instance.data()), "abc");
+    BOOST_REQUIRE_EQUAL(arguments::format("a{}c", instance.data()), "ac");
+}
+
+BOOST_AUTO_TEST_CASE(arguments__format__mixed_arguments__expected)
+{
+    arguments instance{};
+    instance.add(std::string{ "ping" });
+    instance.add(42u);
+    instance.add(-7);
+    instance.add(data_array<2>{ 0x0a, 0xff });
+    instance.add(true);
+
+    const auto text = arguments::format("{} {} {} 0x{} {}", instance.data());
+    BOOST_REQUIRE_EQUAL(text, "ping 42 -7 0aff 1");
+}
+
+BOOST_AUTO_TEST_CASE(arguments__format__network_code__message)
+{
+    arguments instance{};
+    instance.add(code{ error::invalid_magic });
+    BOOST_REQUIRE_EQUAL(arguments::format("{}", instance.data()),
+        code{ error::invalid_magic }.message());
+}
+
+BOOST_AUTO_TEST_CASE(arguments__format__excess_placeholders__empty)
+{
+    arguments instance{};
+    instance.add(1u);
+    BOOST_REQUIRE_EQUAL(arguments::format("{}-{}", instance.data()), "1-");
+}
+
+BOOST_AUTO_TEST_CASE(arguments__add__oversized_bytes__truncated)
+{
+    arguments instance{};
+    instance.add(data_chunk(arguments::capacity, 0x42));
+    BOOST_REQUIRE_EQUAL(instance.data().size(), arguments::capacity);
+
+    // Once full, subsequent arguments are omitted.
+    instance.add(1u);
+    BOOST_REQUIRE_EQUAL(instance.data().size(), arguments::capacity);
+
+    const auto hex = arguments::format("{}", instance.data());
+    BOOST_REQUIRE_EQUAL(hex.size(), (arguments::capacity - 3u) * 2u);
+}
+
+BOOST_AUTO_TEST_CASE(arguments__to_pattern__formats__expected)
+{
+    BOOST_REQUIRE_EQUAL(std::string{ formats::to_pattern(formats::text) },
+        "{}");
+    BOOST_REQUIRE(std::string{ formats::to_pattern(max_uint16) }.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(logger_tests)
+
+BOOST_AUTO_TEST_CASE(logger__enabled__default__all_levels)
+{
+    const logger instance{};
+    BOOST_REQUIRE_EQUAL(instance.mask(), logger::all_levels);
+    BOOST_REQUIRE(instance.enabled(levels::application));
+    BOOST_REQUIRE(instance.enabled(levels::quit));
+}
+
+BOOST_AUTO_TEST_CASE(logger__enable__disable_level__only_level_disabled)
+{
+    logger instance{};
+    instance.enable(levels::wire, false);
+    BOOST_REQUIRE(!instance.enabled(levels::wire));
+    BOOST_REQUIRE(instance.enabled(levels::remote));
+
+    instance.enable(levels::wire);
+    BOOST_REQUIRE(instance.enabled(levels::wire));
+}
+
+BOOST_AUTO_TEST_CASE(logger__set_mask__zero__none_enabled)
+{
+    logger instance{};
+    instance.set_mask(0);
+    BOOST_REQUIRE_EQUAL(instance.mask(), 0u);
+    BOOST_REQUIRE(!instance.enabled(levels::news));
+    BOOST_REQUIRE(!instance.enabled(levels::quit));
+}
+
+BOOST_AUTO_TEST_CASE(logger__enabled__out_of_range__false)
+{
+    logger instance{};
+    BOOST_REQUIRE(!instance.enabled(logger::mask_bits));
+    instance.enable(logger::mask_bits);
+    BOOST_REQUIRE_EQUAL(instance.mask(), logger::all_levels);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(probe_tests)
+
+BOOST_AUTO_TEST_CASE(probes__record__one__counted_and_bucketed)
+{
+    constexpr auto point = probe_point::hosts_save;
+    const auto index = static_cast<size_t>(point);
+    const auto before = probes::snapshot().at(index);
+    probes::record(point, nanoseconds(42));
+
+    const auto after = probes::snapshot().at(index);
+    BOOST_REQUIRE_EQUAL(after.count, add1(before.count));
+    BOOST_REQUIRE_EQUAL(after.total, before.total + 42u);
+    BOOST_REQUIRE_EQUAL(after.buckets.at(6), add1(before.buckets.at(6)));
+}
+
+BOOST_AUTO_TEST_CASE(probes__record__negative__zero_bucket)
+{
+    constexpr auto point = probe_point::session_start;
+    const auto index = static_cast<size_t>(point);
+    const auto before = probes::snapshot().at(index);
+    probes::record(point, nanoseconds(-1));
+
+    const auto after = probes::snapshot().at(index);
+    BOOST_REQUIRE_EQUAL(after.total, before.total);
+    BOOST_REQUIRE_EQUAL(after.buckets.at(0), add1(before.buckets.at(0)));
+}
+
+BOOST_AUTO_TEST_CASE(probes__name__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(probes::name(probe_point::proxy_deserialize),
+        "proxy_deserialize");
+    BOOST_REQUIRE_EQUAL(probes::name(probe_point::session_channel_stopped),
+        "session_channel_stopped");
+    BOOST_REQUIRE(probes::name(probe_point::count).empty());
+}
+
+BOOST_AUTO_TEST_CASE(probe__destruct__always__recorded)
+{
+    constexpr auto point = probe_point::distributor_notify;
+    const auto index = static_cast<size_t>(point);
+    const auto before = probes::snapshot().at(index).count;
+    {
+        const probe scope{ point };
+    }
+
+    BOOST_REQUIRE_EQUAL(probes::snapshot().at(index).count, add1(before));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(record_queue_tests)
+
+BOOST_AUTO_TEST_CASE(record_queue__capacity__not_power_of_two__rounded_up)
+{
+    const record_queue instance(5);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 8u);
+    BOOST_REQUIRE_EQUAL(record_queue(0).capacity(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(record_queue__pop__empty__false)
+{
+    record_queue instance(4);
+    record_queue::record out{};
+    BOOST_REQUIRE(!instance.pop(out));
+}
+
+BOOST_AUTO_TEST_CASE(record_queue__push_pop__fifo__expected)
+{
+    record_queue instance(4);
+    BOOST_REQUIRE(instance.push(1, 10, "first"));
+    BOOST_REQUIRE(instance.push(2, 20, "second"));
+
+    record_queue::record out{};
+    BOOST_REQUIRE(instance.pop(out));
+    BOOST_REQUIRE_EQUAL(out.level, 1u);
+    BOOST_REQUIRE_EQUAL(out.zulu, 10);
+    BOOST_REQUIRE_EQUAL(out.view(), "first");
+    BOOST_REQUIRE(instance.pop(out));
+    BOOST_REQUIRE_EQUAL(out.level, 2u);
+    BOOST_REQUIRE_EQUAL(out.view(), "second");
+    BOOST_REQUIRE(!instance.pop(out));
+}
+
+BOOST_AUTO_TEST_CASE(record_queue__push__full__dropped)
+{
+    record_queue instance(2);
+    BOOST_REQUIRE(instance.push(0, 0, "a"));
+    BOOST_REQUIRE(instance.push(0, 0, "b"));
+    BOOST_REQUIRE(!instance.push(0, 0, "c"));
+    BOOST_REQUIRE_EQUAL(instance.dropped(), 1u);
+
+    // Space is reclaimed upon pop.
+    record_queue::record out{};
+    BOOST_REQUIRE(instance.pop(out));
+    BOOST_REQUIRE(instance.push(0, 0, "d"));
+    BOOST_REQUIRE(instance.pop(out));
+    BOOST_REQUIRE_EQUAL(out.view(), "b");
+    BOOST_REQUIRE(instance.pop(out));
+    BOOST_REQUIRE_EQUAL(out.view(), "d");
+}
+
+BOOST_AUTO_TEST_CASE(record_queue__push__oversized__truncated)
+{
+    record_queue instance(2);
+    const std::string text(add1(record_queue::text_size), 'x');
+    BOOST_REQUIRE(instance.push(0, 0, text));
+
+    record_queue::record out{};
+    BOOST_REQUIRE(instance.pop(out));
+    BOOST_REQUIRE_EQUAL(out.size, record_queue::text_size);
+}
+
+BOOST_AUTO_TEST_CASE(record_queue__push__concurrent_producers__all_popped)
+{
+    constexpr size_t producers = 4;
+    constexpr size_t each = 100;
+    record_queue instance(producers * each);
+
+    std::vector<std::thread> threads{};
+    for (size_t thread = 0; thread < producers; ++thread)
+        threads.emplace_back([&]() NOEXCEPT
+        {
+            for (size_t count = 0; count < each; ++count)
+                instance.push(0, 0, "message");
+        });
+
+    for (auto& thread: threads)
+        thread.join();
+
+    size_t popped{};
+    record_queue::record out{};
+    while (instance.pop(out))
+        ++popped;
+
+    BOOST_REQUIRE_EQUAL(popped, producers * each);
+    BOOST_REQUIRE_EQUAL(instance.dropped(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(tracer_tests)
+
+BOOST_AUTO_TEST_CASE(traces__record__disabled__not_recorded)
+{
+    traces::enable(false);
+    traces::clear();
+    traces::record(trace_point::channel, traces::phase::begin, 42);
+    BOOST_REQUIRE(traces::snapshot().empty());
+}
+
+BOOST_AUTO_TEST_CASE(traces__record__enabled__recorded)
+{
+    traces::enable();
+    traces::clear();
+    traces::record(trace_point::message, traces::phase::instant, 42);
+    const auto events = traces::snapshot();
+    traces::enable(false);
+
+    BOOST_REQUIRE_EQUAL(events.size(), 1u);
+    BOOST_REQUIRE_EQUAL(events.front().id, 42u);
+    BOOST_REQUIRE(events.front().point == trace_point::message);
+    BOOST_REQUIRE(events.front().phase == traces::phase::instant);
+}
+
+BOOST_AUTO_TEST_CASE(traces__record__overflow__capacity_retained)
+{
+    traces::enable();
+    traces::clear();
+    for (size_t id = 0; id <= traces::capacity; ++id)
+        traces::record(trace_point::dispatch, traces::phase::instant, id);
+
+    const auto events = traces::snapshot();
+    traces::enable(false);
+
+    BOOST_REQUIRE_EQUAL(events.size(), traces::capacity);
+    BOOST_REQUIRE_EQUAL(events.front().id, 1u);
+    BOOST_REQUIRE_EQUAL(events.back().id, traces::capacity);
+}
+
+BOOST_AUTO_TEST_CASE(trace__destruct__enabled__begin_end)
+{
+    traces::enable();
+    traces::clear();
+    {
+        const trace scope{ trace_point::handshake, 7 };
+    }
+
+    const auto events = traces::snapshot();
+    traces::enable(false);
+
+    BOOST_REQUIRE_EQUAL(events.size(), 2u);
+    BOOST_REQUIRE(events.front().phase == traces::phase::begin);
+    BOOST_REQUIRE(events.back().phase == traces::phase::end);
+    BOOST_REQUIRE_EQUAL(events.back().id, 7u);
+}
+
+BOOST_AUTO_TEST_CASE(traces__write__events__chrome_json)
+{
+    const traces::events events
+    {
+        { 1'000, 42, 1, trace_point::channel, traces::phase::begin },
+        { 3'500, 42, 2, trace_point::channel, traces::phase::end }
+    };
+
+    std::ostringstream out{};
+    BOOST_REQUIRE(traces::write(out, events));
+    BOOST_REQUIRE_EQUAL(out.str(),
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"channel\",\"cat\":\"network\",\"ph\":\"b\",\"id\":\"42\","
+        "\"pid\":0,\"tid\":1,\"ts\":0.000},\n"
+        "{\"name\":\"channel\",\"cat\":\"network\",\"ph\":\"e\",\"id\":\"42\","
+        "\"pid\":0,\"tid\":2,\"ts\":2.500}\n"
+        "],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+BOOST_AUTO_TEST_CASE(traces__name__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(traces::name(trace_point::channel), "channel");
+    BOOST_REQUIRE_EQUAL(traces::name(trace_point::dispatch), "dispatch");
+    BOOST_REQUIRE(traces::name(trace_point::count).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
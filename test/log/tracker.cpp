@@ -83,4 +83,27 @@ BOOST_AUTO_TEST_CASE(tracker__construct__stopped_log__safe)
     BOOST_REQUIRE(instance.method());
 }
 
+BOOST_AUTO_TEST_CASE(tracker__census__live_instances__counted)
+{
+    const auto count = []() NOEXCEPT
+    {
+        for (const auto& entry: census::snapshot())
+            if (entry.name == typeid(tracked).name())
+                return entry.count;
+
+        return zero;
+    };
+
+    logger log{};
+    log.stop();
+    const auto before = count();
+    {
+        const tracked first{ log };
+        const tracked second{ first };
+        BOOST_REQUIRE_EQUAL(count(), before + 2u);
+    }
+
+    BOOST_REQUIRE_EQUAL(count(), before);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
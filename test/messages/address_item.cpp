@@ -187,4 +187,22 @@ BOOST_AUTO_TEST_CASE(address_item__inequality__distinct_timestamp__false)
     BOOST_REQUIRE(!(item1 != item2));
 }
 
+// to_key
+
+BOOST_AUTO_TEST_CASE(address_item__to_key__distinct_timestamp_services__equal)
+{
+    constexpr address_item item1{ 1, 2, loopback_ip_address, 3 };
+    constexpr address_item item2{ 4, 5, loopback_ip_address, 3 };
+    static_assert(to_key(item1) == to_key(item2));
+    BOOST_REQUIRE_EQUAL(std::hash<address_key>{}(to_key(item1)), std::hash<address_key>{}(to_key(item2)));
+}
+
+BOOST_AUTO_TEST_CASE(address_item__to_key__distinct_port__unequal)
+{
+    constexpr address_item item1{ 1, 2, loopback_ip_address, 3 };
+    constexpr address_item item2{ 1, 2, loopback_ip_address, 4 };
+    static_assert(to_key(item1) != to_key(item2));
+    BOOST_REQUIRE(to_key(item1) != to_key(item2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -36,4 +36,15 @@ BOOST_AUTO_TEST_CASE(block__size__default__zero)
     BOOST_REQUIRE_EQUAL(block{}.size(level::canonical, false), zero);
 }
 
+BOOST_AUTO_TEST_CASE(block__deserialize__null_chunk__nullptr)
+{
+    BOOST_REQUIRE(!block::deserialize(level::canonical, system::chunk_ptr{}));
+}
+
+BOOST_AUTO_TEST_CASE(block__deserialize__empty_chunk__nullptr)
+{
+    const auto data = std::make_shared<system::data_chunk>();
+    BOOST_REQUIRE(!block::deserialize(level::canonical, data));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -41,4 +41,45 @@ BOOST_AUTO_TEST_CASE(compact_block__size__default__expected)
     BOOST_REQUIRE_EQUAL(compact_block{}.size(level::canonical, false), expected);
 }
 
+BOOST_AUTO_TEST_CASE(compact_block__to_short_id__always__48_bits)
+{
+    const auto key = compact_block::to_key(system::chain::header{}, 42);
+    const auto id = compact_block::to_short_id(key, system::null_hash);
+    BOOST_REQUIRE_EQUAL(id >> 48, 0u);
+    BOOST_REQUIRE_EQUAL(id, siphash(key, system::null_hash) &
+        0x0000ffffffffffff_u64);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__to_short_ids__hashes__same_as_to_short_id)
+{
+    const auto key = compact_block::to_key(system::chain::header{}, 42);
+    const system::hashes hashes
+    {
+        system::null_hash,
+        system::one_hash,
+        system::sha256_hash(system::data_chunk{ 0x42 }),
+        system::sha256_hash(system::data_chunk{ 0x43 }),
+        system::sha256_hash(system::data_chunk{ 0x44 })
+    };
+
+    const auto ids = compact_block::to_short_ids(key, hashes);
+    BOOST_REQUIRE_EQUAL(ids.size(), hashes.size());
+    for (size_t index = 0; index < hashes.size(); ++index)
+        BOOST_REQUIRE_EQUAL(ids[index],
+            compact_block::to_short_id(key, hashes[index]));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__to_number__little_endian__expected)
+{
+    const compact_block::short_id id{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+    BOOST_REQUIRE_EQUAL(compact_block::to_number(id), 0x060504030201_u64);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__key__null_header__default)
+{
+    const auto key = compact_block{}.key();
+    BOOST_REQUIRE_EQUAL(key.k0, 0u);
+    BOOST_REQUIRE_EQUAL(key.k1, 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
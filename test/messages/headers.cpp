@@ -36,4 +36,40 @@ BOOST_AUTO_TEST_CASE(headers__size__default__expected)
     BOOST_REQUIRE_EQUAL(headers{}.size(level::canonical), expected);
 }
 
+BOOST_AUTO_TEST_CASE(headers__hash__empty__empty)
+{
+    BOOST_REQUIRE(headers::hash(data_chunk{}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(headers__deserialize__headers__arena_and_expected_hashes)
+{
+    const chain::header first{ 1, hash_digest{ 0x01 }, hash_digest{ 0x02 }, 3, 4, 5 };
+    const chain::header second{ 6, first.hash(), hash_digest{ 0x07 }, 8, 9, 10 };
+
+    data_chunk payload{ 0x02 };
+    for (const auto& header: { first, second })
+    {
+        const auto data = header.to_data();
+        payload.insert(payload.end(), data.begin(), data.end());
+        payload.push_back(0x00);
+    }
+
+    const auto hashes = headers::hash(payload);
+    BOOST_REQUIRE_EQUAL(hashes.size(), two);
+    BOOST_REQUIRE_EQUAL(hashes.front(), first.hash());
+    BOOST_REQUIRE_EQUAL(hashes.back(), second.hash());
+
+    const auto message = headers::deserialize(level::maximum_protocol, payload);
+    BOOST_REQUIRE(message);
+    BOOST_REQUIRE_EQUAL(message->header_ptrs.size(), two);
+    BOOST_REQUIRE(*message->header_ptrs.front() == first);
+    BOOST_REQUIRE(*message->header_ptrs.back() == second);
+    BOOST_REQUIRE_EQUAL(message->header_ptrs.front()->hash(), first.hash());
+    BOOST_REQUIRE(message->is_sequential());
+
+    // Headers are contiguous in one allocation.
+    BOOST_REQUIRE_EQUAL(std::next(message->header_ptrs.front().get()),
+        message->header_ptrs.back().get());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
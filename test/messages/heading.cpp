@@ -43,6 +43,71 @@ BOOST_AUTO_TEST_CASE(heading__size__always__expected)
     BOOST_REQUIRE_EQUAL(heading::size(), expected);
 }
 
+BOOST_AUTO_TEST_CASE(heading__maximum_payload__fixed__expected)
+{
+    constexpr size_t limit = 4'000'000;
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::ping, limit), 8u);
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::version, limit), 341u);
+    BOOST_REQUIRE(is_zero(heading::maximum_payload(identifier::version_acknowledge, limit)));
+}
+
+BOOST_AUTO_TEST_CASE(heading__maximum_payload__lists__expected)
+{
+    constexpr size_t limit = 4'000'000;
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::inventory, limit), 1'800'003u);
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::address, limit), 30'003u);
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::headers, limit), 162'003u);
+}
+
+BOOST_AUTO_TEST_CASE(heading__maximum_payload__unbounded__limit)
+{
+    constexpr size_t limit = 42;
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::block, limit), limit);
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::unknown, limit), limit);
+    BOOST_REQUIRE_EQUAL(heading::maximum_payload(identifier::inventory, limit), limit);
+}
+
+BOOST_AUTO_TEST_CASE(heading__prescan__exact_lists__true)
+{
+    data_chunk inventory(add1(2u * 36u), 0x00);
+    inventory.front() = 2;
+    BOOST_REQUIRE(heading::prescan(identifier::inventory, inventory));
+    BOOST_REQUIRE(heading::prescan(identifier::get_data, inventory));
+    BOOST_REQUIRE(heading::prescan(identifier::not_found, inventory));
+    BOOST_REQUIRE(heading::prescan(identifier::address, data_chunk{ 0x00 }));
+
+    data_chunk headers(add1(81u), 0x00);
+    headers.front() = 1;
+    BOOST_REQUIRE(heading::prescan(identifier::headers, headers));
+}
+
+BOOST_AUTO_TEST_CASE(heading__prescan__size_mismatch__false)
+{
+    data_chunk inventory(add1(2u * 36u), 0x00);
+    inventory.front() = 3;
+    BOOST_REQUIRE(!heading::prescan(identifier::inventory, inventory));
+
+    inventory.front() = 1;
+    BOOST_REQUIRE(!heading::prescan(identifier::inventory, inventory));
+    BOOST_REQUIRE(!heading::prescan(identifier::address, data_chunk{}));
+}
+
+BOOST_AUTO_TEST_CASE(heading__prescan__excessive_count__false)
+{
+    // A varint count of 1,001 (0xfd, little endian 0x03e9).
+    data_chunk address(3u + 1'001u * 30u, 0x00);
+    address.at(0) = 0xfd;
+    address.at(1) = 0xe9;
+    address.at(2) = 0x03;
+    BOOST_REQUIRE(!heading::prescan(identifier::address, address));
+}
+
+BOOST_AUTO_TEST_CASE(heading__prescan__not_list__true)
+{
+    BOOST_REQUIRE(heading::prescan(identifier::ping, data_chunk{ 0x42 }));
+    BOOST_REQUIRE(heading::prescan(identifier::unknown, data_chunk{}));
+}
+
 BOOST_AUTO_TEST_CASE(heading__address_id__always__expected)
 {
     const auto instance = heading{ 0u, address::command, 0u, 0u };
@@ -241,6 +306,73 @@ BOOST_AUTO_TEST_CASE(heading__version_acknowledge_id__always__expected)
     BOOST_REQUIRE(instance.id() == version_acknowledge::id);
 }
 
+BOOST_AUTO_TEST_CASE(heading__wtxid_relay_id__always__expected)
+{
+    const auto instance = heading{ 0u, wtxid_relay::command, 0u, 0u };
+    BOOST_REQUIRE(instance.id() == wtxid_relay::id);
+}
+
+BOOST_AUTO_TEST_CASE(heading__reconciliation_ids__always__expected)
+{
+    BOOST_REQUIRE(heading{ 0u, send_reconciliation::command, 0u, 0u }.id() ==
+        send_reconciliation::id);
+    BOOST_REQUIRE(heading{ 0u, request_reconciliation::command, 0u, 0u }.id() ==
+        request_reconciliation::id);
+    BOOST_REQUIRE(heading{ 0u, reconciliation_sketch::command, 0u, 0u }.id() ==
+        reconciliation_sketch::id);
+    BOOST_REQUIRE(heading{ 0u, reconciliation_difference::command, 0u, 0u }.id() ==
+        reconciliation_difference::id);
+    BOOST_REQUIRE(heading{ 0u, request_sketch_extension::command, 0u, 0u }.id() ==
+        request_sketch_extension::id);
+}
+
+BOOST_AUTO_TEST_CASE(heading__unknown_id__always__unknown)
+{
+    const auto instance = heading{ 0u, "foobar", 0u, 0u };
+    BOOST_REQUIRE(instance.id() == identifier::unknown);
+}
+
+BOOST_AUTO_TEST_CASE(heading__id__empty_command__unknown)
+{
+    BOOST_REQUIRE(heading::id(system::data_chunk{}) == identifier::unknown);
+}
+
+BOOST_AUTO_TEST_CASE(heading__id__nul_padded_command__expected)
+{
+    const system::data_array<heading::command_size> command
+    {
+        'p', 'i', 'n', 'g', 0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    BOOST_REQUIRE(heading::id(command) == ping::id);
+}
+
+BOOST_AUTO_TEST_CASE(heading__id__bytes_after_nul__ignored)
+{
+    const system::data_array<heading::command_size> command
+    {
+        'p', 'o', 'n', 'g', 0, 'x', 'y', 'z', 0, 0, 0, 0
+    };
+
+    BOOST_REQUIRE(heading::id(command) == pong::id);
+}
+
+BOOST_AUTO_TEST_CASE(heading__id__long_command__expected)
+{
+    const system::data_array<heading::command_size> command
+    {
+        's', 'e', 'n', 'd', 'h', 'e', 'a', 'd', 'e', 'r', 's', 0
+    };
+
+    BOOST_REQUIRE(heading::id(command) == send_headers::id);
+}
+
+BOOST_AUTO_TEST_CASE(heading__id__command_prefix__unknown)
+{
+    const auto instance = heading{ 0u, "sendheader", 0u, 0u };
+    BOOST_REQUIRE(instance.id() == identifier::unknown);
+}
+
 BOOST_AUTO_TEST_CASE(heading__get_command__empty_payload__unknown)
 {
     const system::data_chunk payload{};
@@ -316,4 +448,30 @@ BOOST_AUTO_TEST_CASE(heading__factory2__non_default_hash__expected)
     BOOST_REQUIRE(instance.id() == identifier::pong);
 }
 
+// fixed_heading
+
+BOOST_AUTO_TEST_CASE(fixed_heading__deserialize__valid__expected)
+{
+    system::data_array<heading::size()> data{};
+    const auto expected = heading::factory(0x01020304u, ping::command, {});
+    BOOST_REQUIRE(expected.serialize(data));
+
+    fixed_heading instance{};
+    system::read::bytes::copy reader(data);
+    BOOST_REQUIRE(instance.deserialize(reader));
+    BOOST_REQUIRE_EQUAL(instance.magic, expected.magic);
+    BOOST_REQUIRE_EQUAL(instance.payload_size, expected.payload_size);
+    BOOST_REQUIRE_EQUAL(instance.checksum, expected.checksum);
+    BOOST_REQUIRE_EQUAL(instance.command_text(), ping::command);
+    BOOST_REQUIRE(instance.id == ping::id);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_heading__deserialize__insufficient__false)
+{
+    const system::data_array<sub1(heading::size())> data{};
+    fixed_heading instance{};
+    system::read::bytes::copy reader(data);
+    BOOST_REQUIRE(!instance.deserialize(reader));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
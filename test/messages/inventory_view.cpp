@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(inventory_view_tests)
+
+using namespace bc::network::messages;
+using type_id = inventory_item::type_id;
+
+static data_chunk wire(const inventory& message)
+{
+    data_chunk out(message.size(level::canonical));
+    BOOST_REQUIRE(message.serialize(level::canonical, out));
+    return out;
+}
+
+static const inventory expected
+{
+    {
+        { type_id::block, hash_digest{ 0x01 } },
+        { type_id::transaction, hash_digest{ 0x02 } },
+        { type_id::block, hash_digest{ 0x03 } }
+    }
+};
+
+BOOST_AUTO_TEST_CASE(inventory_view__construct__empty_payload__invalid)
+{
+    const inventory_view instance{ data_chunk{} };
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__construct__empty_list__valid_empty)
+{
+    const inventory_view instance{ data_chunk{ 0x00 } };
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__construct__truncated__invalid)
+{
+    auto payload = wire(expected);
+    payload.pop_back();
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__construct__trailing_bytes__invalid)
+{
+    auto payload = wire(expected);
+    payload.push_back(0x00);
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE(!instance);
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__items__valid__expected)
+{
+    const auto payload = wire(expected);
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE_EQUAL(instance.size(), expected.items.size());
+
+    for (size_t index = 0; index < instance.size(); ++index)
+    {
+        BOOST_REQUIRE(instance.type(index) == expected.items[index].type);
+        BOOST_REQUIRE_EQUAL(instance.hash(index), expected.items[index].hash);
+        BOOST_REQUIRE(instance.item(index) == expected.items[index]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__hash__valid__references_payload)
+{
+    const auto payload = wire(expected);
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE(instance.hash(0).data() ==
+        std::next(payload.data(), one + sizeof(uint32_t)));
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__count__valid__expected)
+{
+    const auto payload = wire(expected);
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE_EQUAL(instance.count(type_id::block), expected.count(type_id::block));
+    BOOST_REQUIRE_EQUAL(instance.count(type_id::transaction), expected.count(type_id::transaction));
+    BOOST_REQUIRE_EQUAL(instance.count(type_id::compact_block), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__to_hashes__valid__expected)
+{
+    const auto payload = wire(expected);
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE_EQUAL(instance.to_hashes(type_id::block), expected.to_hashes(type_id::block));
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__to_inventory__valid__expected)
+{
+    const auto payload = wire(expected);
+    const inventory_view instance{ payload };
+    BOOST_REQUIRE(instance.to_inventory().items == expected.items);
+}
+
+BOOST_AUTO_TEST_CASE(inventory_view__partition__valid__expected)
+{
+    const auto payload = wire(expected);
+    const inventory_view instance{ payload };
+
+    hashes blocks{};
+    inventory_items others{};
+    instance.partition(type_id::block,
+        [&](const hash_digest& hash) NOEXCEPT
+        {
+            blocks.push_back(hash);
+        },
+        [&](type_id type, const hash_digest& hash) NOEXCEPT
+        {
+            others.push_back({ type, hash });
+        });
+
+    BOOST_REQUIRE_EQUAL(blocks, expected.to_hashes(type_id::block));
+    BOOST_REQUIRE(others == expected.filter(type_id::transaction));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -32,4 +32,104 @@ BOOST_AUTO_TEST_CASE(message__network_checksum__empty_hash__empty_checksum)
     BOOST_REQUIRE_EQUAL(network_checksum(empty_hash), empty_checksum);
 }
 
+template <typename Message>
+static data_chunk expected(const Message& message, uint32_t magic,
+    uint32_t version)
+{
+    data_chunk payload(message.size(version));
+    BOOST_REQUIRE(message.serialize(version, payload));
+
+    data_chunk out(heading::size());
+    const auto head = heading::factory(magic, Message::command, payload);
+    BOOST_REQUIRE(head.serialize(out));
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+constexpr auto magic = 0xd9b4bef9_u32;
+
+BOOST_AUTO_TEST_CASE(message__serialize__empty_payloads__expected)
+{
+    constexpr auto version = level::maximum_protocol;
+    const auto verack = serialize(version_acknowledge{}, magic, version);
+    const auto get_addr = serialize(get_address{}, magic, version);
+    const auto headers = serialize(send_headers{}, magic, version);
+    const auto mempool = serialize(memory_pool{}, magic, version);
+    BOOST_REQUIRE(verack && get_addr && headers && mempool);
+    const version_acknowledge ack{};
+    BOOST_REQUIRE_EQUAL(*verack, expected(ack, magic, version));
+    BOOST_REQUIRE_EQUAL(*get_addr, expected(get_address{}, magic, version));
+    BOOST_REQUIRE_EQUAL(*headers, expected(send_headers{}, magic, version));
+    BOOST_REQUIRE_EQUAL(*mempool, expected(memory_pool{}, magic, version));
+}
+
+BOOST_AUTO_TEST_CASE(message__serialize__ping_bip31__expected)
+{
+    constexpr auto version = level::bip31;
+    const ping instance{ 0x0102030405060708_u64 };
+    const auto data = serialize(instance, magic, version);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE_EQUAL(data->size(), heading::size() + sizeof(uint64_t));
+    BOOST_REQUIRE_EQUAL(*data, expected(instance, magic, version));
+}
+
+BOOST_AUTO_TEST_CASE(message__serialize__ping_pre_bip31__empty_payload)
+{
+    constexpr auto version = sub1(level::bip31);
+    const ping instance{ 42 };
+    const auto data = serialize(instance, magic, version);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE_EQUAL(data->size(), heading::size());
+    BOOST_REQUIRE_EQUAL(*data, expected(instance, magic, version));
+}
+
+BOOST_AUTO_TEST_CASE(message__serialize__pong__expected)
+{
+    constexpr auto version = level::maximum_protocol;
+    const pong instance{ 0xfedcba9876543210_u64, true };
+    const auto data = serialize(instance, magic, version);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE_EQUAL(*data, expected(instance, magic, version));
+}
+
+BOOST_AUTO_TEST_CASE(message__serialize__dirty_allocation__expected_in_allocation)
+{
+    constexpr auto version = level::maximum_protocol;
+    const pong instance{ 0xfedcba9876543210_u64, true };
+    chunk_ptr buffer{};
+    const auto data = serialize(instance, magic, version, true,
+        [&](size_t size) NOEXCEPT
+        {
+            buffer = std::make_shared<data_chunk>(size, 0xff);
+            return buffer;
+        });
+
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE_EQUAL(data.get(), buffer.get());
+    BOOST_REQUIRE_EQUAL(*data, expected(instance, magic, version));
+}
+
+BOOST_AUTO_TEST_CASE(message__serialize__failed_allocation__nullptr)
+{
+    constexpr auto version = level::maximum_protocol;
+    const auto allocate = [](size_t) NOEXCEPT { return chunk_ptr{}; };
+    BOOST_REQUIRE(!serialize(pong{ 42, true }, magic, version, true, allocate));
+    BOOST_REQUIRE(!serialize(get_address{}, magic, version, true, allocate));
+}
+
+BOOST_AUTO_TEST_CASE(message__retained_hash__not_retained__nullptr)
+{
+    BOOST_REQUIRE(!retained_hash(block{}, zero));
+    BOOST_REQUIRE(!retained_hash(transaction{}, zero));
+}
+
+BOOST_AUTO_TEST_CASE(message__retained_hash__retained_block__payload_hash)
+{
+    const auto payload = std::make_shared<system::data_chunk>(42u, 0x00);
+    const auto hash = system::to_shared(system::null_hash);
+    const block instance{ {}, payload, hash };
+    BOOST_REQUIRE(retained_hash(instance, 42u) == hash);
+    BOOST_REQUIRE(!retained_hash(instance, 41u));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(reconciliation_difference_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(reconciliation_difference__properties__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(reconciliation_difference::command, "reconcildiff");
+    BOOST_REQUIRE(reconciliation_difference::id == identifier::reconciliation_difference);
+    BOOST_REQUIRE_EQUAL(reconciliation_difference::version_minimum, level::bip339);
+    BOOST_REQUIRE_EQUAL(reconciliation_difference::version_maximum, level::maximum_protocol);
+}
+
+BOOST_AUTO_TEST_CASE(reconciliation_difference__size__default__expected)
+{
+    constexpr auto expected = sizeof(uint8_t) + variable_size(zero);
+    BOOST_REQUIRE_EQUAL(reconciliation_difference{}.size(level::canonical), expected);
+}
+
+BOOST_AUTO_TEST_CASE(reconciliation_difference__serialize__asks__expected)
+{
+    const reconciliation_difference instance{ true, { 0x01020304, 42 } };
+    const bc::system::data_chunk expected
+    {
+        0x01, 0x02, 0x04, 0x03, 0x02, 0x01, 0x2a, 0x00, 0x00, 0x00
+    };
+
+    bc::system::data_chunk data(instance.size(level::maximum_protocol));
+    BOOST_REQUIRE(instance.serialize(level::maximum_protocol, data));
+    BOOST_REQUIRE_EQUAL(data, expected);
+
+    const auto copy = reconciliation_difference::deserialize(level::maximum_protocol, data);
+    BOOST_REQUIRE(copy);
+    BOOST_REQUIRE(copy->success);
+    BOOST_REQUIRE_EQUAL(copy->short_ids, instance.short_ids);
+}
+
+BOOST_AUTO_TEST_CASE(reconciliation_difference__serialize__failure__empty)
+{
+    const reconciliation_difference instance{ false, {} };
+    const bc::system::data_chunk expected{ 0x00, 0x00 };
+    bc::system::data_chunk data(instance.size(level::maximum_protocol));
+    BOOST_REQUIRE(instance.serialize(level::maximum_protocol, data));
+    BOOST_REQUIRE_EQUAL(data, expected);
+
+    const auto copy = reconciliation_difference::deserialize(level::maximum_protocol, data);
+    BOOST_REQUIRE(copy);
+    BOOST_REQUIRE(!copy->success);
+    BOOST_REQUIRE(copy->short_ids.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
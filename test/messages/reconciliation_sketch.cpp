@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(reconciliation_sketch_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(reconciliation_sketch__properties__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(reconciliation_sketch::command, "sketch");
+    BOOST_REQUIRE(reconciliation_sketch::id == identifier::reconciliation_sketch);
+    BOOST_REQUIRE_EQUAL(reconciliation_sketch::version_minimum, level::bip339);
+    BOOST_REQUIRE_EQUAL(reconciliation_sketch::version_maximum, level::maximum_protocol);
+}
+
+BOOST_AUTO_TEST_CASE(reconciliation_sketch__size__default__expected)
+{
+    constexpr auto expected = variable_size(zero);
+    BOOST_REQUIRE_EQUAL(reconciliation_sketch{}.size(level::canonical), expected);
+}
+
+BOOST_AUTO_TEST_CASE(reconciliation_sketch__serialize__sketch__prefixed)
+{
+    const reconciliation_sketch instance{ { 0x01, 0x00, 0x00, 0x00 } };
+    const bc::system::data_chunk expected{ 0x04, 0x01, 0x00, 0x00, 0x00 };
+    bc::system::data_chunk data(instance.size(level::maximum_protocol));
+    BOOST_REQUIRE(instance.serialize(level::maximum_protocol, data));
+    BOOST_REQUIRE_EQUAL(data, expected);
+
+    const auto copy = reconciliation_sketch::deserialize(level::maximum_protocol, data);
+    BOOST_REQUIRE(copy);
+    BOOST_REQUIRE_EQUAL(copy->sketch, instance.sketch);
+}
+
+BOOST_AUTO_TEST_CASE(reconciliation_sketch__deserialize__over_capacity__nullptr)
+{
+    constexpr auto size = add1(max_sketch_capacity * sizeof(uint32_t));
+    bc::system::data_chunk data(size + 3u);
+    bc::system::write::bytes::copy writer(data);
+    writer.write_variable(size);
+    BOOST_REQUIRE(!reconciliation_sketch::deserialize(level::maximum_protocol, data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
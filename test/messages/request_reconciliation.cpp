@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(request_reconciliation_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(request_reconciliation__properties__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(request_reconciliation::command, "reqrecon");
+    BOOST_REQUIRE(request_reconciliation::id == identifier::request_reconciliation);
+    BOOST_REQUIRE_EQUAL(request_reconciliation::version_minimum, level::bip339);
+    BOOST_REQUIRE_EQUAL(request_reconciliation::version_maximum, level::maximum_protocol);
+}
+
+BOOST_AUTO_TEST_CASE(request_reconciliation__size__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(request_reconciliation::size(level::canonical), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(request_reconciliation__serialize__values__little_endian)
+{
+    const request_reconciliation instance{ 0x0102, 0x0304 };
+    const bc::system::data_chunk expected{ 0x02, 0x01, 0x04, 0x03 };
+    bc::system::data_chunk data(request_reconciliation::size(level::maximum_protocol));
+    BOOST_REQUIRE(instance.serialize(level::maximum_protocol, data));
+    BOOST_REQUIRE_EQUAL(data, expected);
+
+    const auto copy = request_reconciliation::deserialize(level::maximum_protocol, data);
+    BOOST_REQUIRE(copy);
+    BOOST_REQUIRE_EQUAL(copy->set_size, instance.set_size);
+    BOOST_REQUIRE_EQUAL(copy->coefficient, instance.coefficient);
+}
+
+BOOST_AUTO_TEST_CASE(request_reconciliation__deserialize__below_minimum__nullptr)
+{
+    const bc::system::data_chunk data{ 0x02, 0x01, 0x04, 0x03 };
+    BOOST_REQUIRE(!request_reconciliation::deserialize(level::bip133, data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(request_sketch_extension_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(request_sketch_extension__properties__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(request_sketch_extension::command, "reqsketchext");
+    BOOST_REQUIRE(request_sketch_extension::id == identifier::request_sketch_extension);
+    BOOST_REQUIRE_EQUAL(request_sketch_extension::version_minimum, level::bip339);
+    BOOST_REQUIRE_EQUAL(request_sketch_extension::version_maximum, level::maximum_protocol);
+}
+
+BOOST_AUTO_TEST_CASE(request_sketch_extension__size__always_zero)
+{
+    BOOST_REQUIRE_EQUAL(request_sketch_extension::size(level::canonical), zero);
+}
+
+BOOST_AUTO_TEST_CASE(request_sketch_extension__deserialize__empty__expected)
+{
+    BOOST_REQUIRE(request_sketch_extension::deserialize(level::maximum_protocol, bc::system::data_chunk{}));
+    BOOST_REQUIRE(!request_sketch_extension::deserialize(level::bip133, bc::system::data_chunk{}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(send_reconciliation_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(send_reconciliation__properties__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(send_reconciliation::command, "sendtxrcncl");
+    BOOST_REQUIRE(send_reconciliation::id == identifier::send_reconciliation);
+    BOOST_REQUIRE_EQUAL(send_reconciliation::version_minimum, level::bip339);
+    BOOST_REQUIRE_EQUAL(send_reconciliation::version_maximum, level::maximum_protocol);
+}
+
+BOOST_AUTO_TEST_CASE(send_reconciliation__size__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(send_reconciliation::size(level::canonical), 12u);
+}
+
+BOOST_AUTO_TEST_CASE(send_reconciliation__serialize__values__little_endian)
+{
+    const send_reconciliation instance{ 1, 0x0102030405060708 };
+    const bc::system::data_chunk expected
+    {
+        0x01, 0x00, 0x00, 0x00, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01
+    };
+
+    bc::system::data_chunk data(send_reconciliation::size(level::maximum_protocol));
+    BOOST_REQUIRE(instance.serialize(level::maximum_protocol, data));
+    BOOST_REQUIRE_EQUAL(data, expected);
+
+    const auto copy = send_reconciliation::deserialize(level::maximum_protocol, data);
+    BOOST_REQUIRE(copy);
+    BOOST_REQUIRE_EQUAL(copy->protocol_version, instance.protocol_version);
+    BOOST_REQUIRE_EQUAL(copy->salt, instance.salt);
+}
+
+BOOST_AUTO_TEST_CASE(send_reconciliation__to_key__salt_order__symmetric)
+{
+    const auto key1 = send_reconciliation::to_key(42, 7);
+    const auto key2 = send_reconciliation::to_key(7, 42);
+    BOOST_REQUIRE_EQUAL(key1.k0, key2.k0);
+    BOOST_REQUIRE_EQUAL(key1.k1, key2.k1);
+}
+
+BOOST_AUTO_TEST_CASE(send_reconciliation__to_short_id__null_hash__nonzero)
+{
+    const auto key = send_reconciliation::to_key(1, 2);
+    BOOST_REQUIRE(!is_zero(send_reconciliation::to_short_id(key,
+        bc::system::null_hash)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
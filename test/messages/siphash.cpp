@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(siphash_tests)
+
+using namespace bc::network::messages;
+
+// Reference vectors: key 0x00..0x0f, message 0x00..(size - 1).
+static const siphash_key key
+{
+    0x0706050403020100_u64,
+    0x0f0e0d0c0b0a0908_u64
+};
+
+static system::data_chunk sequence(size_t size) NOEXCEPT
+{
+    system::data_chunk out(size);
+    for (size_t index = 0; index < size; ++index)
+        out[index] = static_cast<uint8_t>(index);
+
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(siphash__data__empty__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, sequence(0)), 0x726fdb47dd0e0e31_u64);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__data__fifteen_bytes__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, sequence(15)), 0xa129ca6149be45e5_u64);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__hash__sequence__same_as_data)
+{
+    const auto data = sequence(system::hash_size);
+    system::hash_digest hash{};
+    std::copy(data.begin(), data.end(), hash.begin());
+    BOOST_REQUIRE_EQUAL(siphash(key, hash), siphash(key, data));
+}
+
+BOOST_AUTO_TEST_CASE(siphash__hashes__batches_and_tails__same_as_scalar)
+{
+    for (const auto count: { 0u, 3u, 4u, 9u })
+    {
+        system::hashes hashes(count);
+        for (size_t index = 0; index < count; ++index)
+            hashes[index] = system::sha256_hash(sequence(index));
+
+        const auto out = siphash(key, hashes);
+        BOOST_REQUIRE_EQUAL(out.size(), count);
+        for (size_t index = 0; index < count; ++index)
+            BOOST_REQUIRE_EQUAL(out[index], siphash(key, hashes[index]));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
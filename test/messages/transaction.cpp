@@ -36,4 +36,53 @@ BOOST_AUTO_TEST_CASE(transaction__size__default__zero)
     BOOST_REQUIRE_EQUAL(transaction{}.size(level::canonical, false), zero);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__deserialize__null_chunk__nullptr)
+{
+    BOOST_REQUIRE(!transaction::deserialize(level::canonical, system::chunk_ptr{}));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__deserialize__empty_chunk__nullptr)
+{
+    const auto data = std::make_shared<system::data_chunk>();
+    BOOST_REQUIRE(!transaction::deserialize(level::canonical, data));
+}
+
+// version, marker, flag, puts, witness, locktime.
+static const system::data_chunk segregated
+{
+    0x01, 0x02, 0x03, 0x04,
+    0x00, 0x01,
+    0xaa, 0xbb, 0xcc,
+    0xdd, 0xee,
+    0x05, 0x06, 0x07, 0x08
+};
+
+// version, puts, locktime.
+static const system::data_chunk desegregated
+{
+    0x01, 0x02, 0x03, 0x04,
+    0xaa, 0xbb, 0xcc,
+    0x05, 0x06, 0x07, 0x08
+};
+
+BOOST_AUTO_TEST_CASE(transaction__desegregated_hash__segregated__stripped_hash)
+{
+    const auto expected = system::bitcoin_hash(desegregated);
+    BOOST_REQUIRE_EQUAL(transaction::desegregated_hash(segregated,
+        desegregated.size()), expected);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__desegregated_hashes__mixed__expected)
+{
+    const auto hashes = transaction::desegregated_hashes(
+        { segregated, desegregated, segregated },
+        { desegregated.size(), desegregated.size(), desegregated.size() });
+
+    const auto expected = system::bitcoin_hash(desegregated);
+    BOOST_REQUIRE_EQUAL(hashes.size(), 3u);
+    BOOST_REQUIRE_EQUAL(hashes.at(0), expected);
+    BOOST_REQUIRE_EQUAL(hashes.at(1), expected);
+    BOOST_REQUIRE_EQUAL(hashes.at(2), expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(wtxid_relay_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(wtxid_relay__properties__always__expected)
+{
+    BOOST_REQUIRE_EQUAL(wtxid_relay::command, "wtxidrelay");
+    BOOST_REQUIRE(wtxid_relay::id == identifier::wtxid_relay);
+    BOOST_REQUIRE_EQUAL(wtxid_relay::version_minimum, level::bip339);
+    BOOST_REQUIRE_EQUAL(wtxid_relay::version_maximum, level::maximum_protocol);
+}
+
+BOOST_AUTO_TEST_CASE(wtxid_relay__size__always__zero)
+{
+    BOOST_REQUIRE_EQUAL(wtxid_relay::size(level::canonical), zero);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
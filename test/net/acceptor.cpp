@@ -69,6 +69,23 @@ BOOST_AUTO_TEST_CASE(acceptor__construct__default__stopped_expected)
     BOOST_REQUIRE(instance->get_stopped());
 }
 
+BOOST_AUTO_TEST_CASE(acceptor__construct__shard__sharded_expected)
+{
+    const logger log{};
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    const settings set(bc::system::chain::selection::mainnet);
+    auto shard = std::make_shared<accessor>(log, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+
+    BOOST_REQUIRE(shard->sharded());
+    BOOST_REQUIRE(!instance->sharded());
+    BOOST_REQUIRE(&shard->get_service() == &pool.service());
+    BOOST_REQUIRE(&shard->strand() != &strand);
+    BOOST_REQUIRE(&instance->strand() == &strand);
+    BOOST_REQUIRE(shard->get_stopped());
+}
+
 // TODO: There is no way to fake failures in start.
 BOOST_AUTO_TEST_CASE(acceptor__start__stop__success)
 {
@@ -123,4 +140,40 @@ BOOST_AUTO_TEST_CASE(acceptor__accept__stop__channel_stopped)
     BOOST_REQUIRE(!result.second);
 }
 
+BOOST_AUTO_TEST_CASE(acceptor__accept__filtered_stop__channel_stopped)
+{
+    const logger log{};
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    settings set(bc::system::chain::selection::mainnet);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+
+    // Result codes inconsistent due to context.
+    instance->start(42);
+
+    std::pair<code, socket::ptr>  result{};
+    boost::asio::post(strand, [&, instance]() NOEXCEPT
+    {
+        instance->filter([](const config::authority&) NOEXCEPT
+        {
+            return false;
+        });
+
+        instance->accept([&](const code& ec, const socket::ptr& socket) NOEXCEPT
+        {
+            result.first = ec;
+            result.second = socket;
+        });
+
+        std::this_thread::sleep_for(microseconds(1));
+        instance->stop();
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE(instance->get_stopped());
+    BOOST_REQUIRE(result.first);
+    BOOST_REQUIRE(!result.second);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct anchors_tests_setup_fixture
+{
+    anchors_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+
+    ~anchors_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(anchors_tests, anchors_tests_setup_fixture)
+
+using namespace messages;
+
+class mock_settings final
+  : public settings
+{
+public:
+    using settings::settings;
+
+    // Override derivative name, using directory as file.
+    std::filesystem::path anchors_file() const NOEXCEPT override
+    {
+        return path;
+    }
+};
+
+constexpr address_item host1{ 0, 0, loopback_ip_address, 1 };
+constexpr address_item host2{ 0, 0, loopback_ip_address, 2 };
+constexpr address_item host3{ 0, 0, loopback_ip_address, 3 };
+
+BOOST_AUTO_TEST_CASE(anchors__stop__disabled__no_file)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    anchors instance(set);
+    instance.record(host1, false, hours(1));
+    BOOST_REQUIRE_EQUAL(instance.stop(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(anchors__record__short_lived__not_saved)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.anchor_connections = 2;
+    anchors instance(set);
+    instance.record(host1, false, seconds(1));
+    BOOST_REQUIRE_EQUAL(instance.stop(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(anchors__stop__recorded__block_relay_first_on_start)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.anchor_connections = 2;
+    anchors instance1(set);
+    BOOST_REQUIRE_EQUAL(instance1.start(), error::success);
+    instance1.record(host1, false, hours(1));
+    instance1.record(host2, false, hours(2));
+    instance1.record(host3, true, minutes(20));
+    BOOST_REQUIRE_EQUAL(instance1.stop(), error::success);
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+
+    anchors instance2(set);
+    BOOST_REQUIRE_EQUAL(instance2.start(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+    BOOST_REQUIRE_EQUAL(instance2.count(), 2u);
+
+    address_item_cptr anchor{};
+    BOOST_REQUIRE(instance2.take(anchor));
+    BOOST_REQUIRE_EQUAL(anchor->port, host3.port);
+    BOOST_REQUIRE(instance2.take(anchor));
+    BOOST_REQUIRE_EQUAL(anchor->port, host2.port);
+    BOOST_REQUIRE(!instance2.take(anchor));
+}
+
+BOOST_AUTO_TEST_CASE(anchors__start__invalid_file__file_load)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.anchor_connections = 2;
+    BOOST_REQUIRE(test::create(TEST_NAME));
+    anchors instance(set);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::file_load);
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(asmap_tests)
+
+using namespace messages;
+
+// ASN 42 for all addresses.
+static const data_chunk return42{ 0x00, 0x28, 0x01 };
+
+// Jump on the first address bit, ASN 1 if clear, ASN 2 if set.
+static const data_chunk jump12{ 0x01, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+constexpr ip_address high_ip_address
+{
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+};
+
+BOOST_AUTO_TEST_CASE(asmap__loaded__default__false)
+{
+    const asmap instance{};
+    BOOST_REQUIRE(!instance.loaded());
+}
+
+BOOST_AUTO_TEST_CASE(asmap__lookup__unloaded__zero)
+{
+    const asmap instance{};
+    BOOST_REQUIRE_EQUAL(instance.lookup(loopback_ip_address), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(asmap__group__unloaded__prefix_group)
+{
+    const asmap instance{};
+    const uint64_t expected = config::to_group(loopback_ip_address);
+    BOOST_REQUIRE_EQUAL(instance.group(loopback_ip_address), expected);
+}
+
+BOOST_AUTO_TEST_CASE(asmap__load__missing__file_load)
+{
+    asmap instance{};
+    BOOST_REQUIRE_EQUAL(instance.load(TEST_NAME), error::file_load);
+    BOOST_REQUIRE(!instance.loaded());
+}
+
+BOOST_AUTO_TEST_CASE(asmap__interpret__return__expected)
+{
+    BOOST_REQUIRE_EQUAL(asmap::interpret(return42, loopback_ip_address), 42u);
+    BOOST_REQUIRE_EQUAL(asmap::interpret(return42, high_ip_address), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(asmap__interpret__jump__expected)
+{
+    BOOST_REQUIRE_EQUAL(asmap::interpret(jump12, loopback_ip_address), 1u);
+    BOOST_REQUIRE_EQUAL(asmap::interpret(jump12, high_ip_address), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(asmap__interpret__truncated__zero)
+{
+    static const data_chunk truncated{ 0x01 };
+    BOOST_REQUIRE_EQUAL(asmap::interpret(truncated, loopback_ip_address), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct bans_tests_setup_fixture
+{
+    bans_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+
+    ~bans_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(bans_tests, bans_tests_setup_fixture)
+
+using namespace messages;
+
+class mock_settings final
+  : public settings
+{
+public:
+    using settings::settings;
+
+    // Override derivative name, using directory as file.
+    std::filesystem::path bans_file() const NOEXCEPT override
+    {
+        return path;
+    }
+};
+
+constexpr address_item host1{ 0, 0, loopback_ip_address, 1 };
+constexpr address_item host2{ 0, 0, loopback_ip_address, 2 };
+constexpr address_item other{ 0, 0, unspecified_ip_address, 1 };
+constexpr uint32_t now = 1'000'000;
+
+// penalty
+
+BOOST_AUTO_TEST_CASE(bans__penalty__protocol_errors__expected)
+{
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::invalid_magic), 100u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::invalid_heading), 100u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::oversized_payload), 100u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::invalid_checksum), 50u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::protocol_violation), 50u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::invalid_message), 20u);
+}
+
+BOOST_AUTO_TEST_CASE(bans__penalty__other_errors__zero)
+{
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::success), 0u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::channel_timeout), 0u);
+    BOOST_REQUIRE_EQUAL(bans::penalty(error::peer_disconnect), 0u);
+}
+
+// misbehaved
+
+BOOST_AUTO_TEST_CASE(bans__misbehaved__invalid_magic__banned_any_port)
+{
+    const settings set(bc::system::chain::selection::mainnet);
+    bans instance(set);
+    BOOST_REQUIRE(!instance.banned(host1, now));
+    BOOST_REQUIRE(instance.misbehaved(host1, error::invalid_magic, now));
+    BOOST_REQUIRE(instance.banned(host1, now));
+    BOOST_REQUIRE(instance.banned(host2, now));
+    BOOST_REQUIRE(!instance.banned(other, now));
+    BOOST_REQUIRE_EQUAL(instance.count(now), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(bans__misbehaved__accumulated__banned)
+{
+    const settings set(bc::system::chain::selection::mainnet);
+    bans instance(set);
+    BOOST_REQUIRE(!instance.misbehaved(host1, error::invalid_checksum, now));
+    BOOST_REQUIRE(!instance.banned(host1, now));
+    BOOST_REQUIRE(instance.misbehaved(host1, error::invalid_checksum, now));
+    BOOST_REQUIRE(instance.banned(host1, now));
+}
+
+BOOST_AUTO_TEST_CASE(bans__misbehaved__decayed__not_banned)
+{
+    settings set(bc::system::chain::selection::mainnet);
+    const auto half = set.ban_decay_minutes * 60u;
+    bans instance(set);
+    BOOST_REQUIRE(!instance.misbehaved(host1, error::invalid_checksum, now));
+    BOOST_REQUIRE(!instance.misbehaved(host1, error::invalid_checksum, now + half));
+    BOOST_REQUIRE(!instance.banned(host1, now + half));
+    BOOST_REQUIRE(instance.misbehaved(host1, error::invalid_checksum, now + half));
+}
+
+BOOST_AUTO_TEST_CASE(bans__misbehaved__expired__not_banned)
+{
+    const settings set(bc::system::chain::selection::mainnet);
+    const auto duration = set.ban_minutes * 60u;
+    bans instance(set);
+    BOOST_REQUIRE(instance.misbehaved(host1, error::invalid_heading, now));
+    BOOST_REQUIRE(instance.banned(host1, sub1(now + duration)));
+    BOOST_REQUIRE(!instance.banned(host1, now + duration));
+    BOOST_REQUIRE_EQUAL(instance.count(now + duration), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(bans__misbehaved__zero_threshold__not_banned)
+{
+    settings set(bc::system::chain::selection::mainnet);
+    set.ban_threshold = 0;
+    bans instance(set);
+    BOOST_REQUIRE(!instance.misbehaved(host1, error::invalid_magic, now));
+    BOOST_REQUIRE(!instance.banned(host1, now));
+}
+
+BOOST_AUTO_TEST_CASE(bans__misbehaved__not_misbehavior__not_banned)
+{
+    const settings set(bc::system::chain::selection::mainnet);
+    bans instance(set);
+    BOOST_REQUIRE(!instance.misbehaved(host1, error::channel_timeout, now));
+    BOOST_REQUIRE(!instance.banned(host1, now));
+}
+
+// start/stop
+
+BOOST_AUTO_TEST_CASE(bans__stop__disabled__no_file)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    bans instance(set);
+    BOOST_REQUIRE(instance.misbehaved(host1, error::invalid_magic));
+    BOOST_REQUIRE_EQUAL(instance.stop(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(bans__stop__banned__restored_on_start)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    bans instance1(set);
+    BOOST_REQUIRE_EQUAL(instance1.start(), error::success);
+    BOOST_REQUIRE(instance1.misbehaved(host1, error::invalid_magic));
+    BOOST_REQUIRE_EQUAL(instance1.stop(), error::success);
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+
+    bans instance2(set);
+    BOOST_REQUIRE_EQUAL(instance2.start(), error::success);
+    BOOST_REQUIRE(instance2.banned(host2));
+    BOOST_REQUIRE(!instance2.banned(other));
+    BOOST_REQUIRE_EQUAL(instance2.count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(bans__stop__empty__file_removed)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    BOOST_REQUIRE(test::create(TEST_NAME));
+    bans instance(set);
+    BOOST_REQUIRE_EQUAL(instance.stop(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_stream_tests)
+
+using namespace system;
+using namespace network::messages;
+
+// Mainnet genesis block.
+static const auto genesis = base16_chunk(
+    "0100000000000000000000000000000000000000000000000000000000000000"
+    "000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa"
+    "4b1e5e4a29ab5f49ffff001d1dac2b7c01010000000100000000000000000000"
+    "00000000000000000000000000000000000000000000ffffffff4d04ffff001d"
+    "0104455468652054696d65732030332f4a616e2f32303039204368616e63656c"
+    "6c6f72206f6e206272696e6b206f66207365636f6e64206261696c6f75742066"
+    "6f722062616e6b73ffffffff0100f2052a01000000434104678afdb0fe554827"
+    "1967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4"
+    "f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac00000000");
+
+static chunk_ptr to_payload() NOEXCEPT
+{
+    return std::make_shared<data_chunk>(genesis);
+}
+
+BOOST_AUTO_TEST_CASE(block_stream__advance__chunks__expected_block)
+{
+    const auto payload = to_payload();
+    block_stream instance(payload, level::maximum_protocol, false);
+
+    for (size_t filled = 50; filled < payload->size(); filled += 50)
+        BOOST_REQUIRE(instance.advance(filled));
+
+    BOOST_REQUIRE_EQUAL(instance.parsed(), 0u);
+    BOOST_REQUIRE(instance.advance(payload->size()));
+    BOOST_REQUIRE_EQUAL(instance.parsed(), 1u);
+
+    const auto message = instance.finish();
+    BOOST_REQUIRE(message);
+    BOOST_REQUIRE(!message->payload_ptr);
+    BOOST_REQUIRE_EQUAL(message->block_ptr->transactions_ptr()->size(), 1u);
+    BOOST_REQUIRE_EQUAL(message->block_ptr->hash(),
+        bitcoin_hash(chain::header::serialized_size(), genesis.data()));
+}
+
+BOOST_AUTO_TEST_CASE(block_stream__finish__retain__payload_retained)
+{
+    const auto payload = to_payload();
+    block_stream instance(payload, level::maximum_protocol, true);
+    BOOST_REQUIRE(instance.advance(payload->size()));
+
+    const auto message = instance.finish();
+    BOOST_REQUIRE(message);
+    BOOST_REQUIRE(message->payload_ptr == payload);
+}
+
+BOOST_AUTO_TEST_CASE(block_stream__finish__incomplete__nullptr)
+{
+    const auto payload = to_payload();
+    block_stream instance(payload, level::maximum_protocol, false);
+    BOOST_REQUIRE(instance.advance(sub1(payload->size())));
+    BOOST_REQUIRE(!instance.finish());
+}
+
+BOOST_AUTO_TEST_CASE(block_stream__advance__missing_transaction__false)
+{
+    // Two transactions are declared, but only one is present.
+    const auto payload = to_payload();
+    payload->at(chain::header::serialized_size()) = 0x02;
+    block_stream instance(payload, level::maximum_protocol, false);
+    BOOST_REQUIRE(instance.advance(100));
+    BOOST_REQUIRE(!instance.advance(payload->size()));
+    BOOST_REQUIRE(!instance.finish());
+}
+
+BOOST_AUTO_TEST_CASE(block_stream__advance__invalid_version__false)
+{
+    const auto payload = to_payload();
+    block_stream instance(payload, sub1(block::version_minimum), false);
+    BOOST_REQUIRE(!instance.advance(payload->size()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
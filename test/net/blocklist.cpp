@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct blocklist_tests_setup_fixture
+{
+    blocklist_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+
+    ~blocklist_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(blocklist_tests, blocklist_tests_setup_fixture)
+
+using namespace network::config;
+
+BOOST_AUTO_TEST_CASE(blocklist__parse__lines__expected_prefixes_and_invalid)
+{
+    subnets::prefixes out{};
+    const auto invalid = blocklist::parse(out,
+        "# comment\n"
+        "42.42.42.0/24\n"
+        "  24.24.24.24  # host\r\n"
+        "\n"
+        "2020:db8::/32\n"
+        "42.42.42.0/33\n"
+        "not-an-address\n"
+        "1.2.3.4/x");
+
+    BOOST_REQUIRE_EQUAL(invalid, 3u);
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+    BOOST_REQUIRE_EQUAL(out.at(0).cidr, 24u);
+    BOOST_REQUIRE_EQUAL(out.at(1).cidr, 0u);
+    BOOST_REQUIRE_EQUAL(out.at(2).cidr, 32u);
+}
+
+BOOST_AUTO_TEST_CASE(blocklist__refresh__missing__file_load)
+{
+    blocklist instance{ TEST_NAME };
+    BOOST_REQUIRE_EQUAL(instance.refresh(), error::file_load);
+    BOOST_REQUIRE(is_zero(instance.size()));
+    BOOST_REQUIRE(!instance.contains(address{ "42.42.42.42" }));
+}
+
+BOOST_AUTO_TEST_CASE(blocklist__refresh__text__contains_expected)
+{
+    {
+        std::ofstream file{ TEST_NAME };
+        file << "42.42.42.0/24\n# ipv6 host\n2020:db8::2\n";
+    }
+
+    blocklist instance{ TEST_NAME, 4 };
+    BOOST_REQUIRE_EQUAL(instance.refresh(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE(instance.contains(address{ "42.42.42.42:8333" }));
+    BOOST_REQUIRE(instance.contains(address{ "[2020:db8::2]" }));
+    BOOST_REQUIRE(!instance.contains(address{ "42.42.43.42" }));
+
+    // Unchanged file is not reloaded.
+    BOOST_REQUIRE_EQUAL(instance.refresh(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(blocklist__save__binary__round_trip)
+{
+    subnets::prefixes values{};
+    BOOST_REQUIRE(is_zero(blocklist::parse(values, "42.42.42.0/24\n")));
+    BOOST_REQUIRE_EQUAL(blocklist::save(TEST_NAME, values), error::success);
+
+    blocklist instance{ TEST_NAME };
+    BOOST_REQUIRE_EQUAL(instance.refresh(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.contains(address{ "42.42.42.1" }));
+    BOOST_REQUIRE(!instance.contains(address{ "42.42.41.1" }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
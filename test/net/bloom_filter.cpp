@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+using namespace system;
+using namespace network::messages;
+
+static uint32_t murmur3(uint32_t seed, const std::string& text) NOEXCEPT
+{
+    return bloom_filter::murmur3(seed, base16_chunk(text));
+}
+
+static const auto element1 = base16_chunk(
+    "99108ad8ed9bb6274d3980bab5a85c048f0950c8");
+static const auto element2 = base16_chunk(
+    "19108ad8ed9bb6274d3980bab5a85c048f0950c8");
+static const auto element3 = base16_chunk(
+    "b5a2c786d9ef4658287ced5914b37a1b4aa32eee");
+static const auto element4 = base16_chunk(
+    "b9300670b4c5366e95b2699e8b18bc75e5f729c5");
+
+BOOST_AUTO_TEST_CASE(bloom_filter__murmur3__vectors__expected)
+{
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, ""), 0x00000000u);
+    BOOST_REQUIRE_EQUAL(murmur3(0xfba4c795, ""), 0x6a396f08u);
+    BOOST_REQUIRE_EQUAL(murmur3(0xffffffff, ""), 0x81f16f39u);
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, "00"), 0x514e28b7u);
+    BOOST_REQUIRE_EQUAL(murmur3(0xfba4c795, "00"), 0xea3f0b17u);
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, "ff"), 0xfd6cf10du);
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, "0011"), 0x16c6b7abu);
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, "001122"), 0x8eb51c3du);
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, "00112233"), 0xb4471bf8u);
+    BOOST_REQUIRE_EQUAL(murmur3(0x00000000, "0011223344"), 0xe2301fa8u);
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_valid__limits__expected)
+{
+    BOOST_REQUIRE(bloom_filter::is_valid({ data_chunk(36'000), 50, 0, 0 }));
+    BOOST_REQUIRE(!bloom_filter::is_valid({ data_chunk(36'001), 50, 0, 0 }));
+    BOOST_REQUIRE(!bloom_filter::is_valid({ data_chunk(36'000), 51, 0, 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__contains__empty_filter__true)
+{
+    const bloom_filter instance({ {}, 5, 0, 0 });
+    BOOST_REQUIRE(instance.contains(base16_chunk("00")));
+}
+
+// Bitcoin Core bloom_tests (3 elements, 0.01, tweak 0) is 0x614e9b.
+BOOST_AUTO_TEST_CASE(bloom_filter__contains__core_vector__expected)
+{
+    const bloom_filter instance({ base16_chunk("614e9b"), 5, 0, 1 });
+    BOOST_REQUIRE(instance.contains(element1));
+    BOOST_REQUIRE(!instance.contains(element2));
+    BOOST_REQUIRE(instance.contains(element3));
+    BOOST_REQUIRE(instance.contains(element4));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__core_vector__contains_expected)
+{
+    bloom_filter instance({ data_chunk(3), 5, 0, 1 });
+    instance.insert(element1);
+    instance.insert(element3);
+    instance.insert(element4);
+    BOOST_REQUIRE(instance.contains(element1));
+    BOOST_REQUIRE(!instance.contains(element2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct capture_tests_setup_fixture
+{
+    capture_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+
+    ~capture_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(capture_tests, capture_tests_setup_fixture)
+
+BOOST_AUTO_TEST_CASE(capture__construct__created__good_magic)
+{
+    {
+        const capture instance{ TEST_NAME };
+        BOOST_REQUIRE(instance.good());
+    }
+
+    std::ifstream file{ TEST_NAME, std::ios::in | std::ios::binary };
+    capture::record record{};
+    BOOST_REQUIRE(capture::read_magic(file));
+    BOOST_REQUIRE(!capture::read(file, record));
+}
+
+BOOST_AUTO_TEST_CASE(capture__write__records__read_in_order)
+{
+    const system::data_chunk heading1{ 0x01, 0x02, 0x03 };
+    const system::data_chunk payload1{ 0x04, 0x05 };
+    const system::data_chunk heading2{ 0x06 };
+    const system::data_chunk payload2{};
+    {
+        capture instance{ TEST_NAME };
+        BOOST_REQUIRE(instance.write(heading1, payload1));
+        BOOST_REQUIRE(instance.write(heading2, payload2));
+    }
+
+    std::ifstream file{ TEST_NAME, std::ios::in | std::ios::binary };
+    BOOST_REQUIRE(capture::read_magic(file));
+
+    capture::record first{};
+    BOOST_REQUIRE(capture::read(file, first));
+    BOOST_REQUIRE_EQUAL(first.message,
+        system::data_chunk({ 0x01, 0x02, 0x03, 0x04, 0x05 }));
+
+    capture::record second{};
+    BOOST_REQUIRE(capture::read(file, second));
+    BOOST_REQUIRE_EQUAL(second.message, heading2);
+    BOOST_REQUIRE_GE(second.microseconds, first.microseconds);
+
+    capture::record third{};
+    BOOST_REQUIRE(!capture::read(file, third));
+}
+
+BOOST_AUTO_TEST_CASE(capture__read_magic__not_capture__false)
+{
+    {
+        std::ofstream file{ TEST_NAME, std::ios::out | std::ios::binary };
+        file << "hosts";
+    }
+
+    std::ifstream file{ TEST_NAME, std::ios::in | std::ios::binary };
+    BOOST_REQUIRE(!capture::read_magic(file));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -41,6 +41,26 @@ public:
         return channel::validate_checksum();
     }
 
+    size_t rate_limit() const NOEXCEPT override
+    {
+        return channel::rate_limit();
+    }
+
+    size_t send_high_water() const NOEXCEPT override
+    {
+        return channel::send_high_water();
+    }
+
+    size_t send_low_water() const NOEXCEPT override
+    {
+        return channel::send_low_water();
+    }
+
+    deadline::duration send_grace() const NOEXCEPT override
+    {
+        return channel::send_grace();
+    }
+
     uint32_t version() const NOEXCEPT override
     {
         return channel::version();
@@ -54,7 +74,8 @@ BOOST_AUTO_TEST_CASE(channel__stopped__default__false)
     asio::strand strand(pool.service().get_executor());
     const settings set(bc::system::chain::selection::mainnet);
     auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
-    auto channel_ptr = std::make_shared<channel>(log, socket_ptr, set, 42);
+    auto channel_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42);
     BOOST_REQUIRE(!channel_ptr->stopped());
 
     // Stop completion is asynchronous.
@@ -75,7 +96,8 @@ BOOST_AUTO_TEST_CASE(channel__properties__default__expected)
     asio::strand strand(pool.service().get_executor());
     const settings set(bc::system::chain::selection::mainnet);
     auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
-    auto channel_ptr = std::make_shared<channel_accessor>(log, socket_ptr, set, 42);
+    auto channel_ptr = std::make_shared<channel_accessor>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42);
 
     BOOST_REQUIRE(!channel_ptr->address());
     BOOST_REQUIRE_NE(channel_ptr->nonce(), 0u);
@@ -88,9 +110,145 @@ BOOST_AUTO_TEST_CASE(channel__properties__default__expected)
     BOOST_REQUIRE_EQUAL(channel_ptr->protocol_magic(), set.identifier);
     BOOST_REQUIRE_EQUAL(channel_ptr->validate_checksum(), set.validate_checksum);
     BOOST_REQUIRE_EQUAL(channel_ptr->version(), set.protocol_maximum);
+    BOOST_REQUIRE_EQUAL(channel_ptr->rate_limit(), set.rate_limit * 1024u);
+    BOOST_REQUIRE_EQUAL(channel_ptr->send_high_water(), set.send_high_water);
+    BOOST_REQUIRE_EQUAL(channel_ptr->send_low_water(), set.send_low_water);
+    BOOST_REQUIRE(channel_ptr->send_grace() == set.send_grace());
 
     channel_ptr->stop(error::invalid_magic);
     channel_ptr.reset();
 }
 
+BOOST_AUTO_TEST_CASE(channel__set_block_relay__true__block_relay)
+{
+    const logger log{};
+    threadpool pool(1);
+    const settings set(bc::system::chain::selection::mainnet);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto channel_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42);
+    BOOST_REQUIRE(!channel_ptr->block_relay());
+
+    channel_ptr->set_block_relay(true);
+    BOOST_REQUIRE(channel_ptr->block_relay());
+
+    channel_ptr->stop(error::invalid_magic);
+    channel_ptr.reset();
+}
+
+BOOST_AUTO_TEST_CASE(channel__round_trip__default__zeros)
+{
+    const logger log{};
+    threadpool pool(1);
+    const settings set(bc::system::chain::selection::mainnet);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto channel_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42);
+
+    const auto latency = channel_ptr->round_trip();
+    BOOST_REQUIRE_EQUAL(latency.smoothed, 0u);
+    BOOST_REQUIRE_EQUAL(latency.minimum, 0u);
+    BOOST_REQUIRE_EQUAL(latency.jitter, 0u);
+
+    channel_ptr->stop(error::invalid_magic);
+    channel_ptr.reset();
+}
+
+BOOST_AUTO_TEST_CASE(channel__set_round_trip__samples__smoothed)
+{
+    const logger log{};
+    threadpool pool(1);
+    const settings set(bc::system::chain::selection::mainnet);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto channel_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42);
+
+    std::promise<bool> sampled;
+    boost::asio::post(channel_ptr->strand(), [=, &sampled]() NOEXCEPT
+    {
+        channel_ptr->set_round_trip(1000);
+        const auto first = channel_ptr->round_trip();
+        channel_ptr->set_round_trip(2000);
+        const auto second = channel_ptr->round_trip();
+        channel_ptr->set_round_trip(400);
+        const auto third = channel_ptr->round_trip();
+
+        sampled.set_value(
+            first.smoothed == 1000u && first.minimum == 1000u &&
+            first.jitter == 500u &&
+            second.smoothed == 1125u && second.minimum == 1000u &&
+            second.jitter == 625u &&
+            third.smoothed == 1035u && third.minimum == 400u &&
+            third.jitter == 650u);
+    });
+
+    BOOST_REQUIRE(sampled.get_future().get());
+    channel_ptr->stop(error::invalid_magic);
+    channel_ptr.reset();
+}
+
+BOOST_AUTO_TEST_CASE(channel__memory__idle__expected_components)
+{
+    const logger log{};
+    threadpool pool(1);
+    const settings set(bc::system::chain::selection::mainnet);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto channel_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42);
+
+    std::promise<proxy::footprint> measured;
+    boost::asio::post(channel_ptr->strand(), [=, &measured]() NOEXCEPT
+    {
+        measured.set_value(channel_ptr->memory());
+    });
+
+    const auto footprint = measured.get_future().get();
+    BOOST_REQUIRE_EQUAL(footprint.object, sizeof(channel));
+    BOOST_REQUIRE_EQUAL(footprint.socket, sizeof(network::socket));
+    BOOST_REQUIRE_EQUAL(footprint.queues, 0u);
+    BOOST_REQUIRE_EQUAL(footprint.protocols, 0u);
+    BOOST_REQUIRE_GE(footprint.total(), footprint.object + footprint.socket +
+        footprint.filters);
+
+    channel_ptr->stop(error::invalid_magic);
+    channel_ptr.reset();
+}
+
+BOOST_AUTO_TEST_CASE(channel__memory__quiet__expiration_timer_only)
+{
+    const logger log{};
+    threadpool pool(1);
+    const settings set(bc::system::chain::selection::mainnet);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto quiet_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42, true);
+    auto loud_ptr = std::make_shared<channel>(log, socket_ptr, set,
+        std::make_shared<resources>(set), 42, false);
+
+    std::promise<proxy::footprint> quiet;
+    boost::asio::post(quiet_ptr->strand(), [=, &quiet]() NOEXCEPT
+    {
+        quiet.set_value(quiet_ptr->memory());
+    });
+
+    std::promise<proxy::footprint> loud;
+    boost::asio::post(loud_ptr->strand(), [=, &loud]() NOEXCEPT
+    {
+        loud.set_value(loud_ptr->memory());
+    });
+
+    const auto quiet_footprint = quiet.get_future().get();
+    const auto loud_footprint = loud.get_future().get();
+    BOOST_REQUIRE(quiet_ptr->quiet());
+    BOOST_REQUIRE(!loud_ptr->quiet());
+    BOOST_REQUIRE_EQUAL(quiet_footprint.timers + two * sizeof(deadline),
+        loud_footprint.timers);
+    BOOST_REQUIRE_LT(quiet_footprint.filters, loud_footprint.filters);
+
+    quiet_ptr->stop(error::invalid_magic);
+    loud_ptr->stop(error::invalid_magic);
+    quiet_ptr.reset();
+    loud_ptr.reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(checksum_batcher_tests)
+
+using namespace system;
+
+static chunk_ptr to_payload(size_t size) NOEXCEPT
+{
+    const auto payload = std::make_shared<data_chunk>(size);
+    for (size_t index = 0; index < size; ++index)
+        (*payload)[index] = static_cast<uint8_t>(index + size);
+
+    return payload;
+}
+
+BOOST_AUTO_TEST_CASE(checksum_batcher__submit__window__expected_hash)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    checksum_batcher batcher(milliseconds(1));
+    std::promise<hash_digest> promise{};
+    const auto payload = to_payload(100);
+    const auto expected = bitcoin_hash(*payload);
+
+    batcher.submit(payload, strand, [&](const hash_cptr& hash) NOEXCEPT
+    {
+        BOOST_REQUIRE(strand.running_in_this_thread());
+        promise.set_value(*hash);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(checksum_batcher__submit__full_lanes__expected_hashes)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+
+    // The window exceeds the test, so the full group is hashed immediately.
+    checksum_batcher batcher(seconds(42));
+    std::vector<std::promise<hash_digest>> promises(payload_hash::lanes);
+    std::vector<chunk_ptr> payloads{};
+
+    for (size_t lane = 0; lane < payload_hash::lanes; ++lane)
+    {
+        payloads.push_back(to_payload(lane * 50));
+        batcher.submit(payloads.back(), strand,
+            [&, lane](const hash_cptr& hash) NOEXCEPT
+            {
+                promises[lane].set_value(*hash);
+            });
+    }
+
+    for (size_t lane = 0; lane < payload_hash::lanes; ++lane)
+        BOOST_REQUIRE_EQUAL(promises[lane].get_future().get(),
+            bitcoin_hash(*payloads[lane]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -59,7 +59,8 @@ BOOST_AUTO_TEST_CASE(connector__construct__default__stopped_expected)
     threadpool pool(1);
     asio::strand strand(pool.service().get_executor());
     const settings set(bc::system::chain::selection::mainnet);
-    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
 
     BOOST_REQUIRE(&instance->get_settings() == &set);
     BOOST_REQUIRE(&instance->get_service() == &pool.service());
@@ -73,7 +74,8 @@ class tiny_timeout
 {
     using settings::settings;
 
-    steady_clock::duration connect_timeout() const NOEXCEPT override
+    steady_clock::duration connect_timeout(
+        const timeout_estimator&) const NOEXCEPT override
     {
         return microseconds(1);
     }
@@ -86,7 +88,8 @@ BOOST_AUTO_TEST_CASE(connector__connect_address__bogus_address__operation_timeou
     threadpool pool(2);
     asio::strand strand(pool.service().get_executor());
     const tiny_timeout set(bc::system::chain::selection::mainnet);
-    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
     auto result = true;
 
     boost::asio::post(strand, [&]() NOEXCEPT
@@ -116,7 +119,8 @@ BOOST_AUTO_TEST_CASE(connector__connect_authority__bogus_authority__operation_ti
     threadpool pool(2);
     asio::strand strand(pool.service().get_executor());
     const tiny_timeout set(bc::system::chain::selection::mainnet);
-    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
     auto result = true;
 
     boost::asio::post(strand, [&, instance]() NOEXCEPT
@@ -146,7 +150,8 @@ BOOST_AUTO_TEST_CASE(connector__connect_endpoint__bogus_hostname__resolve_failed
     threadpool pool(2);
     asio::strand strand(pool.service().get_executor());
     const tiny_timeout set(bc::system::chain::selection::mainnet);
-    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
     auto result = true;
 
     boost::asio::post(strand, [&, instance]() NOEXCEPT
@@ -167,6 +172,37 @@ BOOST_AUTO_TEST_CASE(connector__connect_endpoint__bogus_hostname__resolve_failed
     BOOST_REQUIRE(result);
 }
 
+BOOST_AUTO_TEST_CASE(connector__connect_endpoint__numeric_host__operation_timeout)
+{
+    logger log{};
+    log.stop();
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    const tiny_timeout set(bc::system::chain::selection::mainnet);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
+    auto result = true;
+
+    boost::asio::post(strand, [&, instance]() NOEXCEPT
+    {
+        // Numeric host is not resolved, timeout includes a socket.
+        instance->connect(config::endpoint{ "42.42.42.42", 42 },
+            [&](const code& ec, const socket::ptr& socket) NOEXCEPT
+            {
+                result &= (ec == error::operation_timeout);
+                result &= !is_null(socket);
+                result &= socket->stopped();
+            });
+
+        std::this_thread::sleep_for(microseconds(1));
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE(instance->get_stopped());
+    BOOST_REQUIRE(result);
+}
+
 BOOST_AUTO_TEST_CASE(connector__connect__stop__resolve_failed_race_operation_canceled)
 {
     logger log{};
@@ -175,7 +211,8 @@ BOOST_AUTO_TEST_CASE(connector__connect__stop__resolve_failed_race_operation_can
     asio::strand strand(pool.service().get_executor());
     settings set(bc::system::chain::selection::mainnet);
     set.connect_timeout_seconds = 1000;
-    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
     auto result = true;
 
     boost::asio::post(strand, [&, instance]()NOEXCEPT
@@ -205,7 +242,8 @@ BOOST_AUTO_TEST_CASE(connector__connect__started_start__operation_failed)
     asio::strand strand(pool.service().get_executor());
     settings set(bc::system::chain::selection::mainnet);
     set.connect_timeout_seconds = 1000;
-    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set);
+    auto instance = std::make_shared<accessor>(log, strand, pool.service(), set,
+        std::make_shared<resources>(set));
     auto result = true;
 
     boost::asio::post(strand, [&, instance]() NOEXCEPT
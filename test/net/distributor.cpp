@@ -69,6 +69,35 @@ BOOST_AUTO_TEST_CASE(distributor__subscribe__stop__expected_code)
     BOOST_REQUIRE(result);
 }
 
+BOOST_AUTO_TEST_CASE(distributor__subscribe__stopped__subscriber_stopped)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+    auto result = true;
+
+    std::promise<code> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.stop(error::service_stopped);
+        const auto ec = instance.subscribe([&](const code& ec,
+            const messages::pong::cptr& pong) NOEXCEPT
+        {
+            result &= is_null(pong);
+            promise.set_value(ec);
+            return true;
+        });
+
+        result &= (ec == error::subscriber_stopped);
+        result &= !instance.subscribed(messages::identifier::pong);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::subscriber_stopped);
+    BOOST_REQUIRE(result);
+}
+
 BOOST_AUTO_TEST_CASE(distributor__notify__invalid_message__no_notification)
 {
     threadpool pool(2);
@@ -199,4 +228,209 @@ BOOST_AUTO_TEST_CASE(distributor__notify__valid_nonced_ping__expected_notificati
     BOOST_REQUIRE(result);
 }
 
+BOOST_AUTO_TEST_CASE(distributor__subscribed__no_subscriber__false)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    std::promise<bool> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        promise.set_value(instance.subscribed(messages::identifier::ping) ||
+            instance.subscribed(messages::identifier::unknown));
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE(!promise.get_future().get());
+}
+
+BOOST_AUTO_TEST_CASE(distributor__subscribed__subscriber__true_for_type_only)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    std::promise<bool> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.subscribe([&](const code&, const messages::ping::cptr&) NOEXCEPT
+        {
+            return true;
+        });
+
+        promise.set_value(instance.subscribed(messages::identifier::ping) &&
+            !instance.subscribed(messages::identifier::pong));
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE(promise.get_future().get());
+}
+
+BOOST_AUTO_TEST_CASE(distributor__notify__no_subscriber_invalid_message__success)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    // Invalid payload is not deserialized when there is no subscriber.
+    std::promise<code> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        const system::data_chunk empty{};
+        constexpr auto nonced_ping_version = messages::level::bip31;
+        promise.set_value(instance.notify(messages::identifier::ping,
+            nonced_ping_version, empty));
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(distributor__notify__unknown__unknown_message)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    std::promise<code> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        const system::data_chunk empty{};
+        promise.set_value(instance.notify(messages::identifier::unknown,
+            messages::level::bip31, empty));
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::unknown_message);
+}
+
+BOOST_AUTO_TEST_CASE(distributor__prepare__unknown__unknown_message)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    // Prepare does not require the strand.
+    distributor::delivery delivery{};
+    const system::data_chunk empty{};
+    BOOST_REQUIRE_EQUAL(instance.prepare(delivery, messages::identifier::unknown,
+        messages::level::bip31, empty), error::unknown_message);
+    BOOST_REQUIRE(!delivery);
+
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(distributor__prepare__invalid_message__invalid_message)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    distributor::delivery delivery{};
+    const system::data_chunk empty{};
+    BOOST_REQUIRE_EQUAL(instance.prepare(delivery, messages::identifier::ping,
+        messages::level::bip31, empty), error::invalid_message);
+    BOOST_REQUIRE(!delivery);
+
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(distributor__prepare__valid_nonced_ping__expected_delivery)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+    constexpr uint64_t expected_nonce = 42;
+
+    // Deserialization occurs off of the strand.
+    distributor::delivery delivery{};
+    const auto ping = system::to_little_endian_size(expected_nonce, sizeof(uint64_t));
+    BOOST_REQUIRE_EQUAL(instance.prepare(delivery, messages::identifier::ping,
+        messages::level::bip31, ping), error::success);
+    BOOST_REQUIRE(delivery);
+
+    std::promise<uint64_t> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.subscribe([&](const code&, const messages::ping::cptr& ping) NOEXCEPT
+        {
+            if (ping)
+                promise.set_value(ping->nonce);
+
+            return false;
+        });
+
+        delivery();
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), expected_nonce);
+}
+
+BOOST_AUTO_TEST_CASE(distributor__priority__defaults__expected)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    using lane = distributor::lane;
+    BOOST_REQUIRE(instance.priority(messages::identifier::unknown) == lane::normal);
+    BOOST_REQUIRE(instance.priority(messages::identifier::version) == lane::control);
+    BOOST_REQUIRE(instance.priority(messages::identifier::ping) == lane::control);
+    BOOST_REQUIRE(instance.priority(messages::identifier::inventory) == lane::normal);
+    BOOST_REQUIRE(instance.priority(messages::identifier::block) == lane::bulk);
+
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(distributor__prioritize__headers_bulk__bulk)
+{
+    threadpool pool(2);
+    asio::strand strand(pool.service().get_executor());
+    distributor instance(strand);
+
+    using lane = distributor::lane;
+    std::promise<bool> promise;
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        instance.prioritize<messages::headers>(lane::bulk);
+        promise.set_value(
+            instance.priority(messages::identifier::headers) == lane::bulk);
+        instance.stop(error::service_stopped);
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+    BOOST_REQUIRE(promise.get_future().get());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(eviction_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(eviction__select__empty__false)
+{
+    uint64_t out{};
+    BOOST_REQUIRE(!eviction::select(out, {}));
+}
+
+BOOST_AUTO_TEST_CASE(eviction__select__distinct_groups__false)
+{
+    eviction::candidates peers{};
+    for (auto group = 0u; group < eviction::protect_group; ++group)
+        peers.push_back({ group, group, 0, 0, seconds{ 1 } });
+
+    uint64_t out{};
+    BOOST_REQUIRE(!eviction::select(out, peers));
+}
+
+BOOST_AUTO_TEST_CASE(eviction__select__one_group__youngest_unprotected)
+{
+    // Older peers are slower and younger peers receive more.
+    eviction::candidates peers{};
+    for (uint64_t id = 1; id <= 40u; ++id)
+        peers.push_back({ id, 7, id * 1000u, 41u - id, seconds(id) });
+
+    // Protected: 40 (group), 1-8 (round trip), 9-12 (received) and 27-39
+    // (uptime), leaving 13-26 of which 13 is youngest.
+    uint64_t out{};
+    BOOST_REQUIRE(eviction::select(out, peers));
+    BOOST_REQUIRE_EQUAL(out, 13u);
+}
+
+BOOST_AUTO_TEST_CASE(eviction__select__unsampled_round_trip__not_protected)
+{
+    // All peers are unsampled but one, which is protected by round trip.
+    eviction::candidates peers{};
+    for (uint64_t id = 1; id <= 20u; ++id)
+        peers.push_back({ id, 7, 0, 0, seconds(100u - id) });
+
+    peers.back().round_trip = 1000;
+
+    // With ties the youngest unprotected is selected, never the sampled.
+    uint64_t out{};
+    BOOST_REQUIRE(eviction::select(out, peers));
+    BOOST_REQUIRE_NE(out, 20u);
+}
+
+BOOST_AUTO_TEST_CASE(eviction__select__processing__most_costly_unprotected)
+{
+    // Younger peers are faster and older peers receive more.
+    eviction::candidates peers{};
+    for (uint64_t id = 1; id <= 20u; ++id)
+        peers.push_back({ id, 7, id * 1000u, id, seconds(id), 0 });
+
+    // Protected: 20 (group), 1-8 (round trip), 16-19 (received) and 13-15
+    // (uptime), leaving 9-12 of which 11 is the most costly (not youngest).
+    peers.at(10).processing = 1'000'000;
+
+    uint64_t out{};
+    BOOST_REQUIRE(eviction::select(out, peers));
+    BOOST_REQUIRE_EQUAL(out, 11u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+#if !defined(HAVE_MSC)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+BOOST_AUTO_TEST_SUITE(export_ring_tests)
+
+#if !defined(HAVE_MSC)
+
+using namespace system;
+using namespace network::messages;
+
+const std::string name{ "/libbitcoin-network-test-export-ring" };
+
+BOOST_AUTO_TEST_CASE(export_ring__construct__empty_name__not_good)
+{
+    const export_ring producer({}, 1'000, 16);
+    const export_ring consumer(std::string{});
+    BOOST_REQUIRE(!producer.good());
+    BOOST_REQUIRE(!consumer.good());
+}
+
+BOOST_AUTO_TEST_CASE(export_ring__construct__not_created__consumer_not_good)
+{
+    const export_ring consumer(name + "-none");
+    BOOST_REQUIRE(!consumer.good());
+}
+
+BOOST_AUTO_TEST_CASE(export_ring__construct__producer__owner_only)
+{
+    const export_ring producer(name, 1'000, 16);
+    BOOST_REQUIRE(producer.good());
+
+    struct stat status{};
+    const auto descriptor = ::shm_open(name.c_str(), O_RDONLY, 0);
+    BOOST_REQUIRE(descriptor >= 0);
+    BOOST_REQUIRE_EQUAL(::fstat(descriptor, &status), 0);
+    ::close(descriptor);
+    BOOST_REQUIRE_EQUAL(status.st_mode & 0777, 0600u);
+}
+
+BOOST_AUTO_TEST_CASE(export_ring__write__read__intact)
+{
+    export_ring producer(name, 1'000, 16);
+    const export_ring consumer(name);
+    BOOST_REQUIRE(producer.good());
+    BOOST_REQUIRE(consumer.good());
+    BOOST_REQUIRE_EQUAL(consumer.capacity(), 1'000u);
+
+    const data_chunk payload{ 0x01, 0x02, 0x03 };
+    export_ring::record out{};
+    BOOST_REQUIRE(consumer.read(out, 0) == export_ring::status::pending);
+    BOOST_REQUIRE(producer.write(identifier::transaction, 42, 70016, payload));
+    BOOST_REQUIRE_EQUAL(consumer.head(), 1u);
+    BOOST_REQUIRE(consumer.read(out, 0) == export_ring::status::ready);
+    BOOST_REQUIRE(out.id == identifier::transaction);
+    BOOST_REQUIRE_EQUAL(out.channel, 42u);
+    BOOST_REQUIRE_EQUAL(out.version, 70016u);
+    BOOST_REQUIRE_EQUAL(out.payload.to_chunk(), payload);
+    BOOST_REQUIRE(consumer.intact(out));
+}
+
+BOOST_AUTO_TEST_CASE(export_ring__write__oversized__false)
+{
+    export_ring producer(name, 10, 16);
+    export_ring consumer(name);
+    BOOST_REQUIRE(!producer.write(identifier::block, 1, 1, data_chunk(11)));
+    BOOST_REQUIRE(producer.write(identifier::block, 1, 1, data_chunk(10)));
+    BOOST_REQUIRE(!consumer.write(identifier::block, 1, 1, data_chunk(1)));
+    BOOST_REQUIRE_EQUAL(consumer.head(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(export_ring__write__slots_lapped__lapped)
+{
+    export_ring producer(name, 1'000, 4);
+    const export_ring consumer(name);
+
+    for (uint8_t index = 0; index < 6u; ++index)
+        BOOST_REQUIRE(producer.write(identifier::ping, 1, 1, { index }));
+
+    export_ring::record out{};
+    BOOST_REQUIRE_EQUAL(consumer.tail(), 2u);
+    BOOST_REQUIRE(consumer.read(out, 1) == export_ring::status::lapped);
+    BOOST_REQUIRE(consumer.read(out, 2) == export_ring::status::ready);
+    BOOST_REQUIRE_EQUAL(out.payload.to_chunk(), data_chunk{ 0x02 });
+    BOOST_REQUIRE(consumer.read(out, 6) == export_ring::status::pending);
+}
+
+BOOST_AUTO_TEST_CASE(export_ring__write__arena_overwritten__not_intact)
+{
+    export_ring producer(name, 10, 16);
+    const export_ring consumer(name);
+    BOOST_REQUIRE(producer.write(identifier::ping, 1, 1, data_chunk(6, 0x01)));
+
+    export_ring::record out{};
+    BOOST_REQUIRE(consumer.read(out, 0) == export_ring::status::ready);
+
+    // The second payload wraps to the start of the arena, over the first.
+    BOOST_REQUIRE(producer.write(identifier::ping, 1, 1, data_chunk(6, 0x02)));
+    BOOST_REQUIRE(!consumer.intact(out));
+    BOOST_REQUIRE(consumer.read(out, 1) == export_ring::status::ready);
+    BOOST_REQUIRE_EQUAL(out.payload.to_chunk(), data_chunk(6, 0x02));
+    BOOST_REQUIRE(consumer.intact(out));
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(fetcher_tests)
+
+using namespace system;
+using namespace network::messages;
+
+static const auto block_type = inventory_item::type_id::block;
+static const inventory_item item1{ block_type, { 0x01 } };
+static const inventory_item item2{ block_type, { 0x02 } };
+static const inventory_item item3{ block_type, { 0x03 } };
+
+BOOST_AUTO_TEST_CASE(fetcher__construct__default__empty)
+{
+    const fetcher instance{ 4, seconds(10) };
+    BOOST_REQUIRE(is_zero(instance.queued()));
+    BOOST_REQUIRE(is_zero(instance.in_flight()));
+    BOOST_REQUIRE_EQUAL(instance.window(42), 4u);
+    BOOST_REQUIRE(instance.round_trip(42) == steady_clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__construct__zero_window__one)
+{
+    const fetcher instance{ 0, seconds(10) };
+    BOOST_REQUIRE_EQUAL(instance.window(42), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__enqueue__duplicates__ignored)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1, item2, item1 });
+    BOOST_REQUIRE_EQUAL(instance.queued(), 2u);
+
+    instance.enqueue({ item2 });
+    BOOST_REQUIRE_EQUAL(instance.queued(), 2u);
+
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 2u);
+    instance.enqueue({ item1, item2 });
+    BOOST_REQUIRE(is_zero(instance.queued()));
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__request__window__limited)
+{
+    fetcher instance{ 2, seconds(10) };
+    instance.enqueue({ item1, item2, item3 });
+
+    const auto items = instance.request(42);
+    BOOST_REQUIRE_EQUAL(items.size(), 2u);
+    BOOST_REQUIRE(items[0] == item1);
+    BOOST_REQUIRE(items[1] == item2);
+    BOOST_REQUIRE(instance.request(42).empty());
+    BOOST_REQUIRE_EQUAL(instance.request(7).size(), 1u);
+    BOOST_REQUIRE(is_zero(instance.queued()));
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__received__in_flight__true_refills)
+{
+    fetcher instance{ 1, seconds(10) };
+    instance.enqueue({ item1, item2 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+    BOOST_REQUIRE(instance.request(42).empty());
+
+    BOOST_REQUIRE(instance.received(42, item1.hash));
+    BOOST_REQUIRE(instance.round_trip(42) > steady_clock::duration::zero());
+    BOOST_REQUIRE(is_zero(instance.in_flight()));
+
+    const auto items = instance.request(42);
+    BOOST_REQUIRE_EQUAL(items.size(), 1u);
+    BOOST_REQUIRE(items.front() == item2);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__received__other_channel__false)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+    BOOST_REQUIRE(!instance.received(7, item1.hash));
+    BOOST_REQUIRE(!instance.received(42, item2.hash));
+    BOOST_REQUIRE(instance.received(42, item1.hash));
+    BOOST_REQUIRE(!instance.received(42, item1.hash));
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__not_found__requeued__excludes_channel)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.request(7).size(), 0u);
+    BOOST_REQUIRE(instance.not_found(42, item1.hash));
+    BOOST_REQUIRE_EQUAL(instance.queued(), 1u);
+
+    BOOST_REQUIRE(instance.request(42).empty());
+    const auto items = instance.request(7);
+    BOOST_REQUIRE_EQUAL(items.size(), 1u);
+    BOOST_REQUIRE(items.front() == item1);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__not_found__all_channels_failed__exclusions_cleared)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+    BOOST_REQUIRE(instance.not_found(42, item1.hash));
+
+    // The only known channel has failed, so it is retried.
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__not_found__not_in_flight__false)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1 });
+    BOOST_REQUIRE(!instance.not_found(42, item1.hash));
+    BOOST_REQUIRE_EQUAL(instance.queued(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__expire__zero_stall__requeued_first)
+{
+    fetcher instance{ 1, seconds(0) };
+    instance.enqueue({ item1, item2 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.expire(42), 1u);
+    BOOST_REQUIRE(is_zero(instance.in_flight()));
+    BOOST_REQUIRE_EQUAL(instance.queued(), 2u);
+
+    const auto items = instance.request(7);
+    BOOST_REQUIRE_EQUAL(items.size(), 1u);
+    BOOST_REQUIRE(items.front() == item1);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__expire__not_stalled__zero)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 1u);
+    BOOST_REQUIRE(is_zero(instance.expire(42)));
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(fetcher__release__in_flight__requeued_unexcluded)
+{
+    fetcher instance{ 4, seconds(10) };
+    instance.enqueue({ item1, item2 });
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 2u);
+    instance.release(42);
+    BOOST_REQUIRE(is_zero(instance.in_flight()));
+    BOOST_REQUIRE_EQUAL(instance.queued(), 2u);
+
+    // Released items do not exclude the channel.
+    BOOST_REQUIRE_EQUAL(instance.request(42).size(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
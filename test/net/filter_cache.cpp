@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(filter_cache_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(filter_cache__find__empty__false)
+{
+    filter_cache instance(10);
+    filter_cache::header out{};
+    BOOST_REQUIRE(!instance.find(out, 0, null_hash));
+    BOOST_REQUIRE(!instance.find(0, null_hash));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.checkpoints(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(filter_cache__store__header__found_by_type_and_block)
+{
+    filter_cache instance(10);
+    const filter_cache::header value{ one_hash, null_hash };
+    instance.store(0, one_hash, value);
+
+    filter_cache::header out{};
+    BOOST_REQUIRE(instance.find(out, 0, one_hash));
+    BOOST_REQUIRE_EQUAL(out.filter_hash, one_hash);
+    BOOST_REQUIRE_EQUAL(out.filter_header, null_hash);
+    BOOST_REQUIRE(!instance.find(out, 1, one_hash));
+    BOOST_REQUIRE(!instance.find(out, 0, null_hash));
+}
+
+BOOST_AUTO_TEST_CASE(filter_cache__store__full__evicts_least_recent)
+{
+    filter_cache instance(2);
+    const filter_cache::header value{};
+    instance.store(0, hash_digest{ 1 }, value);
+    instance.store(0, hash_digest{ 2 }, value);
+
+    // Touch the first, so that the second is least recent.
+    filter_cache::header out{};
+    BOOST_REQUIRE(instance.find(out, 0, hash_digest{ 1 }));
+    instance.store(0, hash_digest{ 3 }, value);
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE(instance.find(out, 0, hash_digest{ 1 }));
+    BOOST_REQUIRE(!instance.find(out, 0, hash_digest{ 2 }));
+    BOOST_REQUIRE(instance.find(out, 0, hash_digest{ 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(filter_cache__store__zero_capacity__not_cached)
+{
+    filter_cache instance(0);
+    instance.store(0, one_hash, {});
+    instance.store(std::make_shared<const client_filter_checkpoint>(
+        client_filter_checkpoint{ 0, one_hash, {} }));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.checkpoints(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(filter_cache__store__checkpoint__found_by_type_and_stop)
+{
+    filter_cache instance(10);
+    const auto checkpoint = std::make_shared<const client_filter_checkpoint>(
+        client_filter_checkpoint{ 0, one_hash, { null_hash } });
+
+    instance.store(checkpoint);
+    BOOST_REQUIRE_EQUAL(instance.checkpoints(), 1u);
+    BOOST_REQUIRE(instance.find(0, one_hash) == checkpoint);
+    BOOST_REQUIRE(!instance.find(1, one_hash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(filter_matcher_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+// Testnet genesis block and its coinbase output script (bip158 vector).
+static const auto genesis = base16_hash(
+    "000000000933ea01ad0ee984209779baaec3ced90fa3f408719526f8d77f4943");
+static const auto genesis_script = base16_chunk(
+    "4104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb6"
+    "49f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac");
+static const auto genesis_filter = base16_chunk("019dfca8");
+
+BOOST_AUTO_TEST_CASE(filter_matcher__to_range__extremes__expected)
+{
+    BOOST_REQUIRE_EQUAL(filter_matcher::to_range(0, 10), 0u);
+    BOOST_REQUIRE_EQUAL(filter_matcher::to_range(max_uint64, 10), 9u);
+    BOOST_REQUIRE_EQUAL(filter_matcher::to_range(power2<uint64_t>(63u), 10),
+        5u);
+    BOOST_REQUIRE_EQUAL(filter_matcher::to_range(max_uint64, max_uint64),
+        sub1(max_uint64));
+}
+
+BOOST_AUTO_TEST_CASE(filter_matcher__match__bip158_genesis__true)
+{
+    const filter_matcher instance({ genesis_script });
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+    BOOST_REQUIRE(instance.match(genesis, genesis_filter));
+}
+
+BOOST_AUTO_TEST_CASE(filter_matcher__match__unwatched__false)
+{
+    const filter_matcher instance({ base16_chunk(
+        "0014000102030405060708090a0b0c0d0e0f10111213") });
+    BOOST_REQUIRE(!instance.match(genesis, genesis_filter));
+}
+
+BOOST_AUTO_TEST_CASE(filter_matcher__match__empty_watch_list__false)
+{
+    const filter_matcher instance({});
+    BOOST_REQUIRE(!instance.match(genesis, genesis_filter));
+}
+
+BOOST_AUTO_TEST_CASE(filter_matcher__match__empty_filter_set__false)
+{
+    const filter_matcher instance({ genesis_script });
+    BOOST_REQUIRE(!instance.match(genesis, base16_chunk("00")));
+}
+
+BOOST_AUTO_TEST_CASE(filter_matcher__match__truncated__true)
+{
+    const filter_matcher instance({ genesis_script });
+    BOOST_REQUIRE(instance.match(genesis, base16_chunk("019d")));
+    BOOST_REQUIRE(instance.match(genesis, data_chunk{}));
+}
+
+BOOST_AUTO_TEST_CASE(filter_matcher__match__filters__matching_indexes)
+{
+    const filter_matcher instance({ genesis_script });
+    const filter_matcher::filters filters
+    {
+        to_shared<client_filter>(client_filter{ filter_matcher::basic,
+            genesis, base16_chunk("00") }),
+        to_shared<client_filter>(client_filter{ filter_matcher::basic,
+            genesis, genesis_filter }),
+        to_shared<client_filter>(client_filter{ 42, genesis,
+            base16_chunk("00") })
+    };
+
+    const auto indexes = instance.match(filters);
+    BOOST_REQUIRE_EQUAL(indexes.size(), two);
+    BOOST_REQUIRE_EQUAL(indexes.front(), 1u);
+    BOOST_REQUIRE_EQUAL(indexes.back(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(handoff_tests)
+
+#if !defined(HAVE_MSC)
+
+BOOST_AUTO_TEST_CASE(handoff__take__empty_path__invalid_configuration)
+{
+    handoff::listeners out{};
+    BOOST_REQUIRE_EQUAL(handoff::take(out, {}, seconds(1)),
+        error::invalid_configuration);
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(handoff__take__not_offered__connect_failed)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    handoff::listeners out{};
+    BOOST_REQUIRE_EQUAL(handoff::take(out, TEST_DIRECTORY + "/none.sock",
+        seconds(1)), error::connect_failed);
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(handoff__offer__not_socket__invalid_configuration_retained)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const std::filesystem::path directory{ TEST_DIRECTORY + "/handoff" };
+    const std::filesystem::path path{ directory / "handoff.sock" };
+    BOOST_REQUIRE(std::filesystem::create_directory(directory));
+    std::filesystem::permissions(directory, std::filesystem::perms::owner_all,
+        std::filesystem::perm_options::replace);
+    std::ofstream{ path } << "retained";
+
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    const auto instance = std::make_shared<handoff>(strand);
+
+    std::promise<code> offered{};
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        offered.set_value(instance->offer(path, {}, [](const code&) NOEXCEPT
+        {
+        }));
+    });
+
+    BOOST_REQUIRE_EQUAL(offered.get_future().get(),
+        error::invalid_configuration);
+    BOOST_REQUIRE(std::filesystem::is_regular_file(path));
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(handoff__offer__shared_directory__invalid_configuration)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const std::filesystem::path directory{ TEST_DIRECTORY + "/handoff" };
+    BOOST_REQUIRE(std::filesystem::create_directory(directory));
+    std::filesystem::permissions(directory, std::filesystem::perms::owner_all |
+        std::filesystem::perms::others_all,
+        std::filesystem::perm_options::replace);
+
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    const auto instance = std::make_shared<handoff>(strand);
+
+    std::promise<code> offered{};
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        offered.set_value(instance->offer(directory / "handoff.sock", {},
+            [](const code&) NOEXCEPT
+            {
+            }));
+    });
+
+    BOOST_REQUIRE_EQUAL(offered.get_future().get(),
+        error::invalid_configuration);
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(handoff__offer__take__listener_transferred)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const std::filesystem::path path{ TEST_DIRECTORY + "/handoff/handoff.sock" };
+
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    asio::acceptor listener(pool.service(),
+        asio::endpoint{ asio::ipv4::loopback(), 0 });
+    const auto port = listener.local_endpoint().port();
+    const auto instance = std::make_shared<handoff>(strand);
+
+    std::promise<code> offered{};
+    std::promise<code> taken{};
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        offered.set_value(instance->offer(path, { listener.native_handle() },
+            [&](const code& ec) NOEXCEPT
+            {
+                taken.set_value(ec);
+            }));
+    });
+
+    BOOST_REQUIRE_EQUAL(offered.get_future().get(), error::success);
+
+    handoff::listeners out{};
+    BOOST_REQUIRE_EQUAL(handoff::take(out, path, seconds(5)), error::success);
+    BOOST_REQUIRE_EQUAL(taken.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(out.size(), one);
+    BOOST_REQUIRE_EQUAL(out.front().local.port(), port);
+    BOOST_REQUIRE_NE(out.front().handle, listener.native_handle());
+    handoff::release(out);
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
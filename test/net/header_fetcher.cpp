@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(header_fetcher_tests)
+
+using namespace system;
+
+class accumulator
+  : public header_fetcher::sink
+{
+public:
+    void accept(size_t height,
+        const chain::header_cptrs& headers) NOEXCEPT override
+    {
+        heights.push_back(height);
+        count += headers.size();
+    }
+
+    std::vector<size_t> heights{};
+    size_t count{};
+};
+
+// Headers extending the previous hash, with their hashes.
+static chain::header_cptrs chain_of(const hash_digest& previous, size_t count,
+    hashes& out) NOEXCEPT
+{
+    chain::header_cptrs headers{};
+    auto parent = previous;
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto header = std::make_shared<const chain::header>(1u, parent,
+            null_hash, possible_narrow_cast<uint32_t>(index), 0u, 0u);
+        parent = header->hash();
+        out.push_back(parent);
+        headers.push_back(header);
+    }
+
+    return headers;
+}
+
+static const hash_digest genesis{ 0x42 };
+
+BOOST_AUTO_TEST_CASE(header_fetcher__request__ranges__disjoint_then_none)
+{
+    accumulator sink{};
+    hashes ignore{};
+    chain_of(genesis, 3, ignore);
+    header_fetcher instance{ { { genesis, 0 }, { ignore.back(), 3 } }, sink };
+    BOOST_REQUIRE_EQUAL(instance.remaining(), 2u);
+
+    header_fetcher::range one{};
+    header_fetcher::range two{};
+    header_fetcher::range three{};
+    BOOST_REQUIRE(instance.request(1, one));
+    BOOST_REQUIRE(instance.request(2, two));
+    BOOST_REQUIRE(!instance.request(3, three));
+    BOOST_REQUIRE(one.start == genesis);
+    BOOST_REQUIRE(one.stop == ignore.back());
+    BOOST_REQUIRE(two.start == ignore.back());
+    BOOST_REQUIRE(two.stop == null_hash);
+
+    // A channel continues its own range.
+    BOOST_REQUIRE(instance.request(1, three));
+    BOOST_REQUIRE(three.start == genesis);
+}
+
+BOOST_AUTO_TEST_CASE(header_fetcher__received__out_of_order__stitched_in_order)
+{
+    accumulator sink{};
+    hashes lower{};
+    hashes upper{};
+    const auto first = chain_of(genesis, 3, lower);
+    const auto second = chain_of(lower.back(), 2, upper);
+    header_fetcher instance{ { { genesis, 0 }, { lower.back(), 3 } }, sink };
+
+    header_fetcher::range range{};
+    BOOST_REQUIRE(instance.request(1, range));
+    BOOST_REQUIRE(instance.request(2, range));
+
+    // The open range completes upon a partial message, retained until the
+    // lower range is contiguous.
+    BOOST_REQUIRE_EQUAL(instance.received(2, second, upper), error::success);
+    BOOST_REQUIRE(sink.heights.empty());
+    BOOST_REQUIRE_EQUAL(instance.remaining(), 1u);
+
+    BOOST_REQUIRE_EQUAL(instance.received(1, first, lower), error::success);
+    BOOST_REQUIRE_EQUAL(sink.count, 5u);
+    BOOST_REQUIRE_EQUAL(sink.heights.size(), 2u);
+    BOOST_REQUIRE_EQUAL(sink.heights.front(), 1u);
+    BOOST_REQUIRE_EQUAL(sink.heights.back(), 4u);
+    BOOST_REQUIRE(instance.complete());
+}
+
+BOOST_AUTO_TEST_CASE(header_fetcher__received__discontinuous__protocol_violation_released)
+{
+    accumulator sink{};
+    hashes ignore{};
+    hashes other{};
+    chain_of(genesis, 3, ignore);
+    const auto wrong = chain_of(hash_digest{ 0x24 }, 3, other);
+    header_fetcher instance{ { { genesis, 0 }, { ignore.back(), 3 } }, sink };
+
+    header_fetcher::range range{};
+    BOOST_REQUIRE(instance.request(1, range));
+    BOOST_REQUIRE_EQUAL(instance.received(1, wrong, other),
+        error::protocol_violation);
+
+    // The range is available to another channel, unchanged.
+    BOOST_REQUIRE(instance.request(2, range));
+    BOOST_REQUIRE(range.start == genesis);
+}
+
+BOOST_AUTO_TEST_CASE(header_fetcher__received__beyond_checkpoint__protocol_violation)
+{
+    accumulator sink{};
+    hashes four{};
+    const auto headers = chain_of(genesis, 4, four);
+    header_fetcher instance{ { { genesis, 0 }, { four.at(2), 3 } }, sink };
+
+    header_fetcher::range range{};
+    BOOST_REQUIRE(instance.request(1, range));
+    BOOST_REQUIRE_EQUAL(instance.received(1, headers, four),
+        error::protocol_violation);
+    BOOST_REQUIRE(sink.heights.empty());
+}
+
+BOOST_AUTO_TEST_CASE(header_fetcher__release__partial__progress_retained)
+{
+    accumulator sink{};
+    hashes all{};
+    const auto headers = chain_of(genesis, 3, all);
+    header_fetcher instance{ { { genesis, 0 }, { all.back(), 3 } }, sink };
+
+    header_fetcher::range range{};
+    BOOST_REQUIRE(instance.request(1, range));
+    const chain::header_cptrs part{ headers.front() };
+    BOOST_REQUIRE_EQUAL(instance.received(1, part, { all.front() }),
+        error::success);
+    BOOST_REQUIRE_EQUAL(sink.count, 1u);
+
+    instance.release(1);
+    BOOST_REQUIRE(instance.request(2, range));
+    BOOST_REQUIRE(range.start == all.front());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -147,6 +147,83 @@ BOOST_AUTO_TEST_CASE(hosts__start__populated_file__expected)
     BOOST_REQUIRE(test::exists(TEST_NAME));
 }
 
+BOOST_AUTO_TEST_CASE(hosts__start__legacy_text_file__expected)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+
+    // Legacy file is a line-oriented textual serialization.
+    {
+        std::ofstream file{ TEST_NAME };
+        file << config::address{ host1 } << std::endl;
+        file << config::address{ host2 } << std::endl;
+        file << config::address{ host3 } << std::endl;
+    }
+
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(hosts__start__unsupported_file_version__file_load)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+
+    // Magic (little endian) with file version 42.
+    {
+        std::ofstream file{ TEST_NAME, std::ios::binary };
+        file << "bhos" << '\x2a' << '\0' << '\0' << '\0';
+    }
+
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::file_load);
+}
+
+BOOST_AUTO_TEST_CASE(hosts__take__loaded_excluded__address_not_found)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.enable_ipv6 = true;
+    hosts instance1(set, log);
+    BOOST_REQUIRE_EQUAL(instance1.start(), error::success);
+
+    const auto message = system::to_shared(address{ { host1 } });
+    std::promise<size_t> promise_count{};
+    instance1.save(message, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise_count.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise_count.get_future().get(), 1u);
+    instance1.stop();
+
+    // Loopback is an ipv6 address, loaded but excluded upon take.
+    set.enable_ipv6 = false;
+    hosts instance2(set, log);
+    BOOST_REQUIRE_EQUAL(instance2.start(), error::success);
+    BOOST_REQUIRE_EQUAL(instance2.count(), 1u);
+
+    std::promise<code> promise_take{};
+    instance2.take([&](const code& ec, const address_item_cptr&) NOEXCEPT
+    {
+        promise_take.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise_take.get_future().get(), error::address_not_found);
+    BOOST_REQUIRE_EQUAL(instance2.count(), 0u);
+
+    instance2.stop();
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+}
+
 // stop
 
 BOOST_AUTO_TEST_CASE(hosts__stop__disabled__success)
@@ -258,6 +335,207 @@ BOOST_AUTO_TEST_CASE(hosts__take__only__expected)
     BOOST_REQUIRE(!test::exists(TEST_NAME));
 }
 
+BOOST_AUTO_TEST_CASE(hosts__take__ipv4__expected)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    // IPv4-mapped hosts are held compactly and restored in full.
+    constexpr address_item ipv4
+    {
+        42, 9,
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 192, 168, 1, 200 },
+        8333
+    };
+
+    std::promise<code> promise_restore{};
+    instance.restore(system::to_shared(ipv4), [&](const code& ec) NOEXCEPT
+    {
+        promise_restore.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise_restore.get_future().get(), error::success);
+
+    std::promise<address_item_cptr> promise_take{};
+    instance.take([&](const code&, const address_item_cptr& item) NOEXCEPT
+    {
+        promise_take.set_value(item);
+    });
+
+    const auto item = promise_take.get_future().get();
+    BOOST_REQUIRE(item);
+    BOOST_REQUIRE(item->ip == ipv4.ip);
+    BOOST_REQUIRE_EQUAL(item->port, ipv4.port);
+    BOOST_REQUIRE_EQUAL(item->timestamp, ipv4.timestamp);
+    BOOST_REQUIRE_EQUAL(item->services, ipv4.services);
+    instance.stop();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__take__services_unadvertised__address_not_found)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.services_minimum = 0;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise_restore{};
+    instance.restore(system::to_shared(host1), [&](const code& ec) NOEXCEPT
+    {
+        promise_restore.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise_restore.get_future().get(), error::success);
+
+    std::promise<code> promise_take{};
+    instance.take(8, [&](const code& ec, const address_item_cptr&) NOEXCEPT
+    {
+        promise_take.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise_take.get_future().get(),
+        error::address_not_found);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    instance.stop();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__take__services_advertised__expected)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.services_minimum = 0;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    // Only the last of the new hosts and the slower tried host are serviced.
+    constexpr address_item new1{ 0, 8, loopback_ip_address, 4 };
+    constexpr address_item tried1{ 0, 9, loopback_ip_address, 5 };
+    for (const auto& host: { host1, host2, new1 })
+    {
+        std::promise<code> promise{};
+        instance.restore(system::to_shared(host), [&](const code& ec) NOEXCEPT
+        {
+            promise.set_value(ec);
+        });
+        BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    }
+
+    for (const auto& host: { host3, tried1 })
+    {
+        std::promise<code> promise{};
+        instance.restore(system::to_shared(host), error::success,
+            seconds(host.port), [&](const code& ec) NOEXCEPT
+            {
+                promise.set_value(ec);
+            });
+        BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.count(), 5u);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 2u);
+
+    // Tables alternate, so both serviced hosts are taken in either order.
+    std::vector<address_item> taken{};
+    for (auto count = 0; count < 2; ++count)
+    {
+        std::promise<address_item_cptr> promise{};
+        instance.take(8, [&](const code&, const address_item_cptr& item)
+            NOEXCEPT
+            {
+                promise.set_value(item);
+            });
+
+        const auto item = promise.get_future().get();
+        BOOST_REQUIRE(item);
+        BOOST_REQUIRE_EQUAL(item->services & 8u, 8u);
+        taken.push_back(*item);
+    }
+
+    BOOST_REQUIRE(!(taken.front() == taken.back()));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 1u);
+
+    std::promise<code> promise_take{};
+    instance.take(8, [&](const code& ec, const address_item_cptr&) NOEXCEPT
+    {
+        promise_take.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise_take.get_future().get(),
+        error::address_not_found);
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+    instance.stop();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__take_new__tried_only__address_not_found)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise_restore{};
+    instance.restore(system::to_shared(host1), error::success, seconds(1),
+        [&](const code& ec) NOEXCEPT
+        {
+            promise_restore.set_value(ec);
+        });
+
+    BOOST_REQUIRE_EQUAL(promise_restore.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 1u);
+
+    std::promise<code> promise_take{};
+    instance.take_new([&](const code& ec, const address_item_cptr&) NOEXCEPT
+    {
+        promise_take.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise_take.get_future().get(),
+        error::address_not_found);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    instance.stop();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__take_new__new__expected)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise_restore{};
+    instance.restore(system::to_shared(loopback42), [&](const code& ec) NOEXCEPT
+    {
+        promise_restore.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise_restore.get_future().get(), error::success);
+
+    std::promise<std::pair<code, address_item_cptr>> promise_take{};
+    instance.take_new([&](const code& ec, const address_item_cptr& item) NOEXCEPT
+    {
+        promise_take.set_value({ ec, item });
+    });
+
+    instance.stop();
+    const auto result = promise_take.get_future().get();
+    BOOST_REQUIRE_EQUAL(result.first, error::success);
+    BOOST_REQUIRE(*result.second == loopback42);
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+}
+
 // restore
 
 BOOST_AUTO_TEST_CASE(hosts__restore__disabled_stopped__service_stopped_empty)
@@ -351,6 +629,168 @@ BOOST_AUTO_TEST_CASE(hosts__restore__duplicate_authority__updated)
     BOOST_REQUIRE(test::exists(TEST_NAME));
 }
 
+BOOST_AUTO_TEST_CASE(hosts__restore__connected__tried)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise1{};
+    instance.restore(system::to_shared(host1), error::success, seconds(1),
+        [&](const code& ec) NOEXCEPT
+        {
+            promise1.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise1.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 1u);
+
+    // Tried host is pooled, so is not also saved as new.
+    const auto message = system::to_shared(address{ { host1, host2 } });
+    std::promise<size_t> promise2{};
+    instance.save(message, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise2.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise2.get_future().get(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 1u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(hosts__restore__failed__new)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise{};
+    instance.restore(system::to_shared(host1), error::operation_timeout,
+        seconds(1), [&](const code& ec) NOEXCEPT
+        {
+            promise.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 0u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(hosts__take__tried_only__lowest_latency)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    // Same network group, so selection is by latency.
+    std::promise<code> promise1{};
+    instance.restore(system::to_shared(host1), error::success, seconds(2),
+        [&](const code& ec) NOEXCEPT
+        {
+            promise1.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise1.get_future().get(), error::success);
+
+    std::promise<code> promise2{};
+    instance.restore(system::to_shared(host2), error::success, seconds(1),
+        [&](const code& ec) NOEXCEPT
+        {
+            promise2.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise2.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 2u);
+
+    std::promise<address_item_cptr> promise3{};
+    instance.take([&](const code&, const address_item_cptr& item) NOEXCEPT
+    {
+        promise3.set_value(item);
+    });
+    BOOST_REQUIRE(*promise3.get_future().get() == host2);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.tried(), 1u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(hosts__restore__failure_limit__dropped)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.host_failure_limit = 2;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise1{};
+    instance.restore(system::to_shared(host1), error::operation_timeout,
+        seconds(1), [&](const code& ec) NOEXCEPT
+        {
+            promise1.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise1.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    std::promise<address_item_cptr> promise2{};
+    instance.take([&](const code&, const address_item_cptr& item) NOEXCEPT
+    {
+        promise2.set_value(item);
+    });
+    BOOST_REQUIRE(*promise2.get_future().get() == host1);
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+
+    std::promise<code> promise3{};
+    instance.restore(system::to_shared(host1), error::operation_timeout,
+        seconds(1), [&](const code& ec) NOEXCEPT
+        {
+            promise3.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise3.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+
+    instance.stop();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__reload__failure_limit__dropped)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.host_failure_limit = 0;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    auto snapshot = set;
+    snapshot.host_failure_limit = 1;
+    instance.reload(std::make_shared<mock_settings>(snapshot));
+
+    std::promise<code> promise{};
+    instance.restore(system::to_shared(host1), error::operation_timeout,
+        seconds(1), [&](const code& ec) NOEXCEPT
+        {
+            promise.set_value(ec);
+        });
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+
+    instance.stop();
+}
+
 // fetch
 
 BOOST_AUTO_TEST_CASE(hosts__fetch__empty__address_not_found)
@@ -364,7 +804,8 @@ BOOST_AUTO_TEST_CASE(hosts__fetch__empty__address_not_found)
     BOOST_REQUIRE_EQUAL(instance.count(), 0u);
 
     std::promise<std::pair<code, address::cptr>> promise_fetch{};
-    instance.fetch([&](const code& ec, const address::cptr& message) NOEXCEPT
+    instance.fetch([&](const code& ec, const address::cptr& message,
+        const wire_cache::ptr&) NOEXCEPT
     {
         promise_fetch.set_value({ ec, message });
     });
@@ -396,7 +837,8 @@ BOOST_AUTO_TEST_CASE(hosts__fetch__three__success_empty)
     BOOST_REQUIRE_EQUAL(promise_save.get_future().get(), 3u);
 
     std::promise<std::pair<code, address::cptr>> promise_fetch{};
-    instance.fetch([&](const code& ec, const address::cptr& message) NOEXCEPT
+    instance.fetch([&](const code& ec, const address::cptr& message,
+        const wire_cache::ptr&) NOEXCEPT
     {
         promise_fetch.set_value({ ec, message });
     });
@@ -409,6 +851,82 @@ BOOST_AUTO_TEST_CASE(hosts__fetch__three__success_empty)
     BOOST_REQUIRE(test::exists(TEST_NAME));
 }
 
+BOOST_AUTO_TEST_CASE(hosts__fetch__twice__shared_message_and_cache)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.address_snapshots = 1;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    const auto message = system::to_shared(address{ { host1, host2, host3 } });
+    std::promise<size_t> promise_save{};
+    instance.save(message, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise_save.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise_save.get_future().get(), 3u);
+
+    address::cptr first{};
+    wire_cache::ptr first_cache{};
+    instance.fetch([&](const code& ec, const address::cptr& message,
+        const wire_cache::ptr& cache) NOEXCEPT
+    {
+        BOOST_REQUIRE_EQUAL(ec, error::success);
+        first = message;
+        first_cache = cache;
+    });
+
+    instance.fetch([&](const code& ec, const address::cptr& message,
+        const wire_cache::ptr& cache) NOEXCEPT
+    {
+        BOOST_REQUIRE_EQUAL(ec, error::success);
+        BOOST_REQUIRE(message == first);
+        BOOST_REQUIRE(cache == first_cache);
+    });
+
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE(first_cache);
+    instance.stop();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__fetch__rotation__round_robin)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.address_snapshots = 2;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    const auto message = system::to_shared(address{ { host1, host2, host3 } });
+    std::promise<size_t> promise_save{};
+    instance.save(message, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise_save.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise_save.get_future().get(), 3u);
+
+    std::vector<address::cptr> fetched{};
+    const auto handler = [&](const code& ec, const address::cptr& message,
+        const wire_cache::ptr&) NOEXCEPT
+    {
+        BOOST_REQUIRE_EQUAL(ec, error::success);
+        fetched.push_back(message);
+    };
+
+    instance.fetch(handler);
+    instance.fetch(handler);
+    instance.fetch(handler);
+    BOOST_REQUIRE_EQUAL(fetched.size(), 3u);
+    BOOST_REQUIRE(fetched.at(0) != fetched.at(1));
+    BOOST_REQUIRE(fetched.at(0) == fetched.at(2));
+    instance.stop();
+}
+
 // store
 
 BOOST_AUTO_TEST_CASE(hosts__save__three_unique__three)
@@ -457,4 +975,239 @@ BOOST_AUTO_TEST_CASE(hosts__save__redundant__expected)
     BOOST_REQUIRE(test::exists(TEST_NAME));
 }
 
+BOOST_AUTO_TEST_CASE(hosts__save__evicted__reaccepted)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 2;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    // host1 is evicted by host3.
+    const auto message1 = system::to_shared(address{ { host1, host2, host3 } });
+    std::promise<size_t> promise1{};
+    instance.save(message1, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise1.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise1.get_future().get(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+
+    // host1 is no longer pooled, host3 remains pooled (host2 is evicted).
+    const auto message2 = system::to_shared(address{ { host1, host3 } });
+    std::promise<size_t> promise2{};
+    instance.save(message2, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise2.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise2.get_future().get(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+
+    std::promise<address_item_cptr> promise3{};
+    instance.take([&](const code&, const address_item_cptr& item) NOEXCEPT
+    {
+        promise3.set_value(item);
+    });
+    BOOST_REQUIRE(*promise3.get_future().get() == host3);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(hosts__ingest__redundant__accepted_new)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    const auto first = system::to_shared(address{ { host1 } });
+    instance.save(first, [](code, size_t) NOEXCEPT {});
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    const auto message = system::to_shared(address{ { host1, host2, host3, host2 } });
+    std::promise<address_cptr> promise_accepted{};
+    instance.ingest(message, [&](code, const address_cptr& accepted) NOEXCEPT
+    {
+        promise_accepted.set_value(accepted);
+    });
+
+    const auto accepted = promise_accepted.get_future().get();
+    BOOST_REQUIRE_EQUAL(accepted->addresses.size(), 2u);
+    BOOST_REQUIRE(accepted->addresses.front() == host2);
+    BOOST_REQUIRE(accepted->addresses.back() == host3);
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(hosts__restore__taken__accepted)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    std::promise<code> promise1{};
+    instance.restore(system::to_shared(host1), [&](const code& ec) NOEXCEPT
+    {
+        promise1.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise1.get_future().get(), error::success);
+
+    std::promise<address_item_cptr> promise2{};
+    instance.take([&](const code&, const address_item_cptr& item) NOEXCEPT
+    {
+        promise2.set_value(item);
+    });
+    BOOST_REQUIRE(*promise2.get_future().get() == host1);
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+
+    // Taken host is no longer indexed, so restore repools it.
+    std::promise<code> promise3{};
+    instance.restore(system::to_shared(host1), [&](const code& ec) NOEXCEPT
+    {
+        promise3.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise3.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    instance.stop();
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+// checkpoint
+
+BOOST_AUTO_TEST_CASE(hosts__checkpoint__stopped__service_stopped)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.host_checkpoint_minutes = 1;
+    hosts instance(set, log);
+
+    std::promise<code> promise{};
+    instance.checkpoint([&](const code& ec) NOEXCEPT
+    {
+        promise.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::service_stopped);
+}
+
+BOOST_AUTO_TEST_CASE(hosts__checkpoint__unsaved__replayed)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    set.host_checkpoint_minutes = 1;
+    hosts instance1(set, log);
+    BOOST_REQUIRE_EQUAL(instance1.start(), error::success);
+
+    // Changes are appended to the journal, the file is not written.
+    const auto message1 = system::to_shared(address{ { host1, host2 } });
+    std::promise<size_t> promise1{};
+    instance1.save(message1, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise1.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise1.get_future().get(), 2u);
+
+    std::promise<code> promise2{};
+    instance1.checkpoint([&](const code& ec) NOEXCEPT
+    {
+        promise2.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise2.get_future().get(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+
+    // Subsequent change is appended to the journal.
+    const auto message2 = system::to_shared(address{ { host3 } });
+    std::promise<size_t> promise3{};
+    instance1.save(message2, [&](code, size_t accepted) NOEXCEPT
+    {
+        promise3.set_value(accepted);
+    });
+    BOOST_REQUIRE_EQUAL(promise3.get_future().get(), 1u);
+
+    std::promise<code> promise4{};
+    instance1.checkpoint([&](const code& ec) NOEXCEPT
+    {
+        promise4.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise4.get_future().get(), error::success);
+
+    // Start without stop of first instance (as if crashed).
+    hosts instance2(set, log);
+    BOOST_REQUIRE_EQUAL(instance2.start(), error::success);
+    BOOST_REQUIRE_EQUAL(instance2.count(), 3u);
+
+    BOOST_REQUIRE_EQUAL(instance2.stop(), error::success);
+    BOOST_REQUIRE_EQUAL(instance1.stop(), error::success);
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+}
+
+// sweep
+
+BOOST_AUTO_TEST_CASE(hosts__sweep__stopped__service_stopped)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+
+    std::promise<code> promise{};
+    instance.sweep([&](const code& ec, size_t) NOEXCEPT
+    {
+        promise.set_value(ec);
+    });
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::service_stopped);
+}
+
+BOOST_AUTO_TEST_CASE(hosts__sweep__expired__dropped)
+{
+    const logger log{};
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.host_pool_capacity = 42;
+    hosts instance(set, log);
+    BOOST_REQUIRE_EQUAL(instance.start(), error::success);
+
+    // Untimestamped hosts do not expire.
+    const address_item fresh{ unix_time(), 0, loopback_ip_address, 4 };
+    constexpr address_item expired{ 1, 0, loopback_ip_address, 5 };
+    for (const auto& host: { host1, expired, fresh })
+    {
+        std::promise<code> promise{};
+        instance.restore(system::to_shared(host), [&](const code& ec) NOEXCEPT
+        {
+            promise.set_value(ec);
+        });
+        BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    std::promise<std::pair<code, size_t>> promise{};
+    instance.sweep([&](const code& ec, size_t swept) NOEXCEPT
+    {
+        promise.set_value({ ec, swept });
+    });
+
+    const auto result = promise.get_future().get();
+    BOOST_REQUIRE_EQUAL(result.first, error::success);
+    BOOST_REQUIRE_EQUAL(result.second, 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    instance.stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(lz4_tests)
+
+static data_chunk repeated(size_t size)
+{
+    data_chunk out(size);
+    for (size_t index = 0; index < size; ++index)
+        out[index] = static_cast<uint8_t>((index * 7u) % 13u);
+
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(lz4__compress__empty__literal_token)
+{
+    const auto block = lz4::compress({});
+    BOOST_REQUIRE_EQUAL(block, base16_chunk("00"));
+
+    data_chunk out{};
+    BOOST_REQUIRE(lz4::decompress(out, block));
+}
+
+BOOST_AUTO_TEST_CASE(lz4__compress__short__literals_only)
+{
+    const auto data = base16_chunk("0102030405060708");
+    const auto block = lz4::compress(data);
+    BOOST_REQUIRE_EQUAL(block, base16_chunk("800102030405060708"));
+
+    data_chunk out(data.size());
+    BOOST_REQUIRE(lz4::decompress(out, block));
+    BOOST_REQUIRE_EQUAL(out, data);
+}
+
+BOOST_AUTO_TEST_CASE(lz4__compress__repetitive__smaller_round_trip)
+{
+    const auto data = repeated(100'000);
+    const auto block = lz4::compress(data);
+    BOOST_REQUIRE_LT(block.size(), data.size() / 10u);
+
+    data_chunk out(data.size());
+    BOOST_REQUIRE(lz4::decompress(out, block));
+    BOOST_REQUIRE_EQUAL(out, data);
+}
+
+BOOST_AUTO_TEST_CASE(lz4__compress__dictionary__smaller_round_trip)
+{
+    const auto& dictionary = lz4::transaction_dictionary();
+    const auto data = base16_chunk(
+        "0200000000010100000000000000000000000000000000000000000000000000"
+        "000000000000000000ffffffff0100000000000000001600140000000000000000"
+        "000000000000000000000000");
+
+    const auto plain = lz4::compress(data);
+    const auto block = lz4::compress(data, dictionary);
+    BOOST_REQUIRE_LT(block.size(), plain.size());
+
+    data_chunk out(data.size());
+    BOOST_REQUIRE(lz4::decompress(out, block, dictionary));
+    BOOST_REQUIRE_EQUAL(out, data);
+}
+
+// Hand assembled block: literals "abcd" then a match of 8 at offset 4.
+BOOST_AUTO_TEST_CASE(lz4__decompress__overlapping_match__expected)
+{
+    const auto block = base16_chunk("44616263640400" "5078797a7778");
+    data_chunk out(17);
+    BOOST_REQUIRE(lz4::decompress(out, block));
+    BOOST_REQUIRE_EQUAL(out, to_chunk(std::string{ "abcdabcdabcdxyzwx" }));
+}
+
+BOOST_AUTO_TEST_CASE(lz4__decompress__wrong_size__false)
+{
+    const auto data = repeated(1'000);
+    const auto block = lz4::compress(data);
+
+    data_chunk smaller(sub1(data.size()));
+    data_chunk larger(add1(data.size()));
+    BOOST_REQUIRE(!lz4::decompress(smaller, block));
+    BOOST_REQUIRE(!lz4::decompress(larger, block));
+}
+
+BOOST_AUTO_TEST_CASE(lz4__decompress__invalid_offset__false)
+{
+    // Match offset (8) precedes the start of the output (4).
+    const auto block = base16_chunk("44616263640800" "5078797a7778");
+    data_chunk out(17);
+    BOOST_REQUIRE(!lz4::decompress(out, block));
+}
+
+BOOST_AUTO_TEST_CASE(lz4__decompress__truncated__false)
+{
+    const auto data = repeated(1'000);
+    auto block = lz4::compress(data);
+    block.resize(block.size() / 2u);
+
+    data_chunk out(data.size());
+    BOOST_REQUIRE(!lz4::decompress(out, block));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(memory_budget_tests)
+
+BOOST_AUTO_TEST_CASE(memory_budget__construct__limit__unused)
+{
+    const memory_budget instance{ 800 };
+    BOOST_REQUIRE_EQUAL(instance.limit(), 800u);
+    BOOST_REQUIRE_EQUAL(instance.used(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.channels(), 0u);
+    BOOST_REQUIRE(!instance.pressured());
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget__acquire_release__expected_used)
+{
+    memory_budget instance{ 800 };
+    instance.acquire(100);
+    instance.acquire(50);
+    BOOST_REQUIRE_EQUAL(instance.used(), 150u);
+    instance.release(100);
+    BOOST_REQUIRE_EQUAL(instance.used(), 50u);
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget__release__excess__floored)
+{
+    memory_budget instance{ 800 };
+    instance.acquire(10);
+    instance.release(100);
+    BOOST_REQUIRE_EQUAL(instance.used(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget__pressured__high_water__true)
+{
+    memory_budget instance{ 800 };
+    instance.acquire(699);
+    BOOST_REQUIRE(!instance.pressured());
+    instance.acquire(1);
+    BOOST_REQUIRE(instance.pressured());
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget__pressured__zero_limit__false)
+{
+    memory_budget instance{ 0 };
+    instance.acquire(1'000'000);
+    BOOST_REQUIRE(!instance.pressured());
+    BOOST_REQUIRE(!instance.heavy(1'000'000));
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget__heavy__above_fair_share__true)
+{
+    memory_budget instance{ 800 };
+    instance.attach();
+    instance.attach();
+    instance.acquire(800);
+    BOOST_REQUIRE_EQUAL(instance.channels(), 2u);
+    BOOST_REQUIRE(!instance.heavy(400));
+    BOOST_REQUIRE(instance.heavy(401));
+
+    instance.detach();
+    BOOST_REQUIRE_EQUAL(instance.channels(), 1u);
+    BOOST_REQUIRE(!instance.heavy(800));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
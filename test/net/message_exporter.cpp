@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(message_exporter_tests)
+
+#if !defined(HAVE_MSC)
+
+using namespace system;
+using namespace network::messages;
+
+const std::string name{ "/libbitcoin-network-test-message-exporter" };
+
+static bool settled(const message_exporter& instance, size_t count) NOEXCEPT
+{
+    for (auto tries = 0; tries < 1'000; ++tries)
+    {
+        if (instance.exported() + instance.duplicates() +
+            instance.dropped() >= count)
+            return true;
+
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(message_exporter__construct__empty_name__disabled)
+{
+    message_exporter instance({}, 1'000);
+    BOOST_REQUIRE(!instance.enabled());
+    instance.submit(identifier::ping, 1, 1, to_shared(data_chunk{ 42 }), {});
+    BOOST_REQUIRE_EQUAL(instance.exported(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(message_exporter__submit__duplicate__exported_once)
+{
+    message_exporter instance(name, 1'000);
+    BOOST_REQUIRE(instance.enabled());
+
+    const auto first = to_shared(data_chunk{ 0x01, 0x02 });
+    const auto second = to_shared(data_chunk{ 0x03 });
+    instance.submit(identifier::transaction, 1, 70016, first, {});
+    instance.submit(identifier::transaction, 2, 70016, first,
+        to_shared(bitcoin_hash(*first)));
+    instance.submit(identifier::transaction, 3, 70016, second, {});
+
+    BOOST_REQUIRE(settled(instance, 3));
+    BOOST_REQUIRE_EQUAL(instance.exported(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.duplicates(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.dropped(), 0u);
+
+    const export_ring consumer(name);
+    export_ring::record out{};
+    BOOST_REQUIRE_EQUAL(consumer.head(), 2u);
+    BOOST_REQUIRE(consumer.read(out, 0) == export_ring::status::ready);
+    BOOST_REQUIRE_EQUAL(out.channel, 1u);
+    BOOST_REQUIRE_EQUAL(out.payload.to_chunk(), *first);
+    BOOST_REQUIRE(consumer.read(out, 1) == export_ring::status::ready);
+    BOOST_REQUIRE_EQUAL(out.channel, 3u);
+    BOOST_REQUIRE_EQUAL(out.payload.to_chunk(), *second);
+}
+
+BOOST_AUTO_TEST_CASE(message_exporter__submit__over_capacity__dropped)
+{
+    message_exporter instance(name, 10);
+    instance.submit(identifier::block, 1, 1, to_shared(data_chunk(11)), {});
+    BOOST_REQUIRE(settled(instance, 1));
+    BOOST_REQUIRE_EQUAL(instance.dropped(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.exported(), 0u);
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(metrics_tests)
+
+using namespace system;
+using namespace network::messages;
+
+constexpr auto ping_index = static_cast<size_t>(identifier::ping);
+constexpr auto block_index = static_cast<size_t>(identifier::block);
+
+BOOST_AUTO_TEST_CASE(metrics__get__default__zeros)
+{
+    const metrics instance{};
+    const auto snapshot = instance.get();
+    BOOST_REQUIRE_EQUAL(snapshot.total_received().messages, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.total_received().bytes, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.total_sent().messages, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.total_sent().bytes, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.reads, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.writes, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.queue_depth, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.deserializations, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.deserialize_nanoseconds, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.processing_nanoseconds, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics__receive_send__by_identifier__expected)
+{
+    metrics instance{};
+    instance.receive(identifier::ping, 32);
+    instance.receive(identifier::ping, 32);
+    instance.receive(identifier::block, 1000);
+    instance.send(identifier::ping, 32);
+
+    const auto snapshot = instance.get();
+    BOOST_REQUIRE_EQUAL(snapshot.received[ping_index].messages, 2u);
+    BOOST_REQUIRE_EQUAL(snapshot.received[ping_index].bytes, 64u);
+    BOOST_REQUIRE_EQUAL(snapshot.received[block_index].messages, 1u);
+    BOOST_REQUIRE_EQUAL(snapshot.received[block_index].bytes, 1000u);
+    BOOST_REQUIRE_EQUAL(snapshot.sent[ping_index].messages, 1u);
+    BOOST_REQUIRE_EQUAL(snapshot.sent[block_index].messages, 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.total_received().messages, 3u);
+    BOOST_REQUIRE_EQUAL(snapshot.total_received().bytes, 1064u);
+    BOOST_REQUIRE_EQUAL(snapshot.total_sent().bytes, 32u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics__operations__recorded__expected)
+{
+    metrics instance{};
+    instance.read();
+    instance.read();
+    instance.write();
+    instance.queue(3);
+    instance.queue(7);
+    instance.queue(5);
+    instance.deserialize(nanoseconds{ 40 });
+    instance.deserialize(nanoseconds{ 2 });
+    instance.process(nanoseconds{ 20 });
+    instance.process(nanoseconds{ 22 });
+
+    const auto snapshot = instance.get();
+    BOOST_REQUIRE_EQUAL(snapshot.reads, 2u);
+    BOOST_REQUIRE_EQUAL(snapshot.writes, 1u);
+    BOOST_REQUIRE_EQUAL(snapshot.queue_depth, 7u);
+    BOOST_REQUIRE_EQUAL(snapshot.deserializations, 2u);
+    BOOST_REQUIRE_EQUAL(snapshot.deserialize_nanoseconds, 42u);
+    BOOST_REQUIRE_EQUAL(snapshot.processing_nanoseconds, 42u);
+    BOOST_REQUIRE_EQUAL(instance.processing(), 42u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
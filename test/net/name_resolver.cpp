@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(name_resolver_tests)
+
+using result = std::pair<error::boost_code, size_t>;
+
+static result resolve(name_resolver& resolver, asio::strand& strand,
+    const std::string& host) NOEXCEPT
+{
+    std::promise<result> promise{};
+    resolver.resolve(host, 42, strand,
+        [&](const error::boost_code& ec, const asio::endpoints& range) NOEXCEPT
+        {
+            BOOST_REQUIRE(strand.running_in_this_thread());
+            promise.set_value({ ec, range.size() });
+        });
+
+    return promise.get_future().get();
+}
+
+BOOST_AUTO_TEST_CASE(name_resolver__resolve__localhost__resolved_cached)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    name_resolver resolver(2, seconds(42), seconds(42));
+
+    const auto first = resolve(resolver, strand, "localhost");
+    BOOST_REQUIRE(!first.first);
+    BOOST_REQUIRE(!is_zero(first.second));
+    BOOST_REQUIRE_EQUAL(resolver.cached(), 1u);
+
+    const auto second = resolve(resolver, strand, "localhost");
+    BOOST_REQUIRE(!second.first);
+    BOOST_REQUIRE_EQUAL(second.second, first.second);
+    BOOST_REQUIRE_EQUAL(resolver.cached(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(name_resolver__resolve__zero_durations__not_cached)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    name_resolver resolver(1, seconds(0), seconds(0));
+
+    BOOST_REQUIRE(!resolve(resolver, strand, "localhost").first);
+    BOOST_REQUIRE_EQUAL(resolver.cached(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(name_resolver__resolve__bogus_hostname__failure_cached)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    name_resolver resolver(1, seconds(0), seconds(42));
+
+    BOOST_REQUIRE(resolve(resolver, strand, "bogus.xxx").first);
+    BOOST_REQUIRE_EQUAL(resolver.cached(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(name_resolver__cancel__zero_ticket__no_effect)
+{
+    name_resolver resolver(1, seconds(0), seconds(0));
+    resolver.cancel(0);
+    BOOST_REQUIRE_EQUAL(resolver.cached(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
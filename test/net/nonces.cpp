@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(nonces_tests)
+
+BOOST_AUTO_TEST_CASE(nonces__construct__capacity__power_of_two)
+{
+    BOOST_REQUIRE_EQUAL(nonces(0).capacity(), 2u);
+    BOOST_REQUIRE_EQUAL(nonces(3).capacity(), 4u);
+    BOOST_REQUIRE_EQUAL(nonces(64).capacity(), 64u);
+    BOOST_REQUIRE(is_zero(nonces(64).size()));
+}
+
+BOOST_AUTO_TEST_CASE(nonces__insert__reserved__false)
+{
+    nonces instance(8);
+    BOOST_REQUIRE(!instance.insert(0));
+    BOOST_REQUIRE(!instance.insert(max_uint64));
+    BOOST_REQUIRE(!instance.contains(0));
+    BOOST_REQUIRE(!instance.contains(max_uint64));
+    BOOST_REQUIRE(is_zero(instance.size()));
+}
+
+BOOST_AUTO_TEST_CASE(nonces__insert__duplicate__false)
+{
+    nonces instance(8);
+    BOOST_REQUIRE(instance.insert(42));
+    BOOST_REQUIRE(!instance.insert(42));
+    BOOST_REQUIRE(instance.contains(42));
+    BOOST_REQUIRE(!instance.contains(24));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(nonces__insert__full__false)
+{
+    nonces instance(4);
+    for (uint64_t nonce = 1; nonce <= 4u; ++nonce)
+        BOOST_REQUIRE(instance.insert(nonce));
+
+    BOOST_REQUIRE(!instance.insert(5));
+    for (uint64_t nonce = 1; nonce <= 4u; ++nonce)
+        BOOST_REQUIRE(instance.contains(nonce));
+}
+
+BOOST_AUTO_TEST_CASE(nonces__erase__contained__reused)
+{
+    nonces instance(4);
+    for (uint64_t nonce = 1; nonce <= 4u; ++nonce)
+        BOOST_REQUIRE(instance.insert(nonce));
+
+    BOOST_REQUIRE(instance.erase(2));
+    BOOST_REQUIRE(!instance.erase(2));
+    BOOST_REQUIRE(!instance.contains(2));
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+
+    BOOST_REQUIRE(instance.insert(5));
+    BOOST_REQUIRE(instance.contains(5));
+    BOOST_REQUIRE(instance.contains(1));
+    BOOST_REQUIRE(instance.contains(3));
+    BOOST_REQUIRE(instance.contains(4));
+}
+
+BOOST_AUTO_TEST_CASE(nonces__erase__churn__contains_remaining)
+{
+    nonces instance(16);
+    for (uint64_t nonce = 1; nonce <= 1000u; ++nonce)
+    {
+        BOOST_REQUIRE(instance.insert(nonce));
+        if (nonce > 8u)
+            BOOST_REQUIRE(instance.erase(nonce - 8u));
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 8u);
+    for (uint64_t nonce = 993; nonce <= 1000u; ++nonce)
+        BOOST_REQUIRE(instance.contains(nonce));
+
+    BOOST_REQUIRE(!instance.contains(992));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
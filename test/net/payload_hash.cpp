@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(payload_hash_tests)
+
+using namespace system;
+
+static data_chunk to_data(size_t size) NOEXCEPT
+{
+    data_chunk out(size);
+    for (size_t index = 0; index < size; ++index)
+        out[index] = static_cast<uint8_t>(index * 31 + 7);
+
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(payload_hash__flush__empty__bitcoin_hash)
+{
+    payload_hash instance{};
+    BOOST_REQUIRE_EQUAL(instance.flush(), bitcoin_hash(data_chunk{}));
+}
+
+BOOST_AUTO_TEST_CASE(payload_hash__write__chunks__bitcoin_hash)
+{
+    for (const auto size: { 1u, 55u, 56u, 64u, 65u, 119u, 1000u, 100'000u })
+    {
+        const auto data = to_data(size);
+        for (const auto chunk: { 1u, 7u, 64u, 1000u })
+        {
+            payload_hash instance{};
+            for (size_t offset = 0; offset < size; offset += chunk)
+                instance.write({ std::next(data.begin(), offset),
+                    std::next(data.begin(), std::min(size, offset + chunk)) });
+
+            BOOST_REQUIRE_EQUAL(instance.size(), size);
+            BOOST_REQUIRE_EQUAL(instance.flush(), bitcoin_hash(data));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(payload_hash__flush__twice__reset)
+{
+    const auto data = to_data(100);
+    payload_hash instance{};
+    instance.write(data);
+    BOOST_REQUIRE_EQUAL(instance.flush(), bitcoin_hash(data));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    instance.write(data);
+    BOOST_REQUIRE_EQUAL(instance.flush(), bitcoin_hash(data));
+}
+
+BOOST_AUTO_TEST_CASE(payload_hash__batch__mixed_sizes__bitcoin_hashes)
+{
+    std::vector<data_chunk> data{};
+    for (const auto size: { 0u, 1u, 55u, 56u, 64u, 65u, 119u, 1000u, 3u, 33u })
+        data.push_back(to_data(size));
+
+    std::vector<data_slice> payloads{};
+    for (const auto& payload: data)
+        payloads.emplace_back(payload);
+
+    const auto hashes = payload_hash::batch(payloads);
+    BOOST_REQUIRE_EQUAL(hashes.size(), data.size());
+    for (size_t index = 0; index < data.size(); ++index)
+        BOOST_REQUIRE_EQUAL(hashes[index], bitcoin_hash(data[index]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
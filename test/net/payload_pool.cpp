@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(payload_pool_tests)
+
+BOOST_AUTO_TEST_CASE(payload_pool__size_class__minimum__minimum_class)
+{
+    BOOST_REQUIRE_EQUAL(payload_pool::size_class(0), payload_pool::minimum_class);
+    BOOST_REQUIRE_EQUAL(payload_pool::size_class(1), payload_pool::minimum_class);
+    BOOST_REQUIRE_EQUAL(payload_pool::size_class(4096), payload_pool::minimum_class);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__size_class__above_minimum__ceilinged_log2)
+{
+    BOOST_REQUIRE_EQUAL(payload_pool::size_class(4097), 13u);
+    BOOST_REQUIRE_EQUAL(payload_pool::size_class(8192), 13u);
+    BOOST_REQUIRE_EQUAL(payload_pool::size_class(4'000'000), 22u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__lease__empty__expected_size)
+{
+    payload_pool instance(1, 4'000'000);
+    const auto buffer = instance.lease(42);
+    BOOST_REQUIRE(buffer);
+    BOOST_REQUIRE_EQUAL(buffer->size(), 42u);
+    BOOST_REQUIRE_GE(buffer->capacity(), 4096u);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__lease__unallocatable__nullptr)
+{
+    payload_pool instance(1, 4'000'000);
+    BOOST_REQUIRE(!instance.lease(max_size_t));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__release__leased__retained_and_reused)
+{
+    payload_pool instance(1, 4'000'000);
+    auto buffer = instance.lease(5000);
+    const auto address = buffer.get();
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+
+    const auto reused = instance.lease(8000);
+    BOOST_REQUIRE_EQUAL(reused.get(), address);
+    BOOST_REQUIRE_EQUAL(reused->size(), 8000u);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__lease__huge_pages__retained_and_reused)
+{
+    payload_pool instance(1, 4'000'000, true);
+    auto buffer = instance.lease(3'000'000);
+    BOOST_REQUIRE(buffer);
+    BOOST_REQUIRE_EQUAL(buffer->size(), 3'000'000u);
+    BOOST_REQUIRE_GE(buffer->capacity(), power2(22u));
+
+    const auto address = buffer.get();
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.lease(4'000'000).get(), address);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__release__class_full__not_retained)
+{
+    payload_pool instance(1, 4'000'000);
+    auto buffer1 = instance.lease(42);
+    auto buffer2 = instance.lease(42);
+    instance.release(std::move(buffer1));
+    instance.release(std::move(buffer2));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__release__referenced__not_retained)
+{
+    payload_pool instance(1, 4'000'000);
+    auto buffer = instance.lease(42);
+    const auto reference = buffer;
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__release__oversized__not_retained)
+{
+    payload_pool instance(1, 4096);
+    auto buffer = instance.lease(5000);
+    BOOST_REQUIRE_EQUAL(buffer->size(), 5000u);
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__release__zero_capacity__not_retained)
+{
+    payload_pool instance(0, 4'000'000);
+    auto buffer = instance.lease(42);
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payload_pool__release__null__not_retained)
+{
+    payload_pool instance(1, 4'000'000);
+    instance.release({});
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(pin_sketch_tests)
+
+using namespace bc::system;
+
+static pin_sketch::elements sorted(pin_sketch::elements values) NOEXCEPT
+{
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__serialized_size__capacity__four_bytes_each)
+{
+    BOOST_REQUIRE_EQUAL(pin_sketch::serialized_size(0), 0u);
+    BOOST_REQUIRE_EQUAL(pin_sketch::serialized_size(10), 40u);
+}
+
+// Known answers of the minisketch 32 bit field (x^32 + x^7 + x^3 + x^2 + 1)
+// and serialization (odd power sums, each 4 bytes little-endian).
+
+BOOST_AUTO_TEST_CASE(pin_sketch__serialize__one__all_ones)
+{
+    pin_sketch instance(3);
+    instance.add(1);
+    BOOST_REQUIRE_EQUAL(instance.serialize(), base16_chunk("010000000100000001000000"));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__serialize__x__odd_powers_reduced)
+{
+    // x^1 ... x^31 are unreduced, x^33 = x^8 + x^4 + x^3 + x.
+    pin_sketch instance(17);
+    instance.add(2);
+    BOOST_REQUIRE_EQUAL(instance.serialize(), base16_chunk(
+        "0200000008000000200000008000000000020000000800000020000000800000"
+        "0000020000000800000020000000800000000002000000080000002000000080"
+        "1a010000"));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__serialize__elements__expected)
+{
+    pin_sketch single(2);
+    single.add(0xdeadbeef);
+    BOOST_REQUIRE_EQUAL(single.serialize(), base16_chunk("efbeadde7505cb84"));
+
+    pin_sketch triple(4);
+    triple.add(1);
+    triple.add(2);
+    triple.add(3);
+    BOOST_REQUIRE_EQUAL(triple.serialize(), base16_chunk("0000000006000000120000007e000000"));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__decode__serialized__expected)
+{
+    const pin_sketch instance(base16_chunk("888888887ecb6f1a64514247"));
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 3u);
+
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(sorted(out) == sorted({ 0x12345678, 0x9abcdef0 }));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__merge__extension__doubled_capacity)
+{
+    // An extension is the higher power sums of the same set, so that the
+    // concatenated serialization is the sketch of doubled capacity.
+    pin_sketch initial(2);
+    pin_sketch doubled(4);
+    for (const auto value: { 11u, 22u, 33u, 44u })
+    {
+        initial.add(value);
+        doubled.add(value);
+    }
+
+    auto extended = initial.serialize();
+    const auto full = doubled.serialize();
+    extended.insert(extended.end(), std::next(full.begin(),
+        pin_sketch::serialized_size(2)), full.end());
+    BOOST_REQUIRE_EQUAL(extended, full);
+
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(!initial.decode(out));
+    BOOST_REQUIRE(pin_sketch(extended).decode(out));
+    BOOST_REQUIRE(sorted(out) == sorted({ 11, 22, 33, 44 }));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__decode__empty__true_empty)
+{
+    const pin_sketch instance(4);
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__decode__within_capacity__expected)
+{
+    const pin_sketch::elements expected{ 1, 2, 42, 0xdeadbeef, 0xffffffff };
+    pin_sketch instance(8);
+    for (const auto value: expected)
+        instance.add(value);
+
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(sorted(out) == sorted(expected));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__add__twice__removed)
+{
+    pin_sketch instance(4);
+    instance.add(7);
+    instance.add(9);
+    instance.add(7);
+
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(out == pin_sketch::elements{ 9 });
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__merge__sets__symmetric_difference)
+{
+    pin_sketch local(6);
+    pin_sketch remote(6);
+    for (uint32_t value = 100; value < 200; ++value)
+    {
+        local.add(value);
+        remote.add(value);
+    }
+
+    local.add(5);
+    local.add(6);
+    remote.add(0x12345678);
+
+    const pin_sketch copy(remote.serialize());
+    BOOST_REQUIRE_EQUAL(copy.capacity(), 6u);
+
+    local.merge(copy);
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(local.decode(out));
+    BOOST_REQUIRE(sorted(out) == sorted({ 5, 6, 0x12345678 }));
+}
+
+BOOST_AUTO_TEST_CASE(pin_sketch__decode__over_capacity__false)
+{
+    pin_sketch instance(4);
+    for (uint32_t value = 1; value <= 12; ++value)
+        instance.add(value * 0x9e3779b9);
+
+    pin_sketch::elements out{};
+    BOOST_REQUIRE(!instance.decode(out));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(pipe_tests)
+
+BOOST_AUTO_TEST_CASE(pipe__create__pair__inbound_outbound_not_stopped)
+{
+    const logger log{};
+    threadpool pool(1);
+    const auto pair = network::pipe::create(log, pool.service());
+    BOOST_REQUIRE(pair.first->inbound());
+    BOOST_REQUIRE(!pair.second->inbound());
+    BOOST_REQUIRE(!pair.first->stopped());
+    BOOST_REQUIRE(!pair.second->stopped());
+
+    pair.first->stop();
+    pair.second->stop();
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(pipe__write_read__split_writes__expected)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto pair = network::pipe::create(log, pool.service());
+
+    const data_chunk first{ 0x01, 0x02, 0x03 };
+    const data_chunk second{ 0x04, 0x05 };
+    data_chunk out(5, 0x00);
+
+    std::promise<code> read{};
+    pair.first->read(out, [&](const code& ec, size_t size)
+    {
+        BOOST_REQUIRE_EQUAL(size, 5u);
+        read.set_value(ec);
+    });
+
+    std::promise<code> wrote{};
+    pair.second->write(first, [&](const code& ec, size_t size)
+    {
+        BOOST_REQUIRE(!ec);
+        BOOST_REQUIRE_EQUAL(size, 3u);
+        pair.second->write(second, [&](const code& next, size_t)
+        {
+            wrote.set_value(next);
+        });
+    });
+
+    BOOST_REQUIRE_EQUAL(wrote.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(read.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(out, (data_chunk{ 0x01, 0x02, 0x03, 0x04, 0x05 }));
+
+    pair.first->stop();
+    pair.second->stop();
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(pipe__write_buffers__gathered__expected)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto pair = network::pipe::create(log, pool.service());
+
+    const data_chunk first{ 0x0a, 0x0b };
+    const data_chunk second{ 0x0c };
+    const asio::const_buffers buffers
+    {
+        { first.data(), first.size() },
+        { second.data(), second.size() }
+    };
+
+    std::promise<code> wrote{};
+    pair.first->write(buffers, [&](const code& ec, size_t size)
+    {
+        BOOST_REQUIRE_EQUAL(size, 3u);
+        wrote.set_value(ec);
+    });
+
+    data_chunk out(3, 0x00);
+    std::promise<code> read{};
+    pair.second->read(out, [&](const code& ec, size_t)
+    {
+        read.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(wrote.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(read.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(out, (data_chunk{ 0x0a, 0x0b, 0x0c }));
+
+    pair.first->stop();
+    pair.second->stop();
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(pipe__read__peer_stopped__peer_disconnect)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto pair = network::pipe::create(log, pool.service());
+
+    data_chunk out(4, 0x00);
+    std::promise<code> read{};
+    pair.first->read(out, [&](const code& ec, size_t size)
+    {
+        BOOST_REQUIRE_EQUAL(size, 0u);
+        read.set_value(ec);
+    });
+
+    pair.second->stop();
+    BOOST_REQUIRE_EQUAL(read.get_future().get(), error::peer_disconnect);
+
+    pair.first->stop();
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(pipe__read__stopped__channel_stopped)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto pair = network::pipe::create(log, pool.service());
+
+    data_chunk out(4, 0x00);
+    std::promise<code> read{};
+    pair.first->read(out, [&](const code& ec, size_t)
+    {
+        read.set_value(ec);
+    });
+
+    pair.first->stop();
+    BOOST_REQUIRE_EQUAL(read.get_future().get(), error::channel_stopped);
+
+    pair.second->stop();
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,13 @@
 
 BOOST_AUTO_TEST_SUITE(proxy_tests)
 
+static const auto payloads = std::make_shared<payload_pool>(1, 4'000'000);
+static threadpool deserializers(1);
+static checksum_batcher batcher(microseconds(1'000));
+static metrics counters{};
+static const auto budget = std::make_shared<memory_budget>(0);
+static upload_budget uploaded(0, 0);
+
 class mock_proxy
   : public proxy
 {
@@ -38,7 +45,7 @@ public:
     }
 
     mock_proxy(socket::ptr socket) NOEXCEPT
-      : proxy(socket)
+      : proxy(socket, payloads, budget)
     {
     }
 
@@ -58,31 +65,161 @@ public:
         return stopped_.get_future().get();
     }
 
-    size_t minimum_buffer() const NOEXCEPT override
+    size_t maximum_payload() const NOEXCEPT override
     {
         return 0;
     }
 
-    size_t maximum_payload() const NOEXCEPT override
+    uint32_t protocol_magic() const NOEXCEPT override
     {
         return 0;
     }
 
-    uint32_t protocol_magic() const NOEXCEPT override
+    bool validate_checksum() const NOEXCEPT override
+    {
+        return false;
+    }
+
+    bool trusted() const NOEXCEPT override
+    {
+        return false;
+    }
+
+    bool retain_payload() const NOEXCEPT override
+    {
+        return false;
+    }
+
+    size_t maximum_gather_count() const NOEXCEPT override
+    {
+        return 1;
+    }
+
+    size_t maximum_gather_bytes() const NOEXCEPT override
     {
         return 0;
     }
 
-    bool validate_checksum() const NOEXCEPT override
+    size_t deserialize_threshold() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t read_chunk() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t read_ahead() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t write_slice() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t buffer_retain() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    deadline::duration buffer_idle() const NOEXCEPT override
+    {
+        return {};
+    }
+
+    deadline::duration read_quantum() const NOEXCEPT override
+    {
+        return {};
+    }
+
+    bool batch_checksum() const NOEXCEPT override
     {
         return false;
     }
 
+    bool deduplicate_sends() const NOEXCEPT override
+    {
+        return false;
+    }
+
+    bool pool_sends() const NOEXCEPT override
+    {
+        return false;
+    }
+
+    size_t rate_limit() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t send_high_water() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t send_low_water() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    deadline::duration send_grace() const NOEXCEPT override
+    {
+        return {};
+    }
+
+    size_t compression_minimum() const NOEXCEPT override
+    {
+        return 0;
+    }
+
+    size_t trace_sample() const NOEXCEPT override
+    {
+        return 1;
+    }
+
+    uint64_t trace_id() const NOEXCEPT override
+    {
+        return 0;
+    }
+
     uint32_t version() const NOEXCEPT override
     {
         return 0;
     }
 
+    asio::io_context& deserializer() NOEXCEPT override
+    {
+        return deserializers.service();
+    }
+
+    checksum_batcher& checksums() NOEXCEPT override
+    {
+        return batcher;
+    }
+
+    metrics& aggregate() NOEXCEPT override
+    {
+        return counters;
+    }
+
+    upload_budget& uploads() NOEXCEPT override
+    {
+        return uploaded;
+    }
+
+    capture* recorder() NOEXCEPT override
+    {
+        return nullptr;
+    }
+
+    message_exporter* exporter() NOEXCEPT override
+    {
+        return nullptr;
+    }
+
     void signal_activity() NOEXCEPT override
     {
     }
@@ -109,6 +246,44 @@ BOOST_AUTO_TEST_CASE(proxy__paused__default__true)
     proxy_ptr->stop(error::invalid_magic);
 }
 
+BOOST_AUTO_TEST_CASE(proxy__starved__default__false)
+{
+    const logger log{};
+    threadpool pool(1);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto proxy_ptr = std::make_shared<mock_proxy>(socket_ptr);
+
+    std::promise<bool> starved;
+    boost::asio::post(proxy_ptr->strand(), [=, &starved]() NOEXCEPT
+    {
+        starved.set_value(proxy_ptr->starved());
+    });
+
+    BOOST_REQUIRE(!starved.get_future().get());
+    proxy_ptr->stop(error::invalid_magic);
+}
+
+BOOST_AUTO_TEST_CASE(proxy__starved__resume_without_credit__true)
+{
+    const logger log{};
+    threadpool pool(1);
+    auto socket_ptr = std::make_shared<network::socket>(log, pool.service());
+    auto proxy_ptr = std::make_shared<mock_proxy>(socket_ptr);
+
+    // Enables flow control without credit, so resume holds the read.
+    proxy_ptr->grant(0, 0);
+
+    std::promise<bool> starved;
+    boost::asio::post(proxy_ptr->strand(), [=, &starved]() NOEXCEPT
+    {
+        proxy_ptr->resume();
+        starved.set_value(proxy_ptr->starved());
+    });
+
+    BOOST_REQUIRE(starved.get_future().get());
+    proxy_ptr->stop(error::invalid_magic);
+}
+
 BOOST_AUTO_TEST_CASE(proxy__paused__pause__true)
 {
     const logger log{};
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(recycler_tests)
+
+using namespace network::messages;
+
+constexpr uint32_t protocol = level::maximum_protocol;
+
+// Count (varint) of two zeroed inventory items (type and hash).
+inline data_chunk inventory_payload()
+{
+    data_chunk data(add1(2u * inventory_item::size(protocol)), 0x00);
+    data.front() = 2;
+    return data;
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deserialize__valid__expected)
+{
+    recycler<inventory> instance{};
+    const auto message = instance.deserialize(protocol, inventory_payload());
+    BOOST_REQUIRE(message);
+    BOOST_REQUIRE_EQUAL(message->items.size(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deserialize__invalid__nullptr_retained)
+{
+    recycler<inventory> instance{};
+    BOOST_REQUIRE(!instance.deserialize(protocol, data_chunk{ 0x02 }));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deserialize__released__object_and_capacity_reused)
+{
+    recycler<inventory> instance{};
+    auto first = instance.deserialize(protocol, inventory_payload());
+    BOOST_REQUIRE(first);
+
+    const auto address = first.get();
+    const auto capacity = first->items.capacity();
+    first.reset();
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+
+    const auto second = instance.deserialize(protocol, data_chunk{ 0x00 });
+    BOOST_REQUIRE(second);
+    BOOST_REQUIRE_EQUAL(second.get(), address);
+    BOOST_REQUIRE(second->items.empty());
+    BOOST_REQUIRE_EQUAL(second->items.capacity(), capacity);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deserialize__over_capacity__freed)
+{
+    recycler<inventory> instance{ 4, 1 };
+    BOOST_REQUIRE(instance.deserialize(protocol, inventory_payload()));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deserialize__outlives_recycler__freed)
+{
+    inventory::cptr message{};
+    {
+        recycler<inventory> instance{};
+        message = instance.deserialize(protocol, inventory_payload());
+    }
+
+    BOOST_REQUIRE(message);
+    BOOST_REQUIRE_EQUAL(message->items.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deserialize__ping__expected)
+{
+    recycler<ping> instance{};
+    const data_chunk data{ 0x2a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    auto message = instance.deserialize(protocol, data);
+    BOOST_REQUIRE(message);
+    BOOST_REQUIRE_EQUAL(message->nonce, 42u);
+
+    message.reset();
+    BOOST_REQUIRE_EQUAL(instance.retained(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
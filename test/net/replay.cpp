@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct replay_tests_setup_fixture
+{
+    replay_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+
+    ~replay_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(replay_tests, replay_tests_setup_fixture)
+
+BOOST_AUTO_TEST_CASE(replay__start__missing_file__file_load)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto socket = std::make_shared<network::socket>(log, pool.service());
+    const auto instance = std::make_shared<replay>(log, socket, TEST_NAME,
+        false);
+
+    boost::asio::post(socket->strand(), [instance, socket]()
+    {
+        instance->start([socket](const code& ec, size_t count)
+        {
+            BOOST_REQUIRE_EQUAL(ec, error::file_load);
+            BOOST_REQUIRE_EQUAL(count, zero);
+            socket->stop();
+        });
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(replay__start__disconnected__bad_stream)
+{
+    {
+        capture recorder{ TEST_NAME };
+        BOOST_REQUIRE(recorder.write(system::data_chunk{ 0x01 },
+            system::data_chunk{ 0x02 }));
+    }
+
+    const logger log{};
+    threadpool pool(2);
+    const auto socket = std::make_shared<network::socket>(log, pool.service());
+    const auto instance = std::make_shared<replay>(log, socket, TEST_NAME,
+        false);
+
+    boost::asio::post(socket->strand(), [instance, socket]()
+    {
+        instance->start([socket](const code& ec, size_t count)
+        {
+            // 10009 (WSAEBADF, invalid file handle) gets mapped to bad_stream.
+            BOOST_REQUIRE_EQUAL(ec, error::bad_stream);
+            BOOST_REQUIRE_EQUAL(count, zero);
+            socket->stop();
+        });
+    });
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
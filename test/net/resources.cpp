@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(resources_tests)
+
+BOOST_AUTO_TEST_CASE(resources__construct__settings__configured)
+{
+    settings set(bc::system::chain::selection::mainnet);
+    set.memory_budget_megabytes = 2;
+    resources instance(set);
+    BOOST_REQUIRE_EQUAL(instance.memory().limit(), 2'000'000u);
+    BOOST_REQUIRE_EQUAL(instance.memory().used(), 0u);
+    instance.stop();
+    BOOST_REQUIRE(instance.join());
+}
+
+BOOST_AUTO_TEST_CASE(resources__construct__distinct_settings__independent)
+{
+    settings first(bc::system::chain::selection::mainnet);
+    settings second(bc::system::chain::selection::testnet);
+    first.memory_budget_megabytes = 1;
+    second.memory_budget_megabytes = 3;
+    resources left(first);
+    resources right(second);
+    BOOST_REQUIRE_EQUAL(left.memory().limit(), 1'000'000u);
+    BOOST_REQUIRE_EQUAL(right.memory().limit(), 3'000'000u);
+
+    left.memory().acquire(42);
+    BOOST_REQUIRE_EQUAL(left.memory().used(), 42u);
+    BOOST_REQUIRE_EQUAL(right.memory().used(), 0u);
+    left.memory().release(42);
+    BOOST_REQUIRE(&left.timers() != &right.timers());
+    BOOST_REQUIRE(&left.payload_buffers() != &right.payload_buffers());
+}
+
+BOOST_AUTO_TEST_CASE(resources__deserializers__stop_join__completed)
+{
+    const settings set(bc::system::chain::selection::mainnet);
+    resources instance(set);
+    std::promise<bool> promise{};
+    boost::asio::post(instance.deserializers().service(), [&]() NOEXCEPT
+    {
+        promise.set_value(true);
+    });
+
+    BOOST_REQUIRE(promise.get_future().get());
+    instance.stop();
+    BOOST_REQUIRE(instance.join());
+}
+
+BOOST_AUTO_TEST_CASE(resources__take_high_bandwidth__three_taken__false_until_released)
+{
+    const settings set(bc::system::chain::selection::mainnet);
+    resources instance(set);
+    BOOST_REQUIRE(instance.take_high_bandwidth());
+    BOOST_REQUIRE(instance.take_high_bandwidth());
+    BOOST_REQUIRE(instance.take_high_bandwidth());
+    BOOST_REQUIRE(!instance.take_high_bandwidth());
+
+    instance.release_high_bandwidth();
+    BOOST_REQUIRE(instance.take_high_bandwidth());
+    BOOST_REQUIRE(!instance.take_high_bandwidth());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
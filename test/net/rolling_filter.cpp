@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(rolling_filter_tests)
+
+using namespace system;
+
+static hash_digest to_hash(size_t value) NOEXCEPT
+{
+    return sha256_hash(to_little_endian(value));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__empty__false)
+{
+    const rolling_filter instance(100);
+    BOOST_REQUIRE(!instance.contains(to_hash(42)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__zero_capacity__false)
+{
+    rolling_filter instance(0);
+    instance.insert(to_hash(42));
+    BOOST_REQUIRE(!instance.contains(to_hash(42)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__insert__within_capacity__contains_all)
+{
+    constexpr size_t capacity = 100;
+    rolling_filter instance(capacity);
+
+    for (size_t value = 0; value < capacity; ++value)
+        instance.insert(to_hash(value));
+
+    for (size_t value = 0; value < capacity; ++value)
+        BOOST_REQUIRE(instance.contains(to_hash(value)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__insert__twice_capacity__forgets_oldest)
+{
+    constexpr size_t capacity = 100;
+    rolling_filter instance(capacity);
+
+    for (size_t value = 0; value < 2 * capacity; ++value)
+        instance.insert(to_hash(value));
+
+    // Most recent generation(s) are retained.
+    for (size_t value = capacity + capacity / 2; value < 2 * capacity; ++value)
+        BOOST_REQUIRE(instance.contains(to_hash(value)));
+
+    // Oldest generation is forgotten (barring false positives).
+    size_t retained{};
+    for (size_t value = 0; value < capacity / 2; ++value)
+        retained += instance.contains(to_hash(value)) ? 1 : 0;
+
+    BOOST_REQUIRE_LT(retained, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__clear__inserted__not_contained)
+{
+    rolling_filter instance(100);
+    instance.insert(to_hash(42));
+    BOOST_REQUIRE(instance.contains(to_hash(42)));
+    instance.clear();
+    BOOST_REQUIRE(!instance.contains(to_hash(42)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
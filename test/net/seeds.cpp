@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct seeds_tests_setup_fixture
+{
+    seeds_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+
+    ~seeds_tests_setup_fixture()
+    {
+        test::remove(TEST_NAME);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(seeds_tests, seeds_tests_setup_fixture)
+
+class mock_settings final
+  : public settings
+{
+public:
+    using settings::settings;
+
+    // Override derivative name, using directory as file.
+    std::filesystem::path seeds_file() const NOEXCEPT override
+    {
+        return path;
+    }
+};
+
+const config::endpoint seed1{ "seed1.example.com", 8333 };
+const config::endpoint seed2{ "seed2.example.com", 8333 };
+const config::authority resolved{ "1.2.3.4:8333" };
+
+// load/save
+
+BOOST_AUTO_TEST_CASE(seeds__save__disabled__no_file)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.seeds = { seed1 };
+    seeds instance(set);
+    instance.connected(seed1, resolved);
+    BOOST_REQUIRE_EQUAL(instance.save(), error::success);
+    BOOST_REQUIRE(!test::exists(TEST_NAME));
+}
+
+BOOST_AUTO_TEST_CASE(seeds__load__no_file__success)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.seed_cache_minutes = 42;
+    seeds instance(set);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE(!instance.get(seed1).authority);
+}
+
+BOOST_AUTO_TEST_CASE(seeds__save__load__round_trip)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.seed_cache_minutes = 42;
+    set.seeds = { seed1, seed2 };
+
+    seeds writer(set);
+    writer.connected(seed1, resolved);
+    writer.yielded(seed1, 7);
+    writer.failed(seed2);
+    BOOST_REQUIRE_EQUAL(writer.save(), error::success);
+    BOOST_REQUIRE(test::exists(TEST_NAME));
+
+    seeds reader(set);
+    BOOST_REQUIRE_EQUAL(reader.load(), error::success);
+    const auto first = reader.get(seed1);
+    BOOST_REQUIRE(first.authority == resolved);
+    BOOST_REQUIRE_EQUAL(first.yield, 7u);
+    BOOST_REQUIRE_EQUAL(first.successes, 1u);
+    BOOST_REQUIRE_EQUAL(first.failures, 0u);
+    const auto second = reader.get(seed2);
+    BOOST_REQUIRE(!second.authority);
+    BOOST_REQUIRE_EQUAL(second.failures, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(seeds__load__unconfigured_seed__dropped)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.path = TEST_NAME;
+    set.seed_cache_minutes = 42;
+    set.seeds = { seed1 };
+
+    seeds writer(set);
+    writer.connected(seed1, resolved);
+    BOOST_REQUIRE_EQUAL(writer.save(), error::success);
+
+    set.seeds = { seed2 };
+    seeds reader(set);
+    BOOST_REQUIRE_EQUAL(reader.load(), error::success);
+    BOOST_REQUIRE(!reader.get(seed1).authority);
+}
+
+// target
+
+BOOST_AUTO_TEST_CASE(seeds__target__unresolved__seed)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.seed_cache_minutes = 42;
+    seeds instance(set);
+    BOOST_REQUIRE(instance.target(seed1) == seed1);
+}
+
+BOOST_AUTO_TEST_CASE(seeds__target__fresh__authority)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.seed_cache_minutes = 42;
+    seeds instance(set);
+    instance.connected(seed1, resolved);
+    BOOST_REQUIRE(instance.target(seed1) == config::endpoint{ resolved });
+}
+
+BOOST_AUTO_TEST_CASE(seeds__target__disabled__seed)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    seeds instance(set);
+    instance.connected(seed1, resolved);
+    BOOST_REQUIRE(instance.target(seed1) == seed1);
+}
+
+BOOST_AUTO_TEST_CASE(seeds__target__failed__seed)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.seed_cache_minutes = 42;
+    seeds instance(set);
+    instance.connected(seed1, resolved);
+    instance.failed(seed1);
+    BOOST_REQUIRE(instance.target(seed1) == seed1);
+}
+
+// order
+
+BOOST_AUTO_TEST_CASE(seeds__order__yield__descending)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.seed_cache_minutes = 42;
+    set.seeds = { seed1, seed2 };
+    seeds instance(set);
+    instance.yielded(seed2, 42);
+    const auto ordered = instance.order();
+    BOOST_REQUIRE_EQUAL(ordered.size(), 2u);
+    BOOST_REQUIRE(ordered.front() == seed2);
+    BOOST_REQUIRE(ordered.back() == seed1);
+}
+
+BOOST_AUTO_TEST_CASE(seeds__order__failed_without_yield__skipped)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.seed_cache_minutes = 42;
+    set.seeds = { seed1, seed2 };
+    seeds instance(set);
+    instance.failed(seed1);
+    const auto ordered = instance.order();
+    BOOST_REQUIRE_EQUAL(ordered.size(), 1u);
+    BOOST_REQUIRE(ordered.front() == seed2);
+}
+
+BOOST_AUTO_TEST_CASE(seeds__order__all_failed__all)
+{
+    mock_settings set(bc::system::chain::selection::mainnet);
+    set.seed_cache_minutes = 42;
+    set.seeds = { seed1, seed2 };
+    seeds instance(set);
+    instance.failed(seed1);
+    instance.failed(seed2);
+    BOOST_REQUIRE_EQUAL(instance.order().size(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
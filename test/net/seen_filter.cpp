@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include <atomic>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(seen_filter_tests)
+
+using namespace system;
+
+static hash_digest to_hash(size_t value) NOEXCEPT
+{
+    return sha256_hash(to_little_endian(value));
+}
+
+BOOST_AUTO_TEST_CASE(seen_filter__contains__empty__false)
+{
+    const seen_filter instance(100);
+    BOOST_REQUIRE(!instance.contains(to_hash(42)));
+}
+
+BOOST_AUTO_TEST_CASE(seen_filter__insert__zero_capacity__always_novel)
+{
+    seen_filter instance(0);
+    BOOST_REQUIRE(instance.insert(to_hash(42)));
+    BOOST_REQUIRE(instance.insert(to_hash(42)));
+    BOOST_REQUIRE(!instance.contains(to_hash(42)));
+}
+
+BOOST_AUTO_TEST_CASE(seen_filter__insert__duplicate__not_novel)
+{
+    seen_filter instance(100);
+    BOOST_REQUIRE(instance.insert(to_hash(42)));
+    BOOST_REQUIRE(!instance.insert(to_hash(42)));
+    BOOST_REQUIRE(instance.contains(to_hash(42)));
+}
+
+BOOST_AUTO_TEST_CASE(seen_filter__insert__twice_capacity__forgets_oldest)
+{
+    constexpr size_t capacity = 100;
+    seen_filter instance(capacity);
+
+    for (size_t value = 0; value < 2 * capacity; ++value)
+        instance.insert(to_hash(value));
+
+    // Most recent generation(s) are retained.
+    for (size_t value = capacity + capacity / 2; value < 2 * capacity; ++value)
+        BOOST_REQUIRE(instance.contains(to_hash(value)));
+
+    // Oldest generation is forgotten (barring false positives).
+    size_t retained{};
+    for (size_t value = 0; value < capacity / 2; ++value)
+        retained += instance.contains(to_hash(value)) ? 1 : 0;
+
+    BOOST_REQUIRE_LT(retained, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(seen_filter__insert__concurrent__each_novel_once)
+{
+    constexpr size_t capacity = 1000;
+    constexpr size_t threads = 4;
+    seen_filter instance(2 * capacity);
+    std::atomic<size_t> novel{};
+
+    std::vector<std::thread> workers{};
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back([&]() NOEXCEPT
+        {
+            for (size_t value = 0; value < capacity; ++value)
+                if (instance.insert(to_hash(value)))
+                    ++novel;
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    // A racing duplicate may be admitted, but most are dropped.
+    BOOST_REQUIRE_GE(novel.load(), capacity - 2u);
+    BOOST_REQUIRE_LT(novel.load(), capacity * 2u);
+}
+
+BOOST_AUTO_TEST_CASE(seen_filter__bytes__capacity__non_zero)
+{
+    const seen_filter instance(100);
+    BOOST_REQUIRE_GT(instance.bytes(), 0u);
+    BOOST_REQUIRE_EQUAL(seen_filter(0).bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
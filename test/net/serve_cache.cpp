@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(serve_cache_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+static transaction make_transaction(uint32_t locktime) NOEXCEPT
+{
+    return { to_shared<chain::transaction>(1u, chain::inputs{},
+        chain::outputs{}, locktime) };
+}
+
+BOOST_AUTO_TEST_CASE(serve_cache__find__empty__nullptr)
+{
+    serve_cache instance(1'000);
+    BOOST_REQUIRE(!instance.find<transaction>(null_hash, 1, level::bip31));
+    BOOST_REQUIRE(!instance.find<block>(null_hash, 1, level::bip31));
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.bytes(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(serve_cache__serialize__transaction__found_by_txid)
+{
+    serve_cache instance(1'000);
+    const auto message = make_transaction(0);
+    const auto hash = message.transaction_ptr->hash(false);
+    const auto data = instance.serialize(message, 1, level::bip31);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE_EQUAL(instance.find<transaction>(hash, 1, level::bip31).get(),
+        data.get());
+    BOOST_REQUIRE_EQUAL(instance.serialize(message, 1, level::bip31).get(),
+        data.get());
+    BOOST_REQUIRE(!instance.find<block>(hash, 1, level::bip31));
+    BOOST_REQUIRE(!instance.find<transaction>(hash, 2, level::bip31));
+    BOOST_REQUIRE(!instance.find<transaction>(hash, 1, level::bip37));
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.bytes(), data->size());
+}
+
+BOOST_AUTO_TEST_CASE(serve_cache__serialize__zero_capacity__not_cached)
+{
+    serve_cache instance(0);
+    const auto message = make_transaction(0);
+    BOOST_REQUIRE(instance.serialize(message, 1, level::bip31));
+    BOOST_REQUIRE(!instance.find<transaction>(
+        message.transaction_ptr->hash(false), 1, level::bip31));
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(serve_cache__serialize__null_transaction__nullptr)
+{
+    serve_cache instance(1'000);
+    BOOST_REQUIRE(!instance.serialize(transaction{}, 1, level::bip31));
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(serve_cache__serialize__full__evicts_least_recent)
+{
+    const auto first = make_transaction(1);
+    const auto second = make_transaction(2);
+    const auto third = make_transaction(3);
+    const auto size = network::messages::serialize(first, 1,
+        level::bip31)->size();
+
+    // Capacity is two encodings (of equal size).
+    serve_cache instance(two * size);
+    BOOST_REQUIRE(instance.serialize(first, 1, level::bip31));
+    BOOST_REQUIRE(instance.serialize(second, 1, level::bip31));
+
+    // Touch the first, so that the second is least recent.
+    BOOST_REQUIRE(instance.find<transaction>(
+        first.transaction_ptr->hash(false), 1, level::bip31));
+    BOOST_REQUIRE(instance.serialize(third, 1, level::bip31));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+    BOOST_REQUIRE_EQUAL(instance.bytes(), two * size);
+    BOOST_REQUIRE(instance.find<transaction>(
+        first.transaction_ptr->hash(false), 1, level::bip31));
+    BOOST_REQUIRE(!instance.find<transaction>(
+        second.transaction_ptr->hash(false), 1, level::bip31));
+    BOOST_REQUIRE(instance.find<transaction>(
+        third.transaction_ptr->hash(false), 1, level::bip31));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(short_id_table_tests)
+
+BOOST_AUTO_TEST_CASE(short_id_table__find__empty__nullptr)
+{
+    short_id_table instance(10);
+    BOOST_REQUIRE(is_null(instance.find(42)));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(short_id_table__insert__distinct__found)
+{
+    constexpr size_t count = 100;
+    short_id_table instance(count);
+
+    // Identical low bits force probing.
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.insert(value << 20, value));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), count);
+    for (size_t value = 0; value < count; ++value)
+    {
+        const auto found = instance.find(value << 20);
+        BOOST_REQUIRE(!is_null(found));
+        BOOST_REQUIRE_EQUAL(*found, value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(short_id_table__insert__duplicate__false_unchanged)
+{
+    short_id_table instance(10);
+    BOOST_REQUIRE(instance.insert(42, 1));
+    BOOST_REQUIRE(!instance.insert(42, 2));
+    BOOST_REQUIRE_EQUAL(*instance.find(42), 1u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(short_id_table__find__value__mutable)
+{
+    short_id_table instance(10);
+    BOOST_REQUIRE(instance.insert(42, 1));
+    *instance.find(42) = 7;
+    BOOST_REQUIRE_EQUAL(*instance.find(42), 7u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
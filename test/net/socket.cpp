@@ -187,6 +187,30 @@ BOOST_AUTO_TEST_CASE(socket__read__disconnected__error)
     BOOST_REQUIRE(pool.join());
 }
 
+BOOST_AUTO_TEST_CASE(socket__read_some__disconnected__error)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto instance = std::make_shared<socket_accessor>(log, pool.service());
+
+    system::data_array<42> data;
+    instance->read_some({ data }, [instance](const code& ec, size_t size)
+    {
+        // 10009 (WSAEBADF, invalid file handle) gets mapped to bad_stream.
+        BOOST_REQUIRE_EQUAL(ec, error::bad_stream);
+        BOOST_REQUIRE_EQUAL(size, zero);
+    });
+
+    // Test race.
+    std::this_thread::sleep_for(microseconds(1));
+
+    // Stopping the socket precludes assertion.
+    instance->stop();
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
 BOOST_AUTO_TEST_CASE(socket__write__disconnected__bad_stream)
 {
     const logger log{};
@@ -211,4 +235,58 @@ BOOST_AUTO_TEST_CASE(socket__write__disconnected__bad_stream)
     BOOST_REQUIRE(pool.join());
 }
 
+BOOST_AUTO_TEST_CASE(socket__write_file__disconnected__error)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto instance = std::make_shared<socket_accessor>(log, pool.service());
+
+    const socket::file_region region{ -1, zero, 42 };
+    instance->write(region, [instance](const code& ec, size_t size)
+    {
+        // Invalid descriptor (or unsupported platform).
+        BOOST_REQUIRE(ec);
+        BOOST_REQUIRE_EQUAL(size, zero);
+    });
+
+    // Test race.
+    std::this_thread::sleep_for(microseconds(1));
+
+    // Stopping the socket precludes assertion.
+    instance->stop();
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(socket__write_buffers__disconnected__bad_stream)
+{
+    const logger log{};
+    threadpool pool(2);
+    const auto instance = std::make_shared<socket_accessor>(log, pool.service());
+
+    system::data_array<42> data1;
+    system::data_array<24> data2;
+    const asio::const_buffers buffers
+    {
+        { data1.data(), data1.size() },
+        { data2.data(), data2.size() }
+    };
+
+    instance->write(buffers, [instance](const code& ec, size_t size)
+    {
+        BOOST_REQUIRE_EQUAL(ec, error::bad_stream);
+        BOOST_REQUIRE_EQUAL(size, zero);
+    });
+
+    // Test race.
+    std::this_thread::sleep_for(microseconds(1));
+
+    // Stopping the socket precludes assertion.
+    instance->stop();
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(timeout_estimator_tests)
+
+BOOST_AUTO_TEST_CASE(timeout_estimator__estimate__insufficient_samples__maximum)
+{
+    timeout_estimator instance{};
+    BOOST_REQUIRE(instance.estimate(milliseconds(10), seconds(5)) == seconds(5));
+
+    for (size_t sample = 0; sample < 15u; ++sample)
+        instance.sample(milliseconds(100));
+
+    BOOST_REQUIRE_EQUAL(instance.count(), 15u);
+    BOOST_REQUIRE(instance.estimate(milliseconds(10), seconds(5)) == seconds(5));
+}
+
+BOOST_AUTO_TEST_CASE(timeout_estimator__estimate__sufficient_samples__twice_percentile)
+{
+    timeout_estimator instance{};
+    for (size_t sample = 1; sample <= 20u; ++sample)
+        instance.sample(milliseconds(sample * 10u));
+
+    BOOST_REQUIRE(instance.estimate(milliseconds(10), seconds(5)) ==
+        milliseconds(400));
+}
+
+BOOST_AUTO_TEST_CASE(timeout_estimator__estimate__out_of_bounds__clamped)
+{
+    timeout_estimator instance{};
+    for (size_t sample = 0; sample < 20u; ++sample)
+        instance.sample(milliseconds(100));
+
+    BOOST_REQUIRE(instance.estimate(seconds(1), seconds(5)) == seconds(1));
+    BOOST_REQUIRE(instance.estimate(milliseconds(1), milliseconds(150)) ==
+        milliseconds(150));
+}
+
+BOOST_AUTO_TEST_CASE(timeout_estimator__sample__full_window__oldest_replaced)
+{
+    timeout_estimator instance{ 32 };
+    for (size_t sample = 0; sample < 32u; ++sample)
+        instance.sample(seconds(1));
+
+    for (size_t sample = 0; sample < 32u; ++sample)
+        instance.sample(milliseconds(50));
+
+    BOOST_REQUIRE_EQUAL(instance.count(), 32u);
+    BOOST_REQUIRE(instance.estimate(milliseconds(1), seconds(5)) ==
+        milliseconds(100));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
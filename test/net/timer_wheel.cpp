@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(timer_wheel_tests)
+
+BOOST_AUTO_TEST_CASE(timer_wheel__resolution__default__one_second)
+{
+    const timer_wheel wheel{};
+    BOOST_REQUIRE(wheel.resolution() == seconds(1));
+    BOOST_REQUIRE_EQUAL(wheel.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__start__expires__success)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    timer_wheel wheel(milliseconds(1), 4);
+    std::promise<code> promise{};
+    timer_wheel::key id{};
+
+    wheel.start(id, strand, [&](const code& ec) NOEXCEPT
+    {
+        promise.set_value(ec);
+    }, milliseconds(10));
+
+    BOOST_REQUIRE_NE(id, 0u);
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(wheel.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__stop__pending__canceled)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    timer_wheel wheel(seconds(1));
+    std::promise<code> promise{};
+    timer_wheel::key id{};
+
+    wheel.start(id, strand, [&](const code& ec) NOEXCEPT
+    {
+        promise.set_value(ec);
+    }, seconds(42));
+
+    BOOST_REQUIRE_EQUAL(wheel.size(), 1u);
+    wheel.stop(id);
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::operation_canceled);
+    BOOST_REQUIRE_EQUAL(wheel.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__start__restart__canceled_then_success)
+{
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    timer_wheel wheel(milliseconds(1), 4);
+    std::promise<code> first{};
+    std::promise<code> second{};
+    timer_wheel::key id{};
+
+    wheel.start(id, strand, [&](const code& ec) NOEXCEPT
+    {
+        first.set_value(ec);
+    }, seconds(42));
+
+    const auto key = id;
+    wheel.start(id, strand, [&](const code& ec) NOEXCEPT
+    {
+        second.set_value(ec);
+    }, milliseconds(10));
+
+    BOOST_REQUIRE_EQUAL(id, key);
+    BOOST_REQUIRE_EQUAL(first.get_future().get(), error::operation_canceled);
+    BOOST_REQUIRE_EQUAL(second.get_future().get(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(deadline__start__wheel__success)
+{
+    const logger log{};
+    threadpool pool(1);
+    asio::strand strand(pool.service().get_executor());
+    timer_wheel wheel(milliseconds(1));
+    std::promise<code> promise{};
+    const auto timer = std::make_shared<deadline>(log, strand, wheel,
+        milliseconds(5));
+
+    timer->start([&](const code& ec) NOEXCEPT
+    {
+        promise.set_value(ec);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
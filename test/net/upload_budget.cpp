@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(upload_budget_tests)
+
+BOOST_AUTO_TEST_CASE(upload_budget__construct__limits__unspent)
+{
+    const upload_budget instance{ 800, 8000 };
+    BOOST_REQUIRE_EQUAL(instance.limit(), 800u);
+    BOOST_REQUIRE_EQUAL(instance.target(), 8000u);
+    BOOST_REQUIRE_EQUAL(instance.sent(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.served(), 0u);
+    BOOST_REQUIRE(!instance.deferred());
+    BOOST_REQUIRE(instance.delay() == upload_budget::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(upload_budget__consume__zero_limits__not_deferred)
+{
+    upload_budget instance{ 0, 0 };
+    instance.consume(1'000'000);
+    BOOST_REQUIRE_EQUAL(instance.served(), 1'000'000u);
+    BOOST_REQUIRE(!instance.deferred());
+    BOOST_REQUIRE(instance.delay() == upload_budget::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(upload_budget__consume__interval_limit__deferred)
+{
+    upload_budget instance{ 800, 0, std::chrono::hours{ 1 } };
+    instance.consume(799);
+    BOOST_REQUIRE(!instance.deferred());
+    instance.consume(1);
+    BOOST_REQUIRE_EQUAL(instance.sent(), 800u);
+    BOOST_REQUIRE(instance.deferred());
+    BOOST_REQUIRE(instance.delay() > upload_budget::duration::zero());
+    BOOST_REQUIRE(instance.delay() <= std::chrono::hours{ 1 });
+}
+
+BOOST_AUTO_TEST_CASE(upload_budget__consume__daily_target__deferred)
+{
+    upload_budget instance{ 0, 800, std::chrono::hours{ 1 } };
+    instance.consume(800);
+    BOOST_REQUIRE(instance.deferred());
+    BOOST_REQUIRE(instance.delay() > std::chrono::hours{ 1 });
+    BOOST_REQUIRE(instance.delay() <= std::chrono::hours{ 24 });
+}
+
+BOOST_AUTO_TEST_CASE(upload_budget__consume__interval_elapsed__replenished)
+{
+    upload_budget instance{ 800, 0, milliseconds{ 1 } };
+    instance.consume(800);
+    std::this_thread::sleep_for(milliseconds{ 5 });
+    BOOST_REQUIRE_EQUAL(instance.sent(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.served(), 800u);
+    BOOST_REQUIRE(!instance.deferred());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
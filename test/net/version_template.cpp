@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(version_template_tests)
+
+using namespace bc::network::messages;
+
+constexpr uint32_t magic = 0x0a0b0c0d;
+
+static version make(uint64_t nonce, uint16_t port, uint32_t height,
+    const std::string& agent="/test:0.1/") NOEXCEPT
+{
+    return
+    {
+        level::maximum_protocol,
+        service::node_network,
+        nonce + 1000,
+        { 0, service::node_none, loopback_ip_address, port },
+        { 0, service::node_network, unspecified_ip_address, 8333 },
+        nonce,
+        agent,
+        height,
+        true
+    };
+}
+
+BOOST_AUTO_TEST_CASE(version_template__size__default__zero)
+{
+    const version_template instance{};
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(version_template__serialize__first__expected_encoding)
+{
+    version_template instance{};
+    const auto message = make(42, 1, 100);
+    const auto data = instance.serialize(message, magic, level::maximum_protocol);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE(*data == *serialize(message, magic, level::maximum_protocol));
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+}
+
+BOOST_AUTO_TEST_CASE(version_template__serialize__varied_fields__patched_encoding)
+{
+    version_template instance{};
+    const auto first = make(42, 1, 100);
+    const auto second = make(0x0102030405060708, 0xabcd, 0x01020304);
+    BOOST_REQUIRE(instance.serialize(first, magic, level::maximum_protocol));
+
+    const auto data = instance.serialize(second, magic, level::maximum_protocol);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE(*data == *serialize(second, magic, level::maximum_protocol));
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+}
+
+BOOST_AUTO_TEST_CASE(version_template__serialize__distinct_user_agent__distinct_template)
+{
+    version_template instance{};
+    const auto first = make(42, 1, 100);
+    const auto second = make(43, 2, 101, "/other:0.2/");
+    BOOST_REQUIRE(instance.serialize(first, magic, level::maximum_protocol));
+
+    const auto data = instance.serialize(second, magic, level::maximum_protocol);
+    BOOST_REQUIRE(data);
+    BOOST_REQUIRE(*data == *serialize(second, magic, level::maximum_protocol));
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+}
+
+BOOST_AUTO_TEST_CASE(version_template__serialize__beyond_capacity__bounded)
+{
+    version_template instance{};
+    for (size_t index = 0; index <= version_template::capacity; ++index)
+        BOOST_REQUIRE(instance.serialize(make(42, 1, 100),
+            possible_narrow_cast<uint32_t>(index), level::maximum_protocol));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), version_template::capacity);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(wire_cache_tests)
+
+using namespace bc::network::messages;
+
+BOOST_AUTO_TEST_CASE(wire_cache__size__default__zero)
+{
+    const wire_cache instance{};
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(wire_cache__serialize__same_parameters__shared_chunk)
+{
+    wire_cache instance{};
+    const ping message{ 42 };
+    const auto first = instance.serialize(message, 0x0a0b0c0d, level::bip31);
+    const auto second = instance.serialize(message, 0x0a0b0c0d, level::bip31);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE_EQUAL(first.get(), second.get());
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+}
+
+BOOST_AUTO_TEST_CASE(wire_cache__serialize__distinct_versions__distinct_chunks)
+{
+    wire_cache instance{};
+    const ping message{ 42 };
+    const auto first = instance.serialize(message, 0x0a0b0c0d, level::bip31);
+    const auto second = instance.serialize(message, 0x0a0b0c0d, level::maximum_protocol);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE(second);
+    BOOST_REQUIRE_NE(first.get(), second.get());
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+}
+
+BOOST_AUTO_TEST_CASE(wire_cache__serialize__distinct_magic__distinct_chunks)
+{
+    wire_cache instance{};
+    const ping message{ 42 };
+    const auto first = instance.serialize(message, 1, level::bip31);
+    const auto second = instance.serialize(message, 2, level::bip31);
+    BOOST_REQUIRE_NE(first.get(), second.get());
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+}
+
+BOOST_AUTO_TEST_CASE(wire_cache__serialize__ping__expected_encoding)
+{
+    wire_cache instance{};
+    const ping message{ 42 };
+    const auto cached = instance.serialize(message, 1, level::bip31);
+    const auto expected = messages::serialize(message, 1, level::bip31);
+    BOOST_REQUIRE(cached);
+    BOOST_REQUIRE(expected);
+    BOOST_REQUIRE_EQUAL(*cached, *expected);
+}
+
+BOOST_AUTO_TEST_CASE(wire_cache__serialize__witness_ignored__shared_chunk)
+{
+    wire_cache instance{};
+    const ping message{ 42 };
+    const auto first = instance.serialize(message, 1, level::bip31, true);
+    const auto second = instance.serialize(message, 1, level::bip31, false);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE_EQUAL(first.get(), second.get());
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+}
+
+BOOST_AUTO_TEST_CASE(wire_cache__serialize__transaction_witness__distinct_chunks)
+{
+    wire_cache instance{};
+    const transaction message{ system::to_shared<system::chain::transaction>() };
+    const auto first = instance.serialize(message, 1, level::bip31, true);
+    const auto second = instance.serialize(message, 1, level::bip31, false);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE(second);
+    BOOST_REQUIRE_NE(first.get(), second.get());
+    BOOST_REQUIRE_EQUAL(instance.serialize(message, 1, level::bip31, false).get(),
+        second.get());
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -157,7 +157,59 @@ BOOST_AUTO_TEST_CASE(p2p__network_settings__unstarted__expected)
     BOOST_REQUIRE_EQUAL(set.threads, 1u);
 
     p2p net(set, log);
-    BOOST_REQUIRE_EQUAL(net.network_settings().threads, 1u);
+    BOOST_REQUIRE_EQUAL(net.network_settings()->threads, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(p2p__reload__unstarted__snapshot_reloaded)
+{
+    const logger log{};
+    const settings set(selection::mainnet);
+    p2p net(set, log);
+
+    settings update(selection::mainnet);
+    update.inbound_connections = 42;
+    update.threads = 7;
+    net.reload(update);
+    BOOST_REQUIRE_EQUAL(net.network_settings()->inbound_connections, 42u);
+    BOOST_REQUIRE_EQUAL(net.network_settings()->threads, set.threads);
+    BOOST_REQUIRE_NE(set.inbound_connections, 42u);
+}
+
+BOOST_AUTO_TEST_CASE(p2p__reload__replaced_snapshot__released)
+{
+    const logger log{};
+    const settings set(selection::mainnet);
+    p2p net(set, log);
+    BOOST_REQUIRE(!net.network_settings()->retain());
+
+    const settings update(selection::mainnet);
+    net.reload(update);
+    const std::weak_ptr<const settings> first{ net.network_settings() };
+    BOOST_REQUIRE(!first.expired());
+
+    net.reload(update);
+    BOOST_REQUIRE(first.expired());
+}
+
+BOOST_AUTO_TEST_CASE(p2p__reload__channel_snapshot__retained)
+{
+    const logger log{};
+    const settings set(selection::mainnet);
+    p2p net(set, log);
+
+    const settings update(selection::mainnet);
+    net.reload(update);
+    const std::weak_ptr<const settings> first{ net.network_settings() };
+    const auto socket = std::make_shared<network::socket>(log, net.service(),
+        config::endpoint{ "42.42.42.42:42" }.to_address());
+    const auto channel = std::make_shared<network::channel>(log, socket,
+        *net.network_settings(), net.resources(), 42);
+
+    net.reload(update);
+    BOOST_REQUIRE(!first.expired());
+    BOOST_REQUIRE(&channel->settings() == first.lock().get());
+    BOOST_REQUIRE(&channel->settings() != net.network_settings().get());
+    channel->stop(error::service_stopped);
 }
 
 BOOST_AUTO_TEST_CASE(p2p__address_count__unstarted__zero)
@@ -168,6 +220,40 @@ BOOST_AUTO_TEST_CASE(p2p__address_count__unstarted__zero)
     BOOST_REQUIRE_EQUAL(net.address_count(), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(p2p__banned_count__unstarted__zero)
+{
+    const logger log{};
+    const settings set(selection::mainnet);
+    p2p net(set, log);
+    BOOST_REQUIRE_EQUAL(net.banned_count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(p2p__misbehaved__exempt_authorities__not_banned)
+{
+    const logger log{};
+    settings set(selection::mainnet);
+    set.peers.emplace_back("43.43.43.43:43");
+    set.whitelists.emplace_back("44.44.44.44");
+    set.initialize();
+    p2p net(set, log);
+
+    const auto misbehave = [&](const std::string& endpoint) NOEXCEPT
+    {
+        const auto socket = std::make_shared<network::socket>(log,
+            net.service(), config::endpoint{ endpoint }.to_address());
+        const auto channel = std::make_shared<network::channel>(log, socket,
+            set, net.resources(), 42);
+        net.misbehaved(*channel, error::invalid_magic);
+        channel->stop(error::service_stopped);
+        return net.banned_count();
+    };
+
+    BOOST_REQUIRE_EQUAL(misbehave("127.0.0.1:42"), 0u);
+    BOOST_REQUIRE_EQUAL(misbehave("43.43.43.43:43"), 0u);
+    BOOST_REQUIRE_EQUAL(misbehave("44.44.44.44:44"), 0u);
+    BOOST_REQUIRE_EQUAL(misbehave("42.42.42.42:42"), 1u);
+}
+
 BOOST_AUTO_TEST_CASE(p2p__channel_count__unstarted__zero)
 {
     const logger log{};
@@ -176,6 +262,31 @@ BOOST_AUTO_TEST_CASE(p2p__channel_count__unstarted__zero)
     BOOST_REQUIRE_EQUAL(net.channel_count(), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(p2p__compute__zero_threads__network_service)
+{
+    const logger log{};
+    const settings set(selection::mainnet);
+    p2p net(set, log);
+    BOOST_REQUIRE_EQUAL(&net.compute(), &net.service());
+}
+
+BOOST_AUTO_TEST_CASE(p2p__compute__threads__distinct_service_runs_work)
+{
+    const logger log{};
+    settings set(selection::mainnet);
+    set.compute_threads = 2;
+    p2p net(set, log);
+    BOOST_REQUIRE_NE(&net.compute(), &net.service());
+
+    std::promise<bool> ran;
+    boost::asio::post(net.compute(), [&ran]() NOEXCEPT
+    {
+        ran.set_value(true);
+    });
+
+    BOOST_REQUIRE(ran.get_future().get());
+}
+
 BOOST_AUTO_TEST_CASE(p2p__connect__unstarted__service_stopped)
 {
     const logger log{};
@@ -318,6 +429,55 @@ BOOST_AUTO_TEST_CASE(p2p__subscribe_close__unclosed___success)
     BOOST_REQUIRE_EQUAL(promise_handler.get_future().get(), error::service_stopped);
 }
 
+BOOST_AUTO_TEST_CASE(p2p__close__shared_threads__networks_stopped)
+{
+    const logger log{};
+    const settings mainnet(selection::mainnet);
+    const settings testnet(selection::testnet);
+    thread_context threads{ 2 };
+    p2p main(mainnet, log, threads);
+    p2p test(testnet, log, threads);
+    BOOST_REQUIRE(main.resources() != test.resources());
+
+    std::promise<code> main_stopped;
+    std::promise<code> test_stopped;
+    const auto subscribe = [](p2p& net, std::promise<code>& stopped) NOEXCEPT
+    {
+        std::promise<code> complete;
+        net.subscribe_close([&stopped](const code& ec) NOEXCEPT
+        {
+            stopped.set_value(ec);
+            return true;
+        },
+        [&complete](const code& ec, p2p::object_key) NOEXCEPT
+        {
+            complete.set_value(ec);
+        });
+
+        return complete.get_future().get();
+    };
+
+    BOOST_REQUIRE_EQUAL(subscribe(main, main_stopped), error::success);
+    BOOST_REQUIRE_EQUAL(subscribe(test, test_stopped), error::success);
+
+    // Closing one network does not stop the shared threads.
+    main.close();
+    BOOST_REQUIRE_EQUAL(main_stopped.get_future().get(), error::service_stopped);
+
+    std::promise<bool> running;
+    boost::asio::post(test.strand(), [&running]() NOEXCEPT
+    {
+        running.set_value(true);
+    });
+
+    BOOST_REQUIRE(running.get_future().get());
+
+    test.close();
+    BOOST_REQUIRE_EQUAL(test_stopped.get_future().get(), error::service_stopped);
+    threads.stop();
+    BOOST_REQUIRE(threads.join());
+}
+
 BOOST_AUTO_TEST_CASE(p2p__start__outbound_connections_but_no_peers_no_seeds__seeding_unsuccessful)
 {
     const logger log{};
@@ -326,8 +486,8 @@ BOOST_AUTO_TEST_CASE(p2p__start__outbound_connections_but_no_peers_no_seeds__see
     BOOST_REQUIRE(set.peers.empty());
 
     p2p net(set, log);
-    BOOST_REQUIRE(net.network_settings().peers.empty());
-    BOOST_REQUIRE(net.network_settings().seeds.empty());
+    BOOST_REQUIRE(net.network_settings()->peers.empty());
+    BOOST_REQUIRE(net.network_settings()->seeds.empty());
 
     std::promise<code> promise;
     const auto handler = [&](const code& ec) NOEXCEPT
@@ -365,8 +525,8 @@ BOOST_AUTO_TEST_CASE(p2p__run__started_no_outbound_connections__success)
     BOOST_REQUIRE(set.peers.empty());
 
     p2p net(set, log);
-    BOOST_REQUIRE(net.network_settings().peers.empty());
-    BOOST_REQUIRE(net.network_settings().seeds.empty());
+    BOOST_REQUIRE(net.network_settings()->peers.empty());
+    BOOST_REQUIRE(net.network_settings()->seeds.empty());
 
     std::promise<code> promise_run;
     const auto run_handler = [&](const code& ec) NOEXCEPT
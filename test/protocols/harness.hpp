@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_TEST_PROTOCOLS_HARNESS_HPP
+#define LIBBITCOIN_NETWORK_TEST_PROTOCOLS_HARNESS_HPP
+
+#include "../test.hpp"
+
+#include <future>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// Protocols are attached to unconnected channels of an unstarted network.
+// Sends of a channel are held for delivery (by the test) to a peer channel,
+// so that the protocols of two channels converse as peers, one message batch
+// at a time. Handlers are invoked on the channel strand by run().
+
+namespace test {
+
+// Post the handler to the strand and wait for its completion.
+template <typename Handler>
+void run(network::asio::strand& strand, Handler&& handler)
+{
+    std::promise<bool> complete{};
+    boost::asio::post(strand, [&]() NOEXCEPT
+    {
+        handler();
+        complete.set_value(true);
+    });
+
+    complete.get_future().get();
+}
+
+// A session that is not started, for attachment of protocols.
+class protocol_session
+  : public network::session
+{
+public:
+    protocol_session(network::p2p& network) NOEXCEPT
+      : session(network, 1)
+    {
+    }
+};
+
+// A channel that holds its sends and notifies messages as if read.
+class peer_channel
+  : public network::channel
+{
+public:
+    typedef std::shared_ptr<peer_channel> ptr;
+
+    using channel::channel;
+
+    // Notify a message as if read from the peer (requires strand).
+    template <class Message>
+    code receive(const Message& message) NOEXCEPT
+    {
+        return deliver(network::messages::serialize(message, protocol_magic(),
+            version()));
+    }
+
+    // Notify a serialized message as if read from the peer (requires strand).
+    code deliver(const system::chunk_ptr& wire) NOEXCEPT
+    {
+        return notify(identify(*wire), version(),
+            system::to_shared(payload(*wire)), {});
+    }
+
+    // Messages of the type sent to the peer, in order (requires strand).
+    template <class Message>
+    std::vector<typename Message::cptr> sent() const NOEXCEPT
+    {
+        std::vector<typename Message::cptr> out{};
+        for (const auto& wire: history_)
+            if (identify(*wire) == Message::id)
+                out.push_back(network::messages::deserialize<Message>(
+                    payload(*wire), version()));
+
+        return out;
+    }
+
+    // The number of messages sent to the peer (requires strand).
+    size_t sends() const NOEXCEPT
+    {
+        return history_.size();
+    }
+
+    // Take the messages sent since the last take (requires strand).
+    std::vector<system::chunk_ptr> take() NOEXCEPT
+    {
+        auto out = std::move(pending_);
+        pending_.clear();
+        return out;
+    }
+
+protected:
+    void write(const system::chunk_ptr& wire,
+        const result_handler& handler) NOEXCEPT override
+    {
+        history_.push_back(wire);
+        pending_.push_back(wire);
+        handler(error::success);
+    }
+
+private:
+    static network::messages::identifier identify(
+        const system::data_chunk& wire) NOEXCEPT
+    {
+        using namespace network::messages;
+        const auto command = std::next(wire.begin(), sizeof(uint32_t));
+        return heading::id(system::data_chunk(command,
+            std::next(command, heading::command_size)));
+    }
+
+    static system::data_chunk payload(const system::data_chunk& wire) NOEXCEPT
+    {
+        using namespace network::messages;
+        return system::data_chunk(std::next(wire.begin(), heading::size()),
+            wire.end());
+    }
+
+    std::vector<system::chunk_ptr> history_{};
+    std::vector<system::chunk_ptr> pending_{};
+};
+
+// An unconnected inbound or outbound channel of the session. A channel that
+// is not quiet has the known inventory filter (of announce_capacity).
+inline peer_channel::ptr make_channel(network::p2p& network,
+    const network::session& session, bool outbound, bool quiet=true)
+{
+    const auto socket = outbound ?
+        std::make_shared<network::socket>(network.log, network.service(),
+            network::config::endpoint{ "42.42.42.42:42" }.to_address()) :
+        std::make_shared<network::socket>(network.log, network.service());
+
+    return std::make_shared<peer_channel>(network.log, socket,
+        *session.settings(), network.resources(), 42, quiet);
+}
+
+// Deliver the sends of each channel to the other until neither sends.
+inline void exchange(const peer_channel::ptr& left,
+    const peer_channel::ptr& right)
+{
+    for (auto quiet = false; !quiet;)
+    {
+        std::vector<system::chunk_ptr> lefts{};
+        std::vector<system::chunk_ptr> rights{};
+        run(left->strand(), [&]() { lefts = left->take(); });
+        run(right->strand(), [&]()
+        {
+            for (const auto& wire: lefts)
+                right->deliver(wire);
+
+            rights = right->take();
+        });
+        run(left->strand(), [&]()
+        {
+            for (const auto& wire: rights)
+                left->deliver(wire);
+        });
+
+        quiet = lefts.empty() && rights.empty();
+    }
+}
+
+// Stop the channel, and so its protocols.
+inline void stop(const peer_channel::ptr& channel)
+{
+    run(channel->strand(), [&]() { channel->stop(error::service_stopped); });
+}
+
+} // namespace test
+
+#endif
@@ -142,8 +142,9 @@ class mock_connector
 {
 public:
     mock_connector(const logger& log, asio::strand& strand,
-        asio::io_context& service, const settings& settings) NOEXCEPT
-      : connector(log, strand, service, settings), stopped_(false)
+        asio::io_context& service, const settings& settings,
+        const resources::ptr& shared) NOEXCEPT
+      : connector(log, strand, service, settings, shared), stopped_(false)
     {
     }
 
@@ -182,14 +183,14 @@ public:
     acceptor::ptr create_acceptor() NOEXCEPT override
     {
         return std::make_shared<mock_acceptor>(log, strand(), service(),
-            network_settings());
+            *network_settings());
     }
 
     // Create mock connector to inject mock channel.
     connector::ptr create_connector() NOEXCEPT override
     {
         return std::make_shared<mock_connector>(log, strand(), service(),
-            network_settings());
+            *network_settings(), resources());
     }
 };
 
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_bloom_filter_70001_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+// A channel with an attached (started) bloom filter protocol.
+struct bloom_peer
+{
+    bloom_peer() NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, false))
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            protocol = channel->attach<protocol_bloom_filter_70001>(*session);
+            protocol->start();
+        });
+    }
+
+    ~bloom_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    template <class Message>
+    code receive(const Message& message) NOEXCEPT
+    {
+        code ec{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            ec = channel->receive(message);
+        });
+
+        return ec;
+    }
+
+    // Invoke on the strand, returning the result.
+    template <typename Handler>
+    auto on_strand(Handler&& handler) NOEXCEPT
+    {
+        decltype(handler()) out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = handler();
+        });
+
+        return out;
+    }
+
+    const settings configuration{ chain::selection::mainnet };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    protocol_bloom_filter_70001::ptr protocol{};
+};
+
+static chain::transaction make_transaction(uint8_t seed) NOEXCEPT
+{
+    return
+    {
+        1u,
+        chain::inputs
+        {
+            chain::input{ chain::point{ hash_digest{ seed }, 0u },
+                chain::script{}, 0u }
+        },
+        chain::outputs{},
+        0u
+    };
+}
+
+// An empty (valid) filter of 800 bits and ten hash functions.
+static const bloom_filter_load empty_load{ data_chunk(100), 10, 42, 0 };
+
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__match__unfiltered__true)
+{
+    bloom_peer peer{};
+    const auto tx = make_transaction(1);
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.protocol->filtered(); }));
+    BOOST_REQUIRE(peer.on_strand([&]() { return peer.protocol->match(tx); }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__receive_load_add__txid__matched)
+{
+    bloom_peer peer{};
+    const auto tx = make_transaction(1);
+    const auto other = make_transaction(2);
+    peer.receive(empty_load);
+    BOOST_REQUIRE(peer.on_strand([&]() { return peer.protocol->filtered(); }));
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.protocol->match(tx); }));
+
+    peer.receive(bloom_filter_add{ to_chunk(tx.hash(false)) });
+    BOOST_REQUIRE(peer.on_strand([&]() { return peer.protocol->match(tx); }));
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.protocol->match(other); }));
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.channel->stopped(); }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__receive_clear__loaded__unfiltered)
+{
+    bloom_peer peer{};
+    const auto tx = make_transaction(1);
+    peer.receive(empty_load);
+    peer.receive(bloom_filter_clear{});
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.protocol->filtered(); }));
+    BOOST_REQUIRE(peer.on_strand([&]() { return peer.protocol->match(tx); }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__match_block__unfiltered__all_matched)
+{
+    bloom_peer peer{};
+    const chain::block block
+    {
+        chain::header{ 1u, null_hash, null_hash, 0u, 0u, 0u },
+        chain::transactions{ make_transaction(1), make_transaction(2) }
+    };
+
+    bloom_filter::indexes matched{};
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        peer.protocol->match(matched, block);
+    });
+
+    BOOST_REQUIRE(matched == bloom_filter::indexes({ 0u, 1u }));
+}
+
+// Oversized messages are rejected by deserialization (before the protocol).
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__receive_load__oversized__unloaded)
+{
+    bloom_peer peer{};
+    BOOST_REQUIRE(peer.receive(bloom_filter_load{ data_chunk(36'001), 10, 0, 0 }));
+    BOOST_REQUIRE(peer.receive(bloom_filter_load{ data_chunk(100), 51, 0, 0 }));
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.protocol->filtered(); }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__receive_add__unloaded__stopped)
+{
+    bloom_peer peer{};
+    peer.receive(bloom_filter_add{ data_chunk(32) });
+    BOOST_REQUIRE(peer.on_strand([&]() { return peer.channel->stopped(); }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_bloom_filter_70001__receive_add__oversized_element__rejected)
+{
+    bloom_peer peer{};
+    const auto tx = make_transaction(1);
+    peer.receive(empty_load);
+    BOOST_REQUIRE(peer.receive(bloom_filter_add{ data_chunk(521) }));
+    BOOST_REQUIRE(!peer.on_strand([&]() { return peer.protocol->match(tx); }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_client_filter_70015_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+// Distinct hashes of the height, tagged by their first byte.
+static hash_digest to_hash(uint8_t tag, size_t height) NOEXCEPT
+{
+    hash_digest out{ tag };
+    out.at(1) = static_cast<uint8_t>(height);
+    out.at(2) = static_cast<uint8_t>(height >> byte_bits);
+    return out;
+}
+
+// A confirmed chain of basic (type zero) filters, to the top height.
+class filter_store
+  : public protocol_client_filter_70015::store
+{
+public:
+    filter_store(size_t top) NOEXCEPT
+      : top_(top)
+    {
+    }
+
+    bool get_height(size_t& out, const hash_digest& block) const NOEXCEPT
+        override
+    {
+        out = block.at(1) + (size_t{ block.at(2) } << byte_bits);
+        return block.at(0) == block_tag && out <= top_ &&
+            to_hash(block_tag, out) == block;
+    }
+
+    bool get_hash(hash_digest& out, size_t height) const NOEXCEPT override
+    {
+        out = to_hash(block_tag, height);
+        return height <= top_;
+    }
+
+    bool get_filter(data_chunk& out, uint8_t type,
+        const hash_digest& block) const NOEXCEPT override
+    {
+        size_t height{};
+        if (!is_zero(type) || !get_height(height, block))
+            return false;
+
+        out = { static_cast<uint8_t>(height) };
+        return true;
+    }
+
+    bool get_filter_header(filter_cache::header& out, uint8_t type,
+        const hash_digest& block) const NOEXCEPT override
+    {
+        size_t height{};
+        if (!is_zero(type) || !get_height(height, block))
+            return false;
+
+        ++reads;
+        out = { to_hash(0xfa, height), to_hash(0xfb, height) };
+        return true;
+    }
+
+    static constexpr uint8_t block_tag = 0xff;
+    mutable size_t reads{};
+
+private:
+    const size_t top_;
+};
+
+// A channel with an attached (started) client filter protocol.
+struct filter_peer
+{
+    filter_peer(size_t top) NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, false)),
+        filters(top)
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->attach<protocol_client_filter_70015>(*session, filters,
+                cache)->start();
+        });
+    }
+
+    ~filter_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    template <class Message>
+    void receive(const Message& message) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->receive(message);
+        });
+    }
+
+    template <class Message>
+    std::vector<typename Message::cptr> sent() NOEXCEPT
+    {
+        std::vector<typename Message::cptr> out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->sent<Message>();
+        });
+
+        return out;
+    }
+
+    bool stopped() NOEXCEPT
+    {
+        auto out = false;
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->stopped();
+        });
+
+        return out;
+    }
+
+    const settings configuration{ chain::selection::mainnet };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    filter_store filters;
+    filter_cache cache{ 100 };
+};
+
+static hash_digest block(size_t height) NOEXCEPT
+{
+    return to_hash(filter_store::block_tag, height);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filters__range__streamed_in_order)
+{
+    filter_peer peer(10);
+    peer.receive(get_client_filters{ 0, 2, block(4) });
+
+    const auto filters = peer.sent<client_filter>();
+    BOOST_REQUIRE_EQUAL(filters.size(), 3u);
+    for (size_t index = 0; index < filters.size(); ++index)
+    {
+        BOOST_REQUIRE_EQUAL(filters.at(index)->filter_type, 0u);
+        BOOST_REQUIRE_EQUAL(filters.at(index)->block_hash, block(index + 2u));
+        BOOST_REQUIRE(filters.at(index)->filter ==
+            data_chunk{ static_cast<uint8_t>(index + 2u) });
+    }
+
+    BOOST_REQUIRE(!peer.stopped());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filters__unknown_stop__ignored)
+{
+    filter_peer peer(10);
+    peer.receive(get_client_filters{ 0, 2, block(11) });
+    BOOST_REQUIRE(peer.sent<client_filter>().empty());
+    BOOST_REQUIRE(!peer.stopped());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filters__inverted__stopped)
+{
+    filter_peer peer(10);
+    peer.receive(get_client_filters{ 0, 5, block(4) });
+    BOOST_REQUIRE(peer.sent<client_filter>().empty());
+    BOOST_REQUIRE(peer.stopped());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filters__oversized__stopped)
+{
+    filter_peer peer(1'000);
+    peer.receive(get_client_filters{ 0, 0, block(1'000) });
+    BOOST_REQUIRE(peer.sent<client_filter>().empty());
+    BOOST_REQUIRE(peer.stopped());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filter_headers__range__previous_and_hashes)
+{
+    filter_peer peer(10);
+    peer.receive(get_client_filter_headers{ 0, 3, block(5) });
+
+    const auto responses = peer.sent<client_filter_headers>();
+    BOOST_REQUIRE_EQUAL(responses.size(), 1u);
+    const auto& response = *responses.front();
+    BOOST_REQUIRE_EQUAL(response.stop_hash, block(5));
+    BOOST_REQUIRE_EQUAL(response.previous_filter_header, to_hash(0xfb, 2));
+    BOOST_REQUIRE(response.filter_hashes ==
+        hashes({ to_hash(0xfa, 3), to_hash(0xfa, 4), to_hash(0xfa, 5) }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filter_headers__genesis__null_previous)
+{
+    filter_peer peer(10);
+    peer.receive(get_client_filter_headers{ 0, 0, block(1) });
+
+    const auto responses = peer.sent<client_filter_headers>();
+    BOOST_REQUIRE_EQUAL(responses.size(), 1u);
+    BOOST_REQUIRE_EQUAL(responses.front()->previous_filter_header, null_hash);
+    BOOST_REQUIRE_EQUAL(responses.front()->filter_hashes.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_client_filter_70015__get_client_filter_checkpoint__repeated__cached)
+{
+    filter_peer peer(2'500);
+    peer.receive(get_client_filter_checkpoint{ 0, block(2'500) });
+    peer.receive(get_client_filter_checkpoint{ 0, block(2'500) });
+
+    const auto checkpoints = peer.sent<client_filter_checkpoint>();
+    BOOST_REQUIRE_EQUAL(checkpoints.size(), 2u);
+    BOOST_REQUIRE(checkpoints.front()->filter_headers ==
+        hashes({ to_hash(0xfb, 1'000), to_hash(0xfb, 2'000) }));
+    BOOST_REQUIRE(checkpoints.back()->filter_headers ==
+        checkpoints.front()->filter_headers);
+
+    // The second is served from the cache, without store reads.
+    BOOST_REQUIRE_EQUAL(peer.filters.reads, 2u);
+    BOOST_REQUIRE_EQUAL(peer.cache.checkpoints(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
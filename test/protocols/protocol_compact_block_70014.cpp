@@ -0,0 +1,288 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_compact_block_70014_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+// Pool candidates are fixed by the test, accepted blocks are retained.
+class compact_pool
+  : public protocol_compact_block_70014::pool
+{
+public:
+    chain::transaction_cptrs candidates() const NOEXCEPT override
+    {
+        return transactions;
+    }
+
+    void accept(const chain::block::cptr& block, uint64_t) NOEXCEPT override
+    {
+        blocks.push_back(block);
+    }
+
+    chain::transaction_cptrs transactions{};
+    std::vector<chain::block::cptr> blocks{};
+};
+
+// A channel with an attached (started) compact block protocol.
+struct compact_peer
+{
+    compact_peer(const settings& configuration) NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, true))
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            protocol = channel->attach<protocol_compact_block_70014>(*session,
+                transactions);
+            protocol->start();
+        });
+    }
+
+    ~compact_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    template <class Message>
+    void receive(const Message& message) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->receive(message);
+        });
+    }
+
+    template <class Message>
+    std::vector<typename Message::cptr> sent() NOEXCEPT
+    {
+        std::vector<typename Message::cptr> out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->sent<Message>();
+        });
+
+        return out;
+    }
+
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    compact_pool transactions{};
+    protocol_compact_block_70014::ptr protocol{};
+};
+
+static chain::transaction::cptr make_transaction(uint8_t seed) NOEXCEPT
+{
+    return to_shared<chain::transaction>(1u, chain::inputs
+    {
+        chain::input{ chain::point{ hash_digest{ seed }, 0u },
+            chain::script{}, 0u }
+    }, chain::outputs{}, 0u);
+}
+
+static compact_block make_block() NOEXCEPT
+{
+    return
+    {
+        to_shared<chain::header>(1u, null_hash, null_hash, 0u, 0u, 0u),
+        42u,
+        {},
+        {}
+    };
+}
+
+// The witness short id of the transaction, for the block.
+static compact_block::short_id to_id(const compact_block& block,
+    const chain::transaction& tx) NOEXCEPT
+{
+    const auto number = compact_block::to_short_id(block.key(), tx.hash(true));
+
+    compact_block::short_id out{};
+    for (size_t index = 0; index < out.size(); ++index)
+        out.at(index) = static_cast<uint8_t>(number >> (byte_bits * index));
+
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(protocol_compact_block_70014__start__default__low_bandwidth_announced)
+{
+    const settings set(chain::selection::mainnet);
+    compact_peer peer(set);
+
+    const auto announcements = peer.sent<send_compact>();
+    BOOST_REQUIRE_EQUAL(announcements.size(), 1u);
+    BOOST_REQUIRE(!announcements.front()->high_bandwidth);
+    BOOST_REQUIRE_EQUAL(announcements.front()->compact_version, 2u);
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(!peer.protocol->high_bandwidth());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(protocol_compact_block_70014__start__high_bandwidth__three_peers_until_stopped)
+{
+    settings set(chain::selection::mainnet);
+    set.compact_high_bandwidth = true;
+    const logger log{};
+    p2p net(set, log);
+    test::protocol_session session(net);
+    compact_pool transactions{};
+
+    // Each channel announces high bandwidth only if it obtained a slot.
+    const auto attach = [&](const test::peer_channel::ptr& channel) NOEXCEPT
+    {
+        auto high = false;
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            const auto protocol = channel->attach<
+                protocol_compact_block_70014>(session, transactions);
+            protocol->start();
+            high = channel->sent<send_compact>().front()->high_bandwidth;
+            BOOST_REQUIRE_EQUAL(protocol->high_bandwidth(), high);
+        });
+
+        return high;
+    };
+
+    std::vector<test::peer_channel::ptr> channels{};
+    for (size_t peer = 0; peer < 5u; ++peer)
+        channels.push_back(test::make_channel(net, session, true));
+
+    BOOST_REQUIRE(attach(channels.at(0)));
+    BOOST_REQUIRE(attach(channels.at(1)));
+    BOOST_REQUIRE(attach(channels.at(2)));
+    BOOST_REQUIRE(!attach(channels.at(3)));
+
+    // The stop of a high bandwidth channel releases its slot.
+    test::stop(channels.at(0));
+    test::run(channels.at(0)->strand(), []() NOEXCEPT {});
+    BOOST_REQUIRE(attach(channels.at(4)));
+
+    for (const auto& channel: channels)
+        test::stop(channel);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_compact_block_70014__receive_send_compact__versions__witness_preferred_unknown_ignored)
+{
+    const settings set(chain::selection::mainnet);
+    compact_peer peer(set);
+
+    peer.receive(send_compact{ true, 3u });
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(!peer.protocol->peer_compact());
+        BOOST_REQUIRE(!peer.protocol->peer_high_bandwidth());
+    });
+
+    peer.receive(send_compact{ true, 2u });
+    peer.receive(send_compact{ false, 1u });
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(peer.protocol->peer_compact());
+        BOOST_REQUIRE(peer.protocol->peer_high_bandwidth());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(protocol_compact_block_70014__receive_compact_block__prefilled_and_pool__accepted)
+{
+    const settings set(chain::selection::mainnet);
+    compact_peer peer(set);
+    const auto first = make_transaction(1);
+    const auto second = make_transaction(2);
+    peer.transactions.transactions = { make_transaction(3), second };
+
+    auto message = make_block();
+    message.transactions.push_back({ 0u, first });
+    message.short_ids.push_back(to_id(message, *second));
+    peer.receive(message);
+
+    BOOST_REQUIRE(peer.sent<get_compact_transactions>().empty());
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE_EQUAL(peer.transactions.blocks.size(), 1u);
+        const auto& txs = *peer.transactions.blocks.front()->transactions_ptr();
+        BOOST_REQUIRE_EQUAL(txs.size(), 2u);
+        BOOST_REQUIRE(txs.at(0) == first);
+        BOOST_REQUIRE(txs.at(1) == second);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(protocol_compact_block_70014__receive_compact_block__missing__requested_then_accepted)
+{
+    const settings set(chain::selection::mainnet);
+    compact_peer peer(set);
+    const auto first = make_transaction(1);
+    const auto second = make_transaction(2);
+    const auto third = make_transaction(3);
+
+    auto message = make_block();
+    message.transactions.push_back({ 0u, first });
+    message.short_ids.push_back(to_id(message, *second));
+    message.short_ids.push_back(to_id(message, *third));
+    peer.receive(message);
+
+    // Positions one and two are differentially encoded (as zero and zero).
+    const auto requests = peer.sent<get_compact_transactions>();
+    BOOST_REQUIRE_EQUAL(requests.size(), 1u);
+    BOOST_REQUIRE_EQUAL(requests.front()->block_hash, message.header_ptr->hash());
+    BOOST_REQUIRE(requests.front()->indexes == std::vector<uint64_t>({ 0u, 0u }));
+
+    // Unrequested transactions are ignored.
+    peer.receive(compact_transactions{ null_hash, { second, third } });
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(peer.transactions.blocks.empty());
+    });
+
+    peer.receive(compact_transactions{ message.header_ptr->hash(),
+        { second, third } });
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(!peer.channel->stopped());
+        BOOST_REQUIRE_EQUAL(peer.transactions.blocks.size(), 1u);
+        const auto& txs = *peer.transactions.blocks.front()->transactions_ptr();
+        BOOST_REQUIRE_EQUAL(txs.size(), 3u);
+        BOOST_REQUIRE(txs.at(0) == first);
+        BOOST_REQUIRE(txs.at(1) == second);
+        BOOST_REQUIRE(txs.at(2) == third);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(protocol_compact_block_70014__receive_compact_block__prefilled_out_of_range__stopped)
+{
+    const settings set(chain::selection::mainnet);
+    compact_peer peer(set);
+
+    auto message = make_block();
+    message.transactions.push_back({ 1u, make_transaction(1) });
+    peer.receive(message);
+
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(peer.channel->stopped());
+        BOOST_REQUIRE(peer.transactions.blocks.empty());
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
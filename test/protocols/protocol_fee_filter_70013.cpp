@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_fee_filter_70013_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+// A handshaken channel with an attached (started) fee filter protocol.
+struct fee_peer
+{
+    fee_peer() NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, true))
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->set_peer_version(to_shared<messages::version>());
+            channel->attach<protocol_fee_filter_70013>(*session)->start();
+        });
+    }
+
+    ~fee_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    void receive(uint64_t rate) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->receive(fee_filter{ rate });
+        });
+    }
+
+    uint64_t rate() NOEXCEPT
+    {
+        uint64_t out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->fee_filter();
+        });
+
+        return out;
+    }
+
+    const settings configuration{ chain::selection::mainnet };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+};
+
+BOOST_AUTO_TEST_CASE(protocol_fee_filter_70013__start__no_filter__zero)
+{
+    fee_peer peer{};
+    BOOST_REQUIRE(is_zero(peer.rate()));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_fee_filter_70013__receive_fee_filter__rate__recorded)
+{
+    fee_peer peer{};
+    peer.receive(1'000);
+    BOOST_REQUIRE_EQUAL(peer.rate(), 1'000u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_fee_filter_70013__receive_fee_filter__repeated__replaced)
+{
+    fee_peer peer{};
+    peer.receive(1'000);
+    peer.receive(500);
+    BOOST_REQUIRE_EQUAL(peer.rate(), 500u);
+
+    peer.receive(0);
+    BOOST_REQUIRE(is_zero(peer.rate()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_fetch_31402_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+// Accepted items are retained.
+class fetch_sink
+  : public protocol_fetch_31402::sink
+{
+public:
+    void accept(const chain::block::cptr& block, uint64_t) NOEXCEPT override
+    {
+        blocks.push_back(block);
+    }
+
+    void accept(const chain::transaction::cptr& tx, uint64_t) NOEXCEPT
+        override
+    {
+        transactions.push_back(tx);
+    }
+
+    std::vector<chain::block::cptr> blocks{};
+    chain::transaction_cptrs transactions{};
+};
+
+static chain::transaction::cptr make_transaction(uint8_t seed) NOEXCEPT
+{
+    return to_shared<chain::transaction>(1u, chain::inputs
+    {
+        chain::input{ chain::point{ hash_digest{ seed }, 0u },
+            chain::script{}, 0u }
+    }, chain::outputs{}, 0u);
+}
+
+static inventory_item to_item(const chain::transaction& tx) NOEXCEPT
+{
+    return { inventory_item::type_id::transaction, tx.hash(false) };
+}
+
+// A channel with an attached fetch protocol, started after enqueue.
+struct fetch_peer
+{
+    fetch_peer(const inventory_items& items) NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, true))
+    {
+        scheduler.enqueue(items);
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->attach<protocol_fetch_31402>(*session, scheduler,
+                items_)->start();
+        });
+    }
+
+    ~fetch_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    template <class Message>
+    void receive(const Message& message) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->receive(message);
+        });
+    }
+
+    // Items requested of the peer, in order.
+    inventory_items requested() NOEXCEPT
+    {
+        inventory_items out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            for (const auto& message: channel->sent<get_data>())
+                out.insert(out.end(), message->items.begin(),
+                    message->items.end());
+        });
+
+        return out;
+    }
+
+    const settings configuration{ chain::selection::mainnet };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    fetcher scheduler{ 2, seconds(3600) };
+    fetch_sink items_{};
+};
+
+BOOST_AUTO_TEST_CASE(protocol_fetch_31402__start__queued__window_requested)
+{
+    const auto first = make_transaction(1);
+    const auto second = make_transaction(2);
+    const auto third = make_transaction(3);
+    fetch_peer peer({ to_item(*first), to_item(*second), to_item(*third) });
+
+    const auto requested = peer.requested();
+    BOOST_REQUIRE_EQUAL(requested.size(), 2u);
+    BOOST_REQUIRE(requested.at(0) == to_item(*first));
+    BOOST_REQUIRE(requested.at(1) == to_item(*second));
+    BOOST_REQUIRE_EQUAL(peer.scheduler.in_flight(), 2u);
+    BOOST_REQUIRE_EQUAL(peer.scheduler.queued(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_fetch_31402__receive_transaction__requested__accepted_and_refilled)
+{
+    const auto first = make_transaction(1);
+    const auto second = make_transaction(2);
+    const auto third = make_transaction(3);
+    fetch_peer peer({ to_item(*first), to_item(*second), to_item(*third) });
+
+    peer.receive(transaction{ first });
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE_EQUAL(peer.items_.transactions.size(), 1u);
+        BOOST_REQUIRE_EQUAL(peer.items_.transactions.front()->hash(false),
+            first->hash(false));
+    });
+
+    const auto requested = peer.requested();
+    BOOST_REQUIRE_EQUAL(requested.size(), 3u);
+    BOOST_REQUIRE(requested.at(2) == to_item(*third));
+    BOOST_REQUIRE(is_zero(peer.scheduler.queued()));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_fetch_31402__receive_transaction__unrequested__ignored)
+{
+    const auto first = make_transaction(1);
+    fetch_peer peer({ to_item(*first) });
+
+    peer.receive(transaction{ make_transaction(2) });
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(peer.items_.transactions.empty());
+    });
+
+    BOOST_REQUIRE_EQUAL(peer.scheduler.in_flight(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_fetch_31402__receive_not_found__requested__requeued_for_others)
+{
+    const auto first = make_transaction(1);
+    fetch_peer peer({ to_item(*first) });
+
+    peer.receive(not_found{ { to_item(*first) } });
+    BOOST_REQUIRE(is_zero(peer.scheduler.in_flight()));
+    BOOST_REQUIRE_EQUAL(peer.scheduler.queued(), 1u);
+
+    // The item is not requested again of this channel.
+    BOOST_REQUIRE_EQUAL(peer.requested().size(), 1u);
+    BOOST_REQUIRE_EQUAL(peer.scheduler.request(43).size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_fetch_31402__stop__in_flight__requeued)
+{
+    const auto first = make_transaction(1);
+    const auto second = make_transaction(2);
+    fetch_peer peer({ to_item(*first), to_item(*second) });
+    BOOST_REQUIRE_EQUAL(peer.scheduler.in_flight(), 2u);
+
+    test::stop(peer.channel);
+    test::run(peer.channel->strand(), []() NOEXCEPT {});
+    BOOST_REQUIRE(is_zero(peer.scheduler.in_flight()));
+    BOOST_REQUIRE_EQUAL(peer.scheduler.queued(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
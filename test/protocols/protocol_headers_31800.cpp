@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_headers_31800_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+class accumulator
+  : public header_fetcher::sink
+{
+public:
+    void accept(size_t height,
+        const chain::header_cptrs& headers) NOEXCEPT override
+    {
+        heights.push_back(height);
+        count += headers.size();
+    }
+
+    std::vector<size_t> heights{};
+    size_t count{};
+};
+
+// Headers extending the previous hash, with their hashes.
+static chain::header_cptrs chain_of(const hash_digest& previous, size_t count,
+    hashes& out) NOEXCEPT
+{
+    chain::header_cptrs headers{};
+    auto parent = previous;
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto header = std::make_shared<const chain::header>(1u, parent,
+            null_hash, possible_narrow_cast<uint32_t>(index), 0u, 0u);
+        parent = header->hash();
+        out.push_back(parent);
+        headers.push_back(header);
+    }
+
+    return headers;
+}
+
+static const hash_digest genesis{ 0x42 };
+
+// A channel with an attached headers protocol, started by start().
+struct headers_peer
+{
+    headers_peer() NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, true)),
+        block_headers(chain_of(genesis, 3, hashes_)),
+        scheduler({ { genesis, 0 }, { hashes_.back(), 3 } }, sink)
+    {
+    }
+
+    ~headers_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    void start() NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->attach<protocol_headers_31800>(*session,
+                scheduler)->start();
+        });
+    }
+
+    void receive(const chain::header_cptrs& value) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->receive(messages::headers{ value });
+        });
+    }
+
+    std::vector<get_headers::cptr> requests() NOEXCEPT
+    {
+        std::vector<get_headers::cptr> out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->sent<get_headers>();
+        });
+
+        return out;
+    }
+
+    bool stopped() NOEXCEPT
+    {
+        auto out = false;
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->stopped();
+        });
+
+        return out;
+    }
+
+    const settings configuration{ chain::selection::mainnet };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    hashes hashes_{};
+    chain::header_cptrs block_headers;
+    accumulator sink{};
+    header_fetcher scheduler;
+};
+
+BOOST_AUTO_TEST_CASE(protocol_headers_31800__start__ranges__first_requested)
+{
+    headers_peer peer{};
+    peer.start();
+
+    const auto requests = peer.requests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 1u);
+    BOOST_REQUIRE(requests.front()->start_hashes == hashes{ genesis });
+    BOOST_REQUIRE_EQUAL(requests.front()->stop_hash, peer.hashes_.back());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_headers_31800__receive_headers__range_complete__accepted_and_next_requested)
+{
+    headers_peer peer{};
+    peer.start();
+    peer.receive(peer.block_headers);
+
+    BOOST_REQUIRE_EQUAL(peer.sink.count, 3u);
+    BOOST_REQUIRE(!peer.stopped());
+
+    // The open range follows the completed range.
+    const auto requests = peer.requests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 2u);
+    BOOST_REQUIRE(requests.back()->start_hashes == hashes{ peer.hashes_.back() });
+    BOOST_REQUIRE_EQUAL(requests.back()->stop_hash, null_hash);
+    BOOST_REQUIRE_EQUAL(peer.scheduler.remaining(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_headers_31800__receive_headers__discontinuous__stopped_and_released)
+{
+    headers_peer peer{};
+    peer.start();
+
+    hashes ignore{};
+    peer.receive(chain_of(hash_digest{ 0x24 }, 3, ignore));
+    BOOST_REQUIRE(peer.stopped());
+    BOOST_REQUIRE(is_zero(peer.sink.count));
+
+    // The released range is available to another channel.
+    header_fetcher::range range{};
+    BOOST_REQUIRE(peer.scheduler.request(43, range));
+    BOOST_REQUIRE(range.start == genesis);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_headers_31800__receive_headers__unrequested__ignored)
+{
+    headers_peer peer{};
+
+    // All ranges are assigned to other channels, so none is requested.
+    header_fetcher::range range{};
+    BOOST_REQUIRE(peer.scheduler.request(43, range));
+    BOOST_REQUIRE(peer.scheduler.request(44, range));
+    peer.start();
+    BOOST_REQUIRE(peer.requests().empty());
+
+    peer.receive(peer.block_headers);
+    BOOST_REQUIRE(!peer.stopped());
+    BOOST_REQUIRE(is_zero(peer.sink.count));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
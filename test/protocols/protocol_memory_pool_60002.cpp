@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_memory_pool_60002_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+using entry = protocol_memory_pool_60002::entry;
+using entries = std::vector<entry>;
+
+// A mempool of fixed entries, each iteration starts a new cursor.
+class pool_source
+  : public protocol_memory_pool_60002::source
+{
+public:
+    class pool_cursor
+      : public protocol_memory_pool_60002::cursor
+    {
+    public:
+        pool_cursor(const entries& items) NOEXCEPT
+          : items_(items)
+        {
+        }
+
+        bool next(entry& out) NOEXCEPT override
+        {
+            if (position_ == items_.size())
+                return false;
+
+            out = items_.at(position_++);
+            return true;
+        }
+
+    private:
+        const entries& items_;
+        size_t position_{};
+    };
+
+    protocol_memory_pool_60002::cursor_ptr iterate() NOEXCEPT override
+    {
+        ++iterations;
+        return available ? std::make_unique<pool_cursor>(items) : nullptr;
+    }
+
+    entries items{};
+    bool available{ true };
+    size_t iterations{};
+};
+
+// Distinct txid and wtxid of the seed, with the fee rate.
+static entry make_entry(size_t seed, uint64_t fee_rate=0) NOEXCEPT
+{
+    entry out{};
+    out.hash.at(0) = 0x01;
+    out.witness_hash.at(0) = 0x02;
+    out.hash.at(1) = out.witness_hash.at(1) = static_cast<uint8_t>(seed);
+    out.hash.at(2) = out.witness_hash.at(2) =
+        static_cast<uint8_t>(seed >> byte_bits);
+    out.hash.at(3) = out.witness_hash.at(3) =
+        static_cast<uint8_t>(seed >> (2u * byte_bits));
+    out.fee_rate = fee_rate;
+    return out;
+}
+
+// Announcements are not trickled, and known inventory is tracked.
+static settings known_configuration() NOEXCEPT
+{
+    settings set(chain::selection::mainnet);
+    set.announce_capacity = 1'000;
+    set.trickle_milliseconds = 0;
+    return set;
+}
+
+// A handshaken channel with an attached (started) memory pool protocol.
+struct pool_peer
+{
+    pool_peer() NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, false, false))
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->set_peer_version(to_shared<messages::version>());
+            channel->attach<protocol_memory_pool_60002>(*session,
+                pool)->start();
+        });
+    }
+
+    ~pool_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    void request() NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->receive(memory_pool{});
+        });
+    }
+
+    std::vector<inventory::cptr> pages() NOEXCEPT
+    {
+        std::vector<inventory::cptr> out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->sent<inventory>();
+        });
+
+        return out;
+    }
+
+    const settings configuration{ known_configuration() };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    pool_source pool{};
+};
+
+BOOST_AUTO_TEST_CASE(protocol_memory_pool_60002__receive_memory_pool__entries__txids_announced)
+{
+    pool_peer peer{};
+    peer.pool.items = { make_entry(1), make_entry(2), make_entry(3) };
+    peer.request();
+
+    const auto pages = peer.pages();
+    BOOST_REQUIRE_EQUAL(pages.size(), 1u);
+    const auto& items = pages.front()->items;
+    BOOST_REQUIRE_EQUAL(items.size(), 3u);
+    for (size_t index = 0; index < items.size(); ++index)
+    {
+        BOOST_REQUIRE(items.at(index).type == inventory::type_id::transaction);
+        BOOST_REQUIRE_EQUAL(items.at(index).hash, make_entry(index + 1u).hash);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(protocol_memory_pool_60002__receive_memory_pool__wtxid_relay__wtxids_announced)
+{
+    pool_peer peer{};
+    peer.pool.items = { make_entry(1), make_entry(2) };
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        peer.channel->set_wtxid_relay(true);
+    });
+
+    peer.request();
+
+    const auto pages = peer.pages();
+    BOOST_REQUIRE_EQUAL(pages.size(), 1u);
+    const auto& items = pages.front()->items;
+    BOOST_REQUIRE_EQUAL(items.size(), 2u);
+    BOOST_REQUIRE(items.front().type == inventory::type_id::wtxid);
+    BOOST_REQUIRE_EQUAL(items.front().hash, make_entry(1).witness_hash);
+    BOOST_REQUIRE_EQUAL(items.back().hash, make_entry(2).witness_hash);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_memory_pool_60002__receive_memory_pool__fee_filter_and_known__omitted)
+{
+    pool_peer peer{};
+    peer.pool.items = { make_entry(1, 999), make_entry(2, 1'000),
+        make_entry(3, 2'000) };
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        peer.channel->set_fee_filter(1'000);
+        peer.channel->set_known(make_entry(3).hash);
+    });
+
+    peer.request();
+
+    const auto pages = peer.pages();
+    BOOST_REQUIRE_EQUAL(pages.size(), 1u);
+    BOOST_REQUIRE_EQUAL(pages.front()->items.size(), 1u);
+    BOOST_REQUIRE_EQUAL(pages.front()->items.front().hash,
+        make_entry(2).hash);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_memory_pool_60002__receive_memory_pool__over_page__paged)
+{
+    pool_peer peer{};
+    for (size_t seed = 0; seed <= max_inventory; ++seed)
+        peer.pool.items.push_back(make_entry(seed));
+
+    peer.request();
+
+    // Each page is sent upon completion of the prior (uncongested).
+    const auto pages = peer.pages();
+    BOOST_REQUIRE_EQUAL(pages.size(), 2u);
+    BOOST_REQUIRE_EQUAL(pages.front()->items.size(), max_inventory);
+    BOOST_REQUIRE_EQUAL(pages.back()->items.size(), 1u);
+    BOOST_REQUIRE_EQUAL(pages.back()->items.front().hash,
+        make_entry(max_inventory).hash);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_memory_pool_60002__receive_memory_pool__unavailable_or_empty__none)
+{
+    pool_peer peer{};
+    peer.pool.available = false;
+    peer.request();
+    BOOST_REQUIRE(peer.pages().empty());
+
+    peer.pool.available = true;
+    peer.request();
+    BOOST_REQUIRE(peer.pages().empty());
+    BOOST_REQUIRE_EQUAL(peer.pool.iterations, 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
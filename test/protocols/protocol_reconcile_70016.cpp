@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_reconcile_70016_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+class reconcile_accessor
+  : public protocol_reconcile_70016
+{
+public:
+    typedef std::shared_ptr<reconcile_accessor> ptr;
+
+    using protocol_reconcile_70016::protocol_reconcile_70016;
+
+    void add(const hash_digest& wtxid) NOEXCEPT override
+    {
+        protocol_reconcile_70016::add(wtxid);
+    }
+
+    // Start a round without waiting on the timer.
+    void reconcile() NOEXCEPT
+    {
+        handle_timer(error::success);
+    }
+};
+
+// Initiator (outbound) and responder (inbound) peers with the given sets.
+struct reconcile_peers
+{
+    reconcile_peers(const settings& configuration) NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        initiator(test::make_channel(net, *session, true)),
+        responder(test::make_channel(net, *session, false))
+    {
+        attach(initiator, outbound);
+        attach(responder, inbound);
+    }
+
+    ~reconcile_peers() NOEXCEPT
+    {
+        test::stop(initiator);
+        test::stop(responder);
+    }
+
+    void attach(const test::peer_channel::ptr& channel,
+        reconcile_accessor::ptr& protocol) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            channel->set_reconciliation(siphash_key{ 1, 2 });
+            protocol = channel->attach<reconcile_accessor>(*session);
+            protocol->start();
+        });
+    }
+
+    static void add(const test::peer_channel::ptr& channel,
+        const reconcile_accessor::ptr& protocol,
+        std::initializer_list<uint8_t> wtxids) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            for (const auto wtxid: wtxids)
+                protocol->add(hash_digest{ wtxid });
+        });
+    }
+
+    // Wtxids announced by the channel, in order.
+    static hashes announced(const test::peer_channel::ptr& channel) NOEXCEPT
+    {
+        hashes out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            for (const auto& message: channel->sent<inventory>())
+                for (const auto& item: message->items)
+                    if (item.type == inventory_item::type_id::wtxid)
+                        out.push_back(item.hash);
+        });
+
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    template <class Message>
+    static std::vector<typename Message::cptr> sent(
+        const test::peer_channel::ptr& channel) NOEXCEPT
+    {
+        std::vector<typename Message::cptr> out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->sent<Message>();
+        });
+
+        return out;
+    }
+
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr initiator;
+    test::peer_channel::ptr responder;
+    reconcile_accessor::ptr outbound{};
+    reconcile_accessor::ptr inbound{};
+};
+
+static settings configuration() NOEXCEPT
+{
+    settings set(chain::selection::mainnet);
+    set.reconciliation_flood_percent = 0;
+    set.reconciliation_seconds = 3600;
+    return set;
+}
+
+static hashes wtxids(std::initializer_list<uint8_t> values) NOEXCEPT
+{
+    hashes out{};
+    for (const auto value: values)
+        out.push_back(hash_digest{ value });
+
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(protocol_reconcile_70016__round_trip__within_capacity__exchanged)
+{
+    const auto set = configuration();
+    reconcile_peers peers(set);
+    peers.add(peers.initiator, peers.outbound, { 1, 2, 3, 4, 9 });
+    peers.add(peers.responder, peers.inbound, { 1, 2, 3, 4, 10 });
+    test::run(peers.initiator->strand(), [&]() NOEXCEPT
+    {
+        peers.outbound->reconcile();
+    });
+
+    test::exchange(peers.initiator, peers.responder);
+
+    // Capacity two (0 + 8191 * 5 / 32767 + 1) decodes the difference of two.
+    const auto sketches = peers.sent<reconciliation_sketch>(peers.responder);
+    BOOST_REQUIRE_EQUAL(sketches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(sketches.front()->sketch.size(), pin_sketch::serialized_size(2));
+    BOOST_REQUIRE(peers.sent<request_sketch_extension>(peers.initiator).empty());
+
+    const auto differences = peers.sent<reconciliation_difference>(peers.initiator);
+    BOOST_REQUIRE_EQUAL(differences.size(), 1u);
+    BOOST_REQUIRE(differences.front()->success);
+    BOOST_REQUIRE_EQUAL(differences.front()->short_ids.size(), 1u);
+
+    // Each announces only the transaction missing from the other.
+    BOOST_REQUIRE(peers.announced(peers.initiator) == wtxids({ 9 }));
+    BOOST_REQUIRE(peers.announced(peers.responder) == wtxids({ 10 }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_reconcile_70016__round_trip__over_capacity__extended)
+{
+    const auto set = configuration();
+    reconcile_peers peers(set);
+    peers.add(peers.initiator, peers.outbound, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+    peers.add(peers.responder, peers.inbound, { 1, 2, 3, 4, 5, 6, 7, 8, 12, 13 });
+    test::run(peers.initiator->strand(), [&]() NOEXCEPT
+    {
+        peers.outbound->reconcile();
+    });
+
+    test::exchange(peers.initiator, peers.responder);
+
+    // Capacity four (1 + 8191 * 10 / 32767 + 1) fails on the difference of
+    // five, and the extension of four more decodes it.
+    const auto sketches = peers.sent<reconciliation_sketch>(peers.responder);
+    BOOST_REQUIRE_EQUAL(sketches.size(), 2u);
+    BOOST_REQUIRE_EQUAL(sketches.front()->sketch.size(), pin_sketch::serialized_size(4));
+    BOOST_REQUIRE_EQUAL(sketches.back()->sketch.size(), pin_sketch::serialized_size(4));
+    BOOST_REQUIRE_EQUAL(peers.sent<request_sketch_extension>(peers.initiator).size(), 1u);
+
+    const auto differences = peers.sent<reconciliation_difference>(peers.initiator);
+    BOOST_REQUIRE_EQUAL(differences.size(), 1u);
+    BOOST_REQUIRE(differences.front()->success);
+    BOOST_REQUIRE_EQUAL(differences.front()->short_ids.size(), 2u);
+
+    BOOST_REQUIRE(peers.announced(peers.initiator) == wtxids({ 9, 10, 11 }));
+    BOOST_REQUIRE(peers.announced(peers.responder) == wtxids({ 12, 13 }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_reconcile_70016__round_trip__over_extension__flooded)
+{
+    const auto set = configuration();
+    reconcile_peers peers(set);
+    peers.add(peers.initiator, peers.outbound,
+        { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 });
+    peers.add(peers.responder, peers.inbound,
+        { 1, 2, 3, 4, 5, 6, 7, 8, 17, 18, 19, 20, 21, 22, 23, 24 });
+    test::run(peers.initiator->strand(), [&]() NOEXCEPT
+    {
+        peers.outbound->reconcile();
+    });
+
+    test::exchange(peers.initiator, peers.responder);
+
+    // The difference of sixteen exceeds the extended capacity of eight.
+    BOOST_REQUIRE_EQUAL(peers.sent<request_sketch_extension>(peers.initiator).size(), 1u);
+
+    const auto differences = peers.sent<reconciliation_difference>(peers.initiator);
+    BOOST_REQUIRE_EQUAL(differences.size(), 1u);
+    BOOST_REQUIRE(!differences.front()->success);
+
+    // Both flood their sets.
+    BOOST_REQUIRE(peers.announced(peers.initiator) ==
+        wtxids({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }));
+    BOOST_REQUIRE(peers.announced(peers.responder) ==
+        wtxids({ 1, 2, 3, 4, 5, 6, 7, 8, 17, 18, 19, 20, 21, 22, 23, 24 }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_reconcile_70016__receive_extension__unrequested__stopped)
+{
+    const auto set = configuration();
+    reconcile_peers peers(set);
+    test::run(peers.responder->strand(), [&]() NOEXCEPT
+    {
+        peers.responder->receive(request_sketch_extension{});
+    });
+
+    test::run(peers.responder->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(peers.responder->stopped());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(protocol_reconcile_70016__receive_sketch__unrequested__stopped)
+{
+    const auto set = configuration();
+    reconcile_peers peers(set);
+    test::run(peers.initiator->strand(), [&]() NOEXCEPT
+    {
+        peers.initiator->receive(reconciliation_sketch{});
+    });
+
+    test::run(peers.initiator->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(peers.initiator->stopped());
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
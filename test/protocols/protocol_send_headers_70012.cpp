@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "harness.hpp"
+
+BOOST_AUTO_TEST_SUITE(protocol_send_headers_70012_tests)
+
+using namespace bc::system;
+using namespace bc::network::messages;
+
+class send_headers_accessor
+  : public protocol_send_headers_70012
+{
+public:
+    typedef std::shared_ptr<send_headers_accessor> ptr;
+
+    using protocol_send_headers_70012::protocol_send_headers_70012;
+
+    // Invoke as if broadcast by the sender (the node for a new tip).
+    bool broadcast(const headers::cptr& message, uint64_t sender) NOEXCEPT
+    {
+        return handle_broadcast_headers(error::success, message, sender);
+    }
+};
+
+// Announcements are not trickled, and known inventory is tracked.
+static settings known_configuration() NOEXCEPT
+{
+    settings set(chain::selection::mainnet);
+    set.announce_capacity = 1'000;
+    set.trickle_milliseconds = 0;
+    return set;
+}
+
+// A channel (identifier 42) with an attached (started) protocol.
+struct headers_peer
+{
+    headers_peer() NOEXCEPT
+      : net(configuration, log),
+        session(std::make_shared<test::protocol_session>(net)),
+        channel(test::make_channel(net, *session, false, false))
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            protocol = channel->attach<send_headers_accessor>(*session);
+            protocol->start();
+        });
+    }
+
+    ~headers_peer() NOEXCEPT
+    {
+        test::stop(channel);
+    }
+
+    void broadcast(const headers::cptr& message, uint64_t sender=0) NOEXCEPT
+    {
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            BOOST_REQUIRE(protocol->broadcast(message, sender));
+        });
+    }
+
+    // Block hashes announced by inventory, in order.
+    hashes announced() NOEXCEPT
+    {
+        hashes out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            for (const auto& message: channel->sent<inventory>())
+                for (const auto& item: message->items)
+                    if (item.type == inventory_item::type_id::block)
+                        out.push_back(item.hash);
+        });
+
+        return out;
+    }
+
+    std::vector<headers::cptr> sent() NOEXCEPT
+    {
+        std::vector<headers::cptr> out{};
+        test::run(channel->strand(), [&]() NOEXCEPT
+        {
+            out = channel->sent<messages::headers>();
+        });
+
+        return out;
+    }
+
+    const settings configuration{ known_configuration() };
+    const logger log{};
+    p2p net;
+    std::shared_ptr<test::protocol_session> session;
+    test::peer_channel::ptr channel;
+    send_headers_accessor::ptr protocol{};
+};
+
+// Two headers extending a previous hash.
+static headers::cptr make_headers(uint8_t previous) NOEXCEPT
+{
+    const auto first = std::make_shared<const chain::header>(1u,
+        hash_digest{ previous }, null_hash, 0u, 0u, 0u);
+    const auto second = std::make_shared<const chain::header>(1u,
+        first->hash(), null_hash, 1u, 0u, 0u);
+    return std::make_shared<const headers>(headers{ { first, second } });
+}
+
+BOOST_AUTO_TEST_CASE(protocol_send_headers_70012__broadcast__not_requested__inventory_announced)
+{
+    headers_peer peer{};
+    const auto message = make_headers(1);
+    peer.broadcast(message);
+
+    BOOST_REQUIRE(peer.sent().empty());
+    BOOST_REQUIRE(peer.announced() == hashes(
+    {
+        message->header_ptrs.front()->hash(),
+        message->header_ptrs.back()->hash()
+    }));
+}
+
+BOOST_AUTO_TEST_CASE(protocol_send_headers_70012__broadcast__requested__headers_sent_once)
+{
+    headers_peer peer{};
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        BOOST_REQUIRE(!peer.protocol->peer_send_headers());
+        peer.channel->receive(send_headers{});
+        BOOST_REQUIRE(peer.protocol->peer_send_headers());
+    });
+
+    const auto message = make_headers(1);
+    peer.broadcast(message);
+    peer.broadcast(message);
+
+    const auto sent = peer.sent();
+    BOOST_REQUIRE_EQUAL(sent.size(), 1u);
+    BOOST_REQUIRE_EQUAL(sent.front()->header_ptrs.size(), 2u);
+    BOOST_REQUIRE_EQUAL(sent.front()->header_ptrs.back()->hash(),
+        message->header_ptrs.back()->hash());
+    BOOST_REQUIRE(peer.announced().empty());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_send_headers_70012__broadcast__own_or_empty__not_announced)
+{
+    headers_peer peer{};
+    peer.broadcast(make_headers(1), 42);
+    peer.broadcast(std::make_shared<const headers>(headers{}));
+
+    BOOST_REQUIRE(peer.sent().empty());
+    BOOST_REQUIRE(peer.announced().empty());
+}
+
+BOOST_AUTO_TEST_CASE(protocol_send_headers_70012__broadcast__known_tip__not_announced)
+{
+    headers_peer peer{};
+    const auto message = make_headers(1);
+    test::run(peer.channel->strand(), [&]() NOEXCEPT
+    {
+        peer.channel->set_known(message->header_ptrs.back()->hash());
+    });
+
+    peer.broadcast(message);
+    BOOST_REQUIRE(peer.announced().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
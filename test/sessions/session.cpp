@@ -223,9 +223,14 @@ public:
         handler(error::invalid_magic, {});
     }
 
-    void fetch(address_handler&& handler) NOEXCEPT override
+    void take(uint64_t, address_item_handler&& handler) NOEXCEPT override
     {
-        handler(error::bad_stream, {});
+        handler(error::invalid_magic, {});
+    }
+
+    void fetch(fetch_handler&& handler) NOEXCEPT override
+    {
+        handler(error::bad_stream, {}, {});
     }
 
     void restore(const address_item_cptr& address,
@@ -350,7 +355,7 @@ BOOST_AUTO_TEST_CASE(session__construct__always__expected_settings)
     set.threads = expected;
     p2p net(set, log);
     mock_session session(net, 1);
-    BOOST_REQUIRE_EQUAL(session.settings().threads, expected);
+    BOOST_REQUIRE_EQUAL(session.settings()->threads, expected);
 }
 
 // properties
@@ -429,7 +434,8 @@ BOOST_AUTO_TEST_CASE(session__fetch__always__calls_network)
     mock_session session(net, 1);
 
     std::promise<code> fetched;
-    session.fetch([&](const code& ec, const address_cptr&) NOEXCEPT
+    session.fetch([&](const code& ec, const address_cptr&,
+        const wire_cache::ptr&) NOEXCEPT
     {
         fetched.set_value(ec);
     });
@@ -586,7 +592,8 @@ BOOST_AUTO_TEST_CASE(session__start_channel__session_not_started__handlers_servi
     BOOST_REQUIRE(session->stopped());
 
     const auto socket = std::make_shared<network::socket>(net.log, net.service());
-    const auto channel = std::make_shared<mock_channel>(net.log, socket, session->settings(), 42);
+    const auto channel = std::make_shared<mock_channel>(net.log, socket,
+        *session->settings(), net.resources(), 42);
 
     std::promise<code> started_channel;
     std::promise<code> stopped_channel;
@@ -641,7 +648,8 @@ BOOST_AUTO_TEST_CASE(session__start_channel__channel_not_started__handlers_chann
     BOOST_REQUIRE_EQUAL(started.get_future().get(), error::success);
 
     const auto socket = std::make_shared<network::socket>(net.log, net.service());
-    const auto channel = std::make_shared<mock_channel>(net.log, socket, session->settings(), 42);
+    const auto channel = std::make_shared<mock_channel>(net.log, socket,
+        *session->settings(), net.resources(), 42);
 
     // Stop the channel (started by default).
     std::promise<bool> unstarted_channel;
@@ -730,7 +738,8 @@ BOOST_AUTO_TEST_CASE(session__start_channel__all_started__handlers_expected_chan
     BOOST_REQUIRE_EQUAL(started.get_future().get(), error::success);
 
     const auto socket = std::make_shared<network::socket>(net.log, net.service());
-    const auto channel = std::make_shared<mock_channel>(net.log, socket, session->settings(), 42);
+    const auto channel = std::make_shared<mock_channel>(net.log, socket,
+        *session->settings(), net.resources(), 42);
     
     std::promise<code> started_channel;
     std::promise<code> stopped_channel;
@@ -811,7 +820,8 @@ BOOST_AUTO_TEST_CASE(session__start_channel__outbound_all_started__handlers_expe
     BOOST_REQUIRE_EQUAL(started.get_future().get(), error::success);
 
     const auto socket = std::make_shared<network::socket>(net.log, net.service());
-    const auto channel = std::make_shared<mock_channel_no_read>(net.log, socket, session->settings(), 42);
+    const auto channel = std::make_shared<mock_channel_no_read>(net.log, socket,
+        *session->settings(), net.resources(), 42);
     
     std::promise<code> started_channel;
     std::promise<code> stopped_channel;
@@ -894,7 +904,8 @@ BOOST_AUTO_TEST_CASE(session__start_channel__inbound_all_started__handlers_expec
     BOOST_REQUIRE_EQUAL(started.get_future().get(), error::success);
 
     const auto socket = std::make_shared<network::socket>(net.log, net.service());
-    const auto channel = std::make_shared<mock_channel_no_read>(net.log, socket, session->settings(), 42);
+    const auto channel = std::make_shared<mock_channel_no_read>(net.log, socket,
+        *session->settings(), net.resources(), 42);
     
     std::promise<code> started_channel;
     std::promise<code> stopped_channel;
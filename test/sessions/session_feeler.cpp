@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(session_feeler_tests)
+
+using namespace bc::system::chain;
+
+class mock_session_feeler
+  : public session_feeler
+{
+public:
+    using session_feeler::session_feeler;
+
+    bool stopped() const NOEXCEPT override
+    {
+        return session_feeler::stopped();
+    }
+};
+
+// stop
+
+BOOST_AUTO_TEST_CASE(session_feeler__stop__stopped__stopped)
+{
+    const logger log{};
+    settings set(selection::mainnet);
+    p2p net(set, log);
+    mock_session_feeler session(net, 1);
+    BOOST_REQUIRE(session.stopped());
+
+    std::promise<bool> promise;
+    boost::asio::post(net.strand(), [&]() NOEXCEPT
+    {
+        session.stop();
+        promise.set_value(true);
+    });
+
+    BOOST_REQUIRE(promise.get_future().get());
+    BOOST_REQUIRE(session.stopped());
+}
+
+// start
+
+BOOST_AUTO_TEST_CASE(session_feeler__start__disabled__success_stopped)
+{
+    const logger log{};
+    settings set(selection::mainnet);
+    set.feeler_seconds = 0;
+    p2p net(set, log);
+    auto session = std::make_shared<mock_session_feeler>(net, 1);
+    BOOST_REQUIRE(session->stopped());
+
+    std::promise<code> started;
+    boost::asio::post(net.strand(), [=, &started]() NOEXCEPT
+    {
+        session->start([&](const code& ec) NOEXCEPT
+        {
+            started.set_value(ec);
+        });
+    });
+
+    BOOST_REQUIRE_EQUAL(started.get_future().get(), error::success);
+    BOOST_REQUIRE(session->stopped());
+}
+
+BOOST_AUTO_TEST_CASE(session_feeler__start__enabled__success_started)
+{
+    const logger log{};
+    settings set(selection::mainnet);
+    set.feeler_seconds = 120;
+    set.outbound_connections = 1;
+    set.host_pool_capacity = 1;
+    p2p net(set, log);
+    auto session = std::make_shared<mock_session_feeler>(net, 1);
+    BOOST_REQUIRE(session->stopped());
+
+    std::promise<code> started;
+    boost::asio::post(net.strand(), [=, &started]() NOEXCEPT
+    {
+        session->start([&](const code& ec) NOEXCEPT
+        {
+            started.set_value(ec);
+        });
+    });
+
+    BOOST_REQUIRE_EQUAL(started.get_future().get(), error::success);
+    BOOST_REQUIRE(!session->stopped());
+
+    std::promise<bool> stopped;
+    boost::asio::post(net.strand(), [=, &stopped]() NOEXCEPT
+    {
+        session->stop();
+        stopped.set_value(true);
+    });
+
+    BOOST_REQUIRE(stopped.get_future().get());
+    BOOST_REQUIRE(session->stopped());
+
+    // Block until the feeler deferral completes before clearing session.
+    net.close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -69,7 +69,7 @@ public:
         acceptor::stop();
     }
 
-    // Handle accept.
+    // Handle accept, applying the session filter as would acceptor.
     void accept(socket_handler&& handler) NOEXCEPT override
     {
         ++accepts_;
@@ -77,8 +77,15 @@ public:
 
         // Must be asynchronous or is an infinite recursion.
         // This error code will set the re-listener timer and channel pointer is ignored.
-        boost::asio::post(strand_, [=]() NOEXCEPT
+        boost::asio::post(strand_, [=, this]() NOEXCEPT
         {
+            // Filtered connections do not invoke the handler.
+            if (!admitted(socket->authority()))
+            {
+                socket->stop();
+                return;
+            }
+
             handler(error::success, socket);
         });
     }
@@ -312,7 +319,7 @@ public:
     acceptor::ptr create_acceptor() NOEXCEPT override
     {
         return ((acceptor_ = std::make_shared<Acceptor>(log, strand(),
-            service(), network_settings())));
+            service(), *network_settings())));
     }
 
     session_inbound::ptr attach_inbound_session() NOEXCEPT override
@@ -233,7 +233,7 @@ public:
     connector::ptr create_connector() NOEXCEPT override
     {
         return ((connector_ = std::make_shared<Connector>(log, strand(),
-            service(), network_settings())));
+            service(), *network_settings(), resources())));
     }
 
     session_inbound::ptr attach_inbound_session() NOEXCEPT override
@@ -239,7 +239,7 @@ public:
     connector::ptr create_connector() NOEXCEPT override
     {
         return ((connector_ = std::make_shared<Connector>(log, strand(),
-            service(), network_settings())));
+            service(), *network_settings(), resources())));
     }
 
     session_inbound::ptr attach_inbound_session() NOEXCEPT override
@@ -305,8 +305,9 @@ public:
 
     mock_connector_stop_connect(const logger& log, asio::strand& strand,
         asio::io_context& service, const settings& settings,
+        const resources::ptr& shared,
         mock_session_outbound::ptr session) NOEXCEPT
-      : mock_connector_connect_success(log, strand, service, settings),
+      : mock_connector_connect_success(log, strand, service, settings, shared),
         session_(session)
     {
     }
@@ -352,7 +353,8 @@ public:
             return connector_;
 
         return ((connector_ = std::make_shared<mock_connector_stop_connect>(
-            log, strand(), service(), network_settings(), session_)));
+            log, strand(), service(), *network_settings(), resources(),
+            session_)));
     }
 
     session_inbound::ptr attach_inbound_session() NOEXCEPT override
@@ -231,7 +231,7 @@ public:
     connector::ptr create_connector() NOEXCEPT override
     {
         return ((connector_ = std::make_shared<Connector>(log, strand(),
-            service(), network_settings())));
+            service(), *network_settings(), resources())));
     }
 
     session_inbound::ptr attach_inbound_session() NOEXCEPT override
@@ -320,8 +320,9 @@ public:
 
     mock_connector_stop_connect(const logger& log, asio::strand& strand,
         asio::io_context& service, const settings& settings,
+        const resources::ptr& shared,
         mock_session_seed::ptr session) NOEXCEPT
-      : mock_connector_connect_success(log, strand, service, settings),
+      : mock_connector_connect_success(log, strand, service, settings, shared),
         session_(session)
     {
     }
@@ -367,7 +368,8 @@ public:
             return connector_;
 
         return ((connector_ = std::make_shared<mock_connector_stop_connect>(
-            log, strand(), service(), network_settings(), session_)));
+            log, strand(), service(), *network_settings(), resources(),
+            session_)));
     }
 
     session_inbound::ptr attach_inbound_session() NOEXCEPT override
@@ -29,6 +29,8 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
 
     // [network]
     BOOST_REQUIRE_EQUAL(instance.threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.threads_maximum, 0u);
+    BOOST_REQUIRE_EQUAL(instance.thread_delay_microseconds, 1000u);
     BOOST_REQUIRE_EQUAL(instance.address_upper, 10u);
     BOOST_REQUIRE_EQUAL(instance.address_lower, 5u);
     BOOST_REQUIRE_EQUAL(instance.protocol_maximum, level::maximum_protocol);
@@ -39,32 +41,123 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
     BOOST_REQUIRE_EQUAL(instance.enable_address, false);
     BOOST_REQUIRE_EQUAL(instance.enable_alert, false);
     BOOST_REQUIRE_EQUAL(instance.enable_reject, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_send_headers, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_wtxid_relay, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_reconciliation, false);
     BOOST_REQUIRE_EQUAL(instance.enable_transaction, false);
     BOOST_REQUIRE_EQUAL(instance.enable_ipv6, false);
     BOOST_REQUIRE_EQUAL(instance.enable_loopback, false);
     BOOST_REQUIRE_EQUAL(instance.validate_checksum, false);
+    BOOST_REQUIRE_EQUAL(instance.retain_payload, false);
+    BOOST_REQUIRE_EQUAL(instance.lazy_inactivity, false);
+    BOOST_REQUIRE_EQUAL(instance.coarse_time, false);
+    BOOST_REQUIRE_EQUAL(instance.payload_huge_pages, false);
+    BOOST_REQUIRE_EQUAL(instance.trusted_peers, false);
+    BOOST_REQUIRE_EQUAL(instance.context_per_thread, false);
+    BOOST_REQUIRE_EQUAL(instance.compact_high_bandwidth, false);
+    BOOST_REQUIRE_EQUAL(instance.inbound_eviction, false);
+    BOOST_REQUIRE_EQUAL(instance.tcp_no_delay, true);
+    BOOST_REQUIRE_EQUAL(instance.deduplicate_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.pool_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.peer_compression, false);
+    BOOST_REQUIRE_EQUAL(instance.reuse_port, false);
+    BOOST_REQUIRE_EQUAL(instance.outbound_diversity, false);
     BOOST_REQUIRE_EQUAL(instance.identifier, 0u);
     BOOST_REQUIRE_EQUAL(instance.inbound_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_rate, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_group_rate, 0u);
     BOOST_REQUIRE_EQUAL(instance.outbound_connections, 10u);
     BOOST_REQUIRE_EQUAL(instance.connect_batch_size, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_batch_minimum, 1u);
+    BOOST_REQUIRE_EQUAL(instance.outbound_standby, 0u);
+    BOOST_REQUIRE_EQUAL(instance.block_relay_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_lifetime_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.retry_timeout_seconds, 1u);
+    BOOST_REQUIRE_EQUAL(instance.retry_maximum_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.connect_timeout_seconds, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_stagger_milliseconds, 250u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_cache_seconds, 300u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_negative_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.handshake_timeout_seconds, 30u);
+    BOOST_REQUIRE_EQUAL(instance.timeout_minimum_milliseconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.seeding_timeout_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.channel_heartbeat_minutes, 5u);
     BOOST_REQUIRE_EQUAL(instance.channel_inactivity_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.channel_expiration_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.channel_jitter_percent, 50u);
     BOOST_REQUIRE_EQUAL(instance.host_pool_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_checkpoint_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_slice, 1000u);
+    BOOST_REQUIRE_EQUAL(instance.host_expiration_days, 30u);
+    BOOST_REQUIRE_EQUAL(instance.host_failure_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.ban_threshold, 100u);
+    BOOST_REQUIRE_EQUAL(instance.ban_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.ban_decay_minutes, 60u);
     BOOST_REQUIRE_EQUAL(instance.minimum_buffer, heading::maximum_payload(level::canonical, true));
+    BOOST_REQUIRE_EQUAL(instance.payload_pool_capacity, 16u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_retain_bytes, 65'536u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_idle_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.read_quantum_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.address_refresh_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.address_snapshots, 4u);
+    BOOST_REQUIRE_EQUAL(instance.memory_budget_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_target_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_count, 32u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_bytes, 262144u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threshold, 0u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.compute_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_chunk_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_ahead_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.write_slice_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.compression_minimum, 1024u);
+    BOOST_REQUIRE_EQUAL(instance.checksum_batch_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_high_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_grace_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.shutdown_drain_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.broadcast_fanout, 0u);
+    BOOST_REQUIRE_EQUAL(instance.trickle_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.announce_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seen_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.serve_cache_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.export_megabytes, 64u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_seconds, 8u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_flood_percent, 10u);
+    BOOST_REQUIRE_EQUAL(instance.trace_sample, 1u);
+    BOOST_REQUIRE_EQUAL(instance.send_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.receive_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.keep_alive_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.not_sent_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.busy_poll_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fast_open_queue, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_cache_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_stagger_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_window, 16u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_stall_seconds, 10u);
+    BOOST_REQUIRE_EQUAL(instance.address_relay_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.feeler_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.rate_limit, 1024u);
     BOOST_REQUIRE_EQUAL(instance.user_agent, BC_USER_AGENT);
+    BOOST_REQUIRE(instance.export_name.empty());
     BOOST_REQUIRE(instance.path.empty());
+    BOOST_REQUIRE(instance.capture_path.empty());
+    BOOST_REQUIRE(instance.asmap_path.empty());
+    BOOST_REQUIRE(instance.handoff_path.empty());
+    BOOST_REQUIRE(instance.blocklist_path.empty());
     BOOST_REQUIRE(instance.peers.empty());
     BOOST_REQUIRE(instance.selfs.empty());
     BOOST_REQUIRE(instance.binds.empty());
     BOOST_REQUIRE(instance.blacklists.empty());
     BOOST_REQUIRE(instance.whitelists.empty());
     BOOST_REQUIRE(instance.friends.empty());
+    BOOST_REQUIRE(instance.traces.empty());
+    BOOST_REQUIRE(instance.thread_processors.empty());
+    BOOST_REQUIRE(instance.deserialize_processors.empty());
 }
 
 BOOST_AUTO_TEST_CASE(settings__construct__mainnet__expected)
@@ -73,6 +166,8 @@ BOOST_AUTO_TEST_CASE(settings__construct__mainnet__expected)
 
     // unchanged from default
     BOOST_REQUIRE_EQUAL(instance.threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.threads_maximum, 0u);
+    BOOST_REQUIRE_EQUAL(instance.thread_delay_microseconds, 1000u);
     BOOST_REQUIRE_EQUAL(instance.address_upper, 10u);
     BOOST_REQUIRE_EQUAL(instance.address_lower, 5u);
     BOOST_REQUIRE_EQUAL(instance.protocol_maximum, level::maximum_protocol);
@@ -83,30 +178,121 @@ BOOST_AUTO_TEST_CASE(settings__construct__mainnet__expected)
     BOOST_REQUIRE_EQUAL(instance.enable_address, false);
     BOOST_REQUIRE_EQUAL(instance.enable_alert, false);
     BOOST_REQUIRE_EQUAL(instance.enable_reject, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_send_headers, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_wtxid_relay, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_reconciliation, false);
     BOOST_REQUIRE_EQUAL(instance.enable_transaction, false);
     BOOST_REQUIRE_EQUAL(instance.enable_ipv6, false);
     BOOST_REQUIRE_EQUAL(instance.enable_loopback, false);
     BOOST_REQUIRE_EQUAL(instance.validate_checksum, false);
+    BOOST_REQUIRE_EQUAL(instance.retain_payload, false);
+    BOOST_REQUIRE_EQUAL(instance.lazy_inactivity, false);
+    BOOST_REQUIRE_EQUAL(instance.coarse_time, false);
+    BOOST_REQUIRE_EQUAL(instance.payload_huge_pages, false);
+    BOOST_REQUIRE_EQUAL(instance.trusted_peers, false);
+    BOOST_REQUIRE_EQUAL(instance.context_per_thread, false);
+    BOOST_REQUIRE_EQUAL(instance.compact_high_bandwidth, false);
+    BOOST_REQUIRE_EQUAL(instance.inbound_eviction, false);
+    BOOST_REQUIRE_EQUAL(instance.tcp_no_delay, true);
+    BOOST_REQUIRE_EQUAL(instance.deduplicate_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.pool_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.peer_compression, false);
+    BOOST_REQUIRE_EQUAL(instance.reuse_port, false);
+    BOOST_REQUIRE_EQUAL(instance.outbound_diversity, false);
     BOOST_REQUIRE_EQUAL(instance.inbound_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_rate, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_group_rate, 0u);
     BOOST_REQUIRE_EQUAL(instance.outbound_connections, 10u);
     BOOST_REQUIRE_EQUAL(instance.connect_batch_size, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_batch_minimum, 1u);
+    BOOST_REQUIRE_EQUAL(instance.outbound_standby, 0u);
+    BOOST_REQUIRE_EQUAL(instance.block_relay_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_lifetime_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.retry_timeout_seconds, 1u);
+    BOOST_REQUIRE_EQUAL(instance.retry_maximum_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.connect_timeout_seconds, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_stagger_milliseconds, 250u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_cache_seconds, 300u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_negative_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.handshake_timeout_seconds, 30u);
+    BOOST_REQUIRE_EQUAL(instance.timeout_minimum_milliseconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.seeding_timeout_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.channel_heartbeat_minutes, 5u);
     BOOST_REQUIRE_EQUAL(instance.channel_inactivity_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.channel_expiration_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.channel_jitter_percent, 50u);
     BOOST_REQUIRE_EQUAL(instance.host_pool_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_checkpoint_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_slice, 1000u);
+    BOOST_REQUIRE_EQUAL(instance.host_expiration_days, 30u);
+    BOOST_REQUIRE_EQUAL(instance.host_failure_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.ban_threshold, 100u);
+    BOOST_REQUIRE_EQUAL(instance.ban_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.ban_decay_minutes, 60u);
     BOOST_REQUIRE_EQUAL(instance.minimum_buffer, heading::maximum_payload(level::canonical, true));
+    BOOST_REQUIRE_EQUAL(instance.payload_pool_capacity, 16u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_retain_bytes, 65'536u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_idle_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.read_quantum_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.address_refresh_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.address_snapshots, 4u);
+    BOOST_REQUIRE_EQUAL(instance.memory_budget_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_target_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_count, 32u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_bytes, 262144u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threshold, 0u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.compute_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_chunk_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_ahead_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.write_slice_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.compression_minimum, 1024u);
+    BOOST_REQUIRE_EQUAL(instance.checksum_batch_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_high_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_grace_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.shutdown_drain_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.broadcast_fanout, 0u);
+    BOOST_REQUIRE_EQUAL(instance.trickle_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.announce_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seen_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.serve_cache_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.export_megabytes, 64u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_seconds, 8u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_flood_percent, 10u);
+    BOOST_REQUIRE_EQUAL(instance.trace_sample, 1u);
+    BOOST_REQUIRE_EQUAL(instance.send_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.receive_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.keep_alive_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.not_sent_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.busy_poll_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fast_open_queue, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_cache_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_stagger_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_window, 16u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_stall_seconds, 10u);
+    BOOST_REQUIRE_EQUAL(instance.address_relay_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.feeler_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.rate_limit, 1024u);
     BOOST_REQUIRE_EQUAL(instance.user_agent, BC_USER_AGENT);
+    BOOST_REQUIRE(instance.export_name.empty());
     BOOST_REQUIRE(instance.path.empty());
+    BOOST_REQUIRE(instance.capture_path.empty());
+    BOOST_REQUIRE(instance.asmap_path.empty());
+    BOOST_REQUIRE(instance.handoff_path.empty());
+    BOOST_REQUIRE(instance.blocklist_path.empty());
     BOOST_REQUIRE(instance.peers.empty());
     BOOST_REQUIRE(instance.selfs.empty());
     BOOST_REQUIRE(instance.blacklists.empty());
     BOOST_REQUIRE(instance.whitelists.empty());
     BOOST_REQUIRE(instance.friends.empty());
+    BOOST_REQUIRE(instance.traces.empty());
+    BOOST_REQUIRE(instance.thread_processors.empty());
+    BOOST_REQUIRE(instance.deserialize_processors.empty());
 
     // changed from default
     BOOST_REQUIRE_EQUAL(instance.identifier, 3652501241u);
@@ -132,6 +318,8 @@ BOOST_AUTO_TEST_CASE(settings__construct__testnet__expected)
 
     // unchanged from default
     BOOST_REQUIRE_EQUAL(instance.threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.threads_maximum, 0u);
+    BOOST_REQUIRE_EQUAL(instance.thread_delay_microseconds, 1000u);
     BOOST_REQUIRE_EQUAL(instance.address_upper, 10u);
     BOOST_REQUIRE_EQUAL(instance.address_lower, 5u);
     BOOST_REQUIRE_EQUAL(instance.protocol_maximum, level::maximum_protocol);
@@ -142,30 +330,121 @@ BOOST_AUTO_TEST_CASE(settings__construct__testnet__expected)
     BOOST_REQUIRE_EQUAL(instance.enable_address, false);
     BOOST_REQUIRE_EQUAL(instance.enable_alert, false);
     BOOST_REQUIRE_EQUAL(instance.enable_reject, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_send_headers, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_wtxid_relay, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_reconciliation, false);
     BOOST_REQUIRE_EQUAL(instance.enable_transaction, false);
     BOOST_REQUIRE_EQUAL(instance.enable_ipv6, false);
     BOOST_REQUIRE_EQUAL(instance.enable_loopback, false);
     BOOST_REQUIRE_EQUAL(instance.validate_checksum, false);
+    BOOST_REQUIRE_EQUAL(instance.retain_payload, false);
+    BOOST_REQUIRE_EQUAL(instance.lazy_inactivity, false);
+    BOOST_REQUIRE_EQUAL(instance.coarse_time, false);
+    BOOST_REQUIRE_EQUAL(instance.payload_huge_pages, false);
+    BOOST_REQUIRE_EQUAL(instance.trusted_peers, false);
+    BOOST_REQUIRE_EQUAL(instance.context_per_thread, false);
+    BOOST_REQUIRE_EQUAL(instance.compact_high_bandwidth, false);
+    BOOST_REQUIRE_EQUAL(instance.inbound_eviction, false);
+    BOOST_REQUIRE_EQUAL(instance.tcp_no_delay, true);
+    BOOST_REQUIRE_EQUAL(instance.deduplicate_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.pool_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.peer_compression, false);
+    BOOST_REQUIRE_EQUAL(instance.reuse_port, false);
+    BOOST_REQUIRE_EQUAL(instance.outbound_diversity, false);
     BOOST_REQUIRE_EQUAL(instance.inbound_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_rate, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_group_rate, 0u);
     BOOST_REQUIRE_EQUAL(instance.outbound_connections, 10u);
     BOOST_REQUIRE_EQUAL(instance.connect_batch_size, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_batch_minimum, 1u);
+    BOOST_REQUIRE_EQUAL(instance.outbound_standby, 0u);
+    BOOST_REQUIRE_EQUAL(instance.block_relay_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_lifetime_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.retry_timeout_seconds, 1u);
+    BOOST_REQUIRE_EQUAL(instance.retry_maximum_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.connect_timeout_seconds, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_stagger_milliseconds, 250u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_cache_seconds, 300u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_negative_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.handshake_timeout_seconds, 30u);
+    BOOST_REQUIRE_EQUAL(instance.timeout_minimum_milliseconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.seeding_timeout_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.channel_heartbeat_minutes, 5u);
     BOOST_REQUIRE_EQUAL(instance.channel_inactivity_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.channel_expiration_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.channel_jitter_percent, 50u);
     BOOST_REQUIRE_EQUAL(instance.host_pool_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_checkpoint_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_slice, 1000u);
+    BOOST_REQUIRE_EQUAL(instance.host_expiration_days, 30u);
+    BOOST_REQUIRE_EQUAL(instance.host_failure_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.ban_threshold, 100u);
+    BOOST_REQUIRE_EQUAL(instance.ban_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.ban_decay_minutes, 60u);
     BOOST_REQUIRE_EQUAL(instance.minimum_buffer, heading::maximum_payload(level::canonical, true));
+    BOOST_REQUIRE_EQUAL(instance.payload_pool_capacity, 16u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_retain_bytes, 65'536u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_idle_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.read_quantum_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.address_refresh_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.address_snapshots, 4u);
+    BOOST_REQUIRE_EQUAL(instance.memory_budget_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_target_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_count, 32u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_bytes, 262144u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threshold, 0u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.compute_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_chunk_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_ahead_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.write_slice_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.compression_minimum, 1024u);
+    BOOST_REQUIRE_EQUAL(instance.checksum_batch_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_high_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_grace_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.shutdown_drain_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.broadcast_fanout, 0u);
+    BOOST_REQUIRE_EQUAL(instance.trickle_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.announce_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seen_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.serve_cache_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.export_megabytes, 64u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_seconds, 8u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_flood_percent, 10u);
+    BOOST_REQUIRE_EQUAL(instance.trace_sample, 1u);
+    BOOST_REQUIRE_EQUAL(instance.send_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.receive_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.keep_alive_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.not_sent_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.busy_poll_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fast_open_queue, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_cache_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_stagger_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_window, 16u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_stall_seconds, 10u);
+    BOOST_REQUIRE_EQUAL(instance.address_relay_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.feeler_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.rate_limit, 1024u);
     BOOST_REQUIRE_EQUAL(instance.user_agent, BC_USER_AGENT);
+    BOOST_REQUIRE(instance.export_name.empty());
     BOOST_REQUIRE(instance.path.empty());
+    BOOST_REQUIRE(instance.capture_path.empty());
+    BOOST_REQUIRE(instance.asmap_path.empty());
+    BOOST_REQUIRE(instance.handoff_path.empty());
+    BOOST_REQUIRE(instance.blocklist_path.empty());
     BOOST_REQUIRE(instance.peers.empty());
     BOOST_REQUIRE(instance.selfs.empty());
     BOOST_REQUIRE(instance.blacklists.empty());
     BOOST_REQUIRE(instance.whitelists.empty());
     BOOST_REQUIRE(instance.friends.empty());
+    BOOST_REQUIRE(instance.traces.empty());
+    BOOST_REQUIRE(instance.thread_processors.empty());
+    BOOST_REQUIRE(instance.deserialize_processors.empty());
 
     // changed from default
     BOOST_REQUIRE_EQUAL(instance.identifier, 118034699u);
@@ -191,6 +470,8 @@ BOOST_AUTO_TEST_CASE(settings__construct__regtest__expected)
 
     // unchanged from default
     BOOST_REQUIRE_EQUAL(instance.threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.threads_maximum, 0u);
+    BOOST_REQUIRE_EQUAL(instance.thread_delay_microseconds, 1000u);
     BOOST_REQUIRE_EQUAL(instance.address_upper, 10u);
     BOOST_REQUIRE_EQUAL(instance.address_lower, 5u);
     BOOST_REQUIRE_EQUAL(instance.protocol_maximum, level::maximum_protocol);
@@ -201,29 +482,120 @@ BOOST_AUTO_TEST_CASE(settings__construct__regtest__expected)
     BOOST_REQUIRE_EQUAL(instance.enable_address, false);
     BOOST_REQUIRE_EQUAL(instance.enable_alert, false);
     BOOST_REQUIRE_EQUAL(instance.enable_reject, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_send_headers, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_wtxid_relay, false);
+    BOOST_REQUIRE_EQUAL(instance.enable_reconciliation, false);
     BOOST_REQUIRE_EQUAL(instance.enable_transaction, false);
     BOOST_REQUIRE_EQUAL(instance.enable_ipv6, false);
     BOOST_REQUIRE_EQUAL(instance.enable_loopback, false);
     BOOST_REQUIRE_EQUAL(instance.validate_checksum, false);
+    BOOST_REQUIRE_EQUAL(instance.retain_payload, false);
+    BOOST_REQUIRE_EQUAL(instance.lazy_inactivity, false);
+    BOOST_REQUIRE_EQUAL(instance.coarse_time, false);
+    BOOST_REQUIRE_EQUAL(instance.payload_huge_pages, false);
+    BOOST_REQUIRE_EQUAL(instance.trusted_peers, false);
+    BOOST_REQUIRE_EQUAL(instance.context_per_thread, false);
+    BOOST_REQUIRE_EQUAL(instance.compact_high_bandwidth, false);
+    BOOST_REQUIRE_EQUAL(instance.inbound_eviction, false);
+    BOOST_REQUIRE_EQUAL(instance.tcp_no_delay, true);
+    BOOST_REQUIRE_EQUAL(instance.deduplicate_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.pool_sends, false);
+    BOOST_REQUIRE_EQUAL(instance.peer_compression, false);
+    BOOST_REQUIRE_EQUAL(instance.reuse_port, false);
+    BOOST_REQUIRE_EQUAL(instance.outbound_diversity, false);
     BOOST_REQUIRE_EQUAL(instance.inbound_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_rate, 0u);
+    BOOST_REQUIRE_EQUAL(instance.accept_group_rate, 0u);
     BOOST_REQUIRE_EQUAL(instance.outbound_connections, 10u);
     BOOST_REQUIRE_EQUAL(instance.connect_batch_size, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_batch_minimum, 1u);
+    BOOST_REQUIRE_EQUAL(instance.outbound_standby, 0u);
+    BOOST_REQUIRE_EQUAL(instance.block_relay_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_connections, 0u);
+    BOOST_REQUIRE_EQUAL(instance.anchor_lifetime_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.retry_timeout_seconds, 1u);
+    BOOST_REQUIRE_EQUAL(instance.retry_maximum_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.connect_timeout_seconds, 5u);
+    BOOST_REQUIRE_EQUAL(instance.connect_stagger_milliseconds, 250u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_cache_seconds, 300u);
+    BOOST_REQUIRE_EQUAL(instance.resolve_negative_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.handshake_timeout_seconds, 30u);
+    BOOST_REQUIRE_EQUAL(instance.timeout_minimum_milliseconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.seeding_timeout_seconds, 30u);
     BOOST_REQUIRE_EQUAL(instance.channel_heartbeat_minutes, 5u);
     BOOST_REQUIRE_EQUAL(instance.channel_inactivity_minutes, 10u);
     BOOST_REQUIRE_EQUAL(instance.channel_expiration_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.channel_jitter_percent, 50u);
     BOOST_REQUIRE_EQUAL(instance.host_pool_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_checkpoint_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.host_sweep_slice, 1000u);
+    BOOST_REQUIRE_EQUAL(instance.host_expiration_days, 30u);
+    BOOST_REQUIRE_EQUAL(instance.host_failure_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.ban_threshold, 100u);
+    BOOST_REQUIRE_EQUAL(instance.ban_minutes, 1440u);
+    BOOST_REQUIRE_EQUAL(instance.ban_decay_minutes, 60u);
     BOOST_REQUIRE_EQUAL(instance.minimum_buffer, heading::maximum_payload(level::canonical, true));
+    BOOST_REQUIRE_EQUAL(instance.payload_pool_capacity, 16u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_retain_bytes, 65'536u);
+    BOOST_REQUIRE_EQUAL(instance.buffer_idle_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.read_quantum_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.address_refresh_seconds, 60u);
+    BOOST_REQUIRE_EQUAL(instance.address_snapshots, 4u);
+    BOOST_REQUIRE_EQUAL(instance.memory_budget_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_limit, 0u);
+    BOOST_REQUIRE_EQUAL(instance.upload_target_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_count, 32u);
+    BOOST_REQUIRE_EQUAL(instance.gather_write_bytes, 262144u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threshold, 0u);
+    BOOST_REQUIRE_EQUAL(instance.deserialize_threads, 1u);
+    BOOST_REQUIRE_EQUAL(instance.compute_threads, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_chunk_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.read_ahead_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.write_slice_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.compression_minimum, 1024u);
+    BOOST_REQUIRE_EQUAL(instance.checksum_batch_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_high_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.send_grace_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.shutdown_drain_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.broadcast_fanout, 0u);
+    BOOST_REQUIRE_EQUAL(instance.trickle_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.announce_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seen_capacity, 0u);
+    BOOST_REQUIRE_EQUAL(instance.serve_cache_megabytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.export_megabytes, 64u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_seconds, 8u);
+    BOOST_REQUIRE_EQUAL(instance.reconciliation_flood_percent, 10u);
+    BOOST_REQUIRE_EQUAL(instance.trace_sample, 1u);
+    BOOST_REQUIRE_EQUAL(instance.send_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.receive_buffer_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.keep_alive_seconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.not_sent_low_water, 0u);
+    BOOST_REQUIRE_EQUAL(instance.busy_poll_microseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fast_open_queue, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_cache_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(instance.seed_stagger_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_window, 16u);
+    BOOST_REQUIRE_EQUAL(instance.fetch_stall_seconds, 10u);
+    BOOST_REQUIRE_EQUAL(instance.address_relay_milliseconds, 0u);
+    BOOST_REQUIRE_EQUAL(instance.feeler_seconds, 0u);
     BOOST_REQUIRE_EQUAL(instance.rate_limit, 1024u);
+    BOOST_REQUIRE(instance.export_name.empty());
     BOOST_REQUIRE(instance.path.empty());
+    BOOST_REQUIRE(instance.capture_path.empty());
+    BOOST_REQUIRE(instance.asmap_path.empty());
+    BOOST_REQUIRE(instance.handoff_path.empty());
+    BOOST_REQUIRE(instance.blocklist_path.empty());
     BOOST_REQUIRE(instance.peers.empty());
     BOOST_REQUIRE(instance.selfs.empty());
     BOOST_REQUIRE(instance.blacklists.empty());
     BOOST_REQUIRE(instance.whitelists.empty());
     BOOST_REQUIRE(instance.friends.empty());
+    BOOST_REQUIRE(instance.traces.empty());
+    BOOST_REQUIRE(instance.thread_processors.empty());
+    BOOST_REQUIRE(instance.deserialize_processors.empty());
 
     // Regtest is private network only, so there is no seeding.
     BOOST_REQUIRE(instance.seeds.empty());
@@ -467,12 +839,106 @@ BOOST_AUTO_TEST_CASE(settings__retry_timeout__always__between_zero_and_retry_tim
     BOOST_REQUIRE(instance.retry_timeout() <= seconds{ instance.retry_timeout_seconds });
 }
 
+BOOST_AUTO_TEST_CASE(settings__retry_backoff__default_maximum__retry_timeout_seconds)
+{
+    settings instance{};
+    instance.retry_timeout_seconds = 42;
+    BOOST_REQUIRE(instance.retry_backoff(10) >= milliseconds{ 42u * 500u });
+    BOOST_REQUIRE(instance.retry_backoff(10) <= seconds{ 42 });
+}
+
+BOOST_AUTO_TEST_CASE(settings__retry_backoff__attempts__doubled_within_maximum)
+{
+    settings instance{};
+    instance.retry_timeout_seconds = 2;
+    instance.retry_maximum_seconds = 60;
+    BOOST_REQUIRE(instance.retry_backoff(0) <= seconds{ 2 });
+    BOOST_REQUIRE(instance.retry_backoff(3) >= seconds{ 8 });
+    BOOST_REQUIRE(instance.retry_backoff(3) <= seconds{ 16 });
+    BOOST_REQUIRE(instance.retry_backoff(100) >= seconds{ 30 });
+    BOOST_REQUIRE(instance.retry_backoff(100) <= seconds{ 60 });
+}
+
 BOOST_AUTO_TEST_CASE(settings__connect_timeout__always__between_zero_and_connect_timeout_seconds)
 {
     settings instance{};
+    const timeout_estimator connects{};
     instance.connect_timeout_seconds = 42;
-    BOOST_REQUIRE(instance.connect_timeout() > seconds{ zero });
-    BOOST_REQUIRE(instance.connect_timeout() <= seconds{ instance.connect_timeout_seconds });
+    BOOST_REQUIRE(instance.connect_timeout(connects) > seconds{ zero });
+    BOOST_REQUIRE(instance.connect_timeout(connects) <= seconds{ instance.connect_timeout_seconds });
+}
+
+BOOST_AUTO_TEST_CASE(settings__connect_timeout__adaptive_fast_samples__below_connect_timeout_seconds)
+{
+    settings instance{};
+    instance.connect_timeout_seconds = 42;
+    instance.timeout_minimum_milliseconds = 100;
+
+    // Twice the 95th percentile (20ms) is raised to the minimum (100ms).
+    timeout_estimator connects{};
+    for (size_t sample = 0; sample < 16u; ++sample)
+        connects.sample(milliseconds(10));
+
+    BOOST_REQUIRE(instance.connect_timeout(connects) <= milliseconds(100));
+    BOOST_REQUIRE(instance.connect_timeout(connects) >= milliseconds(50));
+}
+
+BOOST_AUTO_TEST_CASE(settings__connect_timeout__adaptive_empty_estimator__connect_timeout_seconds)
+{
+    settings instance{};
+    instance.connect_timeout_seconds = 42;
+    instance.timeout_minimum_milliseconds = 100;
+
+    const timeout_estimator connects{};
+    BOOST_REQUIRE(instance.connect_timeout(connects) >= seconds(21));
+    BOOST_REQUIRE(instance.connect_timeout(connects) <= seconds(42));
+}
+
+BOOST_AUTO_TEST_CASE(settings__channel_handshake__adaptive__estimated_or_handshake_timeout_seconds)
+{
+    settings instance{};
+    instance.handshake_timeout_seconds = 42;
+    instance.timeout_minimum_milliseconds = 100;
+
+    timeout_estimator handshakes{};
+    BOOST_REQUIRE(instance.channel_handshake(handshakes) == seconds(42));
+
+    for (size_t sample = 0; sample < 16u; ++sample)
+        handshakes.sample(milliseconds(500));
+
+    BOOST_REQUIRE(instance.channel_handshake(handshakes) == milliseconds(1'000));
+}
+
+BOOST_AUTO_TEST_CASE(settings__connect_stagger__always__connect_stagger_milliseconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.connect_stagger_milliseconds = expected;
+    BOOST_REQUIRE(instance.connect_stagger() == milliseconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__anchor_lifetime__always__anchor_lifetime_minutes)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.anchor_lifetime_minutes = expected;
+    BOOST_REQUIRE(instance.anchor_lifetime() == minutes(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__resolve_cache__always__resolve_cache_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.resolve_cache_seconds = expected;
+    BOOST_REQUIRE(instance.resolve_cache() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__resolve_negative__always__resolve_negative_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.resolve_negative_seconds = expected;
+    BOOST_REQUIRE(instance.resolve_negative() == seconds(expected));
 }
 
 BOOST_AUTO_TEST_CASE(settings__channel_handshake__always__handshake_timeout_seconds)
@@ -480,7 +946,7 @@ BOOST_AUTO_TEST_CASE(settings__channel_handshake__always__handshake_timeout_seco
     settings instance{};
     constexpr auto expected = 42u;
     instance.handshake_timeout_seconds = expected;
-    BOOST_REQUIRE(instance.channel_handshake() == seconds(expected));
+    BOOST_REQUIRE(instance.channel_handshake(timeout_estimator{}) == seconds(expected));
 }
 
 BOOST_AUTO_TEST_CASE(settings__channel_heartbeat__always__channel_heartbeat_minutes)
@@ -507,6 +973,162 @@ BOOST_AUTO_TEST_CASE(settings__channel_expiration__always__channel_expiration_mi
     BOOST_REQUIRE(instance.channel_expiration() == minutes(expected));
 }
 
+BOOST_AUTO_TEST_CASE(settings__staggered__zero_percent__span)
+{
+    settings instance{};
+    instance.channel_jitter_percent = 0;
+    BOOST_REQUIRE(instance.staggered(minutes(42)) == minutes(42));
+}
+
+BOOST_AUTO_TEST_CASE(settings__staggered__default__within_window)
+{
+    settings instance{};
+    for (auto trial = 0; trial < 100; ++trial)
+    {
+        const auto value = instance.staggered(minutes(42));
+        BOOST_REQUIRE(value >= seconds(21 * 60));
+        BOOST_REQUIRE(value <= minutes(42));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(settings__staggered__over_hundred_percent__not_negative)
+{
+    settings instance{};
+    instance.channel_jitter_percent = 200;
+    BOOST_REQUIRE(instance.staggered(minutes(42)) >= minutes(0));
+    BOOST_REQUIRE(instance.staggered(minutes(42)) <= minutes(42));
+}
+
+BOOST_AUTO_TEST_CASE(settings__host_checkpoint__always__host_checkpoint_minutes)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.host_checkpoint_minutes = expected;
+    BOOST_REQUIRE(instance.host_checkpoint() == minutes(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__ban_duration__always__ban_minutes)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.ban_minutes = expected;
+    BOOST_REQUIRE(instance.ban_duration() == minutes(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__ban_decay__always__ban_decay_minutes)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.ban_decay_minutes = expected;
+    BOOST_REQUIRE(instance.ban_decay() == minutes(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__send_grace__always__send_grace_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.send_grace_seconds = expected;
+    BOOST_REQUIRE(instance.send_grace() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__shutdown_drain__always__shutdown_drain_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.shutdown_drain_seconds = expected;
+    BOOST_REQUIRE(instance.shutdown_drain() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__buffer_idle__always__buffer_idle_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.buffer_idle_seconds = expected;
+    BOOST_REQUIRE(instance.buffer_idle() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__read_quantum__always__read_quantum_microseconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.read_quantum_microseconds = expected;
+    BOOST_REQUIRE(instance.read_quantum() == microseconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__address_refresh__always__address_refresh_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.address_refresh_seconds = expected;
+    BOOST_REQUIRE(instance.address_refresh() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__channel_trickle__always__randomized_within_trickle_milliseconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.trickle_milliseconds = expected;
+    const auto trickle = instance.channel_trickle();
+    BOOST_REQUIRE(trickle >= microseconds(expected * 500u));
+    BOOST_REQUIRE(trickle <= milliseconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__seed_stagger__always__seed_stagger_milliseconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.seed_stagger_milliseconds = expected;
+    BOOST_REQUIRE(instance.seed_stagger() == milliseconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__fetch_stall__always__fetch_stall_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.fetch_stall_seconds = expected;
+    BOOST_REQUIRE(instance.fetch_stall() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__address_relay__always__address_relay_milliseconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.address_relay_milliseconds = expected;
+    BOOST_REQUIRE(instance.address_relay() == milliseconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__feeler_interval__always__feeler_seconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.feeler_seconds = expected;
+    BOOST_REQUIRE(instance.feeler_interval() == seconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__thread_delay__always__thread_delay_microseconds)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.thread_delay_microseconds = expected;
+    BOOST_REQUIRE(instance.thread_delay() == microseconds(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__host_sweep__always__host_sweep_minutes)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.host_sweep_minutes = expected;
+    BOOST_REQUIRE(instance.host_sweep() == minutes(expected));
+}
+
+BOOST_AUTO_TEST_CASE(settings__host_expiration__always__host_expiration_days)
+{
+    settings instance{};
+    constexpr auto expected = 42u;
+    instance.host_expiration_days = expected;
+    BOOST_REQUIRE(instance.host_expiration() == hours(24u * expected));
+}
+
 BOOST_AUTO_TEST_CASE(settings__channel_germination__always__seeding_timeout_seconds)
 {
     settings instance{};
@@ -524,6 +1146,25 @@ BOOST_AUTO_TEST_CASE(settings__minimum_address_count__always__outbound_product)
     BOOST_REQUIRE_EQUAL(instance.minimum_address_count(), product);
 }
 
+BOOST_AUTO_TEST_CASE(settings__socket_options__always__expected)
+{
+    settings instance{};
+    instance.tcp_no_delay = false;
+    instance.send_buffer_bytes = 1;
+    instance.receive_buffer_bytes = 2;
+    instance.keep_alive_seconds = 3;
+    instance.not_sent_low_water = 4;
+    instance.busy_poll_microseconds = 5;
+
+    const auto options = instance.socket_options();
+    BOOST_REQUIRE(!options.no_delay);
+    BOOST_REQUIRE_EQUAL(options.send_buffer, 1u);
+    BOOST_REQUIRE_EQUAL(options.receive_buffer, 2u);
+    BOOST_REQUIRE_EQUAL(options.keep_alive, 3u);
+    BOOST_REQUIRE_EQUAL(options.not_sent_low_water, 4u);
+    BOOST_REQUIRE_EQUAL(options.busy_poll, 5u);
+}
+
 // disabled
 
 BOOST_AUTO_TEST_CASE(settings__disabled__enable_ipv6__both_false)
@@ -726,6 +1367,19 @@ BOOST_AUTO_TEST_CASE(settings__blacklisted__ipv6_host__expected)
     BOOST_REQUIRE(instance.blacklisted(config::address{ "[2020:db8::3]" }));
 }
 
+BOOST_AUTO_TEST_CASE(settings__blacklisted__initialized__compiled)
+{
+    settings instance{};
+    instance.blacklists.clear();
+    instance.blacklists.emplace_back("42.42.42.0/24");
+    instance.blacklists.emplace_back("[2020:db8::3]");
+    instance.initialize();
+    BOOST_REQUIRE(instance.blacklisted(config::address{ "42.42.42.42" }));
+    BOOST_REQUIRE(instance.blacklisted(config::address{ "[2020:db8::3]" }));
+    BOOST_REQUIRE(!instance.blacklisted(config::address{ "24.24.24.24" }));
+    BOOST_REQUIRE(instance.whitelisted(config::address{ "24.24.24.24" }));
+}
+
 // peered/initialize
 
 BOOST_AUTO_TEST_CASE(settings__initialize__configured__expected_port_matching)
@@ -800,4 +1454,98 @@ BOOST_AUTO_TEST_CASE(settings__excluded__default__true)
     BOOST_REQUIRE(instance.excluded({}));
 }
 
+BOOST_AUTO_TEST_CASE(settings__excluded__compiled__same_as_scanned)
+{
+    settings scanned{};
+    scanned.services_minimum = 0x01;
+    scanned.invalid_services = 0x02;
+    scanned.enable_ipv6 = false;
+    scanned.blacklists.clear();
+    scanned.blacklists.emplace_back("42.42.42.0/24");
+    scanned.peers.clear();
+    scanned.peers.emplace_back("12.12.12.12:8333");
+    scanned.whitelists.clear();
+
+    settings compiled{ scanned };
+    compiled.initialize();
+    scanned.friends = compiled.friends;
+
+    const auto item = [](const std::string& text, uint64_t services) NOEXCEPT
+    {
+        messages::address_item out = config::address{ text };
+        out.services = services;
+        return out;
+    };
+
+    const std::vector<messages::address_item> items
+    {
+        item("24.24.24.24:8333", 0x01),
+        item("24.24.24.24:8333", 0x00),
+        item("24.24.24.24:8333", 0x03),
+        item("42.42.42.42:8333", 0x01),
+        item("12.12.12.12:8333", 0x01),
+        item("12.12.12.12:8334", 0x01),
+        item("[2020:db8::3]:8333", 0x01)
+    };
+
+    for (const auto& value: items)
+    {
+        BOOST_REQUIRE_EQUAL(compiled.excluded(value), scanned.excluded(value));
+    }
+
+    BOOST_REQUIRE(!compiled.excluded(items.at(0)));
+    BOOST_REQUIRE(compiled.excluded(items.at(1)));
+    BOOST_REQUIRE(compiled.excluded(items.at(2)));
+    BOOST_REQUIRE(compiled.excluded(items.at(3)));
+    BOOST_REQUIRE(compiled.excluded(items.at(4)));
+    BOOST_REQUIRE(!compiled.excluded(items.at(5)));
+    BOOST_REQUIRE(compiled.excluded(items.at(6)));
+}
+
+// traced
+
+BOOST_AUTO_TEST_CASE(settings__traced__ipv4_host__expected)
+{
+    settings instance{};
+    BOOST_REQUIRE(!instance.traced(config::address{ "24.24.24.24" }));
+
+    instance.traces.emplace_back("12.12.12.12");
+    BOOST_REQUIRE(!instance.traced(config::address{ "24.24.24.24" }));
+
+    instance.traces.emplace_back("24.24.24.24");
+    BOOST_REQUIRE(instance.traced(config::address{ "24.24.24.24" }));
+}
+
+// trusted
+
+BOOST_AUTO_TEST_CASE(settings__trusted__peered__trusted_peers_only)
+{
+    settings instance{};
+    instance.peers.emplace_back("24.24.24.24");
+    instance.initialize();
+    BOOST_REQUIRE(!instance.trusted(config::address{ "24.24.24.24" }));
+
+    instance.trusted_peers = true;
+    BOOST_REQUIRE(instance.trusted(config::address{ "24.24.24.24" }));
+    BOOST_REQUIRE(!instance.trusted(config::address{ "12.12.12.12" }));
+}
+
+// reload
+
+BOOST_AUTO_TEST_CASE(settings__reload__update__runtime_fields_only)
+{
+    settings instance{};
+    instance.initialize();
+    BOOST_REQUIRE(!instance.blacklisted(config::address{ "24.24.24.24" }));
+
+    settings update{};
+    update.blacklists.emplace_back("24.24.24.24");
+    update.inbound_connections = 42;
+    update.outbound_connections = 42;
+    instance.reload(update);
+    BOOST_REQUIRE(instance.blacklisted(config::address{ "24.24.24.24" }));
+    BOOST_REQUIRE_EQUAL(instance.inbound_connections, 42u);
+    BOOST_REQUIRE_NE(instance.outbound_connections, 42u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()